@@ -0,0 +1,52 @@
+#
+#
+# Tencent is pleased to support the open source community by making tRPC available.
+#
+# Copyright (C) 2023 THL A29 Limited, a Tencent company.
+# All rights reserved.
+#
+# If you have downloaded a copy of the tRPC source code from Tencent,
+# please note that tRPC source code is licensed under the  Apache 2.0 License,
+# A copy of the Apache 2.0 License is included in this file.
+#
+#
+
+include(FetchContent)
+
+if(NOT DEFINED ZSTD_VER)
+    set(ZSTD_VER 1.5.5)
+endif()
+set(ZSTD_URL https://github.com/facebook/zstd/releases/download/v${ZSTD_VER}/zstd-${ZSTD_VER}.tar.gz)
+
+FetchContent_Declare(
+    zstd
+    URL               ${ZSTD_URL}
+    SOURCE_DIR        ${TRPC_ROOT_PATH}/cmake_third_party/zstd
+)
+
+FetchContent_GetProperties(zstd)
+if(NOT zstd_POPULATED)
+    FetchContent_Populate(zstd)
+
+    set(CMAKE_POLICY_DEFAULT_CMP0077 NEW)
+    set(ZSTD_BUILD_PROGRAMS OFF)
+    set(ZSTD_BUILD_TESTS OFF)
+    set(ZSTD_MULTITHREAD_SUPPORT OFF)
+    if(TRPC_BUILD_SHARED)
+        set(ZSTD_BUILD_STATIC OFF)
+    else()
+        set(ZSTD_BUILD_SHARED OFF)
+    endif()
+
+    add_subdirectory(${TRPC_ROOT_PATH}/cmake_third_party/zstd/build/cmake)
+
+    if(TRPC_BUILD_SHARED)
+        add_library(trpc_zstd ALIAS libzstd_shared)
+    else()
+        add_library(trpc_zstd ALIAS libzstd_static)
+    endif()
+
+    set(TARGET_INCLUDE_PATHS    ${TARGET_INCLUDE_PATHS}
+                                ${TRPC_ROOT_PATH}/cmake_third_party/zstd/lib)
+    set(TARGET_LINK_LIBS ${TARGET_LINK_LIBS} trpc_zstd)
+endif()
@@ -15,13 +15,15 @@
 
 #include <fstream>
 
+#include "trpc/runtime/iomodel/reactor/common/file_region.h"
+
 namespace http::demo {
 
 // Provides file downloading.
 ::trpc::Status FileStorageHandler::Get(const ::trpc::ServerContextPtr& ctx, const ::trpc::http::RequestPtr& req,
                                        ::trpc::http::Response* rsp) {
-  auto fin = std::ifstream(download_src_path_, std::ios::binary);
-  if (!fin.is_open()) {
+  auto file = ::trpc::FileRegion::Open(download_src_path_);
+  if (!file) {
     TRPC_FMT_ERROR("failed to open file: {}", download_src_path_);
     rsp->SetStatus(::trpc::http::ResponseStatus::kInternalServerError);
     return ::trpc::kSuccStatus;
@@ -36,28 +38,16 @@ namespace http::demo {
     return ::trpc::kStreamRstStatus;
   }
 
-  std::size_t nwrite{0};
-  ::trpc::BufferBuilder buffer_builder;
-  for (;;) {
-    fin.read(buffer_builder.data(), buffer_builder.SizeAvailable());
-    std::size_t n = fin.gcount();
-    if (n > 0) {
-      ::trpc::NoncontiguousBuffer buffer;
-      buffer.Append(buffer_builder.Seal(n));
-      status = writer.Write(std::move(buffer));
-      if (status.OK()) {
-        nwrite += n;
-        continue;
-      }
-      TRPC_FMT_ERROR("failed to write content: {}", status.ToString());
-      return ::trpc::kStreamRstStatus;
-    } else if (fin.eof()) {
-      status = writer.WriteDone();
-      if (status.OK()) break;
-      TRPC_FMT_ERROR("failed to send write-done: {}", status.ToString());
-      return ::trpc::kStreamRstStatus;
-    }
-    TRPC_FMT_ERROR("failed to read file");
+  // The file is sent by sendfile(2) without being copied into user space.
+  std::size_t nwrite = file->GetSize();
+  status = writer.WriteFile(std::move(file));
+  if (!status.OK()) {
+    TRPC_FMT_ERROR("failed to write content: {}", status.ToString());
+    return ::trpc::kStreamRstStatus;
+  }
+  status = writer.WriteDone();
+  if (!status.OK()) {
+    TRPC_FMT_ERROR("failed to send write-done: {}", status.ToString());
     return ::trpc::kStreamRstStatus;
   }
   TRPC_FMT_INFO("finish providing file, write size: {}", nwrite);
@@ -48,6 +48,9 @@ namespace trpc {
 /// All derived handlers inherit from AdminHandlerBase and implement the CommandHandle method.
 class AdminHandlerBase : public http::HandlerBase {
  public:
+  /// @param is_stream whether the handler writes the response through the stream of response by itself.
+  explicit AdminHandlerBase(bool is_stream = false) : http::HandlerBase(is_stream) {}
+
   ~AdminHandlerBase() override = default;
 
   /// @brief Handles commands input by user.
@@ -19,6 +19,7 @@
 #include "trpc/admin/commands_handler.h"
 #include "trpc/admin/contention_profiler_handler.h"
 #include "trpc/admin/cpu_profiler_handler.h"
+#include "trpc/admin/fiber_stack_handler.h"
 #include "trpc/admin/heap_profiler_handler.h"
 #include "trpc/admin/index_handler.h"
 #include "trpc/admin/js_handler.h"
@@ -27,7 +28,10 @@
 #include "trpc/admin/prometheus_handler.h"
 #endif
 #include "trpc/admin/reload_config_handler.h"
+#include "trpc/admin/response_cache_handler.h"
+#include "trpc/admin/rpc_stage_stats_handler.h"
 #include "trpc/admin/sample.h"
+#include "trpc/admin/sampling_profiler_handler.h"
 #include "trpc/admin/stats_handler.h"
 #include "trpc/admin/sysvars_handler.h"
 #include "trpc/admin/version_handler.h"
@@ -59,6 +63,8 @@ AdminService::AdminService() {
   RegisterCmd(http::OperationType::POST, "/cmds/watch", std::make_shared<admin::WatchHandler>());
   // Gets the stats
   RegisterCmd(http::OperationType::GET, "/cmds/stats", std::make_shared<admin::StatsHandler>());
+  // Gets the time spent in each stage of rpcs
+  RegisterCmd(http::OperationType::GET, "/cmds/stats/stages", std::make_shared<admin::RpcStageStatsHandler>());
   // Gets the vars.
   RegisterCmd(http::OperationType::GET, "/cmds/var", std::make_shared<admin::VarHandler>("/cmds/var"));
   RegisterCmd(http::OperationType::GET, "<regex(/cmds/var/.*)>", std::make_shared<admin::VarHandler>("/cmds/var"));
@@ -74,6 +80,14 @@ AdminService::AdminService() {
   RegisterCmd(http::OperationType::POST, "/cmds/profile/cpu", std::make_shared<admin::CpuProfilerHandler>());
   // Gets the heap profiling.
   RegisterCmd(http::OperationType::POST, "/cmds/profile/heap", std::make_shared<admin::HeapProfilerHandler>());
+  // Gets the recent samples of sampling profiler.
+  RegisterCmd(http::OperationType::GET, "/cmds/profile/sampling", std::make_shared<admin::SamplingProfilerHandler>());
+  // Starts/stops the sampling profiler.
+  RegisterCmd(http::OperationType::POST, "/cmds/profile/sampling",
+              std::make_shared<admin::SamplingProfilerHandler>(true));
+  // Gets the fiber stack usages.
+  RegisterCmd(http::OperationType::GET, "/cmds/fiber/stack", std::make_shared<admin::FiberStackHandler>());
+  RegisterCmd(http::OperationType::GET, "/cmds/response_cache", std::make_shared<admin::ResponseCacheHandler>());
 
   ////////////////////////////////////////////// return html
   // Gets index.
@@ -25,6 +25,7 @@
 #include <string>
 
 #include "trpc/admin/web_css_jquery.h"
+#include "trpc/runtime/common/stats/sampling_profiler.h"
 #include "trpc/util/http/body_params.h"
 #include "trpc/util/log/logging.h"
 #include "trpc/util/time.h"
@@ -52,10 +53,16 @@ void CpuProfilerHandler::CommandHandle(http::HttpRequestPtr req, rapidjson::Valu
     return;
   }
 
+  // Both profilers rely on SIGPROF, the sampling profiler is paused until this one stops.
+  auto* sampling_profiler = SamplingProfiler::GetInstance();
   if (enable == "y" && !ProfilingIsEnabledForAllThreads()) {
-    ProfilerStart("cpu.prof");
+    sampling_profiler->Pause();
+    if (!ProfilerStart("cpu.prof")) {
+      sampling_profiler->Resume();
+    }
   } else if (enable == "n" && ProfilingIsEnabledForAllThreads()) {
     ProfilerStop();
+    sampling_profiler->Resume();
   }
 
   result.AddMember("errorcode", 0, alloc);
@@ -277,9 +284,13 @@ void WebCpuProfilerDrawHandler::CommandHandle(http::HttpRequestPtr req, rapidjso
       return;
     }
     TRPC_LOG_INFO("start Profile, prof_name: " << prof_name);
+    // Both profilers rely on SIGPROF, the sampling profiler is paused until this one stops.
+    auto* sampling_profiler = SamplingProfiler::GetInstance();
+    sampling_profiler->Pause();
     ProfilerStart(prof_name);
     sleep(seconds);
     ProfilerStop();
+    sampling_profiler->Resume();
     TRPC_LOG_INFO("stop Profile,  check prof_name: " << prof_name);
     view_name = prof_name;
   } else {
@@ -0,0 +1,51 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/admin/fiber_stack_handler.h"
+
+#include <cstddef>
+
+#include "trpc/runtime/threadmodel/fiber/detail/stack_allocator_impl.h"
+
+namespace trpc::admin {
+
+void FiberStackHandler::CommandHandle(http::HttpRequestPtr req, rapidjson::Value& result,
+                                      rapidjson::Document::AllocatorType& alloc) {
+  result.AddMember("errorcode", 0, alloc);
+  result.AddMember("message", "", alloc);
+
+  rapidjson::Value classes(rapidjson::kArrayType);
+  for (std::size_t i = 0; i != fiber::detail::kStackClassNum; ++i) {
+    auto stack_class = static_cast<fiber::detail::StackClass>(i);
+    rapidjson::Value item(rapidjson::kObjectType);
+    item.AddMember("name", rapidjson::StringRef(fiber::detail::GetStackClassName(stack_class)), alloc);
+    item.AddMember("stack_size", fiber::detail::GetFiberStackSize(stack_class), alloc);
+    classes.PushBack(item, alloc);
+  }
+  result.AddMember("classes", classes, alloc);
+
+  rapidjson::Value usages(rapidjson::kArrayType);
+  for (const auto& usage : fiber::detail::GetStackUsages()) {
+    rapidjson::Value item(rapidjson::kObjectType);
+    item.AddMember("name", rapidjson::Value(usage.name.c_str(), alloc), alloc);
+    item.AddMember("stack_class", rapidjson::StringRef(fiber::detail::GetStackClassName(usage.stack_class)), alloc);
+    item.AddMember("stack_size", usage.stack_size, alloc);
+    item.AddMember("samples", usage.samples, alloc);
+    item.AddMember("max_used", static_cast<uint64_t>(usage.max_used), alloc);
+    item.AddMember("avg_used", static_cast<uint64_t>(usage.avg_used), alloc);
+    usages.PushBack(item, alloc);
+  }
+  result.AddMember("usages", usages, alloc);
+}
+
+}  // namespace trpc::admin
@@ -0,0 +1,32 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include "trpc/admin/admin_handler.h"
+
+namespace trpc::admin {
+
+/// @brief Handles the request for getting fiber stack classes and the sampled stack usages of fibers (see
+///        `fiber_stack_usage_sample_rate` in global config), which help to choose stack class for fibers.
+class FiberStackHandler : public AdminHandlerBase {
+ public:
+  FiberStackHandler() { description_ = "[GET /cmds/fiber/stack] get fiber stack classes and sampled stack usages"; }
+
+  ~FiberStackHandler() override = default;
+
+  void CommandHandle(http::HttpRequestPtr req, rapidjson::Value& result,
+                     rapidjson::Document::AllocatorType& alloc) override;
+};
+
+}  // namespace trpc::admin
@@ -0,0 +1,40 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/admin/fiber_stack_handler.h"
+
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "trpc/runtime/threadmodel/fiber/detail/stack_allocator_impl.h"
+#include "trpc/server/server_context.h"
+
+namespace trpc::testing {
+
+TEST(FiberStackHandlerTest, Test) {
+  fiber::detail::ReportStackUsage("test_entry", fiber::detail::StackClass::kSmall, 1024);
+
+  std::unique_ptr<AdminHandlerBase> handler = std::make_unique<admin::FiberStackHandler>();
+  http::HttpRequestPtr req = std::make_shared<http::HttpRequest>();
+  http::HttpResponse reply;
+  ServerContextPtr context;
+  handler->Handle("", context, req, &reply);
+  EXPECT_NE(reply.GetContent().find("\"small\""), std::string::npos);
+  EXPECT_NE(reply.GetContent().find("test_entry"), std::string::npos);
+
+  fiber::detail::ResetStackUsages();
+}
+
+}  // namespace trpc::testing
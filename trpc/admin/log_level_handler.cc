@@ -96,6 +96,8 @@ void LogLevelHandler::CommandHandle(http::HttpRequestPtr req, rapidjson::Value&
       result.AddMember("message", "set level failed, does logger exist?", alloc);
       return;
     }
+    // Log plugins other than "default" may not invalidate the cached decisions of the logging macros by themselves.
+    LogCallSite::InvalidateAll();
   }
 
   auto ret = log->GetLevel(instance.data());
@@ -14,19 +14,87 @@
 #ifdef TRPC_BUILD_INCLUDE_PROMETHEUS
 #include "trpc/admin/prometheus_handler.h"
 
-#include "prometheus/text_serializer.h"
+#include <utility>
+#include <vector>
+
+#include "trpc/util/log/logging.h"
 
 namespace trpc::admin {
 
-PrometheusHandler::PrometheusHandler() { description_ = "[GET /metrics] get prometheus metrics"; }
+namespace {
+
+// Serialized families are flushed as one HTTP chunk once they exceed this size.
+constexpr size_t kChunkSize = 64 * 1024;
+
+// Serializes all families, `flush` is invoked with every chunk. Families are released right after serialized.
+template <typename F>
+trpc::Status SerializeFamilies(PrometheusFormat format, F&& flush) {
+  std::vector<::prometheus::MetricFamily> families = trpc::prometheus::Collect();
+
+  NoncontiguousBufferBuilder builder;
+  for (auto& family : families) {
+    SerializePrometheusFamily(format, family, builder);
+    ::prometheus::MetricFamily released;
+    std::swap(family, released);
+    if (builder.ByteSize() >= kChunkSize) {
+      if (trpc::Status status = flush(builder.DestructiveGet()); !status.OK()) {
+        return status;
+      }
+      builder = NoncontiguousBufferBuilder();
+    }
+  }
+  if (builder.ByteSize() > 0) {
+    return flush(builder.DestructiveGet());
+  }
+  return kDefaultStatus;
+}
+
+}  // namespace
+
+PrometheusHandler::PrometheusHandler() : AdminHandlerBase(true) {
+  description_ = "[GET /metrics] get prometheus metrics";
+}
 
 void PrometheusHandler::CommandHandle(http::HttpRequestPtr req, rapidjson::Value& result,
                                       rapidjson::Document::AllocatorType& alloc) {
-  static std::unique_ptr<::prometheus::Serializer> serializer = std::make_unique<::prometheus::TextSerializer>();
-
-  std::string prometheus_str = serializer->Serialize(trpc::prometheus::Collect());
+  NoncontiguousBuffer content;
+  SerializeFamilies(PrometheusFormat::kText, [&content](NoncontiguousBuffer&& chunk) {
+    content.Append(std::move(chunk));
+    return kDefaultStatus;
+  });
+  std::string prometheus_str = FlattenSlow(content);
   result.AddMember(rapidjson::StringRef("trpc-html"), rapidjson::Value(prometheus_str, alloc).Move(), alloc);
 }
 
+trpc::Status PrometheusHandler::Handle(const std::string& path, trpc::ServerContextPtr context,
+                                       http::HttpRequestPtr req, http::HttpResponse* rsp) {
+  PrometheusFormat format = NegotiatePrometheusFormat(req->GetHeader("Accept"));
+  rsp->SetMimeType(PrometheusContentType(format));
+
+  // Without a server context (e.g. called directly), the whole exposition is set as content of the response.
+  if (!context) {
+    NoncontiguousBuffer content;
+    SerializeFamilies(format, [&content](NoncontiguousBuffer&& chunk) {
+      content.Append(std::move(chunk));
+      return kDefaultStatus;
+    });
+    rsp->SetNonContiguousBufferContent(std::move(content));
+    rsp->Done();
+    return kDefaultStatus;
+  }
+
+  auto& stream = rsp->GetStream();
+  trpc::Status status = SerializeFamilies(format, [&stream](NoncontiguousBuffer&& chunk) {
+    return stream.Write(std::move(chunk));
+  });
+  if (status.OK()) {
+    status = stream.WriteDone();
+  }
+  if (!status.OK()) {
+    TRPC_FMT_ERROR("write prometheus metrics failed: {}", status.ToString());
+  }
+  return status;
+}
+
 }  // namespace trpc::admin
 #endif
@@ -15,17 +15,25 @@
 #pragma once
 
 #include "trpc/admin/admin_handler.h"
+#include "trpc/admin/prometheus_serializer.h"
 #include "trpc/util/prometheus.h"
 
 namespace trpc::admin {
 
 /// @brief Handles the request for getting result of Prometheus monitor.
+/// @brief Exposes Prometheus metrics, in text format or in protobuf format if it is accepted by the scraper.
+/// @note It is a streaming handler, metric families are serialized into chunks of a chunked HTTP response one after
+///       another, so the whole exposition is never held in memory.
 class PrometheusHandler : public AdminHandlerBase {
  public:
   PrometheusHandler();
 
   void CommandHandle(http::HttpRequestPtr req, rapidjson::Value& result,
                      rapidjson::Document::AllocatorType& alloc) override;
+
+  trpc::Status Handle(const std::string& path, trpc::ServerContextPtr context, http::HttpRequestPtr req,
+                      http::HttpResponse* rsp) override;
+
 };
 
 }  // namespace trpc::admin
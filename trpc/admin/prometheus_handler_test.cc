@@ -29,6 +29,21 @@ TEST(PrometheusHandlerTest, CommandHandle) {
   trpc::Status status = prom_handler->Handle("", nullptr, req, &resp);
   ASSERT_EQ(true, status.OK());
   ASSERT_NE(0, resp.GetContent().size());
+  ASSERT_EQ(admin::PrometheusContentType(admin::PrometheusFormat::kText), resp.GetHeader("Content-Type"));
+}
+
+TEST(PrometheusHandlerTest, ProtobufFormat) {
+  std::unique_ptr<admin::PrometheusHandler> prom_handler = std::make_unique<admin::PrometheusHandler>();
+  ASSERT_TRUE(prom_handler->IsStream());
+
+  http::RequestPtr req = std::make_shared<http::Request>();
+  req->SetHeader("Accept",
+                 "application/vnd.google.protobuf;proto=io.prometheus.client.MetricFamily;encoding=delimited");
+  http::Response resp;
+  trpc::Status status = prom_handler->Handle("", nullptr, req, &resp);
+  ASSERT_EQ(true, status.OK());
+  ASSERT_NE(0, resp.GetContent().size());
+  ASSERT_EQ(admin::PrometheusContentType(admin::PrometheusFormat::kProtobuf), resp.GetHeader("Content-Type"));
 }
 
 }  // namespace trpc::testing
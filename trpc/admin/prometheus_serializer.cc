@@ -0,0 +1,374 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#ifdef TRPC_BUILD_INCLUDE_PROMETHEUS
+#include "trpc/admin/prometheus_serializer.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "fmt/format.h"
+
+namespace trpc::admin {
+
+namespace {
+
+constexpr char kTextContentType[] = "text/plain; version=0.0.4; charset=utf-8";
+constexpr char kProtobufContentType[] =
+    "application/vnd.google.protobuf; proto=io.prometheus.client.MetricFamily; encoding=delimited";
+
+// Field numbers and wire types of io.prometheus.client (metrics.proto).
+constexpr uint32_t kWireVarint = 0;
+constexpr uint32_t kWireFixed64 = 1;
+constexpr uint32_t kWireLengthDelimited = 2;
+
+enum ProtoMetricType : uint32_t {
+  kProtoCounter = 0,
+  kProtoGauge = 1,
+  kProtoSummary = 2,
+  kProtoUntyped = 3,
+  kProtoHistogram = 4,
+};
+
+void AppendVarint(uint64_t value, std::string* out) {
+  while (value >= 0x80) {
+    out->push_back(static_cast<char>(value | 0x80));
+    value >>= 7;
+  }
+  out->push_back(static_cast<char>(value));
+}
+
+void AppendTag(uint32_t field, uint32_t wire_type, std::string* out) { AppendVarint((field << 3) | wire_type, out); }
+
+void AppendVarintField(uint32_t field, uint64_t value, std::string* out) {
+  AppendTag(field, kWireVarint, out);
+  AppendVarint(value, out);
+}
+
+void AppendDoubleField(uint32_t field, double value, std::string* out) {
+  AppendTag(field, kWireFixed64, out);
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  for (int i = 0; i < 8; ++i) {
+    out->push_back(static_cast<char>(bits >> (8 * i)));
+  }
+}
+
+void AppendBytesField(uint32_t field, std::string_view value, std::string* out) {
+  AppendTag(field, kWireLengthDelimited, out);
+  AppendVarint(value.size(), out);
+  out->append(value.data(), value.size());
+}
+
+// Text format helpers, the output is the same as ::prometheus::TextSerializer except that doubles are written in
+// the shortest representation.
+
+void AppendTextDouble(double value, std::string* out) {
+  if (std::isnan(value)) {
+    out->append("Nan");
+  } else if (std::isinf(value)) {
+    out->append(value < 0 ? "-Inf" : "+Inf");
+  } else {
+    fmt::format_to(std::back_inserter(*out), "{}", value);
+  }
+}
+
+void AppendEscaped(std::string_view value, bool escape_quote, std::string* out) {
+  for (char c : value) {
+    switch (c) {
+      case '\\':
+        out->append("\\\\");
+        break;
+      case '\n':
+        out->append("\\n");
+        break;
+      case '"':
+        if (escape_quote) {
+          out->append("\\\"");
+        } else {
+          out->push_back(c);
+        }
+        break;
+      default:
+        out->push_back(c);
+        break;
+    }
+  }
+}
+
+void AppendTextHead(const ::prometheus::MetricFamily& family, const ::prometheus::ClientMetric& metric,
+                    std::string_view suffix, std::string_view extra_label_name, std::string_view extra_label_value,
+                    std::string* out) {
+  out->append(family.name);
+  out->append(suffix.data(), suffix.size());
+  if (!metric.label.empty() || !extra_label_name.empty()) {
+    out->push_back('{');
+    const char* prefix = "";
+    for (const auto& label : metric.label) {
+      out->append(prefix);
+      out->append(label.name);
+      out->append("=\"");
+      AppendEscaped(label.value, true, out);
+      out->push_back('"');
+      prefix = ",";
+    }
+    if (!extra_label_name.empty()) {
+      out->append(prefix);
+      out->append(extra_label_name.data(), extra_label_name.size());
+      out->append("=\"");
+      out->append(extra_label_value.data(), extra_label_value.size());
+      out->push_back('"');
+    }
+    out->push_back('}');
+  }
+  out->push_back(' ');
+}
+
+void AppendTextTail(const ::prometheus::ClientMetric& metric, std::string* out) {
+  if (metric.timestamp_ms != 0) {
+    fmt::format_to(std::back_inserter(*out), " {}", metric.timestamp_ms);
+  }
+  out->push_back('\n');
+}
+
+void AppendTextSample(const ::prometheus::MetricFamily& family, const ::prometheus::ClientMetric& metric,
+                      std::string_view suffix, double value, std::string* out) {
+  AppendTextHead(family, metric, suffix, {}, {}, out);
+  AppendTextDouble(value, out);
+  AppendTextTail(metric, out);
+}
+
+void AppendTextMetric(const ::prometheus::MetricFamily& family, const ::prometheus::ClientMetric& metric,
+                      std::string* out) {
+  switch (family.type) {
+    case ::prometheus::MetricType::Counter:
+      AppendTextSample(family, metric, "", metric.counter.value, out);
+      break;
+    case ::prometheus::MetricType::Gauge:
+      AppendTextSample(family, metric, "", metric.gauge.value, out);
+      break;
+    case ::prometheus::MetricType::Info:
+      AppendTextSample(family, metric, "_info", metric.info.value, out);
+      break;
+    case ::prometheus::MetricType::Summary: {
+      const auto& summary = metric.summary;
+      AppendTextHead(family, metric, "_count", {}, {}, out);
+      fmt::format_to(std::back_inserter(*out), "{}", summary.sample_count);
+      AppendTextTail(metric, out);
+      AppendTextSample(family, metric, "_sum", summary.sample_sum, out);
+      std::string quantile_value;
+      for (const auto& quantile : summary.quantile) {
+        quantile_value.clear();
+        AppendTextDouble(quantile.quantile, &quantile_value);
+        AppendTextHead(family, metric, "", "quantile", quantile_value, out);
+        AppendTextDouble(quantile.value, out);
+        AppendTextTail(metric, out);
+      }
+      break;
+    }
+    case ::prometheus::MetricType::Histogram: {
+      const auto& histogram = metric.histogram;
+      AppendTextHead(family, metric, "_count", {}, {}, out);
+      fmt::format_to(std::back_inserter(*out), "{}", histogram.sample_count);
+      AppendTextTail(metric, out);
+      AppendTextSample(family, metric, "_sum", histogram.sample_sum, out);
+      double last = -std::numeric_limits<double>::infinity();
+      std::string upper_bound;
+      for (const auto& bucket : histogram.bucket) {
+        upper_bound.clear();
+        AppendTextDouble(bucket.upper_bound, &upper_bound);
+        AppendTextHead(family, metric, "_bucket", "le", upper_bound, out);
+        fmt::format_to(std::back_inserter(*out), "{}", bucket.cumulative_count);
+        AppendTextTail(metric, out);
+        last = bucket.upper_bound;
+      }
+      if (last != std::numeric_limits<double>::infinity()) {
+        AppendTextHead(family, metric, "_bucket", "le", "+Inf", out);
+        fmt::format_to(std::back_inserter(*out), "{}", histogram.sample_count);
+        AppendTextTail(metric, out);
+      }
+      break;
+    }
+    default:
+      AppendTextSample(family, metric, "", metric.untyped.value, out);
+      break;
+  }
+}
+
+// Protobuf format helpers.
+
+uint32_t ToProtoMetricType(::prometheus::MetricType type) {
+  switch (type) {
+    case ::prometheus::MetricType::Counter:
+      return kProtoCounter;
+    case ::prometheus::MetricType::Gauge:
+    case ::prometheus::MetricType::Info:
+      return kProtoGauge;
+    case ::prometheus::MetricType::Summary:
+      return kProtoSummary;
+    case ::prometheus::MetricType::Histogram:
+      return kProtoHistogram;
+    default:
+      return kProtoUntyped;
+  }
+}
+
+// Encodes a message holding a single double value, which is the layout of Counter, Gauge and Untyped.
+void AppendProtoValueMessage(uint32_t field, double value, std::string* out) {
+  std::string message;
+  AppendDoubleField(1, value, &message);
+  AppendBytesField(field, message, out);
+}
+
+void AppendProtoMetric(::prometheus::MetricType type, const ::prometheus::ClientMetric& metric, std::string* out) {
+  std::string message;
+  std::string nested;
+  for (const auto& label : metric.label) {
+    nested.clear();
+    AppendBytesField(1, label.name, &nested);
+    AppendBytesField(2, label.value, &nested);
+    AppendBytesField(1, nested, &message);
+  }
+
+  switch (type) {
+    case ::prometheus::MetricType::Counter:
+      AppendProtoValueMessage(3, metric.counter.value, &message);
+      break;
+    case ::prometheus::MetricType::Gauge:
+      AppendProtoValueMessage(2, metric.gauge.value, &message);
+      break;
+    case ::prometheus::MetricType::Info:
+      AppendProtoValueMessage(2, metric.info.value, &message);
+      break;
+    case ::prometheus::MetricType::Summary: {
+      std::string summary;
+      AppendVarintField(1, metric.summary.sample_count, &summary);
+      AppendDoubleField(2, metric.summary.sample_sum, &summary);
+      for (const auto& quantile : metric.summary.quantile) {
+        nested.clear();
+        AppendDoubleField(1, quantile.quantile, &nested);
+        AppendDoubleField(2, quantile.value, &nested);
+        AppendBytesField(3, nested, &summary);
+      }
+      AppendBytesField(4, summary, &message);
+      break;
+    }
+    case ::prometheus::MetricType::Histogram: {
+      std::string histogram;
+      AppendVarintField(1, metric.histogram.sample_count, &histogram);
+      AppendDoubleField(2, metric.histogram.sample_sum, &histogram);
+      for (const auto& bucket : metric.histogram.bucket) {
+        nested.clear();
+        AppendVarintField(1, bucket.cumulative_count, &nested);
+        AppendDoubleField(2, bucket.upper_bound, &nested);
+        AppendBytesField(3, nested, &histogram);
+      }
+      AppendBytesField(7, histogram, &message);
+      break;
+    }
+    default:
+      AppendProtoValueMessage(5, metric.untyped.value, &message);
+      break;
+  }
+
+  if (metric.timestamp_ms != 0) {
+    AppendVarintField(6, static_cast<uint64_t>(metric.timestamp_ms), &message);
+  }
+  // `metric` field of MetricFamily.
+  AppendBytesField(4, message, out);
+}
+
+// Header of the family: HELP and TYPE lines for text, or the name/help/type fields for protobuf.
+void SerializeHeader(PrometheusFormat format, const ::prometheus::MetricFamily& family, std::string* out) {
+  // Samples of info metric are named with "_info" suffix.
+  std::string name = family.name;
+  if (family.type == ::prometheus::MetricType::Info) {
+    name.append("_info");
+  }
+
+  if (format == PrometheusFormat::kProtobuf) {
+    AppendBytesField(1, name, out);
+    if (!family.help.empty()) {
+      AppendBytesField(2, family.help, out);
+    }
+    AppendVarintField(3, ToProtoMetricType(family.type), out);
+    return;
+  }
+
+  if (!family.help.empty()) {
+    out->append("# HELP ");
+    out->append(name);
+    out->push_back(' ');
+    AppendEscaped(family.help, false, out);
+    out->push_back('\n');
+  }
+  out->append("# TYPE ");
+  out->append(name);
+  switch (family.type) {
+    case ::prometheus::MetricType::Counter:
+      out->append(" counter\n");
+      break;
+    case ::prometheus::MetricType::Gauge:
+    case ::prometheus::MetricType::Info:
+      out->append(" gauge\n");
+      break;
+    case ::prometheus::MetricType::Summary:
+      out->append(" summary\n");
+      break;
+    case ::prometheus::MetricType::Histogram:
+      out->append(" histogram\n");
+      break;
+    default:
+      out->append(" untyped\n");
+      break;
+  }
+}
+
+}  // namespace
+
+const char* PrometheusContentType(PrometheusFormat format) {
+  return format == PrometheusFormat::kProtobuf ? kProtobufContentType : kTextContentType;
+}
+
+PrometheusFormat NegotiatePrometheusFormat(std::string_view accept) {
+  if (accept.find("application/vnd.google.protobuf") != std::string_view::npos &&
+      accept.find("io.prometheus.client.MetricFamily") != std::string_view::npos) {
+    return PrometheusFormat::kProtobuf;
+  }
+  return PrometheusFormat::kText;
+}
+
+void SerializePrometheusFamily(PrometheusFormat format, const ::prometheus::MetricFamily& family,
+                               NoncontiguousBufferBuilder& builder) {
+  std::string serialized;
+  SerializeHeader(format, family, &serialized);
+  for (const auto& metric : family.metric) {
+    if (format == PrometheusFormat::kProtobuf) {
+      AppendProtoMetric(family.type, metric, &serialized);
+    } else {
+      AppendTextMetric(family, metric, &serialized);
+    }
+  }
+
+  // Protobuf messages are delimited by their length.
+  if (format == PrometheusFormat::kProtobuf) {
+    std::string length;
+    AppendVarint(serialized.size(), &length);
+    builder.Append(length);
+  }
+  builder.Append(serialized);
+}
+
+}  // namespace trpc::admin
+#endif
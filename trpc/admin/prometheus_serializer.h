@@ -0,0 +1,44 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#ifdef TRPC_BUILD_INCLUDE_PROMETHEUS
+#pragma once
+
+#include <string_view>
+
+#include "prometheus/metric_family.h"
+
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+
+namespace trpc::admin {
+
+/// @brief Exposition formats supported by "/metrics".
+enum class PrometheusFormat {
+  // Text format, version 0.0.4.
+  kText,
+  // Length-delimited protobuf format of io.prometheus.client.MetricFamily.
+  kProtobuf,
+};
+
+/// @brief Gets the HTTP Content-Type of the exposition format.
+const char* PrometheusContentType(PrometheusFormat format);
+
+/// @brief Chooses the exposition format by the HTTP Accept header, protobuf is used only when it is accepted.
+PrometheusFormat NegotiatePrometheusFormat(std::string_view accept);
+
+/// @brief Appends the serialized family into builder, so that the exposition can be written out family by family.
+void SerializePrometheusFamily(PrometheusFormat format, const ::prometheus::MetricFamily& family,
+                               NoncontiguousBufferBuilder& builder);
+
+}  // namespace trpc::admin
+#endif
@@ -0,0 +1,93 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#ifdef TRPC_BUILD_INCLUDE_PROMETHEUS
+#include "trpc/admin/prometheus_serializer.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace trpc::testing {
+
+namespace {
+
+::prometheus::MetricFamily MakeGaugeFamily(double value) {
+  ::prometheus::ClientMetric metric;
+  metric.label.push_back({"method", "Say\"Hello\""});
+  metric.gauge.value = value;
+
+  ::prometheus::MetricFamily family;
+  family.name = "rpc_inflight";
+  family.help = "inflight requests";
+  family.type = ::prometheus::MetricType::Gauge;
+  family.metric.push_back(metric);
+  return family;
+}
+
+std::string Serialize(admin::PrometheusFormat format, const ::prometheus::MetricFamily& family) {
+  NoncontiguousBufferBuilder builder;
+  admin::SerializePrometheusFamily(format, family, builder);
+  return FlattenSlow(builder.DestructiveGet());
+}
+
+}  // namespace
+
+TEST(PrometheusSerializerTest, NegotiateFormat) {
+  ASSERT_EQ(admin::PrometheusFormat::kText, admin::NegotiatePrometheusFormat(""));
+  ASSERT_EQ(admin::PrometheusFormat::kText, admin::NegotiatePrometheusFormat("text/plain;version=0.0.4"));
+  ASSERT_EQ(admin::PrometheusFormat::kProtobuf,
+            admin::NegotiatePrometheusFormat("application/vnd.google.protobuf;proto=io.prometheus.client.MetricFamily;"
+                                             "encoding=delimited;q=0.7,text/plain;version=0.0.4;q=0.3"));
+}
+
+TEST(PrometheusSerializerTest, Text) {
+  ASSERT_EQ(
+      "# HELP rpc_inflight inflight requests\n"
+      "# TYPE rpc_inflight gauge\n"
+      "rpc_inflight{method=\"Say\\\"Hello\\\"\"} 1.5\n",
+      Serialize(admin::PrometheusFormat::kText, MakeGaugeFamily(1.5)));
+
+  ::prometheus::ClientMetric metric;
+  metric.histogram.sample_count = 3;
+  metric.histogram.sample_sum = 12;
+  metric.histogram.bucket.push_back({1, 1.0});
+  metric.histogram.bucket.push_back({3, 10.0});
+  ::prometheus::MetricFamily family;
+  family.name = "rpc_latency";
+  family.type = ::prometheus::MetricType::Histogram;
+  family.metric.push_back(metric);
+  ASSERT_EQ(
+      "# TYPE rpc_latency histogram\n"
+      "rpc_latency_count 3\n"
+      "rpc_latency_sum 12\n"
+      "rpc_latency_bucket{le=\"1\"} 1\n"
+      "rpc_latency_bucket{le=\"10\"} 3\n"
+      "rpc_latency_bucket{le=\"+Inf\"} 3\n",
+      Serialize(admin::PrometheusFormat::kText, family));
+}
+
+TEST(PrometheusSerializerTest, Protobuf) {
+  ::prometheus::MetricFamily family;
+  family.name = "up";
+  family.type = ::prometheus::MetricType::Counter;
+  family.metric.emplace_back();
+  family.metric.back().counter.value = 1.0;
+
+  // MetricFamily{name: "up", type: COUNTER, metric: [{counter: {value: 1.0}}]}, prefixed by its length.
+  const std::string expected("\x13\x0a\x02up\x18\x00\x22\x0b\x1a\x09\x09\x00\x00\x00\x00\x00\x00\xf0\x3f", 20);
+  ASSERT_EQ(expected, Serialize(admin::PrometheusFormat::kProtobuf, family));
+}
+
+}  // namespace trpc::testing
+#endif
@@ -0,0 +1,41 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/admin/response_cache_handler.h"
+
+#include "trpc/filter/response_cache/response_cache.h"
+
+namespace trpc::admin {
+
+void ResponseCacheHandler::CommandHandle(http::HttpRequestPtr req, rapidjson::Value& result,
+                                         rapidjson::Document::AllocatorType& alloc) {
+  result.AddMember("errorcode", 0, alloc);
+  result.AddMember("message", "", alloc);
+
+  rapidjson::Value caches(rapidjson::kArrayType);
+  ResponseCache::ForEachCache([&caches, &alloc](const ResponseCache& cache) {
+    auto stats = cache.GetStats();
+    uint64_t total = stats.hits + stats.misses;
+    rapidjson::Value item(rapidjson::kObjectType);
+    item.AddMember("capacity", stats.capacity, alloc);
+    item.AddMember("memory_bytes", stats.memory_bytes, alloc);
+    item.AddMember("entries", stats.entries, alloc);
+    item.AddMember("hits", stats.hits, alloc);
+    item.AddMember("misses", stats.misses, alloc);
+    item.AddMember("hit_ratio", total == 0 ? 0.0 : static_cast<double>(stats.hits) / total, alloc);
+    caches.PushBack(item, alloc);
+  });
+  result.AddMember("caches", caches, alloc);
+}
+
+}  // namespace trpc::admin
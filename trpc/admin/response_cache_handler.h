@@ -0,0 +1,31 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include "trpc/admin/admin_handler.h"
+
+namespace trpc::admin {
+
+/// @brief Handles the request for getting statistics of the response caches used by `response_cache` server filter.
+class ResponseCacheHandler : public AdminHandlerBase {
+ public:
+  ResponseCacheHandler() { description_ = "[GET /cmds/response_cache] get statistics of response caches"; }
+
+  ~ResponseCacheHandler() override = default;
+
+  void CommandHandle(http::HttpRequestPtr req, rapidjson::Value& result,
+                     rapidjson::Document::AllocatorType& alloc) override;
+};
+
+}  // namespace trpc::admin
@@ -0,0 +1,42 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/admin/response_cache_handler.h"
+
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "trpc/filter/response_cache/response_cache.h"
+#include "trpc/server/server_context.h"
+
+namespace trpc::testing {
+
+TEST(ResponseCacheHandlerTest, Test) {
+  ResponseCache cache(1024 * 1024, 4);
+  ResponseCache::Value value;
+  cache.Put("key", value, 1000);
+  ASSERT_TRUE(cache.Get("key", value));
+
+  std::unique_ptr<AdminHandlerBase> handler = std::make_unique<admin::ResponseCacheHandler>();
+  http::HttpRequestPtr req = std::make_shared<http::HttpRequest>();
+  http::HttpResponse reply;
+  ServerContextPtr context;
+  handler->Handle("", context, req, &reply);
+  EXPECT_NE(reply.GetContent().find("\"capacity\":1048576"), std::string::npos);
+  EXPECT_NE(reply.GetContent().find("\"hits\":1"), std::string::npos);
+  EXPECT_NE(reply.GetContent().find("\"entries\":1"), std::string::npos);
+}
+
+}  // namespace trpc::testing
@@ -0,0 +1,75 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#include "trpc/admin/rpc_stage_stats_handler.h"
+
+#include <cstddef>
+#include <string_view>
+
+#include "trpc/runtime/common/stats/rpc_stage_stats.h"
+
+namespace trpc::admin {
+
+namespace {
+
+rapidjson::Value HistogramToJson(const RpcStageHistogram& histogram, rapidjson::Document::AllocatorType& alloc) {
+  rapidjson::Value item(rapidjson::kObjectType);
+  item.AddMember("count", histogram.Count(), alloc);
+  item.AddMember("avg_ns", CyclesToNanoseconds(histogram.Sum() / histogram.Count()), alloc);
+  item.AddMember("p50_ns", CyclesToNanoseconds(histogram.Percentile(0.5)), alloc);
+  item.AddMember("p99_ns", CyclesToNanoseconds(histogram.Percentile(0.99)), alloc);
+  item.AddMember("p999_ns", CyclesToNanoseconds(histogram.Percentile(0.999)), alloc);
+  item.AddMember("max_ns", CyclesToNanoseconds(histogram.Max()), alloc);
+  return item;
+}
+
+}  // namespace
+
+void RpcStageStatsHandler::CommandHandle(http::HttpRequestPtr req, rapidjson::Value& result,
+                                         rapidjson::Document::AllocatorType& alloc) {
+  if (!RpcStageStats::IsEnabled()) {
+    result.AddMember("errorcode", -1, alloc);
+    result.AddMember("message", "rpc stage stats not running, please config enable_rpc_stage_stats in server", alloc);
+    return;
+  }
+
+  auto* stats = RpcStageStats::GetInstance();
+  auto methods = stats->Collect();
+  if (req->GetQueryParameter("reset") == "true") {
+    stats->Reset();
+  }
+
+  result.AddMember("errorcode", 0, alloc);
+  result.AddMember("message", "", alloc);
+
+  rapidjson::Value items(rapidjson::kArrayType);
+  for (const auto& [method, histograms] : methods) {
+    rapidjson::Value stages(rapidjson::kObjectType);
+    for (std::size_t i = 0; i != histograms.size(); ++i) {
+      if (histograms[i].Count() == 0) {
+        continue;
+      }
+      std::string_view name = GetRpcStageName(static_cast<RpcStage>(i));
+      rapidjson::Value stage = HistogramToJson(histograms[i], alloc);
+      stages.AddMember(rapidjson::StringRef(name.data(), name.size()), stage, alloc);
+    }
+    rapidjson::Value item(rapidjson::kObjectType);
+    item.AddMember("method", rapidjson::Value(method.c_str(), alloc), alloc);
+    item.AddMember("stages", stages, alloc);
+    items.PushBack(item, alloc);
+  }
+  result.AddMember("methods", items, alloc);
+}
+
+}  // namespace trpc::admin
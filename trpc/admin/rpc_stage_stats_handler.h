@@ -0,0 +1,34 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#pragma once
+
+#include "trpc/admin/admin_handler.h"
+
+namespace trpc::admin {
+
+/// @brief Handles the request for getting cpu time spent in each stage of rpcs, grouped by method (see
+///        `enable_rpc_stage_stats` in server config). Histograms are cleared after being read if `reset=true` is in
+///        the query.
+class RpcStageStatsHandler : public AdminHandlerBase {
+ public:
+  RpcStageStatsHandler() { description_ = "[GET /cmds/stats/stages] get time spent in each stage of rpcs by method"; }
+
+  ~RpcStageStatsHandler() override = default;
+
+  void CommandHandle(http::HttpRequestPtr req, rapidjson::Value& result,
+                     rapidjson::Document::AllocatorType& alloc) override;
+};
+
+}  // namespace trpc::admin
@@ -0,0 +1,52 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#include "trpc/admin/rpc_stage_stats_handler.h"
+
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "trpc/runtime/common/stats/rpc_stage_stats.h"
+#include "trpc/server/server_context.h"
+
+namespace trpc::testing {
+
+TEST(RpcStageStatsHandlerTest, Test) {
+  std::unique_ptr<AdminHandlerBase> handler = std::make_unique<admin::RpcStageStatsHandler>();
+  ServerContextPtr context;
+
+  http::HttpRequestPtr req = std::make_shared<http::HttpRequest>();
+  http::HttpResponse reply;
+  handler->Handle("", context, req, &reply);
+  EXPECT_NE(reply.GetContent().find("enable_rpc_stage_stats"), std::string::npos);
+
+  RpcStageStats::SetEnabled(true);
+  RpcStageTimer timer;
+  timer.Add(RpcStage::kHandle, 1000);
+  RpcStageStats::GetInstance()->Record("/trpc.test.Greeter/SayHello", timer.GetAll());
+
+  req->AddQueryParameter("reset=true");
+  http::HttpResponse reply2;
+  handler->Handle("", context, req, &reply2);
+  EXPECT_NE(reply2.GetContent().find("/trpc.test.Greeter/SayHello"), std::string::npos);
+  EXPECT_NE(reply2.GetContent().find("\"handle\""), std::string::npos);
+  EXPECT_EQ(reply2.GetContent().find("\"decode\""), std::string::npos);
+  EXPECT_TRUE(RpcStageStats::GetInstance()->Collect().empty());
+
+  RpcStageStats::SetEnabled(false);
+}
+
+}  // namespace trpc::testing
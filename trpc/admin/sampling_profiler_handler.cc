@@ -0,0 +1,122 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#include "trpc/admin/sampling_profiler_handler.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+
+#include "trpc/common/config/trpc_config.h"
+#include "trpc/runtime/common/stats/sampling_profiler.h"
+#include "trpc/util/http/body_params.h"
+#include "trpc/util/string/string_helper.h"
+
+namespace trpc::admin {
+
+namespace {
+
+uint32_t GetSeconds(const http::HttpRequestPtr& req) {
+  return TryParse<uint32_t>(req->GetQueryParameter("seconds")).value_or(0);
+}
+
+void UpdateSamplingProfiler(http::HttpRequestPtr req, rapidjson::Value& result,
+                            rapidjson::Document::AllocatorType& alloc) {
+  auto enable = req->GetQueryParameter("enable");
+  if (enable.empty()) {
+    http::BodyParam body_param(req->GetContent());
+    enable = body_param.GetBodyParam("enable");
+  }
+  if (enable != "y" && enable != "n") {
+    result.AddMember("errorcode", -2, alloc);
+    result.AddMember("message", "wrong parameter, please use ?enable=y/n", alloc);
+    return;
+  }
+
+  auto* profiler = SamplingProfiler::GetInstance();
+  if (enable == "y" && !profiler->IsRunning()) {
+    const auto& server_config = TrpcConfig::GetInstance()->GetServerConfig();
+    SamplingProfiler::Options options;
+    options.frequency = server_config.sampling_profiler_frequency;
+    options.window_seconds = server_config.sampling_profiler_window_seconds;
+    if (!profiler->Start(options)) {
+      result.AddMember("errorcode", -3, alloc);
+      result.AddMember("message", "start sampling profiler failed", alloc);
+      return;
+    }
+  } else if (enable == "n") {
+    profiler->Stop();
+  }
+
+  result.AddMember("errorcode", 0, alloc);
+  result.AddMember("message", "OK", alloc);
+}
+
+}  // namespace
+
+void SamplingProfilerHandler::CommandHandle(http::HttpRequestPtr req, rapidjson::Value& result,
+                                            rapidjson::Document::AllocatorType& alloc) {
+  if (update_flag_) {
+    UpdateSamplingProfiler(std::move(req), result, alloc);
+    return;
+  }
+
+  auto* profiler = SamplingProfiler::GetInstance();
+  if (!profiler->IsRunning()) {
+    result.AddMember("errorcode", -1, alloc);
+    result.AddMember("message", "sampling profiler not running, please config enable_sampling_profiler in server",
+                     alloc);
+    return;
+  }
+
+  std::map<std::string, uint64_t> stacks = profiler->GetCollapsedStacks(GetSeconds(req));
+  uint64_t total = 0;
+  rapidjson::Value items(rapidjson::kArrayType);
+  for (const auto& [stack, count] : stacks) {
+    rapidjson::Value item(rapidjson::kObjectType);
+    item.AddMember("stack", rapidjson::Value(stack.c_str(), alloc), alloc);
+    item.AddMember("samples", count, alloc);
+    items.PushBack(item, alloc);
+    total += count;
+  }
+
+  result.AddMember("errorcode", 0, alloc);
+  result.AddMember("message", "", alloc);
+  result.AddMember("total_samples", total, alloc);
+  result.AddMember("dropped_samples", profiler->GetDroppedSamples(), alloc);
+  result.AddMember("stacks", items, alloc);
+}
+
+trpc::Status SamplingProfilerHandler::Handle(const std::string& path, trpc::ServerContextPtr context,
+                                             http::HttpRequestPtr req, http::HttpResponse* rsp) {
+  auto* profiler = SamplingProfiler::GetInstance();
+  if (update_flag_ || req->GetQueryParameter("format") == "json" || !profiler->IsRunning()) {
+    return AdminHandlerBase::Handle(path, std::move(context), std::move(req), rsp);
+  }
+
+  // Collapsed format, one "frame;frame;... count" per line.
+  std::string content;
+  for (const auto& [stack, count] : profiler->GetCollapsedStacks(GetSeconds(req))) {
+    content += stack;
+    content += ' ';
+    content += std::to_string(count);
+    content += '\n';
+  }
+  rsp->SetContent(std::move(content));
+  rsp->Done("txt");
+  return kDefaultStatus;
+}
+
+}  // namespace trpc::admin
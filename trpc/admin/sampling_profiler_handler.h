@@ -0,0 +1,47 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#pragma once
+
+#include <string>
+
+#include "trpc/admin/admin_handler.h"
+
+namespace trpc::admin {
+
+/// @brief Handles the request for getting samples of the always-on sampling profiler (see `enable_sampling_profiler`
+///        in server config), in collapsed format which can be rendered by flamegraph.pl or speedscope directly, or in
+///        json if `format=json` is in the query. `seconds` in the query limits the samples to the last seconds.
+///        It also supports POST method with `enable=y/n` to start/stop the profiler at runtime.
+class SamplingProfilerHandler : public AdminHandlerBase {
+ public:
+  explicit SamplingProfilerHandler(bool update_flag = false) : update_flag_(update_flag) {
+    description_ =
+        "[GET /cmds/profile/sampling?seconds={SECONDS}&format=collapsed/json] get recent samples of sampling profiler, "
+        "[POST /cmds/profile/sampling?enable=y/n] start/stop sampling profiler";
+  }
+
+  ~SamplingProfilerHandler() override = default;
+
+  void CommandHandle(http::HttpRequestPtr req, rapidjson::Value& result,
+                     rapidjson::Document::AllocatorType& alloc) override;
+
+  trpc::Status Handle(const std::string& path, trpc::ServerContextPtr context, http::HttpRequestPtr req,
+                      http::HttpResponse* rsp) override;
+
+ private:
+  bool update_flag_;
+};
+
+}  // namespace trpc::admin
@@ -0,0 +1,86 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#include "trpc/admin/sampling_profiler_handler.h"
+
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "trpc/runtime/common/stats/sampling_profiler.h"
+#include "trpc/server/server_context.h"
+
+namespace trpc::testing {
+
+namespace {
+
+void SpinFor(int ms) {
+  timespec start, now;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+  volatile uint64_t counter = 0;
+  do {
+    counter = counter + 1;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+  } while ((now.tv_sec - start.tv_sec) * 1000 + (now.tv_nsec - start.tv_nsec) / 1000000 < ms);
+}
+
+}  // namespace
+
+TEST(SamplingProfilerHandlerTest, Test) {
+  std::unique_ptr<AdminHandlerBase> getter = std::make_unique<admin::SamplingProfilerHandler>();
+  std::unique_ptr<AdminHandlerBase> updater = std::make_unique<admin::SamplingProfilerHandler>(true);
+  ServerContextPtr context;
+
+  http::HttpRequestPtr req = std::make_shared<http::HttpRequest>();
+  http::HttpResponse reply;
+  getter->Handle("", context, req, &reply);
+  EXPECT_NE(reply.GetContent().find("enable_sampling_profiler"), std::string::npos);
+
+  http::HttpResponse reply2;
+  updater->Handle("", context, req, &reply2);
+  EXPECT_NE(reply2.GetContent().find("enable=y/n"), std::string::npos);
+
+  SamplingProfiler::GetInstance()->RegisterCurrentThread("handler_test");
+  http::HttpRequestPtr start_req = std::make_shared<http::HttpRequest>();
+  start_req->AddQueryParameter("enable=y");
+  http::HttpResponse reply3;
+  updater->Handle("", context, start_req, &reply3);
+  EXPECT_NE(reply3.GetContent().find("\"errorcode\":0"), std::string::npos);
+  ASSERT_TRUE(SamplingProfiler::GetInstance()->IsRunning());
+  SpinFor(200);
+
+  http::HttpResponse reply4;
+  getter->Handle("", context, req, &reply4);
+  EXPECT_EQ(reply4.GetContent().find("handler_test;"), 0);
+  EXPECT_EQ(reply4.GetContent().back(), '\n');
+
+  http::HttpRequestPtr json_req = std::make_shared<http::HttpRequest>();
+  json_req->AddQueryParameter("format=json");
+  http::HttpResponse reply5;
+  getter->Handle("", context, json_req, &reply5);
+  EXPECT_NE(reply5.GetContent().find("\"total_samples\""), std::string::npos);
+  EXPECT_NE(reply5.GetContent().find("\"stack\":\"handler_test;"), std::string::npos);
+
+  http::HttpRequestPtr stop_req = std::make_shared<http::HttpRequest>();
+  stop_req->AddQueryParameter("enable=n");
+  http::HttpResponse reply6;
+  updater->Handle("", context, stop_req, &reply6);
+  EXPECT_FALSE(SamplingProfiler::GetInstance()->IsRunning());
+  SamplingProfiler::GetInstance()->UnregisterCurrentThread();
+}
+
+}  // namespace trpc::testing
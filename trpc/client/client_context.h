@@ -179,7 +179,20 @@ class ClientContext : public RefCounted<ClientContext> {
   std::string GetFuncName() const { return req_msg_->GetFuncName(); }
 
   /// @brief Set the function name for requesting remote service.
-  void SetFuncName(std::string value) { req_msg_->SetFuncName(std::move(value)); }
+  void SetFuncName(std::string value) {
+    req_msg_->SetFuncName(std::move(value));
+    invoke_info_.method_id = 0;
+  }
+
+  /// @brief Set the function name together with its method id (see `GetMethodId` in trpc/codec/method_id.h), which
+  ///        is precomputed by the generated stub so it needn't be hashed per call.
+  void SetFuncName(std::string value, uint32_t method_id) {
+    req_msg_->SetFuncName(std::move(value));
+    invoke_info_.method_id = method_id;
+  }
+
+  /// @brief Get the method id set with the function name, zero if it is not set.
+  uint32_t GetMethodId() const { return invoke_info_.method_id; }
 
   /// @brief Use GetFuncName instead. Get the function name for requesting remote service using trpc protocol.
   /// @private
@@ -850,6 +863,9 @@ class ClientContext : public RefCounted<ClientContext> {
     // NONE:DEFAULT is the default.
     uint16_t rsp_compress_info{static_cast<uint16_t>(compressor::kNone << 8) | compressor::kDefault};
 
+    // Method id of the function name, zero if it is not precomputed.
+    uint32_t method_id{0};
+
     // The function name of the caller who issues an RPC call.
     std::string caller_func_name;
 
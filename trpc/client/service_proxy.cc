@@ -23,7 +23,10 @@
 #include "trpc/codec/trpc/trpc_protocol.h"
 #include "trpc/common/config/default_value.h"
 #include "trpc/common/config/trpc_config.h"
+#include "trpc/coroutine/fiber.h"
+#include "trpc/coroutine/future.h"
 #include "trpc/filter/filter_manager.h"
+#include "trpc/future/future_utility.h"
 #include "trpc/naming/selector_factory.h"
 #include "trpc/naming/trpc_naming.h"
 #include "trpc/runtime/common/stats/frame_stats.h"
@@ -63,9 +66,13 @@ Status ServiceProxy::UnaryInvoke(const ClientContextPtr& context, const Protocol
   // Run filters before client sends the RPC request message
   int filter_ret = RunFilters(FilterPoint::CLIENT_PRE_SEND_MSG, context);
   if (filter_ret == 0) {
-    UnaryTransportInvoke(context, req, rsp);
+    if (singleflight_) {
+      SingleFlightUnaryInvoke(context, req, rsp);
+    } else {
+      UnaryTransportInvoke(context, req, rsp);
 
-    ProxyStatistics(context);
+      ProxyStatistics(context);
+    }
   }
 
   // Run filters after client receives the RPC response message
@@ -85,6 +92,9 @@ Future<ProtocolPtr> ServiceProxy::AsyncUnaryInvoke(const ClientContextPtr& conte
 
   int filter_ret = RunFilters(FilterPoint::CLIENT_PRE_SEND_MSG, context);
   if (filter_ret == 0) {
+    if (singleflight_) {
+      return SingleFlightAsyncUnaryInvoke(context, req);
+    }
     return AsyncUnaryTransportInvoke(context, req);
   } else {
     RunFilters(FilterPoint::CLIENT_POST_RECV_MSG, context);
@@ -92,6 +102,62 @@ Future<ProtocolPtr> ServiceProxy::AsyncUnaryInvoke(const ClientContextPtr& conte
   }
 }
 
+void ServiceProxy::SingleFlightUnaryInvoke(const ClientContextPtr& context, const ProtocolPtr& req, ProtocolPtr& rsp) {
+  bool leader = false;
+  auto call = singleflight_->Join(context, req, leader);
+  if (!call || leader) {
+    UnaryTransportInvoke(context, req, rsp);
+
+    ProxyStatistics(context);
+
+    if (call) {
+      singleflight_->Finish(call, context->GetStatus(), rsp);
+    }
+    return;
+  }
+
+  auto fut = call->GetFuture();
+  fut = IsRunningInFiberWorker() ? fiber::BlockingGet(std::move(fut)) : future::BlockingGet(std::move(fut));
+  if (fut.IsReady()) {
+    rsp = fut.GetValue0();
+    return;
+  }
+
+  auto ex = fut.GetException();
+  context->SetStatus(Status(ex.GetExceptionCode(), 0, ex.what()));
+}
+
+Future<ProtocolPtr> ServiceProxy::SingleFlightAsyncUnaryInvoke(const ClientContextPtr& context,
+                                                               const ProtocolPtr& req) {
+  bool leader = false;
+  auto call = singleflight_->Join(context, req, leader);
+  if (!call) {
+    return AsyncUnaryTransportInvoke(context, req);
+  }
+
+  if (leader) {
+    return AsyncUnaryTransportInvoke(context, req).Then([this, context, call](Future<ProtocolPtr>&& fut) {
+      if (fut.IsFailed()) {
+        singleflight_->Finish(call, context->GetStatus(), nullptr);
+        return std::move(fut);
+      }
+      auto rsp = fut.GetValue0();
+      singleflight_->Finish(call, context->GetStatus(), rsp);
+      return MakeReadyFuture<ProtocolPtr>(std::move(rsp));
+    });
+  }
+
+  // Filters after receiving are run by the leader for its own context, run them for the follower here.
+  return call->GetFuture().Then([this, context](Future<ProtocolPtr>&& fut) {
+    if (fut.IsFailed()) {
+      auto ex = fut.GetException();
+      context->SetStatus(Status(ex.GetExceptionCode(), 0, ex.what()));
+    }
+    RunFilters(FilterPoint::CLIENT_POST_RECV_MSG, context);
+    return std::move(fut);
+  });
+}
+
 bool ServiceProxy::CheckTimeout(const ClientContextPtr& context) {
   if (context->GetTimeout() == 0) {
     std::string error("service name:");
@@ -353,12 +419,17 @@ void ServiceProxy::SetServiceProxyOptionInner(const std::shared_ptr<ServiceProxy
 
   PrepareStatistics(option->name);
 
+  InitSingleFlight();
+
   InitFilters();
 
   // Init selector filter, the selector_name configuration option will be used.
   // It should be executed after 'InitFilters'.
   InitSelectorFilter();
 
+  // Global filters have been registered by now, so that requests run the chains built here.
+  filter_controller_.BuildChains();
+
   // Init the service routing name.
   // It should be executed after 'InitSelectorFilter'.
   InitServiceNameInfo();
@@ -372,6 +443,21 @@ void ServiceProxy::PrepareStatistics(const std::string& service_name) {
   }
 }
 
+void ServiceProxy::InitSingleFlight() {
+  singleflight_.reset();
+  if (!option_->enable_singleflight) {
+    return;
+  }
+
+  // Followers are served by clones of the leader's response, which must be supported by the protocol.
+  if (codec_->CreateResponsePtr()->Clone() == nullptr) {
+    TRPC_FMT_WARN("service name:{}|codec name:{}|response can't be cloned, singleflight is disabled.", option_->name,
+                  codec_->Name());
+    return;
+  }
+  singleflight_ = std::make_unique<SingleFlight>(option_->name, option_->singleflight_max_wait_ms);
+}
+
 ThreadModel* ServiceProxy::GetThreadModel() {
   if (thread_model_ != nullptr) {
     return thread_model_;
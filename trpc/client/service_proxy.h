@@ -21,6 +21,7 @@
 
 #include "trpc/client/client_context.h"
 #include "trpc/client/service_proxy_option.h"
+#include "trpc/client/singleflight.h"
 #include "trpc/codec/client_codec.h"
 #include "trpc/common/future/future.h"
 #include "trpc/common/status.h"
@@ -140,6 +141,13 @@ class ServiceProxy {
   // Collect statistics on the service proxy and report them to the tvar.
   void ProxyStatistics(const ClientContextPtr& ctx);
 
+  // Create the singleflight used to coalesce identical in-flight unary calls if it is enabled.
+  void InitSingleFlight();
+
+  // Invoke unary call, sharing the result of identical in-flight calls if possible.
+  void SingleFlightUnaryInvoke(const ClientContextPtr& context, const ProtocolPtr& req, ProtocolPtr& rsp);
+  Future<ProtocolPtr> SingleFlightAsyncUnaryInvoke(const ClientContextPtr& context, const ProtocolPtr& req);
+
   // Determine if pipeline is supported.
   bool SupportPipeline(const std::shared_ptr<ServiceProxyOption>& option);
 
@@ -202,6 +210,9 @@ class ServiceProxy {
   // Count of successful backup request retries at the service level.
   std::shared_ptr<tvar::Counter<uint64_t>> backup_retries_succ_{nullptr};
 
+  // Coalesces identical in-flight unary calls, nullptr if it is disabled.
+  std::unique_ptr<SingleFlight> singleflight_{nullptr};
+
   friend class ServiceProxyManager;
 };
 
@@ -41,6 +41,9 @@ void ServiceProxyManager::SetOptionFromConfig(const ServiceProxyConfig& proxy_co
   option->is_reconnection = proxy_conf.is_reconnection;
   option->connect_timeout = proxy_conf.connect_timeout;
   option->allow_reconnect = proxy_conf.allow_reconnect;
+  option->use_method_id = proxy_conf.use_method_id;
+  option->enable_singleflight = proxy_conf.enable_singleflight;
+  option->singleflight_max_wait_ms = proxy_conf.singleflight_max_wait_ms;
   option->threadmodel_type_name = proxy_conf.threadmodel_type;
   option->threadmodel_instance_name = proxy_conf.threadmodel_instance_name;
   option->service_filters = proxy_conf.service_filters;
@@ -173,6 +173,16 @@ struct ServiceProxyOption {
   /// For scenarios where reconnection is not allowed, such as transactional operations, set this value to false.
   bool allow_reconnect{kDefaultAllowReconnect};
 
+  /// Whether to send the compact method id instead of the full function name, only used by trpc protocol.
+  /// It is negotiated per callee address, see `use_method_id` of `ServiceProxyConfig`.
+  bool use_method_id{kDefaultUseMethodId};
+
+  /// Whether to coalesce identical in-flight unary calls, later calls share the response of the first one.
+  bool enable_singleflight{kDefaultEnableSingleflight};
+
+  /// The maximum time(ms) a call waits for an identical in-flight call, 0 means bounded by its own timeout only.
+  uint32_t singleflight_max_wait_ms{kDefaultSingleflightMaxWaitMs};
+
   /// The name of the thread model type, deprecated.
   std::string threadmodel_type_name;
 
@@ -99,6 +99,9 @@ void SetDefaultOption(const std::shared_ptr<ServiceProxyOption>& option) {
   option->is_reconnection = kDefaultIsReconnection;
   option->connect_timeout = kDefaultConnectTimeout;
   option->allow_reconnect = kDefaultAllowReconnect;
+  option->use_method_id = kDefaultUseMethodId;
+  option->enable_singleflight = kDefaultEnableSingleflight;
+  option->singleflight_max_wait_ms = kDefaultSingleflightMaxWaitMs;
   option->threadmodel_type_name = kDefaultThreadmodelType;
   option->threadmodel_instance_name = "";
   option->support_pipeline = kDefaultSupportPipeline;
@@ -187,6 +190,16 @@ void SetSpecifiedOption(const ServiceProxyOption* option_ptr, const std::shared_
   auto allow_reconnect = GetValidInput<bool>(option_ptr->allow_reconnect, kDefaultAllowReconnect);
   SetOutputByValidInput<bool>(allow_reconnect, option->allow_reconnect);
 
+  auto use_method_id = GetValidInput<bool>(option_ptr->use_method_id, kDefaultUseMethodId);
+  SetOutputByValidInput<bool>(use_method_id, option->use_method_id);
+
+  auto enable_singleflight = GetValidInput<bool>(option_ptr->enable_singleflight, kDefaultEnableSingleflight);
+  SetOutputByValidInput<bool>(enable_singleflight, option->enable_singleflight);
+
+  auto singleflight_max_wait_ms =
+      GetValidInput<uint32_t>(option_ptr->singleflight_max_wait_ms, kDefaultSingleflightMaxWaitMs);
+  SetOutputByValidInput<uint32_t>(singleflight_max_wait_ms, option->singleflight_max_wait_ms);
+
   auto threadmodel_type_name = GetValidInput<std::string>(option_ptr->threadmodel_type_name, kDefaultThreadmodelType);
   SetOutputByValidInput<std::string>(threadmodel_type_name, option->threadmodel_type_name);
 
@@ -0,0 +1,181 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/client/singleflight.h"
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "trpc/common/status.h"
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+#include "trpc/util/time.h"
+
+namespace trpc {
+
+namespace {
+
+void AppendKeyField(std::string& key, uint32_t value) { key.append(reinterpret_cast<const char*>(&value), sizeof(value)); }
+
+// Fields are length prefixed, so that values containing any byte can't be confused with each other.
+void AppendKeyField(std::string& key, const std::string& value) {
+  AppendKeyField(key, static_cast<uint32_t>(value.size()));
+  key.append(value);
+}
+
+}  // namespace
+
+Future<ProtocolPtr> SingleFlight::Call::GetFuture() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (!done_) {
+    waiters_.emplace_back();
+    return waiters_.back().GetFuture();
+  }
+  lock.unlock();
+
+  if (status_.OK()) {
+    return MakeReadyFuture<ProtocolPtr>(rsp_->Clone());
+  }
+  return MakeExceptionFuture<ProtocolPtr>(
+      CommonException(status_.ErrorMessage().c_str(), status_.GetFrameworkRetCode()));
+}
+
+SingleFlight::SingleFlight(const std::string& service_name, uint32_t max_wait_ms)
+    : max_wait_ms_(max_wait_ms), coalesced_("trpc/client/" + service_name + "/singleflight_coalesced") {}
+
+bool SingleFlight::BuildKey(const ClientContextPtr& context, const ProtocolPtr& req, std::string& key) {
+  // Payloads are moved out by the getters, put them back after peeking.
+  NoncontiguousBuffer attachment = req->GetProtocolAttachment();
+  bool has_attachment = !attachment.Empty();
+  req->SetProtocolAttachment(std::move(attachment));
+  if (has_attachment) {
+    return false;
+  }
+
+  NoncontiguousBuffer body = req->GetNonContiguousProtocolBody();
+  std::size_t body_size = body.ByteSize();
+  if (body_size > kMaxRequestSize) {
+    req->SetNonContiguousProtocolBody(std::move(body));
+    return false;
+  }
+
+  // Trans info is passed through to callee and may change its response (e.g. auth token, dyeing key), so it is part
+  // of key as well. Entries are sorted since iteration order of protobuf map is unspecified.
+  const TransInfoMap& trans_info = req->GetKVInfos();
+  std::vector<const TransInfoMap::value_type*> sorted_trans_info;
+  std::size_t trans_info_size = 0;
+  sorted_trans_info.reserve(trans_info.size());
+  for (const auto& item : trans_info) {
+    sorted_trans_info.push_back(&item);
+    trans_info_size += item.first.size() + item.second.size() + 2 * sizeof(uint32_t);
+  }
+  std::sort(sorted_trans_info.begin(), sorted_trans_info.end(),
+            [](const auto* x, const auto* y) { return x->first < y->first; });
+
+  // The whole request is kept in key rather than its hash, so different requests are never mixed up.
+  const std::string& callee = req->GetCalleeName();
+  const std::string& caller = req->GetCallerName();
+  const std::string& func = req->GetFuncName();
+  key.reserve(callee.size() + caller.size() + func.size() + trans_info_size + body_size + 4 + sizeof(uint32_t));
+  key.append(callee);
+  key.push_back('\0');
+  key.append(caller);
+  key.push_back('\0');
+  key.append(func);
+  key.push_back('\0');
+  key.push_back(static_cast<char>(context->GetReqEncodeType()));
+  AppendKeyField(key, context->GetMessageType());
+  for (const auto* item : sorted_trans_info) {
+    AppendKeyField(key, item->first);
+    AppendKeyField(key, item->second);
+  }
+  for (const auto& block : body) {
+    key.append(block.data(), block.size());
+  }
+  req->SetNonContiguousProtocolBody(std::move(body));
+  return true;
+}
+
+SingleFlight::CallPtr SingleFlight::Join(const ClientContextPtr& context, const ProtocolPtr& req, bool& leader) {
+  leader = false;
+
+  std::string key;
+  if (!BuildKey(context, req, key)) {
+    return nullptr;
+  }
+
+  uint64_t now_ms = trpc::time::GetSteadyMilliSeconds();
+  uint64_t deadline_ms = now_ms + context->GetTimeout();
+  std::size_t shard_index = std::hash<std::string>{}(key) % kShardCount;
+  Shard& shard = shards_[shard_index];
+
+  std::scoped_lock lock(shard.mutex);
+  auto [iter, inserted] = shard.calls.try_emplace(std::move(key));
+  if (!inserted) {
+    const CallPtr& call = iter->second;
+    // Waiting for a leader expiring after us could fail us later than our own timeout, send it by ourselves then.
+    if (call->deadline_ms_ > deadline_ms || (max_wait_ms_ != 0 && call->deadline_ms_ > now_ms + max_wait_ms_)) {
+      return nullptr;
+    }
+    coalesced_.Increment();
+    return call;
+  }
+
+  auto call = std::make_shared<Call>();
+  call->key_ = iter->first;
+  call->shard_ = shard_index;
+  call->deadline_ms_ = deadline_ms;
+  iter->second = call;
+  leader = true;
+  return call;
+}
+
+void SingleFlight::Finish(const CallPtr& call, const Status& status, const ProtocolPtr& rsp) {
+  {
+    // Requests issued from now on start a new call.
+    Shard& shard = shards_[call->shard_];
+    std::scoped_lock lock(shard.mutex);
+    if (auto iter = shard.calls.find(call->key_); iter != shard.calls.end() && iter->second == call) {
+      shard.calls.erase(iter);
+    }
+  }
+
+  ProtocolPtr shared_rsp = (status.OK() && rsp) ? rsp->Clone() : nullptr;
+
+  std::vector<Promise<ProtocolPtr>> waiters;
+  {
+    std::scoped_lock lock(call->mutex_);
+    call->done_ = true;
+    if (shared_rsp) {
+      call->rsp_ = std::move(shared_rsp);
+    } else if (status.OK()) {
+      call->status_.SetFrameworkRetCode(TrpcRetCode::TRPC_CLIENT_DECODE_ERR);
+      call->status_.SetErrorMessage("singleflight: response of leader is not clonable");
+    } else {
+      call->status_ = status;
+    }
+    waiters.swap(call->waiters_);
+  }
+
+  for (auto& waiter : waiters) {
+    if (call->status_.OK()) {
+      waiter.SetValue(call->rsp_->Clone());
+    } else {
+      waiter.SetException(
+          CommonException(call->status_.ErrorMessage().c_str(), call->status_.GetFrameworkRetCode()));
+    }
+  }
+}
+
+}  // namespace trpc
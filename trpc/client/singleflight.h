@@ -0,0 +1,105 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "trpc/client/client_context.h"
+#include "trpc/codec/protocol.h"
+#include "trpc/common/status.h"
+#include "trpc/common/future/future.h"
+#include "trpc/tvar/basic_ops/reducer.h"
+
+namespace trpc {
+
+/// @brief Coalesces identical in-flight unary calls of a service proxy. The first call of a request (the leader) is
+///        sent to the network, the same requests issued before it finishes (the followers) wait for its result instead,
+///        and each follower gets a clone of the leader's response protocol which shares the payload buffers.
+/// @note  Requests are identical if they have the same callee, caller, function, encode type, message type, trans info
+///        and serialized body. Requests carrying an attachment or larger than `kMaxRequestSize` are never coalesced.
+///        Trans info which differs per call (e.g. a trace id added by a filter before the call is joined) therefore
+///        prevents coalescing.
+///        A follower only waits for a leader whose deadline is not later than its own and not more than `max_wait_ms`
+///        away (0 for no limit), so coalescing never makes a call wait longer than sending the request itself.
+class SingleFlight {
+ public:
+  /// Requests larger than it are sent independently, as comparing them costs more than it saves.
+  static constexpr std::size_t kMaxRequestSize = 64 * 1024;
+
+  /// @brief Shared state of an in-flight call.
+  class Call {
+   public:
+    /// @brief Returns the future of a follower, which is resolved with a clone of the leader's response, or failed with
+    ///        the error of the leader.
+    Future<ProtocolPtr> GetFuture();
+
+   private:
+    friend class SingleFlight;
+
+    std::string key_;
+    std::size_t shard_{0};
+    uint64_t deadline_ms_{0};
+
+    std::mutex mutex_;
+    bool done_{false};
+    Status status_;
+    ProtocolPtr rsp_;
+    std::vector<Promise<ProtocolPtr>> waiters_;
+  };
+
+  using CallPtr = std::shared_ptr<Call>;
+
+  /// @param service_name Name of service proxy, the count of coalesced calls is exposed as tvar
+  ///        "trpc/client/{service_name}/singleflight_coalesced".
+  SingleFlight(const std::string& service_name, uint32_t max_wait_ms);
+
+  /// @brief Joins the in-flight call of the same request, or starts a new one.
+  /// @param[out] leader Set to true if the caller should send the request and then `Finish` the call.
+  /// @return nullptr if the request can't be coalesced, the caller sends it as usual then.
+  CallPtr Join(const ClientContextPtr& context, const ProtocolPtr& req, bool& leader);
+
+  /// @brief Finishes the call by its leader and wakes the followers up.
+  /// @param rsp Response of the leader, it is cloned here so the leader is free to consume it afterwards.
+  void Finish(const CallPtr& call, const Status& status, const ProtocolPtr& rsp);
+
+  /// @brief Returns the count of calls served by another in-flight call.
+  uint64_t GetCoalescedCount() const { return coalesced_.GetValue(); }
+
+ private:
+  static constexpr std::size_t kShardCount = 16;
+
+  struct Shard {
+    std::mutex mutex;
+    std::unordered_map<std::string, CallPtr> calls;
+  };
+
+  // Builds the key of request, returns false if it shouldn't be coalesced.
+  static bool BuildKey(const ClientContextPtr& context, const ProtocolPtr& req, std::string& key);
+
+ private:
+  uint32_t max_wait_ms_;
+
+  std::array<Shard, kShardCount> shards_;
+
+  tvar::Counter<uint64_t> coalesced_;
+};
+
+}  // namespace trpc
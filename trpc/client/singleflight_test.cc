@@ -0,0 +1,245 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/client/singleflight.h"
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "trpc/codec/trpc/trpc_protocol.h"
+#include "trpc/coroutine/fiber.h"
+#include "trpc/coroutine/fiber_latch.h"
+#include "trpc/coroutine/future.h"
+#include "trpc/coroutine/testing/fiber_runtime.h"
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+
+namespace trpc::testing {
+
+namespace {
+
+ProtocolPtr MakeRequest(const std::string& func, const std::string& body) {
+  auto req = std::make_shared<TrpcRequestProtocol>();
+  req->SetCalleeName("trpc.test.helloworld.Greeter");
+  req->SetFuncName(func);
+  req->SetNonContiguousProtocolBody(CreateBufferSlow(body));
+  return req;
+}
+
+ClientContextPtr MakeContext(uint32_t timeout) {
+  auto context = MakeRefCounted<ClientContext>();
+  context->SetTimeout(timeout);
+  return context;
+}
+
+ProtocolPtr MakeResponse(const std::string& body) {
+  auto rsp = std::make_shared<TrpcResponseProtocol>();
+  rsp->rsp_header.set_request_id(1);
+  rsp->SetNonContiguousProtocolBody(CreateBufferSlow(body));
+  return rsp;
+}
+
+}  // namespace
+
+TEST(SingleFlightTest, Coalesce) {
+  SingleFlight singleflight("singleflight_test_coalesce", 0);
+
+  auto req = MakeRequest("/trpc.test.helloworld.Greeter/SayHello", "hello");
+  bool leader = false;
+  auto call = singleflight.Join(MakeContext(1000), req, leader);
+  ASSERT_TRUE(call);
+  ASSERT_TRUE(leader);
+  // Payload of request is kept.
+  ASSERT_EQ(FlattenSlow(req->GetNonContiguousProtocolBody()), "hello");
+
+  auto follower = singleflight.Join(MakeContext(2000), MakeRequest("/trpc.test.helloworld.Greeter/SayHello", "hello"),
+                                    leader);
+  ASSERT_EQ(follower, call);
+  ASSERT_FALSE(leader);
+  auto fut = follower->GetFuture();
+  ASSERT_FALSE(fut.IsReady());
+
+  // Different function or body is not coalesced.
+  auto other = singleflight.Join(MakeContext(2000), MakeRequest("/trpc.test.helloworld.Greeter/SayHi", "hello"), leader);
+  ASSERT_NE(other, call);
+  ASSERT_TRUE(leader);
+  singleflight.Finish(other, Status(), MakeResponse(""));
+
+  auto rsp = MakeResponse("world");
+  singleflight.Finish(call, Status(), rsp);
+  ASSERT_TRUE(fut.IsReady());
+  auto shared_rsp = fut.GetValue0();
+  ASSERT_NE(shared_rsp, rsp);
+  ASSERT_EQ(static_cast<TrpcResponseProtocol*>(shared_rsp.get())->rsp_header.request_id(), 1);
+
+  // Response buffer is shared rather than copied.
+  auto body = rsp->GetNonContiguousProtocolBody();
+  auto shared_body = shared_rsp->GetNonContiguousProtocolBody();
+  ASSERT_EQ(FlattenSlow(shared_body), "world");
+  ASSERT_EQ(shared_body.FirstContiguous().data(), body.FirstContiguous().data());
+
+  ASSERT_EQ(singleflight.GetCoalescedCount(), 1);
+
+  // A new call is started once the previous one finished.
+  auto next = singleflight.Join(MakeContext(1000), MakeRequest("/trpc.test.helloworld.Greeter/SayHello", "hello"),
+                                leader);
+  ASSERT_NE(next, call);
+  ASSERT_TRUE(leader);
+  singleflight.Finish(next, Status(), MakeResponse(""));
+}
+
+TEST(SingleFlightTest, Failed) {
+  SingleFlight singleflight("singleflight_test_failed", 0);
+
+  bool leader = false;
+  auto call = singleflight.Join(MakeContext(1000), MakeRequest("/trpc.test.helloworld.Greeter/SayHello", "hello"),
+                                leader);
+  auto follower = singleflight.Join(MakeContext(1000), MakeRequest("/trpc.test.helloworld.Greeter/SayHello", "hello"),
+                                    leader);
+  ASSERT_FALSE(leader);
+  auto fut = follower->GetFuture();
+
+  Status status;
+  status.SetFrameworkRetCode(TrpcRetCode::TRPC_CLIENT_NETWORK_ERR);
+  status.SetErrorMessage("network error");
+  singleflight.Finish(call, status, nullptr);
+  ASSERT_TRUE(fut.IsFailed());
+  ASSERT_EQ(fut.GetException().GetExceptionCode(), TrpcRetCode::TRPC_CLIENT_NETWORK_ERR);
+
+  // Joined before finishing but waits after it.
+  ASSERT_TRUE(follower->GetFuture().IsFailed());
+}
+
+TEST(SingleFlightTest, WaitLimit) {
+  SingleFlight singleflight("singleflight_test_wait_limit", 500);
+
+  bool leader = false;
+  auto call = singleflight.Join(MakeContext(1000), MakeRequest("/trpc.test.helloworld.Greeter/SayHello", "hello"),
+                                leader);
+  ASSERT_TRUE(leader);
+
+  // The leader expires later than the caller, or farther than `max_wait_ms`.
+  ASSERT_EQ(singleflight.Join(MakeContext(100), MakeRequest("/trpc.test.helloworld.Greeter/SayHello", "hello"),
+                              leader),
+            nullptr);
+  ASSERT_EQ(singleflight.Join(MakeContext(3000), MakeRequest("/trpc.test.helloworld.Greeter/SayHello", "hello"),
+                              leader),
+            nullptr);
+  singleflight.Finish(call, Status(), MakeResponse(""));
+
+  call = singleflight.Join(MakeContext(100), MakeRequest("/trpc.test.helloworld.Greeter/SayHello", "hello"), leader);
+  ASSERT_TRUE(leader);
+  ASSERT_EQ(singleflight.Join(MakeContext(3000), MakeRequest("/trpc.test.helloworld.Greeter/SayHello", "hello"),
+                              leader),
+            call);
+  singleflight.Finish(call, Status(), MakeResponse(""));
+  ASSERT_EQ(singleflight.GetCoalescedCount(), 1);
+}
+
+TEST(SingleFlightTest, NotCoalesced) {
+  SingleFlight singleflight("singleflight_test_not_coalesced", 0);
+
+  bool leader = true;
+  auto req = MakeRequest("/trpc.test.helloworld.Greeter/SayHello", "hello");
+  req->SetProtocolAttachment(CreateBufferSlow("attachment"));
+  ASSERT_EQ(singleflight.Join(MakeContext(1000), req, leader), nullptr);
+  ASSERT_FALSE(leader);
+  ASSERT_EQ(FlattenSlow(req->GetProtocolAttachment()), "attachment");
+
+  req = MakeRequest("/trpc.test.helloworld.Greeter/SayHello", std::string(SingleFlight::kMaxRequestSize + 1, 'a'));
+  ASSERT_EQ(singleflight.Join(MakeContext(1000), req, leader), nullptr);
+  ASSERT_EQ(req->GetNonContiguousProtocolBody().ByteSize(), SingleFlight::kMaxRequestSize + 1);
+}
+
+TEST(SingleFlightTest, TransInfo) {
+  SingleFlight singleflight("singleflight_test_trans_info", 0);
+
+  auto req = MakeRequest("/trpc.test.helloworld.Greeter/SayHello", "hello");
+  req->SetKVInfo("token", "a");
+  req->SetKVInfo("dyeing", "1");
+  bool leader = false;
+  auto call = singleflight.Join(MakeContext(1000), req, leader);
+  ASSERT_TRUE(leader);
+
+  // Same trans info is coalesced regardless of insertion order.
+  req = MakeRequest("/trpc.test.helloworld.Greeter/SayHello", "hello");
+  req->SetKVInfo("dyeing", "1");
+  req->SetKVInfo("token", "a");
+  ASSERT_EQ(singleflight.Join(MakeContext(1000), req, leader), call);
+  ASSERT_FALSE(leader);
+
+  // Different or missing trans info is not.
+  req = MakeRequest("/trpc.test.helloworld.Greeter/SayHello", "hello");
+  req->SetKVInfo("token", "b");
+  req->SetKVInfo("dyeing", "1");
+  auto other = singleflight.Join(MakeContext(1000), req, leader);
+  ASSERT_NE(other, call);
+  ASSERT_TRUE(leader);
+  singleflight.Finish(other, Status(), MakeResponse(""));
+
+  other = singleflight.Join(MakeContext(1000), MakeRequest("/trpc.test.helloworld.Greeter/SayHello", "hello"), leader);
+  ASSERT_NE(other, call);
+  ASSERT_TRUE(leader);
+  singleflight.Finish(other, Status(), MakeResponse(""));
+
+  // Nor is a different caller.
+  req = MakeRequest("/trpc.test.helloworld.Greeter/SayHello", "hello");
+  req->SetKVInfo("token", "a");
+  req->SetKVInfo("dyeing", "1");
+  req->SetCallerName("trpc.test.helloworld.Other");
+  other = singleflight.Join(MakeContext(1000), req, leader);
+  ASSERT_NE(other, call);
+  ASSERT_TRUE(leader);
+  singleflight.Finish(other, Status(), MakeResponse(""));
+
+  singleflight.Finish(call, Status(), MakeResponse(""));
+  ASSERT_EQ(singleflight.GetCoalescedCount(), 1);
+}
+
+TEST(SingleFlightTest, FiberFollowers) {
+  RunAsFiber([] {
+    SingleFlight singleflight("singleflight_test_fiber", 0);
+
+    bool leader = false;
+    auto call = singleflight.Join(MakeContext(1000), MakeRequest("/trpc.test.helloworld.Greeter/SayHello", "hello"),
+                                  leader);
+    ASSERT_TRUE(leader);
+
+    constexpr int kFollowers = 100;
+    FiberLatch joined(kFollowers);
+    FiberLatch done(kFollowers);
+    for (int i = 0; i < kFollowers; ++i) {
+      StartFiberDetached([&] {
+        bool leader = true;
+        auto follower = singleflight.Join(
+            MakeContext(1000), MakeRequest("/trpc.test.helloworld.Greeter/SayHello", "hello"), leader);
+        EXPECT_FALSE(leader);
+        auto fut = follower->GetFuture();
+        joined.CountDown();
+        auto rsp = fiber::BlockingGet(std::move(fut)).GetValue0();
+        EXPECT_EQ(FlattenSlow(rsp->GetNonContiguousProtocolBody()), "world");
+        done.CountDown();
+      });
+    }
+    joined.Wait();
+    singleflight.Finish(call, Status(), MakeResponse("world"));
+    done.Wait();
+    ASSERT_EQ(singleflight.GetCoalescedCount(), kFollowers);
+  });
+}
+
+}  // namespace trpc::testing
@@ -0,0 +1,81 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace trpc {
+
+/// @brief Get the numeric id of rpc method by its full name (e.g. "/trpc.test.helloworld.Greeter/SayHello").
+///        The id only depends on the name, so the code generator, clients and servers get the same id without any
+///        registry. 0 is never returned and means "no id".
+constexpr uint32_t GetMethodId(std::string_view func_name) {
+  // 32 bits FNV-1a.
+  uint32_t hash = 2166136261u;
+  for (char c : func_name) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 16777619u;
+  }
+  return hash != 0 ? hash : 1;
+}
+
+/// @brief Leading character of compact function name, which carries the method id instead of the full name on wire.
+///        Full names always start with '/', so they never conflict.
+constexpr char kCompactFuncNamePrefix = '#';
+
+/// @brief Trans info key to negotiate compact function names: clients willing to send them carry it in requests, and
+///        servers understanding them echo it in responses. Compact names are only sent to peers which echoed it.
+constexpr char kMethodIdTransInfoKey[] = "trpc-method-id";
+
+/// @brief Length of compact function name: the prefix followed by 8 hex digits of method id.
+constexpr std::size_t kCompactFuncNameSize = 9;
+
+/// @brief Encode method id into compact function name, e.g. "#1a2b3c4d".
+inline std::string ToCompactFuncName(uint32_t method_id) {
+  constexpr char kHex[] = "0123456789abcdef";
+  std::string name(kCompactFuncNameSize, kCompactFuncNamePrefix);
+  for (std::size_t i = kCompactFuncNameSize - 1; i > 0; --i) {
+    name[i] = kHex[method_id & 0xf];
+    method_id >>= 4;
+  }
+  return name;
+}
+
+/// @brief Decode method id from compact function name.
+/// @return false if func_name is not a compact function name.
+inline bool ParseCompactFuncName(std::string_view func_name, uint32_t* method_id) {
+  if (func_name.size() != kCompactFuncNameSize || func_name[0] != kCompactFuncNamePrefix) {
+    return false;
+  }
+  uint32_t id = 0;
+  for (std::size_t i = 1; i < kCompactFuncNameSize; ++i) {
+    char c = func_name[i];
+    uint32_t digit = 0;
+    if (c >= '0' && c <= '9') {
+      digit = c - '0';
+    } else if (c >= 'a' && c <= 'f') {
+      digit = c - 'a' + 10;
+    } else {
+      return false;
+    }
+    id = (id << 4) | digit;
+  }
+  *method_id = id;
+  return true;
+}
+
+}  // namespace trpc
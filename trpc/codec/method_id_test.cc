@@ -0,0 +1,45 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/codec/method_id.h"
+
+#include "gtest/gtest.h"
+
+namespace trpc::testing {
+
+TEST(MethodIdTest, GetMethodId) {
+  constexpr uint32_t kId = GetMethodId("/trpc.test.helloworld.Greeter/SayHello");
+  static_assert(kId != 0);
+  ASSERT_EQ(GetMethodId("/trpc.test.helloworld.Greeter/SayHello"), kId);
+  ASSERT_NE(GetMethodId("/trpc.test.helloworld.Greeter/SayHi"), kId);
+  // FNV-1a of empty string is its offset basis.
+  ASSERT_EQ(GetMethodId(""), 2166136261u);
+}
+
+TEST(MethodIdTest, CompactFuncName) {
+  ASSERT_EQ(ToCompactFuncName(0x1a2b3c4d), "#1a2b3c4d");
+  ASSERT_EQ(ToCompactFuncName(1), "#00000001");
+
+  uint32_t id = 0;
+  ASSERT_TRUE(ParseCompactFuncName("#1a2b3c4d", &id));
+  ASSERT_EQ(id, 0x1a2b3c4d);
+  ASSERT_TRUE(ParseCompactFuncName(ToCompactFuncName(0xffffffff), &id));
+  ASSERT_EQ(id, 0xffffffff);
+
+  ASSERT_FALSE(ParseCompactFuncName("/trpc.test.helloworld.Greeter/SayHello", &id));
+  ASSERT_FALSE(ParseCompactFuncName("#1a2b3c4", &id));
+  ASSERT_FALSE(ParseCompactFuncName("#1a2b3c4g", &id));
+  ASSERT_FALSE(ParseCompactFuncName("#1A2B3C4D", &id));
+}
+
+}  // namespace trpc::testing
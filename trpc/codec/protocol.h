@@ -134,6 +134,10 @@ class Protocol {
   /// taken into consideration in order to implement this.
   virtual bool IsConnectionReusable() const { return true; }
 
+  /// @brief Returns a copy of protocol message whose body and attachment share the buffers of this one (no payload bytes
+  ///        are copied), or nullptr if the specific protocol doesn't support it.
+  virtual std::shared_ptr<Protocol> Clone() const { return nullptr; }
+
  private:
   uint32_t timeout_{UINT32_MAX};
   std::string caller_;
@@ -23,6 +23,7 @@
 #include "trpc/runtime/iomodel/reactor/common/connection.h"
 #include "trpc/util/buffer/noncontiguous_buffer.h"
 #include "trpc/util/ref_ptr.h"
+#include "trpc/util/request_arena.h"
 
 namespace trpc {
 
@@ -70,6 +71,13 @@ class ServerCodec {
   /// @brief Creates a protocol object of response.
   virtual ProtocolPtr CreateResponseObject() = 0;
 
+  /// @brief Creates a protocol object of request whose memory comes from the arena of the request, so that it is
+  ///        released along with the request instead of by its own free. Falls back to `CreateRequestObject()`.
+  virtual ProtocolPtr CreateRequestObjectInArena(const RequestArenaPtr& arena) { return CreateRequestObject(); }
+
+  /// @brief Creates a protocol object of response in the arena of the request, see `CreateRequestObjectInArena`.
+  virtual ProtocolPtr CreateResponseObjectInArena(const RequestArenaPtr& arena) { return CreateResponseObject(); }
+
   /// @brief Extracts metadata of protocol message, e.g. frame-type of data, stream-id, frame-type of stream.
   virtual bool Pick(const std::any& message, std::any& data) const { return false; }
 
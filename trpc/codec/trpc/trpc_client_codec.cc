@@ -13,19 +13,46 @@
 
 #include "trpc/codec/trpc/trpc_client_codec.h"
 
+#include <functional>
 #include <memory>
+#include <string>
 #include <utility>
 
 #include "trpc/codec/codec_helper.h"
+#include "trpc/codec/method_id.h"
 #include "trpc/codec/trpc/trpc_proto_checker.h"
 #include "trpc/codec/trpc/trpc_protocol.h"
 #include "trpc/compressor/trpc_compressor.h"
+#include "trpc/compressor/zstd/zstd_dictionary.h"
 #include "trpc/serialization/serialization_factory.h"
 #include "trpc/util/buffer/zero_copy_stream.h"
 #include "trpc/util/log/logging.h"
 
 namespace trpc {
 
+namespace {
+
+uint64_t HashCombine(uint64_t hash, uint64_t value) {
+  return hash ^ ((value + 0x9e3779b97f4a7c15ULL) + (hash << 6) + (hash >> 2));
+}
+
+// Never 0, which marks an empty slot of `method_id_peers_`.
+uint64_t GetPeerFingerprint(const ClientContextPtr& context) {
+  const NodeAddr& addr = context->GetNodeAddr();
+  return HashCombine(std::hash<std::string>{}(addr.ip), addr.port) | 1;
+}
+
+// Fingerprints of `zstd_dictionary_peers_`, never 0 either.
+uint64_t GetZstdPeerFingerprint(const ClientContextPtr& context, uint32_t dict_id) {
+  return HashCombine(GetPeerFingerprint(context), dict_id) | 1;
+}
+
+uint64_t GetZstdCalleeFingerprint(const ClientContextPtr& context, uint32_t dict_id) {
+  return HashCombine(std::hash<std::string>{}(context->GetCalleeName()), dict_id) | 1;
+}
+
+}  // namespace
+
 int TrpcClientCodec::ZeroCopyCheck(const ConnectionPtr& conn, NoncontiguousBuffer& in, std::deque<std::any>& out) {
   return CheckTrpcProtocolMessage(conn, in, out);
 }
@@ -38,7 +65,112 @@ bool TrpcClientCodec::ZeroCopyDecode(const ClientContextPtr& context, std::any&&
 bool TrpcClientCodec::ZeroCopyEncode(const ClientContextPtr& context, const ProtocolPtr& in, NoncontiguousBuffer& out) {
   auto* trpc_req = static_cast<TrpcRequestProtocol*>(in.get());
   FillTrpcRequestHeader(context, trpc_req);
-  return trpc_req->ZeroCopyEncode(out);
+  if (trpc_req->req_header.content_encoding() == compressor::kZstd && !DropZstdDictionaryIfNeeded(context, trpc_req)) {
+    return false;
+  }
+
+  const ServiceProxyOption* option = context->GetServiceProxyOption();
+  if (option == nullptr || !option->use_method_id || trpc_req->req_header.func().empty()) {
+    return trpc_req->ZeroCopyEncode(out);
+  }
+
+  // Only the encoded packet carries the negotiation flag or the compact name, filters and metrics see neither.
+  auto* trans_info = trpc_req->req_header.mutable_trans_info();
+  if (!IsMethodIdPeer(context)) {
+    // The peer may not understand compact names, send the full one and ask for it.
+    (*trans_info)[kMethodIdTransInfoKey] = "1";
+    bool ret = trpc_req->ZeroCopyEncode(out);
+    trans_info->erase(kMethodIdTransInfoKey);
+    return ret;
+  }
+
+  uint32_t method_id = context->GetMethodId();
+  if (method_id == 0) {
+    method_id = GetMethodId(trpc_req->req_header.func());
+  }
+  std::string func_name = std::move(*trpc_req->req_header.mutable_func());
+  trpc_req->req_header.set_func(ToCompactFuncName(method_id));
+  bool ret = trpc_req->ZeroCopyEncode(out);
+  trpc_req->req_header.set_func(std::move(func_name));
+  return ret;
+}
+
+bool TrpcClientCodec::IsMethodIdPeer(const ClientContextPtr& context) const {
+  uint64_t peer = GetPeerFingerprint(context);
+  return method_id_peers_[peer % kMethodIdPeerSlots].load(std::memory_order_relaxed) == peer;
+}
+
+void TrpcClientCodec::UpdateMethodIdPeer(const ClientContextPtr& context, const TrpcResponseProtocol* rsp) {
+  const ServiceProxyOption* option = context->GetServiceProxyOption();
+  if (option == nullptr || !option->use_method_id) {
+    return;
+  }
+
+  const auto& rsp_header = rsp->rsp_header;
+  bool advertised = rsp_header.trans_info().find(kMethodIdTransInfoKey) != rsp_header.trans_info().end();
+  // A peer restarted with an old version at the same address does not know compact names any more.
+  bool rejected = rsp_header.ret() == TrpcRetCode::TRPC_SERVER_NOFUNC_ERR;
+  if (!advertised && !rejected) {
+    return;
+  }
+
+  uint64_t peer = GetPeerFingerprint(context);
+  auto& slot = method_id_peers_[peer % kMethodIdPeerSlots];
+  if (advertised) {
+    if (slot.load(std::memory_order_relaxed) != peer) {
+      slot.store(peer, std::memory_order_relaxed);
+    }
+  } else {
+    // Leave the slot alone if it is taken by another peer.
+    slot.compare_exchange_strong(peer, 0, std::memory_order_relaxed);
+  }
+}
+
+bool TrpcClientCodec::IsZstdDictionaryPeer(uint64_t fingerprint) const {
+  return zstd_dictionary_peers_[fingerprint % kZstdDictionaryPeerSlots].load(std::memory_order_relaxed) == fingerprint;
+}
+
+bool TrpcClientCodec::DropZstdDictionaryIfNeeded(const ClientContextPtr& context, TrpcRequestProtocol* req) {
+  uint32_t dict_id = compressor::zstd::GetFrameDictionary(req->req_body);
+  if (dict_id == 0 || IsZstdDictionaryPeer(GetZstdPeerFingerprint(context, dict_id))) {
+    return true;
+  }
+
+  // The peer may not have our dictionary, compress the body again without it.
+  NoncontiguousBuffer data;
+  if (!compressor::Decompress(compressor::kZstd, req->req_body, data)) {
+    return false;
+  }
+  compressor::zstd::ScopedNoDictionary no_dictionary;
+  NoncontiguousBuffer out;
+  if (!compressor::Compress(compressor::kZstd, data, out, context->GetReqCompressLevel())) {
+    return false;
+  }
+  req->req_body = std::move(out);
+  return true;
+}
+
+void TrpcClientCodec::UpdateZstdDictionaryPeer(const ClientContextPtr& context, const TrpcResponseProtocol* rsp) {
+  uint32_t dict_id = compressor::zstd::GetDefaultDictionary();
+  // Only requests compressed by zstd ask the callee for our dictionary.
+  if (dict_id == 0 || context->GetReqCompressType() != compressor::kZstd) {
+    return;
+  }
+
+  const auto& trans_info = rsp->rsp_header.trans_info();
+  auto it = trans_info.find(compressor::zstd::kDictionaryAckKey);
+  bool confirmed = it != trans_info.end() && it->second == std::to_string(dict_id);
+  for (uint64_t fingerprint : {GetZstdPeerFingerprint(context, dict_id), GetZstdCalleeFingerprint(context, dict_id)}) {
+    auto& slot = zstd_dictionary_peers_[fingerprint % kZstdDictionaryPeerSlots];
+    if (confirmed) {
+      if (slot.load(std::memory_order_relaxed) != fingerprint) {
+        slot.store(fingerprint, std::memory_order_relaxed);
+      }
+    } else {
+      // E.g. the peer restarted without the dictionary, leave the slot alone if it is taken by another one.
+      slot.compare_exchange_strong(fingerprint, 0, std::memory_order_relaxed);
+    }
+  }
 }
 
 void TrpcClientCodec::FillTrpcRequestHeader(const ClientContextPtr& context, TrpcRequestProtocol* req) {
@@ -86,11 +218,26 @@ bool TrpcClientCodec::FillRequest(const ClientContextPtr& context, const Protoco
   }
 
   auto compress_type = context->GetReqCompressType();
-  bool compress_ret = compressor::CompressIfNeeded(compress_type, data, context->GetReqCompressLevel());
+  uint32_t dict_id = compressor::zstd::GetDefaultDictionary();
+  // Requests are compressed by our dictionary only after the callee confirms it has the dictionary. The peer is not
+  // selected yet, so it's decided by whether any instance of the callee has confirmed, peers not confirmed yet get the
+  // request compressed again without dictionary in `ZeroCopyEncode`.
+  compressor::zstd::ScopedNoDictionary no_dictionary(
+      compress_type == compressor::kZstd && dict_id != 0 &&
+      !IsZstdDictionaryPeer(GetZstdCalleeFingerprint(context, dict_id)));
+  bool compress_ret = compressor::AdaptiveCompressIfNeeded(compress_type, data, context->GetReqCompressLevel(),
+                                                           context->GetFuncName());
   if (TRPC_UNLIKELY(!compress_ret)) {
     context->SetStatus(Status(GetDefaultClientRetCode(codec::ClientRetCode::ENCODE_ERROR), "compress failed."));
     return compress_ret;
   }
+  // It's kNone if the request is not worth compressing.
+  context->SetReqCompressType(compress_type);
+  if (compress_type == compressor::kZstd && dict_id != 0) {
+    // Tells the callee which dictionary we have, the response is compressed by its dictionary only if it's the same,
+    // and the callee confirms it if it has the dictionary too.
+    context->AddReqTransInfo(compressor::zstd::kDictionaryIdKey, std::to_string(dict_id));
+  }
   trpc_req_protocol->SetNonContiguousProtocolBody(std::move(data));
 
   return true;
@@ -108,6 +255,8 @@ bool TrpcClientCodec::FillResponse(const ClientContextPtr& context, const Protoc
   TRPC_ASSERT(trpc_rsp_protocol);
 
   FillResponseContext(context, trpc_rsp_protocol);
+  UpdateMethodIdPeer(context, trpc_rsp_protocol);
+  UpdateZstdDictionaryPeer(context, trpc_rsp_protocol);
 
   const auto& rsp_header = trpc_rsp_protocol->rsp_header;
 
@@ -14,6 +14,9 @@
 #pragma once
 
 #include <any>
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <deque>
 #include <string>
 
@@ -105,6 +108,26 @@ class TrpcClientCodec : public ClientCodec {
   bool ProcessTransparentReq(TrpcRequestProtocol* req_protocol, void* body);
   bool ProcessTransparentRsp(TrpcResponseProtocol* rsp_protocol, void* body);
   void FillResponseContext(const ClientContextPtr& context, TrpcResponseProtocol* rsp);
+  bool IsMethodIdPeer(const ClientContextPtr& context) const;
+  void UpdateMethodIdPeer(const ClientContextPtr& context, const TrpcResponseProtocol* rsp);
+  bool IsZstdDictionaryPeer(uint64_t fingerprint) const;
+  bool DropZstdDictionaryIfNeeded(const ClientContextPtr& context, TrpcRequestProtocol* req);
+  void UpdateZstdDictionaryPeer(const ClientContextPtr& context, const TrpcResponseProtocol* rsp);
+
+ private:
+  static constexpr std::size_t kMethodIdPeerSlots = 4096;
+
+  // Fingerprints of peers which advertised that they understand compact function names, see `kMethodIdTransInfoKey`.
+  // A peer takes the slot its fingerprint maps to, a colliding peer evicts it and the evicted one negotiates again, so
+  // the table stays bounded however peers churn, and looking up a peer neither allocates nor locks.
+  std::array<std::atomic<uint64_t>, kMethodIdPeerSlots> method_id_peers_{};
+
+  static constexpr std::size_t kZstdDictionaryPeerSlots = 4096;
+
+  // Fingerprints of peers and callees which confirmed that they have our zstd dictionary, see
+  // `compressor::zstd::kDictionaryAckKey`. Works the same as `method_id_peers_`, a fingerprint also covers the ID of
+  // dictionary, so peers are confirmed again after the dictionary changes.
+  std::array<std::atomic<uint64_t>, kZstdDictionaryPeerSlots> zstd_dictionary_peers_{};
 };
 
 }  // namespace trpc
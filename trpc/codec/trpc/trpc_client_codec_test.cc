@@ -0,0 +1,209 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/codec/trpc/trpc_client_codec.h"
+
+#include <memory>
+#include <random>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "trpc/client/client_context.h"
+#include "trpc/client/service_proxy_option.h"
+#include "trpc/codec/method_id.h"
+#include "trpc/codec/trpc/trpc_protocol.h"
+#include "trpc/compressor/compressor_factory.h"
+#include "trpc/compressor/testing/zstd_testing.h"
+#include "trpc/compressor/trpc_compressor.h"
+#include "trpc/compressor/zstd/zstd_compressor.h"
+#include "trpc/compressor/zstd/zstd_dictionary.h"
+#include "trpc/serialization/noop/noop_serialization.h"
+#include "trpc/serialization/serialization_factory.h"
+
+namespace trpc::testing {
+
+class TrpcClientCodecTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    codec_ = std::make_shared<TrpcClientCodec>();
+    option_.use_method_id = true;
+  }
+
+  ClientContextPtr MakeContext() {
+    auto context = MakeRefCounted<ClientContext>(codec_);
+    context->SetServiceProxyOption(&option_);
+    context->SetAddr("127.0.0.1", 10001);
+    context->SetFuncName(kFuncName);
+    return context;
+  }
+
+  // Encode request of context and decode what is sent on wire.
+  TrpcRequestProtocol Send(const ClientContextPtr& context) {
+    NoncontiguousBuffer buff;
+    EXPECT_TRUE(codec_->ZeroCopyEncode(context, context->GetRequest(), buff));
+    TrpcRequestProtocol req;
+    EXPECT_TRUE(req.ZeroCopyDecode(buff));
+    return req;
+  }
+
+  // Feed a failed response to client codec, so that response body is not decoded.
+  void Receive(const ClientContextPtr& context, bool advertise_method_id, int ret) {
+    ProtocolPtr rsp = codec_->CreateResponsePtr();
+    auto* trpc_rsp = static_cast<TrpcResponseProtocol*>(rsp.get());
+    if (advertise_method_id) {
+      (*trpc_rsp->rsp_header.mutable_trans_info())[kMethodIdTransInfoKey] = "1";
+    }
+    trpc_rsp->rsp_header.set_ret(ret);
+    trpc_rsp->rsp_header.set_func_ret(1);
+    NoncontiguousBuffer body;
+    ASSERT_FALSE(codec_->FillResponse(context, rsp, &body));
+  }
+
+  // Feed a failed response to client codec, with the zstd dictionary confirmed by the callee if `ack` is not empty.
+  void ReceiveZstdAck(const ClientContextPtr& context, const std::string& ack) {
+    ProtocolPtr rsp = codec_->CreateResponsePtr();
+    auto* trpc_rsp = static_cast<TrpcResponseProtocol*>(rsp.get());
+    if (!ack.empty()) {
+      (*trpc_rsp->rsp_header.mutable_trans_info())[compressor::zstd::kDictionaryAckKey] = ack;
+    }
+    trpc_rsp->rsp_header.set_func_ret(1);
+    NoncontiguousBuffer body;
+    ASSERT_FALSE(codec_->FillResponse(context, rsp, &body));
+  }
+
+  static constexpr char kFuncName[] = "/trpc.test.helloworld.Greeter/SayHello";
+
+  std::shared_ptr<TrpcClientCodec> codec_;
+  ServiceProxyOption option_;
+};
+
+TEST_F(TrpcClientCodecTest, NegotiateMethodId) {
+  // Peer is unknown, full name is sent along with negotiation flag.
+  auto context = MakeContext();
+  auto req = Send(context);
+  ASSERT_EQ(req.req_header.func(), kFuncName);
+  ASSERT_EQ(req.req_header.trans_info().count(kMethodIdTransInfoKey), 1);
+  // Flag is not left in request of user.
+  ASSERT_EQ(context->GetPbReqTransInfo().count(kMethodIdTransInfoKey), 0);
+
+  // Peer does not echo the flag, keep sending full name.
+  Receive(context, false, 0);
+  req = Send(MakeContext());
+  ASSERT_EQ(req.req_header.func(), kFuncName);
+
+  // Peer echoes the flag, compact name is sent from now on.
+  Receive(context, true, 0);
+  context = MakeContext();
+  req = Send(context);
+  ASSERT_EQ(req.req_header.func(), ToCompactFuncName(GetMethodId(kFuncName)));
+  ASSERT_EQ(req.req_header.trans_info().count(kMethodIdTransInfoKey), 0);
+  // Filters still see the full name.
+  ASSERT_EQ(context->GetFuncName(), kFuncName);
+
+  // Another peer is still unknown.
+  context = MakeContext();
+  context->SetAddr("127.0.0.1", 10002);
+  ASSERT_EQ(Send(context).req_header.func(), kFuncName);
+
+  // Peer rejects compact name (e.g. restarted with old version), fall back to full name.
+  context = MakeContext();
+  Receive(context, false, TrpcRetCode::TRPC_SERVER_NOFUNC_ERR);
+  ASSERT_EQ(Send(MakeContext()).req_header.func(), kFuncName);
+}
+
+TEST_F(TrpcClientCodecTest, MethodIdManyPeers) {
+  // Peers beyond the capacity evict each other, an evicted peer is just sent full name until negotiated again.
+  for (uint16_t port = 20000; port < 30000; ++port) {
+    auto context = MakeContext();
+    context->SetAddr("127.0.0.2", port);
+    Receive(context, true, 0);
+    context = MakeContext();
+    context->SetAddr("127.0.0.2", port);
+    ASSERT_EQ(Send(context).req_header.func(), ToCompactFuncName(GetMethodId(kFuncName)));
+  }
+}
+
+TEST_F(TrpcClientCodecTest, ZstdDictionaryMismatch) {
+  compressor::CompressorFactory::GetInstance()->Register(MakeRefCounted<compressor::ZstdCompressor>());
+  serialization::SerializationFactory::GetInstance()->Register(MakeRefCounted<serialization::NoopSerialization>());
+
+  // Caller and callee are deployed with different dictionaries.
+  std::string dict = compressor::testing::TrainZstdDictionary(8 * 1024);
+  std::string callee_dict = compressor::testing::TrainZstdDictionary(4 * 1024);
+  uint32_t dict_id = compressor::zstd::AddDictionary(dict);
+  ASSERT_NE(dict_id, 0);
+  ASSERT_TRUE(compressor::zstd::SetDefaultDictionary(dict_id));
+
+  std::mt19937 rng(0);
+  std::string msg = compressor::testing::GenMessageLikeStr(rng);
+  // Returns the ID of dictionary compressing the request on wire, the callee must be able to decompress it.
+  auto send = [&](const ClientContextPtr& context) -> uint32_t {
+    context->SetReqEncodeType(serialization::kNoopType);
+    context->SetReqEncodeDataType(serialization::kNonContiguousBufferNoop);
+    context->SetReqCompressType(compressor::kZstd);
+    NoncontiguousBuffer body = CreateBufferSlow(msg);
+    EXPECT_TRUE(codec_->FillRequest(context, context->GetRequest(), &body));
+    auto req = Send(context);
+    EXPECT_EQ(req.req_header.trans_info().at(compressor::zstd::kDictionaryIdKey), std::to_string(dict_id));
+
+    body = req.GetNonContiguousProtocolBody();
+    uint32_t frame_dict_id = compressor::zstd::GetFrameDictionary(body);
+    compressor::zstd::ClearDictionaries();
+    EXPECT_NE(compressor::zstd::AddDictionary(callee_dict), 0);
+    if (frame_dict_id != dict_id) {
+      EXPECT_TRUE(compressor::DecompressIfNeeded(compressor::kZstd, body));
+      EXPECT_EQ(FlattenSlow(body), msg);
+    }
+    compressor::zstd::ClearDictionaries();
+    compressor::zstd::AddDictionary(dict);
+    compressor::zstd::SetDefaultDictionary(dict_id);
+    return frame_dict_id;
+  };
+
+  // The callee does not confirm our dictionary.
+  auto context = MakeContext();
+  ASSERT_EQ(send(context), 0);
+  ReceiveZstdAck(context, "");
+  context = MakeContext();
+  ASSERT_EQ(send(context), 0);
+
+  // Another instance of the callee has our dictionary, requests to it are compressed by the dictionary from now on.
+  context->SetAddr("127.0.0.1", 10002);
+  ReceiveZstdAck(context, std::to_string(dict_id));
+  context = MakeContext();
+  context->SetAddr("127.0.0.1", 10002);
+  ASSERT_EQ(send(context), dict_id);
+  // The one without our dictionary is still sent requests without dictionary.
+  ASSERT_EQ(send(MakeContext()), 0);
+
+  // The instance restarts with another dictionary.
+  ReceiveZstdAck(context, "");
+  context = MakeContext();
+  context->SetAddr("127.0.0.1", 10002);
+  ASSERT_EQ(send(context), 0);
+
+  compressor::zstd::ClearDictionaries();
+  compressor::CompressorFactory::GetInstance()->Clear();
+}
+
+TEST_F(TrpcClientCodecTest, MethodIdDisabled) {
+  option_.use_method_id = false;
+  auto context = MakeContext();
+  Receive(context, true, 0);
+  auto req = Send(MakeContext());
+  ASSERT_EQ(req.req_header.func(), kFuncName);
+  ASSERT_EQ(req.req_header.trans_info().count(kMethodIdTransInfoKey), 0);
+}
+
+}  // namespace trpc::testing
@@ -189,6 +189,9 @@ class TrpcResponseProtocol : public Protocol {
   /// @brief Get size of message
   uint32_t GetMessageSize() const override;
 
+  /// @brief Copies the response message, body and attachment are shared with this one rather than copied.
+  ProtocolPtr Clone() const override { return std::make_shared<TrpcResponseProtocol>(*this); }
+
  public:
   // Fixed 16-bytes header of `trpc` protocol.
   TrpcFixedHeader fixed_header;
@@ -14,10 +14,13 @@
 #include "trpc/codec/trpc/trpc_server_codec.h"
 
 #include <memory>
+#include <string_view>
 #include <utility>
 
 #include "trpc/codec/trpc/trpc_proto_checker.h"
 #include "trpc/codec/trpc/trpc_protocol.h"
+#include "trpc/compressor/compressor_type.h"
+#include "trpc/compressor/zstd/zstd_dictionary.h"
 #include "trpc/util/log/logging.h"
 
 namespace trpc {
@@ -51,11 +54,21 @@ bool TrpcServerCodec::ZeroCopyDecode(const ServerContextPtr& context, std::any&&
 
     auto* rsp_trans_info = rsp->rsp_header.mutable_trans_info();
     const auto& req_trans_info = out->GetKVInfos();
+    auto dict_it = req_trans_info.find(compressor::zstd::kDictionaryIdKey);
+    std::string_view peer_dict_id = dict_it != req_trans_info.end() ? std::string_view(dict_it->second) : "";
+    if (context->GetReqCompressType() == compressor::kZstd && !compressor::zstd::CanPeerDecompress(peer_dict_id)) {
+      // Responds without compression if the caller can't decompress data compressed by our dictionary.
+      context->SetRspCompressType(compressor::kNone);
+    }
     auto it = req_trans_info.begin();
     while (it != req_trans_info.end()) {
       (*rsp_trans_info)[it->first] = it->second;
       ++it;
     }
+    if (compressor::zstd::HasPeerDictionary(peer_dict_id)) {
+      // So the caller compresses requests by its dictionary from now on.
+      (*rsp_trans_info)[compressor::zstd::kDictionaryAckKey] = peer_dict_id;
+    }
   }
 
   // No response if it has a decoded failure.
@@ -92,6 +105,14 @@ ProtocolPtr TrpcServerCodec::CreateRequestObject() { return std::make_shared<Trp
 
 ProtocolPtr TrpcServerCodec::CreateResponseObject() { return std::make_shared<TrpcResponseProtocol>(); }
 
+ProtocolPtr TrpcServerCodec::CreateRequestObjectInArena(const RequestArenaPtr& arena) {
+  return std::allocate_shared<TrpcRequestProtocol>(RequestArenaAllocator<TrpcRequestProtocol>(arena));
+}
+
+ProtocolPtr TrpcServerCodec::CreateResponseObjectInArena(const RequestArenaPtr& arena) {
+  return std::allocate_shared<TrpcResponseProtocol>(RequestArenaAllocator<TrpcResponseProtocol>(arena));
+}
+
 bool TrpcServerCodec::Pick(const std::any& message, std::any& data) const {
   return PickTrpcProtocolMessageMetadata(message, data);
 }
@@ -62,6 +62,12 @@ class TrpcServerCodec : public ServerCodec {
   /// @brief Creates a protocol object of response (unary call).
   ProtocolPtr CreateResponseObject() override;
 
+  /// @brief Creates a protocol object of request (unary call) in the arena of the request.
+  ProtocolPtr CreateRequestObjectInArena(const RequestArenaPtr& arena) override;
+
+  /// @brief Creates a protocol object of response (unary call) in the arena of the request.
+  ProtocolPtr CreateResponseObjectInArena(const RequestArenaPtr& arena) override;
+
   /// @brief Extracts metadata of protocol message, e.g. frame-type of data, stream-id, frame-type of stream.
   bool Pick(const std::any& message, std::any& data) const override;
 
@@ -14,12 +14,15 @@
 #include "trpc/codec/trpc/trpc_server_codec.h"
 
 #include <memory>
+#include <string>
 #include <utility>
 
 #include "gtest/gtest.h"
 
 #include "trpc/codec/trpc/testing/trpc_protocol_testing.h"
 #include "trpc/codec/trpc/trpc_protocol.h"
+#include "trpc/compressor/testing/zstd_testing.h"
+#include "trpc/compressor/zstd/zstd_dictionary.h"
 #include "trpc/server/server_context.h"
 
 namespace trpc::testing {
@@ -73,6 +76,33 @@ TEST_F(TrpcServerCodecTest, TrpcServerCodecDecode) {
   ASSERT_EQ(req_atta_size, context->GetRequestAttachment().ByteSize());
 }
 
+TEST_F(TrpcServerCodecTest, TrpcServerCodecDecodeInArena) {
+  TrpcRequestProtocol req;
+  req.SetProtocolAttachment(trpc::CreateBufferSlow("test"));
+  FillTrpcRequestProtocolData(req);
+  NoncontiguousBuffer buff;
+  ASSERT_TRUE(req.ZeroCopyEncode(buff));
+
+  RequestArenaPtr arena = RequestArena::Create();
+  ServerContextPtr context = MakeServerContextInArena(arena);
+  context->SetRequestMsg(codec_.CreateRequestObjectInArena(arena));
+  context->SetResponseMsg(codec_.CreateResponseObjectInArena(arena));
+  ASSERT_EQ(&context->GetArena(), arena.Get());
+  ASSERT_GE(arena->UsedBytes(), sizeof(ServerContext) + sizeof(TrpcRequestProtocol) + sizeof(TrpcResponseProtocol));
+
+  ASSERT_TRUE(codec_.ZeroCopyDecode(context, std::move(buff), context->GetRequestMsg()));
+  ASSERT_EQ(4, context->GetRequestAttachment().ByteSize());
+
+  // Protocol objects keep the arena alive after the context is gone.
+  ProtocolPtr rsp = context->GetResponseMsg();
+  context = nullptr;
+  arena = nullptr;
+  uint32_t id = 0;
+  ASSERT_TRUE(rsp->SetRequestId(1));
+  ASSERT_TRUE(rsp->GetRequestId(id));
+  ASSERT_EQ(1, id);
+}
+
 TEST_F(TrpcServerCodecTest, TrpcServerCodecDecode_Fail) {
   TrpcRequestProtocol req;
   auto req_atta = trpc::CreateBufferSlow("test");
@@ -141,4 +171,64 @@ TEST_F(TrpcServerCodecTest, HasStreamingRpcWithTrue) { ASSERT_TRUE(codec_.HasStr
 
 TEST_F(TrpcServerCodecTest, IsStreamingProtocolWithFalse) { ASSERT_FALSE(codec_.IsStreamingProtocol()); }
 
+TEST_F(TrpcServerCodecTest, ZstdDictionaryNegotiation) {
+  uint32_t dict_id = compressor::zstd::AddDictionary(compressor::testing::TrainZstdDictionary());
+  ASSERT_TRUE(compressor::zstd::SetDefaultDictionary(dict_id));
+
+  auto get_rsp_compress_type = [this](const std::string& peer_dict_id) {
+    TrpcRequestProtocol req;
+    FillTrpcRequestProtocolData(req);
+    req.req_header.set_content_encoding(compressor::kZstd);
+    if (!peer_dict_id.empty()) {
+      (*req.req_header.mutable_trans_info())[compressor::zstd::kDictionaryIdKey] = peer_dict_id;
+    }
+    NoncontiguousBuffer buff;
+    EXPECT_TRUE(req.ZeroCopyEncode(buff));
+
+    ServerContextPtr context = MakeRefCounted<ServerContext>();
+    context->SetRequestMsg(codec_.CreateRequestObject());
+    context->SetResponseMsg(codec_.CreateResponseObject());
+    EXPECT_TRUE(codec_.ZeroCopyDecode(context, std::move(buff), context->GetRequestMsg()));
+    return context->GetRspCompressType();
+  };
+
+  ASSERT_EQ(get_rsp_compress_type(std::to_string(dict_id)), compressor::kZstd);
+  // Caller has no dictionary or a different one.
+  ASSERT_EQ(get_rsp_compress_type(""), compressor::kNone);
+  ASSERT_EQ(get_rsp_compress_type(std::to_string(dict_id + 1)), compressor::kNone);
+
+  // Without dictionary, any caller can decompress the response.
+  compressor::zstd::ClearDictionaries();
+  ASSERT_EQ(get_rsp_compress_type(""), compressor::kZstd);
+}
+
+TEST_F(TrpcServerCodecTest, ZstdDictionaryAck) {
+  uint32_t dict_id = compressor::zstd::AddDictionary(compressor::testing::TrainZstdDictionary());
+  ASSERT_NE(dict_id, 0);
+
+  auto get_ack = [this](const std::string& peer_dict_id) -> std::string {
+    TrpcRequestProtocol req;
+    FillTrpcRequestProtocolData(req);
+    req.req_header.set_content_encoding(compressor::kZstd);
+    (*req.req_header.mutable_trans_info())[compressor::zstd::kDictionaryIdKey] = peer_dict_id;
+    NoncontiguousBuffer buff;
+    EXPECT_TRUE(req.ZeroCopyEncode(buff));
+
+    ServerContextPtr context = MakeRefCounted<ServerContext>();
+    context->SetRequestMsg(codec_.CreateRequestObject());
+    context->SetResponseMsg(codec_.CreateResponseObject());
+    EXPECT_TRUE(codec_.ZeroCopyDecode(context, std::move(buff), context->GetRequestMsg()));
+    auto* rsp = static_cast<TrpcResponseProtocol*>(context->GetResponseMsg().get());
+    auto it = rsp->rsp_header.trans_info().find(compressor::zstd::kDictionaryAckKey);
+    return it != rsp->rsp_header.trans_info().end() ? it->second : "";
+  };
+
+  // Confirmed as long as the dictionary of caller is registered, even if ours is another one.
+  ASSERT_EQ(get_ack(std::to_string(dict_id)), std::to_string(dict_id));
+  ASSERT_EQ(get_ack(std::to_string(dict_id + 1)), "");
+
+  compressor::zstd::ClearDictionaries();
+  ASSERT_EQ(get_ack(std::to_string(dict_id)), "");
+}
+
 }  // namespace trpc::testing
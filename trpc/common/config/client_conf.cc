@@ -51,6 +51,9 @@ void ServiceProxyConfig::Display() const {
   TRPC_LOG_DEBUG("is_reconnection:" << is_reconnection);
   TRPC_LOG_DEBUG("connect_timeout:" << connect_timeout);
   TRPC_LOG_DEBUG("allow_reconnect:" << allow_reconnect);
+  TRPC_LOG_DEBUG("use_method_id:" << use_method_id);
+  TRPC_LOG_DEBUG("enable_singleflight:" << enable_singleflight);
+  TRPC_LOG_DEBUG("singleflight_max_wait_ms:" << singleflight_max_wait_ms);
   TRPC_LOG_DEBUG("idle_time:" << idle_time);
   TRPC_LOG_DEBUG("threadmodel_instance_name:" << threadmodel_instance_name);
   TRPC_LOG_DEBUG("support_pipeline:" << support_pipeline);
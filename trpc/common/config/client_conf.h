@@ -84,6 +84,19 @@ struct ServiceProxyConfig {
   /// For scenarios where reconnection is not allowed, such as transactional operations, set this value to false.
   bool allow_reconnect{kDefaultAllowReconnect};
 
+  /// Whether to send the compact method id instead of the full function name in trpc protocol requests.
+  /// The full name is still sent to a callee address until it advertises method ids in a response.
+  /// @note Not safe while callees of old and new versions are mixed: a callee downgraded in place at the same address
+  ///       fails the first call after it with TRPC_SERVER_NOFUNC_ERR.
+  bool use_method_id{kDefaultUseMethodId};
+
+  /// Whether to coalesce identical in-flight unary calls, later calls share the response of the first one.
+  /// Enable it only for idempotent calls whose responses don't depend on the caller.
+  bool enable_singleflight{kDefaultEnableSingleflight};
+
+  /// The maximum time(ms) a call waits for an identical in-flight call, 0 means bounded by its own timeout only.
+  uint32_t singleflight_max_wait_ms{kDefaultSingleflightMaxWaitMs};
+
   /// The maximum size of the response packet that the `ServiceProxy` allows to receive
   /// If set 0, disable check th packet size
   uint32_t max_packet_size{kDefaultMaxPacketSize};
@@ -40,6 +40,9 @@ struct convert<trpc::ServiceProxyConfig> {
     node["request_timeout_check_interval"] = proxy_config.request_timeout_check_interval;
     node["is_reconnection"] = proxy_config.is_reconnection;
     node["allow_reconnect"] = proxy_config.allow_reconnect;
+    node["use_method_id"] = proxy_config.use_method_id;
+    node["enable_singleflight"] = proxy_config.enable_singleflight;
+    node["singleflight_max_wait_ms"] = proxy_config.singleflight_max_wait_ms;
     node["max_packet_size"] = proxy_config.max_packet_size;
     node["max_conn_num"] = proxy_config.max_conn_num;
     node["idle_time"] = proxy_config.idle_time;
@@ -96,6 +99,11 @@ struct convert<trpc::ServiceProxyConfig> {
     }
     if (node["is_reconnection"]) proxy_config.is_reconnection = node["is_reconnection"].as<bool>();
     if (node["allow_reconnect"]) proxy_config.allow_reconnect = node["allow_reconnect"].as<bool>();
+    if (node["use_method_id"]) proxy_config.use_method_id = node["use_method_id"].as<bool>();
+    if (node["enable_singleflight"]) proxy_config.enable_singleflight = node["enable_singleflight"].as<bool>();
+    if (node["singleflight_max_wait_ms"]) {
+      proxy_config.singleflight_max_wait_ms = node["singleflight_max_wait_ms"].as<uint32_t>();
+    }
 	if (node["max_packet_size"]) proxy_config.max_packet_size = node["max_packet_size"].as<uint32_t>();
     if (node["max_conn_num"]) proxy_config.max_conn_num = node["max_conn_num"].as<uint32_t>();
     if (node["idle_time"]) proxy_config.idle_time = node["idle_time"].as<uint32_t>();
@@ -86,6 +86,11 @@ constexpr bool kDefaultIsReconnection = false;
 
 /// The default value whether to support reconnection in fixed connection mode, the default value is true.
 constexpr bool kDefaultAllowReconnect = true;
+constexpr bool kDefaultUseMethodId = false;
+
+/// The default value whether to coalesce identical in-flight unary calls, and the maximum time(ms) to wait for them.
+constexpr bool kDefaultEnableSingleflight = false;
+constexpr uint32_t kDefaultSingleflightMaxWaitMs = 0;
   
 /// The default selector plugin used by the service.
 constexpr char kDefaultSelectorName[] = "";
@@ -64,8 +64,12 @@ void FiberThreadModelInstanceConfig::Display() const {
   TRPC_LOG_DEBUG("fiber_stack_size:" << fiber_stack_size);
   TRPC_LOG_DEBUG("fiber_pool_num_by_mmap:" << fiber_pool_num_by_mmap);
   TRPC_LOG_DEBUG("fiber_stack_enable_guard_page:" << fiber_stack_enable_guard_page);
+  TRPC_LOG_DEBUG("fiber_stack_usage_sample_rate:" << fiber_stack_usage_sample_rate);
   TRPC_LOG_DEBUG("fiber_scheduling_name:" << fiber_scheduling_name);
   TRPC_LOG_DEBUG("enable_gdb_debug:" << enable_gdb_debug);
+  TRPC_LOG_DEBUG("enable_async_io:" << enable_async_io);
+  TRPC_LOG_DEBUG("io_uring_entries:" << io_uring_entries);
+  TRPC_LOG_DEBUG("io_uring_flags:" << io_uring_flags);
 
   TRPC_LOG_DEBUG("================================");
 }
@@ -125,6 +129,8 @@ void RpczConfig::Display() const {
   TRPC_LOG_DEBUG("collect_interval_ms:" << collect_interval_ms);
   TRPC_LOG_DEBUG("remove_interval_ms:" << remove_interval_ms);
   TRPC_LOG_DEBUG("print_spans_num:" << print_spans_num);
+  TRPC_LOG_DEBUG("enable_tail_sample:" << enable_tail_sample);
+  TRPC_LOG_DEBUG("tail_sample_latency_ms:" << tail_sample_latency_ms);
 
   TRPC_LOG_DEBUG("================================");
 }
@@ -84,9 +84,21 @@ struct FiberThreadModelInstanceConfig {
   /// @brief Stack overflow protect
   bool fiber_stack_enable_guard_page{true};
 
+  /// @brief Sample the stack usage of one in every `fiber_stack_usage_sample_rate` fibers, 0 means disabled.
+  uint32_t fiber_stack_usage_sample_rate{0};
+
   /// @brief Enable debug fiber using gdb
   bool enable_gdb_debug = false;
 
+  /// @brief Whether to create an io_uring for each fiber reactor, which is used by `FiberFile`
+  bool enable_async_io{false};
+
+  /// @brief Io_uring queue size
+  uint32_t io_uring_entries{1024};
+
+  /// @brief Io_uring initilize flag
+  uint32_t io_uring_flags{0};
+
   void Display() const;
 };
 
@@ -241,6 +253,14 @@ struct RpczConfig {
   /// @brief How many spans to returned to admin request.
   uint32_t print_spans_num{10};
 
+  /// @brief Whether to decide sampling when the call finishes instead of when it starts.
+  /// @note In tail sampling mode, every call records its span cheaply, and the span is only committed to collector
+  ///       when the call is slower than tail_sample_latency_ms, fails, or hits the high low water sampler.
+  bool enable_tail_sample{false};
+
+  /// @brief Calls slower than this are always committed in tail sampling mode, unit/millisecond.
+  uint32_t tail_sample_latency_ms{100};
+
   void Display() const;
 };
 
@@ -43,8 +43,12 @@ struct convert<trpc::FiberThreadModelInstanceConfig> {
     node["fiber_stack_size"] = config.fiber_stack_size;
     node["fiber_pool_num_by_mmap"] = config.fiber_pool_num_by_mmap;
     node["fiber_stack_enable_guard_page"] = config.fiber_stack_enable_guard_page;
+    node["fiber_stack_usage_sample_rate"] = config.fiber_stack_usage_sample_rate;
     node["fiber_scheduling_name"] = config.fiber_scheduling_name;
     node["enable_gdb_debug"] = config.enable_gdb_debug;
+    node["enable_async_io"] = config.enable_async_io;
+    node["io_uring_entries"] = config.io_uring_entries;
+    node["io_uring_flags"] = config.io_uring_flags;
 
     return node;
   }
@@ -106,6 +110,10 @@ struct convert<trpc::FiberThreadModelInstanceConfig> {
       config.fiber_stack_enable_guard_page = node["fiber_stack_enable_guard_page"].as<bool>();
     }
 
+    if (node["fiber_stack_usage_sample_rate"]) {
+      config.fiber_stack_usage_sample_rate = node["fiber_stack_usage_sample_rate"].as<uint32_t>();
+    }
+
     if (node["fiber_scheduling_name"]) {
       config.fiber_scheduling_name = node["fiber_scheduling_name"].as<std::string>();
     }
@@ -118,6 +126,18 @@ struct convert<trpc::FiberThreadModelInstanceConfig> {
       config.enable_gdb_debug = node["enable_gdb_debug"].as<bool>();
     }
 
+    if (node["enable_async_io"]) {
+      config.enable_async_io = node["enable_async_io"].as<bool>();
+    }
+
+    if (node["io_uring_entries"]) {
+      config.io_uring_entries = node["io_uring_entries"].as<uint32_t>();
+    }
+
+    if (node["io_uring_flags"]) {
+      config.io_uring_flags = node["io_uring_flags"].as<uint32_t>();
+    }
+
     return true;
   }
 };
@@ -332,6 +352,8 @@ struct convert<trpc::RpczConfig> {
     node["collect_interval_ms"] = config.collect_interval_ms;
     node["remove_interval_ms"] = config.remove_interval_ms;
     node["print_spans_num"] = config.print_spans_num;
+    node["enable_tail_sample"] = config.enable_tail_sample;
+    node["tail_sample_latency_ms"] = config.tail_sample_latency_ms;
 
     return node;
   }
@@ -358,6 +380,12 @@ struct convert<trpc::RpczConfig> {
     if (node["print_spans_num"]) {
       config.print_spans_num = node["print_spans_num"].as<uint32_t>();
     }
+    if (node["enable_tail_sample"]) {
+      config.enable_tail_sample = node["enable_tail_sample"].as<bool>();
+    }
+    if (node["tail_sample_latency_ms"]) {
+      config.tail_sample_latency_ms = node["tail_sample_latency_ms"].as<uint32_t>();
+    }
 
     return true;
   }
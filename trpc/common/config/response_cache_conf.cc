@@ -0,0 +1,33 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/common/config/response_cache_conf.h"
+
+#include "trpc/util/log/logging.h"
+
+namespace trpc {
+
+void ResponseCacheConfig::Display() const {
+  TRPC_LOG_DEBUG("capacity:" << capacity);
+  TRPC_LOG_DEBUG("shard_num:" << shard_num);
+  TRPC_LOG_DEBUG("max_entry_size:" << max_entry_size);
+  TRPC_LOG_DEBUG("default_ttl:" << default_ttl);
+  for (const auto& [func, ttl] : method_ttl) {
+    TRPC_LOG_DEBUG("method_ttl:" << func << ":" << ttl);
+  }
+  for (const auto& key : ignored_trans_info) {
+    TRPC_LOG_DEBUG("ignored_trans_info:" << key);
+  }
+}
+
+}  // namespace trpc
@@ -0,0 +1,50 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace trpc {
+
+constexpr char kResponseCacheFilter[] = "response_cache";
+
+/// @brief Config of the response cache server filter, the responses of identical requests are served from cache within
+///        the TTL of method.
+struct ResponseCacheConfig {
+  /// Memory limit(bytes) of the cached requests and responses.
+  uint64_t capacity{64 * 1024 * 1024};
+
+  /// The number of cache shards, each one has its own lock and 1/shard_num of the capacity.
+  uint32_t shard_num{16};
+
+  /// Requests or responses larger than it(bytes) are not cached.
+  uint32_t max_entry_size{64 * 1024};
+
+  /// TTL(ms) of the methods not listed in `method_ttl`, 0 means they are not cached.
+  uint32_t default_ttl{0};
+
+  /// TTL(ms) of each method, key is the function name, e.g. "/trpc.test.helloworld.Greeter/SayHello".
+  std::map<std::string, uint32_t> method_ttl;
+
+  /// Request trans info keys which don't affect the response (e.g. the ones of tracing), they are left out of the cache
+  /// key. All other request trans info is part of the key.
+  std::vector<std::string> ignored_trans_info;
+
+  void Display() const;
+};
+
+}  // namespace trpc
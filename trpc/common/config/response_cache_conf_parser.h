@@ -0,0 +1,62 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "yaml-cpp/yaml.h"
+
+#include "trpc/common/config/response_cache_conf.h"
+
+namespace YAML {
+
+template <>
+struct convert<trpc::ResponseCacheConfig> {
+  static YAML::Node encode(const trpc::ResponseCacheConfig& config) {
+    YAML::Node node;
+    node["capacity"] = config.capacity;
+    node["shard_num"] = config.shard_num;
+    node["max_entry_size"] = config.max_entry_size;
+    node["default_ttl"] = config.default_ttl;
+    node["method_ttl"] = config.method_ttl;
+    node["ignored_trans_info"] = config.ignored_trans_info;
+    return node;
+  }
+
+  static bool decode(const YAML::Node& node, trpc::ResponseCacheConfig& config) {  // NOLINT
+    if (node["capacity"]) {
+      config.capacity = node["capacity"].as<uint64_t>();
+    }
+    if (node["shard_num"]) {
+      config.shard_num = node["shard_num"].as<uint32_t>();
+    }
+    if (node["max_entry_size"]) {
+      config.max_entry_size = node["max_entry_size"].as<uint32_t>();
+    }
+    if (node["default_ttl"]) {
+      config.default_ttl = node["default_ttl"].as<uint32_t>();
+    }
+    if (node["method_ttl"]) {
+      config.method_ttl = node["method_ttl"].as<std::map<std::string, uint32_t>>();
+    }
+    if (node["ignored_trans_info"]) {
+      config.ignored_trans_info = node["ignored_trans_info"].as<std::vector<std::string>>();
+    }
+    return true;
+  }
+};
+
+}  // namespace YAML
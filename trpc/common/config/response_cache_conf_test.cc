@@ -0,0 +1,51 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/common/config/response_cache_conf.h"
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "trpc/common/config/response_cache_conf_parser.h"
+
+namespace trpc::testing {
+
+TEST(ResponseCacheConfig, Parse) {
+  YAML::Node node = YAML::Load(R"(
+capacity: 1048576
+shard_num: 4
+default_ttl: 100
+method_ttl:
+  /trpc.test.helloworld.Greeter/SayHello: 1000
+ignored_trans_info:
+  - trpc-trace-id
+)");
+
+  trpc::ResponseCacheConfig config;
+  ASSERT_TRUE(YAML::convert<trpc::ResponseCacheConfig>::decode(node, config));
+  ASSERT_EQ(config.capacity, 1048576);
+  ASSERT_EQ(config.shard_num, 4);
+  ASSERT_EQ(config.max_entry_size, 64 * 1024);
+  ASSERT_EQ(config.default_ttl, 100);
+  ASSERT_EQ(config.method_ttl["/trpc.test.helloworld.Greeter/SayHello"], 1000);
+  ASSERT_EQ(config.ignored_trans_info, std::vector<std::string>{"trpc-trace-id"});
+  config.Display();
+
+  node = YAML::convert<trpc::ResponseCacheConfig>::encode(config);
+  ASSERT_EQ(node["shard_num"].as<uint32_t>(), 4);
+  ASSERT_EQ(node["method_ttl"]["/trpc.test.helloworld.Greeter/SayHello"].as<uint32_t>(), 1000);
+}
+
+}  // namespace trpc::testing
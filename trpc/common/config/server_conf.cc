@@ -13,6 +13,7 @@
 
 #include "trpc/common/config/server_conf.h"
 
+#include "trpc/common/config/response_cache_conf.h"
 #include "trpc/util/log/logging.h"
 
 namespace trpc {
@@ -40,11 +41,20 @@ void ServiceConfig::Display() const {
   TRPC_LOG_DEBUG("send_queue_timeout:" << send_queue_timeout);
   TRPC_LOG_DEBUG("threadmodel_instance_name:" << threadmodel_instance_name);
   TRPC_LOG_DEBUG("accept_thread_num:" << accept_thread_num);
+  TRPC_LOG_DEBUG("reuseport_per_reactor:" << reuseport_per_reactor);
+  TRPC_LOG_DEBUG("reuseport_cpu_affinity:" << reuseport_cpu_affinity);
   TRPC_LOG_DEBUG("stream_read_timeout:" << stream_read_timeout);
   TRPC_LOG_DEBUG("stream_max_window_size:" << stream_max_window_size);
 
   ssl_config.Display();
 
+  if (!service_filter_configs.empty()) {
+    auto iter = service_filter_configs.find(kResponseCacheFilter);
+    if (iter != service_filter_configs.end()) {
+      std::any_cast<ResponseCacheConfig>(iter->second).Display();
+    }
+  }
+
   TRPC_LOG_DEBUG("--------------------------------");
 }
 
@@ -61,6 +71,10 @@ void ServerConfig::Display() const {
   TRPC_LOG_DEBUG("registry_name:" << registry_name);
   TRPC_LOG_DEBUG("enable_server_stats:" << enable_server_stats);
   TRPC_LOG_DEBUG("server_stats_interval:" << server_stats_interval);
+  TRPC_LOG_DEBUG("enable_rpc_stage_stats:" << enable_rpc_stage_stats);
+  TRPC_LOG_DEBUG("enable_sampling_profiler:" << enable_sampling_profiler);
+  TRPC_LOG_DEBUG("sampling_profiler_frequency:" << sampling_profiler_frequency);
+  TRPC_LOG_DEBUG("sampling_profiler_window_seconds:" << sampling_profiler_window_seconds);
   TRPC_LOG_DEBUG("stop_max_wait_time:" << stop_max_wait_time);
 
   for (const auto& i : services_config) {
@@ -109,6 +109,16 @@ struct ServiceConfig {
   /// @brief The number of threads(fibers) listening on the port
   uint32_t accept_thread_num{1};
 
+  /// @brief Listen by one SO_REUSEPORT listener per reactor, and keep the accepted connection on the reactor which
+  /// accepted it instead of dispatching it by fd. It overrides `accept_thread_num`
+  /// Use in fiber runtime
+  bool reuseport_per_reactor{false};
+
+  /// @brief Steer connections to the listener by the cpu receiving the packet (reuseport bpf program), so that
+  /// accept, read, handle and write of a connection run on the core where the NIC delivered it
+  /// Only takes effect when `reuseport_per_reactor` is true
+  bool reuseport_cpu_affinity{false};
+
   /// @brief Under streaming, the timeout for reading messages from the stream
   int stream_read_timeout{3000};
 
@@ -168,6 +178,18 @@ struct ServerConfig {
   /// @brief Server stats interval, default 1min
   uint32_t server_stats_interval{60000};
 
+  /// @brief Whether to enable cpu cycles stats of each stage of rpcs, which can be queried by admin
+  bool enable_rpc_stage_stats{false};
+
+  /// @brief Whether to enable the always-on sampling cpu profiler, whose samples can be queried by admin
+  bool enable_sampling_profiler{false};
+
+  /// @brief Samples per second of cpu time of each framework thread, default 99
+  uint32_t sampling_profiler_frequency{99};
+
+  /// @brief How many seconds of samples are kept by the sampling profiler, default 1min
+  uint32_t sampling_profiler_window_seconds{60};
+
   /// @brief Service configuration collection
   std::vector<ServiceConfig> services_config;
 
@@ -15,6 +15,7 @@
 
 #include "yaml-cpp/yaml.h"
 
+#include "trpc/common/config/response_cache_conf_parser.h"
 #include "trpc/common/config/server_conf.h"
 #include "trpc/common/config/ssl_conf_parser.h"
 #include "trpc/util/log/logging.h"
@@ -52,9 +53,18 @@ struct convert<trpc::ServiceConfig> {
     node["threadmodel_type"] = service_config.threadmodel_type;
     node["threadmodel_instance_name"] = service_config.threadmodel_instance_name;
     node["accept_thread_num"] = service_config.accept_thread_num;
+    node["reuseport_per_reactor"] = service_config.reuseport_per_reactor;
+    node["reuseport_cpu_affinity"] = service_config.reuseport_cpu_affinity;
     node["stream_read_timeout"] = service_config.stream_read_timeout;
     node["stream_max_window_size"] = service_config.stream_max_window_size;
     node["filter"] = service_config.service_filters;
+
+    auto& filter_configs = service_config.service_filter_configs;
+    auto iter = filter_configs.find(trpc::kResponseCacheFilter);
+    if (iter != filter_configs.end()) {
+      node["filter_config"][iter->first] = std::any_cast<trpc::ResponseCacheConfig>(iter->second);
+    }
+
     node["ssl"] = service_config.ssl_config;
 
     return node;
@@ -150,10 +160,34 @@ struct convert<trpc::ServiceConfig> {
       }
 #endif
     }
+
+    if (node["reuseport_per_reactor"]) {
+      service_config.reuseport_per_reactor = node["reuseport_per_reactor"].as<bool>();
+#if !defined(SO_REUSEPORT) || defined(TRPC_DISABLE_REUSEPORT)
+      if (service_config.reuseport_per_reactor) {
+        TRPC_LOG_WARN(
+            "reuseport is not supported, set reuseport_per_reactor=false as default, please recomplie with [--define "
+            "trpc_disable_reuseport=false] and linux kernel >= 3.9");
+        service_config.reuseport_per_reactor = false;
+      }
+#endif
+    }
+
+    if (node["reuseport_cpu_affinity"]) {
+      service_config.reuseport_cpu_affinity = node["reuseport_cpu_affinity"].as<bool>();
+    }
     if (node["filter"]) {
       service_config.service_filters = node["filter"].as<std::vector<std::string>>();
     }
 
+    if (node["filter_config"]) {
+      if (node["filter_config"][trpc::kResponseCacheFilter]) {
+        auto response_cache_config =
+            node["filter_config"][trpc::kResponseCacheFilter].as<trpc::ResponseCacheConfig>();
+        service_config.service_filter_configs[trpc::kResponseCacheFilter] = response_cache_config;
+      }
+    }
+
     if (node["ssl"]) {
       service_config.ssl_config = node["ssl"].as<trpc::ServerSslConfig>();
     }
@@ -178,6 +212,10 @@ struct convert<trpc::ServerConfig> {
     node["registry_name"] = server_config.registry_name;
     node["enable_server_stats"] = server_config.enable_server_stats;
     node["server_stats_interval"] = server_config.server_stats_interval;
+    node["enable_rpc_stage_stats"] = server_config.enable_rpc_stage_stats;
+    node["enable_sampling_profiler"] = server_config.enable_sampling_profiler;
+    node["sampling_profiler_frequency"] = server_config.sampling_profiler_frequency;
+    node["sampling_profiler_window_seconds"] = server_config.sampling_profiler_window_seconds;
     node["filter"] = server_config.filters;
     node["service"] = server_config.services_config;
     node["stop_max_wait_time"] = server_config.stop_max_wait_time;
@@ -225,6 +263,22 @@ struct convert<trpc::ServerConfig> {
       server_config.server_stats_interval = node["server_stats_interval"].as<uint32_t>();
     }
 
+    if (node["enable_rpc_stage_stats"]) {
+      server_config.enable_rpc_stage_stats = node["enable_rpc_stage_stats"].as<bool>();
+    }
+
+    if (node["enable_sampling_profiler"]) {
+      server_config.enable_sampling_profiler = node["enable_sampling_profiler"].as<bool>();
+    }
+
+    if (node["sampling_profiler_frequency"]) {
+      server_config.sampling_profiler_frequency = node["sampling_profiler_frequency"].as<uint32_t>();
+    }
+
+    if (node["sampling_profiler_window_seconds"]) {
+      server_config.sampling_profiler_window_seconds = node["sampling_profiler_window_seconds"].as<uint32_t>();
+    }
+
     if (node["filter"]) {
       for (size_t idx = 0; idx < node["filter"].size(); ++idx) {
         server_config.filters.push_back(node["filter"][idx].as<std::string>());
@@ -33,6 +33,10 @@ TEST(ServerConfigTest, server_config_test) {
   server_config.registry_name = "meshpolaris";
   server_config.enable_server_stats = false;
   server_config.server_stats_interval = 60000;
+  server_config.enable_rpc_stage_stats = true;
+  server_config.enable_sampling_profiler = true;
+  server_config.sampling_profiler_frequency = 49;
+  server_config.sampling_profiler_window_seconds = 300;
   server_config.filters = {"tpstelemetry"};
   server_config.stop_max_wait_time = 1000;
 
@@ -56,6 +60,8 @@ TEST(ServerConfigTest, server_config_test) {
   service_config.send_queue_timeout = 5000;
   service_config.threadmodel_instance_name = "instance1";
   service_config.accept_thread_num = 2;
+  service_config.reuseport_per_reactor = true;
+  service_config.reuseport_cpu_affinity = true;
   service_config.stream_read_timeout = 3000;
   service_config.stream_max_window_size = 65535;
 
@@ -82,6 +88,10 @@ TEST(ServerConfigTest, server_config_test) {
   ASSERT_EQ(server_config.registry_name, tmp.registry_name);
   ASSERT_EQ(server_config.enable_server_stats, tmp.enable_server_stats);
   ASSERT_EQ(server_config.server_stats_interval, tmp.server_stats_interval);
+  ASSERT_EQ(server_config.enable_rpc_stage_stats, tmp.enable_rpc_stage_stats);
+  ASSERT_EQ(server_config.enable_sampling_profiler, tmp.enable_sampling_profiler);
+  ASSERT_EQ(server_config.sampling_profiler_frequency, tmp.sampling_profiler_frequency);
+  ASSERT_EQ(server_config.sampling_profiler_window_seconds, tmp.sampling_profiler_window_seconds);
   ASSERT_EQ(server_config.filters[0], tmp.filters[0]);
   ASSERT_EQ(server_config.stop_max_wait_time, tmp.stop_max_wait_time);
 
@@ -109,10 +119,13 @@ TEST(ServerConfigTest, server_config_test) {
 #if defined(SO_REUSEPORT) && !defined(TRPC_DISABLE_REUSEPORT)
   ASSERT_EQ(YAML::convert<trpc::ServerConfig>::decode(server_config_node, tmp), true);
   ASSERT_EQ(tmp.services_config.front().accept_thread_num, server_config.services_config.front().accept_thread_num);
+  ASSERT_TRUE(tmp.services_config.front().reuseport_per_reactor);
 #else
   ASSERT_EQ(YAML::convert<trpc::ServerConfig>::decode(server_config_node, tmp), true);
   ASSERT_EQ(tmp.services_config.front().accept_thread_num, 1);
+  ASSERT_FALSE(tmp.services_config.front().reuseport_per_reactor);
 #endif
+  ASSERT_TRUE(tmp.services_config.front().reuseport_cpu_affinity);
 }
 
 TEST(ServerConfigTest, test_ip) {
@@ -0,0 +1,159 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/compressor/adaptive_compression.h"
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <utility>
+
+#include "trpc/util/log/logging.h"
+
+namespace trpc::compressor {
+
+AdaptiveCompression::AdaptiveCompression(const AdaptiveCompressionConfig& config, std::string tvar_path)
+    : config_(config), tvar_path_(std::move(tvar_path)) {
+  if (!tvar_path_.empty()) {
+    skipped_small_.emplace(tvar_path_ + "/skipped_small");
+    skipped_entropy_.emplace(tvar_path_ + "/skipped_entropy");
+    skipped_ratio_.emplace(tvar_path_ + "/skipped_ratio");
+  }
+}
+
+AdaptiveCompression* AdaptiveCompression::GetInstance() {
+  static AdaptiveCompression instance(AdaptiveCompressionConfig{}, "trpc/compressor/adaptive");
+  return &instance;
+}
+
+bool AdaptiveCompression::ShouldCompress(std::string_view method, const NoncontiguousBuffer& data) {
+  if (!config_.enable) {
+    return true;
+  }
+  if (data.ByteSize() < config_.min_size) {
+    CountSkipped(skipped_small_);
+    return false;
+  }
+
+  MethodStats* stats = method.empty() ? nullptr : GetMethodStats(method);
+  if (stats && stats->disabled.load(std::memory_order_relaxed)) {
+    // Retries now and then regardless of entropy, its ratio decides whether to enable it again.
+    if (config_.retry_interval == 0 ||
+        (stats->skipped.fetch_add(1, std::memory_order_relaxed) + 1) % config_.retry_interval != 0) {
+      CountSkipped(skipped_ratio_);
+      return false;
+    }
+    return true;
+  }
+
+  if (config_.probe_size != 0 && EstimateEntropy(data, config_.probe_size) > config_.max_entropy) {
+    CountSkipped(skipped_entropy_);
+    return false;
+  }
+  return true;
+}
+
+void AdaptiveCompression::Report(std::string_view method, std::size_t uncompressed_size,
+                                 std::size_t compressed_size) {
+  if (!config_.enable || method.empty() || uncompressed_size == 0) {
+    return;
+  }
+  MethodStats* stats = GetMethodStats(method);
+  stats->uncompressed_bytes.fetch_add(uncompressed_size, std::memory_order_relaxed);
+  stats->compressed_bytes.fetch_add(compressed_size, std::memory_order_relaxed);
+  // Only the reporter completing the window evaluates it. Reports racing with it may be counted into either window,
+  // which is fine for a statistic.
+  if (stats->samples.fetch_add(1, std::memory_order_relaxed) + 1 < std::max<uint32_t>(config_.ratio_window, 1)) {
+    return;
+  }
+  uint64_t uncompressed = stats->uncompressed_bytes.exchange(0, std::memory_order_relaxed);
+  uint64_t compressed = stats->compressed_bytes.exchange(0, std::memory_order_relaxed);
+  stats->samples.store(0, std::memory_order_relaxed);
+  if (uncompressed == 0) {
+    return;
+  }
+
+  double ratio = static_cast<double>(compressed) / uncompressed;
+  bool disabled = ratio > config_.max_ratio;
+  if (stats->disabled.exchange(disabled, std::memory_order_relaxed) != disabled) {
+    TRPC_FMT_INFO("Compression of `{}` is {}, ratio: {:.3f}", method, disabled ? "disabled" : "enabled", ratio);
+  }
+  if (stats->ratio_var) {
+    stats->ratio_var->SetValue(ratio);
+    stats->disabled_var->SetValue(disabled ? 1 : 0);
+  }
+}
+
+bool AdaptiveCompression::IsDisabled(std::string_view method) {
+  return GetMethodStats(method)->disabled.load(std::memory_order_relaxed);
+}
+
+double AdaptiveCompression::EstimateEntropy(const NoncontiguousBuffer& data, std::size_t sample_size) {
+  std::size_t size = data.ByteSize();
+  if (size == 0 || sample_size == 0) {
+    return 0;
+  }
+  std::size_t step = std::max<std::size_t>(size / sample_size, 1);
+
+  uint32_t counts[256] = {0};
+  std::size_t sampled = 0;
+  // Offset of next sampled byte relative to the beginning of current block.
+  std::size_t next = 0;
+  for (const auto& block : data) {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(block.data());
+    for (; next < block.size(); next += step) {
+      ++counts[bytes[next]];
+      ++sampled;
+    }
+    next -= block.size();
+  }
+
+  double entropy = 0;
+  for (uint32_t count : counts) {
+    if (count != 0) {
+      double p = static_cast<double>(count) / sampled;
+      entropy -= p * std::log2(p);
+    }
+  }
+  return entropy;
+}
+
+AdaptiveCompression::MethodStats* AdaptiveCompression::GetMethodStats(std::string_view method) {
+  {
+    std::shared_lock lock(mutex_);
+    auto iter = methods_.find(method);
+    if (iter != methods_.end()) {
+      return iter->second.get();
+    }
+  }
+
+  std::unique_lock lock(mutex_);
+  auto iter = methods_.find(method);
+  if (iter != methods_.end()) {
+    return iter->second.get();
+  }
+  auto stats = std::make_unique<MethodStats>();
+  stats->name = std::string(method);
+  if (!tvar_path_.empty()) {
+    // Rpc method names are like "/trpc.app.server.Service/Method", which must not start with '/' in tvar path.
+    auto pos = method.find_first_not_of('/');
+    std::string path = tvar_path_ + "/" + std::string(pos == std::string_view::npos ? "_" : method.substr(pos));
+    stats->ratio_var.emplace(path + "/ratio", 0.0);
+    stats->disabled_var.emplace(path + "/disabled", 0);
+  }
+  auto* ptr = stats.get();
+  methods_.emplace(ptr->name, std::move(stats));
+  return ptr;
+}
+
+}  // namespace trpc::compressor
@@ -0,0 +1,99 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "trpc/compressor/adaptive_compression_conf.h"
+#include "trpc/tvar/basic_ops/reducer.h"
+#include "trpc/tvar/basic_ops/status.h"
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+
+namespace trpc::compressor {
+
+/// @brief Decides whether data is worth compressing. Data is left uncompressed if it's small, or it looks random by
+///        a sampled entropy estimation (e.g. already compressed media), or the compression ratio of its method has
+///        been poor recently. Poor methods are still compressed now and then, so they recover once data changes.
+/// @note  Decisions are exposed in tvar under `tvar_path`:
+///          skipped_small / skipped_entropy / skipped_ratio: number of compressions skipped for each reason.
+///          <method>/ratio: compressed/uncompressed size ratio of the last window.
+///          <method>/disabled: 1 if compression of the method is disabled.
+class AdaptiveCompression {
+ public:
+  /// @param tvar_path is where decisions are exposed, empty means not exposed.
+  explicit AdaptiveCompression(const AdaptiveCompressionConfig& config, std::string tvar_path = "");
+
+  /// @brief The instance used by the framework, exposed under "trpc/compressor/adaptive".
+  static AdaptiveCompression* GetInstance();
+
+  /// @brief Replaces the config, it should be called before any compression (e.g. by `compressor::Init`).
+  void SetConfig(const AdaptiveCompressionConfig& config) { config_ = config; }
+
+  const AdaptiveCompressionConfig& GetConfig() const { return config_; }
+
+  /// @brief Whether data of method should be compressed. It's always true if adaptive compression is not enabled.
+  /// @param method identifies the kind of data (e.g. rpc method name), empty means not tracking its ratio.
+  bool ShouldCompress(std::string_view method, const NoncontiguousBuffer& data);
+
+  /// @brief Reports the result of a compression allowed by `ShouldCompress`.
+  void Report(std::string_view method, std::size_t uncompressed_size, std::size_t compressed_size);
+
+  /// @brief Whether compression of method is disabled for poor ratio.
+  bool IsDisabled(std::string_view method);
+
+  /// @brief Estimates the order-0 entropy of data (bits per byte, 0 ~ 8) by sampling about `sample_size` bytes evenly.
+  static double EstimateEntropy(const NoncontiguousBuffer& data, std::size_t sample_size);
+
+ private:
+  struct MethodStats {
+    std::string name;
+    std::atomic<bool> disabled{false};
+    std::atomic<uint32_t> skipped{0};
+    std::atomic<uint32_t> samples{0};
+    std::atomic<uint64_t> uncompressed_bytes{0};
+    std::atomic<uint64_t> compressed_bytes{0};
+    std::optional<tvar::Status<double>> ratio_var;
+    std::optional<tvar::Status<int>> disabled_var;
+  };
+
+  MethodStats* GetMethodStats(std::string_view method);
+
+  void CountSkipped(std::optional<tvar::Counter<uint64_t>>& counter) {
+    if (counter) {
+      counter->Increment();
+    }
+  }
+
+ private:
+  AdaptiveCompressionConfig config_;
+  std::string tvar_path_;
+
+  std::optional<tvar::Counter<uint64_t>> skipped_small_;
+  std::optional<tvar::Counter<uint64_t>> skipped_entropy_;
+  std::optional<tvar::Counter<uint64_t>> skipped_ratio_;
+
+  std::shared_mutex mutex_;
+  // Keys refer to `MethodStats::name`.
+  std::unordered_map<std::string_view, std::unique_ptr<MethodStats>> methods_;
+};
+
+}  // namespace trpc::compressor
@@ -0,0 +1,34 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/compressor/adaptive_compression_conf.h"
+
+#include "trpc/util/log/logging.h"
+
+namespace trpc::compressor {
+
+void AdaptiveCompressionConfig::Display() const {
+  TRPC_LOG_DEBUG("--------------------------------");
+
+  TRPC_LOG_DEBUG("enable:" << enable);
+  TRPC_LOG_DEBUG("min_size:" << min_size);
+  TRPC_LOG_DEBUG("probe_size:" << probe_size);
+  TRPC_LOG_DEBUG("max_entropy:" << max_entropy);
+  TRPC_LOG_DEBUG("max_ratio:" << max_ratio);
+  TRPC_LOG_DEBUG("ratio_window:" << ratio_window);
+  TRPC_LOG_DEBUG("retry_interval:" << retry_interval);
+
+  TRPC_LOG_DEBUG("--------------------------------");
+}
+
+}  // namespace trpc::compressor
@@ -0,0 +1,47 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <cstdint>
+
+namespace trpc::compressor {
+
+/// @brief Options of adaptive compression, which skips compressing data not worth the CPU.
+struct AdaptiveCompressionConfig {
+  /// Whether to compress adaptively, data is always compressed as configured if disabled.
+  bool enable{false};
+
+  /// Data smaller than this (in bytes) is not compressed.
+  uint32_t min_size{256};
+
+  /// Number of bytes sampled evenly to estimate the entropy of data, 0 disables the probe.
+  uint32_t probe_size{1024};
+
+  /// Data is not compressed if its estimated entropy (bits per byte, 0 ~ 8) is above this.
+  double max_entropy{7.5};
+
+  /// Compression of a method is disabled if its compressed/uncompressed size ratio is above this.
+  double max_ratio{0.9};
+
+  /// Number of compressions over which the ratio of a method is evaluated.
+  uint32_t ratio_window{32};
+
+  /// While compression of a method is disabled, one out of this many calls is still compressed to track its ratio,
+  /// 0 means never re-enabling it.
+  uint32_t retry_interval{128};
+
+  void Display() const;
+};
+
+}  // namespace trpc::compressor
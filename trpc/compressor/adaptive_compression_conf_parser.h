@@ -0,0 +1,63 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include "yaml-cpp/yaml.h"
+
+#include "trpc/compressor/adaptive_compression_conf.h"
+
+namespace YAML {
+
+template <>
+struct convert<trpc::compressor::AdaptiveCompressionConfig> {
+  static YAML::Node encode(const trpc::compressor::AdaptiveCompressionConfig& conf) {
+    YAML::Node node;
+    node["enable"] = conf.enable;
+    node["min_size"] = conf.min_size;
+    node["probe_size"] = conf.probe_size;
+    node["max_entropy"] = conf.max_entropy;
+    node["max_ratio"] = conf.max_ratio;
+    node["ratio_window"] = conf.ratio_window;
+    node["retry_interval"] = conf.retry_interval;
+
+    return node;
+  }
+
+  static bool decode(const YAML::Node& node, trpc::compressor::AdaptiveCompressionConfig& conf) {
+    if (node["enable"]) {
+      conf.enable = node["enable"].as<bool>();
+    }
+    if (node["min_size"]) {
+      conf.min_size = node["min_size"].as<uint32_t>();
+    }
+    if (node["probe_size"]) {
+      conf.probe_size = node["probe_size"].as<uint32_t>();
+    }
+    if (node["max_entropy"]) {
+      conf.max_entropy = node["max_entropy"].as<double>();
+    }
+    if (node["max_ratio"]) {
+      conf.max_ratio = node["max_ratio"].as<double>();
+    }
+    if (node["ratio_window"]) {
+      conf.ratio_window = node["ratio_window"].as<uint32_t>();
+    }
+    if (node["retry_interval"]) {
+      conf.retry_interval = node["retry_interval"].as<uint32_t>();
+    }
+    return true;
+  }
+};
+
+}  // namespace YAML
@@ -0,0 +1,134 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/compressor/adaptive_compression.h"
+
+#include <random>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "trpc/tvar/common/tvar_group.h"
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+
+namespace trpc::compressor::testing {
+
+namespace {
+
+NoncontiguousBuffer MakeBuffer(const std::string& str) {
+  NoncontiguousBufferBuilder builder;
+  builder.Append(str);
+  return builder.DestructiveGet();
+}
+
+std::string RandomBytes(std::size_t size) {
+  std::mt19937 rng(size);
+  std::string str(size, 0);
+  for (auto& c : str) {
+    c = static_cast<char>(rng());
+  }
+  return str;
+}
+
+std::string TextBytes(std::size_t size) {
+  std::string str;
+  while (str.size() < size) {
+    str += "hello world, this is a message compressed well. ";
+  }
+  return str.substr(0, size);
+}
+
+AdaptiveCompressionConfig MakeConfig() {
+  AdaptiveCompressionConfig config;
+  config.enable = true;
+  config.min_size = 64;
+  config.ratio_window = 4;
+  config.retry_interval = 8;
+  return config;
+}
+
+}  // namespace
+
+TEST(AdaptiveCompressionTest, Disabled) {
+  AdaptiveCompression adaptive(AdaptiveCompressionConfig{});
+  ASSERT_TRUE(adaptive.ShouldCompress("m", MakeBuffer("a")));
+  ASSERT_TRUE(adaptive.ShouldCompress("m", MakeBuffer(RandomBytes(4096))));
+}
+
+TEST(AdaptiveCompressionTest, EstimateEntropy) {
+  ASSERT_EQ(AdaptiveCompression::EstimateEntropy(NoncontiguousBuffer{}, 1024), 0);
+  ASSERT_EQ(AdaptiveCompression::EstimateEntropy(MakeBuffer(std::string(4096, 'a')), 1024), 0);
+  ASSERT_GT(AdaptiveCompression::EstimateEntropy(MakeBuffer(RandomBytes(65536)), 1024), 7.5);
+  ASSERT_LT(AdaptiveCompression::EstimateEntropy(MakeBuffer(TextBytes(65536)), 1024), 5);
+
+  // Samples across blocks.
+  NoncontiguousBufferBuilder builder;
+  for (int i = 0; i < 100; ++i) {
+    builder.Append(RandomBytes(97 + i));
+  }
+  ASSERT_GT(AdaptiveCompression::EstimateEntropy(builder.DestructiveGet(), 1024), 7.5);
+}
+
+TEST(AdaptiveCompressionTest, SkipSmallAndRandom) {
+  AdaptiveCompression adaptive(MakeConfig());
+  ASSERT_FALSE(adaptive.ShouldCompress("m", MakeBuffer(TextBytes(32))));
+  ASSERT_TRUE(adaptive.ShouldCompress("m", MakeBuffer(TextBytes(64))));
+  ASSERT_FALSE(adaptive.ShouldCompress("m", MakeBuffer(RandomBytes(4096))));
+  ASSERT_TRUE(adaptive.ShouldCompress("", MakeBuffer(TextBytes(4096))));
+}
+
+TEST(AdaptiveCompressionTest, DisableByRatio) {
+  AdaptiveCompression adaptive(MakeConfig());
+  auto data = MakeBuffer(TextBytes(1024));
+
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(adaptive.ShouldCompress("m", data));
+    adaptive.Report("m", 1000, 950);
+  }
+  ASSERT_TRUE(adaptive.IsDisabled("m"));
+  ASSERT_FALSE(adaptive.IsDisabled("other"));
+
+  // One out of `retry_interval` calls is still compressed.
+  int compressed = 0;
+  for (int i = 0; i < 32; ++i) {
+    compressed += adaptive.ShouldCompress("m", data);
+  }
+  ASSERT_EQ(compressed, 4);
+
+  // Enabled again once ratio gets better.
+  for (int i = 0; i < 4; ++i) {
+    adaptive.Report("m", 1000, 300);
+  }
+  ASSERT_FALSE(adaptive.IsDisabled("m"));
+  ASSERT_TRUE(adaptive.ShouldCompress("m", data));
+}
+
+TEST(AdaptiveCompressionTest, ExposeTvar) {
+  AdaptiveCompression adaptive(MakeConfig(), "adaptive_compression_test");
+  ASSERT_FALSE(adaptive.ShouldCompress("/trpc.test.Greeter/SayHello", MakeBuffer(TextBytes(32))));
+  for (int i = 0; i < 4; ++i) {
+    adaptive.Report("/trpc.test.Greeter/SayHello", 1000, 950);
+  }
+
+  auto skipped = tvar::TrpcVarGroup::TryGet("/adaptive_compression_test/skipped_small");
+  ASSERT_TRUE(skipped);
+  ASSERT_EQ(skipped->asUInt64(), 1);
+  auto disabled = tvar::TrpcVarGroup::TryGet("/adaptive_compression_test/trpc.test.Greeter/SayHello/disabled");
+  ASSERT_TRUE(disabled);
+  ASSERT_EQ(disabled->asInt(), 1);
+  auto ratio = tvar::TrpcVarGroup::TryGet("/adaptive_compression_test/trpc.test.Greeter/SayHello/ratio");
+  ASSERT_TRUE(ratio);
+  ASSERT_DOUBLE_EQ(ratio->asDouble(), 0.95);
+}
+
+}  // namespace trpc::compressor::testing
@@ -0,0 +1,120 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace trpc::compressor {
+
+/// @brief Per-thread cache of compression contexts (e.g. z_stream, LZ4F_cctx). Creating and freeing a context costs
+///        more than compressing a small message, so a used context is reset and kept for the next call.
+/// @tparam Traits describes the context:
+///   using Context = ...;                     // Type of context, used by pointer.
+///   using Key = ...;                         // Contexts are shared only between equal keys, e.g. level.
+///   static Context* Create(const Key& key);  // Returns nullptr on failure.
+///   static bool Reset(Context* ctx);         // Makes a used context ready to reuse, false if it can't be reused.
+///   static void Destroy(Context* ctx);
+/// @note  A context taken by `Get` belongs to the caller until it is `Put` back, so it is fine to hold several
+///        contexts at the same time, and to put back a context on another thread.
+/// @private
+template <typename Traits>
+class ContextCache {
+ public:
+  using Context = typename Traits::Context;
+  using Key = typename Traits::Key;
+
+  /// @brief The max number of contexts cached by each thread.
+  static constexpr std::size_t kMaxCachedNum = 4;
+
+  /// @brief Takes a context from the cache of current thread, or creates a new one.
+  static Context* Get(const Key& key) {
+    if (auto* cache = GetThreadCache()) {
+      auto& contexts = cache->contexts;
+      for (auto it = contexts.rbegin(); it != contexts.rend(); ++it) {
+        if (it->first == key) {
+          Context* ctx = it->second;
+          contexts.erase(std::next(it).base());
+          return ctx;
+        }
+      }
+    }
+    return Traits::Create(key);
+  }
+
+  /// @brief Gives back the context to the cache of current thread.
+  static void Put(const Key& key, Context* ctx) {
+    auto* cache = GetThreadCache();
+    if (!cache || cache->contexts.size() >= kMaxCachedNum || !Traits::Reset(ctx)) {
+      Traits::Destroy(ctx);
+      return;
+    }
+    cache->contexts.emplace_back(key, ctx);
+  }
+
+ private:
+  struct ThreadCache {
+    ~ThreadCache() {
+      for (auto& [key, ctx] : contexts) {
+        Traits::Destroy(ctx);
+      }
+      destroyed = true;
+    }
+
+    std::vector<std::pair<Key, Context*>> contexts;
+  };
+
+  static ThreadCache* GetThreadCache() {
+    // Contexts may be put back by objects destroyed after the cache during thread exit.
+    if (destroyed) {
+      return nullptr;
+    }
+    thread_local ThreadCache cache;
+    return &cache;
+  }
+
+  inline static thread_local bool destroyed = false;
+};
+
+/// @brief Holds a context taken from `ContextCache` and puts it back when destroyed.
+/// @private
+template <typename Traits>
+class ScopedContext {
+ public:
+  using Context = typename Traits::Context;
+  using Key = typename Traits::Key;
+
+  explicit ScopedContext(const Key& key) : key_(key), ctx_(ContextCache<Traits>::Get(key)) {}
+
+  ~ScopedContext() {
+    if (ctx_) {
+      ContextCache<Traits>::Put(key_, ctx_);
+    }
+  }
+
+  ScopedContext(const ScopedContext&) = delete;
+  ScopedContext& operator=(const ScopedContext&) = delete;
+
+  /// @brief Returns nullptr if the context failed to create.
+  Context* Get() const { return ctx_; }
+
+  explicit operator bool() const { return ctx_ != nullptr; }
+
+ private:
+  Key key_;
+  Context* ctx_;
+};
+
+}  // namespace trpc::compressor
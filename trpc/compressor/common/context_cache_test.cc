@@ -0,0 +1,86 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/compressor/common/context_cache.h"
+
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace trpc::compressor::testing {
+
+namespace {
+
+struct Context {
+  int key;
+};
+
+struct CountingTraits {
+  using Context = testing::Context;
+  using Key = int;
+
+  static Context* Create(int key) {
+    ++created;
+    return new Context{key};
+  }
+
+  static bool Reset(Context* ctx) { return ctx->key >= 0; }
+
+  static void Destroy(Context* ctx) {
+    ++destroyed;
+    delete ctx;
+  }
+
+  inline static int created = 0;
+  inline static int destroyed = 0;
+};
+
+}  // namespace
+
+TEST(ContextCacheTest, Reuse) {
+  std::thread([] {
+    Context* first = nullptr;
+    {
+      ScopedContext<CountingTraits> ctx(1);
+      ASSERT_TRUE(ctx);
+      first = ctx.Get();
+      // Held contexts are not shared.
+      ScopedContext<CountingTraits> another(1);
+      ASSERT_NE(another.Get(), first);
+    }
+    ASSERT_EQ(CountingTraits::created, 2);
+
+    {
+      ScopedContext<CountingTraits> ctx(1);
+      ASSERT_EQ(ctx.Get(), first);
+      ScopedContext<CountingTraits> other_key(2);
+      ASSERT_EQ(other_key.Get()->key, 2);
+    }
+    ASSERT_EQ(CountingTraits::created, 3);
+
+    // Not reusable.
+    { ScopedContext<CountingTraits> ctx(-1); }
+    ASSERT_EQ(CountingTraits::destroyed, 1);
+
+    // Cache is bounded, 3 contexts are cached already.
+    {
+      ScopedContext<CountingTraits> c1(3), c2(3), c3(3), c4(3), c5(3);
+    }
+    ASSERT_EQ(CountingTraits::destroyed, 1 + 4);
+  }).join();
+
+  // All cached contexts are freed on thread exit.
+  ASSERT_EQ(CountingTraits::created, CountingTraits::destroyed);
+}
+
+}  // namespace trpc::compressor::testing
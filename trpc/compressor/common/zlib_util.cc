@@ -14,9 +14,12 @@
 #include "trpc/compressor/common/zlib_util.h"
 
 #include <algorithm>
+#include <memory>
+#include <utility>
 
 #include "zlib.h"
 
+#include "trpc/compressor/common/context_cache.h"
 #include "trpc/util/buffer/zero_copy_stream.h"
 #include "trpc/util/log/logging.h"
 
@@ -42,116 +45,252 @@ int GetWindowBits(CompressType type) {
   }
 }
 
+namespace {
+
+// deflateInit2/inflateInit2 allocate the window and hash tables (about 256KB for deflate), which costs more than
+// compressing a small message, while deflateReset/inflateReset keep them. z_stream must not move once initialized.
+struct DeflateTraits {
+  using Context = z_stream;
+  // Window bits and level.
+  using Key = std::pair<int, int>;
+
+  static z_stream* Create(const Key& key) {
+    auto strm = std::make_unique<z_stream>();
+    strm->zalloc = Z_NULL;
+    strm->zfree = Z_NULL;
+    strm->opaque = Z_NULL;
+    int ret = deflateInit2(strm.get(), key.second, Z_DEFLATED, key.first, 8, Z_DEFAULT_STRATEGY);
+    if (ret != Z_OK) {
+      TRPC_FMT_ERROR("deflateInit2 error, ret:{}", ret);
+      return nullptr;
+    }
+    return strm.release();
+  }
+
+  static bool Reset(z_stream* strm) { return deflateReset(strm) == Z_OK; }
+
+  static void Destroy(z_stream* strm) {
+    (void)deflateEnd(strm);
+    delete strm;
+  }
+};
+
+struct InflateTraits {
+  using Context = z_stream;
+  // Window bits.
+  using Key = int;
+
+  static z_stream* Create(const Key& key) {
+    auto strm = std::make_unique<z_stream>();
+    strm->zalloc = Z_NULL;
+    strm->zfree = Z_NULL;
+    strm->opaque = Z_NULL;
+    strm->avail_in = 0;
+    strm->next_in = Z_NULL;
+    int ret = inflateInit2(strm.get(), key);
+    if (ret != Z_OK) {
+      TRPC_FMT_ERROR("inflateInit2 error, ret:{}", ret);
+      return nullptr;
+    }
+    return strm.release();
+  }
+
+  static bool Reset(z_stream* strm) { return inflateReset(strm) == Z_OK; }
+
+  static void Destroy(z_stream* strm) {
+    (void)inflateEnd(strm);
+    delete strm;
+  }
+};
+
+using ScopedDeflateStream = ScopedContext<DeflateTraits>;
+using ScopedInflateStream = ScopedContext<InflateTraits>;
+
+// Runs deflate(...) over the input until it is drained and output still is not full.
 // Reference: http://www.zlib.net/zlib_how.html
+bool Deflate(z_stream* strm, const void* data, std::size_t size, int flush, NoncontiguousBufferOutputStream* out) {
+  strm->next_in = reinterpret_cast<Bytef*>(const_cast<void*>(data));
+  strm->avail_in = size;
+  int ret = Z_OK;
+  do {
+    void* next_data = nullptr;
+    int next_size = 0;
+    if (!out->Next(&next_data, &next_size)) {
+      TRPC_FMT_ERROR("NoncontiguousBufferOutputStream::Next failed.");
+      return false;
+    }
+    strm->avail_out = next_size;
+    strm->next_out = reinterpret_cast<Bytef*>(next_data);
+    ret = deflate(strm, flush);
+    out->BackUp(strm->avail_out);
+    // Z_BUF_ERROR only means no progress is possible, e.g. flush twice.
+    if (ret == Z_STREAM_ERROR) {
+      TRPC_FMT_ERROR("deflate error, ret:{}", ret);
+      return false;
+    }
+  } while (strm->avail_out == 0);
+  TRPC_ASSERT(strm->avail_in == 0);
+  return flush != Z_FINISH || ret == Z_STREAM_END;
+}
+
+// Runs inflate(...) until the input is drained (or the end of stream is reached) and output still is not full.
+// Returns the result of the last inflate(...), or Z_DATA_ERROR on failure.
+int Inflate(z_stream* strm, NoncontiguousBufferOutputStream* out) {
+  int ret = Z_OK;
+  do {
+    void* next_data = nullptr;
+    int next_size = 0;
+    if (!out->Next(&next_data, &next_size)) {
+      TRPC_FMT_ERROR("NoncontiguousBufferOutputStream::Next failed.");
+      return Z_DATA_ERROR;
+    }
+    strm->avail_out = next_size;
+    strm->next_out = reinterpret_cast<Bytef*>(next_data);
+    ret = inflate(strm, Z_NO_FLUSH);
+    out->BackUp(strm->avail_out);
+    switch (ret) {
+      // Z_STREAM_ERROR means empty input.
+      case Z_STREAM_ERROR:
+      case Z_NEED_DICT:
+      case Z_DATA_ERROR:
+      case Z_MEM_ERROR:
+        TRPC_FMT_ERROR("Decompress inflate error, ret:{}", ret);
+        return Z_DATA_ERROR;
+    }
+  } while (strm->avail_out == 0 && ret != Z_STREAM_END);
+  return ret;
+}
+
+class ZlibCompressStream : public CompressStream {
+ public:
+  ZlibCompressStream(int window_bits, int level) : strm_({window_bits, level}) {}
+
+  bool Valid() const { return static_cast<bool>(strm_); }
+
+  bool Append(const NoncontiguousBuffer& in, NoncontiguousBuffer& out) override {
+    NoncontiguousBufferBuilder builder;
+    NoncontiguousBufferOutputStream out_stream(&builder);
+    for (auto itr = in.begin(); itr != in.end(); ++itr) {
+      if (!Deflate(strm_.Get(), itr->data(), itr->size(), Z_NO_FLUSH, &out_stream)) {
+        return false;
+      }
+    }
+    out_stream.Flush();
+    out.Append(builder.DestructiveGet());
+    return true;
+  }
+
+  bool Flush(NoncontiguousBuffer& out) override { return DeflateAll(Z_SYNC_FLUSH, out); }
+
+  bool Finish(NoncontiguousBuffer& out) override {
+    bool ok = DeflateAll(Z_FINISH, out);
+    // Ready for the next stream.
+    return DeflateTraits::Reset(strm_.Get()) && ok;
+  }
+
+ private:
+  bool DeflateAll(int flush, NoncontiguousBuffer& out) {
+    NoncontiguousBufferBuilder builder;
+    NoncontiguousBufferOutputStream out_stream(&builder);
+    if (!Deflate(strm_.Get(), nullptr, 0, flush, &out_stream)) {
+      return false;
+    }
+    out_stream.Flush();
+    out.Append(builder.DestructiveGet());
+    return true;
+  }
+
+ private:
+  ScopedDeflateStream strm_;
+};
+
+class ZlibDecompressStream : public DecompressStream {
+ public:
+  explicit ZlibDecompressStream(int window_bits) : strm_(window_bits) {}
+
+  bool Valid() const { return static_cast<bool>(strm_); }
+
+  bool Append(const NoncontiguousBuffer& in, NoncontiguousBuffer& out) override {
+    NoncontiguousBufferBuilder builder;
+    NoncontiguousBufferOutputStream out_stream(&builder);
+    z_stream* strm = strm_.Get();
+    for (auto itr = in.begin(); itr != in.end(); ++itr) {
+      strm->next_in = reinterpret_cast<Bytef*>(itr->data());
+      strm->avail_in = itr->size();
+      while (strm->avail_in > 0) {
+        if (finished_) {
+          // Input following the end of stream begins a new one.
+          if (!InflateTraits::Reset(strm)) {
+            return false;
+          }
+          finished_ = false;
+        }
+        int ret = Inflate(strm, &out_stream);
+        if (ret == Z_DATA_ERROR) {
+          return false;
+        }
+        finished_ = (ret == Z_STREAM_END);
+      }
+    }
+    out_stream.Flush();
+    out.Append(builder.DestructiveGet());
+    return true;
+  }
+
+  bool IsFinished() const override { return finished_; }
+
+ private:
+  ScopedInflateStream strm_;
+
+  bool finished_{false};
+};
+
+}  // namespace
+
 bool Compress(CompressType type, const NoncontiguousBuffer& in, NoncontiguousBuffer& out, LevelType level) {
-  z_stream strm;
-  strm.zalloc = Z_NULL;
-  strm.zfree = Z_NULL;
-  strm.opaque = Z_NULL;
-  int ret = deflateInit2(&strm, ConvertLevel(level), Z_DEFLATED, GetWindowBits(type), 8, Z_DEFAULT_STRATEGY);
-  if (ret != Z_OK) {
-    TRPC_FMT_ERROR("deflateInit2 error, ret:{}", ret);
+  ScopedDeflateStream strm({GetWindowBits(type), ConvertLevel(level)});
+  if (!strm) {
     return false;
   }
 
   NoncontiguousBufferBuilder builder;
   NoncontiguousBufferOutputStream out_stream(&builder);
-
-  int flush = Z_NO_FLUSH;
-  auto itr = in.begin();
-  do {
-    if (itr != in.end()) {
-      strm.next_in = reinterpret_cast<Bytef*>(itr->data());
-      strm.avail_in = itr->size();
-      ++itr;
-    } else {
-      flush = Z_FINISH;
-      strm.next_in = Z_NULL;
-      strm.avail_in = 0;
+  for (auto itr = in.begin(); itr != in.end(); ++itr) {
+    if (!Deflate(strm.Get(), itr->data(), itr->size(), Z_NO_FLUSH, &out_stream)) {
+      return false;
     }
-    // Runs deflate(...) until input drained and output still is not full.
-    do {
-      void* data = nullptr;
-      int size = 0;
-      if (!out_stream.Next(&data, &size)) {
-        TRPC_FMT_ERROR("NoncontiguousBufferOutputStream::Next failed.");
-        (void)deflateEnd(&strm);
-        return false;
-      }
-      strm.avail_out = size;
-      strm.next_out = reinterpret_cast<Bytef*>(data);
-      ret = deflate(&strm, flush);
-      // Z_STREAM_ERROR is unreached.
-      TRPC_ASSERT(ret != Z_STREAM_ERROR);
-      out_stream.BackUp(strm.avail_out);
-    } while (strm.avail_out == 0);
-    TRPC_ASSERT(strm.avail_in == 0);
-  } while (flush != Z_FINISH);
-  TRPC_ASSERT(ret == Z_STREAM_END);
-
-  (void)deflateEnd(&strm);
+  }
+  if (!Deflate(strm.Get(), nullptr, 0, Z_FINISH, &out_stream)) {
+    return false;
+  }
+
   out_stream.Flush();
   out = builder.DestructiveGet();
   return true;
 }
 
-// Reference: http://www.zlib.net/zlib_how.html
 bool Decompress(CompressType type, const NoncontiguousBuffer& in, NoncontiguousBuffer& out) {
-  z_stream strm;
-  strm.zalloc = Z_NULL;
-  strm.zfree = Z_NULL;
-  strm.opaque = Z_NULL;
-  strm.avail_in = 0;
-  strm.next_in = Z_NULL;
-  int ret = inflateInit2(&strm, GetWindowBits(type));
-  if (ret != Z_OK) {
-    TRPC_FMT_ERROR("inflateInit2 error, ret:{}", ret);
+  ScopedInflateStream strm(GetWindowBits(type));
+  if (!strm) {
     return false;
   }
 
   NoncontiguousBufferBuilder builder;
   NoncontiguousBufferOutputStream out_stream(&builder);
 
-  auto itr = in.begin();
-  // Runs inflate(...) until input drained and output still is not full.
-  do {
-    if (!(itr != in.end())) {
-      break;
-    }
-    strm.next_in = reinterpret_cast<Bytef*>(itr->data());
-    strm.avail_in = itr->size();
-    ++itr;
-    if (strm.avail_in == 0) {
+  int ret = Z_OK;
+  for (auto itr = in.begin(); itr != in.end() && ret != Z_STREAM_END; ++itr) {
+    if (itr->size() == 0) {
       continue;
     }
-    TRPC_ASSERT(strm.next_in);
-
-    do {
-      void* data = nullptr;
-      int size = 0;
-      if (!out_stream.Next(&data, &size)) {
-        (void)deflateEnd(&strm);
-        return false;
-      }
-      strm.avail_out = size;
-      strm.next_out = reinterpret_cast<Bytef*>(data);
-      ret = inflate(&strm, Z_NO_FLUSH);
-      switch (ret) {
-        // Z_STREAM_ERROR means empty input.
-        case Z_STREAM_ERROR:
-        case Z_NEED_DICT:
-          ret = Z_DATA_ERROR;
-        case Z_DATA_ERROR:
-        case Z_MEM_ERROR:
-          (void)inflateEnd(&strm);
-          TRPC_FMT_ERROR("Decompress inflate error, ret:{}", ret);
-          return false;
-      }
-      out_stream.BackUp(strm.avail_out);
-    } while (strm.avail_out == 0);
-  } while (ret != Z_STREAM_END);
+    strm.Get()->next_in = reinterpret_cast<Bytef*>(itr->data());
+    strm.Get()->avail_in = itr->size();
+    ret = Inflate(strm.Get(), &out_stream);
+    if (ret == Z_DATA_ERROR) {
+      return false;
+    }
+  }
 
-  (void)inflateEnd(&strm);
   if (ret != Z_STREAM_END) {
     TRPC_FMT_ERROR("Decompress error, ret:{}", ret);
     return false;
@@ -161,4 +300,20 @@ bool Decompress(CompressType type, const NoncontiguousBuffer& in, NoncontiguousB
   return true;
 }
 
+CompressStreamPtr MakeCompressStream(CompressType type, LevelType level) {
+  auto stream = std::make_unique<ZlibCompressStream>(GetWindowBits(type), ConvertLevel(level));
+  if (!stream->Valid()) {
+    return nullptr;
+  }
+  return stream;
+}
+
+DecompressStreamPtr MakeDecompressStream(CompressType type) {
+  auto stream = std::make_unique<ZlibDecompressStream>(GetWindowBits(type));
+  if (!stream->Valid()) {
+    return nullptr;
+  }
+  return stream;
+}
+
 }  // namespace trpc::compressor::zlib
@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include "trpc/compressor/compress_stream.h"
 #include "trpc/compressor/compressor_type.h"
 #include "trpc/util/buffer/noncontiguous_buffer.h"
 
@@ -43,4 +44,15 @@ bool Compress(CompressType type, const NoncontiguousBuffer& in, NoncontiguousBuf
 /// @return Returns true on success, false otherwise.
 bool Decompress(CompressType type, const NoncontiguousBuffer& in, NoncontiguousBuffer& out);
 
+/// @brief Creates an incremental compressor, `Flush` emits a sync flush point of deflate.
+/// @param type is the compression algorithm.
+/// @param level indicates the compression quality.
+/// @return Returns nullptr if failed.
+CompressStreamPtr MakeCompressStream(CompressType type, LevelType level);
+
+/// @brief Creates an incremental decompressor.
+/// @param type is the compression algorithm.
+/// @return Returns nullptr if failed.
+DecompressStreamPtr MakeDecompressStream(CompressType type);
+
 }  // namespace trpc::compressor::zlib
@@ -0,0 +1,68 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <memory>
+
+#include "trpc/compressor/compressor_type.h"
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+
+namespace trpc::compressor {
+
+/// @brief Incremental compressor, input is fed block by block (e.g. frames of a stream rpc) without materializing the
+///        whole message, and the compressed bytes are produced as they are ready.
+/// @note  Not thread-safe. After `Finish`, the next `Append` begins a new compressed stream with the same context.
+class CompressStream {
+ public:
+  virtual ~CompressStream() = default;
+
+  /// @brief Compresses the input bytes, the compressed bytes ready so far are appended to output buffer. Some input
+  ///        may be kept by the compressor until `Flush` or `Finish`.
+  /// @param[in] in is the input bytes.
+  /// @param[out] out saves the compressed bytes.
+  /// @return Returns true on success, false otherwise.
+  virtual bool Append(const NoncontiguousBuffer& in, NoncontiguousBuffer& out) = 0;
+
+  /// @brief Outputs all pending compressed bytes, so that the peer is able to decompress all input appended so far,
+  ///        e.g. at the end of a frame. Flushing too often hurts compression ratio.
+  /// @param[out] out saves the compressed bytes.
+  /// @return Returns true on success, false otherwise.
+  virtual bool Flush(NoncontiguousBuffer& out) = 0;
+
+  /// @brief Ends the compressed stream (writes the trailer of the format).
+  /// @param[out] out saves the compressed bytes.
+  /// @return Returns true on success, false otherwise.
+  virtual bool Finish(NoncontiguousBuffer& out) = 0;
+};
+
+/// @brief Incremental decompressor, compressed bytes may be fed in arbitrary pieces.
+/// @note  Not thread-safe. Input following the end of a compressed stream is decompressed as a new stream.
+class DecompressStream {
+ public:
+  virtual ~DecompressStream() = default;
+
+  /// @brief Decompresses the compressed bytes, the uncompressed bytes ready so far are appended to output buffer.
+  /// @param[in] in is the compressed bytes.
+  /// @param[out] out saves the uncompressed bytes.
+  /// @return Returns true on success, false if the input is corrupted.
+  virtual bool Append(const NoncontiguousBuffer& in, NoncontiguousBuffer& out) = 0;
+
+  /// @brief Returns true if the end of compressed stream is reached by the input so far.
+  virtual bool IsFinished() const = 0;
+};
+
+using CompressStreamPtr = std::unique_ptr<CompressStream>;
+using DecompressStreamPtr = std::unique_ptr<DecompressStream>;
+
+}  // namespace trpc::compressor
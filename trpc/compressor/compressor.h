@@ -13,6 +13,7 @@
 
 #pragma once
 
+#include "trpc/compressor/compress_stream.h"
 #include "trpc/compressor/compressor_type.h"
 #include "trpc/util/buffer/noncontiguous_buffer.h"
 #include "trpc/util/ref_ptr.h"
@@ -48,6 +49,15 @@ class Compressor : public RefCounted<Compressor> {
   /// @return Returns true on success, false otherwise.
   bool Decompress(const NoncontiguousBuffer& in, NoncontiguousBuffer& out);
 
+  /// @brief Creates an incremental compressor of the algorithm.
+  /// @param level indicates the compression quality.
+  /// @return Returns nullptr if the algorithm does not support streaming.
+  virtual CompressStreamPtr CreateCompressStream(LevelType level = kDefault) const { return nullptr; }
+
+  /// @brief Creates an incremental decompressor of the algorithm.
+  /// @return Returns nullptr if the algorithm does not support streaming.
+  virtual DecompressStreamPtr CreateDecompressStream() const { return nullptr; }
+
  protected:
   /// @brief Compresses the input bytes and put the compressed bytes into output buffer.
   /// @param[in] in is the input bytes.
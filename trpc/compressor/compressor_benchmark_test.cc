@@ -0,0 +1,126 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "trpc/compressor/compressor_factory.h"
+#include "trpc/compressor/testing/zstd_testing.h"
+#include "trpc/compressor/trpc_compressor.h"
+#include "trpc/compressor/zstd/zstd_dictionary.h"
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+
+// Microbenchmark of compressors, results are printed rather than asserted, as they depend on machine.
+namespace trpc::compressor::testing {
+
+namespace {
+
+constexpr int kMessageNum = 1000;
+constexpr int kRounds = 10;
+
+struct Result {
+  std::size_t plain_size{0};
+  std::size_t compressed_size{0};
+  double compress_ns{0};
+  double decompress_ns{0};
+};
+
+Result RunBenchmark(CompressType type, const std::vector<NoncontiguousBuffer>& messages) {
+  Result result;
+  std::vector<NoncontiguousBuffer> compressed(messages.size());
+  for (std::size_t i = 0; i < messages.size(); ++i) {
+    EXPECT_TRUE(Compress(type, messages[i], compressed[i]));
+    result.plain_size += messages[i].ByteSize();
+    result.compressed_size += compressed[i].ByteSize();
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  for (int round = 0; round < kRounds; ++round) {
+    for (const auto& message : messages) {
+      NoncontiguousBuffer out;
+      Compress(type, message, out);
+    }
+  }
+  result.compress_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+  start = std::chrono::steady_clock::now();
+  for (int round = 0; round < kRounds; ++round) {
+    for (const auto& message : compressed) {
+      NoncontiguousBuffer out;
+      Decompress(type, message, out);
+    }
+  }
+  result.decompress_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+  return result;
+}
+
+void Print(const std::string& name, const Result& result) {
+  // Bytes per nanosecond is GB/s, in MB/s after multiplied by 1000.
+  double plain_bytes = static_cast<double>(result.plain_size) * kRounds;
+  std::cout << name << ": ratio " << static_cast<double>(result.plain_size) / result.compressed_size << ", compress "
+            << plain_bytes / result.compress_ns * 1000 << " MB/s, decompress "
+            << plain_bytes / result.decompress_ns * 1000 << " MB/s" << std::endl;
+}
+
+}  // namespace
+
+// Small messages sharing most of their content, as the body of rpc usually is.
+TEST(CompressorBenchmark, SmallMessages) {
+  ASSERT_TRUE(Init());
+
+  std::mt19937 rng(1);
+  std::vector<NoncontiguousBuffer> messages;
+  for (int i = 0; i < kMessageNum; ++i) {
+    messages.push_back(CreateBufferSlow(GenMessageLikeStr(rng)));
+  }
+
+  Print("gzip", RunBenchmark(kGzip, messages));
+  Print("zlib", RunBenchmark(kZlib, messages));
+  Print("snappy block", RunBenchmark(kSnappyBlock, messages));
+  Print("lz4 frame", RunBenchmark(kLz4Frame, messages));
+  Print("zstd", RunBenchmark(kZstd, messages));
+
+  // Trained by other messages of the same kind.
+  uint32_t dict_id = zstd::AddDictionary(TrainZstdDictionary());
+  ASSERT_TRUE(zstd::SetDefaultDictionary(dict_id));
+  Print("zstd with dictionary", RunBenchmark(kZstd, messages));
+
+  Destroy();
+}
+
+// One large message, where dictionary helps little.
+TEST(CompressorBenchmark, LargeMessage) {
+  ASSERT_TRUE(Init());
+
+  std::mt19937 rng(1);
+  std::string message;
+  while (message.size() < 1024 * 1024) {
+    message += GenMessageLikeStr(rng);
+  }
+  std::vector<NoncontiguousBuffer> messages{CreateBufferSlow(message)};
+
+  Print("gzip", RunBenchmark(kGzip, messages));
+  Print("zlib", RunBenchmark(kZlib, messages));
+  Print("snappy block", RunBenchmark(kSnappyBlock, messages));
+  Print("lz4 frame", RunBenchmark(kLz4Frame, messages));
+  Print("zstd", RunBenchmark(kZstd, messages));
+
+  Destroy();
+}
+
+}  // namespace trpc::compressor::testing
@@ -23,6 +23,12 @@ class GzipCompressor : public Compressor {
  public:
   CompressType Type() const override { return kGzip; }
 
+  CompressStreamPtr CreateCompressStream(LevelType level = kDefault) const override {
+    return zlib::MakeCompressStream(kGzip, level);
+  }
+
+  DecompressStreamPtr CreateDecompressStream() const override { return zlib::MakeDecompressStream(kGzip); }
+
  protected:
   bool DoCompress(const NoncontiguousBuffer& in, NoncontiguousBuffer& out, LevelType level) override {
     return zlib::Compress(kGzip, in, out, level);
@@ -17,6 +17,7 @@
 
 #include <utility>
 
+#include "trpc/compressor/common/context_cache.h"
 #include "trpc/compressor/lz4/lz4_util.h"
 #include "trpc/util/buffer/zero_copy_stream.h"
 
@@ -24,26 +25,26 @@ namespace trpc::compressor {
 
 bool Lz4FrameCompressor::DoCompress(const trpc::NoncontiguousBuffer& in, trpc::NoncontiguousBuffer& out,
                                     LevelType level) {
-  LZ4F_compressionContext_t ctx;
-  const size_t ctx_status = LZ4F_createCompressionContext(&ctx, LZ4F_VERSION);
-  if (LZ4F_isError(ctx_status)) {
+  ScopedContext<lz4::CompressionContextTraits> ctx(0);
+  if (!ctx) {
     return false;
   }
-  bool result = lz4::DoCompress(ctx, in, out);
-  LZ4F_freeCompressionContext(ctx);
-  return result;
+  LZ4F_compressionContext_t cctx = ctx.Get();
+  return lz4::DoCompress(cctx, in, out);
 }
 
 bool Lz4FrameCompressor::DoDecompress(const trpc::NoncontiguousBuffer& in, trpc::NoncontiguousBuffer& out) {
-  LZ4F_dctx* ctx;
-  const size_t ctx_status = LZ4F_createDecompressionContext(&ctx, LZ4F_VERSION);
-  if (LZ4F_isError(ctx_status)) {
-    TRPC_FMT_ERROR("LZ4F_dctx creation error: {}", LZ4F_getErrorName(ctx_status));
+  ScopedContext<lz4::DecompressionContextTraits> ctx(0);
+  if (!ctx) {
     return false;
   }
-  bool result = lz4::DoDecompress(ctx, in, out);
-  LZ4F_freeDecompressionContext(ctx);
-  return result;
+  return lz4::DoDecompress(ctx.Get(), in, out);
 }
 
+CompressStreamPtr Lz4FrameCompressor::CreateCompressStream(LevelType level) const {
+  return lz4::MakeCompressStream();
+}
+
+DecompressStreamPtr Lz4FrameCompressor::CreateDecompressStream() const { return lz4::MakeDecompressStream(); }
+
 }  // namespace trpc::compressor
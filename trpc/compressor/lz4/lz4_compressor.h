@@ -22,6 +22,10 @@ class Lz4FrameCompressor : public Compressor {
  public:
   CompressType Type() const override { return kLz4Frame; }
 
+  CompressStreamPtr CreateCompressStream(LevelType level = kDefault) const override;
+
+  DecompressStreamPtr CreateDecompressStream() const override;
+
  protected:
   bool DoCompress(const NoncontiguousBuffer& in, NoncontiguousBuffer& out, LevelType level) override;
 
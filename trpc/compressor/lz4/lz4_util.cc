@@ -19,6 +19,10 @@
 
 #include "trpc/compressor/lz4/lz4_util.h"
 
+#include <algorithm>
+#include <memory>
+
+#include "trpc/compressor/common/context_cache.h"
 #include "trpc/compressor/common/util.h"
 #include "trpc/util/buffer/contiguous_buffer.h"
 #include "trpc/util/log/logging.h"
@@ -33,26 +37,6 @@ constexpr int kInChunkSize = 16 * 1024;  // buffer chunk size
 
 namespace {
 
-// Calculate block size based on frame info
-size_t GetBlockSize(const LZ4F_frameInfo_t* info) {
-  switch (info->blockSizeID) {
-    case LZ4F_default:
-    case LZ4F_max64KB:
-      return 1 << 16;
-    case LZ4F_max256KB:
-      return 1 << 18;
-    case LZ4F_max1MB:
-      return 1 << 20;
-    case LZ4F_max4MB:
-      return 1 << 22;
-    default:
-      TRPC_FMT_ERROR("Impossible with expected frame specification, block size id:{}",
-                     static_cast<int>(info->blockSizeID));
-      return 0;
-  }
-  return 0;
-}
-
 // Generate lz4 frame preferences according to block size id
 LZ4F_preferences_t GetLz4Pref(LZ4F_blockSizeID_t block_size_id) {
   LZ4F_preferences_t prefs = LZ4F_INIT_PREFERENCES;
@@ -76,37 +60,32 @@ bool CompressedToOutputStream(trpc::NoncontiguousBufferOutputStream* out_stream,
   return true;
 }
 
-bool DecompressSingleBuffer(LZ4F_dctx* ctx, const char* in_data, size_t in_size, void* out, size_t out_capacity,
-                            trpc::NoncontiguousBufferOutputStream* out_stream) {
-  size_t ret = 1;
-  // Decompress:
-  // Continue while there is more input to read (in_data != in_data_end)
-  // and the frame isn't over (ret != 0)
-  char* curr_in_data = const_cast<char*>(in_data);
-  const char* in_data_end = in_data + in_size;
-  while (curr_in_data < in_data_end && ret != 0) {
-    // Any data within dst has been flushed at this stage
-    size_t out_size = out_capacity;
-    size_t curr_in_size = in_data_end - curr_in_data;
-    ret = LZ4F_decompress(ctx, out, &out_size, curr_in_data, &curr_in_size, /* LZ4F_decompressOptions_t */ nullptr);
+// Decompresses a block of input into the output stream directly, it goes on while there is input or the output is
+// full. |frame_end| is set if the last input byte completes a frame.
+bool DecompressBlock(LZ4F_dctx* ctx, const char* in_data, size_t in_size,
+                     trpc::NoncontiguousBufferOutputStream* out_stream, bool* frame_end) {
+  size_t out_size = 0;
+  int next_size = 0;
+  while (in_size > 0 || out_size == static_cast<size_t>(next_size)) {
+    void* next_data = nullptr;
+    if (!out_stream->Next(&next_data, &next_size)) {
+      return false;
+    }
+    out_size = next_size;
+    size_t consumed_size = in_size;
+    size_t ret = LZ4F_decompress(ctx, next_data, &out_size, in_data, &consumed_size, nullptr);
     if (LZ4F_isError(ret)) {
+      out_stream->BackUp(next_size);
       TRPC_FMT_ERROR("Decompression error: {}", LZ4F_getErrorName(ret));
       return false;
     }
-    // Flush output
-    if (out_size != 0) {
-      if (!CopyDataToOutputStream(out, out_size, out_stream)) {
-        TRPC_FMT_ERROR("CopyDataToOutputStream error, out_size={}", out_size);
-        return false;
-      }
+    out_stream->BackUp(next_size - out_size);
+    in_data += consumed_size;
+    in_size -= consumed_size;
+    if (consumed_size > 0 || out_size > 0) {
+      // 0 means the frame is fully decoded, the next input begins a new frame.
+      *frame_end = (ret == 0);
     }
-    // Update input
-    curr_in_data += curr_in_size;
-  }
-
-  if (curr_in_data < in_data_end) {
-    TRPC_FMT_ERROR("Decompress: Trailing data left in file after frame");
-    return false;
   }
   return true;
 }
@@ -147,7 +126,7 @@ bool DoCompress(LZ4F_compressionContext_t& ctx, const NoncontiguousBuffer& in, N
         TRPC_FMT_ERROR("CompressedToOutputStream error, compressed_size={}", compressed_size);
         return false;
       }
-      left_to_copy = -current_size;
+      left_to_copy -= current_size;
       current_pos += current_size;
     }
   }
@@ -168,74 +147,178 @@ bool DoCompress(LZ4F_compressionContext_t& ctx, const NoncontiguousBuffer& in, N
 bool DoDecompress(LZ4F_dctx* ctx, const NoncontiguousBuffer& in, NoncontiguousBuffer& out) {
   NoncontiguousBufferBuilder builder;
   NoncontiguousBufferOutputStream out_stream(&builder);
-  // Read Frame header
-  LZ4F_frameInfo_t info;
-
-  auto itr = in.begin();
-  char* in_data = nullptr;
-  size_t in_size = 0;
-  size_t consumed_size = 0;
-  if (itr != in.end()) {
-    in_data = itr->data();
-    in_size = itr->size();
-    ++itr;
-  }
-  if (in_size >= LZ4F_HEADER_SIZE_MAX) {
-    consumed_size = in_size;
-    const size_t status = LZ4F_getFrameInfo(ctx, &info, in_data, &consumed_size);
-    if (LZ4F_isError(status)) {
-      TRPC_FMT_ERROR("LZ4F_getFrameInfo error: {}", LZ4F_getErrorName(status));
+  // The frame header may be split into several blocks, LZ4F_decompress buffers it internally.
+  bool frame_end = false;
+  for (auto itr = in.begin(); itr != in.end(); ++itr) {
+    if (!DecompressBlock(ctx, itr->data(), itr->size(), &out_stream, &frame_end)) {
       return false;
     }
-  } else {
-    TRPC_ASSERT(kInChunkSize >= LZ4F_HEADER_SIZE_MAX);
-    trpc::BufferPtr header_buff = MakeRefCounted<trpc::Buffer>(kInChunkSize);
-    memcpy(header_buff->GetWritePtr(), reinterpret_cast<const char*>(in_data), in_size);
-    header_buff->AddWriteLen(in_size);
-    size_t total_header_buffer_size = in_size;
-    size_t total_in_buffer_size = in_size;
-    for (; itr != in.end(); ++itr) {
-      if (header_buff->ReadableSize() >= LZ4F_HEADER_SIZE_MAX) {
-        break;
-      }
-      in_data = itr->data();
-      in_size = itr->size();
-      size_t writeable_size = in_size;
-      if (in_size > header_buff->WritableSize()) {
-        writeable_size = header_buff->WritableSize();
+  }
+  if (!frame_end) {
+    TRPC_FMT_ERROR("Decompress: incomplete lz4 frame");
+    return false;
+  }
+  out_stream.Flush();
+  out = builder.DestructiveGet();
+  return true;
+}
+// End of source codes that are from lz4.
+
+LZ4F_cctx* CompressionContextTraits::Create(int) {
+  LZ4F_cctx* ctx = nullptr;
+  const size_t ctx_status = LZ4F_createCompressionContext(&ctx, LZ4F_VERSION);
+  if (LZ4F_isError(ctx_status)) {
+    TRPC_FMT_ERROR("LZ4F_cctx creation error: {}", LZ4F_getErrorName(ctx_status));
+    return nullptr;
+  }
+  return ctx;
+}
+
+LZ4F_dctx* DecompressionContextTraits::Create(int) {
+  LZ4F_dctx* ctx = nullptr;
+  const size_t ctx_status = LZ4F_createDecompressionContext(&ctx, LZ4F_VERSION);
+  if (LZ4F_isError(ctx_status)) {
+    TRPC_FMT_ERROR("LZ4F_dctx creation error: {}", LZ4F_getErrorName(ctx_status));
+    return nullptr;
+  }
+  return ctx;
+}
+
+namespace {
+
+class Lz4CompressStream : public CompressStream {
+ public:
+  Lz4CompressStream()
+      : ctx_(0),
+        prefs_(GetLz4Pref(LZ4F_max256KB)),
+        out_capacity_(LZ4F_compressBound(kInChunkSize, &prefs_)),
+        out_buff_(MakeRefCounted<trpc::Buffer>(out_capacity_)) {}
+
+  bool Valid() const { return static_cast<bool>(ctx_); }
+
+  bool Append(const NoncontiguousBuffer& in, NoncontiguousBuffer& out) override {
+    NoncontiguousBufferBuilder builder;
+    NoncontiguousBufferOutputStream out_stream(&builder);
+    if (!started_ && !Begin(&out_stream)) {
+      return false;
+    }
+    for (auto itr = in.begin(); itr != in.end(); ++itr) {
+      const char* in_data = itr->data();
+      size_t left_size = itr->size();
+      while (left_size > 0) {
+        size_t current_size = std::min<size_t>(left_size, kInChunkSize);
+        size_t compressed_size =
+            LZ4F_compressUpdate(ctx_.Get(), out_buff_->GetWritePtr(), out_capacity_, in_data, current_size, nullptr);
+        if (!CompressedToOutputStream(&out_stream, out_buff_->GetReadPtr(), compressed_size)) {
+          return false;
+        }
+        in_data += current_size;
+        left_size -= current_size;
       }
-      memcpy(header_buff->GetWritePtr(), reinterpret_cast<const char*>(in_data), writeable_size);
-      header_buff->AddWriteLen(writeable_size);
-      total_header_buffer_size += writeable_size;
-      total_in_buffer_size += in_size;
     }
-    size_t buff_consumed_size = total_header_buffer_size;
-    const size_t status = LZ4F_getFrameInfo(ctx, &info, header_buff->GetReadPtr(), &buff_consumed_size);
-    if (LZ4F_isError(status)) {
-      TRPC_FMT_ERROR("LZ4F_getFrameInfo error: {}", LZ4F_getErrorName(status));
+    out_stream.Flush();
+    out.Append(builder.DestructiveGet());
+    return true;
+  }
+
+  bool Flush(NoncontiguousBuffer& out) override {
+    if (!started_) {
+      return true;
+    }
+    NoncontiguousBufferBuilder builder;
+    NoncontiguousBufferOutputStream out_stream(&builder);
+    size_t compressed_size = LZ4F_flush(ctx_.Get(), out_buff_->GetWritePtr(), out_capacity_, nullptr);
+    if (!CompressedToOutputStream(&out_stream, out_buff_->GetReadPtr(), compressed_size)) {
       return false;
     }
-    size_t left_size = total_in_buffer_size - buff_consumed_size;
-    consumed_size = in_size - left_size;
+    out_stream.Flush();
+    out.Append(builder.DestructiveGet());
+    return true;
   }
-  size_t const out_capacity = GetBlockSize(&info);
-  trpc::BufferPtr out_buff = MakeRefCounted<trpc::Buffer>(out_capacity);
-  TRPC_ASSERT(consumed_size <= in_size);
-  if (!DecompressSingleBuffer(ctx, in_data + consumed_size, in_size - consumed_size, out_buff->GetWritePtr(),
-                              out_capacity, &out_stream)) {
-    return false;
+
+  bool Finish(NoncontiguousBuffer& out) override {
+    NoncontiguousBufferBuilder builder;
+    NoncontiguousBufferOutputStream out_stream(&builder);
+    if (!started_ && !Begin(&out_stream)) {
+      return false;
+    }
+    // The next Append begins a new frame.
+    started_ = false;
+    size_t compressed_size = LZ4F_compressEnd(ctx_.Get(), out_buff_->GetWritePtr(), out_capacity_, nullptr);
+    if (!CompressedToOutputStream(&out_stream, out_buff_->GetReadPtr(), compressed_size)) {
+      return false;
+    }
+    out_stream.Flush();
+    out.Append(builder.DestructiveGet());
+    return true;
   }
-  for (; itr != in.end(); ++itr) {
-    in_data = itr->data();
-    in_size = itr->size();
-    if (!DecompressSingleBuffer(ctx, in_data, in_size, out_buff->GetWritePtr(), out_capacity, &out_stream)) {
+
+ private:
+  bool Begin(NoncontiguousBufferOutputStream* out_stream) {
+    size_t header_size = LZ4F_compressBegin(ctx_.Get(), out_buff_->GetWritePtr(), out_capacity_, &prefs_);
+    if (!CompressedToOutputStream(out_stream, out_buff_->GetReadPtr(), header_size)) {
       return false;
     }
+    started_ = true;
+    return true;
   }
-  out_stream.Flush();
-  out = builder.DestructiveGet();
-  return true;
+
+ private:
+  ScopedContext<CompressionContextTraits> ctx_;
+
+  LZ4F_preferences_t prefs_;
+
+  // Large enough for any input <= kInChunkSize.
+  size_t out_capacity_;
+
+  trpc::BufferPtr out_buff_;
+
+  bool started_{false};
+};
+
+class Lz4DecompressStream : public DecompressStream {
+ public:
+  Lz4DecompressStream() : ctx_(0) {}
+
+  bool Valid() const { return static_cast<bool>(ctx_); }
+
+  bool Append(const NoncontiguousBuffer& in, NoncontiguousBuffer& out) override {
+    NoncontiguousBufferBuilder builder;
+    NoncontiguousBufferOutputStream out_stream(&builder);
+    for (auto itr = in.begin(); itr != in.end(); ++itr) {
+      if (!DecompressBlock(ctx_.Get(), itr->data(), itr->size(), &out_stream, &finished_)) {
+        return false;
+      }
+    }
+    out_stream.Flush();
+    out.Append(builder.DestructiveGet());
+    return true;
+  }
+
+  bool IsFinished() const override { return finished_; }
+
+ private:
+  ScopedContext<DecompressionContextTraits> ctx_;
+
+  bool finished_{false};
+};
+
+}  // namespace
+
+CompressStreamPtr MakeCompressStream() {
+  auto stream = std::make_unique<Lz4CompressStream>();
+  if (!stream->Valid()) {
+    return nullptr;
+  }
+  return stream;
+}
+
+DecompressStreamPtr MakeDecompressStream() {
+  auto stream = std::make_unique<Lz4DecompressStream>();
+  if (!stream->Valid()) {
+    return nullptr;
+  }
+  return stream;
 }
-// End of source codes that are from lz4.
 
 }  // namespace trpc::compressor::lz4
@@ -15,11 +15,43 @@
 
 #include "lz4frame.h"
 
+#include "trpc/compressor/compress_stream.h"
 #include "trpc/compressor/compressor_type.h"
 #include "trpc/util/buffer/noncontiguous_buffer.h"
 
 namespace trpc::compressor::lz4 {
 
+/// @brief Traits of compress context for `ContextCache`, contexts are interchangeable so key is always 0.
+/// @private
+struct CompressionContextTraits {
+  using Context = LZ4F_cctx;
+  using Key = int;
+
+  static LZ4F_cctx* Create(int);
+
+  // LZ4F_compressBegin resets the context.
+  static bool Reset(LZ4F_cctx*) { return true; }
+
+  static void Destroy(LZ4F_cctx* ctx) { LZ4F_freeCompressionContext(ctx); }
+};
+
+/// @brief Traits of decompress context for `ContextCache`, contexts are interchangeable so key is always 0.
+/// @private
+struct DecompressionContextTraits {
+  using Context = LZ4F_dctx;
+  using Key = int;
+
+  static LZ4F_dctx* Create(int);
+
+  static bool Reset(LZ4F_dctx* ctx) {
+    // The context may stop in the middle of a frame on error.
+    LZ4F_resetDecompressionContext(ctx);
+    return true;
+  }
+
+  static void Destroy(LZ4F_dctx* ctx) { LZ4F_freeDecompressionContext(ctx); }
+};
+
 /// @brief Lz4 compress
 /// @param ctx Compress context
 /// @param[in] in Data before compressed
@@ -34,4 +66,12 @@ bool DoCompress(LZ4F_compressionContext_t& ctx, const NoncontiguousBuffer& in, N
 /// @return true: success, false: failed
 bool DoDecompress(LZ4F_dctx* ctx, const NoncontiguousBuffer& in, NoncontiguousBuffer& out);
 
+/// @brief Creates an incremental compressor of lz4 frame, `Flush` outputs the buffered block.
+/// @return Returns nullptr if failed.
+CompressStreamPtr MakeCompressStream();
+
+/// @brief Creates an incremental decompressor of lz4 frame.
+/// @return Returns nullptr if failed.
+DecompressStreamPtr MakeDecompressStream();
+
 }  // namespace trpc::compressor::lz4
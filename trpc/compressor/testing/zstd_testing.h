@@ -0,0 +1,60 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "zdict.h"
+
+namespace trpc::compressor::testing {
+
+/// @brief Generates a small message looking like the json of a user profile, messages share most of their fields.
+inline std::string GenMessageLikeStr(std::mt19937& rng) {
+  static const char* kRegions[] = {"guangdong", "beijing", "shanghai", "sichuan", "zhejiang"};
+  static const char* kTags[] = {"sports", "music", "movie", "travel", "game", "food"};
+
+  std::uniform_int_distribution<uint32_t> dist;
+  std::string uid = std::to_string(dist(rng));
+  std::string msg = "{\"uid\":" + uid + ",\"nickname\":\"user_" + uid;
+  msg += "\",\"avatar\":\"https://cdn.example.com/avatar/" + uid + ".png\",\"level\":";
+  msg += std::to_string(dist(rng) % 100) + ",\"region\":\"" + kRegions[dist(rng) % 5];
+  msg += "\",\"tags\":[\"" + std::string(kTags[dist(rng) % 6]) + "\",\"" + kTags[dist(rng) % 6] + "\"],\"vip\":";
+  msg += (dist(rng) % 2 ? "true" : "false");
+  msg += ",\"last_login\":" + std::to_string(1700000000 + dist(rng) % 10000000) + "}";
+  return msg;
+}
+
+/// @brief Trains a zstd dictionary from messages generated by `GenMessageLikeStr`, the same as `zstd --train`.
+/// @return Returns empty string on failure.
+inline std::string TrainZstdDictionary(std::size_t capacity = 8 * 1024, std::size_t sample_num = 2000) {
+  std::mt19937 rng(0);
+  std::string samples;
+  std::vector<std::size_t> sizes;
+  for (std::size_t i = 0; i < sample_num; ++i) {
+    auto sample = GenMessageLikeStr(rng);
+    samples += sample;
+    sizes.push_back(sample.size());
+  }
+  std::string dict(capacity, '\0');
+  std::size_t size = ZDICT_trainFromBuffer(dict.data(), dict.size(), samples.data(), sizes.data(), sizes.size());
+  if (ZDICT_isError(size)) {
+    return "";
+  }
+  dict.resize(size);
+  return dict;
+}
+
+}  // namespace trpc::compressor::testing
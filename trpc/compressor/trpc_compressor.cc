@@ -15,11 +15,17 @@
 
 #include <utility>
 
+#include "trpc/common/config/trpc_config.h"
+#include "trpc/compressor/adaptive_compression.h"
+#include "trpc/compressor/adaptive_compression_conf_parser.h"
 #include "trpc/compressor/compressor_factory.h"
 #include "trpc/compressor/gzip/gzip_compressor.h"
 #include "trpc/compressor/lz4/lz4_compressor.h"
 #include "trpc/compressor/snappy/snappy_compressor.h"
 #include "trpc/compressor/zlib/zlib_compressor.h"
+#include "trpc/compressor/zstd/zstd_compressor.h"
+#include "trpc/compressor/zstd/zstd_conf_parser.h"
+#include "trpc/compressor/zstd/zstd_dictionary.h"
 #include "trpc/util/likely.h"
 #include "trpc/util/log/logging.h"
 
@@ -40,11 +46,29 @@ bool Init() {
   // lz4 frame
   TRPC_ASSERT(factory->Register(MakeRefCounted<Lz4FrameCompressor>()));
 
+  // zstd, dictionaries are optional
+  ZstdConfig zstd_config;
+  if (TrpcConfig::GetInstance()->GetPluginConfig("compressor", "zstd", zstd_config)) {
+    zstd_config.Display();
+    if (!zstd::InitDictionaries(zstd_config)) {
+      TRPC_FMT_ERROR("Failed to init zstd dictionaries");
+      return false;
+    }
+  }
+  TRPC_ASSERT(factory->Register(MakeRefCounted<ZstdCompressor>()));
+
+  AdaptiveCompressionConfig adaptive_config;
+  if (TrpcConfig::GetInstance()->GetPluginConfig("compressor", "adaptive", adaptive_config)) {
+    adaptive_config.Display();
+    AdaptiveCompression::GetInstance()->SetConfig(adaptive_config);
+  }
+
   return true;
 }
 
 void Destroy() {
   CompressorFactory::GetInstance()->Clear();
+  zstd::ClearDictionaries();
 }
 
 bool CompressIfNeeded(CompressType type, NoncontiguousBuffer& data, LevelType level) {
@@ -59,6 +83,23 @@ bool CompressIfNeeded(CompressType type, NoncontiguousBuffer& data, LevelType le
   return true;
 }
 
+bool AdaptiveCompressIfNeeded(CompressType& type, NoncontiguousBuffer& data, LevelType level, std::string_view method) {
+  if (type == kNone) {
+    return true;
+  }
+  auto* adaptive = AdaptiveCompression::GetInstance();
+  if (!adaptive->ShouldCompress(method, data)) {
+    type = kNone;
+    return true;
+  }
+  std::size_t uncompressed_size = data.ByteSize();
+  if (TRPC_UNLIKELY(!CompressIfNeeded(type, data, level))) {
+    return false;
+  }
+  adaptive->Report(method, uncompressed_size, data.ByteSize());
+  return true;
+}
+
 bool Compress(CompressType type, const NoncontiguousBuffer& in, NoncontiguousBuffer& out, LevelType level) {
   // Returns false on compressor::kNone
   auto compressor = CompressorFactory::GetInstance()->Get(type);
@@ -89,4 +130,20 @@ bool Decompress(CompressType type, const NoncontiguousBuffer& in, NoncontiguousB
   return compressor->Decompress(in, out);
 }
 
+CompressStreamPtr MakeCompressStream(CompressType type, LevelType level) {
+  auto compressor = CompressorFactory::GetInstance()->Get(type);
+  if (TRPC_UNLIKELY(!compressor)) {
+    return nullptr;
+  }
+  return compressor->CreateCompressStream(level);
+}
+
+DecompressStreamPtr MakeDecompressStream(CompressType type) {
+  auto compressor = CompressorFactory::GetInstance()->Get(type);
+  if (TRPC_UNLIKELY(!compressor)) {
+    return nullptr;
+  }
+  return compressor->CreateDecompressStream();
+}
+
 }  // namespace trpc::compressor
@@ -13,6 +13,9 @@
 
 #pragma once
 
+#include <string_view>
+
+#include "trpc/compressor/compress_stream.h"
 #include "trpc/compressor/compressor_type.h"
 #include "trpc/util/buffer/noncontiguous_buffer.h"
 
@@ -48,6 +51,15 @@ bool Decompress(CompressType type, const NoncontiguousBuffer& in, NoncontiguousB
 /// @return Returns true on success, false otherwise. Keep in mind: it always returns ture when |type| is "kNone".
 bool CompressIfNeeded(CompressType type, NoncontiguousBuffer& data, LevelType level = kDefault);
 
+/// @brief Same as `CompressIfNeeded`, but data not worth compressing is left uncompressed when adaptive compression
+///        is enabled (see `AdaptiveCompression`).
+/// @param[in,out] type is the compression algorithm, it's set to "kNone" if the data is left uncompressed.
+/// @param data is the input bytes(it will be overwritten if compressed successfully).
+/// @param level indicates the compression quality.
+/// @param method identifies the kind of data whose compression ratio is tracked, e.g. the rpc method name.
+/// @return Returns true on success, false otherwise.
+bool AdaptiveCompressIfNeeded(CompressType& type, NoncontiguousBuffer& data, LevelType level, std::string_view method);
+
 /// @brief Decompresses the compressed bytes and put the uncompressed bytes into output buffer if the |type| is not
 /// "kNone".
 /// @param type is the compression algorithm.
@@ -55,4 +67,15 @@ bool CompressIfNeeded(CompressType type, NoncontiguousBuffer& data, LevelType le
 /// @return Returns true on success, false otherwise. Keep in mind: it always returns ture when |type| is "kNone".
 bool DecompressIfNeeded(CompressType type, NoncontiguousBuffer& data);
 
+/// @brief Creates an incremental compressor, which compresses a message (e.g. frames of a stream) block by block.
+/// @param type is the compression algorithm.
+/// @param level indicates the compression quality.
+/// @return Returns nullptr if |type| is not registered or does not support streaming (gzip, zlib, lz4 frame do).
+CompressStreamPtr MakeCompressStream(CompressType type, LevelType level = kDefault);
+
+/// @brief Creates an incremental decompressor.
+/// @param type is the compression algorithm.
+/// @return Returns nullptr if |type| is not registered or does not support streaming.
+DecompressStreamPtr MakeDecompressStream(CompressType type);
+
 }  // namespace trpc::compressor
@@ -13,8 +13,12 @@
 
 #include "trpc/compressor/trpc_compressor.h"
 
+#include <algorithm>
+#include <string>
+
 #include "gtest/gtest.h"
 
+#include "trpc/compressor/adaptive_compression.h"
 #include "trpc/compressor/compressor_factory.h"
 #include "trpc/compressor/testing/compressor_testing.h"
 #include "trpc/util/buffer/buffer.h"
@@ -23,6 +27,7 @@ namespace trpc::compressor::testing {
 
 TEST(TrpcCompressor, Init) {
   ASSERT_TRUE(Init());
+  ASSERT_NE(CompressorFactory::GetInstance()->Get(kZstd), nullptr);
   Destroy();
 }
 
@@ -109,4 +114,93 @@ TEST(TrpcCompressor, CompressorTypeMaxType) {
   ASSERT_FALSE(Decompress(kMaxType, in, out));
 }
 
+TEST(TrpcCompressor, CompressStream) {
+  ASSERT_TRUE(Init());
+
+  std::string in = GenRandomStr(100 * 1024);
+  for (CompressType type : {kGzip, kZlib, kLz4Frame}) {
+    auto compress_stream = MakeCompressStream(type);
+    auto decompress_stream = MakeDecompressStream(type);
+    ASSERT_TRUE(compress_stream && decompress_stream);
+
+    // Two messages over the same streams, each one is fed in frames of different sizes.
+    for (int round = 0; round < 2; ++round) {
+      NoncontiguousBuffer compressed;
+      NoncontiguousBuffer decompressed;
+      std::size_t pos = 0;
+      for (std::size_t frame_size : {1, 100, 4096, 70000}) {
+        frame_size = std::min(frame_size, in.size() - pos);
+        NoncontiguousBuffer frame;
+        ASSERT_TRUE(compress_stream->Append(CreateBufferSlow(in.data() + pos, frame_size), frame));
+        ASSERT_TRUE(compress_stream->Flush(frame));
+        pos += frame_size;
+
+        // Everything appended so far is decompressed once flushed.
+        ASSERT_TRUE(decompress_stream->Append(frame, decompressed));
+        ASSERT_EQ(FlattenSlow(decompressed), in.substr(0, pos));
+        compressed.Append(std::move(frame));
+      }
+      NoncontiguousBuffer tail;
+      ASSERT_TRUE(compress_stream->Append(CreateBufferSlow(in.data() + pos, in.size() - pos), tail));
+      ASSERT_TRUE(compress_stream->Finish(tail));
+      ASSERT_FALSE(decompress_stream->IsFinished());
+      compressed.Append(tail);
+
+      // Fed byte by byte.
+      std::string tail_str = FlattenSlow(tail);
+      for (char c : tail_str) {
+        ASSERT_TRUE(decompress_stream->Append(CreateBufferSlow(&c, 1), decompressed));
+      }
+      ASSERT_TRUE(decompress_stream->IsFinished());
+      ASSERT_EQ(FlattenSlow(decompressed), in);
+
+      // The whole stream is a valid message of the one-shot api.
+      NoncontiguousBuffer out;
+      ASSERT_TRUE(Decompress(type, compressed, out));
+      ASSERT_EQ(FlattenSlow(out), in);
+    }
+  }
+
+  ASSERT_FALSE(MakeCompressStream(kNone));
+  ASSERT_FALSE(MakeDecompressStream(kMaxType));
+
+  auto decompress_stream = MakeDecompressStream(kGzip);
+  NoncontiguousBuffer out;
+  ASSERT_FALSE(decompress_stream->Append(CreateBufferSlow("hello world"), out));
+
+  Destroy();
+}
+
+TEST(TrpcCompressor, AdaptiveCompress) {
+  ASSERT_TRUE(Init());
+  std::string str;
+  while (str.size() < 4096) {
+    str += "hello world ";
+  }
+
+  // Always compressed if adaptive compression is not enabled.
+  CompressType type = kZlib;
+  NoncontiguousBuffer data = CreateBufferSlow("hello world");
+  ASSERT_TRUE(AdaptiveCompressIfNeeded(type, data, kDefault, "/trpc.test.Greeter/SayHello"));
+  ASSERT_EQ(type, kZlib);
+
+  AdaptiveCompressionConfig config;
+  config.enable = true;
+  AdaptiveCompression::GetInstance()->SetConfig(config);
+
+  data = CreateBufferSlow("hello world");
+  ASSERT_TRUE(AdaptiveCompressIfNeeded(type, data, kDefault, "/trpc.test.Greeter/SayHello"));
+  ASSERT_EQ(type, kNone);
+  ASSERT_EQ(FlattenSlow(data), "hello world");
+
+  type = kZlib;
+  data = CreateBufferSlow(str);
+  ASSERT_TRUE(AdaptiveCompressIfNeeded(type, data, kDefault, "/trpc.test.Greeter/SayHello"));
+  ASSERT_EQ(type, kZlib);
+  ASSERT_LT(data.ByteSize(), str.size());
+
+  AdaptiveCompression::GetInstance()->SetConfig(AdaptiveCompressionConfig{});
+  Destroy();
+}
+
 }  // namespace trpc::compressor::testing
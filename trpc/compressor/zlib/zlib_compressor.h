@@ -23,6 +23,12 @@ class ZlibCompressor : public Compressor {
  public:
   CompressType Type() const override { return kZlib; }
 
+  CompressStreamPtr CreateCompressStream(LevelType level = kDefault) const override {
+    return zlib::MakeCompressStream(kZlib, level);
+  }
+
+  DecompressStreamPtr CreateDecompressStream() const override { return zlib::MakeDecompressStream(kZlib); }
+
  protected:
   bool DoCompress(const NoncontiguousBuffer& in, NoncontiguousBuffer& out, LevelType level) override {
     return zlib::Compress(kZlib, in, out, level);
@@ -0,0 +1,176 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/compressor/zstd/zstd_compressor.h"
+
+#include "zstd.h"
+
+#include "trpc/compressor/common/context_cache.h"
+#include "trpc/compressor/zstd/zstd_dictionary.h"
+#include "trpc/util/buffer/zero_copy_stream.h"
+#include "trpc/util/log/logging.h"
+
+namespace trpc::compressor {
+
+namespace {
+
+// Contexts are reset with their parameters and dictionary, so they are interchangeable and key is always 0.
+struct CompressionContextTraits {
+  using Context = ZSTD_CCtx;
+  using Key = int;
+
+  static ZSTD_CCtx* Create(int) { return ZSTD_createCCtx(); }
+
+  static bool Reset(ZSTD_CCtx* ctx) { return !ZSTD_isError(ZSTD_CCtx_reset(ctx, ZSTD_reset_session_and_parameters)); }
+
+  static void Destroy(ZSTD_CCtx* ctx) { ZSTD_freeCCtx(ctx); }
+};
+
+struct DecompressionContextTraits {
+  using Context = ZSTD_DCtx;
+  using Key = int;
+
+  static ZSTD_DCtx* Create(int) { return ZSTD_createDCtx(); }
+
+  static bool Reset(ZSTD_DCtx* ctx) { return !ZSTD_isError(ZSTD_DCtx_reset(ctx, ZSTD_reset_session_and_parameters)); }
+
+  static void Destroy(ZSTD_DCtx* ctx) { ZSTD_freeDCtx(ctx); }
+};
+
+int ConvertLevel(LevelType level) {
+  switch (level) {
+    case kFastest:
+      return 1;
+    case kBest:
+      return 19;
+    default:
+      // Same as ZSTD_CLEVEL_DEFAULT.
+      return 3;
+  }
+}
+
+// Compresses the input into the output stream directly, until the input is consumed, or the frame is ended if `mode`
+// is ZSTD_e_end.
+bool CompressToStream(ZSTD_CCtx* ctx, ZSTD_inBuffer* input, ZSTD_EndDirective mode,
+                      NoncontiguousBufferOutputStream* out_stream) {
+  while (true) {
+    void* data = nullptr;
+    int size = 0;
+    if (!out_stream->Next(&data, &size)) {
+      return false;
+    }
+    ZSTD_outBuffer output{data, static_cast<std::size_t>(size), 0};
+    std::size_t ret = ZSTD_compressStream2(ctx, &output, input, mode);
+    out_stream->BackUp(size - static_cast<int>(output.pos));
+    if (ZSTD_isError(ret)) {
+      TRPC_FMT_ERROR("Zstd compression error: {}", ZSTD_getErrorName(ret));
+      return false;
+    }
+    if (mode == ZSTD_e_end ? ret == 0 : input->pos == input->size) {
+      return true;
+    }
+  }
+}
+
+}  // namespace
+
+bool ZstdCompressor::DoCompress(const NoncontiguousBuffer& in, NoncontiguousBuffer& out, LevelType level) {
+  ScopedContext<CompressionContextTraits> ctx(0);
+  if (!ctx) {
+    return false;
+  }
+  int zstd_level = ConvertLevel(level);
+  uint32_t dict_id = zstd::GetCompressionDictionary();
+  if (dict_id != 0) {
+    const ZSTD_CDict* cdict = zstd::GetCDict(dict_id, zstd_level);
+    if (!cdict) {
+      TRPC_FMT_ERROR("Zstd dictionary {} is not available", dict_id);
+      return false;
+    }
+    ZSTD_CCtx_refCDict(ctx.Get(), cdict);
+  } else {
+    ZSTD_CCtx_setParameter(ctx.Get(), ZSTD_c_compressionLevel, zstd_level);
+  }
+  // So the content size is written to the frame header, and parameters are tuned for small input.
+  ZSTD_CCtx_setPledgedSrcSize(ctx.Get(), in.ByteSize());
+
+  NoncontiguousBufferBuilder builder;
+  NoncontiguousBufferOutputStream out_stream(&builder);
+  for (auto itr = in.begin(); itr != in.end(); ++itr) {
+    ZSTD_inBuffer input{itr->data(), itr->size(), 0};
+    if (!CompressToStream(ctx.Get(), &input, ZSTD_e_continue, &out_stream)) {
+      return false;
+    }
+  }
+  ZSTD_inBuffer input{nullptr, 0, 0};
+  if (!CompressToStream(ctx.Get(), &input, ZSTD_e_end, &out_stream)) {
+    return false;
+  }
+  out_stream.Flush();
+  out = builder.DestructiveGet();
+  return true;
+}
+
+bool ZstdCompressor::DoDecompress(const NoncontiguousBuffer& in, NoncontiguousBuffer& out) {
+  ScopedContext<DecompressionContextTraits> ctx(0);
+  if (!ctx) {
+    return false;
+  }
+  uint32_t dict_id = zstd::GetFrameDictionary(in);
+  if (dict_id != 0) {
+    const ZSTD_DDict* ddict = zstd::GetDDict(dict_id);
+    if (!ddict) {
+      TRPC_FMT_ERROR("Zstd dictionary {} is not registered", dict_id);
+      return false;
+    }
+    ZSTD_DCtx_refDDict(ctx.Get(), ddict);
+  }
+
+  NoncontiguousBufferBuilder builder;
+  NoncontiguousBufferOutputStream out_stream(&builder);
+  bool frame_end = false;
+  for (auto itr = in.begin(); itr != in.end(); ++itr) {
+    ZSTD_inBuffer input{itr->data(), itr->size(), 0};
+    bool output_full = false;
+    // Goes on while there is input, or the output is full as more data may be buffered by the context.
+    while (input.pos < input.size || output_full) {
+      void* data = nullptr;
+      int size = 0;
+      if (!out_stream.Next(&data, &size)) {
+        return false;
+      }
+      ZSTD_outBuffer output{data, static_cast<std::size_t>(size), 0};
+      std::size_t consumed_pos = input.pos;
+      std::size_t ret = ZSTD_decompressStream(ctx.Get(), &output, &input);
+      out_stream.BackUp(size - static_cast<int>(output.pos));
+      if (ZSTD_isError(ret)) {
+        TRPC_FMT_ERROR("Zstd decompression error: {}", ZSTD_getErrorName(ret));
+        return false;
+      }
+      output_full = output.pos == output.size;
+      if (input.pos > consumed_pos || output.pos > 0) {
+        // 0 means the frame is fully decoded and flushed, the next input begins a new frame.
+        frame_end = ret == 0;
+      }
+    }
+  }
+  if (!frame_end) {
+    TRPC_FMT_ERROR("Zstd decompression error: incomplete frame");
+    return false;
+  }
+  out_stream.Flush();
+  out = builder.DestructiveGet();
+  return true;
+}
+
+}  // namespace trpc::compressor
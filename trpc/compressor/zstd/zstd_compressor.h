@@ -0,0 +1,34 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include "trpc/compressor/compressor.h"
+
+namespace trpc::compressor {
+
+/// @brief Implementation of zstd compress/decompress.
+/// @note  Data is compressed by the default dictionary (see `zstd::SetDefaultDictionary`) if there is one, unless in
+///        the scope of `zstd::ScopedNoDictionary`. The ID of dictionary is carried in the frame header, so it is
+///        decompressed by the registered dictionary of that ID.
+class ZstdCompressor : public Compressor {
+ public:
+  CompressType Type() const override { return kZstd; }
+
+ protected:
+  bool DoCompress(const NoncontiguousBuffer& in, NoncontiguousBuffer& out, LevelType level) override;
+
+  bool DoDecompress(const NoncontiguousBuffer& in, NoncontiguousBuffer& out) override;
+};
+
+}  // namespace trpc::compressor
@@ -0,0 +1,160 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/compressor/zstd/zstd_compressor.h"
+
+#include <random>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "zstd.h"
+
+#include "trpc/compressor/testing/compressor_testing.h"
+#include "trpc/compressor/testing/zstd_testing.h"
+#include "trpc/compressor/zstd/zstd_dictionary.h"
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+
+namespace trpc::compressor::testing {
+
+namespace {
+
+NoncontiguousBuffer SplitToBlocks(const std::string& str, std::size_t block_size) {
+  NoncontiguousBufferBuilder builder;
+  for (std::size_t pos = 0; pos < str.size(); pos += block_size) {
+    builder.Append(str.substr(pos, block_size));
+  }
+  return builder.DestructiveGet();
+}
+
+}  // namespace
+
+TEST(ZstdCompressor, Type) {
+  ZstdCompressor compressor;
+  ASSERT_EQ(compressor.Type(), kZstd);
+}
+
+TEST(ZstdCompressor, CompressStr) {
+  ZstdCompressor compressor;
+
+  for (const auto& in : {std::string(), std::string("ab"), GenRandomStr(10 * 1024 * 1024)}) {
+    for (LevelType level : {kFastest, kDefault, kBest}) {
+      // Skips the slow level for large input.
+      if (level == kBest && in.size() > 1024) {
+        continue;
+      }
+      NoncontiguousBuffer compress_out;
+      ASSERT_TRUE(compressor.Compress(CreateBufferSlow(in), compress_out, level));
+
+      // Compatible with the one-shot API of zstd.
+      auto compressed = FlattenSlow(compress_out);
+      ASSERT_EQ(ZSTD_getFrameContentSize(compressed.data(), compressed.size()), in.size());
+      std::string plain(in.size(), '\0');
+      ASSERT_EQ(ZSTD_decompress(plain.data(), plain.size(), compressed.data(), compressed.size()), in.size());
+      ASSERT_EQ(plain, in);
+
+      NoncontiguousBuffer decompress_out;
+      ASSERT_TRUE(compressor.Decompress(compress_out, decompress_out));
+      ASSERT_EQ(FlattenSlow(decompress_out), in);
+    }
+  }
+}
+
+TEST(ZstdCompressor, SmallBlocks) {
+  ZstdCompressor compressor;
+  auto in = GenRandomStr(100 * 1024);
+
+  NoncontiguousBuffer compress_out;
+  ASSERT_TRUE(compressor.Compress(SplitToBlocks(in, 7), compress_out));
+
+  // Frame header is split across blocks too.
+  NoncontiguousBuffer decompress_out;
+  ASSERT_TRUE(compressor.Decompress(SplitToBlocks(FlattenSlow(compress_out), 3), decompress_out));
+  ASSERT_EQ(FlattenSlow(decompress_out), in);
+}
+
+TEST(ZstdCompressor, BadInput) {
+  ZstdCompressor compressor;
+  NoncontiguousBuffer out;
+  ASSERT_FALSE(compressor.Decompress(CreateBufferSlow("not a zstd frame"), out));
+  ASSERT_FALSE(compressor.Decompress(NoncontiguousBuffer(), out));
+
+  NoncontiguousBuffer compress_out;
+  ASSERT_TRUE(compressor.Compress(CreateBufferSlow(GenRandomStr(1024)), compress_out));
+  auto compressed = FlattenSlow(compress_out);
+  ASSERT_FALSE(compressor.Decompress(CreateBufferSlow(compressed.substr(0, compressed.size() - 1)), out));
+}
+
+TEST(ZstdCompressor, Dictionary) {
+  auto dict = TrainZstdDictionary();
+  ASSERT_FALSE(dict.empty());
+  uint32_t dict_id = zstd::AddDictionary(dict);
+  ASSERT_NE(dict_id, 0);
+  ASSERT_TRUE(zstd::SetDefaultDictionary(dict_id));
+
+  ZstdCompressor compressor;
+  std::mt19937 rng(1);
+  auto in = GenMessageLikeStr(rng);
+
+  NoncontiguousBuffer compress_out;
+  ASSERT_TRUE(compressor.Compress(CreateBufferSlow(in), compress_out));
+  auto compressed = FlattenSlow(compress_out);
+  ASSERT_EQ(ZSTD_getDictID_fromFrame(compressed.data(), compressed.size()), dict_id);
+
+  // Compressed by the same dictionary, and decompressed by the dictionary of the frame without default dictionary.
+  NoncontiguousBuffer compress_again;
+  ASSERT_TRUE(compressor.Compress(CreateBufferSlow(in), compress_again));
+  ASSERT_EQ(FlattenSlow(compress_again), compressed);
+  ASSERT_TRUE(zstd::SetDefaultDictionary(0));
+
+  NoncontiguousBuffer decompress_out;
+  ASSERT_TRUE(compressor.Decompress(compress_out, decompress_out));
+  ASSERT_EQ(FlattenSlow(decompress_out), in);
+
+  // Much smaller than without dictionary, as messages are small and similar.
+  NoncontiguousBuffer no_dict_out;
+  ASSERT_TRUE(compressor.Compress(CreateBufferSlow(in), no_dict_out));
+  ASSERT_LT(compress_out.ByteSize() * 3 / 2, no_dict_out.ByteSize());
+
+  // Fails if the dictionary is unknown.
+  zstd::ClearDictionaries();
+  ASSERT_FALSE(compressor.Decompress(compress_out, decompress_out));
+}
+
+TEST(ZstdCompressor, ScopedNoDictionary) {
+  uint32_t dict_id = zstd::AddDictionary(TrainZstdDictionary());
+  ASSERT_NE(dict_id, 0);
+  ASSERT_TRUE(zstd::SetDefaultDictionary(dict_id));
+
+  ZstdCompressor compressor;
+  std::mt19937 rng(1);
+  auto in = CreateBufferSlow(GenMessageLikeStr(rng));
+  NoncontiguousBuffer out;
+  {
+    zstd::ScopedNoDictionary no_dictionary;
+    ASSERT_EQ(zstd::GetCompressionDictionary(), 0);
+    {
+      // Nested scope doesn't enable it again.
+      zstd::ScopedNoDictionary not_enabled(false);
+      ASSERT_TRUE(compressor.Compress(in, out));
+      ASSERT_EQ(zstd::GetFrameDictionary(out), 0);
+    }
+    ASSERT_EQ(zstd::GetCompressionDictionary(), 0);
+  }
+  ASSERT_EQ(zstd::GetCompressionDictionary(), dict_id);
+  ASSERT_TRUE(compressor.Compress(in, out));
+  ASSERT_EQ(zstd::GetFrameDictionary(out), dict_id);
+
+  zstd::ClearDictionaries();
+}
+
+}  // namespace trpc::compressor::testing
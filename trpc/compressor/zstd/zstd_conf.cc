@@ -0,0 +1,32 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/compressor/zstd/zstd_conf.h"
+
+#include "trpc/util/log/logging.h"
+
+namespace trpc::compressor {
+
+void ZstdConfig::Display() const {
+  TRPC_LOG_DEBUG("--------------------------------");
+
+  TRPC_LOG_DEBUG("dictionaries:");
+  for (const auto& path : dictionaries) {
+    TRPC_LOG_DEBUG(path);
+  }
+  TRPC_LOG_DEBUG("dictionary_id:" << dictionary_id);
+
+  TRPC_LOG_DEBUG("--------------------------------");
+}
+
+}  // namespace trpc::compressor
@@ -0,0 +1,33 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace trpc::compressor {
+
+/// @brief Configuration of zstd compressor, which is under `plugins: compressor: zstd`.
+struct ZstdConfig {
+  /// Paths of dictionaries trained by `zstd --train`, all of them are used to decompress.
+  std::vector<std::string> dictionaries;
+
+  /// ID of the dictionary used to compress, it must be one of `dictionaries`. 0 means compressing without dictionary.
+  uint32_t dictionary_id{0};
+
+  void Display() const;
+};
+
+}  // namespace trpc::compressor
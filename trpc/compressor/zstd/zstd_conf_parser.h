@@ -0,0 +1,44 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include "yaml-cpp/yaml.h"
+
+#include "trpc/compressor/zstd/zstd_conf.h"
+
+namespace YAML {
+
+template <>
+struct convert<trpc::compressor::ZstdConfig> {
+  static YAML::Node encode(const trpc::compressor::ZstdConfig& conf) {
+    YAML::Node node;
+    node["dictionaries"] = conf.dictionaries;
+    node["dictionary_id"] = conf.dictionary_id;
+
+    return node;
+  }
+
+  static bool decode(const YAML::Node& node, trpc::compressor::ZstdConfig& conf) {
+    if (node["dictionaries"]) {
+      conf.dictionaries = node["dictionaries"].as<std::vector<std::string>>();
+    }
+
+    if (node["dictionary_id"]) {
+      conf.dictionary_id = node["dictionary_id"].as<uint32_t>();
+    }
+    return true;
+  }
+};
+
+}  // namespace YAML
@@ -0,0 +1,237 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/compressor/zstd/zstd_dictionary.h"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+#include <utility>
+
+#include "trpc/util/log/logging.h"
+
+namespace trpc::compressor::zstd {
+
+namespace {
+
+struct Dictionaries {
+  std::mutex mutex;
+  std::unordered_map<uint32_t, std::shared_ptr<const std::string>> contents;
+  std::atomic<uint32_t> default_id{0};
+  // Increased once dictionaries are removed, so threads drop the dictionaries they have digested.
+  std::atomic<uint64_t> version{0};
+};
+
+Dictionaries& GetDictionaries() {
+  static Dictionaries dictionaries;
+  return dictionaries;
+}
+
+std::shared_ptr<const std::string> FindContent(uint32_t id) {
+  auto& dictionaries = GetDictionaries();
+  std::scoped_lock lock(dictionaries.mutex);
+  auto it = dictionaries.contents.find(id);
+  return it != dictionaries.contents.end() ? it->second : nullptr;
+}
+
+// Returns 0 if it's not a valid ID.
+uint32_t ParseDictionaryId(std::string_view dict_id) {
+  uint32_t id = 0;
+  const char* end = dict_id.data() + dict_id.size();
+  auto [ptr, ec] = std::from_chars(dict_id.data(), end, id);
+  return ec == std::errc() && ptr == end ? id : 0;
+}
+
+// Max size of frame header, which is ZSTD_FRAMEHEADERSIZE_MAX of static linking only API.
+constexpr std::size_t kMaxFrameHeaderSize = 18;
+
+thread_local bool thread_dictionary_disabled = false;
+
+thread_local bool thread_dictionaries_destroyed = false;
+
+struct ThreadDictionaries {
+  ~ThreadDictionaries() {
+    Clear();
+    thread_dictionaries_destroyed = true;
+  }
+
+  void Clear() {
+    for (auto& [key, cdict] : cdicts) {
+      ZSTD_freeCDict(cdict);
+    }
+    cdicts.clear();
+    for (auto& [id, ddict] : ddicts) {
+      ZSTD_freeDDict(ddict);
+    }
+    ddicts.clear();
+  }
+
+  uint64_t version{0};
+  // Keyed by dictionary ID and compression level.
+  std::map<std::pair<uint32_t, int>, ZSTD_CDict*> cdicts;
+  std::unordered_map<uint32_t, ZSTD_DDict*> ddicts;
+};
+
+ThreadDictionaries* GetThreadDictionaries() {
+  // Compression may happen in destructors run after the thread local objects during thread exit.
+  if (thread_dictionaries_destroyed) {
+    return nullptr;
+  }
+  thread_local ThreadDictionaries dictionaries;
+  uint64_t version = GetDictionaries().version.load(std::memory_order_acquire);
+  if (dictionaries.version != version) {
+    dictionaries.Clear();
+    dictionaries.version = version;
+  }
+  return &dictionaries;
+}
+
+}  // namespace
+
+uint32_t AddDictionary(std::string content) {
+  uint32_t id = ZSTD_getDictID_fromDict(content.data(), content.size());
+  if (id == 0) {
+    TRPC_FMT_ERROR("Zstd dictionary must be trained by `zstd --train`, raw content dictionary is not supported");
+    return 0;
+  }
+
+  auto& dictionaries = GetDictionaries();
+  std::scoped_lock lock(dictionaries.mutex);
+  auto [it, inserted] = dictionaries.contents.try_emplace(id);
+  if (!inserted) {
+    if (*it->second == content) {
+      return id;
+    }
+    TRPC_FMT_ERROR("Zstd dictionary {} is registered by another content", id);
+    return 0;
+  }
+  it->second = std::make_shared<const std::string>(std::move(content));
+  return id;
+}
+
+uint32_t LoadDictionary(const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    TRPC_FMT_ERROR("Failed to open zstd dictionary {}", path);
+    return 0;
+  }
+  std::stringstream content;
+  content << file.rdbuf();
+  uint32_t id = AddDictionary(content.str());
+  if (id == 0) {
+    TRPC_FMT_ERROR("Failed to load zstd dictionary {}", path);
+  }
+  return id;
+}
+
+bool SetDefaultDictionary(uint32_t id) {
+  if (id != 0 && !HasDictionary(id)) {
+    TRPC_FMT_ERROR("Zstd dictionary {} is not registered", id);
+    return false;
+  }
+  GetDictionaries().default_id.store(id, std::memory_order_release);
+  return true;
+}
+
+uint32_t GetDefaultDictionary() { return GetDictionaries().default_id.load(std::memory_order_acquire); }
+
+bool HasDictionary(uint32_t id) { return FindContent(id) != nullptr; }
+
+bool CanPeerDecompress(std::string_view peer_dict_id) {
+  uint32_t id = GetDefaultDictionary();
+  return id == 0 || ParseDictionaryId(peer_dict_id) == id;
+}
+
+bool HasPeerDictionary(std::string_view peer_dict_id) {
+  uint32_t id = ParseDictionaryId(peer_dict_id);
+  return id != 0 && HasDictionary(id);
+}
+
+uint32_t GetCompressionDictionary() { return thread_dictionary_disabled ? 0 : GetDefaultDictionary(); }
+
+ScopedNoDictionary::ScopedNoDictionary(bool enable) : prev_disabled_(thread_dictionary_disabled) {
+  thread_dictionary_disabled = prev_disabled_ || enable;
+}
+
+ScopedNoDictionary::~ScopedNoDictionary() { thread_dictionary_disabled = prev_disabled_; }
+
+uint32_t GetFrameDictionary(const NoncontiguousBuffer& frame) {
+  // The frame header may be split into several blocks.
+  char header[kMaxFrameHeaderSize];
+  std::size_t header_size = std::min(kMaxFrameHeaderSize, frame.ByteSize());
+  FlattenToSlow(frame, header, header_size);
+  return ZSTD_getDictID_fromFrame(header, header_size);
+}
+
+bool InitDictionaries(const ZstdConfig& config) {
+  bool ok = true;
+  for (const auto& path : config.dictionaries) {
+    ok = LoadDictionary(path) != 0 && ok;
+  }
+  return SetDefaultDictionary(config.dictionary_id) && ok;
+}
+
+void ClearDictionaries() {
+  auto& dictionaries = GetDictionaries();
+  std::scoped_lock lock(dictionaries.mutex);
+  dictionaries.contents.clear();
+  dictionaries.default_id.store(0, std::memory_order_release);
+  dictionaries.version.fetch_add(1, std::memory_order_release);
+}
+
+const ZSTD_CDict* GetCDict(uint32_t id, int level) {
+  auto* dictionaries = GetThreadDictionaries();
+  if (!dictionaries) {
+    return nullptr;
+  }
+  auto key = std::make_pair(id, level);
+  if (auto it = dictionaries->cdicts.find(key); it != dictionaries->cdicts.end()) {
+    return it->second;
+  }
+  auto content = FindContent(id);
+  if (!content) {
+    return nullptr;
+  }
+  ZSTD_CDict* cdict = ZSTD_createCDict(content->data(), content->size(), level);
+  if (cdict) {
+    dictionaries->cdicts.emplace(key, cdict);
+  }
+  return cdict;
+}
+
+const ZSTD_DDict* GetDDict(uint32_t id) {
+  auto* dictionaries = GetThreadDictionaries();
+  if (!dictionaries) {
+    return nullptr;
+  }
+  if (auto it = dictionaries->ddicts.find(id); it != dictionaries->ddicts.end()) {
+    return it->second;
+  }
+  auto content = FindContent(id);
+  if (!content) {
+    return nullptr;
+  }
+  ZSTD_DDict* ddict = ZSTD_createDDict(content->data(), content->size());
+  if (ddict) {
+    dictionaries->ddicts.emplace(id, ddict);
+  }
+  return ddict;
+}
+
+}  // namespace trpc::compressor::zstd
@@ -0,0 +1,103 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "zstd.h"
+
+#include "trpc/compressor/zstd/zstd_conf.h"
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+
+namespace trpc::compressor::zstd {
+
+/// @brief Key of trans-info carrying the ID of the dictionary used by the caller, so the callee knows whether the
+///        caller can decompress the response compressed by its own dictionary.
+constexpr char kDictionaryIdKey[] = "trpc-zstd-dict-id";
+
+/// @brief Key of response trans-info set by the callee when it has the dictionary of `kDictionaryIdKey`, so the caller
+///        knows it can compress requests by that dictionary. Trans-info of request is echoed in response, so the
+///        callee confirms by another key.
+constexpr char kDictionaryAckKey[] = "trpc-zstd-dict-ack";
+
+/// @brief Registers a dictionary trained by `zstd --train`, frames compressed by it carry its ID in the frame header,
+///        and are decompressed by the dictionary of the same ID.
+/// @param content is the content of dictionary, raw content dictionary (without ID) is not supported.
+/// @return Returns the ID of dictionary, 0 if the content is not a trained dictionary or another dictionary has the
+///         same ID.
+uint32_t AddDictionary(std::string content);
+
+/// @brief Reads a dictionary from file and registers it, see `AddDictionary`.
+uint32_t LoadDictionary(const std::string& path);
+
+/// @brief Sets the dictionary used to compress, 0 means compressing without dictionary.
+/// @return Returns false if the dictionary is not registered.
+bool SetDefaultDictionary(uint32_t id);
+
+/// @brief Returns the ID of dictionary used to compress, 0 if none.
+uint32_t GetDefaultDictionary();
+
+/// @brief Returns whether the dictionary is registered.
+bool HasDictionary(uint32_t id);
+
+/// @brief Whether data compressed by the default dictionary can be decompressed by the peer.
+/// @param peer_dict_id is the value of trans-info `kDictionaryIdKey` sent by the peer, empty if not present.
+bool CanPeerDecompress(std::string_view peer_dict_id);
+
+/// @brief Whether the dictionary of the peer is registered, so data compressed by it can be decompressed.
+/// @param peer_dict_id is the value of trans-info `kDictionaryIdKey` sent by the peer.
+bool HasPeerDictionary(std::string_view peer_dict_id);
+
+/// @brief Returns the ID of dictionary used to compress by current thread, it's the default dictionary unless
+///        in the scope of `ScopedNoDictionary`.
+uint32_t GetCompressionDictionary();
+
+/// @brief Compressing by current thread doesn't use the default dictionary in its scope, e.g. the peer is not known to
+///        have the dictionary.
+class ScopedNoDictionary {
+ public:
+  explicit ScopedNoDictionary(bool enable = true);
+  ~ScopedNoDictionary();
+
+  ScopedNoDictionary(const ScopedNoDictionary&) = delete;
+  ScopedNoDictionary& operator=(const ScopedNoDictionary&) = delete;
+
+ private:
+  bool prev_disabled_;
+};
+
+/// @brief Returns the ID of dictionary in the header of the frame, 0 if it's compressed without dictionary.
+uint32_t GetFrameDictionary(const NoncontiguousBuffer& frame);
+
+/// @brief Registers dictionaries and sets the default dictionary by configuration.
+/// @return Returns false if any dictionary failed to load.
+bool InitDictionaries(const ZstdConfig& config);
+
+/// @brief Unregisters all dictionaries.
+void ClearDictionaries();
+
+/// @brief Returns the digested dictionary of current thread for compressing at `level`, digesting a dictionary costs
+///        much more than compressing a small message, so it is done once per thread.
+/// @return Returns nullptr if the dictionary is not registered.
+/// @private
+const ZSTD_CDict* GetCDict(uint32_t id, int level);
+
+/// @brief Returns the digested dictionary of current thread for decompressing.
+/// @return Returns nullptr if the dictionary is not registered.
+/// @private
+const ZSTD_DDict* GetDDict(uint32_t id);
+
+}  // namespace trpc::compressor::zstd
@@ -0,0 +1,106 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/compressor/zstd/zstd_dictionary.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "trpc/compressor/testing/zstd_testing.h"
+#include "trpc/compressor/zstd/zstd_conf_parser.h"
+
+namespace trpc::compressor::testing {
+
+class ZstdDictionaryTest : public ::testing::Test {
+ protected:
+  void SetUp() override { dict_ = TrainZstdDictionary(); }
+
+  void TearDown() override { zstd::ClearDictionaries(); }
+
+  std::string dict_;
+};
+
+TEST_F(ZstdDictionaryTest, AddDictionary) {
+  ASSERT_EQ(zstd::AddDictionary("raw content is not supported"), 0);
+
+  uint32_t dict_id = zstd::AddDictionary(dict_);
+  ASSERT_NE(dict_id, 0);
+  ASSERT_TRUE(zstd::HasDictionary(dict_id));
+  // Adding the same dictionary again is fine.
+  ASSERT_EQ(zstd::AddDictionary(dict_), dict_id);
+
+  // The same ID with another content is rejected.
+  auto other = dict_;
+  other.back() ^= 1;
+  ASSERT_EQ(zstd::AddDictionary(other), 0);
+
+  ASSERT_NE(zstd::GetCDict(dict_id, 3), nullptr);
+  ASSERT_EQ(zstd::GetCDict(dict_id, 3), zstd::GetCDict(dict_id, 3));
+  ASSERT_NE(zstd::GetDDict(dict_id), nullptr);
+  ASSERT_EQ(zstd::GetDDict(dict_id + 1), nullptr);
+
+  zstd::ClearDictionaries();
+  ASSERT_FALSE(zstd::HasDictionary(dict_id));
+  ASSERT_EQ(zstd::GetCDict(dict_id, 3), nullptr);
+  ASSERT_EQ(zstd::GetDDict(dict_id), nullptr);
+}
+
+TEST_F(ZstdDictionaryTest, DefaultDictionary) {
+  ASSERT_EQ(zstd::GetDefaultDictionary(), 0);
+  ASSERT_TRUE(zstd::CanPeerDecompress(""));
+
+  ASSERT_FALSE(zstd::SetDefaultDictionary(1));
+  uint32_t dict_id = zstd::AddDictionary(dict_);
+  ASSERT_TRUE(zstd::SetDefaultDictionary(dict_id));
+  ASSERT_EQ(zstd::GetDefaultDictionary(), dict_id);
+
+  ASSERT_TRUE(zstd::CanPeerDecompress(std::to_string(dict_id)));
+  ASSERT_FALSE(zstd::CanPeerDecompress(""));
+  ASSERT_FALSE(zstd::CanPeerDecompress(std::to_string(dict_id + 1)));
+  ASSERT_FALSE(zstd::CanPeerDecompress(std::to_string(dict_id) + "x"));
+}
+
+TEST_F(ZstdDictionaryTest, HasPeerDictionary) {
+  uint32_t dict_id = zstd::AddDictionary(dict_);
+  // Registered is enough, it's not necessarily the default one.
+  ASSERT_TRUE(zstd::HasPeerDictionary(std::to_string(dict_id)));
+  ASSERT_FALSE(zstd::HasPeerDictionary(""));
+  ASSERT_FALSE(zstd::HasPeerDictionary("0"));
+  ASSERT_FALSE(zstd::HasPeerDictionary(std::to_string(dict_id + 1)));
+}
+
+TEST_F(ZstdDictionaryTest, InitDictionaries) {
+  std::string path = "zstd_dictionary_test.dict";
+  std::ofstream(path, std::ios::binary) << dict_;
+
+  auto config = YAML::Load("dictionaries: [" + path + "]\ndictionary_id: 1").as<ZstdConfig>();
+  ASSERT_EQ(config.dictionaries.size(), 1);
+  ASSERT_FALSE(zstd::InitDictionaries(config));
+
+  uint32_t dict_id = zstd::LoadDictionary(path);
+  ASSERT_NE(dict_id, 0);
+  config.dictionary_id = dict_id;
+  config.Display();
+  ASSERT_TRUE(zstd::InitDictionaries(config));
+  ASSERT_EQ(zstd::GetDefaultDictionary(), dict_id);
+
+  config.dictionaries.push_back("not_exist.dict");
+  ASSERT_FALSE(zstd::InitDictionaries(config));
+
+  std::remove(path.c_str());
+}
+
+}  // namespace trpc::compressor::testing
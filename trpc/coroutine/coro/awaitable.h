@@ -0,0 +1,151 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#if defined(__cpp_impl_coroutine)
+
+#include <chrono>
+#include <coroutine>
+#include <utility>
+
+#include "trpc/common/status.h"
+#include "trpc/coroutine/coro/task.h"
+#include "trpc/coroutine/fiber.h"
+#include "trpc/coroutine/fiber_timer.h"
+#include "trpc/future/executor.h"
+#include "trpc/future/future.h"
+#include "trpc/runtime/iomodel/reactor/reactor.h"
+#include "trpc/util/chrono/chrono.h"
+
+namespace trpc::coro {
+
+namespace detail {
+
+/// @brief Remember where a coroutine is suspended, and resume it in the same kind of context.
+///        In fiber runtime the coroutine is resumed in a fiber, in merge runtime it is resumed by the reactor of the
+///        suspending thread (as `ReactorExecutor` does), otherwise it is resumed by whoever wakes it up.
+/// @private
+class ResumeContext {
+ public:
+  static ResumeContext Capture() noexcept {
+    ResumeContext context;
+    if (IsRunningInFiberWorker()) {
+      context.fiber_ = true;
+    } else {
+      context.reactor_ = Reactor::GetCurrentTlsReactor();
+    }
+    return context;
+  }
+
+  void Resume(std::coroutine_handle<> handle) const {
+    if (fiber_) {
+      // A fiber timer or future continuation runs in a fiber already, avoid starting another one for it.
+      if (IsRunningInFiberWorker() || !StartFiberDetached([handle] { handle.resume(); })) {
+        handle.resume();
+      }
+    } else if (reactor_ && reactor_ != Reactor::GetCurrentTlsReactor()) {
+      reactor_->SubmitTask([handle] { handle.resume(); });
+    } else {
+      handle.resume();
+    }
+  }
+
+ private:
+  Reactor* reactor_ = nullptr;
+  bool fiber_ = false;
+};
+
+}  // namespace detail
+
+/// @brief Awaiter of future, `co_await` it yields the ready or failed future, the same as `fiber::BlockingGet`.
+/// @private
+template <typename... T>
+class FutureAwaiter {
+ public:
+  explicit FutureAwaiter(Future<T...>&& future) noexcept : future_(std::move(future)) {}
+
+  bool await_ready() const noexcept { return future_.IsReady() || future_.IsFailed(); }
+
+  void await_suspend(std::coroutine_handle<> handle) {
+    auto context = detail::ResumeContext::Capture();
+    // The continuation may run (and resume the coroutine) before `Then` returns, so `this` is not touched after it.
+    std::move(future_).Then(&kDefaultInlineExecutor, [this, handle, context](Future<T...>&& future) {
+      future_ = std::move(future);
+      context.Resume(handle);
+    });
+  }
+
+  Future<T...> await_resume() noexcept { return std::move(future_); }
+
+ private:
+  Future<T...> future_;
+};
+
+/// @brief Awaiter of fiber timer.
+/// @private
+class SleepAwaiter {
+ public:
+  explicit SleepAwaiter(std::chrono::steady_clock::time_point expires_at) noexcept : expires_at_(expires_at) {}
+
+  bool await_ready() const noexcept { return expires_at_ <= ReadSteadyClock(); }
+
+  void await_suspend(std::coroutine_handle<> handle) {
+    // Timer callback is run in a new fiber, resume the coroutine there directly.
+    SetFiberDetachedTimer(expires_at_, [handle] { handle.resume(); });
+  }
+
+  void await_resume() const noexcept {}
+
+ private:
+  std::chrono::steady_clock::time_point expires_at_;
+};
+
+/// @brief Suspend current coroutine until `expires_at` without blocking the fiber worker.
+/// @note  It only uses in fiber runtime, in merge runtime `co_await` the future of `AsyncTimer::After` instead.
+inline SleepAwaiter SleepUntil(std::chrono::steady_clock::time_point expires_at) { return SleepAwaiter(expires_at); }
+
+/// @brief Suspend current coroutine for `expires_in`, same as `SleepUntil`.
+template <typename Rep, typename Period>
+SleepAwaiter SleepFor(std::chrono::duration<Rep, Period> expires_in) {
+  return SleepAwaiter(ReadSteadyClock() + expires_in);
+}
+
+/// @brief Await the future of an unary rpc, store the response and return the status like the synchronous call.
+/// @note  Used by the `Co` methods of generated service proxy.
+template <typename ResponseMessage>
+Task<Status> AwaitUnaryResponse(Future<ResponseMessage> future, ResponseMessage* response) {
+  auto done = co_await std::move(future);
+  if (done.IsFailed()) {
+    auto ex = done.GetException();
+    co_return Status(ex.GetExceptionCode(), 0, ex.what());
+  }
+  *response = done.GetValue0();
+  co_return Status();
+}
+
+}  // namespace trpc::coro
+
+namespace trpc {
+
+/// @brief Make future awaitable, e.g. `auto fut = co_await proxy->AsyncSayHello(ctx, req);`, stream reads of
+///        `stream::AsyncReader` are awaited in the same way.
+/// @note  The future returned by `co_await` is always ready or failed.
+template <typename... T>
+coro::FutureAwaiter<T...> operator co_await(Future<T...>&& future) noexcept {
+  return coro::FutureAwaiter<T...>(std::move(future));
+}
+
+}  // namespace trpc
+
+#endif  // defined(__cpp_impl_coroutine)
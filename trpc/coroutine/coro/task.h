@@ -0,0 +1,338 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+// C++20 coroutines are optional, everything below is only visible when compiled with `-std=c++20` or later.
+#if defined(__cpp_impl_coroutine)
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "trpc/future/exception.h"
+#include "trpc/future/future.h"
+#include "trpc/util/check.h"
+#include "trpc/util/object_pool/object_pool.h"
+
+namespace trpc::coro {
+
+namespace detail {
+
+/// @brief Raw memory of coroutine frame. Frames of any coroutine are allocated from the object pool of the smallest
+///        storage which fits it, the same way as FutureImpl.
+/// @private
+template <std::size_t kSize>
+struct alignas(std::max_align_t) FrameStorage {
+  // User-provided to avoid zero filling when allocated.
+  FrameStorage() {}
+
+  unsigned char bytes[kSize];
+};
+
+}  // namespace detail
+
+}  // namespace trpc::coro
+
+namespace trpc {
+
+/// @private
+template <std::size_t kSize>
+struct object_pool::ObjectPoolTraits<coro::detail::FrameStorage<kSize>> {
+#if defined(TRPC_DISABLED_OBJECTPOOL)
+  static constexpr auto kType = ObjectPoolType::kDisabled;
+#elif defined(TRPC_SHARED_NOTHING_OBJECTPOOL)
+  static constexpr auto kType = ObjectPoolType::kSharedNothing;
+#else
+  static constexpr auto kType = ObjectPoolType::kGlobal;
+#endif
+};
+
+}  // namespace trpc
+
+namespace trpc::coro {
+
+namespace detail {
+
+/// @private
+template <std::size_t kSize, typename F>
+bool DispatchFrameSize(std::size_t size, F&& func) {
+  if (size <= kSize) {
+    func(static_cast<FrameStorage<kSize>*>(nullptr));
+    return true;
+  }
+  return false;
+}
+
+/// @brief Call func with a null pointer of the smallest FrameStorage holding `size` bytes.
+/// @return false if `size` is too large for any storage.
+/// @private
+template <typename F>
+bool VisitFrameStorage(std::size_t size, F&& func) {
+  return DispatchFrameSize<256>(size, func) || DispatchFrameSize<512>(size, func) ||
+         DispatchFrameSize<1024>(size, func) || DispatchFrameSize<2048>(size, func);
+}
+
+/// @brief Allocate coroutine frame from object pool, fall back to heap if it is too large.
+/// @private
+inline void* AllocateFrame(std::size_t size) {
+  void* ptr = nullptr;
+  bool pooled = VisitFrameStorage(size, [&ptr](auto* tag) {
+    using Storage = std::remove_pointer_t<decltype(tag)>;
+    ptr = object_pool::New<Storage>();
+  });
+  return pooled ? ptr : ::operator new(size);
+}
+
+/// @private
+inline void DeallocateFrame(void* ptr, std::size_t size) {
+  bool pooled = VisitFrameStorage(size, [ptr](auto* tag) {
+    using Storage = std::remove_pointer_t<decltype(tag)>;
+    object_pool::Delete<Storage>(static_cast<Storage*>(ptr));
+  });
+  if (!pooled) {
+    ::operator delete(ptr);
+  }
+}
+
+/// @brief Common part of the promise of all tasks.
+/// @private
+class PromiseBase {
+ public:
+  /// @brief Resume the awaiting coroutine (if any) when the task finishes.
+  struct FinalAwaiter {
+    bool await_ready() const noexcept { return false; }
+
+    template <typename Promise>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+      // Symmetric transfer, so a long chain of tasks finishing synchronously won't overflow the stack.
+      auto continuation = handle.promise().continuation_;
+      return continuation ? continuation : std::noop_coroutine();
+    }
+
+    void await_resume() const noexcept {}
+  };
+
+  static void* operator new(std::size_t size) { return AllocateFrame(size); }
+
+  static void operator delete(void* ptr, std::size_t size) { DeallocateFrame(ptr, size); }
+
+  std::suspend_always initial_suspend() const noexcept { return {}; }
+
+  FinalAwaiter final_suspend() const noexcept { return {}; }
+
+  void unhandled_exception() noexcept { exception_ = std::current_exception(); }
+
+  void SetContinuation(std::coroutine_handle<> continuation) noexcept { continuation_ = continuation; }
+
+ protected:
+  void RethrowIfFailed() const {
+    if (exception_) {
+      std::rethrow_exception(exception_);
+    }
+  }
+
+ private:
+  std::coroutine_handle<> continuation_;
+  std::exception_ptr exception_;
+};
+
+}  // namespace detail
+
+template <typename T = void>
+class Task;
+
+namespace detail {
+
+/// @private
+template <typename T>
+class TaskPromise : public PromiseBase {
+ public:
+  Task<T> get_return_object() noexcept;
+
+  template <typename U = T, typename = std::enable_if_t<std::is_convertible_v<U&&, T>>>
+  void return_value(U&& value) {
+    value_.emplace(std::forward<U>(value));
+  }
+
+  T Result() {
+    RethrowIfFailed();
+    return std::move(*value_);
+  }
+
+ private:
+  std::optional<T> value_;
+};
+
+/// @private
+template <>
+class TaskPromise<void> : public PromiseBase {
+ public:
+  Task<void> get_return_object() noexcept;
+
+  void return_void() noexcept {}
+
+  void Result() { RethrowIfFailed(); }
+};
+
+}  // namespace detail
+
+/// @brief Lazily started coroutine returning `T`, it runs when it is `co_await`ed and resumes the awaiting coroutine
+///        once finished. An exception escaping from the coroutine is rethrown to the awaiting coroutine.
+/// @note  Frames are allocated from object pool, so creating a task normally doesn't hit the heap allocator.
+///        Use `ToFuture` to start a task from non-coroutine code.
+///        Take parameters by value, a reference parameter may dangle once the coroutine is suspended.
+/// @example
+///   Task<int> Add(Future<int> a, int b) {
+///     auto fut = co_await std::move(a);
+///     co_return fut.GetValue0() + b;
+///   }
+template <typename T>
+class [[nodiscard]] Task {
+ public:
+  using promise_type = detail::TaskPromise<T>;
+  using ValueType = T;
+
+  /// @private
+  class Awaiter {
+   public:
+    explicit Awaiter(std::coroutine_handle<promise_type> handle) noexcept : handle_(handle) {}
+
+    bool await_ready() const noexcept { return handle_.done(); }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+      handle_.promise().SetContinuation(awaiting);
+      return handle_;
+    }
+
+    T await_resume() { return handle_.promise().Result(); }
+
+   private:
+    std::coroutine_handle<promise_type> handle_;
+  };
+
+  Task() noexcept = default;
+
+  explicit Task(std::coroutine_handle<promise_type> handle) noexcept : handle_(handle) {}
+
+  Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+
+  Task& operator=(Task&& other) noexcept {
+    if (this != &other) {
+      Reset();
+      handle_ = std::exchange(other.handle_, nullptr);
+    }
+    return *this;
+  }
+
+  Task(const Task&) = delete;
+  Task& operator=(const Task&) = delete;
+
+  ~Task() { Reset(); }
+
+  /// @brief Whether the task holds a coroutine.
+  bool Valid() const noexcept { return static_cast<bool>(handle_); }
+
+  /// @brief Whether the coroutine has run to the end.
+  bool IsDone() const noexcept { return handle_ && handle_.done(); }
+
+  /// @note The task must hold a coroutine, awaiting a default constructed or moved-from task aborts.
+  Awaiter operator co_await() && noexcept {
+    TRPC_CHECK(handle_, "Awaiting a task without coroutine.");
+    return Awaiter(handle_);
+  }
+
+ private:
+  void Reset() noexcept {
+    if (handle_) {
+      handle_.destroy();
+      handle_ = nullptr;
+    }
+  }
+
+ private:
+  std::coroutine_handle<promise_type> handle_;
+};
+
+namespace detail {
+
+template <typename T>
+Task<T> TaskPromise<T>::get_return_object() noexcept {
+  return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+  return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+/// @brief Eagerly started coroutine which destroys itself when finished, used as the root of a task tree.
+/// @private
+struct DetachedTask {
+  struct promise_type {
+    static void* operator new(std::size_t size) { return AllocateFrame(size); }
+
+    static void operator delete(void* ptr, std::size_t size) { DeallocateFrame(ptr, size); }
+
+    DetachedTask get_return_object() const noexcept { return {}; }
+
+    std::suspend_never initial_suspend() const noexcept { return {}; }
+
+    std::suspend_never final_suspend() const noexcept { return {}; }
+
+    void return_void() const noexcept {}
+
+    void unhandled_exception() const noexcept { std::terminate(); }
+  };
+};
+
+/// @private
+template <typename T, typename PromiseType>
+DetachedTask RunTask(Task<T> task, PromiseType promise) {
+  try {
+    if constexpr (std::is_void_v<T>) {
+      co_await std::move(task);
+      promise.SetValue();
+    } else {
+      promise.SetValue(co_await std::move(task));
+    }
+  } catch (Exception& ex) {
+    promise.SetException(std::move(ex));
+  } catch (const std::exception& ex) {
+    promise.SetException(CommonException(ex.what()));
+  } catch (...) {
+    promise.SetException(CommonException("Unknown exception thrown from coroutine task"));
+  }
+}
+
+}  // namespace detail
+
+/// @brief Start task immediately in current thread, and get its result by future.
+/// @note  Exceptions thrown by the task are converted into the exception of the future.
+///        Besides exceptions derived from std::exception, the task may throw `trpc::Exception` to fail the future
+///        with a specific exception.
+template <typename T>
+auto ToFuture(Task<T>&& task) {
+  using PromiseType = std::conditional_t<std::is_void_v<T>, Promise<>, Promise<T>>;
+  PromiseType promise;
+  auto fut = promise.GetFuture();
+  detail::RunTask(std::move(task), std::move(promise));
+  return fut;
+}
+
+}  // namespace trpc::coro
+
+#endif  // defined(__cpp_impl_coroutine)
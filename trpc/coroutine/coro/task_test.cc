@@ -0,0 +1,151 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/coroutine/coro/task.h"
+
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "trpc/coroutine/coro/awaitable.h"
+#include "trpc/coroutine/fiber.h"
+#include "trpc/coroutine/future.h"
+#include "trpc/coroutine/testing/fiber_runtime.h"
+#include "trpc/util/chrono/chrono.h"
+
+namespace trpc::coro::testing {
+
+namespace {
+
+Task<int> Add(Future<int> fut, int n) {
+  auto done = co_await std::move(fut);
+  co_return done.GetValue0() + n;
+}
+
+Task<int> Twice(Future<int> fut) {
+  int val = co_await Add(std::move(fut), 1);
+  co_return val * 2;
+}
+
+Task<> Throw() {
+  throw std::runtime_error("oops");
+  co_return;
+}
+
+Task<int> Count(int depth) {
+  if (depth == 0) {
+    co_return 0;
+  }
+  co_return co_await Count(depth - 1) + 1;
+}
+
+}  // namespace
+
+TEST(TaskTest, AwaitReadyFuture) {
+  auto fut = ToFuture(Twice(MakeReadyFuture<int>(1)));
+  ASSERT_TRUE(fut.IsReady());
+  ASSERT_EQ(fut.GetValue0(), 4);
+}
+
+TEST(TaskTest, AwaitPendingFuture) {
+  Promise<int> pr;
+  auto fut = ToFuture(Twice(pr.GetFuture()));
+  ASSERT_FALSE(fut.IsReady());
+
+  // Resumed by the thread setting the promise, as there is no reactor or fiber.
+  std::thread t([&pr] { pr.SetValue(2); });
+  t.join();
+  ASSERT_TRUE(fut.IsReady());
+  ASSERT_EQ(fut.GetValue0(), 6);
+}
+
+TEST(TaskTest, AwaitFailedFuture) {
+  auto fut = ToFuture([]() -> Task<bool> {
+    auto done = co_await MakeExceptionFuture<int>(CommonException("failed", -1));
+    co_return done.IsFailed();
+  }());
+  ASSERT_TRUE(fut.GetValue0());
+}
+
+TEST(TaskTest, ExceptionToFailedFuture) {
+  auto fut = ToFuture(Throw());
+  ASSERT_TRUE(fut.IsFailed());
+  ASSERT_EQ(std::string(fut.GetException().what()), "oops");
+}
+
+TEST(TaskTest, LazyStart) {
+  bool started = false;
+  // Captures of lambda are gone once the task is created, pass by parameter instead.
+  auto task = [](bool* started) -> Task<> {
+    *started = true;
+    co_return;
+  }(&started);
+  ASSERT_FALSE(started);
+  ASSERT_FALSE(task.IsDone());
+  ToFuture(std::move(task));
+  ASSERT_TRUE(started);
+}
+
+TEST(TaskTest, AwaitEmptyTask) {
+  Task<int> task = Count(1);
+  Task<int> moved = std::move(task);
+  ASSERT_FALSE(task.Valid());
+  ASSERT_DEATH(ToFuture(std::move(task)), "Awaiting a task without coroutine");
+  ASSERT_EQ(ToFuture(std::move(moved)).GetValue0(), 1);
+}
+
+// Nested tasks finishing synchronously are resumed by symmetric transfer, so they won't overflow the stack.
+TEST(TaskTest, DeepRecursion) {
+  auto fut = ToFuture(Count(10000));
+  ASSERT_EQ(fut.GetValue0(), 10000);
+}
+
+TEST(TaskTest, AwaitUnaryResponse) {
+  std::string rsp;
+  auto status = ToFuture(AwaitUnaryResponse(MakeReadyFuture<std::string>("hello"), &rsp)).GetValue0();
+  ASSERT_TRUE(status.OK());
+  ASSERT_EQ(rsp, "hello");
+
+  status = ToFuture(AwaitUnaryResponse(MakeExceptionFuture<std::string>(CommonException("timeout", 101)), &rsp))
+               .GetValue0();
+  ASSERT_FALSE(status.OK());
+  ASSERT_EQ(status.GetFrameworkRetCode(), 101);
+}
+
+TEST(TaskTest, RunInFiber) {
+  trpc::testing::RunAsFiber([] {
+    Promise<int> pr;
+    auto fut = ToFuture([](Future<int> fut) -> Task<int> {
+      auto start = ReadSteadyClock();
+      co_await SleepFor(std::chrono::milliseconds(10));
+      EXPECT_GE(ReadSteadyClock() - start, std::chrono::milliseconds(10));
+
+      auto done = co_await std::move(fut);
+      // Still resumed in fiber, though the promise is set by a pthread.
+      EXPECT_TRUE(IsRunningInFiberWorker());
+      co_return done.GetValue0();
+    }(pr.GetFuture()));
+
+    std::thread t([&pr] {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      pr.SetValue(1);
+    });
+    ASSERT_EQ(fiber::BlockingGet(std::move(fut)).GetValue0(), 1);
+    t.join();
+  });
+}
+
+}  // namespace trpc::coro::testing
@@ -17,6 +17,7 @@
 #include <utility>
 #include <vector>
 
+#include "trpc/runtime/threadmodel/fiber/detail/stack_allocator_impl.h"
 #include "trpc/util/chrono/chrono.h"
 #include "trpc/util/function.h"
 #include "trpc/util/object_pool/object_pool_ptr.h"
@@ -40,6 +41,9 @@ enum class Launch {
   Dispatch
 };
 
+/// @brief Size class of fiber stack, see `Fiber::Attributes::stack_class`.
+using StackClass = detail::StackClass;
+
 constexpr std::string_view kCreateFiberEntityError =
     "Create Fiber Entity fail,maybe too many. Check `/proc/[pid]/maps` to "
     "see if there are too many memory regions. There's a limit at around 64K "
@@ -81,6 +85,13 @@ class Fiber {
     /// @brief If Set, it is a reactor fiber
     /// @note  Only used inside the framework
     bool is_fiber_reactor = false;
+
+    /// @brief Size class of the fiber stack. Use `kSmall` for the large number of simple (e.g. parked) fibers and
+    ///        `kLarge` for deep call chains, sampled usages in admin (`/cmds/fiber/stack`) help to choose.
+    fiber::StackClass stack_class = fiber::StackClass::kDefault;
+
+    /// @brief Name of the entry function, which groups the sampled stack usages. Must be a static string.
+    const char* name = nullptr;
   };
 
   /// @brief Create an empty (invalid) fiber.
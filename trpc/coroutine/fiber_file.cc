@@ -0,0 +1,206 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#include "trpc/coroutine/fiber_file.h"
+
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <utility>
+#include <vector>
+
+#ifdef TRPC_BUILD_INCLUDE_ASYNC_IO
+#include "trpc/common/future/future.h"
+#include "trpc/coroutine/fiber.h"
+#include "trpc/coroutine/future.h"
+#include "trpc/runtime/fiber_runtime.h"
+#include "trpc/runtime/iomodel/async_io/async_io.h"
+#include "trpc/runtime/iomodel/reactor/fiber/fiber_reactor.h"
+#endif  // ifdef TRPC_BUILD_INCLUDE_ASYNC_IO
+
+namespace trpc {
+
+namespace {
+
+enum class FileOp { kRead, kWrite, kFsync };
+
+#ifdef TRPC_BUILD_INCLUDE_ASYNC_IO
+// Submit the operation to the io_uring of fiber reactor, and wait for the completion without blocking the worker.
+// Returns false if async io is unavailable, then the caller does it synchronously.
+bool RunFileOpAsync(FileOp op, int fd, const iovec* iov, int iovcnt, off_t offset, int32_t* result) {
+  if (!IsRunningInFiberWorker()) {
+    return false;
+  }
+  Reactor* reactor = fiber::GetAsyncIOReactor(fiber::GetCurrentSchedulingGroupIndex(), fd);
+  if (reactor == nullptr) {
+    return false;
+  }
+
+  Promise<int32_t> pr;
+  auto fut = pr.GetFuture();
+  // AsyncIO is not thread-safe, it's only touched by tasks running in its reactor.
+  bool submitted = reactor->SubmitTask([reactor, op, fd, iov, iovcnt, offset, pr = std::move(pr)]() mutable {
+    AsyncIO* async_io = reactor->GetAsyncIO();
+    Future<int32_t> done;
+    if (op == FileOp::kRead) {
+      done = async_io->AsyncReadv(fd, iov, iovcnt, offset);
+    } else if (op == FileOp::kWrite) {
+      done = async_io->AsyncWritev(fd, iov, iovcnt, offset);
+    } else {
+      done = async_io->AsyncFSync(fd);
+    }
+    std::move(done).Then([pr = std::move(pr)](Future<int32_t>&& fut) mutable {
+      if (fut.IsFailed()) {
+        pr.SetException(fut.GetException());
+      } else {
+        pr.SetValue(fut.GetValue0());
+      }
+      return MakeReadyFuture<>();
+    });
+  });
+  if (!submitted) {
+    return false;
+  }
+
+  auto done = fiber::BlockingGet(std::move(fut));
+  if (done.IsFailed()) {
+    // The operation was not submitted as the io_uring is busy (or broken), retry it synchronously.
+    return false;
+  }
+  *result = done.GetValue0();
+  return true;
+}
+#endif  // ifdef TRPC_BUILD_INCLUDE_ASYNC_IO
+
+// Returns the result of the operation, or -errno on failure, the same as io_uring does.
+int32_t RunFileOp(FileOp op, int fd, const iovec* iov, int iovcnt, off_t offset) {
+#ifdef TRPC_BUILD_INCLUDE_ASYNC_IO
+  int32_t result = 0;
+  if (RunFileOpAsync(op, fd, iov, iovcnt, offset, &result)) {
+    return result;
+  }
+#endif  // ifdef TRPC_BUILD_INCLUDE_ASYNC_IO
+
+  ssize_t ret = 0;
+  do {
+    if (op == FileOp::kRead) {
+      ret = ::preadv(fd, iov, iovcnt, offset);
+    } else if (op == FileOp::kWrite) {
+      ret = ::pwritev(fd, iov, iovcnt, offset);
+    } else {
+      ret = ::fsync(fd);
+    }
+  } while (ret < 0 && errno == EINTR);
+  return ret < 0 ? -errno : static_cast<int32_t>(ret);
+}
+
+// Read or write until all of `iov` is transferred, or end of file is reached.
+ssize_t TransferAll(FileOp op, int fd, std::vector<iovec> iov, off_t offset) {
+  ssize_t total = 0;
+  std::size_t index = 0;
+  while (index < iov.size()) {
+    int iovcnt = static_cast<int>(std::min<std::size_t>(iov.size() - index, IOV_MAX));
+    int32_t ret = RunFileOp(op, fd, iov.data() + index, iovcnt, offset + total);
+    if (ret < 0) {
+      errno = -ret;
+      return -1;
+    }
+    if (ret == 0) {
+      break;
+    }
+    total += ret;
+
+    // Skip the bytes transferred, the first iovec left may be partially done.
+    std::size_t done = ret;
+    while (done > 0) {
+      if (done >= iov[index].iov_len) {
+        done -= iov[index].iov_len;
+        ++index;
+      } else {
+        iov[index].iov_base = static_cast<char*>(iov[index].iov_base) + done;
+        iov[index].iov_len -= done;
+        done = 0;
+      }
+    }
+  }
+  return total;
+}
+
+}  // namespace
+
+FiberFile::FiberFile(FiberFile&& other) noexcept : fd_(std::exchange(other.fd_, -1)) {}
+
+FiberFile& FiberFile::operator=(FiberFile&& other) noexcept {
+  if (this != &other) {
+    Close();
+    fd_ = std::exchange(other.fd_, -1);
+  }
+  return *this;
+}
+
+bool FiberFile::Open(const std::string& path, int flags, mode_t mode) {
+  Close();
+  fd_ = ::open(path.c_str(), flags | O_CLOEXEC, mode);
+  return fd_ >= 0;
+}
+
+void FiberFile::Close() {
+  if (fd_ >= 0) {
+    ::close(fd_);
+    fd_ = -1;
+  }
+}
+
+ssize_t FiberFile::ReadAt(std::size_t size, off_t offset, NoncontiguousBuffer* buffer) {
+  // Space of all blocks is reserved before reading, blocks are filled in order even if a read returns short.
+  NoncontiguousBufferBuilder builder;
+  std::vector<iovec> iov;
+  for (std::size_t reserved = 0; reserved < size;) {
+    std::size_t len = std::min(builder.SizeAvailable(), size - reserved);
+    iov.push_back(iovec{builder.data(), len});
+    builder.MarkWritten(len);
+    reserved += len;
+  }
+
+  ssize_t ret = TransferAll(FileOp::kRead, fd_, std::move(iov), offset);
+  if (ret > 0) {
+    auto content = builder.DestructiveGet();
+    buffer->Append(content.Cut(ret));
+  }
+  return ret;
+}
+
+ssize_t FiberFile::WriteAt(const NoncontiguousBuffer& buffer, off_t offset) {
+  std::vector<iovec> iov;
+  iov.reserve(buffer.size());
+  for (auto&& block : buffer) {
+    iov.push_back(iovec{const_cast<char*>(block.data()), block.size()});
+  }
+  return TransferAll(FileOp::kWrite, fd_, std::move(iov), offset);
+}
+
+int FiberFile::Fsync() {
+  int32_t ret = RunFileOp(FileOp::kFsync, fd_, nullptr, 0, 0);
+  if (ret < 0) {
+    errno = -ret;
+    return -1;
+  }
+  return 0;
+}
+
+}  // namespace trpc
@@ -0,0 +1,81 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#pragma once
+
+#include <sys/types.h>
+
+#include <cstddef>
+#include <string>
+
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+
+namespace trpc {
+
+/// @brief File whose reads and writes block the calling fiber only, instead of the fiber worker thread.
+///        In fiber runtime, operations are submitted to the io_uring of the fiber reactor in the same scheduling
+///        group, and the fiber is woken up by the completion. It falls back to blocking `preadv` / `pwritev` /
+///        `fsync` if async io is not enabled (see `enable_async_io` of fiber threadmodel), the calling thread is
+///        not a fiber worker, or the io_uring is busy.
+/// @note  Like other file descriptors, a FiberFile is not meant to be used by multiple fibers at the same offset
+///        concurrently. Errors are reported as the corresponding syscall does: -1 is returned and `errno` is set.
+/// @example
+///   FiberFile file;
+///   if (file.Open("data.bin", O_RDONLY)) {
+///     NoncontiguousBuffer content;
+///     ssize_t n = file.ReadAt(4096, 0, &content);
+///   }
+class FiberFile {
+ public:
+  FiberFile() = default;
+
+  /// @brief Take ownership of an opened file descriptor.
+  explicit FiberFile(int fd) : fd_(fd) {}
+
+  ~FiberFile() { Close(); }
+
+  FiberFile(FiberFile&& other) noexcept;
+  FiberFile& operator=(FiberFile&& other) noexcept;
+
+  FiberFile(const FiberFile&) = delete;
+  FiberFile& operator=(const FiberFile&) = delete;
+
+  /// @brief Open the file at `path`, the same as `open(2)`. A file opened before is closed first.
+  bool Open(const std::string& path, int flags, mode_t mode = 0644);
+
+  /// @brief Close the file, it does nothing if the file is not opened.
+  void Close();
+
+  bool IsOpen() const { return fd_ >= 0; }
+
+  int GetFd() const { return fd_; }
+
+  /// @brief Read at most `size` bytes starting from `offset`, and append them to `buffer`.
+  ///        It keeps reading until `size` bytes are read or end of file is reached.
+  /// @return Number of bytes read, or -1 on failure.
+  ssize_t ReadAt(std::size_t size, off_t offset, NoncontiguousBuffer* buffer);
+
+  /// @brief Write the whole `buffer` starting from `offset`, blocks of buffer are written without copying.
+  /// @return Number of bytes written, or -1 on failure.
+  ssize_t WriteAt(const NoncontiguousBuffer& buffer, off_t offset);
+
+  /// @brief Flush data and metadata of the file to disk, the same as `fsync(2)`.
+  /// @return 0 on success, or -1 on failure.
+  int Fsync();
+
+ private:
+  int fd_{-1};
+};
+
+}  // namespace trpc
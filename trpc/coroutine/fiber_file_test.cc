@@ -0,0 +1,116 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#include "trpc/coroutine/fiber_file.h"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "trpc/coroutine/fiber.h"
+#include "trpc/coroutine/testing/fiber_runtime.h"
+#include "trpc/runtime/iomodel/reactor/fiber/fiber_reactor.h"
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+
+namespace trpc::testing {
+
+namespace {
+
+std::string MakeContent(std::size_t size) {
+  std::string content(size, 0);
+  for (std::size_t i = 0; i != size; ++i) {
+    content[i] = static_cast<char>(i * 7 + i / 4096);
+  }
+  return content;
+}
+
+void ReadWriteFile() {
+  char path[] = "./fiber_file_test.XXXXXX";
+  int fd = ::mkstemp(path);
+  ASSERT_GE(fd, 0);
+  ::unlink(path);
+
+  FiberFile file(fd);
+  ASSERT_TRUE(file.IsOpen());
+
+  // Large enough to span many blocks, and more than IOV_MAX of them.
+  auto content = MakeContent(8 * 1024 * 1024 + 123);
+  NoncontiguousBufferBuilder builder;
+  builder.Append(content.data(), content.size());
+  auto buffer = builder.DestructiveGet();
+  ASSERT_GT(buffer.size(), 1);
+  ASSERT_EQ(file.WriteAt(buffer, 100), content.size());
+  ASSERT_EQ(file.Fsync(), 0);
+
+  NoncontiguousBuffer read;
+  ASSERT_EQ(file.ReadAt(content.size(), 100, &read), content.size());
+  ASSERT_EQ(FlattenSlow(read), content);
+
+  // Short read at the end of file, data is appended to the buffer.
+  NoncontiguousBuffer tail = CreateBufferSlow("head");
+  ASSERT_EQ(file.ReadAt(1000, 100 + content.size() - 10, &tail), 10);
+  ASSERT_EQ(FlattenSlow(tail), "head" + content.substr(content.size() - 10));
+
+  NoncontiguousBuffer empty;
+  ASSERT_EQ(file.ReadAt(10, 100 + content.size(), &empty), 0);
+  ASSERT_TRUE(empty.Empty());
+
+  FiberFile moved(std::move(file));
+  ASSERT_FALSE(file.IsOpen());
+  moved.Close();
+  ASSERT_FALSE(moved.IsOpen());
+  ASSERT_EQ(moved.ReadAt(10, 0, &empty), -1);
+  ASSERT_EQ(errno, EBADF);
+  ASSERT_EQ(moved.Fsync(), -1);
+}
+
+}  // namespace
+
+TEST(FiberFileTest, ReadWrite) {
+  RunAsFiber([] { ReadWriteFile(); });
+}
+
+TEST(FiberFileTest, ReadWriteWithReactor) {
+  // Falls back to blocking syscalls unless built with async io.
+  RunAsFiber([] {
+    fiber::EnableReactorAsyncIO(1024, 0);
+    fiber::StartAllReactor();
+    ReadWriteFile();
+    fiber::TerminateAllReactor();
+  });
+}
+
+TEST(FiberFileTest, Open) {
+  FiberFile file;
+  ASSERT_FALSE(file.IsOpen());
+  ASSERT_FALSE(file.Open("/not_exist_dir/file", O_RDONLY));
+  ASSERT_EQ(errno, ENOENT);
+
+  // Works in pthread as well.
+  char path[] = "./fiber_file_test.XXXXXX";
+  ::close(::mkstemp(path));
+  ASSERT_TRUE(file.Open(path, O_RDWR));
+  ::unlink(path);
+  ASSERT_EQ(file.WriteAt(CreateBufferSlow("hello"), 0), 5);
+  NoncontiguousBuffer read;
+  ASSERT_EQ(file.ReadAt(100, 0, &read), 5);
+  ASSERT_EQ(FlattenSlow(read), "hello");
+}
+
+}  // namespace trpc::testing
@@ -13,8 +13,11 @@
 
 #include "trpc/coroutine/fiber.h"
 
+#include <alloca.h>
+
 #include <atomic>
 #include <chrono>
+#include <cstring>
 #include <thread>
 #include <vector>
 
@@ -298,4 +301,43 @@ TEST(Fiber, FiberMutexInMixedContext) {
   });
 }
 
+TEST(Fiber, StackClass) {
+  RunAsFiber([] {
+    fiber::detail::ResetStackUsages();
+    fiber::detail::SetFiberStackUsageSampleRate(1);
+
+    for (auto stack_class : {fiber::StackClass::kSmall, fiber::StackClass::kDefault, fiber::StackClass::kLarge}) {
+      Fiber::Attributes attr;
+      attr.stack_class = stack_class;
+      attr.name = "StackClassTest";
+      // Use more stack than the small class has, which only fits in the large class.
+      std::size_t use_size = fiber::detail::GetFiberStackSize(fiber::StackClass::kSmall) / 2;
+      Fiber fiber(attr, [use_size] {
+        std::vector<char> buffer(use_size);
+        char* on_stack = static_cast<char*>(alloca(use_size));
+        memset(on_stack, 1, use_size);
+        buffer[0] = on_stack[use_size - 1];
+        ASSERT_EQ(buffer[0], 1);
+      });
+      fiber.Join();
+    }
+
+    fiber::detail::SetFiberStackUsageSampleRate(0);
+    // Stack of the fiber is freed (and measured) after `Join` returns.
+    for (int i = 0; i < 1000 && fiber::detail::GetStackUsages().size() < 3; ++i) {
+      FiberSleepFor(std::chrono::milliseconds(1));
+    }
+
+    auto usages = fiber::detail::GetStackUsages();
+    ASSERT_EQ(usages.size(), 3);
+    for (const auto& usage : usages) {
+      ASSERT_EQ(usage.name, "StackClassTest");
+      ASSERT_EQ(usage.samples, 1);
+      ASSERT_GE(usage.max_used, fiber::detail::GetFiberStackSize(fiber::StackClass::kSmall) / 2);
+      ASSERT_LT(usage.max_used, usage.stack_size);
+    }
+    fiber::detail::ResetStackUsages();
+  });
+}
+
 }  // namespace trpc
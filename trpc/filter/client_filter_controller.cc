@@ -13,13 +13,17 @@
 
 #include "trpc/filter/client_filter_controller.h"
 
+#include <cstddef>
+#include <utility>
+
 #include "trpc/client/client_context.h"
-#include "trpc/filter/client_filter_manager.h"
+#include "trpc/util/likely.h"
 
 namespace trpc {
 
 bool ClientFilterController::AddMessageClientFilter(const MessageClientFilterPtr& filter) {
   std::vector<FilterPoint> points = filter->GetFilterPoint();
+  std::scoped_lock lock(mutex_);
   // Check for duplicate additions.
   if (points.size() > 0) {
     int point = static_cast<int>(points[0]);
@@ -50,63 +54,80 @@ bool ClientFilterController::AddMessageClientFilter(const MessageClientFilterPtr
       client_filters_[point].push_back(filter);
     }
   }
+  MergeChains();
 
   return true;
 }
 
+void ClientFilterController::BuildChains() {
+  std::scoped_lock lock(mutex_);
+  MergeChains();
+}
+
+const ClientFilterController::Chains& ClientFilterController::GetChains() {
+  const Chains* chains = chains_.load(std::memory_order_acquire);
+  if (TRPC_UNLIKELY(chains == nullptr ||
+                    chains->global_filters->version != ClientFilterManager::GetInstance()->GetGlobalFilterVersion())) {
+    std::scoped_lock lock(mutex_);
+    chains = chains_.load(std::memory_order_relaxed);
+    if (chains == nullptr ||
+        chains->global_filters->version != ClientFilterManager::GetInstance()->GetGlobalFilterVersion()) {
+      chains = MergeChains();
+    }
+  }
+  return *chains;
+}
+
+const ClientFilterController::Chains* ClientFilterController::MergeChains() {
+  auto chains = std::make_unique<Chains>();
+  chains->global_filters = ClientFilterManager::GetInstance()->GetGlobalFilters();
+  for (int point = 0; point < kFilterTypeNum; ++point) {
+    // Global and service-level filters use the same index of filter point.
+    const auto& global_filters = chains->global_filters->filters[point];
+    const auto& service_filters = client_filters_[point];
+    auto& chain = chains->filters[point];
+    chain.reserve(global_filters.size() + service_filters.size());
+    if (!PostOrder(point)) {
+      chain.insert(chain.end(), global_filters.begin(), global_filters.end());
+      chain.insert(chain.end(), service_filters.begin(), service_filters.end());
+    } else {
+      chain.insert(chain.end(), service_filters.begin(), service_filters.end());
+      chain.insert(chain.end(), global_filters.begin(), global_filters.end());
+    }
+  }
+
+  const Chains* published = chains.get();
+  published_chains_.push_back(std::move(chains));
+  chains_.store(published, std::memory_order_release);
+  return published;
+}
+
 FilterStatus ClientFilterController::RunMessageClientFilters(FilterPoint type, const ClientContextPtr& context) {
   TRPC_ASSERT(context);
   FilterStatus status = FilterStatus::CONTINUE;
-  if (!PostOrder(static_cast<int>(type))) {
-    // execute global filters first
-    const auto& global_filters = ClientFilterManager::GetInstance()->GetMessageClientGlobalFilter(type);
-    for (uint32_t i = 0; i < global_filters.size(); ++i) {
-      global_filters[i]->operator()(status, type, context);
+  int point = static_cast<int>(type);
+  const auto& chain = GetChains().filters[point];
+  if (!PostOrder(point)) {
+    for (uint32_t i = 0; i < chain.size(); ++i) {
+      (*chain[i])(status, type, context);
       if (status == FilterStatus::REJECT) {
-        // execute filter fail, save the index of current filter (the index of the global filter is the index in the
-        // global_filters array).
+        // execute filter fail, save the index of current filter, the global filters come first in chain.
         context->SetFilterExecIndex(type, i);
         return status;
       }
     }
-
-    // execute service-level filter
-    auto& service_filters = client_filters_[static_cast<int>(type)];
-    for (uint32_t i = 0; i < service_filters.size(); ++i) {
-      service_filters[i]->operator()(status, type, context);
-      if (status == FilterStatus::REJECT) {
-        // execute filter fail, save the index of current service-level filter (the index is the index in
-        // the service_filters array plus the size of global filters).
-        context->SetFilterExecIndex(type, i + global_filters.size());
-        return status;
-      }
-    }
   } else {
-    int exec_index = context->GetFilterExecIndex(GetMatchPoint(type));
-    const auto& global_filters = ClientFilterManager::GetInstance()->GetMessageClientGlobalFilter(type);
-    auto& service_filters = client_filters_[static_cast<int>(type)];
-
-    if (exec_index == -1) {
-      exec_index = global_filters.size() + service_filters.size();
-    }
-
-    // The execution order of post-point is opposite to that of pre-point.
-    // The service-level filters are executed first, followed by the global filters.
+    // The execution order of post-point is opposite to that of pre-point, so the post-points of the filters whose
+    // pre-points have been executed successfully are the tail of the chain.
     // To ensure that all post-filters of successfully executed filters can be executed, post-filters do not need to
     // check whether the previous filters have been executed successfully.
-    if (static_cast<uint32_t>(exec_index) > global_filters.size()) {
-      // calculate the offset of the service filters that need to be executed
-      auto index = service_filters.size() - (exec_index - global_filters.size());
-      for (uint32_t i = index; i < service_filters.size(); ++i) {
-        service_filters[i]->operator()(status, type, context);
-      }
-      exec_index = global_filters.size();
+    int exec_index = context->GetFilterExecIndex(GetMatchPoint(type));
+    std::size_t index = 0;
+    if (exec_index != -1 && static_cast<std::size_t>(exec_index) < chain.size()) {
+      index = chain.size() - exec_index;
     }
-
-    // calculate the offset of the global filters that need to be executed
-    auto index = global_filters.size() - exec_index;
-    for (uint32_t i = index; i < global_filters.size(); ++i) {
-      global_filters[i]->operator()(status, type, context);
+    for (std::size_t i = index; i < chain.size(); ++i) {
+      (*chain[i])(status, type, context);
     }
   }
 
@@ -13,14 +13,22 @@
 
 #pragma once
 
+#include <atomic>
 #include <deque>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 #include "trpc/filter/client_filter_base.h"
+#include "trpc/filter/client_filter_manager.h"
 
 namespace trpc {
 
 /// @brief Execution controller for client filters.
+/// @note  The global and service-level filters of each filter point are merged into a flat chain holding only the
+///        filters of that point, so running a point is a single pass over an array. Chains are built at setup once
+///        filters are added (see `BuildChains`) and never modified afterwards: if global filters change later, a new
+///        set of chains is built and published atomically, while the requests running the old one are not affected.
 class ClientFilterController {
  public:
   /// @brief Run client filters in specified fitler point.
@@ -35,13 +43,42 @@ class ClientFilterController {
   /// @note The same filter can only be added once.
   bool AddMessageClientFilter(const MessageClientFilterPtr& filter);
 
+  /// @brief Build the filter chains from the global and service-level filters added so far, it is called at setup
+  ///        after filters are added, so that requests never need to build them.
+  void BuildChains();
+
  private:
+  // Immutable filter chains of every filter point. For pre-points the global filters come first, followed by the
+  // service-level filters, and it's the opposite for post-points.
+  struct Chains {
+    // Snapshot of global filters merged.
+    std::shared_ptr<const ClientGlobalFilters> global_filters;
+
+    std::vector<MessageClientFilterPtr> filters[kFilterTypeNum];
+  };
+
   // Determine if a filter point is a post-point.
   inline bool PostOrder(int index) { return index & 0x1; }
 
+  // Get the filter chains, which are built again if global filters have changed.
+  const Chains& GetChains();
+
+  // Build and publish the chains, `mutex_` must be held.
+  const Chains* MergeChains();
+
  private:
+  // Guards the service-level filters and building chains.
+  std::mutex mutex_;
+
   // Queue array to store service-level's client filters by filter point.
   std::deque<MessageClientFilterPtr> client_filters_[kFilterTypeNum];
+
+  // Chains published, nullptr if not built yet.
+  std::atomic<const Chains*> chains_{nullptr};
+
+  // All chains published. The ones replaced may still be run by requests in flight, so they are released along with
+  // the controller, chains are rarely rebuilt after setup.
+  std::vector<std::unique_ptr<const Chains>> published_chains_;
 };
 
 }  // namespace trpc
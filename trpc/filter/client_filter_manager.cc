@@ -80,6 +80,7 @@ bool ClientFilterManager::AddMessageClientGlobalFilter(const MessageClientFilter
       message_client_global_filters_[point].push_back(filter);
     }
   }
+  PublishGlobalFilters();
 
   return true;
 }
@@ -89,12 +90,32 @@ const std::deque<MessageClientFilterPtr>& ClientFilterManager::GetMessageClientG
   return message_client_global_filters_[point];
 }
 
+std::shared_ptr<const ClientGlobalFilters> ClientFilterManager::GetGlobalFilters() const {
+  std::scoped_lock lock(global_filters_mutex_);
+  return global_filters_;
+}
+
+void ClientFilterManager::PublishGlobalFilters() {
+  auto global_filters = std::make_shared<ClientGlobalFilters>();
+  for (int i = 0; i < kFilterTypeNum; ++i) {
+    const auto& filters = message_client_global_filters_[i];
+    global_filters->filters[i].assign(filters.begin(), filters.end());
+  }
+
+  std::scoped_lock lock(global_filters_mutex_);
+  global_filters->version = global_filter_version_.load(std::memory_order_relaxed) + 1;
+  global_filter_version_.store(global_filters->version, std::memory_order_release);
+  global_filters_ = std::move(global_filters);
+}
+
 void ClientFilterManager::Clear() {
   // clear global client filters
   for (int i = 0; i < kFilterTypeNum; ++i) {
     message_client_global_filters_[i].clear();
   }
 
+  PublishGlobalFilters();
+
   // clear client filter
   message_client_filters_.clear();
 }
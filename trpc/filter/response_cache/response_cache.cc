@@ -0,0 +1,166 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/filter/response_cache/response_cache.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "trpc/tvar/basic_ops/passive_status.h"
+#include "trpc/util/time.h"
+
+namespace trpc {
+
+namespace {
+
+struct Registry {
+  std::mutex mutex;
+  std::vector<const ResponseCache*> caches;
+};
+
+Registry& GetRegistry() {
+  static Registry registry;
+  return registry;
+}
+
+ResponseCache::Stats SumStats() {
+  ResponseCache::Stats total;
+  ResponseCache::ForEachCache([&total](const ResponseCache& cache) {
+    auto stats = cache.GetStats();
+    total.capacity += stats.capacity;
+    total.memory_bytes += stats.memory_bytes;
+    total.entries += stats.entries;
+    total.hits += stats.hits;
+    total.misses += stats.misses;
+  });
+  return total;
+}
+
+// Statistics summed over all caches, exposed once the first cache is created.
+struct ResponseCacheVars {
+  tvar::PassiveStatus<uint64_t> hits{"trpc/server/response_cache/hits", [] { return SumStats().hits; }};
+  tvar::PassiveStatus<uint64_t> misses{"trpc/server/response_cache/misses", [] { return SumStats().misses; }};
+  tvar::PassiveStatus<double> hit_ratio{"trpc/server/response_cache/hit_ratio", [] {
+                                          auto stats = SumStats();
+                                          auto total = stats.hits + stats.misses;
+                                          return total == 0 ? 0.0 : static_cast<double>(stats.hits) / total;
+                                        }};
+  tvar::PassiveStatus<uint64_t> memory_bytes{"trpc/server/response_cache/memory_bytes",
+                                             [] { return SumStats().memory_bytes; }};
+  tvar::PassiveStatus<uint64_t> entries{"trpc/server/response_cache/entries", [] { return SumStats().entries; }};
+};
+
+void ExposeVars() { static ResponseCacheVars vars; }
+
+}  // namespace
+
+ResponseCache::ResponseCache(uint64_t capacity, uint32_t shard_num)
+    : capacity_(capacity),
+      shard_capacity_(capacity / std::max<uint32_t>(shard_num, 1)),
+      shards_(std::max<uint32_t>(shard_num, 1)) {
+  ExposeVars();
+
+  auto& registry = GetRegistry();
+  std::scoped_lock lock(registry.mutex);
+  registry.caches.push_back(this);
+}
+
+ResponseCache::~ResponseCache() {
+  auto& registry = GetRegistry();
+  std::scoped_lock lock(registry.mutex);
+  registry.caches.erase(std::remove(registry.caches.begin(), registry.caches.end(), this), registry.caches.end());
+}
+
+void ResponseCache::Erase(Shard& shard, std::list<Entry>::iterator iter) {
+  shard.memory_bytes -= iter->charge;
+  shard.index.erase(iter->key);
+  shard.lru.erase(iter);
+}
+
+bool ResponseCache::Get(std::string_view key, Value& value) {
+  Shard& shard = GetShard(key);
+  {
+    std::scoped_lock lock(shard.mutex);
+    auto iter = shard.index.find(key);
+    if (iter != shard.index.end()) {
+      auto entry = iter->second;
+      if (entry->expire_ms > trpc::time::GetSteadyMilliSeconds()) {
+        shard.lru.splice(shard.lru.begin(), shard.lru, entry);
+        value = entry->value;
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+      }
+      Erase(shard, entry);
+    }
+  }
+  misses_.fetch_add(1, std::memory_order_relaxed);
+  return false;
+}
+
+bool ResponseCache::Put(std::string key, Value value, uint32_t ttl_ms) {
+  std::size_t charge = key.size() + value.body.ByteSize() + kEntryOverhead;
+  for (const auto& [name, data] : value.trans_info) {
+    charge += name.size() + data.size();
+  }
+  if (charge > shard_capacity_) {
+    return false;
+  }
+
+  uint64_t expire_ms = trpc::time::GetSteadyMilliSeconds() + ttl_ms;
+  Shard& shard = GetShard(key);
+  std::scoped_lock lock(shard.mutex);
+  if (auto iter = shard.index.find(key); iter != shard.index.end()) {
+    Erase(shard, iter->second);
+  }
+
+  while (!shard.lru.empty() && shard.memory_bytes + charge > shard_capacity_) {
+    Erase(shard, std::prev(shard.lru.end()));
+  }
+
+  shard.lru.push_front(Entry{std::move(key), std::move(value), expire_ms, charge});
+  shard.index.emplace(shard.lru.front().key, shard.lru.begin());
+  shard.memory_bytes += charge;
+  return true;
+}
+
+void ResponseCache::Clear() {
+  for (auto& shard : shards_) {
+    std::scoped_lock lock(shard.mutex);
+    shard.index.clear();
+    shard.lru.clear();
+    shard.memory_bytes = 0;
+  }
+}
+
+ResponseCache::Stats ResponseCache::GetStats() const {
+  Stats stats;
+  stats.capacity = capacity_;
+  stats.hits = hits_.load(std::memory_order_relaxed);
+  stats.misses = misses_.load(std::memory_order_relaxed);
+  for (auto& shard : shards_) {
+    std::scoped_lock lock(shard.mutex);
+    stats.memory_bytes += shard.memory_bytes;
+    stats.entries += shard.index.size();
+  }
+  return stats;
+}
+
+void ResponseCache::ForEachCache(const std::function<void(const ResponseCache&)>& func) {
+  auto& registry = GetRegistry();
+  std::scoped_lock lock(registry.mutex);
+  for (const auto* cache : registry.caches) {
+    func(*cache);
+  }
+}
+
+}  // namespace trpc
@@ -0,0 +1,117 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+
+namespace trpc {
+
+/// @brief Memory-bounded cache of serialized responses, sharded by key, each shard is a LRU list guarded by its own
+///        lock. Entries expire after their TTL, and the least recently used ones are evicted once the memory of a shard
+///        exceeds its part of the capacity.
+/// @note  Cached bodies are shared with the responses sent on hit, no payload bytes are copied when getting.
+///        Statistics of all caches are exposed as tvar under "trpc/server/response_cache", and by admin command
+///        "/cmds/response_cache".
+class ResponseCache {
+ public:
+  /// @brief Cached response.
+  struct Value {
+    // Only its bytes are charged, so it should own memory of its own size rather than share blocks of memory pool.
+    NoncontiguousBuffer body;
+    uint8_t encode_type{0};
+    uint8_t compress_type{0};
+    // Response trans info, which is replayed on hit.
+    std::vector<std::pair<std::string, std::string>> trans_info;
+  };
+
+  /// @brief Statistics of cache.
+  struct Stats {
+    uint64_t capacity{0};
+    uint64_t memory_bytes{0};
+    uint64_t entries{0};
+    uint64_t hits{0};
+    uint64_t misses{0};
+  };
+
+  /// Memory charged for each entry besides its key, body and trans info, which covers the nodes of list and index.
+  static constexpr std::size_t kEntryOverhead = 128;
+
+  ResponseCache(uint64_t capacity, uint32_t shard_num);
+
+  ~ResponseCache();
+
+  /// @brief Get the response of key.
+  /// @return false if not found or expired.
+  bool Get(std::string_view key, Value& value);
+
+  /// @brief Put the response of key, which expires after `ttl_ms`.
+  /// @return false if it's too large for the cache.
+  bool Put(std::string key, Value value, uint32_t ttl_ms);
+
+  /// @brief Remove all entries.
+  void Clear();
+
+  Stats GetStats() const;
+
+  /// @brief Visit statistics of all caches alive.
+  static void ForEachCache(const std::function<void(const ResponseCache&)>& func);
+
+ private:
+  struct Entry {
+    std::string key;
+    Value value;
+    uint64_t expire_ms{0};
+    std::size_t charge{0};
+  };
+
+  struct Shard {
+    mutable std::mutex mutex;
+    // Most recently used at front.
+    std::list<Entry> lru;
+    // Keys refer to the keys in `lru`.
+    std::unordered_map<std::string_view, std::list<Entry>::iterator> index;
+    std::size_t memory_bytes{0};
+  };
+
+  Shard& GetShard(std::string_view key) { return shards_[std::hash<std::string_view>{}(key) % shards_.size()]; }
+
+  // Remove the entry from shard, lock of shard must be held.
+  static void Erase(Shard& shard, std::list<Entry>::iterator iter);
+
+ private:
+  uint64_t capacity_;
+
+  std::size_t shard_capacity_;
+
+  std::vector<Shard> shards_;
+
+  std::atomic<uint64_t> hits_{0};
+
+  std::atomic<uint64_t> misses_{0};
+};
+
+}  // namespace trpc
@@ -0,0 +1,209 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/filter/response_cache/response_cache_server_filter.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "trpc/server/service.h"
+#include "trpc/util/log/logging.h"
+
+namespace trpc {
+
+namespace {
+
+// Fields are length prefixed, so that values containing any byte can't be confused with each other.
+void AppendKeyField(std::string& key, const std::string& value) {
+  auto size = static_cast<uint32_t>(value.size());
+  key.append(reinterpret_cast<const char*>(&size), sizeof(size));
+  key.append(value);
+}
+
+// Blocks of memory pool are far larger than a typical cached body, sharing them with the response would pin the whole
+// blocks as long as the entry lives, so the body is copied into memory of its exact size.
+NoncontiguousBuffer CompactCopy(const NoncontiguousBuffer& buffer) {
+  NoncontiguousBuffer compact;
+  std::size_t size = buffer.ByteSize();
+  if (size > 0) {
+    char* data = new char[size];
+    FlattenToSlow(buffer, data, size);
+    compact.Append(data, size);
+  }
+  return compact;
+}
+
+}  // namespace
+
+ResponseCacheServerFilter::ResponseCacheServerFilter(const ResponseCacheConfig* config) {
+  if (config != nullptr) {
+    TRPC_ASSERT(config->shard_num > 0);
+    config_ = *config;
+    ignored_trans_info_.insert(config_.ignored_trans_info.begin(), config_.ignored_trans_info.end());
+    cache_ = std::make_unique<ResponseCache>(config_.capacity, config_.shard_num);
+  }
+}
+
+std::vector<FilterPoint> ResponseCacheServerFilter::GetFilterPoint() {
+  std::vector<FilterPoint> points = {FilterPoint::SERVER_POST_RECV_MSG, FilterPoint::SERVER_PRE_SEND_MSG};
+  return points;
+}
+
+void ResponseCacheServerFilter::operator()(FilterStatus& status, FilterPoint point, const ServerContextPtr& context) {
+  switch (point) {
+    case FilterPoint::SERVER_POST_RECV_MSG:
+      OnRequest(status, context);
+      break;
+    case FilterPoint::SERVER_PRE_SEND_MSG:
+      OnResponse(context);
+      break;
+    default:
+      break;
+  }
+}
+
+MessageServerFilterPtr ResponseCacheServerFilter::Create(const std::any& param) {
+  if (!param.has_value()) {
+    TRPC_FMT_WARN("No filter_config of {} filter is found in service config, it caches nothing.", Name());
+    return std::make_shared<ResponseCacheServerFilter>();
+  }
+
+  auto config = std::any_cast<ResponseCacheConfig>(param);
+  return std::make_shared<ResponseCacheServerFilter>(&config);
+}
+
+uint32_t ResponseCacheServerFilter::GetTtl(const std::string& func_name) const {
+  if (auto iter = config_.method_ttl.find(func_name); iter != config_.method_ttl.end()) {
+    return iter->second;
+  }
+  return config_.default_ttl;
+}
+
+void ResponseCacheServerFilter::OnRequest(FilterStatus& status, const ServerContextPtr& context) {
+  if (!cache_ || context->GetCallType() != kUnaryCall || !context->GetStatus().OK() ||
+      context->GetServerCodec()->Name() != "trpc") {
+    return;
+  }
+
+  uint32_t ttl = GetTtl(context->GetFuncName());
+  if (ttl == 0) {
+    return;
+  }
+
+  // Payloads are moved out by the getters, put them back after peeking.
+  const ProtocolPtr& req = context->GetRequestMsg();
+  NoncontiguousBuffer attachment = req->GetProtocolAttachment();
+  bool has_attachment = !attachment.Empty();
+  req->SetProtocolAttachment(std::move(attachment));
+  if (has_attachment) {
+    return;
+  }
+
+  // Trans info may change the response (e.g. auth token, dyeing key). Entries are sorted since iteration order of
+  // protobuf map is unspecified.
+  const auto& trans_info = context->GetPbReqTransInfo();
+  std::vector<const TransInfoMap::value_type*> key_trans_info;
+  std::size_t trans_info_size = 0;
+  key_trans_info.reserve(trans_info.size());
+  for (const auto& item : trans_info) {
+    if (ignored_trans_info_.empty() || ignored_trans_info_.find(item.first) == ignored_trans_info_.end()) {
+      key_trans_info.push_back(&item);
+      trans_info_size += item.first.size() + item.second.size() + 2 * sizeof(uint32_t);
+    }
+  }
+  std::sort(key_trans_info.begin(), key_trans_info.end(),
+            [](const auto* x, const auto* y) { return x->first < y->first; });
+
+  NoncontiguousBuffer body = req->GetNonContiguousProtocolBody();
+  std::size_t body_size = body.ByteSize();
+  if (body_size + trans_info_size > config_.max_entry_size) {
+    req->SetNonContiguousProtocolBody(std::move(body));
+    return;
+  }
+
+  // The whole request is kept in key rather than its hash, so different requests are never mixed up.
+  const std::string& service_name = context->GetService() ? context->GetService()->GetName() : context->GetCalleeName();
+  const std::string& func_name = context->GetFuncName();
+  RequestState state;
+  state.ttl = ttl;
+  state.key.reserve(service_name.size() + func_name.size() + trans_info_size + body_size + 4);
+  state.key.append(service_name);
+  state.key.push_back('\0');
+  state.key.append(func_name);
+  state.key.push_back('\0');
+  state.key.push_back(static_cast<char>(context->GetReqEncodeType()));
+  state.key.push_back(static_cast<char>(context->GetReqCompressType()));
+  for (const auto* item : key_trans_info) {
+    AppendKeyField(state.key, item->first);
+    AppendKeyField(state.key, item->second);
+  }
+  for (const auto& block : body) {
+    state.key.append(block.data(), block.size());
+  }
+  req->SetNonContiguousProtocolBody(std::move(body));
+
+  ResponseCache::Value value;
+  if (cache_->Get(state.key, value)) {
+    context->SetRspEncodeType(value.encode_type);
+    context->SetRspCompressType(value.compress_type);
+    for (auto& [name, data] : value.trans_info) {
+      context->AddRspTransInfo(std::move(name), std::move(data));
+    }
+    context->GetResponseMsg()->SetNonContiguousProtocolBody(std::move(value.body));
+
+    state.hit = true;
+    state.key.clear();
+    context->SetFilterData(GetFilterID(), std::move(state));
+
+    // The cached response is sent by framework, the same as the response of a rejected request.
+    status = FilterStatus::REJECT;
+    return;
+  }
+
+  context->SetFilterData(GetFilterID(), std::move(state));
+}
+
+void ResponseCacheServerFilter::OnResponse(const ServerContextPtr& context) {
+  auto* state = context->GetFilterData<RequestState>(GetFilterID());
+  if (state == nullptr || state->hit || !context->GetStatus().OK()) {
+    return;
+  }
+
+  const ProtocolPtr& rsp = context->GetResponseMsg();
+  NoncontiguousBuffer attachment = rsp->GetProtocolAttachment();
+  bool has_attachment = !attachment.Empty();
+  rsp->SetProtocolAttachment(std::move(attachment));
+  if (has_attachment) {
+    return;
+  }
+
+  NoncontiguousBuffer body = rsp->GetNonContiguousProtocolBody();
+  if (body.ByteSize() > config_.max_entry_size) {
+    rsp->SetNonContiguousProtocolBody(std::move(body));
+    return;
+  }
+  ResponseCache::Value value;
+  value.body = CompactCopy(body);
+  rsp->SetNonContiguousProtocolBody(std::move(body));
+  value.encode_type = context->GetRspEncodeType();
+  value.compress_type = context->GetRspCompressType();
+  const auto& rsp_trans_info = context->GetPbRspTransInfo();
+  value.trans_info.reserve(rsp_trans_info.size());
+  for (const auto& [name, data] : rsp_trans_info) {
+    value.trans_info.emplace_back(name, data);
+  }
+  cache_->Put(std::move(state->key), std::move(value), state->ttl);
+}
+
+}  // namespace trpc
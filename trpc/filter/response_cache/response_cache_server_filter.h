@@ -0,0 +1,80 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <any>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "trpc/common/config/response_cache_conf.h"
+#include "trpc/filter/server_filter_base.h"
+#include "trpc/filter/response_cache/response_cache.h"
+#include "trpc/server/server_context.h"
+
+namespace trpc {
+
+/// @brief Server filter serving identical requests from cached responses within the TTL of method. Requests are
+///        identical if they have the same service, function, encode type, compress type, trans info and body, trans
+///        info listed in `ResponseCacheConfig::ignored_trans_info` left out. A cache hit sends the cached response along
+///        with its trans info at once, skipping deserialization, the handler and serialization.
+/// @note  Only the successful responses of unary trpc calls without attachment are cached, enable it only for methods
+///        whose responses depend on nothing but the request.
+///        Filters after it are skipped on cache hit, so put it after the filters which must see every request, e.g.
+///        authentication or rate limiting.
+///        Each service using it by `filter` of service config has its own cache, which is configured by
+///        `filter_config.response_cache` of the service, see `ResponseCacheConfig`.
+class ResponseCacheServerFilter : public MessageServerFilter {
+ public:
+  /// @brief The filter registered without config only works as the prototype of filters created for services, it
+  ///        caches nothing.
+  explicit ResponseCacheServerFilter(const ResponseCacheConfig* config = nullptr);
+
+  std::string Name() override { return kResponseCacheFilter; }
+
+  std::vector<FilterPoint> GetFilterPoint() override;
+
+  void operator()(FilterStatus& status, FilterPoint point, const ServerContextPtr& context) override;
+
+  MessageServerFilterPtr Create(const std::any& param) override;
+
+  /// @brief Get the cache of filter, nullptr if it is created without config.
+  ResponseCache* GetCache() { return cache_.get(); }
+
+ private:
+  // State of request kept in filter data.
+  struct RequestState {
+    bool hit{false};
+    uint32_t ttl{0};
+    std::string key;
+  };
+
+  // Serve the request from cache if hit, otherwise remember its key.
+  void OnRequest(FilterStatus& status, const ServerContextPtr& context);
+
+  // Cache the response of request missed.
+  void OnResponse(const ServerContextPtr& context);
+
+  uint32_t GetTtl(const std::string& func_name) const;
+
+ private:
+  ResponseCacheConfig config_;
+
+  std::unordered_set<std::string> ignored_trans_info_;
+
+  std::unique_ptr<ResponseCache> cache_;
+};
+
+}  // namespace trpc
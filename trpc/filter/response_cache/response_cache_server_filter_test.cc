@@ -0,0 +1,155 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/filter/response_cache/response_cache_server_filter.h"
+
+#include <memory>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "trpc/codec/trpc/trpc_protocol.h"
+#include "trpc/codec/trpc/trpc_server_codec.h"
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+
+namespace trpc::testing {
+
+class ResponseCacheServerFilterTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ResponseCacheConfig config;
+    config.default_ttl = 0;
+    config.method_ttl["/trpc.test.helloworld.Greeter/SayHello"] = 1000;
+    config.max_entry_size = 64;
+    config.ignored_trans_info.push_back("trace-id");
+    filter_ = ResponseCacheServerFilter().Create(config);
+    ASSERT_NE(filter_, nullptr);
+  }
+
+  ServerContextPtr MakeContext(const std::string& func, const std::string& body) {
+    auto context = MakeRefCounted<ServerContext>();
+    context->SetServerCodec(&codec_);
+    context->SetRequestMsg(std::make_shared<TrpcRequestProtocol>());
+    context->SetResponseMsg(std::make_shared<TrpcResponseProtocol>());
+    context->SetFuncName(func);
+    context->GetRequestMsg()->SetNonContiguousProtocolBody(CreateBufferSlow(body));
+    return context;
+  }
+
+  // Run the filter around a handler which responds `rsp`.
+  FilterStatus Invoke(const ServerContextPtr& context, const std::string& rsp) {
+    FilterStatus status = FilterStatus::CONTINUE;
+    (*filter_)(status, FilterPoint::SERVER_POST_RECV_MSG, context);
+    if (status == FilterStatus::CONTINUE) {
+      context->SetRspEncodeType(3);
+      context->GetResponseMsg()->SetNonContiguousProtocolBody(CreateBufferSlow(rsp));
+    }
+    FilterStatus send_status = FilterStatus::CONTINUE;
+    (*filter_)(send_status, FilterPoint::SERVER_PRE_SEND_MSG, context);
+    return status;
+  }
+
+  static std::string GetRspBody(const ServerContextPtr& context) {
+    return FlattenSlow(context->GetResponseMsg()->GetNonContiguousProtocolBody());
+  }
+
+ protected:
+  TrpcServerCodec codec_;
+  MessageServerFilterPtr filter_;
+};
+
+TEST_F(ResponseCacheServerFilterTest, Hit) {
+  auto context = MakeContext("/trpc.test.helloworld.Greeter/SayHello", "req");
+  ASSERT_EQ(Invoke(context, "rsp"), FilterStatus::CONTINUE);
+  // Request is intact after the key is built.
+  ASSERT_EQ(FlattenSlow(context->GetRequestMsg()->GetNonContiguousProtocolBody()), "req");
+  auto sent = context->GetResponseMsg()->GetNonContiguousProtocolBody();
+  ASSERT_EQ(FlattenSlow(sent), "rsp");
+
+  context = MakeContext("/trpc.test.helloworld.Greeter/SayHello", "req");
+  ASSERT_EQ(Invoke(context, "other"), FilterStatus::REJECT);
+  auto cached = context->GetResponseMsg()->GetNonContiguousProtocolBody();
+  ASSERT_EQ(FlattenSlow(cached), "rsp");
+  // The cached body is a copy of its own, which doesn't pin the blocks of the response sent.
+  ASSERT_NE(cached.FirstContiguous().data(), sent.FirstContiguous().data());
+  ASSERT_EQ(context->GetRspEncodeType(), 3);
+
+  auto* cache = static_cast<ResponseCacheServerFilter*>(filter_.get())->GetCache();
+  ASSERT_EQ(cache->GetStats().hits, 1);
+  ASSERT_EQ(cache->GetStats().entries, 1);
+}
+
+TEST_F(ResponseCacheServerFilterTest, NotCached) {
+  // Different request.
+  ASSERT_EQ(Invoke(MakeContext("/trpc.test.helloworld.Greeter/SayHello", "req1"), "rsp"), FilterStatus::CONTINUE);
+  ASSERT_EQ(Invoke(MakeContext("/trpc.test.helloworld.Greeter/SayHello", "req2"), "rsp"), FilterStatus::CONTINUE);
+
+  // Method without ttl.
+  ASSERT_EQ(Invoke(MakeContext("/trpc.test.helloworld.Greeter/SayHi", "req"), "rsp"), FilterStatus::CONTINUE);
+  ASSERT_EQ(Invoke(MakeContext("/trpc.test.helloworld.Greeter/SayHi", "req"), "rsp"), FilterStatus::CONTINUE);
+
+  // Failed response.
+  auto context = MakeContext("/trpc.test.helloworld.Greeter/SayHello", "failed");
+  context->GetStatus().SetFuncRetCode(-1);
+  ASSERT_EQ(Invoke(context, "rsp"), FilterStatus::CONTINUE);
+  ASSERT_EQ(Invoke(MakeContext("/trpc.test.helloworld.Greeter/SayHello", "failed"), "rsp"), FilterStatus::CONTINUE);
+
+  // Request too large.
+  std::string large(128, 'x');
+  ASSERT_EQ(Invoke(MakeContext("/trpc.test.helloworld.Greeter/SayHello", large), "rsp"), FilterStatus::CONTINUE);
+  ASSERT_EQ(Invoke(MakeContext("/trpc.test.helloworld.Greeter/SayHello", large), "rsp"), FilterStatus::CONTINUE);
+
+  // Response too large.
+  ASSERT_EQ(Invoke(MakeContext("/trpc.test.helloworld.Greeter/SayHello", "req3"), large), FilterStatus::CONTINUE);
+  ASSERT_EQ(Invoke(MakeContext("/trpc.test.helloworld.Greeter/SayHello", "req3"), large), FilterStatus::CONTINUE);
+}
+
+TEST_F(ResponseCacheServerFilterTest, TransInfo) {
+  auto context = MakeContext("/trpc.test.helloworld.Greeter/SayHello", "req");
+  context->AddReqTransInfo("token", "a");
+  context->AddReqTransInfo("trace-id", "1");
+  FilterStatus status = FilterStatus::CONTINUE;
+  (*filter_)(status, FilterPoint::SERVER_POST_RECV_MSG, context);
+  ASSERT_EQ(status, FilterStatus::CONTINUE);
+  context->GetResponseMsg()->SetNonContiguousProtocolBody(CreateBufferSlow("rsp"));
+  context->AddRspTransInfo("rsp-key", "rsp-value");
+  (*filter_)(status, FilterPoint::SERVER_PRE_SEND_MSG, context);
+
+  // Ignored trans info doesn't matter, and response trans info is replayed.
+  context = MakeContext("/trpc.test.helloworld.Greeter/SayHello", "req");
+  context->AddReqTransInfo("token", "a");
+  context->AddReqTransInfo("trace-id", "2");
+  ASSERT_EQ(Invoke(context, "other"), FilterStatus::REJECT);
+  ASSERT_EQ(GetRspBody(context), "rsp");
+  ASSERT_EQ(context->GetPbRspTransInfo().at("rsp-key"), "rsp-value");
+
+  // Other trans info does.
+  context = MakeContext("/trpc.test.helloworld.Greeter/SayHello", "req");
+  context->AddReqTransInfo("token", "b");
+  ASSERT_EQ(Invoke(context, "other"), FilterStatus::CONTINUE);
+  ASSERT_EQ(Invoke(MakeContext("/trpc.test.helloworld.Greeter/SayHello", "req"), "other"), FilterStatus::CONTINUE);
+}
+
+TEST_F(ResponseCacheServerFilterTest, Prototype) {
+  ResponseCacheServerFilter filter;
+  ASSERT_EQ(filter.Name(), kResponseCacheFilter);
+  ASSERT_EQ(filter.GetFilterPoint().size(), 2);
+  ASSERT_EQ(filter.GetCache(), nullptr);
+
+  auto context = MakeContext("/trpc.test.helloworld.Greeter/SayHello", "req");
+  FilterStatus status = FilterStatus::CONTINUE;
+  filter(status, FilterPoint::SERVER_POST_RECV_MSG, context);
+  ASSERT_EQ(status, FilterStatus::CONTINUE);
+}
+
+}  // namespace trpc::testing
@@ -0,0 +1,104 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/filter/response_cache/response_cache.h"
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+
+namespace trpc::testing {
+
+namespace {
+
+ResponseCache::Value MakeValue(const std::string& body) {
+  ResponseCache::Value value;
+  value.body = CreateBufferSlow(body);
+  value.encode_type = 1;
+  value.compress_type = 2;
+  return value;
+}
+
+}  // namespace
+
+TEST(ResponseCacheTest, GetAndPut) {
+  ResponseCache cache(1024 * 1024, 4);
+  ResponseCache::Value value;
+  ASSERT_FALSE(cache.Get("key", value));
+
+  ASSERT_TRUE(cache.Put("key", MakeValue("hello"), 1000));
+  ASSERT_TRUE(cache.Get("key", value));
+  ASSERT_EQ(FlattenSlow(value.body), "hello");
+  ASSERT_EQ(value.encode_type, 1);
+  ASSERT_EQ(value.compress_type, 2);
+
+  // Replaced by the newer one.
+  ASSERT_TRUE(cache.Put("key", MakeValue("world"), 1000));
+  ASSERT_TRUE(cache.Get("key", value));
+  ASSERT_EQ(FlattenSlow(value.body), "world");
+
+  auto stats = cache.GetStats();
+  ASSERT_EQ(stats.entries, 1);
+  ASSERT_EQ(stats.hits, 2);
+  ASSERT_EQ(stats.misses, 1);
+  ASSERT_EQ(stats.memory_bytes, 3 + 5 + ResponseCache::kEntryOverhead);
+
+  cache.Clear();
+  ASSERT_FALSE(cache.Get("key", value));
+  ASSERT_EQ(cache.GetStats().memory_bytes, 0);
+}
+
+TEST(ResponseCacheTest, Expire) {
+  ResponseCache cache(1024 * 1024, 1);
+  ASSERT_TRUE(cache.Put("key", MakeValue("hello"), 10));
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+  ResponseCache::Value value;
+  ASSERT_FALSE(cache.Get("key", value));
+  ASSERT_EQ(cache.GetStats().entries, 0);
+}
+
+TEST(ResponseCacheTest, EvictLeastRecentlyUsed) {
+  // Room for 3 entries with 2-byte keys and 70-byte bodies.
+  ResponseCache cache(3 * (2 + 70 + ResponseCache::kEntryOverhead), 1);
+  std::string body(70, 'x');
+  ASSERT_TRUE(cache.Put("k1", MakeValue(body), 1000));
+  ASSERT_TRUE(cache.Put("k2", MakeValue(body), 1000));
+  ASSERT_TRUE(cache.Put("k3", MakeValue(body), 1000));
+
+  ResponseCache::Value value;
+  ASSERT_TRUE(cache.Get("k1", value));
+  ASSERT_TRUE(cache.Put("k4", MakeValue(body), 1000));
+
+  ASSERT_TRUE(cache.Get("k1", value));
+  ASSERT_FALSE(cache.Get("k2", value));
+  ASSERT_TRUE(cache.Get("k3", value));
+  ASSERT_TRUE(cache.Get("k4", value));
+  ASSERT_LE(cache.GetStats().memory_bytes, cache.GetStats().capacity);
+
+  // Larger than capacity.
+  ASSERT_FALSE(cache.Put("k5", MakeValue(std::string(1024, 'x')), 1000));
+}
+
+TEST(ResponseCacheTest, ForEachCache) {
+  ResponseCache cache(1024, 1);
+  bool found = false;
+  ResponseCache::ForEachCache([&](const ResponseCache& c) { found = found || &c == &cache; });
+  ASSERT_TRUE(found);
+}
+
+}  // namespace trpc::testing
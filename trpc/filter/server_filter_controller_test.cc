@@ -134,4 +134,27 @@ TEST(ServerFilterController, RunMessageServerFilters) {
   trpc::ServerFilterManager::GetInstance()->Clear();
 }
 
+TEST(ServerFilterController, BuildChains) {
+  std::vector<FilterPoint> points = {FilterPoint::SERVER_PRE_RPC_INVOKE, FilterPoint::SERVER_POST_RPC_INVOKE};
+  auto server_filter = std::make_shared<MockServerFilter>();
+  EXPECT_CALL(*server_filter, GetFilterPoint()).WillRepeatedly(::testing::Return(points));
+  EXPECT_CALL(*server_filter, Name()).WillRepeatedly(::testing::Return("global_server_filter"));
+  ASSERT_TRUE(trpc::ServerFilterManager::GetInstance()->AddMessageServerGlobalFilter(server_filter));
+
+  ServerFilterController filter_controller;
+  filter_controller.BuildChains();
+  long use_count = server_filter.use_count();
+
+  // Filters of the chains built are kept alive even if global filters are cleared.
+  trpc::ServerFilterManager::GetInstance()->Clear();
+  ASSERT_LT(server_filter.use_count(), use_count);
+  ASSERT_GT(server_filter.use_count(), 1);
+
+  // Chains are built again without the filters cleared.
+  trpc::ServerContextPtr ctx = trpc::MakeRefCounted<trpc::ServerContext>();
+  EXPECT_CALL(*server_filter, BracketOp(::testing::_, ::testing::_, ::testing::_)).Times(0);
+  ASSERT_EQ(filter_controller.RunMessageServerFilters(FilterPoint::SERVER_PRE_RPC_INVOKE, ctx),
+            FilterStatus::CONTINUE);
+}
+
 }  // namespace trpc::testing
@@ -79,6 +79,7 @@ bool ServerFilterManager::AddMessageServerGlobalFilter(const MessageServerFilter
       message_server_global_filters_[point].push_back(filter);
     }
   }
+  PublishGlobalFilters();
 
   return true;
 }
@@ -88,12 +89,32 @@ const std::deque<MessageServerFilterPtr>& ServerFilterManager::GetMessageServerG
   return message_server_global_filters_[point];
 }
 
+std::shared_ptr<const ServerGlobalFilters> ServerFilterManager::GetGlobalFilters() const {
+  std::scoped_lock lock(global_filters_mutex_);
+  return global_filters_;
+}
+
+void ServerFilterManager::PublishGlobalFilters() {
+  auto global_filters = std::make_shared<ServerGlobalFilters>();
+  for (int i = 0; i < kFilterTypeNum; ++i) {
+    const auto& filters = message_server_global_filters_[i];
+    global_filters->filters[i].assign(filters.begin(), filters.end());
+  }
+
+  std::scoped_lock lock(global_filters_mutex_);
+  global_filters->version = global_filter_version_.load(std::memory_order_relaxed) + 1;
+  global_filter_version_.store(global_filters->version, std::memory_order_release);
+  global_filters_ = std::move(global_filters);
+}
+
 void ServerFilterManager::Clear() {
   // clear global server filters
   for (int i = 0; i < kFilterTypeNum; ++i) {
     message_server_global_filters_[i].clear();
   }
 
+  PublishGlobalFilters();
+
   // clear server filter
   message_server_filters_.clear();
 }
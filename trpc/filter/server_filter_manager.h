@@ -13,7 +13,11 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <deque>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -22,6 +26,16 @@
 
 namespace trpc {
 
+/// @brief Immutable snapshot of global server filters, a new one is published whenever global filters change, so that
+///        filter controllers can merge it into their filter chains without racing with the change.
+struct ServerGlobalFilters {
+  /// Version of global filters, see `ServerFilterManager::GetGlobalFilterVersion`.
+  uint32_t version{0};
+
+  /// Global filters by filter point, in the same order as `GetMessageServerGlobalFilter`.
+  std::vector<MessageServerFilterPtr> filters[kFilterTypeNum];
+};
+
 /// @brief The server filter management class.
 class ServerFilterManager {
  public:
@@ -51,11 +65,21 @@ class ServerFilterManager {
   /// @brief Get global server filters by filter point.
   const std::deque<MessageServerFilterPtr>& GetMessageServerGlobalFilter(FilterPoint type);
 
+  /// @brief Get the version of global server filters, which changes whenever global filters are added or cleared.
+  /// @note  Filter controllers merge global filters into their filter chains, and merge again once it changes.
+  uint32_t GetGlobalFilterVersion() const { return global_filter_version_.load(std::memory_order_acquire); }
+
+  /// @brief Get the snapshot of global server filters, whose version is the current one.
+  std::shared_ptr<const ServerGlobalFilters> GetGlobalFilters() const;
+
   /// @brief Clean up the used resources.
   void Clear();
 
  private:
-  ServerFilterManager() = default;
+  ServerFilterManager() { PublishGlobalFilters(); }
+
+  // Publish a new snapshot of global filters with a new version.
+  void PublishGlobalFilters();
 
   // Determine if a filter point is a post-point. The index parameter refers to the corresponding index of the point.
   inline bool PostOrder(int index) { return index & 0x1; }
@@ -70,6 +94,15 @@ class ServerFilterManager {
 
   // Queue array to store global server filters by filter point.
   std::deque<MessageServerFilterPtr> message_server_global_filters_[kFilterTypeNum];
+
+  // Guards `global_filters_`.
+  mutable std::mutex global_filters_mutex_;
+
+  // Snapshot of the global filters above.
+  std::shared_ptr<const ServerGlobalFilters> global_filters_;
+
+  // Version of `global_filters_`, starts from 1 once the first (empty) snapshot is published.
+  std::atomic<uint32_t> global_filter_version_{0};
 };
 
 }  // namespace trpc
@@ -0,0 +1,157 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "trpc/filter/client_filter_base.h"
+#include "trpc/filter/server_filter_base.h"
+
+namespace trpc {
+
+namespace detail {
+
+/// @brief Bit of filter point in the mask of stage, client and server points share the same bits.
+/// @private
+constexpr uint32_t FilterPointBit(FilterPoint point) {
+  return 1u << (static_cast<uint32_t>(point) & kServerFilterMask);
+}
+
+/// @private
+template <typename Stage>
+constexpr uint32_t StageFilterPointMask() {
+  uint32_t mask = 0;
+  for (FilterPoint point : Stage::kFilterPoints) {
+    mask |= FilterPointBit(point);
+  }
+  return mask;
+}
+
+}  // namespace detail
+
+/// @brief Filter running a fixed list of stages, which are called directly (and usually inlined) instead of through
+///        virtual functions, so a chain of common filters, e.g. metrics, tracing and limiter, costs a single virtual
+///        call at each filter point.
+///        A stage is a plain class with the filter points it handles and the handler of them:
+///        @code
+///          struct MetricsStage {
+///            static constexpr FilterPoint kFilterPoints[] = {FilterPoint::SERVER_PRE_RPC_INVOKE,
+///                                                            FilterPoint::SERVER_POST_RPC_INVOKE};
+///            void operator()(FilterStatus& status, FilterPoint point, const ServerContextPtr& context);
+///          };
+///
+///          auto filter = std::make_shared<StaticServerFilterChain<MetricsStage, LimiterStage>>("metrics_limiter");
+///        @endcode
+///        Filter points of stages must be paired, as those of filters.
+/// @note  Stages run in the order listed at pre-points and in the reverse order at post-points, the same as filters
+///        in filter controller. If a stage rejects at a pre-point, the chain rejects, and the post-points of the
+///        stages run before it are executed at once (in reverse order), as filter controller skips the post-point of
+///        a rejecting filter.
+template <typename ContextPtr, typename... Stages>
+class StaticFilterChain : public Filter<ContextPtr> {
+  static_assert(sizeof...(Stages) > 0, "At least one stage is required");
+
+ public:
+  explicit StaticFilterChain(std::string name) : name_(std::move(name)) {}
+
+  StaticFilterChain(std::string name, Stages... stages) : name_(std::move(name)), stages_(std::move(stages)...) {}
+
+  std::string Name() override { return name_; }
+
+  std::vector<FilterPoint> GetFilterPoint() override {
+    std::vector<FilterPoint> points;
+    (AddFilterPoints<Stages>(points), ...);
+    return points;
+  }
+
+  void operator()(FilterStatus& status, FilterPoint point, const ContextPtr& context) override {
+    if ((static_cast<int>(point) & 0x1) == 0) {
+      RunPrePoint<0>(status, point, context);
+    } else {
+      RunPostPoint<sizeof...(Stages)>(status, point, context);
+    }
+  }
+
+  /// @brief Get stage by index.
+  template <std::size_t I>
+  auto& GetStage() {
+    return std::get<I>(stages_);
+  }
+
+ private:
+  template <typename Stage>
+  static void AddFilterPoints(std::vector<FilterPoint>& points) {
+    for (FilterPoint point : Stage::kFilterPoints) {
+      bool exists = false;
+      for (FilterPoint added : points) {
+        exists = exists || added == point;
+      }
+      if (!exists) {
+        points.push_back(point);
+      }
+    }
+  }
+
+  template <std::size_t I>
+  static bool HasFilterPoint(FilterPoint point) {
+    using Stage = std::tuple_element_t<I, std::tuple<Stages...>>;
+    constexpr uint32_t kMask = detail::StageFilterPointMask<Stage>();
+    return (kMask & detail::FilterPointBit(point)) != 0;
+  }
+
+  // Run stages from I to the last one.
+  template <std::size_t I>
+  void RunPrePoint(FilterStatus& status, FilterPoint point, const ContextPtr& context) {
+    if constexpr (I < sizeof...(Stages)) {
+      if (HasFilterPoint<I>(point)) {
+        std::get<I>(stages_)(status, point, context);
+        if (status == FilterStatus::REJECT) {
+          FilterStatus post_status = FilterStatus::CONTINUE;
+          RunPostPoint<I>(post_status, GetMatchPoint(point), context);
+          return;
+        }
+      }
+      RunPrePoint<I + 1>(status, point, context);
+    }
+  }
+
+  // Run the first N stages in reverse order.
+  template <std::size_t N>
+  void RunPostPoint(FilterStatus& status, FilterPoint point, const ContextPtr& context) {
+    if constexpr (N > 0) {
+      if (HasFilterPoint<N - 1>(point)) {
+        std::get<N - 1>(stages_)(status, point, context);
+      }
+      RunPostPoint<N - 1>(status, point, context);
+    }
+  }
+
+ private:
+  std::string name_;
+
+  std::tuple<Stages...> stages_;
+};
+
+template <typename... Stages>
+using StaticServerFilterChain = StaticFilterChain<ServerContextPtr, Stages...>;
+
+template <typename... Stages>
+using StaticClientFilterChain = StaticFilterChain<ClientContextPtr, Stages...>;
+
+}  // namespace trpc
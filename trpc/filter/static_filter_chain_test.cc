@@ -0,0 +1,106 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/filter/static_filter_chain.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "trpc/filter/server_filter_controller.h"
+#include "trpc/filter/server_filter_manager.h"
+#include "trpc/server/server_context.h"
+
+namespace trpc::testing {
+
+namespace {
+
+// Records the stages executed as "<name>:<point>".
+std::vector<std::string> records;
+
+template <char kName>
+struct RecordStage {
+  static constexpr FilterPoint kFilterPoints[] = {FilterPoint::SERVER_PRE_RPC_INVOKE,
+                                                  FilterPoint::SERVER_POST_RPC_INVOKE};
+
+  void operator()(FilterStatus& status, FilterPoint point, const ServerContextPtr& context) {
+    records.push_back(std::string(1, kName) + ":" + std::to_string(static_cast<int>(point) & kServerFilterMask));
+    if (point == reject_point) {
+      status = FilterStatus::REJECT;
+    }
+  }
+
+  FilterPoint reject_point = FilterPoint::SERVER_POST_IO_SEND_MSG;
+};
+
+struct RecvStage {
+  static constexpr FilterPoint kFilterPoints[] = {FilterPoint::SERVER_POST_RECV_MSG, FilterPoint::SERVER_PRE_SEND_MSG};
+
+  void operator()(FilterStatus& status, FilterPoint point, const ServerContextPtr& context) {
+    records.push_back("r:" + std::to_string(static_cast<int>(point) & kServerFilterMask));
+  }
+};
+
+using Chain = StaticServerFilterChain<RecordStage<'a'>, RecvStage, RecordStage<'b'>, RecordStage<'c'>>;
+
+}  // namespace
+
+TEST(StaticFilterChainTest, FilterPoint) {
+  Chain chain("chain");
+  ASSERT_EQ(chain.Name(), "chain");
+  std::vector<FilterPoint> points = {FilterPoint::SERVER_PRE_RPC_INVOKE, FilterPoint::SERVER_POST_RPC_INVOKE,
+                                     FilterPoint::SERVER_POST_RECV_MSG, FilterPoint::SERVER_PRE_SEND_MSG};
+  ASSERT_EQ(chain.GetFilterPoint(), points);
+}
+
+TEST(StaticFilterChainTest, Run) {
+  records.clear();
+  Chain chain("chain");
+  auto context = MakeRefCounted<ServerContext>();
+  FilterStatus status = FilterStatus::CONTINUE;
+  chain(status, FilterPoint::SERVER_PRE_RPC_INVOKE, context);
+  chain(status, FilterPoint::SERVER_POST_RPC_INVOKE, context);
+  ASSERT_EQ(status, FilterStatus::CONTINUE);
+  std::vector<std::string> expected = {"a:2", "b:2", "c:2", "c:3", "b:3", "a:3"};
+  ASSERT_EQ(records, expected);
+
+  records.clear();
+  chain(status, FilterPoint::SERVER_POST_RECV_MSG, context);
+  chain(status, FilterPoint::SERVER_PRE_SEND_MSG, context);
+  expected = {"r:0", "r:1"};
+  ASSERT_EQ(records, expected);
+}
+
+TEST(StaticFilterChainTest, Reject) {
+  records.clear();
+  auto chain = std::make_shared<Chain>("chain");
+  chain->GetStage<2>().reject_point = FilterPoint::SERVER_PRE_RPC_INVOKE;
+
+  ServerFilterController controller;
+  ASSERT_TRUE(controller.AddMessageServerFilter(chain));
+
+  auto context = MakeRefCounted<ServerContext>();
+  ASSERT_EQ(controller.RunMessageServerFilters(FilterPoint::SERVER_PRE_RPC_INVOKE, context), FilterStatus::REJECT);
+  // Post-points of the stages before the rejecting one are executed by chain.
+  std::vector<std::string> expected = {"a:2", "b:2", "a:3"};
+  ASSERT_EQ(records, expected);
+
+  // The post-point of chain is skipped by controller.
+  ASSERT_EQ(controller.RunMessageServerFilters(FilterPoint::SERVER_POST_RPC_INVOKE, context), FilterStatus::CONTINUE);
+  ASSERT_EQ(records, expected);
+}
+
+}  // namespace trpc::testing
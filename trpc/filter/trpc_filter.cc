@@ -18,6 +18,7 @@
 #include "trpc/client/make_client_context.h"
 #include "trpc/common/config/trpc_config.h"
 #include "trpc/filter/filter_manager.h"
+#include "trpc/filter/response_cache/response_cache_server_filter.h"
 #ifdef TRPC_BUILD_INCLUDE_PROMETHEUS
 #include "trpc/metrics/prometheus/prometheus_client_filter.h"
 #include "trpc/metrics/prometheus/prometheus_server_filter.h"
@@ -68,6 +69,7 @@ bool InitializeServerFilter() {
   FilterManager::GetInstance()->AddMessageServerFilter(flow_control_server_filter);
 #endif
 
+  FilterManager::GetInstance()->AddMessageServerFilter(std::make_shared<ResponseCacheServerFilter>());
 
 #ifdef TRPC_BUILD_INCLUDE_RPCZ
   FilterManager::GetInstance()->AddMessageServerFilter(std::make_shared<trpc::rpcz::RpczServerFilter>());
@@ -77,7 +79,8 @@ bool InitializeServerFilter() {
     if (!ptr) return;
 
     rpcz::ClientRouteRpczSpan client_route_rpcz_span;
-    client_route_rpcz_span.sample_flag = ptr->sample_flag;
+    // In tail sampling mode the parent span may be recycled before asynchronous sub calls finish, skip sub spans.
+    client_route_rpcz_span.sample_flag = ptr->sample_flag && !ptr->tail_sample;
     client_route_rpcz_span.parent_span = ptr->span;
     client_ctx->SetFilterData<rpcz::ClientRouteRpczSpan>(rpcz::kTrpcRouteRpczIndex, std::move(client_route_rpcz_span));
   });
@@ -13,11 +13,14 @@
 
 #pragma once
 
+#include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <functional>
 #include <iostream>
 #include <memory>
 #include <mutex>
+#include <new>
 #include <thread>
 #include <tuple>
 #include <utility>
@@ -27,6 +30,7 @@
 #include "trpc//future/function_traits.h"
 #include "trpc/runtime/iomodel/reactor/reactor.h"
 #include "trpc/util/function.h"
+#include "trpc/util/object_pool/object_pool.h"
 
 namespace trpc {
 
@@ -55,6 +59,11 @@ Future<T...> MakeExceptionFuture(const Exception& e) {
   return Future<T...>(e);
 }
 
+/// @brief Declaration of FutureImpl.
+/// @private
+template <typename... T>
+class FutureImpl;
+
 /// @brief Declaration of Continuation for variable parameters.
 /// @private
 template <typename... T>
@@ -84,32 +93,90 @@ static inline Executor* GetExecutor() {
                                          : static_cast<Executor*>(&kDefaultInlineExecutor);
 }
 
+/// @brief Continuation not larger than this is constructed inside future state instead of heap.
+/// @private
+constexpr std::size_t kInlineContinuationSize = 128;
+
+/// @brief Raw memory of FutureImpl. FutureImpl of any type is allocated from the object pool of the smallest storage
+///        which fits it, so only a few object pools are created no matter how many future types are used.
+/// @private
+template <std::size_t kSize>
+struct alignas(std::max_align_t) FutureImplStorage {
+  // User-provided to avoid zero filling when allocated.
+  FutureImplStorage() {}
+
+  unsigned char bytes[kSize];
+};
+
+/// @private
+template <std::size_t kSize>
+struct object_pool::ObjectPoolTraits<FutureImplStorage<kSize>> {
+#if defined(TRPC_DISABLED_OBJECTPOOL)
+  static constexpr auto kType = ObjectPoolType::kDisabled;
+#elif defined(TRPC_SHARED_NOTHING_OBJECTPOOL)
+  static constexpr auto kType = ObjectPoolType::kSharedNothing;
+#else
+  static constexpr auto kType = ObjectPoolType::kGlobal;
+#endif
+};
+
+/// @brief Allocate FutureImpl from object pool, fall back to heap if it is too large.
+/// @private
+template <typename Impl, typename... Args>
+Impl* NewFutureImpl(Args&&... args) {
+  static_assert(alignof(Impl) <= alignof(std::max_align_t), "Over aligned future value is not supported");
+  if constexpr (sizeof(Impl) <= 256) {
+    return new (object_pool::New<FutureImplStorage<256>>()) Impl(std::forward<Args>(args)...);
+  } else if constexpr (sizeof(Impl) <= 512) {
+    return new (object_pool::New<FutureImplStorage<512>>()) Impl(std::forward<Args>(args)...);
+  } else {
+    return new Impl(std::forward<Args>(args)...);
+  }
+}
+
+/// @brief Destruct FutureImpl allocated by NewFutureImpl and give its memory back.
+/// @private
+template <typename Impl>
+void DeleteFutureImpl(Impl* impl) {
+  if constexpr (sizeof(Impl) <= 256) {
+    impl->~Impl();
+    object_pool::Delete(new (impl) FutureImplStorage<256>);
+  } else if constexpr (sizeof(Impl) <= 512) {
+    impl->~Impl();
+    object_pool::Delete(new (impl) FutureImplStorage<512>);
+  } else {
+    delete impl;
+  }
+}
+
 /// @brief Inherited by FutureState to stand for state of FutureImpl.
+///        Result and callback are published by an atomic state machine instead of a lock: empty -> has callback or
+///        has result -> both. Whoever completes both schedules the callback, so it is scheduled exactly once.
 /// @private
 struct FutureStateBase {
+  // Callback set through Then.
+  static constexpr uint8_t kHasCallback = 1;
+
+  // Either ready or failed.
+  static constexpr uint8_t kHasResult = 2;
+
   // Future is ready or not.
   bool ready = false;
 
   // Future is failed or not.
   bool failed = false;
 
-  // Future is either ready or failed when true.
-  bool has_result = false;
-
-  // Is callback set through Then to this Future.
-  bool has_callback = false;
-
-  // Is callback already been scheduled, to control only once may callback be called.
-  std::atomic_flag schedule_flag = ATOMIC_FLAG_INIT;
+  // Combination of kHasCallback and kHasResult.
+  std::atomic<uint8_t> flags = 0;
 
   // Since FutureImpl may hold by Future and Promise, use ref to determin when to free FutureImpl.
   std::atomic<int> ref_count = 1;
 
-  // Synchronize ready/failed/has_result/has_callback between maybe two threads holding current state.
-  std::mutex mtx;
-
   // Store exception when Futuren failed.
   Exception exception;
+
+  // Storage of small continuation.
+  alignas(std::max_align_t) unsigned char inline_callback[kInlineContinuationSize];
 };
 
 /// @brief Variable parameters version of FutureState.
@@ -155,6 +222,9 @@ class ContinuationBase {
   /// @brief Bind executor to current continuation.
   inline void SetExecutor(Executor* executor) { executor_ = executor; }
 
+  /// @brief Release current continuation after it run.
+  virtual void Destroy() { delete this; }
+
   /// @brief Bind exception to current continuation.
   inline void SetException(Exception&& e) {
     failed_ = true;
@@ -169,13 +239,13 @@ class ContinuationBase {
     auto executor = executor_ ? executor_ : GetExecutor();
     bool ret = executor->SubmitTask([task]() mutable {
       task->Run();
-      delete task;
+      task->Destroy();
     });
 
     // Fall back to current thread.
     if (!ret) {
       task->Run();
-      delete task;
+      task->Destroy();
     }
   }
 
@@ -210,9 +280,29 @@ class Continuation : public ContinuationBase {
     value_ = std::move(value);
   }
 
+  /// @brief Mark current continuation constructed inside state of owner.
+  void SetOwner(FutureImpl<T...>* owner) noexcept { owner_ = owner; }
+
+  /// @brief Whether current continuation constructed inside state of owner.
+  bool IsInline() const noexcept { return owner_ != nullptr; }
+
+  /// @brief Inline continuation holds a reference of owner while scheduled, drop it after destructed.
+  void Destroy() override {
+    if (owner_ == nullptr) {
+      delete this;
+      return;
+    }
+    auto* owner = owner_;
+    this->~Continuation();
+    owner->Detach();
+  }
+
  protected:
   // Value type with tuple.
   std::tuple<T...> value_;
+
+  // FutureImpl holding current continuation inline, null if allocated on heap.
+  FutureImpl<T...>* owner_ = nullptr;
 };
 
 /// @brief Single parameter version of Continuation.
@@ -228,9 +318,29 @@ class Continuation<T> : public ContinuationBase {
     value_ = std::move(value);
   }
 
+  /// @brief Same as multiple version.
+  void SetOwner(FutureImpl<T>* owner) noexcept { owner_ = owner; }
+
+  /// @brief Same as multiple version.
+  bool IsInline() const noexcept { return owner_ != nullptr; }
+
+  /// @brief Same as multiple version.
+  void Destroy() override {
+    if (owner_ == nullptr) {
+      delete this;
+      return;
+    }
+    auto* owner = owner_;
+    this->~Continuation();
+    owner->Detach();
+  }
+
  protected:
   // Value type with Future template parameter, better performance.
   T value_;
+
+  // Same as multiple version.
+  FutureImpl<T>* owner_ = nullptr;
 };
 
 /// @brief Firstly, current future is of multiple parameters.
@@ -444,7 +554,9 @@ class FutureImplBase {
   inline bool IsFailed() const noexcept { return state_base_->failed; }
 
   /// @brief Either future is ready or failed.
-  inline bool HasResult() const noexcept { return state_base_->has_result; }
+  inline bool HasResult() const noexcept {
+    return state_base_->flags.load(std::memory_order_acquire) & FutureStateBase::kHasResult;
+  }
 
   /// @brief Wait for future ready or failed, return if timeout expired. It't deprecated.
   /// @note Do not call this inside framework threads or users threads, as it blocks everything.
@@ -452,7 +564,7 @@ class FutureImplBase {
     int64_t timeout_us = timeout * 1000;
     auto start = std::chrono::system_clock::now();
 
-    while (!state_base_->has_result) {
+    while (!HasResult()) {
       std::this_thread::sleep_for(std::chrono::microseconds(100));
       auto now = std::chrono::system_clock::now();
       auto diff = std::chrono::duration_cast<std::chrono::microseconds>(now - start);
@@ -474,6 +586,18 @@ class FutureImplBase {
   /// @brief Normally called by get pair future of promise, to avoid wild pointer.
   inline void Attach() noexcept { state_base_->ref_count.fetch_add(1, std::memory_order_relaxed); }
 
+  /// @brief Publish result, return true if callback was set before and should be scheduled by caller.
+  inline bool PublishResult() noexcept {
+    auto prev = state_base_->flags.fetch_or(FutureStateBase::kHasResult, std::memory_order_acq_rel);
+    return (prev & FutureStateBase::kHasCallback) && !(prev & FutureStateBase::kHasResult);
+  }
+
+  /// @brief Publish callback, return true if result was set before and callback should be scheduled by caller.
+  inline bool PublishCallback() noexcept {
+    auto prev = state_base_->flags.fetch_or(FutureStateBase::kHasCallback, std::memory_order_acq_rel);
+    return (prev & FutureStateBase::kHasResult) && !(prev & FutureStateBase::kHasCallback);
+  }
+
  private:
   FutureStateBase* state_base_ = nullptr;
 };
@@ -485,6 +609,7 @@ class FutureImpl : public FutureImplBase {
  public:
   friend class Promise<T...>;
   friend class Future<T...>;
+  friend class Continuation<T...>;
 
   FutureImpl() noexcept { FutureImplBase::Init(&state_); }
 
@@ -492,10 +617,19 @@ class FutureImpl : public FutureImplBase {
   explicit FutureImpl(std::tuple<T...>&& value) noexcept : state_(std::move(value)) {
     FutureImplBase::Init(&state_);
     state_.ready = true;
-    state_.has_result = true;
+    state_.flags.store(FutureStateBase::kHasResult, std::memory_order_relaxed);
   }
 
-  ~FutureImpl() noexcept = default;
+  /// @brief Callback never scheduled is released here.
+  ~FutureImpl() noexcept {
+    if (state_.callback) {
+      if (state_.callback->IsInline()) {
+        state_.callback->~Continuation();
+      } else {
+        delete state_.callback;
+      }
+    }
+  }
 
   /// @brief Make sure future is ready before calling.
   /// @note After calling, future is not ready any more.
@@ -522,16 +656,9 @@ class FutureImpl : public FutureImplBase {
   template <typename FutureType, typename PromiseType = typename FutureType::PromiseType,
             typename Func = Function<FutureType(T&&...)>>
   void SetCallback(PromiseType&& promise, Func&& func, Executor* executor) {
-    state_.callback = new ContinuationWithValue<Func, PromiseType, T...>(std::forward<Func>(func),
-                                                                         std::forward<PromiseType>(promise));
-    if (executor) state_.callback->SetExecutor(executor);
-    state_.has_callback = true;
-
-    std::lock_guard<std::mutex> lock(state_.mtx);
-    // Got immediately executed.
-    if (HasResult()) {
-      TrySchedule();
-    }
+    SetContinuation(NewContinuation<ContinuationWithValue<Func, PromiseType, T...>>(
+                        std::forward<Func>(func), std::forward<PromiseType>(promise)),
+                    executor);
   }
 
   /// @brief Callback registered through Then with parameters type by Value, and returned result typed by void.
@@ -541,15 +668,7 @@ class FutureImpl : public FutureImplBase {
   /// @param executor User specified executor, default to null.
   template <typename NotFutureType, typename Func = Function<NotFutureType(T&&...)>>
   void SetTerminalCallback(Func&& func, Executor* executor) {
-    state_.callback = new TerminalWithValue<Func, T...>(std::forward<Func>(func));
-    if (executor) state_.callback->SetExecutor(executor);
-    state_.has_callback = true;
-
-    std::lock_guard<std::mutex> lock(state_.mtx);
-    // Got immediately executed.
-    if (HasResult()) {
-      TrySchedule();
-    }
+    SetContinuation(NewContinuation<TerminalWithValue<Func, T...>>(std::forward<Func>(func)), executor);
   }
 
   /// @brief Callback registered through Then with parameters type by Future, and returned result typed by Future.
@@ -562,16 +681,9 @@ class FutureImpl : public FutureImplBase {
   template <typename FutureType, typename PromiseType = typename FutureType::PromiseType,
             typename Func = Function<FutureType(Future<T...>&&)>>
   void SetCallbackWrapped(PromiseType&& promise, Func&& func, Executor* executor) {
-    state_.callback = new ContinuationWithFuture<Func, PromiseType, T...>(std::forward<Func>(func),
-                                                                          std::forward<PromiseType>(promise));
-    if (executor) state_.callback->SetExecutor(executor);
-    state_.has_callback = true;
-
-    std::lock_guard<std::mutex> lock(state_.mtx);
-    // Got immediately executed.
-    if (HasResult()) {
-      TrySchedule();
-    }
+    SetContinuation(NewContinuation<ContinuationWithFuture<Func, PromiseType, T...>>(
+                        std::forward<Func>(func), std::forward<PromiseType>(promise)),
+                    executor);
   }
 
   /// @brief Callback registered through Then with parameters type by Future, and returned result typed by void.
@@ -581,69 +693,79 @@ class FutureImpl : public FutureImplBase {
   /// @param executor User specified executor, default to null.
   template <typename NotFutureType, typename Func = Function<NotFutureType(Future<T...>&&)>>
   void SetTerminalCallbackWrapped(Func&& func, Executor* executor) {
-    state_.callback = new TerminalWithFuture<Func, T...>(std::forward<Func>(func));
-    if (executor) state_.callback->SetExecutor(executor);
-    state_.has_callback = true;
-
-    std::lock_guard<std::mutex> lock(state_.mtx);
-    // Got immediately executed.
-    if (HasResult()) {
-      TrySchedule();
-    }
+    SetContinuation(NewContinuation<TerminalWithFuture<Func, T...>>(std::forward<Func>(func)), executor);
   }
 
   /// @brief Ready value set through promise.
   void SetValue(std::tuple<T...>&& value) {
     state_.value = std::move(value);
     state_.ready = true;
-    // Result state may be looped by another thread.
-    {
-      std::lock_guard<std::mutex> lock(state_.mtx);
-      state_.has_result = true;
+    // Callback may be set by another thread at the same time.
+    if (PublishResult()) {
+      ScheduleCallback();
     }
-    TrySchedule();
   }
 
   /// @brief Exceptional value set through promise.
   void SetException(const Exception& e) {
     state_.exception = e;
     state_.failed = true;
-    // Result state may be looped by another thread.
-    {
-      std::lock_guard<std::mutex> lock(state_.mtx);
-      state_.has_result = true;
+    if (PublishResult()) {
+      ScheduleCallback();
     }
-    TrySchedule();
   }
 
   /// @brief Support non const parameter.
   void SetException(Exception&& e) {
     state_.exception = std::move(e);
     state_.failed = true;
-    {
-      std::lock_guard<std::mutex> lock(state_.mtx);
-      state_.has_result = true;
+    if (PublishResult()) {
+      ScheduleCallback();
     }
-    TrySchedule();
   }
 
  private:
-  /// @brief Future may or may not registered callback yet, check to inspire callback.
-  /// @note Callback can only inspired once.
-  void TrySchedule() {
-    if (state_.has_callback) {
-      if (IsReady()) {
-        if (state_.schedule_flag.test_and_set() == false) {
-          state_.callback->SetValue(GetValue());
-          state_.callback->Schedule(state_.callback);
-        }
-      } else if (IsFailed()) {
-        if (state_.schedule_flag.test_and_set() == false) {
-          state_.callback->SetException(GetException());
-          state_.callback->Schedule(state_.callback);
-        }
-      }
+  /// @brief Construct continuation inside state if it is small enough, otherwise on heap.
+  template <typename ContinuationType, typename... Args>
+  Continuation<T...>* NewContinuation(Args&&... args) {
+    if constexpr (sizeof(ContinuationType) <= kInlineContinuationSize &&
+                  alignof(ContinuationType) <= alignof(std::max_align_t)) {
+      auto* callback = new (state_.inline_callback) ContinuationType(std::forward<Args>(args)...);
+      callback->SetOwner(this);
+      return callback;
+    } else {
+      return new ContinuationType(std::forward<Args>(args)...);
+    }
+  }
+
+  /// @brief Set callback and schedule it if result is already set.
+  void SetContinuation(Continuation<T...>* callback, Executor* executor) {
+    if (executor) callback->SetExecutor(executor);
+    state_.callback = callback;
+    // Got immediately executed.
+    if (PublishCallback()) {
+      ScheduleCallback();
+    }
+  }
+
+  /// @brief Called exactly once after both callback and result are set.
+  void ScheduleCallback() {
+    auto* callback = state_.callback;
+    if (IsReady()) {
+      callback->SetValue(GetValue());
+    } else if (IsFailed()) {
+      callback->SetException(GetException());
+    } else {
+      // Result already taken away, callback is released with current future.
+      return;
     }
+
+    state_.callback = nullptr;
+    // Inline callback lives inside current state, keep state alive until it destroyed.
+    if (callback->IsInline()) {
+      Attach();
+    }
+    callback->Schedule(callback);
   }
 
   /// @brief Protected from wild pointer.
@@ -651,7 +773,7 @@ class FutureImpl : public FutureImplBase {
     auto a = state_.ref_count.fetch_sub(1, std::memory_order_acq_rel);
     assert(a >= 1);
     if (a == 1) {
-      delete this;
+      DeleteFutureImpl(this);
     }
   }
 
@@ -666,6 +788,7 @@ class FutureImpl<T> : public FutureImplBase {
  public:
   friend class Promise<T>;
   friend class Future<T>;
+  friend class Continuation<T>;
 
   FutureImpl() noexcept { FutureImplBase::Init(&state_); }
 
@@ -673,10 +796,19 @@ class FutureImpl<T> : public FutureImplBase {
   explicit FutureImpl(T&& value) noexcept : state_(std::move(value)) {
     FutureImplBase::Init(&state_);
     state_.ready = true;
-    state_.has_result = true;
+    state_.flags.store(FutureStateBase::kHasResult, std::memory_order_relaxed);
   }
 
-  ~FutureImpl() noexcept = default;
+  /// @brief Same as multiple version.
+  ~FutureImpl() noexcept {
+    if (state_.callback) {
+      if (state_.callback->IsInline()) {
+        state_.callback->~Continuation();
+      } else {
+        delete state_.callback;
+      }
+    }
+  }
 
   /// @brief Same as multiple version.
   T&& GetValue() noexcept {
@@ -695,115 +827,106 @@ class FutureImpl<T> : public FutureImplBase {
   template <typename FutureType, typename PromiseType = typename FutureType::PromiseType,
             typename Func = Function<FutureType(T&&)>>
   void SetCallback(PromiseType&& promise, Func&& func, Executor* executor) {
-    state_.callback =
-        new ContinuationWithValue<Func, PromiseType, T>(std::forward<Func>(func), std::forward<PromiseType>(promise));
-    if (executor) state_.callback->SetExecutor(executor);
-    state_.has_callback = true;
-
-    std::lock_guard<std::mutex> lock(state_.mtx);
-    if (HasResult()) {
-      TrySchedule();
-    }
+    SetContinuation(NewContinuation<ContinuationWithValue<Func, PromiseType, T>>(std::forward<Func>(func),
+                                                                                 std::forward<PromiseType>(promise)),
+                    executor);
   }
 
   /// @brief Same as multiple version.
   template <typename FutureType, typename Func = Function<FutureType(T&&)>>
   void SetTerminalCallback(Func&& func, Executor* executor) {
-    state_.callback = new TerminalWithValue<Func, T>(std::forward<Func>(func));
-    if (executor) state_.callback->SetExecutor(executor);
-    state_.has_callback = true;
-
-    std::lock_guard<std::mutex> lock(state_.mtx);
-    if (HasResult()) {
-      TrySchedule();
-    }
+    SetContinuation(NewContinuation<TerminalWithValue<Func, T>>(std::forward<Func>(func)), executor);
   }
 
   /// @brief Same as multiple version.
   template <typename FutureType, typename PromiseType = typename FutureType::PromiseType,
             typename Func = Function<FutureType(Future<T>&&)>>
   void SetCallbackWrapped(PromiseType&& promise, Func&& func, Executor* executor) {
-    state_.callback =
-        new ContinuationWithFuture<Func, PromiseType, T>(std::forward<Func>(func), std::forward<PromiseType>(promise));
-    if (executor) state_.callback->SetExecutor(executor);
-    state_.has_callback = true;
-
-    std::lock_guard<std::mutex> lock(state_.mtx);
-    if (HasResult()) {
-      TrySchedule();
-    }
+    SetContinuation(NewContinuation<ContinuationWithFuture<Func, PromiseType, T>>(std::forward<Func>(func),
+                                                                                  std::forward<PromiseType>(promise)),
+                    executor);
   }
 
   /// @brief Same as multiple version.
   template <typename FutureType, typename Func = Function<FutureType(Future<T>&&)>>
   void SetTerminalCallbackWrapped(Func&& func, Executor* executor) {
-    state_.callback = new TerminalWithFuture<Func, T>(std::forward<Func>(func));
-    if (executor) state_.callback->SetExecutor(executor);
-    state_.has_callback = true;
-
-    std::lock_guard<std::mutex> lock(state_.mtx);
-    if (HasResult()) {
-      TrySchedule();
-    }
+    SetContinuation(NewContinuation<TerminalWithFuture<Func, T>>(std::forward<Func>(func)), executor);
   }
 
   /// @brief Same as multiple version.
   void SetValue(T&& value) {
     state_.value = std::move(value);
     state_.ready = true;
-    {
-      std::lock_guard<std::mutex> lock(state_.mtx);
-      state_.has_result = true;
+    if (PublishResult()) {
+      ScheduleCallback();
     }
-    TrySchedule();
   }
 
   /// @brief Same as multiple version.
   void SetException(const Exception& e) {
     state_.exception = e;
     state_.failed = true;
-    {
-      std::lock_guard<std::mutex> lock(state_.mtx);
-      state_.has_result = true;
+    if (PublishResult()) {
+      ScheduleCallback();
     }
-    TrySchedule();
   }
 
   /// @brief Same as multiple version.
   void SetException(Exception&& e) {
     state_.exception = std::move(e);
     state_.failed = true;
-    {
-      std::lock_guard<std::mutex> lock(state_.mtx);
-      state_.has_result = true;
+    if (PublishResult()) {
+      ScheduleCallback();
     }
-    TrySchedule();
   }
 
  private:
   /// @brief Same as multiple version.
-  void TrySchedule() {
-    if (state_.has_callback) {
-      if (IsReady()) {
-        if (state_.schedule_flag.test_and_set() == false) {
-          state_.callback->SetValue(GetValue());
-          state_.callback->Schedule(state_.callback);
-        }
-      } else if (IsFailed()) {
-        if (state_.schedule_flag.test_and_set() == false) {
-          state_.callback->SetException(GetException());
-          state_.callback->Schedule(state_.callback);
-        }
-      }
+  template <typename ContinuationType, typename... Args>
+  Continuation<T>* NewContinuation(Args&&... args) {
+    if constexpr (sizeof(ContinuationType) <= kInlineContinuationSize &&
+                  alignof(ContinuationType) <= alignof(std::max_align_t)) {
+      auto* callback = new (state_.inline_callback) ContinuationType(std::forward<Args>(args)...);
+      callback->SetOwner(this);
+      return callback;
+    } else {
+      return new ContinuationType(std::forward<Args>(args)...);
     }
   }
 
+  /// @brief Same as multiple version.
+  void SetContinuation(Continuation<T>* callback, Executor* executor) {
+    if (executor) callback->SetExecutor(executor);
+    state_.callback = callback;
+    if (PublishCallback()) {
+      ScheduleCallback();
+    }
+  }
+
+  /// @brief Same as multiple version.
+  void ScheduleCallback() {
+    auto* callback = state_.callback;
+    if (IsReady()) {
+      callback->SetValue(GetValue());
+    } else if (IsFailed()) {
+      callback->SetException(GetException());
+    } else {
+      return;
+    }
+
+    state_.callback = nullptr;
+    if (callback->IsInline()) {
+      Attach();
+    }
+    callback->Schedule(callback);
+  }
+
   /// @brief Same as multiple version.
   inline void Detach() noexcept {
     auto a = state_.ref_count.fetch_sub(1, std::memory_order_acq_rel);
     assert(a >= 1);
     if (a == 1) {
-      delete this;
+      DeleteFutureImpl(this);
     }
   }
 
@@ -863,12 +986,12 @@ class Future {
 
   /// @brief Used by MakeReadyFuture.
   explicit Future(MakeReadyFutureHelper no_sense, T&&... v) noexcept {
-    future_ = new FutureImpl<T...>(std::make_tuple<T...>(std::move(v)...));
+    future_ = NewFutureImpl<FutureImpl<T...>>(std::make_tuple<T...>(std::move(v)...));
   }
 
   /// @brief Used by MakeExceptionFuture.
   explicit Future(const Exception& e) noexcept {
-    future_ = new FutureImpl<T...>();
+    future_ = NewFutureImpl<FutureImpl<T...>>();
     future_->SetException(e);
   }
 
@@ -1028,11 +1151,13 @@ class Future<T> {
   }
 
   /// @brief Used by MakeReadyFuture.
-  explicit Future(MakeReadyFutureHelper no_sense, T&& v) noexcept { future_ = new FutureImpl<T>(std::move(v)); }
+  explicit Future(MakeReadyFutureHelper no_sense, T&& v) noexcept {
+    future_ = NewFutureImpl<FutureImpl<T>>(std::move(v));
+  }
 
   /// @brief Used by MakeExceptionFuture.
   explicit Future(const Exception& e) noexcept {
-    future_ = new FutureImpl<T>();
+    future_ = NewFutureImpl<FutureImpl<T>>();
     future_->SetException(e);
   }
 
@@ -1181,7 +1306,7 @@ class Promise {
   /// @private
   using FutureType = Future<T...>;
 
-  Promise() noexcept : retrieved_(false) { future_ = new FutureImpl<T...>(); }
+  Promise() noexcept : retrieved_(false) { future_ = NewFutureImpl<FutureImpl<T...>>(); }
 
   Promise(Promise&& o) noexcept
       : retrieved_(std::exchange(o.retrieved_, false)), future_(std::exchange(o.future_, nullptr)) {}
@@ -1261,7 +1386,7 @@ class Promise<T> {
  public:
   using FutureType = Future<T>;
 
-  Promise() noexcept : retrieved_(false) { future_ = new FutureImpl<T>(); }
+  Promise() noexcept : retrieved_(false) { future_ = NewFutureImpl<FutureImpl<T>>(); }
 
   Promise(Promise&& o) noexcept : retrieved_(std::exchange(o.retrieved_, false)),
                                   future_(std::exchange(o.future_, nullptr)) {}
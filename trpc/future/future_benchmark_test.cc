@@ -0,0 +1,98 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include <chrono>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "trpc/future/future.h"
+#include "trpc/future/future_utility.h"
+
+// Microbenchmark of future, results are printed rather than asserted, as they depend on machine.
+namespace trpc::testing {
+
+namespace {
+
+constexpr int kFutureNum = 1000;
+constexpr int kRounds = 200;
+
+template <typename F>
+double NanosecondsPerOp(F&& func, int ops_per_round) {
+  // Warm up object pool.
+  func();
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kRounds; ++i) {
+    func();
+  }
+  auto cost = std::chrono::steady_clock::now() - start;
+  return std::chrono::duration<double, std::nano>(cost).count() / kRounds / ops_per_round;
+}
+
+}  // namespace
+
+// Chain 1k Then to one promise, then resolve it.
+TEST(FutureBenchmark, ChainedThen) {
+  double ns = NanosecondsPerOp(
+      [] {
+        Promise<int> pr;
+        auto fut = pr.GetFuture();
+        for (int i = 0; i < kFutureNum; ++i) {
+          fut = fut.Then([](int&& val) { return MakeReadyFuture<int>(val + 1); });
+        }
+        pr.SetValue(0);
+        ASSERT_TRUE(fut.IsReady());
+        ASSERT_EQ(fut.GetValue0(), kFutureNum);
+      },
+      kFutureNum);
+  std::cout << "chained Then: " << ns << " ns/link" << std::endl;
+}
+
+// Chain 1k Then to a ready future, each callback runs immediately.
+TEST(FutureBenchmark, ReadyThen) {
+  double ns = NanosecondsPerOp(
+      [] {
+        auto fut = MakeReadyFuture<int>(0);
+        for (int i = 0; i < kFutureNum; ++i) {
+          fut = fut.Then([](int&& val) { return MakeReadyFuture<int>(val + 1); });
+        }
+        ASSERT_EQ(fut.GetValue0(), kFutureNum);
+      },
+      kFutureNum);
+  std::cout << "ready Then: " << ns << " ns/link" << std::endl;
+}
+
+// Fan out 1k promises and join them by WhenAll.
+TEST(FutureBenchmark, FanOutWhenAll) {
+  double ns = NanosecondsPerOp(
+      [] {
+        std::vector<Promise<int>> prs(kFutureNum);
+        std::vector<Future<int>> futs;
+        futs.reserve(kFutureNum);
+        for (auto& pr : prs) {
+          futs.emplace_back(pr.GetFuture());
+        }
+        auto all = WhenAll(futs.begin(), futs.end());
+        for (int i = 0; i < kFutureNum; ++i) {
+          prs[i].SetValue(std::move(i));
+        }
+        ASSERT_TRUE(all.IsReady());
+        ASSERT_EQ(all.GetValue0().size(), kFutureNum);
+      },
+      kFutureNum);
+  std::cout << "fan-out WhenAll: " << ns << " ns/future" << std::endl;
+}
+
+}  // namespace trpc::testing
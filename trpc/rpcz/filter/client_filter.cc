@@ -26,6 +26,7 @@ namespace trpc::rpcz {
 
 RpczClientFilter::RpczClientFilter() : customer_func_set_flag_(false) {
   high_low_water_level_sampler_.Init();
+  tail_sampler_.Init();
 
   ClientFilterPointHandleFunction pre_rpc_handle =
       std::bind(&RpczClientFilter::PreRpcHandle, this, std::placeholders::_1);
@@ -110,9 +111,12 @@ void RpczClientFilter::PreRpcHandle(const trpc::ClientContextPtr& context) {
   // Pure client scenario.
   ClientRpczSpan client_rpcz_span;
   uint32_t span_id = SpanIdGenerator::GetInstance()->GenerateId();
-  client_rpcz_span.sample_flag = ShouldSample(context, span_id);
+  // In tail sampling mode, every request records its span and the decision is made in PostRpcHandle.
+  client_rpcz_span.tail_sample = !customer_func_set_flag_ && tail_sampler_.Enabled();
+  client_rpcz_span.sample_flag = client_rpcz_span.tail_sample || ShouldSample(context, span_id);
   if (client_rpcz_span.sample_flag) {
-    Span* span_ptr = trpc::rpcz::CreateClientRpczSpan(context, span_id);
+    // String info is filled only when span committed, so that recycling a span involves no memory allocation.
+    Span* span_ptr = trpc::rpcz::CreateClientRpczSpan(context, span_id, !client_rpcz_span.tail_sample);
     client_rpcz_span.span = span_ptr;
   } else {
     client_rpcz_span.span = nullptr;
@@ -140,6 +144,9 @@ void RpczClientFilter::PreSendHandle(const trpc::ClientContextPtr& context) {
   auto* client_rpcz_span_ptr = context->GetFilterData<ClientRpczSpan>(kTrpcClientRpczIndex);
   if (client_rpcz_span_ptr && client_rpcz_span_ptr->sample_flag && client_rpcz_span_ptr->span != nullptr) {
     client_rpcz_span_ptr->span->SetStartTransInvokeRealUs(trpc::GetSystemMicroSeconds());
+    if (client_rpcz_span_ptr->tail_sample) {
+      return;
+    }
 
     std::string ip_port;
     ip_port.append(context->GetIp());
@@ -277,6 +284,21 @@ void RpczClientFilter::PostRpcHandle(const trpc::ClientContextPtr& context) {
     client_rpcz_span_ptr->span->SetErrorCode(context->GetStatus().GetFrameworkRetCode());
     client_rpcz_span_ptr->span->SetResponseSize(context->GetResponseLength());
     client_rpcz_span_ptr->span->SetLastLogRealUs(now_us);
+    if (client_rpcz_span_ptr->tail_sample) {
+      Span* span = client_rpcz_span_ptr->span;
+      uint64_t cost_us = span->RpcInvokeDoneRealUs() - span->StartRpcInvokeRealUs();
+      if (!tail_sampler_.Sample(span->SpanId(), cost_us, span->ErrorCode())) {
+        RecycleRpczSpan(span);
+        client_rpcz_span_ptr->span = nullptr;
+        return;
+      }
+      FillClientRpczSpanInfo(context, span);
+      std::string ip_port;
+      ip_port.append(context->GetIp());
+      ip_port.append(":");
+      ip_port.append(trpc::util::Convert<std::string, int>(context->GetPort()));
+      span->SetRemoteSide(ip_port);
+    }
     RpczCollector::GetInstance()->Submit(client_rpcz_span_ptr->span);
   }
 }
@@ -65,7 +65,12 @@ class SpanIdGenerator {
 /// @private
 struct ServerRpczSpan {
   bool sample_flag{false};
+  // Whether to decide committing span or not after the call finishes.
+  bool tail_sample{false};
   Span* span;
+  // Tail sampling span not yet committed or dropped, allocated in request arena so that it is recycled along with
+  // the request even if no response is sent, e.g. oneway calls or requests rejected by overload.
+  Span** pending{nullptr};
 };
 
 /// @brief For route scenario.
@@ -81,6 +86,8 @@ struct ClientRouteRpczSpan {
 /// @private
 struct ClientRpczSpan {
   bool sample_flag{false};
+  // Whether to decide committing span or not after the call finishes.
+  bool tail_sample{false};
   Span* span;
 };
 
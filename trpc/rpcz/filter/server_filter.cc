@@ -27,6 +27,7 @@ namespace trpc::rpcz {
 
 RpczServerFilter::RpczServerFilter() : customer_func_set_flag_(false) {
   high_low_water_level_sampler_.Init();
+  tail_sampler_.Init();
 
   ServerFilterPointHandleFunction pre_sched_recv_handle =
       std::bind(&RpczServerFilter::PreSchedRecvHandle, this, std::placeholders::_1);
@@ -78,14 +79,29 @@ bool RpczServerFilter::ShouldSample(const trpc::ServerContextPtr& context, uint3
 void RpczServerFilter::PreSchedRecvHandle(const trpc::ServerContextPtr& context) {
   ServerRpczSpan svr_rpcz_span;
   uint32_t span_id = SpanIdGenerator::GetInstance()->GenerateId();
-  svr_rpcz_span.sample_flag = ShouldSample(context, span_id);
+  // In tail sampling mode, every request records its span and the decision is made in PostIoSendHandle.
+  svr_rpcz_span.tail_sample = !customer_func_set_flag_ && tail_sampler_.Enabled();
+  svr_rpcz_span.sample_flag = svr_rpcz_span.tail_sample || ShouldSample(context, span_id);
 
   if (svr_rpcz_span.sample_flag) {
     // convert timestamp from steady_clock to timestamp from system_clock
     uint64_t epoch_timestamp =
         trpc::time::GetSystemMicroSeconds() - (trpc::time::GetSteadyMicroSeconds() - context->GetRecvTimestampUs());
-    Span* span_ptr = trpc::rpcz::CreateServerRpczSpan(context, span_id, epoch_timestamp);
+    // String info is filled only when span committed, so that recycling a span involves no memory allocation.
+    Span* span_ptr = trpc::rpcz::CreateServerRpczSpan(context, span_id, epoch_timestamp, !svr_rpcz_span.tail_sample);
     svr_rpcz_span.span = span_ptr;
+    if (svr_rpcz_span.tail_sample) {
+      // Arena is released after the context, by then the span is not referenced by the request any more.
+      auto& arena = context->GetArena();
+      svr_rpcz_span.pending = arena.New<Span*>(span_ptr);
+      arena.AddCleanup(
+          [](void* pending) {
+            if (Span* span = *static_cast<Span**>(pending); span != nullptr) {
+              RecycleRpczSpan(span);
+            }
+          },
+          svr_rpcz_span.pending);
+    }
   } else {
     svr_rpcz_span.span = nullptr;
   }
@@ -145,6 +161,17 @@ void RpczServerFilter::PostIoSendHandle(const trpc::ServerContextPtr& context) {
     auto now_us = trpc::GetSystemMicroSeconds();
     ptr->span->SetSendDoneRealUs(now_us);
     ptr->span->SetLastLogRealUs(now_us);
+    if (ptr->tail_sample) {
+      // From now on the span is either recycled or owned by collector.
+      *ptr->pending = nullptr;
+      uint64_t cost_us = ptr->span->SendDoneRealUs() - ptr->span->ReceivedRealUs();
+      if (!tail_sampler_.Sample(ptr->span->SpanId(), cost_us, ptr->span->ErrorCode())) {
+        RecycleRpczSpan(ptr->span);
+        ptr->span = nullptr;
+        return;
+      }
+      FillServerRpczSpanInfo(context, ptr->span);
+    }
     RpczCollector::GetInstance()->Submit(ptr->span);
   }
 }
@@ -114,6 +114,8 @@ class RpczServerFilter : public trpc::MessageServerFilter {
   CustomerServerRpczSampleFunction customer_rpcz_sample_function_;
   //  Framework default sampler.
   HighLowWaterLevelSampler high_low_water_level_sampler_;
+  // Sampler to decide after the call finishes, only works when user-defined function not set.
+  TailSampler tail_sampler_;
   // All the handle functions to run in filter points.
   std::map<trpc::FilterPoint, ServerFilterPointHandleFunction> point_handles_;
 };
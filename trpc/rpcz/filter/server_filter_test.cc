@@ -163,5 +163,41 @@ TEST_F(RpczServerFilterTest, SamplePointTestWithSampleSucc) {
   ASSERT_GT(ptr->span->SendDoneRealUs(), 0);
 }
 
+/// @brief Test that span of tail sampling mode is released along with the request.
+TEST_F(RpczServerFilterTest, TailSampleSpanOwnedByRequest) {
+  auto& rpcz_config = TrpcConfig::GetInstance()->GetMutableGlobalConfig().rpcz_config;
+  rpcz_config.enable_tail_sample = true;
+  trpc::rpcz::RpczServerFilter tail_filter;
+  rpcz_config.enable_tail_sample = false;
+
+  // Request ends without sending response, e.g. oneway call or rejected by overload.
+  {
+    trpc::ServerContextPtr context;
+    InitServerContext(context);
+
+    FilterStatus status = FilterStatus::CONTINUE;
+    tail_filter(status, trpc::FilterPoint::SERVER_PRE_SCHED_RECV_MSG, context);
+    auto* ptr = context->GetFilterData<trpc::rpcz::ServerRpczSpan>(trpc::rpcz::kTrpcServerRpczIndex);
+    ASSERT_NE(ptr, nullptr);
+    ASSERT_TRUE(ptr->tail_sample);
+    ASSERT_NE(ptr->span, nullptr);
+    ASSERT_NE(ptr->pending, nullptr);
+    ASSERT_EQ(*ptr->pending, ptr->span);
+  }
+
+  // Span is handed over once response sent.
+  {
+    trpc::ServerContextPtr context;
+    InitServerContext(context);
+
+    FilterStatus status = FilterStatus::CONTINUE;
+    tail_filter(status, trpc::FilterPoint::SERVER_PRE_SCHED_RECV_MSG, context);
+    tail_filter(status, trpc::FilterPoint::SERVER_POST_IO_SEND_MSG, context);
+    auto* ptr = context->GetFilterData<trpc::rpcz::ServerRpczSpan>(trpc::rpcz::kTrpcServerRpczIndex);
+    ASSERT_NE(ptr, nullptr);
+    ASSERT_EQ(*ptr->pending, nullptr);
+  }
+}
+
 }  // namespace trpc::testing
 #endif
@@ -45,7 +45,8 @@ std::string FormatFuncNameIfPossible(const std::string& func_name) {
 
 Span* CreateServerRpczSpan(const trpc::ServerContextPtr& context,
                            uint32_t req_seq_id,
-                           const uint64_t recv_timestamp_us) {
+                           const uint64_t recv_timestamp_us,
+                           bool fill_info) {
   Span* span_ptr = trpc::object_pool::New<Span>();
   if (!span_ptr) {
     TRPC_FMT_ERROR("create span failed");
@@ -56,26 +57,31 @@ Span* CreateServerRpczSpan(const trpc::ServerContextPtr& context,
   span_ptr->SetSpanId(req_seq_id);
   span_ptr->SetReceivedRealUs(recv_timestamp_us);
   span_ptr->SetCallType(static_cast<uint32_t>(context->GetCallType()));
-
-  std::string ip_port;
-  ip_port.append(context->GetIp());
-  ip_port.append(":");
-  ip_port.append(trpc::util::Convert<std::string, int>(context->GetPort()));
-  span_ptr->SetRemoteSide(ip_port);
-
-  span_ptr->SetProtocolName(context->GetCodecName());
   span_ptr->SetRequestSize(context->GetRequestLength());
   span_ptr->SetSpanType(SpanType::kSpanTypeServer);
   uint64_t now_us = trpc::GetSystemMicroSeconds();
   span_ptr->SetFirstLogRealUs(recv_timestamp_us);
   span_ptr->SetStartHandleRealUs(now_us);
-  span_ptr->SetFullMethodName(FormatFuncNameIfPossible(context->GetFuncName()));
 
-  span_ptr->SetRemoteName(context->GetCallerName());
+  if (fill_info) {
+    FillServerRpczSpanInfo(context, span_ptr);
+  }
   return span_ptr;
 }
 
-Span* CreateClientRpczSpan(const trpc::ClientContextPtr& context, uint32_t req_seq_id) {
+void FillServerRpczSpanInfo(const trpc::ServerContextPtr& context, Span* span) {
+  std::string ip_port;
+  ip_port.append(context->GetIp());
+  ip_port.append(":");
+  ip_port.append(trpc::util::Convert<std::string, int>(context->GetPort()));
+  span->SetRemoteSide(ip_port);
+
+  span->SetProtocolName(context->GetCodecName());
+  span->SetFullMethodName(FormatFuncNameIfPossible(context->GetFuncName()));
+  span->SetRemoteName(context->GetCallerName());
+}
+
+Span* CreateClientRpczSpan(const trpc::ClientContextPtr& context, uint32_t req_seq_id, bool fill_info) {
   Span* span_ptr = trpc::object_pool::New<Span>();
   if (!span_ptr) {
     TRPC_FMT_ERROR("create span failed");
@@ -84,17 +90,31 @@ Span* CreateClientRpczSpan(const trpc::ClientContextPtr& context, uint32_t req_s
   span_ptr->SetTraceId(0);
   span_ptr->SetSpanId(req_seq_id);
   span_ptr->SetCallType(static_cast<uint32_t>(context->GetCallType()));
-  span_ptr->SetProtocolName(context->GetCodecName());
 
   span_ptr->SetSpanType(SpanType::kSpanTypeClient);
   uint64_t now_us = trpc::GetSystemMicroSeconds();
   span_ptr->SetFirstLogRealUs(now_us);
   span_ptr->SetStartRpcInvokeRealUs(now_us);
-  span_ptr->SetFullMethodName(FormatFuncNameIfPossible(context->GetFuncName()));
-  span_ptr->SetRemoteName(context->GetCalleeName());
+
+  if (fill_info) {
+    FillClientRpczSpanInfo(context, span_ptr);
+  }
   return span_ptr;
 }
 
+void FillClientRpczSpanInfo(const trpc::ClientContextPtr& context, Span* span) {
+  span->SetProtocolName(context->GetCodecName());
+  span->SetFullMethodName(FormatFuncNameIfPossible(context->GetFuncName()));
+  span->SetRemoteName(context->GetCalleeName());
+}
+
+void RecycleRpczSpan(Span* span) {
+  for (auto* sub_span : span->SubSpans()) {
+    RecycleRpczSpan(sub_span);
+  }
+  trpc::object_pool::Delete(span);
+}
+
 Span* CreateUserRpczSpan(const std::string& viewer_name) {
   Span* span_ptr = trpc::object_pool::New<Span>(viewer_name);
   if (!span_ptr) {
@@ -31,17 +31,33 @@ namespace trpc::rpcz {
 /// @param context Server context.
 /// @param req_seq_id Unique id for this span.
 /// @param recv_timestamp_us Timestamp recv this request.
+/// @param fill_info Whether to fill string info such as remote side and method name, tail sampling mode defers it
+///                  to FillServerRpczSpanInfo after the span is decided to be committed.
 /// @return Span ptr.
 /// @private
 Span* CreateServerRpczSpan(const trpc::ServerContextPtr& context, uint32_t req_seq_id,
-                                                    const uint64_t recv_timestamp_us);
+                                                    const uint64_t recv_timestamp_us, bool fill_info = true);
+
+/// @brief Fill string info of server span, such as remote side, protocol and method name.
+/// @private
+void FillServerRpczSpanInfo(const trpc::ServerContextPtr& context, Span* span);
 
 /// @brief Create a new client span object in first filter point and fill basic info.
 /// @param context Client context.
 /// @param req_seq_id Unique id for this span.
+/// @param fill_info Whether to fill string info such as protocol and method name, tail sampling mode defers it
+///                  to FillClientRpczSpanInfo after the span is decided to be committed.
 /// @return Span ptr.
 /// @private
-Span* CreateClientRpczSpan(const trpc::ClientContextPtr& context, uint32_t req_seq_id);
+Span* CreateClientRpczSpan(const trpc::ClientContextPtr& context, uint32_t req_seq_id, bool fill_info = true);
+
+/// @brief Fill string info of client span, such as remote side, protocol and method name.
+/// @private
+void FillClientRpczSpanInfo(const trpc::ClientContextPtr& context, Span* span);
+
+/// @brief Give span and all its sub spans back to object pool, used for spans not committed to collector.
+/// @private
+void RecycleRpczSpan(Span* span);
 
 /// @brief For the kSpanTypeUser type of span object, users are provided with the ability to
 ///        create a root span object without context.
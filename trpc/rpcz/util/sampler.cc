@@ -22,11 +22,23 @@
 
 namespace trpc::rpcz {
 
-void HighLowWaterLevelSampler::Init() {
-  sampling_rate_ = trpc::TrpcConfig::GetInstance()->GetGlobalConfig().rpcz_config.sample_rate;
-  speed_min_rate_ = trpc::TrpcConfig::GetInstance()->GetGlobalConfig().rpcz_config.lower_water_level;
-  speed_max_rate_ = trpc::TrpcConfig::GetInstance()->GetGlobalConfig().rpcz_config.high_water_level;
+void HighLowWaterLevelSampler::Init() { Init(trpc::TrpcConfig::GetInstance()->GetGlobalConfig().rpcz_config); }
+
+void HighLowWaterLevelSampler::Init(const RpczConfig& config) {
+  sampling_rate_ = config.sample_rate;
+  speed_min_rate_ = config.lower_water_level;
+  speed_max_rate_ = config.high_water_level;
+  sample_rate_limiter_.Init();
+}
+
+void TailSampler::Init() { Init(trpc::TrpcConfig::GetInstance()->GetGlobalConfig().rpcz_config); }
+
+void TailSampler::Init(const RpczConfig& config) {
+  enabled_ = config.enable_tail_sample;
+  latency_threshold_us_ = static_cast<uint64_t>(config.tail_sample_latency_ms) * 1000;
+  speed_max_rate_ = config.high_water_level;
   sample_rate_limiter_.Init();
+  base_sampler_.Init(config);
 }
 
 void SampleRateLimiter::Init() {
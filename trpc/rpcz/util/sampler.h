@@ -18,6 +18,8 @@
 #include <memory>
 #include <string>
 
+#include "trpc/common/config/global_conf.h"
+
 namespace trpc::rpcz {
 
 /// @brief To limit sampling rate, window size is 1s.
@@ -72,9 +74,12 @@ class HighLowWaterLevelSampler {
   /// @brief Default destructor.
   ~HighLowWaterLevelSampler() = default;
 
-  /// @brief Init sampler.
+  /// @brief Init sampler from global rpcz config.
   void Init();
 
+  /// @brief Init sampler from specified rpcz config.
+  void Init(const RpczConfig& config);
+
   /// @brief Get sampler name.
   std::string GetName() const { return "HighLowWaterLevelSampler"; }
 
@@ -119,5 +124,48 @@ class HighLowWaterLevelSampler {
   SampleRateLimiter sample_rate_limiter_;
 };
 
+/// @brief Sampler of tail sampling mode, which decides after the call finishes:
+///        Calls slower than latency threshold or failed are kept until window count reaches high water.
+///        Other calls fall back to high low water level sampling.
+/// @private
+class TailSampler {
+ public:
+  /// @brief Init sampler from global rpcz config.
+  void Init();
+
+  /// @brief Init sampler from specified rpcz config.
+  void Init(const RpczConfig& config);
+
+  /// @brief Get sampler name.
+  std::string GetName() const { return "TailSampler"; }
+
+  /// @brief Whether tail sampling mode is enabled.
+  bool Enabled() const { return enabled_; }
+
+  /// @brief Determine whether to commit the span of a finished call or not.
+  /// @param id Span id.
+  /// @param cost_us Time cost of the call in microseconds.
+  /// @param error_code Framework error code of the call.
+  /// @return True, should committed, false, should recycled.
+  bool Sample(uint32_t id, uint64_t cost_us, int error_code) {
+    if (cost_us >= latency_threshold_us_ || error_code != 0) {
+      return sample_rate_limiter_.Increase() <= speed_max_rate_;
+    }
+    return base_sampler_.Sample(id);
+  }
+
+ private:
+  // Whether tail sampling mode is enabled.
+  bool enabled_{false};
+  // Calls cost more than this are always interesting.
+  uint64_t latency_threshold_us_{0};
+  // High water of slow or failed calls.
+  uint32_t speed_max_rate_{0};
+  // Limiter of slow or failed calls by window.
+  SampleRateLimiter sample_rate_limiter_;
+  // Sampler of normal calls.
+  HighLowWaterLevelSampler base_sampler_;
+};
+
 }  // trpc::rpcz
 #endif
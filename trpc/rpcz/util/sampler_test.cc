@@ -79,5 +79,32 @@ TEST_F(TestHighLowWaterLevelSampler, IncreaseAndGetSampleNum) {
   ASSERT_EQ(sampler.GetSampleNum(), 2);
 }
 
+/// @brief Test for TailSampler.
+TEST_F(TestHighLowWaterLevelSampler, TailSample) {
+  trpc::rpcz::TailSampler sampler;
+  sampler.Init();
+  ASSERT_EQ(sampler.GetName(), "TailSampler");
+  ASSERT_FALSE(sampler.Enabled());
+
+  trpc::RpczConfig config;
+  config.lower_water_level = 1;
+  config.high_water_level = 3;
+  config.sample_rate = 0;
+  config.enable_tail_sample = true;
+  config.tail_sample_latency_ms = 10;
+  sampler.Init(config);
+  ASSERT_TRUE(sampler.Enabled());
+
+  // Fast and successful calls fall back to high low water level sampler.
+  ASSERT_TRUE(sampler.Sample(1, 100, 0));
+  ASSERT_FALSE(sampler.Sample(2, 100, 0));
+
+  // Slow or failed calls are kept until high water.
+  ASSERT_TRUE(sampler.Sample(3, 10 * 1000, 0));
+  ASSERT_TRUE(sampler.Sample(4, 100, 141));
+  ASSERT_TRUE(sampler.Sample(5, 20 * 1000, 0));
+  ASSERT_FALSE(sampler.Sample(6, 20 * 1000, 0));
+}
+
 }  // namespace trpc::testing
 #endif
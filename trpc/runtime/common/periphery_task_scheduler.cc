@@ -13,6 +13,7 @@
 
 #include "trpc/runtime/common/periphery_task_scheduler.h"
 
+#include <algorithm>
 #include <chrono>
 
 #include "trpc/common/config/trpc_config.h"
@@ -24,6 +25,12 @@ using namespace std::literals;
 
 namespace trpc {
 
+PeripheryTaskScheduler::PeripheryTaskSchedulerImpl::PeripheryTaskSchedulerImpl(const std::string& tvar_prefix)
+    : lateness_us_(tvar_prefix + "/lateness_us"), queue_depth_(tvar_prefix + "/queue_depth", [this] {
+        std::scoped_lock _(lock_);
+        return static_cast<uint64_t>(timing_wheel_.PendingSize() + timing_wheel_.ExpiredSize());
+      }) {}
+
 PeripheryTaskScheduler::PeripheryTaskSchedulerImpl::~PeripheryTaskSchedulerImpl() {
   Stop();
   Join();
@@ -60,9 +67,7 @@ void PeripheryTaskScheduler::PeripheryTaskSchedulerImpl::Join() {
     clean_cb_ = nullptr;
   }
 
-  while (!tasks_.empty()) {
-    tasks_.pop();
-  }
+  timing_wheel_.Clear([](TimingWheelEntry* entry) { TaskPtr task_ptr(adopt_ptr, static_cast<Task*>(entry)); });
 }
 
 std::uint64_t PeripheryTaskScheduler::PeripheryTaskSchedulerImpl::SubmitTaskImpl(Function<void()>&& task,
@@ -119,11 +124,18 @@ bool PeripheryTaskScheduler::PeripheryTaskSchedulerImpl::StopAndDestroyTask(std:
     return false;
   }
 
-  std::scoped_lock _(task_ptr->lock);
+  TaskPtr removed_task_ptr;
+  std::scoped_lock _(lock_, task_ptr->lock);
   task_ptr->cancelled = true;
   if (!is_destroy) {
     task_ptr->Ref();
   }
+  // The task waiting in queue is removed right now instead of being dropped when it expires.
+  if (timing_wheel_.Remove(task_ptr.Get())) {
+    removed_task_ptr = TaskPtr(adopt_ptr, task_ptr.Get());
+    task_ptr->done = true;
+    task_ptr->stop_cv.notify_all();
+  }
   return true;
 }
 
@@ -161,25 +173,29 @@ void PeripheryTaskScheduler::PeripheryTaskSchedulerImpl::Schedule() {
   SetCurrentThreadName("periphery_task_scheduler");
   while (!exited_.load(std::memory_order_relaxed)) {
     std::unique_lock lk(lock_);
-    auto pred = [&] {
-      return (!tasks_.empty() && tasks_.top()->expires_at <= std::chrono::steady_clock::now()) ||
-             exited_.load(std::memory_order_relaxed);
-    };
-    auto next = tasks_.empty() ? std::chrono::steady_clock::now() + 100s : tasks_.top()->expires_at;
-    cv_.wait_until(lk, next, pred);
-
-    if (exited_.load(std::memory_order_relaxed)) {
-      break;
-    }
-    if (!pred()) {
+    auto now = std::chrono::steady_clock::now();
+    // All tasks expired are moved out of the wheel in batch, and then executed one by one.
+    timing_wheel_.Advance(ToCurrentTick(now));
+    TimingWheelEntry* entry = timing_wheel_.PopExpired();
+    if (!entry) {
+      // `Stop()` notifies under the lock, so checking it under the lock here ensures the notification isn't lost.
+      if (exited_.load(std::memory_order_relaxed)) {
+        break;
+      }
+      auto next = std::min(ToTimePoint(timing_wheel_.NextTick()), now + 100s);
+      cv_.wait_until(lk, next);
       continue;
     }
+    if (timing_wheel_.ExpiredSize() > 0) {
+      // Let other threads help to execute the rest of the batch.
+      cv_.notify_one();
+    }
+    lk.unlock();
 
     // get and execute task
-    auto task = tasks_.top();
-    tasks_.pop();
-
-    lk.unlock();
+    TaskPtr task(adopt_ptr, static_cast<Task*>(entry));
+    lateness_us_.Update(static_cast<uint32_t>(
+        std::max(std::chrono::duration_cast<std::chrono::microseconds>(now - task->expires_at).count(), int64_t{0})));
     TaskProc(std::move(task));
   }
 }
@@ -208,11 +224,43 @@ void PeripheryTaskScheduler::PeripheryTaskSchedulerImpl::TaskProc(TaskPtr&& task
     task_ptr->expires_at += std::chrono::milliseconds(task_ptr->interval_gen_func());
   }
 
+  AddToTimingWheel(std::move(task_ptr));
+}
+
+void PeripheryTaskScheduler::PeripheryTaskSchedulerImpl::AddToTimingWheel(TaskPtr&& task_ptr) {
+  task_ptr->expires_tick = ToTick(task_ptr->expires_at);
+
   std::scoped_lock _(lock_);
-  tasks_.push(std::move(task_ptr));
+  timing_wheel_.Add(task_ptr.Leak());
   cv_.notify_all();
 }
 
+std::uint64_t PeripheryTaskScheduler::PeripheryTaskSchedulerImpl::ToTick(
+    std::chrono::steady_clock::time_point time_point) const {
+  if (time_point <= start_time_) {
+    return 0;
+  }
+  // Round up, so that tasks never run before their expiration time.
+  auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(time_point - start_time_).count();
+  return static_cast<std::uint64_t>((elapsed + 999999) / 1000000);
+}
+
+std::uint64_t PeripheryTaskScheduler::PeripheryTaskSchedulerImpl::ToCurrentTick(
+    std::chrono::steady_clock::time_point time_point) const {
+  if (time_point <= start_time_) {
+    return 0;
+  }
+  // Round down, a tick is reached only after it has fully passed.
+  return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(time_point - start_time_).count());
+}
+
+std::chrono::steady_clock::time_point PeripheryTaskScheduler::PeripheryTaskSchedulerImpl::ToTimePoint(
+    std::uint64_t tick) const {
+  // Avoid overflow when the wheel is empty.
+  return start_time_ + std::chrono::milliseconds(std::min(tick, std::uint64_t{1} << 40));
+}
+
 std::uint64_t PeripheryTaskScheduler::PeripheryTaskSchedulerImpl::CreateAndSubmitTask(
     Function<void()>&& cb, Function<std::uint64_t()>&& interval_gen_func, bool periodic, const std::string& name) {
   auto task_ptr = trpc::MakeRefCounted<Task>();
@@ -225,17 +273,10 @@ std::uint64_t PeripheryTaskScheduler::PeripheryTaskSchedulerImpl::CreateAndSubmi
 
   uint64_t task_id = reinterpret_cast<std::uint64_t>(task_ptr.Get());
 
-  std::scoped_lock _(lock_);
-  tasks_.push(std::move(task_ptr));
-  cv_.notify_all();
+  AddToTimingWheel(std::move(task_ptr));
   return task_id;
 }
 
-bool PeripheryTaskScheduler::PeripheryTaskSchedulerImpl::TaskPtrComp::operator()(const TaskPtr& p1,
-                                                                                 const TaskPtr& p2) const {
-  return p1->expires_at > p2->expires_at;
-}
-
 PeripheryTaskScheduler::~PeripheryTaskScheduler() {
   Stop();
   Join();
@@ -251,10 +292,10 @@ bool PeripheryTaskScheduler::Init() {
     return true;
   }
 
-  scheduler_ = std::make_unique<PeripheryTaskSchedulerImpl>();
+  scheduler_ = std::make_unique<PeripheryTaskSchedulerImpl>("trpc/periphery_task_scheduler/user");
   scheduler_->Init(TrpcConfig::GetInstance()->GetGlobalConfig().periphery_task_scheduler_thread_num);
 
-  inner_scheduler_ = std::make_unique<PeripheryTaskSchedulerImpl>();
+  inner_scheduler_ = std::make_unique<PeripheryTaskSchedulerImpl>("trpc/periphery_task_scheduler/inner");
   inner_scheduler_->Init(TrpcConfig::GetInstance()->GetGlobalConfig().inner_periphery_task_scheduler_thread_num);
 
   return true;
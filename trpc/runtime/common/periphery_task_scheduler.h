@@ -14,15 +14,18 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <cstdint>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <string>
 #include <thread>
 #include <vector>
 
+#include "trpc/runtime/common/timing_wheel.h"
+#include "trpc/tvar/basic_ops/passive_status.h"
+#include "trpc/tvar/compound_ops/histogram_recorder.h"
 #include "trpc/util/function.h"
 #include "trpc/util/ref_ptr.h"
 
@@ -42,6 +45,9 @@ namespace trpc {
 ///        Generally, does not need to be concerned about this value. If too many tasks
 ///        are started due to the use of many plugins, the value can be appropriately increased based on the performance
 ///        of the program.
+///        Tasks are kept in a hierarchical timing wheel with 1ms tick, so submitting, rescheduling and removing a task
+///        are O(1) no matter how many tasks there are. The lateness of task execution and the number of queued tasks
+///        are exposed by tvar under "trpc/periphery_task_scheduler/{user|inner}".
 
 class PeripheryTaskScheduler {
  public:
@@ -142,7 +148,7 @@ class PeripheryTaskScheduler {
   // Concrete implementation of PeripheryTaskScheduler.
   class PeripheryTaskSchedulerImpl {
    public:
-    PeripheryTaskSchedulerImpl() = default;
+    explicit PeripheryTaskSchedulerImpl(const std::string& tvar_prefix);
     ~PeripheryTaskSchedulerImpl();
 
     PeripheryTaskSchedulerImpl(const PeripheryTaskSchedulerImpl&) = delete;
@@ -167,7 +173,7 @@ class PeripheryTaskScheduler {
     void RegisterResourceCleanCallback(Function<void()>&& cb) { clean_cb_ = std::move(cb); }
 
    private:
-    struct Task : trpc::RefCounted<Task> {
+    struct Task : trpc::RefCounted<Task>, TimingWheelEntry {
       // task name
       std::string name;
       // is periodic task or not
@@ -192,12 +198,20 @@ class PeripheryTaskScheduler {
       std::condition_variable stop_cv;
     };
     using TaskPtr = trpc::RefPtr<Task>;
-    struct TaskPtrComp {
-      bool operator()(const TaskPtr& p1, const TaskPtr& p2) const;
-    };
 
     void Schedule();
 
+    // Puts task into the timing wheel, the reference of task is held by the wheel until it is taken out.
+    void AddToTimingWheel(TaskPtr&& task_ptr);
+
+    // Converts an expiration time to the first tick not earlier than it.
+    std::uint64_t ToTick(std::chrono::steady_clock::time_point time_point) const;
+
+    // Converts current time to the last tick not later than it.
+    std::uint64_t ToCurrentTick(std::chrono::steady_clock::time_point time_point) const;
+
+    std::chrono::steady_clock::time_point ToTimePoint(std::uint64_t tick) const;
+
     void TaskProc(TaskPtr&& task_ptr);
 
     std::uint64_t CreateAndSubmitTask(Function<void()>&& cb, Function<std::uint64_t()>&& interval_gen_func,
@@ -214,8 +228,11 @@ class PeripheryTaskScheduler {
     // the threads been asked to stop
     std::atomic<bool> exited_{false};
 
-    // task queue
-    std::priority_queue<TaskPtr, std::vector<TaskPtr>, TaskPtrComp> tasks_;
+    // time point of tick 0 of the timing wheel
+    const std::chrono::steady_clock::time_point start_time_{std::chrono::steady_clock::now()};
+
+    // task queue, guarded by `lock_`
+    TimingWheel timing_wheel_;
 
     // worker threads
     std::vector<std::thread> workers_;
@@ -224,6 +241,12 @@ class PeripheryTaskScheduler {
     size_t thread_num_{1};
 
     Function<void()> clean_cb_{nullptr};
+
+    // delay between the expiration time and the actual execution time of tasks, in microseconds
+    tvar::HistogramRecorder lateness_us_;
+
+    // number of tasks waiting in queue, including the expired ones
+    tvar::PassiveStatus<uint64_t> queue_depth_;
   };
 
   std::unique_ptr<PeripheryTaskSchedulerImpl> scheduler_{nullptr}, inner_scheduler_{nullptr};
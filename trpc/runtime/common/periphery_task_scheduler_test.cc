@@ -17,6 +17,7 @@
 #include <iostream>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 #include "trpc/common/config/trpc_config.h"
 #include "trpc/util/thread/latch.h"
@@ -264,6 +265,30 @@ void TestStopAndJoinTask() {
   ASSERT_EQ(counter, 3);
 }
 
+void TestNeverRunBeforeExpiration() {
+  constexpr int kRuns = 30;
+  constexpr auto kInterval = 3ms;
+  std::vector<std::chrono::steady_clock::time_point> run_times;
+  Latch latch(1);
+  auto submit_time = std::chrono::steady_clock::now();
+  std::uint64_t task_id = PeripheryTaskScheduler::GetInstance()->SubmitInnerPeriodicalTask(
+      [&run_times, &latch] {
+        run_times.push_back(std::chrono::steady_clock::now());
+        if (run_times.size() == kRuns) {
+          latch.count_down();
+        }
+      },
+      kInterval.count());
+  latch.wait();
+  PeripheryTaskScheduler::GetInstance()->StopInnerTask(task_id);
+  PeripheryTaskScheduler::GetInstance()->JoinInnerTask(task_id);
+
+  // The n-th run expires at `n * interval` after the first one, which expires no earlier than submitting.
+  for (int i = 0; i < kRuns; ++i) {
+    ASSERT_GE(run_times[i], submit_time + i * kInterval) << "run " << i;
+  }
+}
+
 TEST_F(PeripheryTaskSchedulerTest, SubmitTaskTest) { TestSubmitTask(); }
 
 TEST_F(PeripheryTaskSchedulerTest, RemoveTaskTest) { TestRemoveTask(); }
@@ -280,6 +305,8 @@ TEST_F(PeripheryTaskSchedulerTest, SubmitManyTaskTest) { TestSubmitManyTask(); }
 
 TEST_F(PeripheryTaskSchedulerTest, TestStopAndJoinTask) { TestStopAndJoinTask(); }
 
+TEST_F(PeripheryTaskSchedulerTest, NeverRunBeforeExpirationTest) { TestNeverRunBeforeExpiration(); }
+
 TEST_F(PeripheryTaskSchedulerMultiCoreTest, SubmitTaskTest) { TestSubmitTask(); }
 
 TEST_F(PeripheryTaskSchedulerMultiCoreTest, RemoveTaskTest) { TestRemoveTask(); }
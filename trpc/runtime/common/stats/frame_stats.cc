@@ -17,6 +17,8 @@
 
 #include "trpc/common/config/trpc_config.h"
 #include "trpc/runtime/common/periphery_task_scheduler.h"
+#include "trpc/runtime/common/stats/rpc_stage_stats.h"
+#include "trpc/runtime/common/stats/sampling_profiler.h"
 #include "trpc/util/log/logging.h"
 #include "trpc/util/time.h"
 
@@ -26,6 +28,16 @@ void FrameStats::Start() {
   // Get metrics plugins
   TrpcConfig::GetInstance()->GetPluginNodes("metrics", metrics_);
 
+  const auto& server_config = TrpcConfig::GetInstance()->GetServerConfig();
+  RpcStageStats::SetEnabled(server_config.enable_rpc_stage_stats);
+
+  if (server_config.enable_sampling_profiler) {
+    SamplingProfiler::Options options;
+    options.frequency = server_config.sampling_profiler_frequency;
+    options.window_seconds = server_config.sampling_profiler_window_seconds;
+    SamplingProfiler::GetInstance()->Start(options);
+  }
+
   // start periodical task
   if (task_id_ == 0) {
     last_server_stats_time_ = trpc::time::GetMilliSeconds();
@@ -41,6 +53,8 @@ void FrameStats::Stop() {
     PeripheryTaskScheduler::GetInstance()->JoinInnerTask(task_id_);
     task_id_ = 0;
   }
+
+  SamplingProfiler::GetInstance()->Stop();
 }
 
 void FrameStats::Run() {
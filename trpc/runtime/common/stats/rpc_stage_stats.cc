@@ -0,0 +1,180 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#include "trpc/runtime/common/stats/rpc_stage_stats.h"
+
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+namespace trpc {
+
+namespace {
+
+constexpr std::string_view kRpcStageNames[] = {"decode", "dispatch", "filter", "deserialize",
+                                               "handle", "serialize", "encode", "write"};
+static_assert(std::size(kRpcStageNames) == static_cast<std::size_t>(RpcStage::kStageNum));
+
+using MethodHistograms = std::unordered_map<std::string, RpcStageHistograms>;
+
+void MergeHistograms(const RpcStageHistograms& from, RpcStageHistograms* to) {
+  for (std::size_t i = 0; i != from.size(); ++i) {
+    (*to)[i].Merge(from[i]);
+  }
+}
+
+// Histograms recorded by a thread. The mutex is only contended while histograms are being collected.
+struct ThreadStageStats {
+  std::mutex mutex;
+  MethodHistograms histograms;
+};
+
+// All alive `ThreadStageStats`, and histograms of exited threads.
+struct StageStatsRegistry {
+  std::mutex mutex;
+  std::unordered_set<ThreadStageStats*> threads;
+  MethodHistograms retired;
+};
+
+StageStatsRegistry* GetRegistry() {
+  // Leaked, as threads may exit after static objects are destroyed.
+  static auto* registry = new StageStatsRegistry();
+  return registry;
+}
+
+class ThreadStageStatsHolder {
+ public:
+  ThreadStageStatsHolder() {
+    auto* registry = GetRegistry();
+    std::scoped_lock lock(registry->mutex);
+    registry->threads.insert(&stats_);
+  }
+
+  ~ThreadStageStatsHolder() {
+    auto* registry = GetRegistry();
+    std::scoped_lock lock(registry->mutex);
+    registry->threads.erase(&stats_);
+    for (auto&& [method, histograms] : stats_.histograms) {
+      MergeHistograms(histograms, &registry->retired[method]);
+    }
+  }
+
+  ThreadStageStats* Get() { return &stats_; }
+
+ private:
+  ThreadStageStats stats_;
+};
+
+ThreadStageStats* GetThreadStageStats() {
+  thread_local ThreadStageStatsHolder holder;
+  return holder.Get();
+}
+
+}  // namespace
+
+std::string_view GetRpcStageName(RpcStage stage) {
+  auto index = static_cast<std::size_t>(stage);
+  return index < std::size(kRpcStageNames) ? kRpcStageNames[index] : "unknown";
+}
+
+uint64_t CyclesToNanoseconds(uint64_t cycles) {
+  // Converted by double, `DurationFromTsc` may overflow for large cycles.
+  static const double kNanosecondsPerCycle =
+      static_cast<double>(detail::kNanosecondsPerUnit.count()) / static_cast<double>(detail::kUnit);
+  return static_cast<uint64_t>(static_cast<double>(cycles) * kNanosecondsPerCycle);
+}
+
+void RpcStageHistogram::Merge(const RpcStageHistogram& other) {
+  count_ += other.count_;
+  sum_ += other.sum_;
+  max_ = std::max(max_, other.max_);
+  for (std::size_t i = 0; i != kBucketNum; ++i) {
+    buckets_[i] += other.buckets_[i];
+  }
+}
+
+uint64_t RpcStageHistogram::Percentile(double ratio) const {
+  if (count_ == 0) {
+    return 0;
+  }
+  double rank = std::clamp(ratio, 0.0, 1.0) * static_cast<double>(count_);
+  uint64_t accumulated = 0;
+  for (std::size_t i = 0; i != kBucketNum; ++i) {
+    if (buckets_[i] == 0 || static_cast<double>(accumulated + buckets_[i]) < rank) {
+      accumulated += buckets_[i];
+      continue;
+    }
+    if (i == 0) {
+      return 0;
+    }
+    uint64_t lower = 1ULL << (i - 1);
+    uint64_t upper = std::min(lower * 2, max_);
+    if (upper <= lower) {
+      return max_;
+    }
+    double in_bucket = (rank - static_cast<double>(accumulated)) / static_cast<double>(buckets_[i]);
+    return lower + static_cast<uint64_t>(in_bucket * static_cast<double>(upper - lower));
+  }
+  return max_;
+}
+
+void RpcStageStats::Record(const std::string& method, const uint64_t* cycles) {
+  auto* stats = GetThreadStageStats();
+  std::scoped_lock lock(stats->mutex);
+
+  auto iter = stats->histograms.find(method);
+  if (iter == stats->histograms.end()) {
+    // Number of methods is unbounded for some protocols (e.g. paths of http), so they're limited.
+    if (stats->histograms.size() < kMaxMethodsPerThread) {
+      iter = stats->histograms.emplace(method, RpcStageHistograms{}).first;
+    } else {
+      iter = stats->histograms.try_emplace(std::string(kOtherMethods)).first;
+    }
+  }
+  for (std::size_t i = 0; i != iter->second.size(); ++i) {
+    if (cycles[i] != 0) {
+      iter->second[i].Add(cycles[i]);
+    }
+  }
+}
+
+std::map<std::string, RpcStageHistograms> RpcStageStats::Collect() const {
+  std::map<std::string, RpcStageHistograms> result;
+  auto* registry = GetRegistry();
+  std::scoped_lock lock(registry->mutex);
+  for (auto&& [method, histograms] : registry->retired) {
+    MergeHistograms(histograms, &result[method]);
+  }
+  for (auto* stats : registry->threads) {
+    std::scoped_lock thread_lock(stats->mutex);
+    for (auto&& [method, histograms] : stats->histograms) {
+      MergeHistograms(histograms, &result[method]);
+    }
+  }
+  return result;
+}
+
+void RpcStageStats::Reset() {
+  auto* registry = GetRegistry();
+  std::scoped_lock lock(registry->mutex);
+  registry->retired.clear();
+  for (auto* stats : registry->threads) {
+    std::scoped_lock thread_lock(stats->mutex);
+    stats->histograms.clear();
+  }
+}
+
+}  // namespace trpc
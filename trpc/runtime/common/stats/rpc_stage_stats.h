@@ -0,0 +1,200 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+
+#include "trpc/util/chrono/tsc.h"
+
+namespace trpc {
+
+/// @brief Stages of handling an unary rpc on server side.
+enum class RpcStage : uint8_t {
+  // Decoding the request frame by the codec.
+  kDecode = 0,
+  // Queueing from being decoded (by io thread) to being handled (by handle thread or fiber).
+  kDispatch,
+  // Running server filters, filters of io points are not included.
+  kFilter,
+  // Decompressing and deserializing the request body.
+  kDeserialize,
+  // Running the method implemented by user.
+  kHandle,
+  // Serializing and compressing the response body.
+  kSerialize,
+  // Encoding the response frame by the codec.
+  kEncode,
+  // From the response being handed to transport until it has been written to the socket.
+  kWrite,
+  kStageNum,
+};
+
+/// @brief Get the name of stage, e.g. "decode".
+std::string_view GetRpcStageName(RpcStage stage);
+
+/// @brief Convert TSC cycles into nanoseconds.
+uint64_t CyclesToNanoseconds(uint64_t cycles);
+
+/// @brief Histogram of the cycles of a stage, in buckets of powers of 2.
+class RpcStageHistogram {
+ public:
+  /// Cycles not less than 2^(kBucketNum - 2) (about 3 minutes on 3GHz) fall into the last bucket.
+  static constexpr std::size_t kBucketNum = 40;
+
+  void Add(uint64_t cycles) {
+    ++count_;
+    sum_ += cycles;
+    max_ = cycles > max_ ? cycles : max_;
+    ++buckets_[GetBucketIndex(cycles)];
+  }
+
+  void Merge(const RpcStageHistogram& other);
+
+  uint64_t Count() const { return count_; }
+
+  uint64_t Sum() const { return sum_; }
+
+  uint64_t Max() const { return max_; }
+
+  /// @brief Estimate the percentile of cycles, by interpolating inside the bucket where it falls.
+  /// @param ratio in (0, 1], e.g. 0.99
+  uint64_t Percentile(double ratio) const;
+
+ private:
+  static std::size_t GetBucketIndex(uint64_t cycles) {
+    // Bucket i (i > 0) holds [2^(i - 1), 2^i).
+    std::size_t index = cycles == 0 ? 0 : 64 - __builtin_clzll(cycles);
+    return index < kBucketNum ? index : kBucketNum - 1;
+  }
+
+ private:
+  uint64_t count_{0};
+  uint64_t sum_{0};
+  uint64_t max_{0};
+  std::array<uint64_t, kBucketNum> buckets_{};
+};
+
+/// @brief Histograms of all stages of a method.
+using RpcStageHistograms = std::array<RpcStageHistogram, static_cast<std::size_t>(RpcStage::kStageNum)>;
+
+/// @brief Statistics of cycles spent in each stage of rpcs, grouped by method.
+///        Timings are recorded into histograms of the recording thread, which are only merged when they are read
+///        (e.g. by admin command `/cmds/stats/stages`), so recording has no contention across threads.
+/// @note  It's disabled by default, enable it by `enable_rpc_stage_stats` in server config.
+class RpcStageStats {
+ public:
+  /// Methods recorded per thread is limited, the others are recorded as `kOtherMethods`.
+  static constexpr std::size_t kMaxMethodsPerThread = 1024;
+  static constexpr std::string_view kOtherMethods = "<others>";
+
+  static RpcStageStats* GetInstance() {
+    static RpcStageStats instance;
+    return &instance;
+  }
+
+  RpcStageStats(const RpcStageStats&) = delete;
+  RpcStageStats& operator=(const RpcStageStats&) = delete;
+
+  static void SetEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+
+  static bool IsEnabled() { return enabled_.load(std::memory_order_relaxed); }
+
+  /// @brief Record cycles of stages of a finished rpc into histograms of current thread.
+  /// @param cycles cycles of each stage, stages with 0 cycles are skipped
+  void Record(const std::string& method, const uint64_t* cycles);
+
+  /// @brief Merge histograms of all threads, by method name.
+  std::map<std::string, RpcStageHistograms> Collect() const;
+
+  /// @brief Clear all the histograms.
+  void Reset();
+
+ private:
+  RpcStageStats() = default;
+
+ private:
+  inline static std::atomic<bool> enabled_{false};
+};
+
+/// @brief Cycles spent in each stage of a rpc, which is carried by the server context.
+class RpcStageTimer {
+ public:
+  void Add(RpcStage stage, uint64_t cycles) {
+    cycles_[static_cast<std::size_t>(stage)] += cycles;
+    recorded_ = true;
+  }
+
+  /// @brief Remember the start of a stage which ends in another place (or thread), e.g. dispatch.
+  void Mark() {
+    if (RpcStageStats::IsEnabled()) {
+      mark_ = ReadTsc();
+    }
+  }
+
+  /// @brief End the stage started by `Mark`, it does nothing if not marked.
+  void AddSinceMark(RpcStage stage) {
+    if (mark_ != 0) {
+      uint64_t now = ReadTsc();
+      // TSC of different cores may be slightly out of sync.
+      Add(stage, now > mark_ ? now - mark_ : 0);
+      mark_ = 0;
+    }
+  }
+
+  uint64_t Get(RpcStage stage) const { return cycles_[static_cast<std::size_t>(stage)]; }
+
+  const uint64_t* GetAll() const { return cycles_; }
+
+  bool Empty() const { return !recorded_; }
+
+ private:
+  uint64_t cycles_[static_cast<std::size_t>(RpcStage::kStageNum)]{};
+  uint64_t mark_{0};
+  bool recorded_{false};
+};
+
+/// @brief Add cycles spent in the scope to a stage of the timer. Nothing is done if timer is nullptr or rpc stage
+///        stats is disabled.
+class ScopedRpcStage {
+ public:
+  ScopedRpcStage(RpcStageTimer* timer, RpcStage stage)
+      : timer_(RpcStageStats::IsEnabled() ? timer : nullptr), stage_(stage) {
+    if (timer_) {
+      start_ = ReadTsc();
+    }
+  }
+
+  ~ScopedRpcStage() {
+    if (timer_) {
+      timer_->Add(stage_, ReadTsc() - start_);
+    }
+  }
+
+  ScopedRpcStage(const ScopedRpcStage&) = delete;
+  ScopedRpcStage& operator=(const ScopedRpcStage&) = delete;
+
+ private:
+  RpcStageTimer* timer_;
+  RpcStage stage_;
+  uint64_t start_{0};
+};
+
+}  // namespace trpc
@@ -0,0 +1,131 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#include "trpc/runtime/common/stats/rpc_stage_stats.h"
+
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace trpc::testing {
+
+TEST(RpcStageHistogramTest, Percentile) {
+  RpcStageHistogram histogram;
+  ASSERT_EQ(histogram.Percentile(0.99), 0);
+
+  for (uint64_t i = 1; i <= 1000; ++i) {
+    histogram.Add(i);
+  }
+  ASSERT_EQ(histogram.Count(), 1000);
+  ASSERT_EQ(histogram.Sum(), 500500);
+  ASSERT_EQ(histogram.Max(), 1000);
+
+  // Estimated within the bucket, so the error is less than the value itself.
+  auto p50 = histogram.Percentile(0.5);
+  ASSERT_GE(p50, 256);
+  ASSERT_LT(p50, 1000);
+  auto p99 = histogram.Percentile(0.99);
+  ASSERT_GE(p99, 512);
+  ASSERT_LE(p99, 1000);
+  ASSERT_EQ(histogram.Percentile(1), 1000);
+
+  RpcStageHistogram other;
+  other.Add(1ULL << 20);
+  histogram.Merge(other);
+  ASSERT_EQ(histogram.Count(), 1001);
+  ASSERT_EQ(histogram.Max(), 1ULL << 20);
+  ASSERT_EQ(histogram.Percentile(1), 1ULL << 20);
+}
+
+TEST(RpcStageTimerTest, Timer) {
+  RpcStageStats::SetEnabled(false);
+  RpcStageTimer timer;
+  {
+    ScopedRpcStage stage(&timer, RpcStage::kHandle);
+  }
+  timer.Mark();
+  timer.AddSinceMark(RpcStage::kDispatch);
+  ASSERT_TRUE(timer.Empty());
+
+  RpcStageStats::SetEnabled(true);
+  {
+    ScopedRpcStage stage(&timer, RpcStage::kHandle);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  ASSERT_FALSE(timer.Empty());
+  ASSERT_GE(CyclesToNanoseconds(timer.Get(RpcStage::kHandle)), 1000000);
+
+  timer.AddSinceMark(RpcStage::kDispatch);
+  ASSERT_EQ(timer.Get(RpcStage::kDispatch), 0);
+  timer.Mark();
+  timer.AddSinceMark(RpcStage::kDispatch);
+  ASSERT_GT(timer.Get(RpcStage::kDispatch), 0);
+
+  {
+    ScopedRpcStage stage(nullptr, RpcStage::kEncode);
+  }
+  RpcStageStats::SetEnabled(false);
+}
+
+TEST(RpcStageStatsTest, RecordAndCollect) {
+  auto* stats = RpcStageStats::GetInstance();
+  stats->Reset();
+
+  RpcStageTimer timer;
+  timer.Add(RpcStage::kDecode, 100);
+  timer.Add(RpcStage::kHandle, 1000);
+  stats->Record("/trpc.test.Greeter/SayHello", timer.GetAll());
+
+  // Recorded by an exited thread.
+  std::thread t([stats, &timer] {
+    stats->Record("/trpc.test.Greeter/SayHello", timer.GetAll());
+    stats->Record("/trpc.test.Greeter/SayHi", timer.GetAll());
+  });
+  t.join();
+
+  auto result = stats->Collect();
+  ASSERT_EQ(result.size(), 2);
+  const auto& histograms = result["/trpc.test.Greeter/SayHello"];
+  ASSERT_EQ(histograms[static_cast<std::size_t>(RpcStage::kDecode)].Count(), 2);
+  ASSERT_EQ(histograms[static_cast<std::size_t>(RpcStage::kHandle)].Sum(), 2000);
+  ASSERT_EQ(histograms[static_cast<std::size_t>(RpcStage::kEncode)].Count(), 0);
+  ASSERT_EQ(result["/trpc.test.Greeter/SayHi"][static_cast<std::size_t>(RpcStage::kDecode)].Count(), 1);
+
+  stats->Reset();
+  ASSERT_TRUE(stats->Collect().empty());
+}
+
+TEST(RpcStageStatsTest, MethodsLimited) {
+  auto* stats = RpcStageStats::GetInstance();
+  stats->Reset();
+
+  RpcStageTimer timer;
+  timer.Add(RpcStage::kHandle, 1);
+  for (std::size_t i = 0; i != RpcStageStats::kMaxMethodsPerThread + 10; ++i) {
+    stats->Record("/path/" + std::to_string(i), timer.GetAll());
+  }
+  auto result = stats->Collect();
+  ASSERT_EQ(result.size(), RpcStageStats::kMaxMethodsPerThread + 1);
+  ASSERT_EQ(result[std::string(RpcStageStats::kOtherMethods)][static_cast<std::size_t>(RpcStage::kHandle)].Count(),
+            10);
+  stats->Reset();
+}
+
+TEST(RpcStageStatsTest, StageName) {
+  ASSERT_EQ(GetRpcStageName(RpcStage::kDecode), "decode");
+  ASSERT_EQ(GetRpcStageName(RpcStage::kWrite), "write");
+}
+
+}  // namespace trpc::testing
@@ -0,0 +1,581 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+#include "trpc/runtime/common/stats/sampling_profiler.h"
+
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <fcntl.h>
+#include <linux/perf_event.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <unordered_set>
+#include <utility>
+
+#include "trpc/util/log/logging.h"
+
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+
+namespace trpc {
+
+namespace {
+
+constexpr std::size_t kMaxFrames = 64;
+// Frames of the signal handler and `backtrace` above the interrupted one.
+constexpr std::size_t kMaxHandlerFrames = 8;
+// Must be a power of 2.
+constexpr uint64_t kRingSize = 64;
+constexpr std::size_t kAltStackSize = 64 * 1024;
+constexpr std::size_t kMaxTags = 4096;
+constexpr auto kCollectInterval = std::chrono::milliseconds(200);
+constexpr char kOtherTags[] = "<others>";
+
+struct RawSample {
+  const char* tag;
+  const char* entry;
+  std::size_t depth;
+  void* frames[kMaxFrames];
+};
+
+// Tag slot of the thread itself, used if the running context has no slot of its own.
+thread_local const char* tls_tag = nullptr;
+thread_local SamplingProfiler::ThreadSampler* tls_sampler = nullptr;
+
+// Unregisters the thread on thread exit.
+struct ThreadSamplerGuard {
+  bool registered = false;
+
+  ~ThreadSamplerGuard() {
+    if (registered) {
+      SamplingProfiler::GetInstance()->UnregisterCurrentThread();
+    }
+  }
+};
+
+thread_local ThreadSamplerGuard tls_guard;
+
+int64_t NowSeconds() {
+  return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void* GetInterruptedPc(void* ucontext) {
+#if defined(__x86_64__)
+  return reinterpret_cast<void*>(static_cast<ucontext_t*>(ucontext)->uc_mcontext.gregs[REG_RIP]);
+#elif defined(__aarch64__)
+  return reinterpret_cast<void*>(static_cast<ucontext_t*>(ucontext)->uc_mcontext.pc);
+#else
+  return nullptr;
+#endif
+}
+
+void OnProfilingSignal(int signo, siginfo_t* info, void* ucontext);
+
+}  // namespace
+
+struct SamplingProfiler::ThreadSampler {
+  const char* name = nullptr;
+  SampleContextGetter getter = nullptr;
+  pid_t tid = 0;
+  pthread_t thread;
+
+  // Owned by the collector (and the thread being unregistered) under `SamplingProfiler::mutex_`.
+  int perf_fd = -1;
+  timer_t timer;
+  bool has_timer = false;
+
+  // Written by the signal handler, read by the collector.
+  std::atomic<bool> armed{false};
+  std::atomic<bool> in_handler{false};
+  std::atomic<uint64_t> head{0};
+  std::atomic<uint64_t> tail{0};
+  std::atomic<uint64_t> dropped{0};
+  std::unique_ptr<RawSample[]> ring;
+
+  // Signal stack installed for the thread, so the handler won't overflow a small fiber stack.
+  std::unique_ptr<char[]> alt_stack;
+};
+
+namespace {
+
+void OnProfilingSignal(int signo, siginfo_t* info, void* ucontext) {
+  auto* sampler = tls_sampler;
+  if (sampler == nullptr || !sampler->armed.load(std::memory_order_acquire) ||
+      sampler->in_handler.exchange(true, std::memory_order_relaxed)) {
+    return;
+  }
+  int saved_errno = errno;
+
+  uint64_t head = sampler->head.load(std::memory_order_relaxed);
+  if (head - sampler->tail.load(std::memory_order_acquire) >= kRingSize) {
+    sampler->dropped.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    RawSample& sample = sampler->ring[head & (kRingSize - 1)];
+    SampleContext context = sampler->getter ? sampler->getter() : SampleContext{};
+    sample.tag = *(context.tag_slot ? context.tag_slot : &tls_tag);
+    sample.entry = context.entry_name;
+
+    void* frames[kMaxFrames + kMaxHandlerFrames];
+    int depth = backtrace(frames, kMaxFrames + kMaxHandlerFrames);
+    // Skip frames of the signal handler, the interrupted one is the leaf.
+    void* pc = GetInterruptedPc(ucontext);
+    int start = 0;
+    while (start < depth && frames[start] != pc) {
+      ++start;
+    }
+    if (start == depth) {
+      start = std::min(depth, 2);
+    }
+    sample.depth = std::min<std::size_t>(depth - start, kMaxFrames);
+    memcpy(sample.frames, frames + start, sample.depth * sizeof(void*));
+    sampler->head.store(head + 1, std::memory_order_release);
+  }
+
+  sampler->in_handler.store(false, std::memory_order_relaxed);
+  errno = saved_errno;
+}
+
+std::string Demangle(const char* name) {
+  int status = 0;
+  char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+  if (demangled == nullptr) {
+    return name;
+  }
+  std::string ret(demangled);
+  free(demangled);
+  return ret;
+}
+
+std::string Symbolize(void* addr, bool return_address) {
+  // Return addresses point to the instruction after the call, which may belong to the next function.
+  auto lookup = reinterpret_cast<uintptr_t>(addr) - (return_address ? 1 : 0);
+  Dl_info info;
+  bool found = dladdr(reinterpret_cast<void*>(lookup), &info) != 0;
+  std::string ret;
+  if (found && info.dli_sname != nullptr) {
+    ret = Demangle(info.dli_sname);
+  } else if (found && info.dli_fname != nullptr) {
+    // Not exported, left for tools like addr2line.
+    const char* module = strrchr(info.dli_fname, '/');
+    char offset[32];
+    snprintf(offset, sizeof(offset), "+0x%" PRIxPTR, lookup - reinterpret_cast<uintptr_t>(info.dli_fbase));
+    ret = std::string(module ? module + 1 : info.dli_fname) + offset;
+  } else {
+    char hex[32];
+    snprintf(hex, sizeof(hex), "0x%" PRIxPTR, lookup);
+    ret = hex;
+  }
+  // ';' separates frames in collapsed format.
+  for (auto& c : ret) {
+    if (c == ';') {
+      c = ':';
+    }
+  }
+  return ret;
+}
+
+// Raw stack is the bytes of [tag, entry, name, frames...].
+std::string EncodeRawStack(const RawSample& sample, const char* name) {
+  const void* header[] = {sample.tag, sample.entry, name};
+  std::string raw(reinterpret_cast<const char*>(header), sizeof(header));
+  raw.append(reinterpret_cast<const char*>(sample.frames), sample.depth * sizeof(void*));
+  return raw;
+}
+
+std::string CollapseRawStack(const std::string& raw, std::unordered_map<void*, std::string>* symbols) {
+  std::vector<void*> words(raw.size() / sizeof(void*));
+  memcpy(words.data(), raw.data(), words.size() * sizeof(void*));
+
+  auto tag = static_cast<const char*>(words[0]);
+  auto entry = static_cast<const char*>(words[1]);
+  auto name = static_cast<const char*>(words[2]);
+  std::string ret;
+  if (tag != nullptr) {
+    ret = tag;
+  } else if (entry != nullptr) {
+    ret = std::string("fiber:") + entry;
+  } else {
+    ret = name;
+  }
+
+  // From the root to the leaf.
+  for (std::size_t i = words.size(); i > 3; --i) {
+    void* addr = words[i - 1];
+    bool leaf = (i == 4);
+    // Leaf address is not a return address, cache it separately.
+    void* key = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(addr) ^ (leaf ? 1 : 0));
+    auto it = symbols->find(key);
+    if (it == symbols->end()) {
+      it = symbols->emplace(key, Symbolize(addr, !leaf)).first;
+    }
+    ret += ';';
+    ret += it->second;
+  }
+  return ret;
+}
+
+// Whether SIGPROF is handled by another profiler, e.g. gperftools started by env `CPUPROFILE`.
+bool IsSignalTakenByOthers() {
+  struct sigaction action;
+  if (sigaction(SIGPROF, nullptr, &action) != 0) {
+    return false;
+  }
+  if (action.sa_flags & SA_SIGINFO) {
+    return action.sa_sigaction != OnProfilingSignal;
+  }
+  return action.sa_handler != SIG_DFL && action.sa_handler != SIG_IGN;
+}
+
+bool InstallSignalHandler() {
+  struct sigaction action;
+  memset(&action, 0, sizeof(action));
+  action.sa_sigaction = OnProfilingSignal;
+  action.sa_flags = SA_SIGINFO | SA_RESTART | SA_ONSTACK;
+  sigemptyset(&action.sa_mask);
+  if (sigaction(SIGPROF, &action, nullptr) != 0) {
+    TRPC_FMT_ERROR("Install SIGPROF handler failed: {}", strerror(errno));
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+const char* InternSampleTag(std::string_view tag) {
+  // Leaked intentionally, tags may be referred to until the process exits.
+  static auto* mutex = new std::mutex();
+  static auto* tags = new std::unordered_set<std::string>();
+
+  std::lock_guard<std::mutex> lock(*mutex);
+  std::string key(tag);
+  if (auto it = tags->find(key); it != tags->end()) {
+    return it->c_str();
+  }
+  if (tags->size() >= kMaxTags) {
+    return kOtherTags;
+  }
+  return tags->insert(std::move(key)).first->c_str();
+}
+
+bool SamplingProfiler::Start(const Options& options) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (running_.load(std::memory_order_relaxed)) {
+    return false;
+  }
+
+  // Taking SIGPROF over would break the other profiler, and it would break ours once it stops.
+  if (IsSignalTakenByOthers()) {
+    TRPC_FMT_ERROR("SIGPROF is handled by another profiler (e.g. gperftools), stop it first");
+    return false;
+  }
+  if (!InstallSignalHandler()) {
+    return false;
+  }
+  // The unwinder is loaded lazily on first use, which is not async-signal-safe, so load it before any signal.
+  void* frames[1];
+  backtrace(frames, 1);
+
+  options_ = options;
+  options_.frequency = std::clamp<uint32_t>(options_.frequency, 1, 1000);
+  options_.window_seconds = std::max<uint32_t>(options_.window_seconds, 1);
+  stopping_ = false;
+  running_.store(true, std::memory_order_relaxed);
+  for (auto& sampler : samplers_) {
+    Arm(sampler.get());
+  }
+  collector_ = std::thread([this] { CollectProc(); });
+
+  TRPC_FMT_INFO("Sampling profiler started, frequency: {}, window: {}s, threads: {}", options_.frequency,
+                options_.window_seconds, samplers_.size());
+  return true;
+}
+
+void SamplingProfiler::Stop() {
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!running_.load(std::memory_order_relaxed)) {
+      return;
+    }
+    running_.store(false, std::memory_order_relaxed);
+    paused_ = false;
+    for (auto& sampler : samplers_) {
+      Disarm(sampler.get());
+    }
+    stopping_ = true;
+  }
+  cond_.notify_all();
+  collector_.join();
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (auto& sampler : samplers_) {
+    sampler->tail.store(sampler->head.load(std::memory_order_acquire), std::memory_order_release);
+    sampler->dropped.store(0, std::memory_order_relaxed);
+  }
+  buckets_.clear();
+  dropped_ = 0;
+}
+
+void SamplingProfiler::Pause() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (!running_.load(std::memory_order_relaxed) || paused_) {
+    return;
+  }
+  for (auto& sampler : samplers_) {
+    Disarm(sampler.get());
+  }
+  paused_ = true;
+  TRPC_FMT_INFO("Sampling profiler paused");
+}
+
+bool SamplingProfiler::Resume() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (!paused_) {
+    return true;
+  }
+  // The other profiler may have reset or kept its handler when it stopped, take SIGPROF back before arming.
+  if (!InstallSignalHandler()) {
+    return false;
+  }
+  paused_ = false;
+  for (auto& sampler : samplers_) {
+    Arm(sampler.get());
+  }
+  TRPC_FMT_INFO("Sampling profiler resumed");
+  return true;
+}
+
+bool SamplingProfiler::IsPaused() const {
+  std::unique_lock<std::mutex> lock(mutex_);
+  return paused_;
+}
+
+void SamplingProfiler::RegisterCurrentThread(std::string_view name, SampleContextGetter getter) {
+  if (tls_sampler != nullptr) {
+    return;
+  }
+
+  auto sampler = std::make_shared<ThreadSampler>();
+  sampler->name = InternSampleTag(name);
+  sampler->getter = getter;
+  sampler->tid = static_cast<pid_t>(syscall(SYS_gettid));
+  sampler->thread = pthread_self();
+  sampler->ring = std::make_unique<RawSample[]>(kRingSize);
+
+  // Keep the signal stack the thread already has (if any).
+  stack_t stack;
+  if (sigaltstack(nullptr, &stack) == 0 && (stack.ss_flags & SS_DISABLE)) {
+    sampler->alt_stack = std::make_unique<char[]>(kAltStackSize);
+    stack.ss_sp = sampler->alt_stack.get();
+    stack.ss_size = kAltStackSize;
+    stack.ss_flags = 0;
+    if (sigaltstack(&stack, nullptr) != 0) {
+      sampler->alt_stack.reset();
+    }
+  }
+
+  tls_guard.registered = true;
+  tls_sampler = sampler.get();
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  samplers_.push_back(sampler);
+  if (running_.load(std::memory_order_relaxed) && !paused_) {
+    Arm(sampler.get());
+  }
+}
+
+void SamplingProfiler::UnregisterCurrentThread() {
+  auto* sampler = tls_sampler;
+  if (sampler == nullptr) {
+    return;
+  }
+  // Signals arriving from now on are ignored.
+  tls_sampler = nullptr;
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+
+  std::shared_ptr<ThreadSampler> holder;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    Disarm(sampler);
+    if (running_.load(std::memory_order_relaxed)) {
+      DrainLocked(sampler, NowSeconds());
+    }
+    for (auto it = samplers_.begin(); it != samplers_.end(); ++it) {
+      if (it->get() == sampler) {
+        holder = std::move(*it);
+        samplers_.erase(it);
+        break;
+      }
+    }
+  }
+
+  if (sampler->alt_stack) {
+    stack_t stack;
+    memset(&stack, 0, sizeof(stack));
+    stack.ss_flags = SS_DISABLE;
+    sigaltstack(&stack, nullptr);
+  }
+}
+
+std::map<std::string, uint64_t> SamplingProfiler::GetCollapsedStacks(uint32_t seconds) {
+  std::unordered_map<std::string, uint64_t> raw_stacks;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    int64_t now = NowSeconds();
+    for (auto& sampler : samplers_) {
+      DrainLocked(sampler.get(), now);
+    }
+    for (const auto& bucket : buckets_) {
+      if (seconds == 0 || bucket.second > now - seconds) {
+        for (const auto& [raw, count] : bucket.stacks) {
+          raw_stacks[raw] += count;
+        }
+      }
+    }
+  }
+
+  // Symbolized out of lock, it's slow.
+  std::unordered_map<void*, std::string> symbols;
+  std::map<std::string, uint64_t> stacks;
+  for (const auto& [raw, count] : raw_stacks) {
+    stacks[CollapseRawStack(raw, &symbols)] += count;
+  }
+  return stacks;
+}
+
+uint64_t SamplingProfiler::GetDroppedSamples() const {
+  std::unique_lock<std::mutex> lock(mutex_);
+  uint64_t dropped = dropped_;
+  for (const auto& sampler : samplers_) {
+    dropped += sampler->dropped.load(std::memory_order_relaxed);
+  }
+  return dropped;
+}
+
+void SamplingProfiler::Arm(ThreadSampler* sampler) {
+  sampler->armed.store(true, std::memory_order_release);
+  uint64_t period_ns = 1000000000ULL / options_.frequency;
+
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_SOFTWARE;
+  attr.config = PERF_COUNT_SW_TASK_CLOCK;
+  attr.sample_period = period_ns;
+  attr.wakeup_events = 1;
+  attr.disabled = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, sampler->tid, -1, -1, PERF_FLAG_FD_CLOEXEC));
+  if (fd >= 0) {
+    struct f_owner_ex owner;
+    owner.type = F_OWNER_TID;
+    owner.pid = sampler->tid;
+    if (fcntl(fd, F_SETFL, O_ASYNC) == 0 && fcntl(fd, F_SETSIG, SIGPROF) == 0 &&
+        fcntl(fd, F_SETOWN_EX, &owner) == 0 && ioctl(fd, PERF_EVENT_IOC_ENABLE, 0) == 0) {
+      sampler->perf_fd = fd;
+      return;
+    }
+    close(fd);
+  }
+
+  // perf_event is not permitted (e.g. by perf_event_paranoid or seccomp), fall back to cpu-time timer.
+  clockid_t clock;
+  struct sigevent event;
+  memset(&event, 0, sizeof(event));
+  event.sigev_notify = SIGEV_THREAD_ID;
+  event.sigev_signo = SIGPROF;
+  event.sigev_notify_thread_id = sampler->tid;
+  if (pthread_getcpuclockid(sampler->thread, &clock) == 0 && timer_create(clock, &event, &sampler->timer) == 0) {
+    struct itimerspec spec;
+    spec.it_interval.tv_sec = period_ns / 1000000000ULL;
+    spec.it_interval.tv_nsec = period_ns % 1000000000ULL;
+    spec.it_value = spec.it_interval;
+    if (timer_settime(sampler->timer, 0, &spec, nullptr) == 0) {
+      sampler->has_timer = true;
+      return;
+    }
+    timer_delete(sampler->timer);
+  }
+
+  sampler->armed.store(false, std::memory_order_release);
+  TRPC_FMT_WARN("Arm sampling profiler for thread {}({}) failed: {}", sampler->name, sampler->tid, strerror(errno));
+}
+
+void SamplingProfiler::Disarm(ThreadSampler* sampler) {
+  sampler->armed.store(false, std::memory_order_release);
+  if (sampler->perf_fd >= 0) {
+    ioctl(sampler->perf_fd, PERF_EVENT_IOC_DISABLE, 0);
+    close(sampler->perf_fd);
+    sampler->perf_fd = -1;
+  }
+  if (sampler->has_timer) {
+    timer_delete(sampler->timer);
+    sampler->has_timer = false;
+  }
+}
+
+void SamplingProfiler::CollectProc() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!stopping_) {
+    cond_.wait_for(lock, kCollectInterval, [this] { return stopping_; });
+    int64_t now = NowSeconds();
+    for (auto& sampler : samplers_) {
+      DrainLocked(sampler.get(), now);
+    }
+  }
+}
+
+void SamplingProfiler::DrainLocked(ThreadSampler* sampler, int64_t now) {
+  if (buckets_.empty() || buckets_.back().second != now) {
+    buckets_.push_back(Bucket{now, {}});
+  }
+  while (buckets_.front().second <= now - static_cast<int64_t>(options_.window_seconds)) {
+    buckets_.pop_front();
+  }
+
+  auto& stacks = buckets_.back().stacks;
+  uint64_t tail = sampler->tail.load(std::memory_order_relaxed);
+  uint64_t head = sampler->head.load(std::memory_order_acquire);
+  for (; tail != head; ++tail) {
+    ++stacks[EncodeRawStack(sampler->ring[tail & (kRingSize - 1)], sampler->name)];
+  }
+  sampler->tail.store(tail, std::memory_order_release);
+  dropped_ += sampler->dropped.exchange(0, std::memory_order_relaxed);
+}
+
+ScopedSampleTag::ScopedSampleTag(const char* tag) noexcept {
+  auto* sampler = tls_sampler;
+  SampleContext context = (sampler && sampler->getter) ? sampler->getter() : SampleContext{};
+  slot_ = context.tag_slot ? context.tag_slot : &tls_tag;
+  prev_ = *slot_;
+  *slot_ = tag;
+}
+
+ScopedSampleTag::~ScopedSampleTag() { *slot_ = prev_; }
+
+}  // namespace trpc
@@ -0,0 +1,165 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <sys/types.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace trpc {
+
+/// @brief Execution context running on a thread when it is sampled.
+struct SampleContext {
+  /// Slot of the tag (e.g. the rpc method being handled) of the running context, nullptr to use the slot of thread.
+  const char** tag_slot = nullptr;
+  /// Name of the entry of the running context (e.g. fiber entry), nullptr if unknown. Must be a static string.
+  const char* entry_name = nullptr;
+};
+
+/// @brief Get the execution context of current thread, it's called in signal handler so must be async-signal-safe.
+using SampleContextGetter = SampleContext (*)() noexcept;
+
+/// @brief Intern a tag, so it can be referred by `ScopedSampleTag` (and samples) for the life of process.
+/// @note  Tags are never freed, intern a bounded set of strings (e.g. method names) only. Once there are too many
+///        tags, "<others>" is returned.
+const char* InternSampleTag(std::string_view tag);
+
+/// @brief Always-on sampling cpu profiler.
+///        Each registered thread is interrupted (by SIGPROF) about `frequency` times per second of its cpu time,
+///        using a perf_event software cpu clock (or a cpu-time timer if perf_event is not permitted). The call stack
+///        of the running context, a fiber stack if a fiber is running, is recorded with the tag of the context.
+///        Samples are aggregated per second in memory, and the last `window_seconds` seconds are kept, so recent
+///        hot spots can be inspected at any time without restarting the process.
+/// @note  It shares SIGPROF with the gperftools cpu profiler, so they can't sample at the same time. It refuses to start
+///        while SIGPROF is handled by others, and it's paused (see `Pause`) while the gperftools one is started by
+///        admin commands.
+class SamplingProfiler {
+ public:
+  struct Options {
+    /// Samples per second of cpu time of each thread.
+    uint32_t frequency = 99;
+    /// How many seconds of samples are kept.
+    uint32_t window_seconds = 60;
+  };
+
+  static SamplingProfiler* GetInstance() {
+    static SamplingProfiler instance;
+    return &instance;
+  }
+
+  SamplingProfiler(const SamplingProfiler&) = delete;
+  SamplingProfiler& operator=(const SamplingProfiler&) = delete;
+
+  /// @brief Start sampling threads registered (either before or after starting).
+  /// @return false if it's already running, SIGPROF is handled by another profiler (e.g. gperftools started by env
+  ///         `CPUPROFILE`), or it fails to install the signal handler.
+  bool Start(const Options& options);
+
+  /// @brief Stop sampling and drop the samples kept.
+  void Stop();
+
+  bool IsRunning() const { return running_.load(std::memory_order_relaxed); }
+
+  /// @brief Stop sampling for a while and leave SIGPROF to another profiler, samples kept are not dropped.
+  void Pause();
+
+  /// @brief Take SIGPROF back and go on sampling after `Pause`, the other profiler must have stopped.
+  /// @return false if it fails to install the signal handler, it's still paused then.
+  bool Resume();
+
+  bool IsPaused() const;
+
+  /// @brief Register current thread to be sampled, it's unregistered automatically on thread exit.
+  /// @param name name of the thread (e.g. thread model instance name), root frame of samples without tag and entry
+  /// @param getter getter of the running context, nullptr if the thread runs no other context than itself
+  void RegisterCurrentThread(std::string_view name, SampleContextGetter getter = nullptr);
+
+  /// @brief Unregister current thread, samples not collected yet are dropped.
+  void UnregisterCurrentThread();
+
+  /// @brief Get samples of the last `seconds` seconds (whole window if 0) in collapsed format: frames from the root
+  ///        (tag, fiber entry or thread name) to the leaf joined by ';', mapped to number of samples.
+  std::map<std::string, uint64_t> GetCollapsedStacks(uint32_t seconds = 0);
+
+  /// @brief Number of samples dropped because they're not collected in time.
+  uint64_t GetDroppedSamples() const;
+
+  /// @private For internal use purpose only.
+  struct ThreadSampler;
+
+ private:
+  struct Bucket {
+    int64_t second;
+    // Raw stacks (tags and frame addresses) to number of samples.
+    std::unordered_map<std::string, uint64_t> stacks;
+  };
+
+  SamplingProfiler() = default;
+
+  ~SamplingProfiler() { Stop(); }
+
+  void Arm(ThreadSampler* sampler);
+
+  void Disarm(ThreadSampler* sampler);
+
+  void CollectProc();
+
+  void DrainLocked(ThreadSampler* sampler, int64_t now);
+
+ private:
+  std::atomic<bool> running_{false};
+
+  // Protects members below.
+  mutable std::mutex mutex_;
+  Options options_;
+  std::vector<std::shared_ptr<ThreadSampler>> samplers_;
+  std::deque<Bucket> buckets_;
+  uint64_t dropped_{0};
+  // Running but not sampling, see `Pause`.
+  bool paused_{false};
+
+  bool stopping_{false};
+  std::condition_variable cond_;
+  std::thread collector_;
+};
+
+/// @brief Tag samples taken in this scope with `tag` (e.g. the rpc method being handled).
+///        The tag sticks to the running fiber, so it's kept even if the fiber is migrated to another thread.
+/// @note  `tag` must live as long as the process, see `InternSampleTag`.
+class ScopedSampleTag {
+ public:
+  explicit ScopedSampleTag(const char* tag) noexcept;
+
+  ~ScopedSampleTag();
+
+  ScopedSampleTag(const ScopedSampleTag&) = delete;
+  ScopedSampleTag& operator=(const ScopedSampleTag&) = delete;
+
+ private:
+  const char** slot_;
+  const char* prev_;
+};
+
+}  // namespace trpc
@@ -0,0 +1,167 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+#include "trpc/runtime/common/stats/sampling_profiler.h"
+
+#include <signal.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <map>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace trpc::testing {
+
+namespace {
+
+const char* test_tag_slot = nullptr;
+
+SampleContext GetTestSampleContext() noexcept { return {&test_tag_slot, "TestEntry"}; }
+
+// Burn cpu time of current thread for `duration`.
+void Spin(std::chrono::milliseconds duration) {
+  timespec start, now;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+  volatile uint64_t counter = 0;
+  do {
+    for (int i = 0; i < 10000; ++i) {
+      counter = counter + 1;
+    }
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+  } while ((now.tv_sec - start.tv_sec) * 1000 + (now.tv_nsec - start.tv_nsec) / 1000000 < duration.count());
+}
+
+uint64_t CountSamples(const std::map<std::string, uint64_t>& stacks, const std::string& root) {
+  uint64_t count = 0;
+  for (const auto& [stack, samples] : stacks) {
+    if (stack.compare(0, root.size() + 1, root + ";") == 0) {
+      count += samples;
+    }
+  }
+  return count;
+}
+
+}  // namespace
+
+TEST(SamplingProfilerTest, InternSampleTag) {
+  const char* tag = InternSampleTag("/trpc.test.helloworld.Greeter/SayHello");
+  ASSERT_STREQ(tag, "/trpc.test.helloworld.Greeter/SayHello");
+  ASSERT_EQ(InternSampleTag(std::string("/trpc.test.helloworld.Greeter/SayHello")), tag);
+  ASSERT_NE(InternSampleTag("/trpc.test.helloworld.Greeter/SayHi"), tag);
+}
+
+TEST(SamplingProfilerTest, SampleThreads) {
+  SamplingProfiler* profiler = SamplingProfiler::GetInstance();
+  SamplingProfiler::Options options;
+  options.frequency = 500;
+  ASSERT_TRUE(profiler->Start(options));
+  ASSERT_TRUE(profiler->IsRunning());
+  ASSERT_FALSE(profiler->Start(options));
+
+  // Registered after starting, samples are tagged by the tag of thread.
+  std::thread plain([profiler] {
+    profiler->RegisterCurrentThread("plain_thread");
+    Spin(std::chrono::milliseconds(200));
+    ScopedSampleTag tag(InternSampleTag("TaggedScope"));
+    Spin(std::chrono::milliseconds(200));
+  });
+  plain.join();
+
+  // Samples are tagged by the running context.
+  std::thread context([profiler] {
+    profiler->RegisterCurrentThread("context_thread", GetTestSampleContext);
+    Spin(std::chrono::milliseconds(200));
+    ScopedSampleTag tag(InternSampleTag("TaggedContext"));
+    ASSERT_STREQ(test_tag_slot, "TaggedContext");
+    Spin(std::chrono::milliseconds(200));
+  });
+  context.join();
+  ASSERT_EQ(test_tag_slot, nullptr);
+
+  auto stacks = profiler->GetCollapsedStacks();
+  ASSERT_GT(CountSamples(stacks, "plain_thread"), 10);
+  ASSERT_GT(CountSamples(stacks, "TaggedScope"), 10);
+  ASSERT_GT(CountSamples(stacks, "fiber:TestEntry"), 10);
+  ASSERT_GT(CountSamples(stacks, "TaggedContext"), 10);
+  ASSERT_EQ(CountSamples(stacks, "context_thread"), 0);
+  for (const auto& [stack, samples] : stacks) {
+    ASSERT_NE(stack.find(';'), std::string::npos) << stack;
+  }
+
+  profiler->Stop();
+  ASSERT_FALSE(profiler->IsRunning());
+  ASSERT_TRUE(profiler->GetCollapsedStacks().empty());
+}
+
+TEST(SamplingProfilerTest, RegisteredBeforeStart) {
+  SamplingProfiler* profiler = SamplingProfiler::GetInstance();
+  profiler->RegisterCurrentThread("main_thread");
+  Spin(std::chrono::milliseconds(50));
+  ASSERT_TRUE(profiler->GetCollapsedStacks().empty());
+
+  SamplingProfiler::Options options;
+  options.frequency = 500;
+  ASSERT_TRUE(profiler->Start(options));
+  Spin(std::chrono::milliseconds(200));
+  auto stacks = profiler->GetCollapsedStacks(1);
+  ASSERT_GT(CountSamples(stacks, "main_thread"), 10);
+
+  profiler->UnregisterCurrentThread();
+  profiler->Stop();
+}
+
+TEST(SamplingProfilerTest, PauseForOtherProfiler) {
+  SamplingProfiler* profiler = SamplingProfiler::GetInstance();
+  profiler->RegisterCurrentThread("main_thread");
+  SamplingProfiler::Options options;
+  options.frequency = 500;
+  ASSERT_TRUE(profiler->Start(options));
+  Spin(std::chrono::milliseconds(200));
+
+  // Another profiler takes SIGPROF while it's paused, samples kept are not dropped.
+  profiler->Pause();
+  uint64_t samples = CountSamples(profiler->GetCollapsedStacks(), "main_thread");
+  ASSERT_GT(samples, 10);
+  ASSERT_TRUE(profiler->IsRunning());
+  ASSERT_TRUE(profiler->IsPaused());
+  struct sigaction other;
+  memset(&other, 0, sizeof(other));
+  other.sa_handler = [](int) {};
+  struct sigaction prev;
+  ASSERT_EQ(sigaction(SIGPROF, &other, &prev), 0);
+  Spin(std::chrono::milliseconds(200));
+  ASSERT_EQ(CountSamples(profiler->GetCollapsedStacks(), "main_thread"), samples);
+
+  // Signal handler is installed again on resuming.
+  ASSERT_TRUE(profiler->Resume());
+  ASSERT_FALSE(profiler->IsPaused());
+  Spin(std::chrono::milliseconds(200));
+  ASSERT_GT(CountSamples(profiler->GetCollapsedStacks(), "main_thread"), samples + 10);
+
+  // Refuses to start while SIGPROF is handled by another profiler.
+  profiler->Stop();
+  ASSERT_EQ(sigaction(SIGPROF, &other, nullptr), 0);
+  ASSERT_FALSE(profiler->Start(options));
+  ASSERT_FALSE(profiler->IsRunning());
+  ASSERT_EQ(sigaction(SIGPROF, &prev, nullptr), 0);
+  ASSERT_TRUE(profiler->Start(options));
+
+  profiler->UnregisterCurrentThread();
+  profiler->Stop();
+}
+
+}  // namespace trpc::testing
@@ -0,0 +1,149 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/runtime/common/timing_wheel.h"
+
+#include <algorithm>
+
+#include "trpc/util/check.h"
+
+namespace trpc {
+
+namespace {
+
+constexpr std::uint64_t kSlotMask = TimingWheel::kSlots - 1;
+
+constexpr std::size_t SlotIndex(std::uint64_t tick, std::size_t level) {
+  return (tick >> (level * TimingWheel::kSlotBits)) & kSlotMask;
+}
+
+}  // namespace
+
+void TimingWheel::Add(TimingWheelEntry* entry) {
+  TRPC_DCHECK(entry->owner == nullptr);
+  Place(entry, current_tick_ + 1);
+  ++pending_size_;
+}
+
+bool TimingWheel::Remove(TimingWheelEntry* entry) {
+  if (entry->owner == nullptr) {
+    return false;
+  }
+  if (entry->owner != &expired_) {
+    --pending_size_;
+  }
+  entry->owner->erase(entry);
+  entry->owner = nullptr;
+  return true;
+}
+
+std::size_t TimingWheel::Advance(std::uint64_t now_tick) {
+  std::size_t expired_size = expired_.size();
+  while (current_tick_ < now_tick) {
+    // Skip ticks at which nothing happens.
+    std::uint64_t next_tick = std::max(NextTick(), current_tick_ + 1);
+    if (next_tick > now_tick) {
+      current_tick_ = now_tick;
+      break;
+    }
+    current_tick_ = next_tick;
+
+    // Higher levels are cascaded once lower level wraps around, and always before the lowest level fires, so entries
+    // cascaded into the slot of current tick are fired immediately.
+    for (std::size_t level = 1; level < kLevels; ++level) {
+      if (SlotIndex(current_tick_, level - 1) != 0) {
+        break;
+      }
+      Cascade(level);
+    }
+
+    EntryList& slot = slots_[0][SlotIndex(current_tick_, 0)];
+    while (auto* entry = slot.pop_front()) {
+      --pending_size_;
+      if (entry->expires_tick > current_tick_) {
+        // Entries expire beyond the range of the wheel are placed into the farthest slot and wait for another round.
+        Place(entry, current_tick_ + 1);
+        ++pending_size_;
+        continue;
+      }
+      entry->owner = &expired_;
+      expired_.push_back(entry);
+    }
+  }
+  return expired_.size() - expired_size;
+}
+
+TimingWheelEntry* TimingWheel::PopExpired() {
+  auto* entry = expired_.pop_front();
+  if (entry) {
+    entry->owner = nullptr;
+  }
+  return entry;
+}
+
+std::uint64_t TimingWheel::NextTick() const {
+  if (!expired_.empty()) {
+    return current_tick_;
+  }
+  std::uint64_t next_tick = current_tick_ + kMaxTicks;
+  if (pending_size_ == 0) {
+    return next_tick;
+  }
+  // The first non-empty slot of lowest level, entries in it expire at exactly that tick.
+  for (std::uint64_t tick = current_tick_ + 1; tick <= current_tick_ + kSlots; ++tick) {
+    if (!slots_[0][SlotIndex(tick, 0)].empty()) {
+      next_tick = tick;
+      break;
+    }
+  }
+  // The first non-empty slot of higher levels, entries in it are cascaded when the slot starts.
+  for (std::size_t level = 1; level < kLevels; ++level) {
+    const std::size_t shift = level * kSlotBits;
+    for (std::uint64_t i = 1; i <= kSlots; ++i) {
+      std::uint64_t tick = ((current_tick_ >> shift) + i) << shift;
+      if (tick >= next_tick) {
+        break;
+      }
+      if (!slots_[level][SlotIndex(tick, level)].empty()) {
+        next_tick = tick;
+        break;
+      }
+    }
+  }
+  return next_tick;
+}
+
+void TimingWheel::Place(TimingWheelEntry* entry, std::uint64_t earliest_tick) {
+  // Entries beyond the range of the wheel wait in the farthest slot.
+  const std::uint64_t expires_tick = std::clamp(entry->expires_tick, earliest_tick, current_tick_ + kMaxTicks - 1);
+  const std::uint64_t delta = expires_tick - current_tick_;
+  std::size_t level = 0;
+  while (level + 1 < kLevels && delta >= (std::uint64_t{1} << ((level + 1) * kSlotBits))) {
+    ++level;
+  }
+  EntryList& slot = slots_[level][SlotIndex(expires_tick, level)];
+  entry->owner = &slot;
+  slot.push_back(entry);
+}
+
+void TimingWheel::Cascade(std::size_t level) {
+  EntryList entries;
+  entries.splice(std::move(slots_[level][SlotIndex(current_tick_, level)]));
+  while (auto* entry = entries.pop_front()) {
+    entry->owner = nullptr;
+    // Slot of current tick has not fired yet.
+    Place(entry, current_tick_);
+  }
+}
+
+}  // namespace trpc
@@ -0,0 +1,118 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "trpc/util/internal/doubly_linked_list.h"
+
+namespace trpc {
+
+class TimingWheel;
+
+/// @brief Intrusive hook of the object scheduled by TimingWheel.
+/// @private For internal use purpose only.
+struct TimingWheelEntry {
+  DoublyLinkedListEntry chain;
+
+  // List in the wheel currently holding the entry, `nullptr` if the entry is not in the wheel.
+  DoublyLinkedList<TimingWheelEntry, &TimingWheelEntry::chain>* owner{nullptr};
+
+  // Tick at which the entry expires.
+  std::uint64_t expires_tick{0};
+};
+
+/// @brief Hierarchical timing wheel, 4 levels of 256 slots each, which covers 2^32 ticks.
+///        Adding and removing an entry are O(1). Expired entries are moved in batch into an expired list by Advance,
+///        and taken out one by one by PopExpired.
+/// @note Thread-compatible, entries are not owned by the wheel.
+/// @private For internal use purpose only.
+class TimingWheel {
+ public:
+  static constexpr std::size_t kLevels = 4;
+  static constexpr std::size_t kSlotBits = 8;
+  static constexpr std::size_t kSlots = 1 << kSlotBits;
+  static constexpr std::uint64_t kMaxTicks = std::uint64_t{1} << (kLevels * kSlotBits);
+
+  /// @param now_tick ticks already elapsed, entries never expire before it.
+  explicit TimingWheel(std::uint64_t now_tick = 0) : current_tick_(now_tick) {}
+
+  TimingWheel(const TimingWheel&) = delete;
+  TimingWheel& operator=(const TimingWheel&) = delete;
+
+  /// @brief Adds an entry whose `expires_tick` has been set. An entry already expired fires on the next tick.
+  /// @note The entry must not be in the wheel.
+  void Add(TimingWheelEntry* entry);
+
+  /// @brief Removes an entry, either pending or expired.
+  /// @return Returns false if the entry is not in the wheel.
+  bool Remove(TimingWheelEntry* entry);
+
+  /// @brief Moves all entries expired at `now_tick` into the expired list.
+  /// @return Returns the number of entries newly expired.
+  std::size_t Advance(std::uint64_t now_tick);
+
+  /// @brief Takes out an expired entry, returns `nullptr` if there is no one.
+  TimingWheelEntry* PopExpired();
+
+  /// @brief Gets the earliest tick at which Advance may make some progress, an entry may expire or be cascaded to a
+  ///        lower level at that tick. Returns `current tick` if there are expired entries, or kMaxTicks + current tick
+  ///        if the wheel is empty.
+  std::uint64_t NextTick() const;
+
+  /// @brief Removes all entries, `func` is invoked with every removed entry.
+  template <typename F>
+  void Clear(F&& func) {
+    for (auto& level : slots_) {
+      for (auto& slot : level) {
+        while (auto* entry = slot.pop_front()) {
+          entry->owner = nullptr;
+          func(entry);
+        }
+      }
+    }
+    while (auto* entry = expired_.pop_front()) {
+      entry->owner = nullptr;
+      func(entry);
+    }
+    pending_size_ = 0;
+  }
+
+  /// @brief Gets the number of entries not expired yet.
+  std::size_t PendingSize() const { return pending_size_; }
+
+  /// @brief Gets the number of entries expired but not popped.
+  std::size_t ExpiredSize() const { return expired_.size(); }
+
+  std::uint64_t CurrentTick() const { return current_tick_; }
+
+ private:
+  using EntryList = DoublyLinkedList<TimingWheelEntry, &TimingWheelEntry::chain>;
+
+  // Puts entry into the slot according to its expires tick (but not earlier than `earliest_tick`), without counting.
+  void Place(TimingWheelEntry* entry, std::uint64_t earliest_tick);
+
+  // Moves entries of the slot of `level` which covers current tick into lower levels.
+  void Cascade(std::size_t level);
+
+ private:
+  // The last tick processed, entries are all expire after it.
+  std::uint64_t current_tick_;
+  std::size_t pending_size_{0};
+  EntryList slots_[kLevels][kSlots];
+  EntryList expired_;
+};
+
+}  // namespace trpc
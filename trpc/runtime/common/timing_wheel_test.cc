@@ -0,0 +1,131 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/runtime/common/timing_wheel.h"
+
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace trpc::testing {
+
+namespace {
+
+std::vector<std::uint64_t> PopAllExpired(TimingWheel& wheel) {
+  std::vector<std::uint64_t> expires_ticks;
+  while (auto* entry = wheel.PopExpired()) {
+    expires_ticks.push_back(entry->expires_tick);
+  }
+  return expires_ticks;
+}
+
+}  // namespace
+
+TEST(TimingWheelTest, AddAndAdvance) {
+  TimingWheel wheel(100);
+  TimingWheelEntry e1, e2, e3;
+  e1.expires_tick = 100;
+  e2.expires_tick = 110;
+  e3.expires_tick = 100 + 70000;
+  wheel.Add(&e1);
+  wheel.Add(&e2);
+  wheel.Add(&e3);
+  ASSERT_EQ(3, wheel.PendingSize());
+  ASSERT_EQ(101, wheel.NextTick());
+
+  // Already expired entry fires on the next tick.
+  ASSERT_EQ(1, wheel.Advance(101));
+  ASSERT_EQ(std::vector<std::uint64_t>{100}, PopAllExpired(wheel));
+
+  ASSERT_EQ(0, wheel.Advance(109));
+  ASSERT_EQ(1, wheel.Advance(110));
+  ASSERT_EQ(std::vector<std::uint64_t>{110}, PopAllExpired(wheel));
+
+  ASSERT_EQ(0, wheel.Advance(100 + 69999));
+  ASSERT_EQ(1, wheel.Advance(100 + 80000));
+  ASSERT_EQ(std::vector<std::uint64_t>{100 + 70000}, PopAllExpired(wheel));
+  ASSERT_EQ(0, wheel.PendingSize());
+}
+
+TEST(TimingWheelTest, Remove) {
+  TimingWheel wheel;
+  TimingWheelEntry e1, e2;
+  e1.expires_tick = 10;
+  e2.expires_tick = 1000;
+  wheel.Add(&e1);
+  wheel.Add(&e2);
+  ASSERT_TRUE(wheel.Remove(&e2));
+  ASSERT_FALSE(wheel.Remove(&e2));
+  ASSERT_EQ(1, wheel.PendingSize());
+
+  ASSERT_EQ(1, wheel.Advance(2000));
+  ASSERT_EQ(1, wheel.ExpiredSize());
+  // Expired but not popped entry can be removed too.
+  ASSERT_TRUE(wheel.Remove(&e1));
+  ASSERT_EQ(nullptr, wheel.PopExpired());
+}
+
+TEST(TimingWheelTest, BeyondRange) {
+  TimingWheel wheel;
+  TimingWheelEntry entry;
+  entry.expires_tick = TimingWheel::kMaxTicks + 5;
+  wheel.Add(&entry);
+  ASSERT_EQ(0, wheel.Advance(TimingWheel::kMaxTicks + 4));
+  ASSERT_EQ(1, wheel.Advance(TimingWheel::kMaxTicks + 5));
+}
+
+TEST(TimingWheelTest, Random) {
+  std::mt19937_64 random(0);
+  TimingWheel wheel;
+  std::vector<TimingWheelEntry> entries(10000);
+  for (auto& entry : entries) {
+    entry.expires_tick = random() % (1 << 26);
+    wheel.Add(&entry);
+  }
+
+  std::size_t expired = 0;
+  std::uint64_t now = 0;
+  while (wheel.PendingSize() > 0) {
+    std::uint64_t prev = now;
+    now = std::min(wheel.NextTick() + random() % 300, prev + random() % 100000);
+    now = std::max(now, prev + 1);
+    expired += wheel.Advance(now);
+    while (auto* entry = wheel.PopExpired()) {
+      // Every entry fires by the first Advance which passes its expires tick.
+      ASSERT_LE(entry->expires_tick, now);
+      ASSERT_TRUE(entry->expires_tick > prev || (prev == 0 && entry->expires_tick == 0));
+    }
+  }
+  ASSERT_EQ(entries.size(), expired);
+}
+
+TEST(TimingWheelTest, Clear) {
+  TimingWheel wheel;
+  std::vector<TimingWheelEntry> entries(100);
+  for (std::size_t i = 0; i < entries.size(); ++i) {
+    entries[i].expires_tick = i * 1000;
+    wheel.Add(&entries[i]);
+  }
+  wheel.Advance(50000);
+  std::size_t cleared = 0;
+  wheel.Clear([&cleared](TimingWheelEntry* entry) {
+    ASSERT_EQ(nullptr, entry->owner);
+    ++cleared;
+  });
+  ASSERT_EQ(entries.size(), cleared);
+  ASSERT_EQ(0, wheel.PendingSize());
+  ASSERT_EQ(0, wheel.ExpiredSize());
+}
+
+}  // namespace trpc::testing
@@ -104,6 +104,7 @@ void StartRuntime() {
     options.stack_size = conf.fiber_stack_size;
     options.pool_num_by_mmap = conf.fiber_pool_num_by_mmap;
     options.stack_enable_guard_page = conf.fiber_stack_enable_guard_page;
+    options.stack_usage_sample_rate = conf.fiber_stack_usage_sample_rate;
     options.disable_process_name = global_config.thread_disable_process_name;
     options.enable_gdb_debug = conf.enable_gdb_debug;
   } else {
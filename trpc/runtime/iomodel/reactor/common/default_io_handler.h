@@ -13,6 +13,8 @@
 
 #pragma once
 
+#include <sys/sendfile.h>
+
 #include "trpc/runtime/iomodel/reactor/common/io_handler.h"
 #include "trpc/util/log/logging.h"
 
@@ -39,6 +41,14 @@ class DefaultIoHandler : public IoHandler {
     return ret;
   }
 
+  int SendFile(int fd, off_t* offset, std::size_t count) override {
+    int ret = ::sendfile(fd_, fd, offset, count);
+#ifdef TRPC_DISABLE_TCP_CORK
+    detail::FlushTcpCorkedData(fd_);
+#endif
+    return ret;
+  }
+
   Connection* GetConnection() const override { return conn_; }
 
  private:
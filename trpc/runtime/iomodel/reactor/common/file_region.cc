@@ -0,0 +1,107 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/runtime/iomodel/reactor/common/file_region.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+
+#include "trpc/runtime/iomodel/reactor/common/io_handler.h"
+#include "trpc/util/log/logging.h"
+
+namespace trpc {
+
+namespace {
+
+// `IoHandler::SendFile` returns int.
+constexpr std::size_t kMaxBytesPerSend = 1UL << 30;
+
+}  // namespace
+
+FileRegion::FileRegion(int fd, std::size_t offset, std::size_t size) : fd_(fd), offset_(offset), size_(size) {}
+
+FileRegion::~FileRegion() {
+  if (fd_ >= 0) {
+    ::close(fd_);
+  }
+}
+
+std::shared_ptr<FileRegion> FileRegion::Open(const std::string& path, std::size_t offset,
+                                             std::optional<std::size_t> size) {
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    TRPC_FMT_ERROR("Failed to open file `{}`, errno: {}", path, errno);
+    return nullptr;
+  }
+  struct stat st;
+  if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+    TRPC_FMT_ERROR("`{}` is not a regular file", path);
+    ::close(fd);
+    return nullptr;
+  }
+  auto file_size = static_cast<std::size_t>(st.st_size);
+  if (offset > file_size || (size && *size > file_size - offset)) {
+    TRPC_FMT_ERROR("Region [{}, +{}) exceeds the size of file `{}`: {}", offset, size.value_or(0), path, file_size);
+    ::close(fd);
+    return nullptr;
+  }
+  return std::make_shared<FileRegion>(fd, offset, size.value_or(file_size - offset));
+}
+
+ssize_t FileRegion::SendTo(IoHandler* io, std::size_t max_bytes) {
+  std::size_t count = std::min({size_, max_bytes, kMaxBytesPerSend});
+  off_t offset = static_cast<off_t>(offset_);
+  int n = io->SendFile(fd_, &offset, count);
+  if (n > 0) {
+    Skip(n);
+  } else if (n == 0 && count > 0) {
+    // The file was truncated.
+    errno = ENODATA;
+    return -1;
+  }
+  return n;
+}
+
+ssize_t FileRegion::ReadTo(NoncontiguousBuffer& buffer, std::size_t max_bytes) {
+  std::size_t count = std::min(size_, max_bytes);
+  NoncontiguousBufferBuilder builder;
+  std::size_t total = 0;
+  while (total < count) {
+    std::size_t len = std::min(builder.SizeAvailable(), count - total);
+    ssize_t n = ::pread(fd_, builder.data(), len, offset_ + total);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      if (total > 0) {
+        break;
+      }
+      if (n == 0) {
+        errno = ENODATA;
+      }
+      return -1;
+    }
+    builder.MarkWritten(n);
+    total += n;
+  }
+  Skip(total);
+  buffer.Append(builder.DestructiveGet());
+  return total;
+}
+
+}  // namespace trpc
@@ -0,0 +1,85 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <sys/types.h>
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+
+namespace trpc {
+
+class IoHandler;
+
+/// @brief A region of file sent after the buffer of an `IoMessage`, e.g. body of http file response. It's sent by
+///        `IoHandler::SendFile` without passing through user space (sendfile(2)), or read into user space and written
+///        as normal data if the io handler can't (e.g. ssl).
+/// @note  The region is consumed while it's being sent, so don't share it between messages. Only regular files are
+///        supported, pipes and sockets can't be waited for by the io thread sending the region without blocking it.
+class FileRegion {
+ public:
+  /// @brief Takes the ownership of `fd` of a regular file, it's closed on destruction.
+  /// @param offset is where the region begins.
+  /// @param size is the number of bytes to send.
+  FileRegion(int fd, std::size_t offset, std::size_t size);
+
+  ~FileRegion();
+
+  FileRegion(const FileRegion&) = delete;
+  FileRegion& operator=(const FileRegion&) = delete;
+
+  /// @brief Opens a region of the file at `path`.
+  /// @param size is the number of bytes from `offset`, till the end of file by default.
+  /// @return nullptr if the file can't be opened, or the region exceeds the file.
+  static std::shared_ptr<FileRegion> Open(const std::string& path, std::size_t offset = 0,
+                                          std::optional<std::size_t> size = std::nullopt);
+
+  int GetFd() const { return fd_; }
+
+  /// @brief Offset of the bytes not sent yet.
+  std::size_t GetOffset() const { return offset_; }
+
+  /// @brief Number of bytes not sent yet.
+  std::size_t GetSize() const { return size_; }
+
+  bool Empty() const { return size_ == 0; }
+
+  /// @brief Sends at most `max_bytes` by `io` without copying them into user space.
+  /// @return The number of bytes sent, -1 on error. errno is `EOPNOTSUPP` if `io` doesn't support it, and `ENODATA`
+  ///         if the file is shorter than the region.
+  ssize_t SendTo(IoHandler* io, std::size_t max_bytes);
+
+  /// @brief Reads at most `max_bytes` into `buffer`, for sending the region by io handlers not supporting `SendTo`.
+  /// @return The number of bytes read, -1 on error (see `SendTo`).
+  ssize_t ReadTo(NoncontiguousBuffer& buffer, std::size_t max_bytes);
+
+ private:
+  void Skip(std::size_t n) {
+    offset_ += n;
+    size_ -= n;
+  }
+
+ private:
+  int fd_;
+  std::size_t offset_;
+  std::size_t size_;
+};
+
+using FileRegionPtr = std::shared_ptr<FileRegion>;
+
+}  // namespace trpc
@@ -0,0 +1,158 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/runtime/iomodel/reactor/common/file_region.h"
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "trpc/runtime/iomodel/reactor/common/connection.h"
+#include "trpc/runtime/iomodel/reactor/common/default_io_handler.h"
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+
+namespace trpc::testing {
+
+namespace {
+
+constexpr char kFilePath[] = "file_region_test.bin";
+
+std::string MakeContent(std::size_t size) {
+  std::string content(size, 0);
+  for (std::size_t i = 0; i < size; ++i) {
+    content[i] = static_cast<char>('a' + i % 26);
+  }
+  return content;
+}
+
+std::string ReadAll(int fd, std::size_t size) {
+  std::string str(size, 0);
+  std::size_t read = 0;
+  while (read < size) {
+    ssize_t n = ::read(fd, str.data() + read, size - read);
+    if (n <= 0) {
+      break;
+    }
+    read += n;
+  }
+  str.resize(read);
+  return str;
+}
+
+class FileRegionTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    content_ = MakeContent(100000);
+    std::ofstream(kFilePath, std::ios::binary) << content_;
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds_), 0);
+    conn_.SetFd(fds_[0]);
+  }
+
+  void TearDown() override {
+    ::close(fds_[0]);
+    ::close(fds_[1]);
+    ::remove(kFilePath);
+  }
+
+ protected:
+  std::string content_;
+  int fds_[2];
+  Connection conn_;
+};
+
+class UnsupportedIoHandler : public IoHandler {
+ public:
+  Connection* GetConnection() const override { return nullptr; }
+  HandshakeStatus Handshake(bool is_read_event) override { return HandshakeStatus::kSucc; }
+  int Read(void* buffer, uint32_t size) override { return -1; }
+  int Writev(const iovec* iov, int iovcnt) override { return -1; }
+};
+
+}  // namespace
+
+TEST_F(FileRegionTest, Open) {
+  ASSERT_EQ(FileRegion::Open("not_exist.bin"), nullptr);
+  ASSERT_EQ(FileRegion::Open(kFilePath, content_.size() + 1), nullptr);
+  ASSERT_EQ(FileRegion::Open(kFilePath, 10, content_.size()), nullptr);
+
+  auto file = FileRegion::Open(kFilePath);
+  ASSERT_NE(file, nullptr);
+  ASSERT_EQ(file->GetOffset(), 0);
+  ASSERT_EQ(file->GetSize(), content_.size());
+
+  file = FileRegion::Open(kFilePath, 100, 200);
+  ASSERT_EQ(file->GetOffset(), 100);
+  ASSERT_EQ(file->GetSize(), 200);
+}
+
+TEST_F(FileRegionTest, SendFile) {
+  DefaultIoHandler io(&conn_);
+  auto file = FileRegion::Open(kFilePath, 1000, 50000);
+  std::size_t sent = 0;
+  while (!file->Empty()) {
+    ssize_t n = file->SendTo(&io, 8192);
+    ASSERT_GT(n, 0);
+    ASSERT_LE(n, 8192);
+    sent += n;
+    ASSERT_EQ(file->GetOffset(), 1000 + sent);
+  }
+  ASSERT_EQ(ReadAll(fds_[1], 50000), content_.substr(1000, 50000));
+}
+
+TEST_F(FileRegionTest, PipeNotSupported) {
+  // Fails instead of blocking the io thread on a pipe without data.
+  int pipe_fds[2];
+  ASSERT_EQ(::pipe(pipe_fds), 0);
+  DefaultIoHandler io(&conn_);
+  FileRegion pipe(pipe_fds[0], 0, 1000);
+  ASSERT_EQ(pipe.SendTo(&io, 4096), -1);
+  NoncontiguousBuffer buffer;
+  ASSERT_EQ(pipe.ReadTo(buffer, 4096), -1);
+  ASSERT_EQ(buffer.ByteSize(), 0);
+  ::close(pipe_fds[1]);
+}
+
+TEST_F(FileRegionTest, ReadToBuffer) {
+  UnsupportedIoHandler io;
+  auto file = FileRegion::Open(kFilePath, 10);
+  ASSERT_EQ(file->SendTo(&io, 4096), -1);
+  ASSERT_EQ(errno, EOPNOTSUPP);
+
+  NoncontiguousBuffer buffer;
+  ASSERT_EQ(file->ReadTo(buffer, 50000), 50000);
+  ASSERT_EQ(file->GetOffset(), 50010);
+  ASSERT_EQ(file->ReadTo(buffer, 100000), content_.size() - 50010);
+  ASSERT_TRUE(file->Empty());
+  ASSERT_EQ(FlattenSlow(buffer), content_.substr(10));
+}
+
+TEST_F(FileRegionTest, Truncated) {
+  DefaultIoHandler io(&conn_);
+  FileRegion file(::open(kFilePath, O_RDONLY), content_.size() - 10, 20);
+  ASSERT_EQ(file.SendTo(&io, 4096), 10);
+  ASSERT_EQ(file.SendTo(&io, 4096), -1);
+  ASSERT_EQ(errno, ENODATA);
+
+  NoncontiguousBuffer buffer;
+  ASSERT_EQ(file.ReadTo(buffer, 4096), -1);
+  ASSERT_EQ(errno, ENODATA);
+}
+
+}  // namespace trpc::testing
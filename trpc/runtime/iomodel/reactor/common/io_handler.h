@@ -14,8 +14,11 @@
 #pragma once
 
 #include <sys/socket.h>
+#include <sys/types.h>
 #include <sys/uio.h>
 
+#include <cerrno>
+#include <cstddef>
 #include <cstdint>
 
 namespace trpc {
@@ -46,6 +49,15 @@ class IoHandler {
   /// @brief write data to the connection
   virtual int Writev(const iovec* iov, int iovcnt) = 0;
 
+  /// @brief Write `count` bytes of file `fd` to the connection without copying them into user space.
+  /// @param offset is where to read the file and it's advanced.
+  /// @return The number of bytes written, -1 on error. By default it fails with errno `EOPNOTSUPP`, then the file is
+  ///         read into user space and written by `Writev` instead.
+  virtual int SendFile(int fd, off_t* offset, std::size_t count) {
+    errno = EOPNOTSUPP;
+    return -1;
+  }
+
   /// @brief Destroy IO handler.
   virtual void Destroy() {}
 };
@@ -16,6 +16,7 @@
 #include <any>
 #include <string>
 
+#include "trpc/runtime/iomodel/reactor/common/file_region.h"
 #include "trpc/util/buffer/noncontiguous_buffer.h"
 
 namespace trpc {
@@ -39,6 +40,9 @@ struct IoMessage {
   // The buffer send to network
   NoncontiguousBuffer buffer;
 
+  // The file region send to network after buffer, the message is done once both of them are sent
+  FileRegionPtr file_region;
+
   // It stores servercontext or clientcontext
   std::any msg;
 };
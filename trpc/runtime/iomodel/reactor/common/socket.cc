@@ -17,6 +17,7 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <ifaddrs.h>
+#include <linux/filter.h>
 #include <net/if.h>
 #include <net/if_arp.h>
 #include <netdb.h>
@@ -123,6 +124,31 @@ bool Socket::SetReusePort() {
   return true;
 }
 
+bool Socket::SetReusePortCpuSteering(uint32_t listener_num) {
+#if defined(SO_REUSEPORT) && defined(SO_ATTACH_REUSEPORT_CBPF) && !defined(TRPC_DISABLE_REUSEPORT)
+  if (listener_num == 0) {
+    return false;
+  }
+  // return (rx cpu) % listener_num
+  struct sock_filter code[] = {
+      {BPF_LD | BPF_W | BPF_ABS, 0, 0, static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU)},
+      {BPF_ALU | BPF_MOD | BPF_K, 0, 0, listener_num},
+      {BPF_RET | BPF_A, 0, 0, 0},
+  };
+  struct sock_fprog prog = {static_cast<uint16_t>(sizeof(code) / sizeof(code[0])), code};
+  if (SetSockOpt(SO_ATTACH_REUSEPORT_CBPF, static_cast<const void*>(&prog),
+                 static_cast<socklen_t>(sizeof(prog)), SOL_SOCKET) == -1) {
+    TRPC_LOG_ERROR("SetReusePortCpuSteering failed" << ", errno: " << errno <<
+                   ", error msg: " << strerror(errno));
+    return false;
+  }
+  return true;
+#else
+  TRPC_LOG_ERROR("SetReusePortCpuSteering is not supported");
+  return false;
+#endif
+}
+
 bool Socket::Bind(const NetworkAddress& bind_addr) {
   int ret = ::bind(fd_, bind_addr.SockAddr(), bind_addr.Socklen());
   if (ret != 0) {
@@ -108,6 +108,11 @@ class Socket {
   /// @brief Set SO_REUSEPORT
   bool SetReusePort();
 
+  /// @brief Attach a reuseport program selecting the listener by the cpu which received the packet, the connection
+  ///        received on cpu `n` goes to the `n % listener_num`-th listener bound in the SO_REUSEPORT group.
+  /// @note  Call it after bind, it is applied to the whole group. Fails if the kernel does not support it.
+  bool SetReusePortCpuSteering(uint32_t listener_num);
+
   /// @brief Set socket whether to be block
   bool SetBlock(bool block = false);
 
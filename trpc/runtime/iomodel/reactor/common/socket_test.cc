@@ -17,7 +17,9 @@
 #include <netinet/tcp.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <unistd.h>
 
+#include <chrono>
 #include <memory>
 #include <random>
 #include <thread>
@@ -147,6 +149,40 @@ TEST_F(SocketTest, ReusePort) {
 #endif
 }
 
+TEST_F(SocketTest, ReusePortCpuSteering) {
+#if defined(SO_REUSEPORT) && defined(SO_ATTACH_REUSEPORT_CBPF) && !defined(TRPC_DISABLE_REUSEPORT)
+  NetworkAddress addr = NetworkAddress(trpc::util::GenRandomAvailablePort(), false, NetworkAddress::IpType::kIpV4);
+  Socket another = Socket::CreateTcpSocket(false);
+  for (auto* sock : {tcp_ipv4_server_sock_.get(), &another}) {
+    sock->SetReuseAddr();
+    sock->SetReusePort();
+    ASSERT_TRUE(sock->Bind(addr));
+    ASSERT_TRUE(sock->Listen());
+  }
+  EXPECT_FALSE(tcp_ipv4_server_sock_->SetReusePortCpuSteering(0));
+  ASSERT_TRUE(tcp_ipv4_server_sock_->SetReusePortCpuSteering(2));
+
+  // Connection is still accepted by one of the listeners.
+  ASSERT_EQ(tcp_ipv4_client_sock_->Connect(addr), 0);
+  tcp_ipv4_server_sock_->SetBlock(false);
+  another.SetBlock(false);
+  int accepted = 0;
+  for (int i = 0; i < 100 && accepted == 0; ++i) {
+    for (auto* sock : {tcp_ipv4_server_sock_.get(), &another}) {
+      NetworkAddress peer;
+      int conn_fd = sock->Accept(&peer);
+      if (conn_fd >= 0) {
+        ::close(conn_fd);
+        ++accepted;
+      }
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_EQ(accepted, 1);
+  another.Close();
+#endif
+}
+
 TEST_F(SocketTest, SetBlock) {
   tcp_ipv4_server_sock_->SetBlock(true);
   tcp_ipv4_server_sock_->SetBlock(false);
@@ -19,7 +19,9 @@
 #include "trpc/util/async_io/async_io.h"
 #endif  // ifdef TRPC_BUILD_INCLUDE_ASYNC_IO
 #include "trpc/runtime/common/heartbeat/heartbeat_info.h"
+#include "trpc/util/buffer/memory_pool/memory_pool.h"
 #include "trpc/util/log/logging.h"
+#include "trpc/util/object_pool/object_pool.h"
 #include "trpc/util/time.h"
 
 namespace trpc {
@@ -228,6 +230,12 @@ bool ReactorImpl::TrySleep(bool ensure) {
 
   int timeout_ms = GetEpollWaitTimeout();
 
+  if (!ensure) {
+    // Return the blocks and objects of other threads freed here before going to sleep, so their owners can reuse them.
+    memory_pool::FlushRemoteFrees();
+    object_pool::FlushRemoteFrees();
+  }
+
   // From now on, if any new task is appended, the actual sleeping will be
   // interrupted quickly by the notifier.
   poller_.Dispatch(ensure ? 0 : timeout_ms);
@@ -18,8 +18,10 @@
 #include <sys/socket.h>
 #include <sys/types.h>
 
+#include <cerrno>
 #include <functional>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <utility>
 
@@ -234,23 +236,30 @@ int TcpConnection::HandleWriteEvent() {
   }
 
   int ret = 0;
-  int send_msgs_size = 0;
   struct iovec iov[kSendDataMergeNum];
 
-  // get how many DataBlocks there are
-  for (auto& msg : io_msgs_) {
-    const auto& buffer = msg.buffer;
-    send_msgs_size += buffer.size();
-  }
+  while (!io_msgs_.empty()) {
+    // The file region of a message is sent once its buffer is written out, and before the following messages.
+    if (IoMessage& front = io_msgs_.front(); front.buffer.Empty() && front.file_region) {
+      ret = WriteFileRegion(front);
+      if (ret != 0) {
+        break;
+      }
+      if (front.file_region->Empty()) {
+        MessageWriteDone(front);
+        io_msgs_.pop_front();
+        continue;
+      }
+      if (front.buffer.Empty()) {
+        need_direct_write_ = false;
+        break;
+      }
+      // Otherwise part of the file is read into the buffer, as the io handler can't send it directly.
+    }
 
-  // the index of DataBlocks has been sent
-  int index = 0;
-  while (index < send_msgs_size) {
-    int last_index = index;
     int iov_index = 0;
     // record the length of data to be sent each time
-    uint32_t total_size = 0;
-    bool flag = true;
+    std::size_t total_size = 0;
     for (auto& msg : io_msgs_) {
       const auto& buf = msg.buffer;
 
@@ -259,22 +268,21 @@ int TcpConnection::HandleWriteEvent() {
         iov[iov_index].iov_len = iter->size();
         total_size += iter->size();
 
-        ++index;
         ++iov_index;
       }
 
-      if (iov_index >= kSendDataMergeNum) {
+      // Messages behind a file region wait for it.
+      if (iov_index >= kSendDataMergeNum || msg.file_region) {
         break;
       }
     }
 
     int n = GetIoHandler()->Writev(iov, iov_index);
     if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
       if (errno != EAGAIN) {
-        if (errno == EINTR) {
-          index = last_index;
-          continue;
-        }
         ret = -1;
         TRPC_LOG_ERROR("TcpConnection::HandleWriteEvent fd:" << socket_.GetFd() << ", ip:" << GetPeerIp()
                                                              << ", port:" << GetPeerPort()
@@ -282,34 +290,33 @@ int TcpConnection::HandleWriteEvent() {
                                                              << ", write failed and connection close.");
       }
       need_direct_write_ = false;
-      flag = false;
-    } else {
-      send_data_size_ -= n;
-      if (static_cast<uint32_t>(n) < total_size) {
-        need_direct_write_ = false;
-        flag = false;
-      }
-
-      while (n > 0) {
-        IoMessage& temp = io_msgs_.front();
-        auto& buff = temp.buffer;
+      break;
+    }
 
-        if (static_cast<uint32_t>(n) >= buff.ByteSize()) {
-          n -= buff.ByteSize();
+    send_data_size_ -= n;
+    bool short_write = static_cast<std::size_t>(n) < total_size;
 
-          MessageWriteDone(temp);
+    while (!io_msgs_.empty()) {
+      IoMessage& temp = io_msgs_.front();
+      auto& buff = temp.buffer;
 
-          io_msgs_.pop_front();
-        } else {
-          buff.Skip(n);
-          break;
-        }
+      if (static_cast<uint32_t>(n) < buff.ByteSize()) {
+        buff.Skip(n);
+        break;
       }
+      n -= buff.ByteSize();
+      if (temp.file_region && !temp.file_region->Empty()) {
+        buff.Clear();
+        break;
+      }
+
+      MessageWriteDone(temp);
 
-      total_size = 0;
+      io_msgs_.pop_front();
     }
 
-    if (!flag) {
+    if (short_write) {
+      need_direct_write_ = false;
       break;
     }
   }
@@ -370,6 +377,34 @@ void TcpConnection::HandleClose(bool destroy) {
   }
 }
 
+int TcpConnection::WriteFileRegion(IoMessage& msg) {
+  auto& file = *msg.file_region;
+  while (!file.Empty()) {
+    ssize_t n = file.SendTo(GetIoHandler(), std::numeric_limits<std::size_t>::max());
+    if (n < 0 && errno == EOPNOTSUPP) {
+      n = file.ReadTo(msg.buffer, kFileReadSize);
+      if (n > 0) {
+        send_data_size_ += n;
+        return 0;
+      }
+    }
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno == EAGAIN) {
+        return 0;
+      }
+      TRPC_LOG_ERROR("TcpConnection::WriteFileRegion fd:" << socket_.GetFd() << ", ip:" << GetPeerIp()
+                                                          << ", port:" << GetPeerPort() << ", is_client:" << IsClient()
+                                                          << ", errno:" << errno
+                                                          << ", write file failed and connection close.");
+      return -1;
+    }
+  }
+  return 0;
+}
+
 void TcpConnection::MessageWriteDone(IoMessage& msg) {
   GetConnectionHandler()->MessageWriteDone(msg);
   GetConnectionHandler()->SetCurrentContextExt(msg.context_ext);
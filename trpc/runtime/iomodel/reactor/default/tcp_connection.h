@@ -58,6 +58,7 @@ class TcpConnection final : public Connection {
   void Handshaking(bool is_read_event);
   void HandleClose(bool destroy);
   void MessageWriteDone(IoMessage& msg);
+  int WriteFileRegion(IoMessage& msg);
   int JudgeConnected();
   bool PreCheckOnWrite();
   int ReadIoData(NoncontiguousBuffer& buff);
@@ -66,6 +67,8 @@ class TcpConnection final : public Connection {
   static constexpr int kSendDataMergeNum = 16;
   static constexpr uint32_t kMergeSendDataSize = 8192;
   static constexpr uint32_t kMaxIoMsgNum = 1024;
+  // Bytes of file region read at a time if the io handler can't send it directly.
+  static constexpr std::size_t kFileReadSize = 65536;
 
   Reactor* reactor_{nullptr};
 
@@ -13,9 +13,14 @@
 
 #include "trpc/runtime/iomodel/reactor/default/tcp_connection.h"
 
+#include <sys/socket.h>
+#include <unistd.h>
+
 #include <algorithm>
 #include <condition_variable>
+#include <cstdio>
 #include <deque>
+#include <fstream>
 #include <memory>
 #include <mutex>
 #include <random>
@@ -26,6 +31,7 @@
 #include "gtest/gtest.h"
 
 #include "trpc/runtime/iomodel/reactor/common/default_io_handler.h"
+#include "trpc/runtime/iomodel/reactor/common/file_region.h"
 #include "trpc/runtime/iomodel/reactor/default/reactor_impl.h"
 #include "trpc/runtime/iomodel/reactor/default/tcp_acceptor.h"
 #include "trpc/util/net_util.h"
@@ -678,4 +684,59 @@ TEST_F(TcpConnectionTest, ConnectingIoMsgLimited) {
   latch.wait();
 }
 
+// File region is sent after the buffer of its message, and before the following messages.
+TEST_F(TcpConnectionTest, SendFileRegion) {
+  constexpr char kFilePath[] = "tcp_connection_test.bin";
+  std::string content;
+  for (int i = 0; content.size() < 1024 * 1024; ++i) {
+    content += std::to_string(i);
+  }
+  std::ofstream(kFilePath, std::ios::binary) << content;
+  std::string expected = "header" + content + "tail";
+
+  int fds[2];
+  ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+
+  RefPtr<TcpConnection> conn;
+  Latch sent(1);
+  reactor_->SubmitTask([this, &conn, &fds, &sent, kFilePath] {
+    Socket socket(fds[0], AF_UNIX);
+    socket.SetBlock(false);
+    conn = MakeRefCounted<TcpConnection>(this->reactor_.get(), socket);
+    conn->SetConnId(1);
+    conn->SetConnType(ConnectionType::kTcpLong);
+    conn->SetIoHandler(std::make_unique<DefaultIoHandler>(conn.Get()));
+    conn->SetConnectionHandler(std::make_unique<TcpConnectionHandler>(conn.Get(), this->reactor_.get()));
+    conn->Established();
+
+    IoMessage file_message;
+    file_message.buffer = CreateBufferSlow("header");
+    file_message.file_region = FileRegion::Open(kFilePath);
+    EXPECT_EQ(conn->Send(std::move(file_message)), 0);
+    IoMessage tail_message;
+    tail_message.buffer = CreateBufferSlow("tail");
+    EXPECT_EQ(conn->Send(std::move(tail_message)), 0);
+    sent.count_down();
+  });
+  sent.wait();
+
+  std::string received;
+  char buf[65536];
+  while (received.size() < expected.size()) {
+    ssize_t n = ::read(fds[1], buf, sizeof(buf));
+    ASSERT_GT(n, 0);
+    received.append(buf, n);
+  }
+  ASSERT_EQ(received, expected);
+
+  Latch closed(1);
+  reactor_->SubmitTask([&conn, &closed] {
+    conn->DoClose(true);
+    closed.count_down();
+  });
+  closed.wait();
+  ::close(fds[1]);
+  ::remove(kFilePath);
+}
+
 }  // namespace trpc::testing
@@ -36,6 +36,10 @@ class FiberAcceptor : public FiberConnection {
   /// @brief Begin to listen connection
   bool Listen();
 
+  /// @brief Steer connections by the cpu receiving the packet, see `Socket::SetReusePortCpuSteering`
+  /// @note  Call it after `Listen`
+  bool SetReusePortCpuSteering(uint32_t listener_num) { return socket_.SetReusePortCpuSteering(listener_num); }
+
   /// @brief Stop listen
   void Stop();
 
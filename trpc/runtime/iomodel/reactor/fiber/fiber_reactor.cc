@@ -30,15 +30,34 @@ std::vector<std::vector<FiberReactorWorker>> fiber_reactor_workers;
 uint32_t reactor_num_per_scheduling_group = 1;
 bool reactor_keep_running = false;
 uint32_t reactor_task_queue_size = 65536;
+bool reactor_enable_async_io = false;
+uint32_t reactor_io_uring_entries = 1024;
+uint32_t reactor_io_uring_flags = 0;
 
 FiberReactor::FiberReactor(const Options& options)
     : options_(options),
       task_notifier_(this) {
+  if (options_.enable_async_io) {
+#ifdef TRPC_BUILD_INCLUDE_ASYNC_IO
+    AsyncIO::Options async_io_options;
+    async_io_options.reactor = this;
+    async_io_options.entries = options_.io_uring_entries;
+    async_io_options.flags = options_.io_uring_flags;
+
+    async_io_ = std::make_unique<AsyncIO>(async_io_options);
+#endif  // ifdef TRPC_BUILD_INCLUDE_ASYNC_IO
+  }
 }
 
 bool FiberReactor::Initialize() {
   task_notifier_.EnableNotify();
 
+#ifdef TRPC_BUILD_INCLUDE_ASYNC_IO
+  if (async_io_) {
+    async_io_->EnableNotify();
+  }
+#endif  // ifdef TRPC_BUILD_INCLUDE_ASYNC_IO
+
   return true;
 }
 
@@ -48,6 +67,12 @@ void FiberReactor::Join() {}
 
 void FiberReactor::Destroy() {
   task_notifier_.DisableNotify();
+
+#ifdef TRPC_BUILD_INCLUDE_ASYNC_IO
+  if (async_io_) {
+    async_io_->DisableNotify();
+  }
+#endif  // ifdef TRPC_BUILD_INCLUDE_ASYNC_IO
 }
 
 void FiberReactor::Run() {
@@ -159,6 +184,16 @@ void SetReactorTaskQueueSize(uint32_t size) {
   reactor_task_queue_size = size;
 }
 
+void EnableReactorAsyncIO(uint32_t io_uring_entries, uint32_t io_uring_flags) {
+#ifdef TRPC_BUILD_INCLUDE_ASYNC_IO
+  reactor_enable_async_io = true;
+  reactor_io_uring_entries = io_uring_entries;
+  reactor_io_uring_flags = io_uring_flags;
+#else
+  TRPC_FMT_WARN("Async io of fiber reactor is ignored, build with `--define trpc_include_async_io=true` to enable it.");
+#endif  // ifdef TRPC_BUILD_INCLUDE_ASYNC_IO
+}
+
 uint32_t HashFd(int fd) {
   auto xorshift = [](std::uint64_t n, std::uint64_t i) { return n ^ (n >> i); };
   uint64_t p = 0x5555555555555555;
@@ -182,6 +217,9 @@ void StartAllReactor() {
       FiberReactor::Options options;
       options.id = (static_cast<uint32_t>(sgi) << 16) | rti;
       options.max_task_queue_size = reactor_task_queue_size;
+      options.enable_async_io = reactor_enable_async_io;
+      options.io_uring_entries = reactor_io_uring_entries;
+      options.io_uring_flags = reactor_io_uring_flags;
 
       rtw.reactor = std::make_unique<FiberReactor>(options);
       TRPC_ASSERT(rtw.reactor->Initialize());
@@ -241,6 +279,13 @@ Reactor* GetReactor(std::size_t scheduling_group, int fd) {
   return ptr.get();
 }
 
+Reactor* GetAsyncIOReactor(size_t scheduling_group, int fd) {
+  if (!reactor_enable_async_io || scheduling_group >= fiber_reactor_workers.size()) {
+    return nullptr;
+  }
+  return GetReactor(scheduling_group, fd);
+}
+
 void GetAllReactor(std::vector<Reactor*>& reactors) {
   reactors.clear();
   for (std::size_t sgi = 0; sgi != fiber_reactor_workers.size(); ++sgi) {
@@ -23,6 +23,9 @@
 #include "trpc/runtime/iomodel/reactor/reactor.h"
 #include "trpc/util/align.h"
 #include "trpc/util/queue/bounded_mpsc_queue.h"
+#ifdef TRPC_BUILD_INCLUDE_ASYNC_IO
+#include "trpc/runtime/iomodel/async_io/async_io.h"
+#endif  // ifdef TRPC_BUILD_INCLUDE_ASYNC_IO
 
 namespace trpc {
 
@@ -33,6 +36,12 @@ class alignas(hardware_destructive_interference_size) FiberReactor final : publi
     uint32_t id;
 
     uint32_t max_task_queue_size{65536};
+
+    bool enable_async_io{false};
+
+    uint32_t io_uring_entries{1024};
+
+    uint32_t io_uring_flags{0};
   };
 
   explicit FiberReactor(const Options& options);
@@ -57,6 +66,11 @@ class alignas(hardware_destructive_interference_size) FiberReactor final : publi
 
   bool SubmitTask2(Task&& task, Priority priority) override;
 
+#ifdef TRPC_BUILD_INCLUDE_ASYNC_IO
+  /// @note The returned AsyncIO is not thread-safe, it must be accessed in the task submitted to this reactor.
+  AsyncIO* GetAsyncIO() const override { return async_io_.get(); }
+#endif  // ifdef TRPC_BUILD_INCLUDE_ASYNC_IO
+
  private:
   void Dispatch();
   void HandleTask();
@@ -79,6 +93,10 @@ class alignas(hardware_destructive_interference_size) FiberReactor final : publi
   std::mutex mutex_;
 
   std::list<Task> task_queue_;
+
+#ifdef TRPC_BUILD_INCLUDE_ASYNC_IO
+  std::unique_ptr<AsyncIO> async_io_;
+#endif  // ifdef TRPC_BUILD_INCLUDE_ASYNC_IO
 };
 
 namespace fiber {
@@ -113,6 +131,14 @@ void SetReactorKeepRunning();
 /// @brief Set fiber reactor task queue size
 void SetReactorTaskQueueSize(uint32_t size);
 
+/// @brief Create an io_uring for each fiber reactor started afterwards, it takes effect only if the framework is built
+///        with async io (`--define trpc_include_async_io=true`)
+void EnableReactorAsyncIO(uint32_t io_uring_entries, uint32_t io_uring_flags);
+
+/// @brief Get the fiber reactor owning an io_uring by schedulinggroup and fd, in the same way as `GetReactor`
+/// @return nullptr if async io is not enabled or fiber reactors are not running
+Reactor* GetAsyncIOReactor(size_t scheduling_group, int fd);
+
 }  // namespace fiber
 
 /// @brief Initilize and start running all fiber reactors
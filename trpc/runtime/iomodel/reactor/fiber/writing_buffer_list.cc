@@ -11,6 +11,7 @@
 #include "trpc/runtime/iomodel/reactor/fiber/writing_buffer_list.h"
 
 #include <algorithm>
+#include <cerrno>
 #include <climits>
 #include <limits>
 #include <utility>
@@ -23,6 +24,12 @@ using namespace std::literals;
 
 namespace trpc {
 
+namespace {
+
+bool HasPendingFile(const IoMessage& msg) { return msg.file_region && !msg.file_region->Empty(); }
+
+}  // namespace
+
 namespace object_pool {
 
 template <>
@@ -88,6 +95,26 @@ ssize_t WritingBufferList::FlushTo(IoHandler* io, ConnectionHandler* conn_handle
   TRPC_ASSERT(current);  // It can't be. `Append` should have already updated it.
 
   TRPC_CHECK(tail_.load(std::memory_order_relaxed), "The buffer is empty.");
+
+  // The file region of a message is sent once its buffer is written out, and before the following messages.
+  if (current->buffer.Empty() && HasPendingFile(current->io_msg)) {
+    PreSendMessage(support_pipeline, conn_handler, current);
+    auto& file = *current->io_msg.file_region;
+    std::size_t sending = std::min(file.GetSize(), max_bytes);
+    ssize_t rc = file.SendTo(io, sending);
+    if (rc >= 0 || errno != EOPNOTSUPP) {
+      *emptied = rc > 0 && file.Empty() && Rewind(head, 0, conn_handler);
+      *short_write = rc >= 0 && static_cast<std::size_t>(rc) != sending;
+      return rc;
+    }
+    // The io handler can't send file directly (e.g. ssl), so part of it is read and written as normal data.
+    ssize_t n = file.ReadTo(current->buffer, std::min(sending, kFileReadSize));
+    if (n < 0) {
+      return n;
+    }
+    size_.fetch_add(n, std::memory_order_release);
+  }
+
   while (current && nv != IOV_MAX && flushing < max_bytes) {
     for (auto iter = current->buffer.begin(); iter != current->buffer.end() && nv != IOV_MAX && flushing < max_bytes;
          ++iter) {
@@ -97,6 +124,10 @@ ssize_t WritingBufferList::FlushTo(IoHandler* io, ConnectionHandler* conn_handle
       flushing += e.iov_len;
     }
     PreSendMessage(support_pipeline, conn_handler, current);
+    // Messages behind a file region wait for it.
+    if (HasPendingFile(current->io_msg)) {
+      break;
+    }
     current = current->next.load(std::memory_order_acquire);
   }
 
@@ -116,17 +147,22 @@ ssize_t WritingBufferList::FlushTo(IoHandler* io, ConnectionHandler* conn_handle
 
   // We did write something out. Remove those buffers and update the result accordingly.
   auto flushed = static_cast<std::size_t>(rc);
-  bool drained = false;
   if (size_.fetch_sub(flushed, std::memory_order_acquire) < max_capacity) {
     writable_cv_.notify_one();
   }
 
-  // Rewind.
-  //
+  *emptied = Rewind(head, flushed, conn_handler);
+  *short_write = (static_cast<std::size_t>(rc) != flushing);
+  return rc;
+}
+
+bool WritingBufferList::Rewind(Node* head, std::size_t flushed, ConnectionHandler* conn_handler) {
+  bool drained = false;
+
   // We do not have to reload `head_`, it shouldn't have changed.
-  current = head;
+  auto current = head;
   while (current) {
-    if (auto b = current->buffer.ByteSize(); b <= flushed) {
+    if (auto b = current->buffer.ByteSize(); b <= flushed && !HasPendingFile(current->io_msg)) {
       // The entire buffer was written then.
       object_pool::LwUniquePtr<Node> destroying;
       destroying.Reset(current);  // To be freed.
@@ -166,16 +202,14 @@ ssize_t WritingBufferList::FlushTo(IoHandler* io, ConnectionHandler* conn_handle
         current = next;
       }
     } else {
-      current->buffer.Skip(flushed);
+      // The buffer is written partially, or its file region is to be sent.
+      current->buffer.Skip(std::min(b, flushed));
       // We didn't drain the list, set `head_` to where we left off.
       head_.store(current, std::memory_order_release);
       break;
     }
   }
-
-  *emptied = drained;
-  *short_write = (static_cast<std::size_t>(rc) != flushing);
-  return rc;
+  return drained;
 }
 
 WritingBufferList::BufferAppendStatus WritingBufferList::Append(NoncontiguousBuffer buffer, IoMessage&& io_msg,
@@ -70,7 +70,13 @@ class alignas(hardware_destructive_interference_size) WritingBufferList {
 
   void PreSendMessage(bool support_pipeline, ConnectionHandler* conn_handle, Node* current);
 
+  // Removes the nodes written out from `head`, returns true if the list is drained.
+  bool Rewind(Node* head, std::size_t flushed, ConnectionHandler* conn_handler);
+
  private:
+  // Bytes of file region read at a time if the io handler can't send it directly.
+  static constexpr std::size_t kFileReadSize = 65536;
+
   alignas(hardware_destructive_interference_size) std::atomic<Node*> head_{nullptr};
   alignas(hardware_destructive_interference_size) std::atomic<Node*> tail_{nullptr};
   std::atomic<size_t> size_{0};
@@ -11,6 +11,10 @@
 #include "trpc/runtime/iomodel/reactor/fiber/writing_buffer_list.h"
 
 #include <memory>
+#include <unistd.h>
+
+#include <cstdio>
+#include <fstream>
 #include <string>
 
 #include "gmock/gmock.h"
@@ -19,6 +23,7 @@
 #include "trpc/coroutine/fiber_latch.h"
 #include "trpc/coroutine/testing/fiber_runtime.h"
 #include "trpc/runtime/iomodel/reactor/common/connection_handler.h"
+#include "trpc/runtime/iomodel/reactor/common/file_region.h"
 #include "trpc/runtime/iomodel/reactor/common/io_handler.h"
 
 namespace trpc::testing {
@@ -72,6 +77,63 @@ class TestShortWriteIoHandler : public TestIoHandler {
   }
 };
 
+// Records the bytes written, and sends file by reading it if `send_file` is true.
+class RecordingIoHandler : public TestIoHandler {
+ public:
+  explicit RecordingIoHandler(bool send_file) : send_file_(send_file) {}
+
+  int Writev(const iovec* iov, int iovcnt) override {
+    int size = 0;
+    for (int i = 0; i < iovcnt; ++i) {
+      written_.append(static_cast<const char*>(iov[i].iov_base), iov[i].iov_len);
+      size += iov[i].iov_len;
+    }
+    return size;
+  }
+
+  int SendFile(int fd, off_t* offset, std::size_t count) override {
+    if (!send_file_) {
+      return TestIoHandler::SendFile(fd, offset, count);
+    }
+    std::string data(std::min<std::size_t>(count, 100), 0);
+    int n = ::pread(fd, data.data(), data.size(), *offset);
+    written_.append(data.data(), n);
+    *offset += n;
+    return n;
+  }
+
+  const std::string& GetWritten() const { return written_; }
+
+ private:
+  bool send_file_;
+  std::string written_;
+};
+
+void TestFileRegion(bool send_file) {
+  constexpr char kFilePath[] = "writing_buffer_list_test.bin";
+  std::string content;
+  for (int i = 0; i < 1000; ++i) {
+    content += std::to_string(i);
+  }
+  std::ofstream(kFilePath, std::ios::binary) << content;
+
+  WritingBufferList buffer;
+  IoMessage first_io_msg, second_io_msg;
+  first_io_msg.file_region = FileRegion::Open(kFilePath, 10);
+  buffer.Append(CreateBufferSlow("header"), std::move(first_io_msg), 0, 0);
+  buffer.Append(CreateBufferSlow("tail"), std::move(second_io_msg), 0, 0);
+
+  RecordingIoHandler io_handler(send_file);
+  MockConnHanlder mock_handler;
+  bool emptied = false;
+  bool short_write = false;
+  while (!emptied) {
+    ASSERT_GT(buffer.FlushTo(&io_handler, &mock_handler, 1024, 0, false, &emptied, &short_write), 0);
+  }
+  ASSERT_EQ(io_handler.GetWritten(), "header" + content.substr(10) + "tail");
+  ::remove(kFilePath);
+}
+
 void TestEmptied() {
   WritingBufferList buffer;
   IoMessage first_io_msg, second_io_msg;
@@ -137,6 +199,8 @@ TEST(WritingBufferList, All) {
     TestEmptied();
     TestPartialFlush();
     TestShortWrite();
+    TestFileRegion(true);
+    TestFileRegion(false);
   });
 }
 
@@ -176,6 +176,10 @@ void InitFiberReactorConfig() {
   }
 
   fiber::SetReactorTaskQueueSize(conf.reactor_task_queue_size);
+
+  if (conf.enable_async_io) {
+    fiber::EnableReactorAsyncIO(conf.io_uring_entries, conf.io_uring_flags);
+  }
 }
 
 }  // namespace trpc::runtime
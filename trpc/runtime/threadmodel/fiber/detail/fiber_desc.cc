@@ -37,6 +37,9 @@ FiberDesc* NewFiberDesc() noexcept {
 }
 
 void DestroyFiberDesc(FiberDesc* desc) noexcept {
+  // Descriptors are reused, reset the optional fields which are not set by every creator.
+  desc->stack_class = StackClass::kDefault;
+  desc->name = nullptr;
   trpc::object_pool::Delete<FiberDesc>(desc);
 }
 
@@ -11,6 +11,7 @@
 #pragma once
 
 #include "trpc/runtime/threadmodel/fiber/detail/runnable_entity.h"
+#include "trpc/runtime/threadmodel/fiber/detail/stack_allocator_impl.h"
 #include "trpc/util/align.h"
 #include "trpc/util/function.h"
 #include "trpc/util/object_pool/object_pool_ptr.h"
@@ -40,6 +41,10 @@ struct alignas(hardware_destructive_interference_size) FiberDesc
   std::uint64_t last_ready_tsc;
   bool scheduling_group_local;
   bool is_fiber_reactor = false;
+  // Size class of the stack to allocate.
+  StackClass stack_class = StackClass::kDefault;
+  // Name of the entry function for stack usage sampling, must be a static string.
+  const char* name = nullptr;
 
   FiberDesc();
 };
@@ -239,8 +239,10 @@ FiberEntity* InstantiateFiberEntity(SchedulingGroup* sg, FiberDesc* desc) noexce
 
   void* stack = nullptr;
   bool is_from_system = true;
+  StackClass stack_class = desc->stack_class;
+  uint32_t stack_size = GetFiberStackSize(stack_class);
 
-  bool succ = Allocate(&stack, &is_from_system);
+  bool succ = Allocate(stack_class, &stack, &is_from_system);
   if (TRPC_UNLIKELY(!succ)) {
     TRPC_FMT_INFO_EVERY_SECOND("CreateFiberEntity failed.");
     TRPC_ASSERT(false);
@@ -249,9 +251,15 @@ FiberEntity* InstantiateFiberEntity(SchedulingGroup* sg, FiberDesc* desc) noexce
   }
 
   fiber_count.fetch_add(1, std::memory_order_relaxed);
-  ReuseStackInSanitizer(stack);
+  ReuseStackInSanitizer(stack, stack_size);
 
-  auto ptr = reinterpret_cast<char*>(stack) + GetFiberStackSize() - kPageSize;
+  // Must be done before the stack is touched by `make_context` below.
+  bool stack_usage_sampled = ShouldSampleStackUsage();
+  if (TRPC_UNLIKELY(stack_usage_sampled)) {
+    FillStackCanary(stack, stack_size - kPageSize);
+  }
+
+  auto ptr = reinterpret_cast<char*>(stack) + stack_size - kPageSize;
   TRPC_DCHECK_EQ(reinterpret_cast<std::uintptr_t>(ptr) & (kPageSize - 1), std::uintptr_t(0));
   TRPC_DCHECK_LE(sizeof(FiberEntity), kPageSize);
   // NOT value-initialized intentionally, to save precious CPU cycles.
@@ -260,7 +268,7 @@ FiberEntity* InstantiateFiberEntity(SchedulingGroup* sg, FiberDesc* desc) noexce
   fiber->debugging_fiber_id = Next<FiberIdTraits>();
   fiber->state = FiberState::Ready;
   fiber->scheduling_group = sg;
-  fiber->stack_size = GetFiberStackSize();
+  fiber->stack_size = stack_size;
   fiber->state_save_area = make_context(fiber->GetStackTop(), fiber->GetStackLimit(), FiberProc);
   fiber->is_from_system = is_from_system;
   fiber->start_proc = std::move(desc->start_proc);
@@ -268,6 +276,10 @@ FiberEntity* InstantiateFiberEntity(SchedulingGroup* sg, FiberDesc* desc) noexce
   fiber->last_ready_tsc = desc->last_ready_tsc;
   fiber->scheduling_group_local = desc->scheduling_group_local;
   fiber->is_fiber_reactor = desc->is_fiber_reactor;
+  fiber->stack_class = stack_class;
+  fiber->stack_usage_sampled = stack_usage_sampled;
+  fiber->name = desc->name;
+  fiber->sample_tag = nullptr;
 
 #ifdef TRPC_INTERNAL_USE_ASAN
   fiber->asan_stack_bottom = stack;
@@ -284,6 +296,12 @@ FiberEntity* InstantiateFiberEntity(SchedulingGroup* sg, FiberDesc* desc) noexce
 void FreeFiberEntity(FiberEntity* fiber) noexcept {
   bool is_from_system = fiber->is_from_system;
   uint32_t fiber_stack_size = fiber->stack_size;
+  StackClass stack_class = fiber->stack_class;
+
+  if (TRPC_UNLIKELY(fiber->stack_usage_sampled)) {
+    auto stack = reinterpret_cast<char*>(fiber) + kFiberEntityToStackTopOffset - fiber_stack_size;
+    ReportStackUsage(fiber->name, stack_class, MeasureStackUsage(stack, fiber_stack_size - kPageSize));
+  }
 
   fiber_count.fetch_sub(1, std::memory_order_relaxed);
   fiber->ever_started_magic = 0;  // Hopefully the compiler does not optimize
@@ -298,7 +316,7 @@ void FreeFiberEntity(FiberEntity* fiber) noexcept {
 
   auto p = reinterpret_cast<char*>(fiber) + kFiberEntityToStackTopOffset - fiber_stack_size;
   TRPC_DCHECK_EQ(reinterpret_cast<std::uintptr_t>(p) & (kPageSize - 1), std::uintptr_t(0));
-  Deallocate(p, is_from_system);
+  Deallocate(stack_class, p, is_from_system);
 }
 
 uint32_t GetFiberCount() {
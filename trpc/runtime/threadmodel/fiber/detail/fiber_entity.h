@@ -152,6 +152,18 @@ struct alignas(hardware_destructive_interference_size) FiberEntity
   // is reactor fiber
   bool is_fiber_reactor = false;
 
+  // Size class of fiber stack.
+  StackClass stack_class = StackClass::kDefault;
+
+  // Set if the stack is filled with canary for measuring its usage on exit.
+  bool stack_usage_sampled = false;
+
+  // Name of the entry function, used by stack usage sampling and the sampling profiler.
+  const char* name = nullptr;
+
+  // Tag of samples taken by the sampling profiler while running this fiber, see `ScopedSampleTag`.
+  const char* sample_tag = nullptr;
+
   // Set if there is a pending `ResumeOn`. Cleared once `ResumeOn` completes.
   Function<void()> resume_proc = nullptr;
 
@@ -12,6 +12,7 @@
 
 #include <thread>
 
+#include "trpc/runtime/common/stats/sampling_profiler.h"
 #include "trpc/runtime/threadmodel/fiber/detail/fiber_entity.h"
 #include "trpc/runtime/threadmodel/fiber/detail/scheduling_group.h"
 #include "trpc/runtime/threadmodel/fiber/detail/stack_allocator_impl.h"
@@ -21,6 +22,19 @@
 
 namespace trpc::fiber::detail {
 
+namespace {
+
+// Samples taken while a fiber is running belong to the fiber, rather than the worker.
+SampleContext GetFiberSampleContext() noexcept {
+  auto* fiber = GetCurrentFiberEntity();
+  if (fiber == nullptr || fiber == GetMasterFiberEntity()) {
+    return {};
+  }
+  return {&fiber->sample_tag, fiber->name};
+}
+
+}  // namespace
+
 FiberWorker::FiberWorker(SchedulingGroup* sg, std::size_t worker_index,
                          bool no_cpu_migration, bool disable_process_name)
     : sg_(sg),
@@ -55,6 +69,7 @@ void FiberWorker::Start() noexcept {
     }
 
     WorkerThread::SetCurrentWorkerThread(this);
+    SamplingProfiler::GetInstance()->RegisterCurrentThread(sg_->GetThreadModeGroupName(), GetFiberSampleContext);
     WorkerProc();
   });
 
@@ -29,6 +29,7 @@ struct RunnableEntity;
 struct FiberDesc;
 struct FiberEntity;
 class SchedulingGroup;
+class SchedulingGroupVar;
 
 /// @brief Base class of scheduling used for schedule the execution of fiber tasks.
 ///        The pure virtual interface must be implemented for internal fiber scheduling/execution within a scheduling
@@ -111,6 +112,15 @@ class alignas(hardware_destructive_interference_size) Scheduling {
 
   /// @brief Get the size of fiber task in current scheduling groups's task queue
   virtual std::size_t GetFiberQueueSize() noexcept = 0;
+
+  /// @brief Set the scheduling statistics to be updated by workers, which needs to be called before starting the
+  ///        fiber worker.
+  /// @param var scheduling statistics, nullptr means statistics is disabled
+  void SetSchedulingGroupVar(SchedulingGroupVar* var) noexcept { scheduling_group_var_ = var; }
+
+ protected:
+  // Scheduling statistics of the scheduling group, nullptr if not exposed.
+  SchedulingGroupVar* scheduling_group_var_{nullptr};
 };
 
 // Set the size of the fiber's run queue.
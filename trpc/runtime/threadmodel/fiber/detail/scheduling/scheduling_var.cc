@@ -0,0 +1,166 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/runtime/threadmodel/fiber/detail/scheduling/scheduling_var.h"
+
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#ifdef TRPC_BUILD_INCLUDE_PROMETHEUS
+#include "prometheus/collectable.h"
+#include "prometheus/metric_family.h"
+
+#include "trpc/util/prometheus.h"
+#endif
+
+namespace trpc::fiber::detail {
+
+namespace {
+
+/// @brief Convert tvar path into a valid Prometheus metric name, eg. "/trpc/fiber/sg" to "trpc_fiber_sg".
+[[maybe_unused]] std::string ToPrometheusName(std::string_view abs_path) {
+  std::string name;
+  name.reserve(abs_path.size());
+  for (char c : abs_path) {
+    bool valid = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == ':';
+    if (!valid) {
+      c = '_';
+    }
+    if (c == '_' && (name.empty() || name.back() == '_')) {
+      continue;
+    }
+    name.push_back(c);
+  }
+  if (!name.empty() && name.front() >= '0' && name.front() <= '9') {
+    name.insert(name.begin(), '_');
+  }
+  return name;
+}
+
+}  // namespace
+
+#ifdef TRPC_BUILD_INCLUDE_PROMETHEUS
+/// @brief Export counters and run queue depth of a scheduling group to Prometheus.
+class SchedulingGroupPrometheusCollectable : public ::prometheus::Collectable {
+ public:
+  SchedulingGroupPrometheusCollectable(std::string name, const SchedulingGroupVar* owner)
+      : name_(std::move(name)), owner_(owner) {}
+
+  std::vector<::prometheus::MetricFamily> Collect() const override {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (owner_ == nullptr) {
+      return {};
+    }
+    std::vector<::prometheus::MetricFamily> families;
+    families.emplace_back(MakeFamily("fibers_run_total", "fibers run by workers", ::prometheus::MetricType::Counter,
+                                     static_cast<double>(owner_->GetFibersRun())));
+    families.emplace_back(MakeFamily("fibers_stolen_total", "fibers stolen by workers",
+                                     ::prometheus::MetricType::Counter,
+                                     static_cast<double>(owner_->GetFibersStolen())));
+    families.emplace_back(MakeFamily("worker_sleeps_total", "sleeps of workers", ::prometheus::MetricType::Counter,
+                                     static_cast<double>(owner_->GetWorkerSleeps())));
+    families.emplace_back(MakeFamily("run_queue_depth", "ready fibers in run queue", ::prometheus::MetricType::Gauge,
+                                     static_cast<double>(owner_->GetRunQueueDepth())));
+    return families;
+  }
+
+  /// @brief Called when owner destructs.
+  void Detach() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    owner_ = nullptr;
+  }
+
+ private:
+  ::prometheus::MetricFamily MakeFamily(std::string_view suffix, std::string help, ::prometheus::MetricType type,
+                                        double value) const {
+    ::prometheus::ClientMetric metric;
+    if (type == ::prometheus::MetricType::Counter) {
+      metric.counter.value = value;
+    } else {
+      metric.gauge.value = value;
+    }
+
+    ::prometheus::MetricFamily family;
+    family.name = name_ + "_" + std::string(suffix);
+    family.help = std::move(help);
+    family.type = type;
+    family.metric.emplace_back(std::move(metric));
+    return family;
+  }
+
+ private:
+  std::string name_;
+  mutable std::mutex mutex_;
+  const SchedulingGroupVar* owner_;
+};
+#else
+class SchedulingGroupPrometheusCollectable {};
+#endif
+
+SchedulingGroupVar::SchedulingGroupVar(std::string_view abs_path, std::size_t worker_num,
+                                       Function<std::size_t()> get_queue_size)
+    : abs_path_(abs_path),
+      worker_num_(worker_num),
+      workers_(std::make_unique<WorkerStats[]>(worker_num)),
+      get_queue_size_(std::move(get_queue_size)),
+      ready_to_run_latency_(tvar::TrpcVarGroup::FindOrCreate(abs_path), "ready_to_run_latency_ns"),
+      wakeup_latency_(tvar::TrpcVarGroup::FindOrCreate(abs_path), "wakeup_latency_ns") {
+  handle_ = tvar::TrpcVarGroup::LinkToParent("stats", tvar::TrpcVarGroup::FindOrCreate(abs_path),
+                                             [this] { return ToJsonValue(); });
+#ifdef TRPC_BUILD_INCLUDE_PROMETHEUS
+  if (handle_) {
+    prometheus_collectable_ = std::make_shared<SchedulingGroupPrometheusCollectable>(ToPrometheusName(abs_path), this);
+    trpc::prometheus::RegisterCollectable(prometheus_collectable_);
+  }
+#endif
+}
+
+SchedulingGroupVar::~SchedulingGroupVar() {
+  // Unlink from group before members destruct.
+  handle_.reset();
+#ifdef TRPC_BUILD_INCLUDE_PROMETHEUS
+  if (prometheus_collectable_) {
+    prometheus_collectable_->Detach();
+  }
+#endif
+}
+
+uint64_t SchedulingGroupVar::Sum(std::atomic<uint64_t> WorkerStats::*counter) const noexcept {
+  uint64_t sum = 0;
+  for (std::size_t i = 0; i != worker_num_; ++i) {
+    sum += (workers_[i].*counter).load(std::memory_order_relaxed);
+  }
+  return sum;
+}
+
+Json::Value SchedulingGroupVar::ToJsonValue() const {
+  Json::Value value;
+  value["run_queue_depth"] = static_cast<Json::UInt64>(GetRunQueueDepth());
+  value["fibers_run"] = static_cast<Json::UInt64>(GetFibersRun());
+  value["fibers_stolen"] = static_cast<Json::UInt64>(GetFibersStolen());
+  value["worker_sleeps"] = static_cast<Json::UInt64>(GetWorkerSleeps());
+
+  Json::Value workers(Json::arrayValue);
+  for (std::size_t i = 0; i != worker_num_; ++i) {
+    Json::Value worker;
+    worker["fibers_run"] = static_cast<Json::UInt64>(workers_[i].fibers_run.load(std::memory_order_relaxed));
+    worker["fibers_stolen"] = static_cast<Json::UInt64>(workers_[i].fibers_stolen.load(std::memory_order_relaxed));
+    worker["sleeps"] = static_cast<Json::UInt64>(workers_[i].sleeps.load(std::memory_order_relaxed));
+    workers.append(std::move(worker));
+  }
+  value["workers"] = std::move(workers);
+  return value;
+}
+
+}  // namespace trpc::fiber::detail
@@ -13,7 +13,23 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "json/json.h"
+
+#include "trpc/tvar/common/tvar_group.h"
+#include "trpc/tvar/compound_ops/histogram_recorder.h"
 #include "trpc/tvar/compound_ops/internal_latency.h"
+#include "trpc/util/align.h"
+#include "trpc/util/chrono/tsc.h"
+#include "trpc/util/function.h"
 
 namespace trpc::fiber::detail {
 
@@ -32,4 +48,99 @@ struct SchedulingVar {
   SchedulingVar() = default;
 };
 
+/// @private
+class SchedulingGroupPrometheusCollectable;
+
+/// @brief Scheduling statistics of a scheduling group, exposed by tvar (and Prometheus if enabled):
+///        - `ready_to_run_latency_ns`: histogram of time from a fiber becoming ready to it starting running.
+///        - `wakeup_latency_ns`: histogram of time from a sleeping worker being woken up to it starting running.
+///        - `stats`: current run queue depth, and the number of fibers run, fibers stolen from others and sleeps of
+///          each worker.
+/// @note  Counters are kept by each worker and only written by the worker itself, histograms are recorded into
+///        thread local buffers, they're merged only when being read. So there is no contended atomic operation on
+///        the scheduling path.
+class SchedulingGroupVar {
+ public:
+  /// @param abs_path tvar path of the scheduling group, e.g. "/trpc/fiber/scheduling_group/fiber_instance/0"
+  /// @param worker_num number of fiber workers of the scheduling group
+  /// @param get_queue_size function returning the number of ready fibers in the scheduling group
+  SchedulingGroupVar(std::string_view abs_path, std::size_t worker_num, Function<std::size_t()> get_queue_size);
+
+  ~SchedulingGroupVar();
+
+  SchedulingGroupVar(const SchedulingGroupVar&) = delete;
+  SchedulingGroupVar& operator=(const SchedulingGroupVar&) = delete;
+
+  /// @brief Called by worker when a fiber which became ready at `ready_tsc` starts running.
+  void OnFiberRun(std::size_t worker_index, uint64_t ready_tsc) noexcept {
+    ready_to_run_latency_.Update(ElapsedNanoseconds(ready_tsc));
+    if (worker_index < worker_num_) {
+      Increase(workers_[worker_index].fibers_run);
+    }
+  }
+
+  /// @brief Called by worker when it got a fiber from the queue of another worker or scheduling group.
+  void OnFiberStolen(std::size_t worker_index) noexcept {
+    if (worker_index < worker_num_) {
+      Increase(workers_[worker_index].fibers_stolen);
+    }
+  }
+
+  /// @brief Called by worker when it's woken up (at `wakeup_tsc`) from sleep.
+  void OnWorkerWakeup(std::size_t worker_index, uint64_t wakeup_tsc) noexcept {
+    wakeup_latency_.Update(ElapsedNanoseconds(wakeup_tsc));
+    if (worker_index < worker_num_) {
+      Increase(workers_[worker_index].sleeps);
+    }
+  }
+
+  /// @brief Total number of fibers run by workers.
+  uint64_t GetFibersRun() const noexcept { return Sum(&WorkerStats::fibers_run); }
+
+  /// @brief Total number of fibers stolen by workers.
+  uint64_t GetFibersStolen() const noexcept { return Sum(&WorkerStats::fibers_stolen); }
+
+  /// @brief Total number of sleeps of workers.
+  uint64_t GetWorkerSleeps() const noexcept { return Sum(&WorkerStats::sleeps); }
+
+  std::size_t GetRunQueueDepth() const { return get_queue_size_(); }
+
+  const tvar::HistogramRecorder& GetReadyToRunLatency() const noexcept { return ready_to_run_latency_; }
+
+  const tvar::HistogramRecorder& GetWakeupLatency() const noexcept { return wakeup_latency_; }
+
+  const std::string& GetAbsPath() const noexcept { return abs_path_; }
+
+ private:
+  struct alignas(hardware_destructive_interference_size) WorkerStats {
+    std::atomic<uint64_t> fibers_run{0};
+    std::atomic<uint64_t> fibers_stolen{0};
+    std::atomic<uint64_t> sleeps{0};
+  };
+
+  // Only the owner worker writes its counters, so a plain load and store is enough.
+  static void Increase(std::atomic<uint64_t>& counter) noexcept {
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  }
+
+  static uint32_t ElapsedNanoseconds(uint64_t since) noexcept {
+    auto ns = DurationFromTsc(since, ReadTsc()).count();
+    return ns < std::numeric_limits<uint32_t>::max() ? static_cast<uint32_t>(ns) : std::numeric_limits<uint32_t>::max();
+  }
+
+  uint64_t Sum(std::atomic<uint64_t> WorkerStats::*counter) const noexcept;
+
+  Json::Value ToJsonValue() const;
+
+ private:
+  std::string abs_path_;
+  std::size_t worker_num_;
+  std::unique_ptr<WorkerStats[]> workers_;
+  Function<std::size_t()> get_queue_size_;
+  tvar::HistogramRecorder ready_to_run_latency_;
+  tvar::HistogramRecorder wakeup_latency_;
+  std::optional<tvar::TrpcVarGroup::Handle> handle_;
+  std::shared_ptr<SchedulingGroupPrometheusCollectable> prometheus_collectable_;
+};
+
 }  // namespace trpc::fiber::detail
@@ -25,10 +25,12 @@
 #include "trpc/runtime/threadmodel/fiber/detail/scheduling/scheduling_var.h"
 #include "trpc/runtime/threadmodel/fiber/detail/timer_worker.h"
 #include "trpc/runtime/threadmodel/fiber/detail/waitable.h"
+#include "trpc/util/buffer/memory_pool/memory_pool.h"
 #include "trpc/util/chrono/tsc.h"
 #include "trpc/util/deferred.h"
 #include "trpc/util/latch.h"
 #include "trpc/util/log/logging.h"
+#include "trpc/util/object_pool/object_pool.h"
 #include "trpc/util/random.h"
 #include "trpc/util/string_helper.h"
 
@@ -37,6 +39,7 @@ namespace trpc::fiber::detail::v1 {
 using namespace std::literals;
 
 void SchedulingImpl::WaitSlot::Wake() noexcept {
+  wake_tsc_.store(ReadTsc(), std::memory_order_relaxed);
   if (wakeup_count_.fetch_add(1, std::memory_order_relaxed) == 0) {
     TRPC_PCHECK(syscall(SYS_futex, &wakeup_count_, FUTEX_WAKE_PRIVATE, 1, 0, 0, 0) >= 0);
   }
@@ -44,17 +47,21 @@ void SchedulingImpl::WaitSlot::Wake() noexcept {
   TRPC_CHECK_GE(wakeup_count_.load(std::memory_order_relaxed), 0);
 }
 
-void SchedulingImpl::WaitSlot::Wait() noexcept {
+std::uint64_t SchedulingImpl::WaitSlot::Wait() noexcept {
+  std::uint64_t wake_tsc = 0;
   if (wakeup_count_.fetch_sub(1, std::memory_order_relaxed) == 1) {
     do {
       auto rc = syscall(SYS_futex, &wakeup_count_, FUTEX_WAIT_PRIVATE, 0, 0, 0, 0);
       TRPC_PCHECK(rc == 0 || errno == EAGAIN);
     } while (wakeup_count_.load(std::memory_order_relaxed) == 0);
+    wake_tsc = wake_tsc_.load(std::memory_order_relaxed);
   }
   TRPC_CHECK_GT(wakeup_count_.load(std::memory_order_relaxed), 0);
+  return wake_tsc;
 }
 
 void SchedulingImpl::WaitSlot::PersistentWake() noexcept {
+  wake_tsc_.store(ReadTsc(), std::memory_order_relaxed);
   // Hopefully this is large enough.
   wakeup_count_.store(0x4000'0000, std::memory_order_relaxed);
   TRPC_PCHECK(syscall(SYS_futex, &wakeup_count_, FUTEX_WAKE_PRIVATE, INT_MAX, 0, 0, 0) >= 0);
@@ -98,6 +105,10 @@ FiberEntity* SchedulingImpl::StealFiberFromForeignSchedulingGroup() noexcept {
   while (victims_[worker_index_].top().next_steal <= steal_vec_clock_[worker_index_]) {
     auto&& top = victims_[worker_index_].top();
     if (auto rc = top.sg->RemoteAcquireFiber()) {
+      if (scheduling_group_var_) {
+        scheduling_group_var_->OnFiberStolen(worker_index_);
+        scheduling_group_var_->OnFiberRun(worker_index_, rc->last_ready_tsc);
+      }
       // We don't pop the top in this case, since it's not empty, maybe the next
       // time we try to steal, there are still something for us.
       return rc;
@@ -163,6 +174,9 @@ FiberEntity* SchedulingImpl::AcquireFiber() noexcept {
     }
 
     SchedulingVar::GetInstance()->ready_run_latency.Update(ReadTsc() - rc->last_ready_tsc);
+    if (scheduling_group_var_) {
+      scheduling_group_var_->OnFiberRun(worker_index_, rc->last_ready_tsc);
+    }
 
     return rc;
   }
@@ -280,7 +294,14 @@ FiberEntity* SchedulingImpl::WaitForFiber() noexcept {
       return f;
     }
 
-    wait_slots_[worker_index_].Wait();
+    // Return the blocks and objects of other threads freed here before going to sleep, so their owners can reuse them.
+    memory_pool::FlushRemoteFrees();
+    object_pool::FlushRemoteFrees();
+
+    auto wake_tsc = wait_slots_[worker_index_].Wait();
+    if (scheduling_group_var_ && wake_tsc) {
+      scheduling_group_var_->OnWorkerWakeup(worker_index_, wake_tsc);
+    }
 
     // We only return non-`nullptr` here. If we return `nullptr` to the caller,
     // it'll go spinning immediately. Doing that will likely waste CPU cycles.
@@ -416,6 +437,9 @@ void SchedulingImpl::Suspend(FiberEntity* self, std::unique_lock<Spinlock>&& sch
     }
 
     SchedulingVar::GetInstance()->ready_run_latency.Update(ReadTsc() - rc->last_ready_tsc);
+    if (scheduling_group_var_) {
+      scheduling_group_var_->OnFiberRun(worker_index_, rc->last_ready_tsc);
+    }
 
     rc->ResumeOn([self_lock = scheduler_lock.release()]() { self_lock->unlock(); });
   } else {
@@ -474,6 +498,9 @@ void SchedulingImpl::Yield(FiberEntity* self) noexcept {
     }
 
     SchedulingVar::GetInstance()->ready_run_latency.Update(ReadTsc() - rc->last_ready_tsc);
+    if (scheduling_group_var_) {
+      scheduling_group_var_->OnFiberRun(worker_index_, rc->last_ready_tsc);
+    }
 
     rc->ResumeOn([this, self]() {
       PostResume(self);
@@ -92,7 +92,8 @@ class alignas(hardware_destructive_interference_size) SchedulingImpl final : pub
    public:
     void Wake() noexcept;
 
-    void Wait() noexcept;
+    // Returns TSC of the wake-up if we actually slept, 0 otherwise.
+    std::uint64_t Wait() noexcept;
 
     void PersistentWake() noexcept;
 
@@ -101,6 +102,9 @@ class alignas(hardware_destructive_interference_size) SchedulingImpl final : pub
     static_assert(sizeof(std::atomic<int>) == sizeof(int));
 
     std::atomic<int> wakeup_count_{1};
+
+    // TSC of the latest `Wake()`, used for measuring wake-up latency.
+    std::atomic<std::uint64_t> wake_tsc_{0};
   };
 
   struct Victim {
@@ -28,10 +28,12 @@
 #include "trpc/runtime/threadmodel/fiber/detail/scheduling/scheduling_var.h"
 #include "trpc/runtime/threadmodel/fiber/detail/timer_worker.h"
 #include "trpc/runtime/threadmodel/fiber/detail/waitable.h"
+#include "trpc/util/buffer/memory_pool/memory_pool.h"
 #include "trpc/util/chrono/tsc.h"
 #include "trpc/util/deferred.h"
 #include "trpc/util/latch.h"
 #include "trpc/util/log/logging.h"
+#include "trpc/util/object_pool/object_pool.h"
 #include "trpc/util/random.h"
 #include "trpc/util/string_helper.h"
 
@@ -191,7 +193,13 @@ FiberEntity* SchedulingImpl::WaitForFiber() noexcept {
   }
 
   // Now I really need to relinguish my self to others
+  // Return the blocks and objects of other threads freed here before going to sleep, so their owners can reuse them.
+  memory_pool::FlushRemoteFrees();
+  object_pool::FlushRemoteFrees();
   notifier_->CommitWait(waiters_[worker_index_]);
+  if (scheduling_group_var_ && waiters_[worker_index_]->unpark_tsc) {
+    scheduling_group_var_->OnWorkerWakeup(worker_index_, waiters_[worker_index_]->unpark_tsc);
+  }
   return nullptr;
 }
 
@@ -207,6 +215,9 @@ FiberEntity* SchedulingImpl::ExploreTask() noexcept {
       }
     } else {
       fiber_entity = GetOrInstantiateFiber(local_queues_[vtm_[worker_index_]].Steal());
+      if (fiber_entity && scheduling_group_var_) {
+        scheduling_group_var_->OnFiberStolen(worker_index_);
+      }
     }
 
     if (fiber_entity) {
@@ -255,6 +266,9 @@ void SchedulingImpl::SetFiberRunning(FiberEntity* fiber_entity) noexcept {
   }
 
   SchedulingVar::GetInstance()->ready_run_latency.Update(ReadTsc() - fiber_entity->last_ready_tsc);
+  if (scheduling_group_var_) {
+    scheduling_group_var_->OnFiberRun(worker_index_, fiber_entity->last_ready_tsc);
+  }
 }
 
 void SchedulingImpl::StartFibers(FiberDesc** start, FiberDesc** end) noexcept {
@@ -374,6 +388,9 @@ void SchedulingImpl::Suspend(FiberEntity* self, std::unique_lock<Spinlock>&& sch
     }
 
     SchedulingVar::GetInstance()->ready_run_latency.Update(ReadTsc() - rc->last_ready_tsc);
+    if (scheduling_group_var_) {
+      scheduling_group_var_->OnFiberRun(worker_index_, rc->last_ready_tsc);
+    }
 
     rc->ResumeOn([self_lock = scheduler_lock.release()]() { self_lock->unlock(); });
   } else {
@@ -113,6 +113,14 @@ const std::vector<unsigned>& SchedulingGroup::Affinity() const noexcept { return
 
 void SchedulingGroup::SetTimerWorker(TimerWorker* worker) noexcept { timer_worker_ = worker; }
 
+void SchedulingGroup::ExposeSchedulingGroupVar(std::string_view abs_path) {
+  TRPC_CHECK(scheduling_ != nullptr, "The scheduling is not available yet.");
+
+  scheduling_group_var_ =
+      std::make_unique<SchedulingGroupVar>(abs_path, group_size_, [this] { return GetFiberQueueSize(); });
+  scheduling_->SetSchedulingGroupVar(scheduling_group_var_.get());
+}
+
 void SchedulingGroup::Stop() {
   TRPC_CHECK(scheduling_ != nullptr, "The scheduling is not available yet.");
 
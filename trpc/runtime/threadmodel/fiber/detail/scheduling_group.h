@@ -13,10 +13,12 @@
 #include <cstddef>
 #include <limits>
 #include <memory>
+#include <string_view>
 #include <utility>
 
 #include "trpc/runtime/threadmodel/fiber/detail/fiber_desc.h"
 #include "trpc/runtime/threadmodel/fiber/detail/scheduling/scheduling.h"
+#include "trpc/runtime/threadmodel/fiber/detail/scheduling/scheduling_var.h"
 #include "trpc/runtime/threadmodel/fiber/detail/timer_worker.h"
 #include "trpc/util/align.h"
 #include "trpc/util/check.h"
@@ -205,6 +207,14 @@ class alignas(hardware_destructive_interference_size) SchedulingGroup {
   /// @brief Get the size of fiber task in current scheduling groups's task queue.
   std::size_t GetFiberQueueSize() const noexcept { return scheduling_->GetFiberQueueSize(); }
 
+  /// @brief Expose scheduling statistics (run queue depth, ready-to-run latency, wake-up latency, etc.) of this
+  ///        scheduling group to tvar under `abs_path`. Statistics are not collected unless this method is called.
+  /// @note  Must be called before starting the fiber workers.
+  void ExposeSchedulingGroupVar(std::string_view abs_path);
+
+  /// @brief Get scheduling statistics of this scheduling group, nullptr if not exposed.
+  const SchedulingGroupVar* GetSchedulingGroupVar() const noexcept { return scheduling_group_var_.get(); }
+
   /// @brief Get and set the logical id of scheduling group.
   uint8_t GetSchedulingGroupId() const { return sg_id_; }
   void SetSchedulingGroupId(uint8_t sg_id) { sg_id_ = sg_id; }
@@ -238,6 +248,9 @@ class alignas(hardware_destructive_interference_size) SchedulingGroup {
 
   TimerWorker* timer_worker_{nullptr};
 
+  // Declared before `scheduling_`, which refers to it.
+  std::unique_ptr<SchedulingGroupVar> scheduling_group_var_{nullptr};
+
   std::unique_ptr<Scheduling> scheduling_{nullptr};
 };
 
@@ -22,6 +22,7 @@
 #include "trpc/runtime/threadmodel/fiber/detail/testing.h"
 #include "trpc/runtime/threadmodel/fiber/detail/timer_worker.h"
 #include "trpc/runtime/threadmodel/fiber/detail/waitable.h"
+#include "trpc/tvar/common/tvar_group.h"
 #include "trpc/util/chrono/chrono.h"
 #include "trpc/util/random.h"
 #include "trpc/util/string_helper.h"
@@ -439,4 +440,59 @@ TEST(SchedulingGroup, FiberYieldOnScheduling) {
   }
 }
 
+void TestSchedulingGroupVar(std::string_view scheduling_name) {
+  constexpr auto N = 10000;
+  std::string path = "/trpc/fiber/scheduling_group/ut/" + std::string(scheduling_name);
+
+  auto scheduling_group = std::make_unique<SchedulingGroup>(std::vector<unsigned>{}, 4, scheduling_name);
+  ASSERT_EQ(nullptr, scheduling_group->GetSchedulingGroupVar());
+  scheduling_group->ExposeSchedulingGroupVar(path);
+  auto var = scheduling_group->GetSchedulingGroupVar();
+  ASSERT_NE(nullptr, var);
+
+  std::thread workers[4];
+  TimerWorker dummy(scheduling_group.get());
+  scheduling_group->SetTimerWorker(&dummy);
+  for (int i = 0; i != 4; ++i) {
+    workers[i] = std::thread(WorkerTest, scheduling_group.get(), i);
+  }
+
+  Context context;
+  for (int i = 0; i != N; ++i) {
+    fiber::testing::StartFiberEntityInGroup(scheduling_group.get(), [&] { FiberProc(&context); });
+  }
+  while (context.executed_fibers != N) {
+    std::this_thread::sleep_for(10ms);
+  }
+  // Every fiber starts running once, and is resumed after each yield.
+  ASSERT_GE(var->GetFibersRun(), N * 11);
+  ASSERT_GE(var->GetReadyToRunLatency().GetHistogram().Count(), N * 11);
+
+  // Workers go to sleep once idle, and they're woken up by new fibers.
+  while (var->GetWorkerSleeps() == 0) {
+    std::this_thread::sleep_for(10ms);
+    fiber::testing::StartFiberEntityInGroup(scheduling_group.get(), [] {});
+  }
+  ASSERT_GT(var->GetWakeupLatency().GetHistogram().Count(), 0);
+
+  auto stats = tvar::TrpcVarGroup::TryGet(path + "/stats");
+  ASSERT_TRUE(stats);
+  ASSERT_GT((*stats)["fibers_run"].asUInt64(), 0);
+  ASSERT_EQ(4, (*stats)["workers"].size());
+  ASSERT_TRUE((*stats).isMember("run_queue_depth"));
+  ASSERT_TRUE(tvar::TrpcVarGroup::TryGet(path + "/ready_to_run_latency_ns"));
+  ASSERT_TRUE(tvar::TrpcVarGroup::TryGet(path + "/wakeup_latency_ns"));
+
+  scheduling_group->Stop();
+  for (auto&& t : workers) {
+    t.join();
+  }
+}
+
+TEST(SchedulingGroup, SchedulingGroupVarOnScheduling) {
+  for (auto& name : kSchedulingNames) {
+    TestSchedulingGroupVar(name);
+  }
+}
+
 }  // namespace trpc::fiber::detail
@@ -22,8 +22,13 @@
 #include <sys/mman.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cstdlib>
+#include <map>
+#include <string>
 #include <thread>
+#include <utility>
 
 #include "trpc/runtime/threadmodel/fiber/detail/assembly.h"
 #include "trpc/util/check.h"
@@ -38,6 +43,7 @@ static uint32_t fiber_stack_size = 131072;
 static bool fiber_stack_enable_guard_page = true;
 static uint32_t max_fiber_num_by_mmap = 30 * 1024;
 static bool enable_gdb_debug = false;
+static uint32_t stack_usage_sample_rate = 0;
 
 const uint32_t kPageSize = getpagesize();
 
@@ -166,6 +172,31 @@ uint32_t GetFiberStackSize() {
   return fiber_stack_size;
 }
 
+uint32_t GetFiberStackSize(StackClass stack_class) {
+  switch (stack_class) {
+    case StackClass::kSmall: {
+      // At least two pages, one of which is taken by the fiber entity.
+      uint32_t min_size = std::max<uint32_t>((16384 + kPageSize - 1) / kPageSize * kPageSize, kPageSize * 2);
+      return std::max<uint32_t>(fiber_stack_size / 4 / kPageSize * kPageSize, min_size);
+    }
+    case StackClass::kLarge:
+      return fiber_stack_size * 4;
+    default:
+      return fiber_stack_size;
+  }
+}
+
+const char* GetStackClassName(StackClass stack_class) {
+  switch (stack_class) {
+    case StackClass::kSmall:
+      return "small";
+    case StackClass::kLarge:
+      return "large";
+    default:
+      return "default";
+  }
+}
+
 void SetFiberStackEnableGuardPage(bool flag) {
   fiber_stack_enable_guard_page = flag;
 }
@@ -178,6 +209,10 @@ void SetEnableGdbDebug(bool flag) {
   enable_gdb_debug = flag;
 }
 
+void SetFiberStackUsageSampleRate(uint32_t rate) {
+  stack_usage_sample_rate = rate;
+}
+
 // We always align stack top to 1M boundary. This helps our GDB plugin to find
 // fiber stacks.
 constexpr auto kStackTopAlignment = 1 * 1024 * 1024;
@@ -196,12 +231,12 @@ void InitializeFiberStackMagic(void* ptr) {
 
 inline std::size_t GetBias() { return fiber_stack_enable_guard_page ? kPageSize : 0; }
 
-inline std::size_t GetAllocationsize() {
-  TRPC_CHECK(fiber_stack_size % kPageSize == 0,
-             "Stack size ({}) must be a multiple of page size ({}).", fiber_stack_size,
+inline std::size_t GetAllocationsize(uint32_t stack_size) {
+  TRPC_CHECK(stack_size % kPageSize == 0,
+             "Stack size ({}) must be a multiple of page size ({}).", stack_size,
              kPageSize);
 
-  return fiber_stack_size + GetBias();
+  return stack_size + GetBias();
 }
 
 void* AlignedMmapImp(std::size_t desired_size, std::size_t alignment, int prot, int flags) {
@@ -242,8 +277,8 @@ void* AlignedMmapImp(std::size_t desired_size, std::size_t alignment, int prot,
   return reinterpret_cast<void*>(desired_start);
 }
 
-void* AlignedMmap() {
-  auto p = AlignedMmapImp(GetAllocationsize(), kStackTopAlignment, PROT_READ | PROT_WRITE,
+void* AlignedMmap(uint32_t stack_size) {
+  auto p = AlignedMmapImp(GetAllocationsize(stack_size), kStackTopAlignment, PROT_READ | PROT_WRITE,
                        MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK);
   // p == nullptr，due to exceeds the protected threshold, so we return directly to avoid the program being aborted
   if (TRPC_UNLIKELY(!p)) {
@@ -260,10 +295,10 @@ void* AlignedMmap() {
     }
   }
   auto stack = reinterpret_cast<char*>(p) + GetBias();
-  InitializeFiberStackMagic(stack + fiber_stack_size - kPageSize);
+  InitializeFiberStackMagic(stack + stack_size - kPageSize);
 
   if (enable_gdb_debug) {
-    auto stack_bottom = stack + fiber_stack_size;
+    auto stack_bottom = stack + stack_size;
     // Register the stack.
     stack_registry.RegisterStack(stack_bottom);
   }
@@ -271,26 +306,26 @@ void* AlignedMmap() {
   return reinterpret_cast<void*>(stack);
 }
 
-void AlignedMunmap(void* ptr) {
+void AlignedMunmap(void* ptr, uint32_t stack_size) {
   if (enable_gdb_debug) {
     // Remove the stack from our registry.
-    auto stack_bottom = reinterpret_cast<char*>(ptr) + fiber_stack_size;
+    auto stack_bottom = reinterpret_cast<char*>(ptr) + stack_size;
     stack_registry.DeregisterStack(stack_bottom);
   }
 
-  TRPC_PCHECK(munmap(reinterpret_cast<char*>(ptr) - GetBias(), GetAllocationsize()) == 0);
+  TRPC_PCHECK(munmap(reinterpret_cast<char*>(ptr) - GetBias(), GetAllocationsize(stack_size)) == 0);
 }
 
-void* AlignedMalloc() {
-  void* p = aligned_alloc(kPageSize, GetAllocationsize());
+void* AlignedMalloc(uint32_t stack_size) {
+  void* p = aligned_alloc(kPageSize, GetAllocationsize(stack_size));
   if (!p) {
     return nullptr;
   }
   auto stack = reinterpret_cast<char*>(p);
-  InitializeFiberStackMagic(stack + fiber_stack_size - kPageSize);
+  InitializeFiberStackMagic(stack + stack_size - kPageSize);
 
   if (enable_gdb_debug) {
-    auto stack_bottom = stack + fiber_stack_size;
+    auto stack_bottom = stack + stack_size;
     // Register the stack.
     stack_registry.RegisterStack(stack_bottom);
   }
@@ -298,32 +333,38 @@ void* AlignedMalloc() {
   return reinterpret_cast<void*>(stack);
 }
 
-void AlignedFree(void* aligned_mem) {
+void AlignedFree(void* aligned_mem, uint32_t stack_size) {
   if (enable_gdb_debug) {
     // Remove the stack from our registry.
-    auto stack_bottom = reinterpret_cast<char*>(aligned_mem) + fiber_stack_size;
+    auto stack_bottom = reinterpret_cast<char*>(aligned_mem) + stack_size;
     stack_registry.DeregisterStack(stack_bottom);
   }
 
   return free(aligned_mem);
 }
 
-void* AllocateFiberStack(bool use_mmap) {
+void* AllocateFiberStack(bool use_mmap, uint32_t stack_size) {
   if (TRPC_LIKELY(use_mmap)) {
-    return AlignedMmap();
+    return AlignedMmap(stack_size);
   }
 
-  return AlignedMalloc();
+  return AlignedMalloc(stack_size);
 }
 
-void DeallocateFiberStack(void* stack_ptr, bool use_mmap) {
+void DeallocateFiberStack(void* stack_ptr, bool use_mmap, uint32_t stack_size) {
   if (TRPC_LIKELY(use_mmap)) {
-    AlignedMunmap(stack_ptr);
+    AlignedMunmap(stack_ptr, stack_size);
   } else {
-    AlignedFree(stack_ptr);
+    AlignedFree(stack_ptr, stack_size);
   }
 }
 
+void* AllocateFiberStack(bool use_mmap) { return AllocateFiberStack(use_mmap, fiber_stack_size); }
+
+void DeallocateFiberStack(void* stack_ptr, bool use_mmap) {
+  DeallocateFiberStack(stack_ptr, use_mmap, fiber_stack_size);
+}
+
 constexpr std::size_t kFiberStackNum = 32;       // The number of fiber stacks that a Block can accommodate
 constexpr std::size_t kBlockNum = 32;            // The number of Blocks contained in a BlockChunk
 constexpr std::size_t kFreeFiberStackNum = 32;   // The length of the recycle list for free Blocks
@@ -735,9 +776,235 @@ void Deallocate(void* stack_ptr, bool is_system) noexcept {
   GetLocalPool()->Deallocate(stack_ptr, is_system);
 }
 
+// The number of free lists of each non-default class kept by the global pool, stacks freed beyond it are released to
+// the system, so a burst of fibers doesn't pin its stacks (and memory regions) forever.
+constexpr std::size_t kSizedStackFreeListNum = 16;
+
+// Pool of fiber stacks of the non-default classes. They are far less used than the default class, so a thread-local
+// free list backed by a locked global one is good enough.
+// Like the default class, at most `max_fiber_num_by_mmap` stacks of each class are mmapped (each takes 2 memory regions
+// with guard page), stacks beyond that are allocated from the system by malloc.
+class SizedStackPool {
+ public:
+  bool Allocate(StackClass stack_class, void** stack_ptr, bool* is_system) noexcept {
+    auto& local = GetLocalFreeStacks(stack_class);
+    if (local.head == nullptr) {
+      std::scoped_lock _(lock_);
+      auto& global = global_free_stacks_[static_cast<std::size_t>(stack_class)];
+      if (!global.empty()) {
+        local = global.back();
+        global.pop_back();
+      }
+    }
+
+    if (TRPC_LIKELY(local.head != nullptr)) {
+      FiberStack* res = local.head;
+      local.head = res->next;
+      --local.length;
+      *stack_ptr = static_cast<void*>(res);
+      *is_system = false;
+      return true;
+    }
+
+    uint32_t stack_size = GetFiberStackSize(stack_class);
+    auto& mmap_num = mmap_stack_num_[static_cast<std::size_t>(stack_class)];
+    if (mmap_num.fetch_add(1, std::memory_order_relaxed) < max_fiber_num_by_mmap) {
+      *stack_ptr = AllocateFiberStack(true, stack_size);
+      if (TRPC_LIKELY(*stack_ptr != nullptr)) {
+        *is_system = false;
+        return true;
+      }
+    } else {
+      TRPC_FMT_INFO_EVERY_SECOND("{} fiber stacks allocated by mmap, beyond {} limited.",
+                                 GetStackClassName(stack_class), max_fiber_num_by_mmap);
+    }
+    mmap_num.fetch_sub(1, std::memory_order_relaxed);
+
+    // Allocate from system
+    *stack_ptr = AllocateFiberStack(false, stack_size);
+    *is_system = true;
+    return *stack_ptr != nullptr;
+  }
+
+  void Deallocate(StackClass stack_class, void* stack_ptr, bool is_system) noexcept {
+    if (is_system) {
+      DeallocateFiberStack(stack_ptr, false, GetFiberStackSize(stack_class));
+      return;
+    }
+
+    auto& local = GetLocalFreeStacks(stack_class);
+    if (TRPC_UNLIKELY(local.length == kFreeFiberStackNum)) {
+      PushFreeStacks(stack_class, local);
+    }
+
+    auto* stack = static_cast<FiberStack*>(stack_ptr);
+    stack->next = local.head;
+    local.head = stack;
+    ++local.length;
+  }
+
+  void PushFreeStacks(StackClass stack_class, FreekFiberStacks& free_stacks) noexcept {
+    bool kept = false;
+    {
+      std::scoped_lock _(lock_);
+      auto& global = global_free_stacks_[static_cast<std::size_t>(stack_class)];
+      if (global.size() < kSizedStackFreeListNum) {
+        global.push_back(free_stacks);
+        kept = true;
+      }
+    }
+
+    if (!kept) {
+      uint32_t stack_size = GetFiberStackSize(stack_class);
+      while (free_stacks.head != nullptr) {
+        FiberStack* stack = free_stacks.head;
+        free_stacks.head = stack->next;
+        DeallocateFiberStack(stack, true, stack_size);
+      }
+      mmap_stack_num_[static_cast<std::size_t>(stack_class)].fetch_sub(static_cast<uint32_t>(free_stacks.length),
+                                                                     std::memory_order_relaxed);
+    }
+    free_stacks.head = nullptr;
+    free_stacks.length = 0;
+  }
+
+ private:
+  // Free lists of the current thread, returned to the global pool when the thread exits.
+  struct LocalFreeStacks {
+    SizedStackPool* pool = nullptr;
+    FreekFiberStacks free_stacks[kStackClassNum];
+
+    ~LocalFreeStacks() {
+      for (std::size_t i = 0; i != kStackClassNum; ++i) {
+        if (free_stacks[i].length > 0) {
+          pool->PushFreeStacks(static_cast<StackClass>(i), free_stacks[i]);
+        }
+      }
+    }
+  };
+
+  FreekFiberStacks& GetLocalFreeStacks(StackClass stack_class) noexcept {
+    thread_local LocalFreeStacks local{this};
+    return local.free_stacks[static_cast<std::size_t>(stack_class)];
+  }
+
+ private:
+  std::mutex lock_;
+  std::vector<FreekFiberStacks> global_free_stacks_[kStackClassNum];
+  // The number of stacks of each class allocated by mmap, either in use or free.
+  std::atomic<uint32_t> mmap_stack_num_[kStackClassNum] = {};
+};
+
+SizedStackPool* GetSizedStackPool() noexcept {
+  // Never destroyed for the same reason as the global pool of default class.
+  static trpc::internal::NeverDestroyed<SizedStackPool> pool;
+  return pool.Get();
+}
+
+bool Allocate(StackClass stack_class, void** stack_ptr, bool* is_system) noexcept {
+  if (TRPC_LIKELY(stack_class == StackClass::kDefault)) {
+    return Allocate(stack_ptr, is_system);
+  }
+  return GetSizedStackPool()->Allocate(stack_class, stack_ptr, is_system);
+}
+
+void Deallocate(StackClass stack_class, void* stack_ptr, bool is_system) noexcept {
+  if (TRPC_LIKELY(stack_class == StackClass::kDefault)) {
+    return Deallocate(stack_ptr, is_system);
+  }
+  GetSizedStackPool()->Deallocate(stack_class, stack_ptr, is_system);
+}
+
+// Pattern filled into sampled stacks, a word which is unlikely written by any frame.
+constexpr std::uint64_t kStackCanary = 0x5452504353544b43;  // "TRPCSTKC"
+
+bool ShouldSampleStackUsage() noexcept {
+  uint32_t rate = stack_usage_sample_rate;
+  if (TRPC_LIKELY(rate == 0)) {
+    return false;
+  }
+  thread_local uint32_t counter = 0;
+  return ++counter % rate == 0;
+}
+
+void FillStackCanary(void* stack_ptr, std::size_t size) noexcept {
+  auto* words = static_cast<std::uint64_t*>(stack_ptr);
+  for (std::size_t i = 0; i != size / sizeof(std::uint64_t); ++i) {
+    words[i] = kStackCanary;
+  }
+}
+
+std::size_t MeasureStackUsage(const void* stack_ptr, std::size_t size) noexcept {
+  // Stack grows downwards, so the lowest word overwritten is the high-water mark.
+  auto* words = static_cast<const std::uint64_t*>(stack_ptr);
+  std::size_t count = size / sizeof(std::uint64_t);
+  std::size_t i = 0;
+  while (i != count && words[i] == kStackCanary) {
+    ++i;
+  }
+  return (count - i) * sizeof(std::uint64_t);
+}
+
+namespace {
+
+struct StackUsageAccumulator {
+  uint64_t samples = 0;
+  std::size_t max_used = 0;
+  uint64_t total_used = 0;
+};
+
+struct StackUsageRegistry {
+  std::mutex lock;
+  std::map<std::pair<std::string, StackClass>, StackUsageAccumulator> usages;
+};
+
+StackUsageRegistry* GetStackUsageRegistry() {
+  static trpc::internal::NeverDestroyed<StackUsageRegistry> registry;
+  return registry.Get();
+}
+
+}  // namespace
+
+void ReportStackUsage(const char* name, StackClass stack_class, std::size_t used) noexcept {
+  auto* registry = GetStackUsageRegistry();
+  std::scoped_lock _(registry->lock);
+  auto& usage = registry->usages[{name ? name : "unnamed", stack_class}];
+  ++usage.samples;
+  usage.max_used = std::max(usage.max_used, used);
+  usage.total_used += used;
+}
+
+std::vector<StackUsage> GetStackUsages() {
+  std::vector<StackUsage> result;
+  auto* registry = GetStackUsageRegistry();
+  std::scoped_lock _(registry->lock);
+  result.reserve(registry->usages.size());
+  for (const auto& [key, usage] : registry->usages) {
+    StackUsage item;
+    item.name = key.first;
+    item.stack_class = key.second;
+    item.stack_size = GetFiberStackSize(key.second);
+    item.samples = usage.samples;
+    item.max_used = usage.max_used;
+    item.avg_used = usage.total_used / usage.samples;
+    result.push_back(std::move(item));
+  }
+  return result;
+}
+
+void ResetStackUsages() {
+  auto* registry = GetStackUsageRegistry();
+  std::scoped_lock _(registry->lock);
+  registry->usages.clear();
+}
+
 void ReuseStackInSanitizer(void* stack_ptr) {
+  ReuseStackInSanitizer(stack_ptr, fiber_stack_size);
+}
+
+void ReuseStackInSanitizer(void* stack_ptr, uint32_t stack_size) {
 #ifdef TRPC_INTERNAL_USE_ASAN
-  trpc::internal::asan::UnpoisonMemoryRegion(stack_ptr, fiber_stack_size);
+  trpc::internal::asan::UnpoisonMemoryRegion(stack_ptr, stack_size);
 #endif
 }
 
@@ -17,10 +17,24 @@
 #include <cstdint>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <vector>
 
 namespace trpc::fiber::detail {
 
+/// @brief Size classes of fiber stacks. Each class has its own pool, so a fiber only takes as much stack as it needs.
+enum class StackClass : uint8_t {
+  /// @brief `fiber_stack_size` in config, pooled by `PrewarmFiberPool` and the block pools below.
+  kDefault = 0,
+  /// @brief A quarter of the default size (at least 16K), for the large number of short-lived or parked fibers.
+  kSmall = 1,
+  /// @brief Four times of the default size, for deep handlers.
+  kLarge = 2,
+};
+
+/// @brief Number of stack classes.
+constexpr std::size_t kStackClassNum = 3;
+
 /// @brief Set whether to use mmap to allocate memory stacks for fibers
 void SetFiberPoolCreateWay(bool use_mmap);
 
@@ -30,6 +44,12 @@ void SetFiberStackSize(uint32_t stack_size);
 /// @brief Get the stack size of memory blocks used by fibers
 uint32_t GetFiberStackSize();
 
+/// @brief Get the stack size of memory blocks of `stack_class`.
+uint32_t GetFiberStackSize(StackClass stack_class);
+
+/// @brief Get the name of stack class, e.g. "small".
+const char* GetStackClassName(StackClass stack_class);
+
 /// @brief Set whether memory page protection is applied to memory blocks allocated through mmap
 void SetFiberStackEnableGuardPage(bool flag);
 
@@ -54,8 +74,48 @@ bool Allocate(void** stack_ptr, bool* is_system) noexcept;
 /// @param is_system Whether the allocated memory block is directly allocated from the system
 void Deallocate(void* stack_ptr, bool is_system) noexcept;
 
+/// @brief Allocate fiber stack of `stack_class`, the same as `Allocate` for `StackClass::kDefault`.
+bool Allocate(StackClass stack_class, void** stack_ptr, bool* is_system) noexcept;
+
+/// @brief Release fiber stack allocated by `Allocate(stack_class, ...)`.
+void Deallocate(StackClass stack_class, void* stack_ptr, bool is_system) noexcept;
+
 // Diagnosing using memory analysis and detection tools
 void ReuseStackInSanitizer(void* stack_ptr);
+void ReuseStackInSanitizer(void* stack_ptr, uint32_t stack_size);
+
+/// @brief Sample the stack usage of one in every `rate` fibers, 0 disables sampling (the default).
+/// @note  Sampled stacks are filled with canary on creation and scanned on exit, which costs a few microseconds.
+void SetFiberStackUsageSampleRate(uint32_t rate);
+
+/// @brief Whether the fiber being created should be sampled, it is cheap when sampling is disabled.
+bool ShouldSampleStackUsage() noexcept;
+
+/// @brief Fill the usable part of stack `[stack_ptr, stack_ptr + size)` with canary.
+void FillStackCanary(void* stack_ptr, std::size_t size) noexcept;
+
+/// @brief Measure the high-water mark of a stack filled by `FillStackCanary`, i.e. the bytes ever written from the
+///        top of the stack.
+std::size_t MeasureStackUsage(const void* stack_ptr, std::size_t size) noexcept;
+
+/// @brief Record a measured stack usage of the fiber named `name` (nullptr for unnamed fibers).
+void ReportStackUsage(const char* name, StackClass stack_class, std::size_t used) noexcept;
+
+/// @brief Sampled stack usage of fibers with the same name and stack class.
+struct StackUsage {
+  std::string name;
+  StackClass stack_class = StackClass::kDefault;
+  uint32_t stack_size = 0;
+  uint64_t samples = 0;
+  std::size_t max_used = 0;
+  std::size_t avg_used = 0;
+};
+
+/// @brief Get sampled stack usages, sorted by name.
+std::vector<StackUsage> GetStackUsages();
+
+/// @brief Clear sampled stack usages.
+void ResetStackUsages();
 
 /// @brief Data statistics for creating/releasing memory pool for fiber stack
 struct alignas(64) Statistics {
@@ -15,8 +15,11 @@
 
 #include <unistd.h>
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <thread>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -133,4 +136,92 @@ TEST(StackAllocatorImpl, PrewarmFiberPool) {
   ASSERT_TRUE(prewarm_nun == 1024);
 }
 
+TEST(StackAllocatorImpl, StackClass) {
+  SetFiberStackSize(131072);
+  ASSERT_EQ(GetFiberStackSize(StackClass::kDefault), 131072);
+  ASSERT_EQ(GetFiberStackSize(StackClass::kSmall), 32768);
+  ASSERT_EQ(GetFiberStackSize(StackClass::kLarge), 524288);
+
+  for (auto stack_class : {StackClass::kSmall, StackClass::kLarge}) {
+    std::vector<void*> stacks;
+    // More than a thread-local free list holds.
+    for (int i = 0; i < 100; ++i) {
+      void* stack_ptr = nullptr;
+      bool is_system = true;
+      ASSERT_TRUE(Allocate(stack_class, &stack_ptr, &is_system));
+      ASSERT_FALSE(is_system);
+      // The whole stack is writable.
+      memset(stack_ptr, 0, GetFiberStackSize(stack_class));
+      stacks.push_back(stack_ptr);
+    }
+    for (auto* stack_ptr : stacks) {
+      Deallocate(stack_class, stack_ptr, false);
+    }
+
+    // Freed stacks are reused.
+    void* stack_ptr = nullptr;
+    bool is_system = true;
+    ASSERT_TRUE(Allocate(stack_class, &stack_ptr, &is_system));
+    ASSERT_NE(std::find(stacks.begin(), stacks.end(), stack_ptr), stacks.end());
+    Deallocate(stack_class, stack_ptr, is_system);
+  }
+}
+
+TEST(StackAllocatorImpl, StackClassBeyondMmapLimit) {
+  SetFiberStackSize(131072);
+  // Stacks beyond the limit are allocated from system instead of failing, once the free ones are used up.
+  SetFiberPoolNumByMmap(0);
+  std::vector<std::pair<void*, bool>> stacks;
+  int system_num = 0;
+  for (int i = 0; i < 200; ++i) {
+    void* stack_ptr = nullptr;
+    bool is_system = false;
+    ASSERT_TRUE(Allocate(StackClass::kLarge, &stack_ptr, &is_system));
+    memset(stack_ptr, 0, GetFiberStackSize(StackClass::kLarge));
+    system_num += is_system;
+    stacks.emplace_back(stack_ptr, is_system);
+  }
+  ASSERT_GT(system_num, 0);
+  for (auto& [stack_ptr, is_system] : stacks) {
+    Deallocate(StackClass::kLarge, stack_ptr, is_system);
+  }
+  SetFiberPoolNumByMmap(30 * 1024);
+}
+
+TEST(StackAllocatorImpl, StackUsage) {
+  std::vector<char> stack(16384);
+  FillStackCanary(stack.data(), stack.size());
+  ASSERT_EQ(MeasureStackUsage(stack.data(), stack.size()), 0);
+
+  // Stack grows downwards.
+  memset(stack.data() + stack.size() - 1000, 1, 1000);
+  ASSERT_EQ(MeasureStackUsage(stack.data(), stack.size()), 1000);
+
+  ResetStackUsages();
+  ReportStackUsage("entry", StackClass::kSmall, 1000);
+  ReportStackUsage("entry", StackClass::kSmall, 3000);
+  ReportStackUsage(nullptr, StackClass::kDefault, 100);
+  auto usages = GetStackUsages();
+  ASSERT_EQ(usages.size(), 2);
+  ASSERT_EQ(usages[0].name, "entry");
+  ASSERT_EQ(usages[0].samples, 2);
+  ASSERT_EQ(usages[0].max_used, 3000);
+  ASSERT_EQ(usages[0].avg_used, 2000);
+  ASSERT_EQ(usages[1].name, "unnamed");
+  ResetStackUsages();
+}
+
+TEST(StackAllocatorImpl, SampleRate) {
+  SetFiberStackUsageSampleRate(0);
+  ASSERT_FALSE(ShouldSampleStackUsage());
+
+  SetFiberStackUsageSampleRate(2);
+  int sampled = 0;
+  for (int i = 0; i < 10; ++i) {
+    sampled += ShouldSampleStackUsage();
+  }
+  ASSERT_EQ(sampled, 5);
+  SetFiberStackUsageSampleRate(0);
+}
+
 }  // namespace trpc::fiber::detail
@@ -86,6 +86,7 @@ void FiberThreadModel::Start() noexcept {
   fiber::detail::SetFiberStackSize(options_.stack_size);
   fiber::detail::SetFiberPoolNumByMmap(options_.pool_num_by_mmap);
   fiber::detail::SetFiberStackEnableGuardPage(options_.stack_enable_guard_page);
+  fiber::detail::SetFiberStackUsageSampleRate(options_.stack_usage_sample_rate);
   fiber::detail::SetEnableGdbDebug(options_.enable_gdb_debug);
 
   InitializeConcurrency();
@@ -237,6 +238,8 @@ std::unique_ptr<FiberThreadModel::FullyFledgedSchedulingGroup> FiberThreadModel:
   rc->scheduling_group->SetNodeId(node_id);
   rc->scheduling_group->SetThreadModelId(options_.group_id);
   rc->scheduling_group->SetThreadModeGroupName(options_.group_name);
+  rc->scheduling_group->ExposeSchedulingGroupVar(
+      fmt::format("/trpc/fiber/scheduling_group/{}/{}/{}", options_.group_name, node_id, sg_id));
 
   rc->fiber_workers.reserve(scheduling_group_size);
   for (std::size_t i = 0; i != scheduling_group_size; ++i) {
@@ -79,6 +79,9 @@ class FiberThreadModel final : public ThreadModel {
     /// Enable fiber stack protection or not
     bool stack_enable_guard_page{true};
 
+    /// Sample the stack usage of one in every `stack_usage_sample_rate` fibers, 0 means disabled
+    uint32_t stack_usage_sample_rate{0};
+
     /// Does the thread name displayed in the top command use the original process name, default is set by the
     /// framework.
     bool disable_process_name{true};
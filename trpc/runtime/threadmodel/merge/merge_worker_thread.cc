@@ -13,6 +13,7 @@
 
 #include "trpc/runtime/threadmodel/merge/merge_worker_thread.h"
 
+#include "trpc/runtime/common/stats/sampling_profiler.h"
 #include "trpc/util/thread/latch.h"
 #include "trpc/util/thread/thread_helper.h"
 
@@ -61,6 +62,7 @@ void MergeWorkerThread::ExecuteTask() noexcept { reactor_->ExecuteTask(); }
 void MergeWorkerThread::Run() noexcept {
   WorkerThread::SetCurrentWorkerThread(this);
   WorkerThread::SetCurrentThreadName(this);
+  SamplingProfiler::GetInstance()->RegisterCurrentThread(options_.group_name);
 
   if (!options_.cpu_affinitys.empty()) {
     trpc::SetCurrentThreadAffinity(options_.cpu_affinitys);
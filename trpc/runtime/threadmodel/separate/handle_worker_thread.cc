@@ -16,6 +16,7 @@
 #include <string>
 #include <utility>
 
+#include "trpc/runtime/common/stats/sampling_profiler.h"
 #include "trpc/util/thread/latch.h"
 #include "trpc/util/thread/thread_helper.h"
 
@@ -56,6 +57,7 @@ void HandleWorkerThread::ExecuteTask() noexcept {
 void HandleWorkerThread::Run() noexcept {
   WorkerThread::SetCurrentWorkerThread(this);
   WorkerThread::SetCurrentThreadName(this);
+  SamplingProfiler::GetInstance()->RegisterCurrentThread(options_.group_name + "_handle");
 
   if (!options_.cpu_affinitys.empty()) {
     trpc::SetCurrentThreadAffinity(options_.cpu_affinitys);
@@ -13,6 +13,7 @@
 
 #include "trpc/runtime/threadmodel/separate/io_worker_thread.h"
 
+#include "trpc/runtime/common/stats/sampling_profiler.h"
 #include "trpc/util/thread/latch.h"
 #include "trpc/util/thread/thread_helper.h"
 
@@ -65,6 +66,7 @@ void IoWorkerThread::Destroy() noexcept {
 void IoWorkerThread::Run() noexcept {
   WorkerThread::SetCurrentWorkerThread(this);
   WorkerThread::SetCurrentThreadName(this);
+  SamplingProfiler::GetInstance()->RegisterCurrentThread(options_.group_name + "_io");
 
   if (!options_.cpu_affinitys.empty()) {
     trpc::SetCurrentThreadAffinity(options_.cpu_affinitys);
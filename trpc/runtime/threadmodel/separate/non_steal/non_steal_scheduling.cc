@@ -14,6 +14,7 @@
 #include "trpc/runtime/threadmodel/separate/non_steal/non_steal_scheduling.h"
 
 #include "trpc/runtime/common/heartbeat/heartbeat_info.h"
+#include "trpc/util/buffer/memory_pool/memory_pool.h"
 #include "trpc/util/log/logging.h"
 #include "trpc/util/object_pool/object_pool.h"
 #include "trpc/util/time.h"
@@ -51,6 +52,10 @@ void NonStealScheduling::Schedule() noexcept {
     if (Size(worker_index) == 0) {
       uint32_t timeout = GetWaitTimeout(worker_index);
       if (timeout > 0) {
+        // Return the blocks and objects of other threads freed here before going to sleep, so their owners can reuse
+        // them.
+        memory_pool::FlushRemoteFrees();
+        object_pool::FlushRemoteFrees();
         Wait(timeout);
       }
     }
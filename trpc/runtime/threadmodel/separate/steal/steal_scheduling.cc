@@ -19,6 +19,7 @@
 #include "trpc/runtime/threadmodel/separate/steal/steal_scheduling.h"
 
 #include "trpc/runtime/common/heartbeat/heartbeat_info.h"
+#include "trpc/util/buffer/memory_pool/memory_pool.h"
 #include "trpc/util/log/logging.h"
 #include "trpc/util/object_pool/object_pool.h"
 #include "trpc/util/time.h"
@@ -146,6 +147,9 @@ bool StealScheduling::WaitForTask(MsgTask*& t, size_t worker_index) noexcept {
   }
 
   // Now I really need to relinguish my self to others
+  // Return the blocks and objects of other threads freed here before going to sleep, so their owners can reuse them.
+  memory_pool::FlushRemoteFrees();
+  object_pool::FlushRemoteFrees();
   notifier_.CommitWait(waiters_[worker_index]);
 
   return true;
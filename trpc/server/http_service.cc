@@ -140,6 +140,9 @@ void HttpService::Handle(const std::string& path, http::HandlerBase* handler, Se
                                          request_handle_timeout_ex);
       std::move(timeout_rsp).SerializeToString((*send)->buffer);
     } else {
+      if (!rsp.IsHeaderOnly()) {
+        (*send)->file_region = rsp.GetFileContent();
+      }
       std::move(rsp).SerializeToString((*send)->buffer);
     }
   }
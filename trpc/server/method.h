@@ -13,8 +13,11 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 
+#include "trpc/codec/method_id.h"
+
 namespace trpc {
 
 /// @brief Method type
@@ -28,7 +31,8 @@ enum class MethodType {
 /// @brief Base class of method。
 class Method {
  public:
-  Method(const std::string& name, MethodType type) : name_(name), method_type_(type) {}
+  Method(const std::string& name, MethodType type)
+      : name_(name), method_id_(trpc::GetMethodId(name)), method_type_(type) {}
 
   virtual ~Method() = default;
 
@@ -37,6 +41,9 @@ class Method {
   /// @note The return value string here is copy-on-write.
   std::string Name() const { return name_; }
 
+  /// @brief Get numeric id of method, which is derived from the name by `GetMethodId`.
+  uint32_t Id() const { return method_id_; }
+
   /// @brief Get type of method
   /// @return MethodType
   MethodType GetMethodType() const { return method_type_; }
@@ -48,6 +55,8 @@ class Method {
  private:
   std::string name_;
 
+  uint32_t method_id_;
+
   MethodType method_type_;
 };
 
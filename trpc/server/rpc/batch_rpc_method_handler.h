@@ -0,0 +1,229 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "trpc/coroutine/fiber.h"
+#include "trpc/coroutine/fiber_timer.h"
+#include "trpc/runtime/iomodel/reactor/reactor.h"
+#include "trpc/server/rpc/unary_rpc_method_handler.h"
+#include "trpc/tvar/compound_ops/latency_recorder.h"
+#include "trpc/util/chrono/chrono.h"
+#include "trpc/util/chrono/time.h"
+
+namespace trpc {
+
+/// @brief Options of batch rpc method handler.
+struct BatchRpcOptions {
+  /// The batch is run as soon as it holds so many requests.
+  std::size_t max_batch_size{32};
+
+  /// How long the first request of a batch waits for others at most, the batch is run right away if it is zero.
+  std::chrono::microseconds max_delay{1000};
+
+  /// Batch stats are exposed as tvars under "trpc/server/batch/{name}/", e.g. the method name. Not exposed if empty.
+  std::string name;
+};
+
+/// @brief A request in the batch, see `BatchRpcMethodHandler`.
+template <class RequestType, class ResponseType>
+struct BatchRpcRequest {
+  ServerContextPtr context;
+
+  /// Owned by context.
+  const RequestType* request{nullptr};
+
+  /// Filled by the batch function, and sent back to the client with `status` after the batch function returns.
+  ResponseType response;
+
+  Status status;
+
+  /// Steady time(us) when the request joined the batch.
+  uint64_t enqueue_timestamp_us{0};
+};
+
+/// @brief Rpc method handler which collects concurrent requests of the method and processes them in batches, for
+///        handlers whose backends are far more efficient with batched requests.
+///        A batch is run when it reaches `max_batch_size`, or `max_delay` after its first request arrives, by the
+///        fiber (fiber runtime) or the reactor (merge runtime) that fills it or whose timer fires.
+/// @note  Requests rejected by filters or failed to decode never join a batch. If there is neither fiber nor
+///        reactor in current thread (e.g. handle threads of separate runtime), the delay timer can't be armed and a
+///        batch is run as soon as its first request arrives.
+/// @example
+///   auto* handler = new BatchRpcMethodHandler<ScoreRequest, ScoreReply>(
+///       [](std::vector<BatchRpcRequest<ScoreRequest, ScoreReply>>& batch) { ... }, {64, 2ms, "Score"});
+///   AddRpcServiceMethod(new RpcServiceMethod("/trpc.test.Scorer/Score", MethodType::UNARY, handler));
+template <class RequestType, class ResponseType>
+class BatchRpcMethodHandler : public UnaryRpcMethodHandler<RequestType, ResponseType> {
+ public:
+  using BatchRequest = BatchRpcRequest<RequestType, ResponseType>;
+  using BatchFunction = std::function<void(std::vector<BatchRequest>& batch)>;
+
+  using UnaryRpcMethodHandler<RequestType, ResponseType>::PreExecute;
+  using UnaryRpcMethodHandler<RequestType, ResponseType>::PostExecute;
+
+  explicit BatchRpcMethodHandler(BatchFunction func, BatchRpcOptions options = {})
+      : batcher_(std::make_shared<Batcher>(std::move(func), std::move(options))) {}
+
+  void Execute(const ServerContextPtr& context, NoncontiguousBuffer&& req_body,
+               NoncontiguousBuffer& rsp_body) noexcept override {
+    if (PreExecute(context, std::move(req_body))) {
+      // The response is sent by the batch.
+      context->SetResponse(false);
+      batcher_->Add(context);
+      return;
+    } else if (IsDecodeError(context)) {
+      // if decoding error, no need to execute PostExecute
+      return;
+    }
+
+    PostExecute(context, rsp_body);
+  }
+
+  /// @brief Get the number of batches run so far.
+  uint32_t GetBatchCount() const { return batcher_->batch_size.Count(); }
+
+ private:
+  void Execute(const ServerContextPtr& context) noexcept override { TRPC_ASSERT(false && "Unreachable"); }
+
+  bool IsDecodeError(const ServerContextPtr& context) {
+    return context->GetStatus().GetFrameworkRetCode() ==
+           context->GetServerCodec()->GetProtocolRetCode(codec::ServerRetCode::DECODE_ERROR);
+  }
+
+  // Shared with the pending timers, so that it outlives the handler until they fire.
+  struct Batcher : public std::enable_shared_from_this<Batcher> {
+    Batcher(BatchFunction&& func, BatchRpcOptions&& opts)
+        : func(std::move(func)),
+          options(std::move(opts)),
+          batch_size(options.name.empty() ? tvar::LatencyRecorder()
+                                          : tvar::LatencyRecorder("trpc/server/batch/" + options.name + "/batch_size")),
+          queue_delay_us(options.name.empty()
+                             ? tvar::LatencyRecorder()
+                             : tvar::LatencyRecorder("trpc/server/batch/" + options.name + "/queue_delay_us")) {
+      options.max_batch_size = std::max<std::size_t>(options.max_batch_size, 1);
+      pending.reserve(options.max_batch_size);
+    }
+
+    void Add(const ServerContextPtr& context) {
+      BatchRequest item;
+      item.context = context;
+      item.request = static_cast<const RequestType*>(context->GetRequestData());
+      item.enqueue_timestamp_us = time::GetSteadyMicroSeconds();
+
+      std::vector<BatchRequest> batch;
+      bool arm_timer = false;
+      uint64_t batch_seq = 0;
+      {
+        std::scoped_lock _(mutex);
+        pending.push_back(std::move(item));
+        if (pending.size() >= options.max_batch_size) {
+          batch = TakePending();
+        } else if (pending.size() == 1) {
+          arm_timer = true;
+          batch_seq = seq;
+        }
+      }
+
+      if (!batch.empty()) {
+        Run(batch);
+      } else if (arm_timer && !ArmTimer(batch_seq)) {
+        Flush(batch_seq);
+      }
+    }
+
+    bool ArmTimer(uint64_t batch_seq) {
+      if (options.max_delay.count() <= 0) {
+        return false;
+      }
+
+      auto cb = [self = this->shared_from_this(), batch_seq] { self->Flush(batch_seq); };
+      if (IsRunningInFiberWorker()) {
+        SetFiberDetachedTimer(ReadSteadyClock() + options.max_delay, std::move(cb));
+        return true;
+      }
+      if (Reactor* reactor = Reactor::GetCurrentTlsReactor(); reactor != nullptr) {
+        // Timers of reactor are in milliseconds.
+        uint64_t delay_ms = (options.max_delay.count() + 999) / 1000;
+        uint64_t timer_id = reactor->AddTimerAfter(delay_ms, 0, std::move(cb));
+        if (timer_id != kInvalidTimerId) {
+          reactor->DetachTimer(timer_id);
+          return true;
+        }
+      }
+      return false;
+    }
+
+    // Run the batch `batch_seq` if it has not been run because of being full.
+    void Flush(uint64_t batch_seq) {
+      std::vector<BatchRequest> batch;
+      {
+        std::scoped_lock _(mutex);
+        if (seq != batch_seq || pending.empty()) {
+          return;
+        }
+        batch = TakePending();
+      }
+      Run(batch);
+    }
+
+    std::vector<BatchRequest> TakePending() {
+      std::vector<BatchRequest> batch;
+      batch.reserve(options.max_batch_size);
+      batch.swap(pending);
+      ++seq;
+      return batch;
+    }
+
+    void Run(std::vector<BatchRequest>& batch) {
+      uint64_t now_us = time::GetSteadyMicroSeconds();
+      batch_size.Update(static_cast<uint32_t>(batch.size()));
+      for (const auto& item : batch) {
+        queue_delay_us.Update(static_cast<uint32_t>(now_us - item.enqueue_timestamp_us));
+      }
+
+      func(batch);
+
+      for (auto& item : batch) {
+        item.context->SendUnaryResponse(item.status, item.response);
+      }
+    }
+
+    BatchFunction func;
+    BatchRpcOptions options;
+    tvar::LatencyRecorder batch_size;
+    tvar::LatencyRecorder queue_delay_us;
+
+    std::mutex mutex;
+    std::vector<BatchRequest> pending;
+    // Sequence of the pending batch, increased each time the pending batch is taken.
+    uint64_t seq{0};
+  };
+
+ private:
+  std::shared_ptr<Batcher> batcher_;
+};
+
+}  // namespace trpc
@@ -0,0 +1,166 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#include "trpc/server/rpc/batch_rpc_method_handler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "trpc/codec/codec_manager.h"
+#include "trpc/codec/trpc/testing/trpc_protocol_testing.h"
+#include "trpc/coroutine/fiber.h"
+#include "trpc/coroutine/fiber_latch.h"
+#include "trpc/coroutine/testing/fiber_runtime.h"
+#include "trpc/proto/testing/helloworld.pb.h"
+#include "trpc/serialization/trpc_serialization.h"
+#include "trpc/server/rpc/rpc_service_impl.h"
+#include "trpc/server/testing/mock_server_transport.h"
+#include "trpc/server/testing/server_context_testing.h"
+
+namespace trpc::testing {
+
+using HelloRequest = trpc::test::helloworld::HelloRequest;
+using HelloReply = trpc::test::helloworld::HelloReply;
+using Handler = BatchRpcMethodHandler<HelloRequest, HelloReply>;
+
+constexpr char kMethodName[] = "/trpc.test.helloworld.Greeter/SayHello";
+
+class BatchRpcMethodHandlerTest : public ::testing::Test {
+ public:
+  static void SetUpTestCase() {
+    codec::Init();
+    serialization::Init();
+  }
+
+  static void TearDownTestCase() {
+    codec::Destroy();
+    serialization::Destroy();
+  }
+
+ protected:
+  void SetUp() override {
+    service_ = std::make_shared<RpcServiceImpl>();
+    service_->SetServerTransport(&transport_);
+    ON_CALL(transport_, SendMsg(::testing::_, ::testing::_))
+        .WillByDefault([this](ServerContextPtr& context, NoncontiguousBuffer&& buffer) {
+          HelloReply reply;
+          DummyTrpcProtocol protocol;
+          EXPECT_TRUE(UnPackTrpcResponse(buffer, protocol, &reply));
+          std::scoped_lock _(mutex_);
+          replies_.push_back(reply.msg());
+          return 0;
+        });
+  }
+
+  // Echo the requests, and record the size of each batch.
+  Handler* AddHandler(BatchRpcOptions options) {
+    auto* handler = new Handler(
+        [this](std::vector<Handler::BatchRequest>& batch) {
+          for (auto& item : batch) {
+            item.response.set_msg(item.request->msg());
+          }
+          std::scoped_lock _(mutex_);
+          batch_sizes_.push_back(batch.size());
+        },
+        std::move(options));
+    service_->AddRpcServiceMethod(new RpcServiceMethod(kMethodName, MethodType::UNARY, handler));
+    return handler;
+  }
+
+  void Dispatch(const std::string& msg) {
+    DummyTrpcProtocol protocol;
+    protocol.func = kMethodName;
+    HelloRequest request;
+    request.set_msg(msg);
+    NoncontiguousBuffer buffer;
+    ASSERT_TRUE(PackTrpcRequest(protocol, static_cast<void*>(&request), buffer));
+
+    ServerContextPtr context = MakeTestServerContext("trpc", service_.get(), std::move(buffer));
+    service_->Dispatch(context, context->GetRequestMsg(), context->GetResponseMsg());
+    ASSERT_FALSE(context->IsResponse());
+  }
+
+  std::size_t ReplyCount() {
+    std::scoped_lock _(mutex_);
+    return replies_.size();
+  }
+
+ protected:
+  std::shared_ptr<RpcServiceImpl> service_;
+  ::testing::NiceMock<MockServerTransport> transport_;
+
+  std::mutex mutex_;
+  std::vector<std::size_t> batch_sizes_;
+  std::vector<std::string> replies_;
+};
+
+TEST_F(BatchRpcMethodHandlerTest, FullBatch) {
+  RunAsFiber([this] {
+    auto* handler = AddHandler({4, std::chrono::seconds(10), "FullBatch"});
+
+    FiberLatch latch(8);
+    for (int i = 0; i < 8; ++i) {
+      StartFiberDetached([this, i, &latch] {
+        Dispatch(std::to_string(i));
+        latch.CountDown();
+      });
+    }
+    latch.Wait();
+
+    // Never wait for the timer as batches are full.
+    ASSERT_EQ(ReplyCount(), 8);
+    ASSERT_EQ(batch_sizes_, (std::vector<std::size_t>{4, 4}));
+    ASSERT_EQ(handler->GetBatchCount(), 2);
+    std::sort(replies_.begin(), replies_.end());
+    ASSERT_EQ(replies_, (std::vector<std::string>{"0", "1", "2", "3", "4", "5", "6", "7"}));
+  });
+}
+
+TEST_F(BatchRpcMethodHandlerTest, MaxDelay) {
+  RunAsFiber([this] {
+    AddHandler({100, std::chrono::milliseconds(20), "MaxDelay"});
+
+    Dispatch("a");
+    Dispatch("b");
+    Dispatch("c");
+    ASSERT_EQ(ReplyCount(), 0);
+
+    while (ReplyCount() != 3) {
+      FiberSleepFor(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(batch_sizes_, (std::vector<std::size_t>{3}));
+    ASSERT_EQ(replies_, (std::vector<std::string>{"a", "b", "c"}));
+  });
+}
+
+TEST_F(BatchRpcMethodHandlerTest, NoDelay) {
+  RunAsFiber([this] {
+    AddHandler({100, std::chrono::microseconds(0)});
+
+    Dispatch("a");
+    Dispatch("b");
+    ASSERT_EQ(ReplyCount(), 2);
+    ASSERT_EQ(batch_sizes_, (std::vector<std::size_t>{1, 1}));
+  });
+}
+
+}  // namespace trpc::testing
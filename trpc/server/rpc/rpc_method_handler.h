@@ -33,8 +33,12 @@ class RpcMethodHandler : public UnaryRpcMethodHandler<RequestType, ResponseType>
   void Execute(const ServerContextPtr& context, NoncontiguousBuffer&& req_body,
                NoncontiguousBuffer& rsp_body) noexcept override {
     if (PreExecute(context, std::move(req_body))) {
-      auto status = func_(context, static_cast<RequestType*>(context->GetRequestData()),
-                          static_cast<ResponseType*>(context->GetResponseData()));
+      Status status;
+      {
+        ScopedRpcStage stage(context->GetRpcStageTimer(), RpcStage::kHandle);
+        status = func_(context, static_cast<RequestType*>(context->GetRequestData()),
+                       static_cast<ResponseType*>(context->GetResponseData()));
+      }
 
       if (context->IsResponse()) {
         context->SetStatus(std::move(status));
@@ -19,20 +19,24 @@
 #include "trpc/codec/codec_helper.h"
 #include "trpc/codec/protocol.h"
 #include "trpc/coroutine/fiber.h"
+#include "trpc/runtime/common/stats/sampling_profiler.h"
 #include "trpc/stream/stream_handler.h"
 #include "trpc/util/log/logging.h"
 
 namespace trpc {
 
 void RpcServiceImpl::Dispatch(const ServerContextPtr& context, const ProtocolPtr& req, ProtocolPtr& rsp) noexcept {
-  RpcMethodHandlerInterface* method_handler = GetUnaryRpcMethodHandler(context->GetFuncName());
-  if (!method_handler) {
+  RpcServiceMethod* method = GetUnaryRpcServiceMethod(context->GetFuncName());
+  if (!method) {
     HandleNoFuncError(context);
     return;
   }
 
   NoncontiguousBuffer response_body;
-  method_handler->Execute(context, req->GetNonContiguousProtocolBody(), response_body);
+  {
+    ScopedSampleTag sample_tag(method->GetSampleTag());
+    method->GetRpcMethodHandler()->Execute(context, req->GetNonContiguousProtocolBody(), response_body);
+  }
 
   if (context->IsResponse()) {
     rsp->SetNonContiguousProtocolBody(std::move(response_body));
@@ -41,8 +45,8 @@ void RpcServiceImpl::Dispatch(const ServerContextPtr& context, const ProtocolPtr
 
 void RpcServiceImpl::DispatchStream(const ServerContextPtr& context) noexcept {
   context->SetService(this);
-  RpcMethodHandlerInterface* handler = GetStreamRpcMethodHandler(context->GetFuncName());
-  if (!handler) {
+  RpcServiceMethod* method = GetStreamRpcServiceMethod(context->GetFuncName());
+  if (!method) {
     HandleNoFuncError(context);
     // StreamReaderWriterProvider object will be moved from context.
     // NOTE: stream options will store context object, and the server context will also set stream provider.
@@ -54,7 +58,10 @@ void RpcServiceImpl::DispatchStream(const ServerContextPtr& context) noexcept {
   stream::StreamReaderWriterProviderPtr stream_provider = context->GetStreamReaderWriterProvider();
   stream_provider->GetMutableStreamOptions()->stream_max_window_size = GetServiceAdapterOption().stream_max_window_size;
   context->SetStreamReaderWriterProvider(std::move(stream_provider));
-  bool start_fiber = StartFiberDetached([handler, context] { handler->Execute(context); });
+  bool start_fiber = StartFiberDetached([method, context] {
+    ScopedSampleTag sample_tag(method->GetSampleTag());
+    method->GetRpcMethodHandler()->Execute(context);
+  });
 
   if (TRPC_UNLIKELY(!start_fiber)) {
     TRPC_FMT_INFO_IF(TRPC_EVERY_N(1000),
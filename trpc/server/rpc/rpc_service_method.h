@@ -16,6 +16,7 @@
 #include <memory>
 #include <string>
 
+#include "trpc/runtime/common/stats/sampling_profiler.h"
 #include "trpc/server/method.h"
 #include "trpc/server/method_handler.h"
 
@@ -25,14 +26,18 @@ namespace trpc {
 class RpcServiceMethod : public Method {
  public:
   RpcServiceMethod(const std::string& name, MethodType type, RpcMethodHandlerInterface* handler)
-      : Method(name, type), handler_(handler) {}
+      : Method(name, type), handler_(handler), sample_tag_(InternSampleTag(name)) {}
 
   ~RpcServiceMethod() override = default;
 
   RpcMethodHandlerInterface* GetRpcMethodHandler() const { return handler_.get(); }
 
+  /// @brief Tag of the samples taken by the sampling profiler while handling this method, see `ScopedSampleTag`.
+  const char* GetSampleTag() const { return sample_tag_; }
+
  private:
   std::unique_ptr<RpcMethodHandlerInterface> handler_;
+  const char* sample_tag_;
 };
 
 }  // namespace trpc
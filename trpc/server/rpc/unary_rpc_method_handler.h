@@ -77,7 +77,11 @@ class UnaryRpcMethodHandler : public RpcMethodHandlerInterface {
     CreateReqAndRspObj(context);
 
     auto decompress_type = context->GetReqCompressType();
-    auto ret = compressor::DecompressIfNeeded(decompress_type, req_body);
+    bool ret;
+    {
+      ScopedRpcStage stage(context->GetRpcStageTimer(), RpcStage::kDeserialize);
+      ret = compressor::DecompressIfNeeded(decompress_type, req_body);
+    }
     if (TRPC_UNLIKELY(!ret)) {
       std::string err_msg = "request body decompress failed, decompress type:";
       err_msg += std::to_string(decompress_type);
@@ -94,7 +98,10 @@ class UnaryRpcMethodHandler : public RpcMethodHandlerInterface {
       return false;
     }
 
-    ret = Deserialize(serialization, &req_body, context->GetRequestData());
+    {
+      ScopedRpcStage stage(context->GetRpcStageTimer(), RpcStage::kDeserialize);
+      ret = Deserialize(serialization, &req_body, context->GetRequestData());
+    }
     if (TRPC_UNLIKELY(!ret)) {
       std::string error_msg = "request body deserialize failed, encode_type:";
       error_msg += std::to_string(encode_type);
@@ -122,7 +129,11 @@ class UnaryRpcMethodHandler : public RpcMethodHandlerInterface {
 
     uint8_t encode_type = context->GetRspEncodeType();
     auto serialization = serialization::SerializationFactory::GetInstance()->Get(encode_type);
-    bool ret = Serialize(serialization, context->GetResponseData(), rsp_body);
+    bool ret;
+    {
+      ScopedRpcStage stage(context->GetRpcStageTimer(), RpcStage::kSerialize);
+      ret = Serialize(serialization, context->GetResponseData(), rsp_body);
+    }
     if (TRPC_UNLIKELY(!ret)) {
       std::string error_msg = "response body serialize failed, encode_type:";
       error_msg += std::to_string(encode_type);
@@ -130,13 +141,20 @@ class UnaryRpcMethodHandler : public RpcMethodHandlerInterface {
       return;
     }
 
-    ret = compressor::CompressIfNeeded(context->GetRspCompressType(), rsp_body, context->GetRspCompressLevel());
+    auto compress_type = context->GetRspCompressType();
+    {
+      ScopedRpcStage stage(context->GetRpcStageTimer(), RpcStage::kSerialize);
+      ret = compressor::AdaptiveCompressIfNeeded(compress_type, rsp_body, context->GetRspCompressLevel(),
+                                                 context->GetFuncName());
+    }
     if (TRPC_UNLIKELY(!ret)) {
       std::string error_msg = "response body serialize compress, compress_type:";
       error_msg += std::to_string(context->GetRspCompressType());
       SetErrorStatus(context, codec::ServerRetCode::ENCODE_ERROR, "response body compress failed");
       return;
     }
+    // It's kNone if the response is not worth compressing.
+    context->SetRspCompressType(compress_type);
 
     DestroyReqAndRspObj(context);
   }
@@ -14,8 +14,10 @@
 #include "trpc/server/server_context.h"
 
 #include <algorithm>
+#include <new>
 #include <string>
 #include <unordered_map>
+#include <utility>
 
 #include "trpc/common/config/trpc_config.h"
 #include "trpc/compressor/trpc_compressor.h"
@@ -27,6 +29,27 @@
 
 namespace trpc {
 
+void ServerContextDeleter::operator()(ServerContext* context) const noexcept {
+  if (!context->in_arena_) {
+    delete context;
+    return;
+  }
+  // Memory of the context belongs to the arena, keep the arena alive until the context is destructed.
+  RequestArenaPtr arena = std::move(context->arena_);
+  context->~ServerContext();
+}
+
+ServerContextPtr MakeServerContextInArena(RequestArenaPtr arena) {
+  if (!arena) {
+    arena = RequestArena::Create();
+  }
+  void* mem = arena->Allocate(sizeof(ServerContext), alignof(ServerContext));
+  auto* context = new (mem) ServerContext();
+  context->arena_ = std::move(arena);
+  context->in_arena_ = true;
+  return ServerContextPtr(adopt_ptr, context);
+}
+
 ServerContext::ServerContext() { FrameStats::GetInstance()->GetServerStats().AddReqConcurrency(); }
 
 ServerContext::~ServerContext() {
@@ -48,6 +71,10 @@ ServerContext::~ServerContext() {
   if (cost > 0) {
     server_stats.AddReqDelay(cost);
   }
+
+  if (!stage_timer_.Empty() && req_msg_ != nullptr) {
+    RpcStageStats::GetInstance()->Record(GetFuncName(), stage_timer_.GetAll());
+  }
 }
 
 bool ServerContext::IsDyeingMessage() const { return (GetMessageType() & TrpcMessageType::TRPC_DYEING_MESSAGE) != 0; }
@@ -131,7 +158,11 @@ void ServerContext::SendUnaryResponse(const Status& status, void* rsp_data, seri
   }
 
   NoncontiguousBuffer data;
-  auto ret = serialization->Serialize(type, rsp_data, &data);
+  bool ret;
+  {
+    ScopedRpcStage serialize_stage(&stage_timer_, RpcStage::kSerialize);
+    ret = serialization->Serialize(type, rsp_data, &data);
+  }
   if (TRPC_UNLIKELY(!ret)) {
     std::string err_msg = "serialize response data failed, serialization_type:";
     err_msg += std::to_string(serialization_type);
@@ -142,7 +173,10 @@ void ServerContext::SendUnaryResponse(const Status& status, void* rsp_data, seri
 
   // compress
   auto compress_type = GetRspCompressType();
-  ret = compressor::CompressIfNeeded(compress_type, data, GetRspCompressLevel());
+  {
+    ScopedRpcStage compress_stage(&stage_timer_, RpcStage::kSerialize);
+    ret = compressor::AdaptiveCompressIfNeeded(compress_type, data, GetRspCompressLevel(), GetFuncName());
+  }
   if (TRPC_UNLIKELY(!ret)) {
     std::string err_msg = "compress response data failed, compress_type:";
     err_msg += std::to_string(compress_type);
@@ -150,6 +184,8 @@ void ServerContext::SendUnaryResponse(const Status& status, void* rsp_data, seri
     TRPC_FMT_ERROR(err_msg);
     return HandleEncodeErrorResponse(std::move(err_msg));
   }
+  // It's kNone if the response is not worth compressing.
+  SetRspCompressType(compress_type);
 
   rsp_msg_->SetNonContiguousProtocolBody(std::move(data));
 
@@ -178,11 +214,17 @@ void ServerContext::SendUnaryResponse(const Status& status) {
 
   // encode
   NoncontiguousBuffer send_data;
-  bool ret = GetServerCodec()->ZeroCopyEncode(ref, rsp_msg_, send_data);
+  bool ret;
+  {
+    ScopedRpcStage encode_stage(&stage_timer_, RpcStage::kEncode);
+    ret = GetServerCodec()->ZeroCopyEncode(ref, rsp_msg_, send_data);
+  }
   if (!ret) {
     TRPC_FMT_ERROR("response encode failed, ip: {}", GetIp());
     return;
   }
+  // Time of writing is counted until the response is written by io thread.
+  stage_timer_.Mark();
 
   auto* send_msg = object_pool::New<STransportRspMsg>();
   send_msg->context = std::move(ref);
@@ -199,7 +241,7 @@ void ServerContext::SendTransparentResponse(const Status& status, NoncontiguousB
   SendUnaryResponse(status);
 }
 
-Status ServerContext::SendResponse(NoncontiguousBuffer&& buffer) {
+Status ServerContext::SendResponse(NoncontiguousBuffer&& buffer, FileRegionPtr file_region) {
   RefPtr ref(ref_ptr, this);
 
   GetFilterController().RunMessageServerFilters(FilterPoint::SERVER_POST_RPC_INVOKE, ref);
@@ -208,6 +250,7 @@ Status ServerContext::SendResponse(NoncontiguousBuffer&& buffer) {
   auto* send_msg = object_pool::New<STransportRspMsg>();
   send_msg->context = std::move(ref);
   send_msg->buffer = std::move(buffer);
+  send_msg->file_region = std::move(file_region);
 
   return Status{service_->SendMsg(send_msg), 0, ""};
 }
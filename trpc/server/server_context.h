@@ -33,15 +33,25 @@
 #include "trpc/common/status.h"
 #include "trpc/compressor/compressor_type.h"
 #include "trpc/filter/server_filter_controller.h"
+#include "trpc/runtime/common/stats/rpc_stage_stats.h"
+#include "trpc/runtime/iomodel/reactor/common/file_region.h"
 #include "trpc/serialization/serialization_type.h"
 #include "trpc/server/method_handler.h"
 #include "trpc/stream/stream_provider.h"
 #include "trpc/util/buffer/noncontiguous_buffer.h"
 #include "trpc/util/flatbuffers/message_fbs.h"
+#include "trpc/util/request_arena.h"
 
 namespace trpc {
 
 class Service;
+class ServerContext;
+
+/// @brief Destroy context according to where it is allocated, see `MakeServerContextInArena`.
+/// @private
+struct ServerContextDeleter {
+  void operator()(ServerContext* context) const noexcept;
+};
 
 /// @brief Context class for server-side request processing, use `MakeServerContext` to create it.
 /// @note  It is not thread-safe.
@@ -50,7 +60,7 @@ class Service;
 ///        concurrently in the constructor and destructor of the class.
 ///        it should be noted that if the user saves the context,
 ///        concurrent current limiting cannot be used.
-class ServerContext : public RefCounted<ServerContext> {
+class ServerContext : public RefCounted<ServerContext, ServerContextDeleter> {
  public:
   /// requested network type
   enum class NetType : uint8_t {
@@ -459,6 +469,16 @@ class ServerContext : public RefCounted<ServerContext> {
   /// @brief Get the filter data for all filter Settings.
   std::unordered_map<uint32_t, std::any>& GetAllFilterData() { return extend_info_.filter_data; }
 
+  /// @brief Get the arena of current request, memory allocated from it is released at once along with the request,
+  ///        e.g. scratch data of filters. An arena is created on the first call if the context is not in arena.
+  /// @note  Allocation from arena is not thread-safe.
+  RequestArena& GetArena() {
+    if (!arena_) {
+      arena_ = RequestArena::Create();
+    }
+    return *arena_;
+  }
+
   //////////////////////////////////////////////////////////////////////////
 
   /// @brief Set the flag of whether the framework actively returns packet.
@@ -546,10 +566,11 @@ class ServerContext : public RefCounted<ServerContext> {
 
   /// @brief Implementation of asynchronous packet return on the server side.
   /// @param buffer raw data, it(protocol header + body) has been seriliazed or compressed
+  /// @param file_region the file sent right after `buffer` (by sendfile if possible), e.g. body of http file response
   /// @return the sending result
   /// @note  before calling this method, you should call `SetResponse(false)` in the rpc interface implemented
   ///        it is generally used in custom protocol data transmission scenarios
-  Status SendResponse(NoncontiguousBuffer&& buffer);
+  Status SendResponse(NoncontiguousBuffer&& buffer, FileRegionPtr file_region = nullptr);
 
   /// @brief Set the remote log field information in the context extension.
   /// @note  Based on the filterIndex Settings, the business can specify the field information
@@ -598,6 +619,9 @@ class ServerContext : public RefCounted<ServerContext> {
   /// @brief Set callback function after send response msg done.
   void SetSendMsgCallback(std::function<void()>&& callback) { extend_info_.send_msg_callback = std::move(callback); }
 
+  /// @brief Framework use. Get the timer of cycles spent in each stage of the request.
+  RpcStageTimer* GetRpcStageTimer() { return &stage_timer_; }
+
  private:
   // Implementation of asynchronous packet return on the server side
   void SendUnaryResponse(const Status& status, google::protobuf::Message* pb);
@@ -742,6 +766,12 @@ class ServerContext : public RefCounted<ServerContext> {
   };
 
  private:
+  // arena of the request, it also holds the memory of the context itself if `in_arena_` is true.
+  // declared first so that it outlives other members which may refer to it
+  RequestArenaPtr arena_;
+
+  bool in_arena_{false};
+
   // not owned
   Service* service_{nullptr};
 
@@ -781,10 +811,20 @@ class ServerContext : public RefCounted<ServerContext> {
   MetricsInfo metrics_info_;
 
   ExtendInfo extend_info_;
+
+  RpcStageTimer stage_timer_;
+
+  friend struct ServerContextDeleter;
+  friend RefPtr<ServerContext> MakeServerContextInArena(RequestArenaPtr arena);
 };
 
 using ServerContextPtr = RefPtr<ServerContext>;
 
+/// @brief Framework use or for testing. Create context in arena, the context, protocol objects created in the arena
+///        and scratch data of filters are released at once when the request finishes.
+/// @param arena The arena owned by the context, if it is nullptr a new arena is created.
+ServerContextPtr MakeServerContextInArena(RequestArenaPtr arena = nullptr);
+
 template <typename T>
 using is_server_context = std::is_same<T, ServerContext>;
 
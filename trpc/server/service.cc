@@ -13,8 +13,13 @@
 
 #include "trpc/server/service.h"
 
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include "trpc/server/service_adapter.h"
 #include "trpc/transport/server/server_transport.h"
+#include "trpc/util/log/logging.h"
 
 namespace trpc {
 
@@ -32,6 +37,34 @@ Service::~Service() {
   }
 }
 
+void Service::AddRpcServiceMethod(RpcServiceMethod* method) {
+  rpc_service_methods_[method->Name()] = method;
+
+  std::vector<std::pair<std::string, RpcServiceMethod*>> names;
+  std::unordered_map<uint32_t, RpcServiceMethod*> ids;
+  names.reserve(rpc_service_methods_.size());
+  for (const auto& [name, rpc_method] : rpc_service_methods_) {
+    names.emplace_back(name, rpc_method);
+    auto [it, inserted] = ids.emplace(rpc_method->Id(), rpc_method);
+    if (!inserted && it->second != nullptr) {
+      // Conflicted id is not usable by any of the methods, they can still be called by name.
+      TRPC_FMT_WARN("service: {}, method {} and {} have the same id {}, call them by name", GetName(),
+                    it->second->Name(), name, rpc_method->Id());
+      it->second = nullptr;
+    }
+  }
+  rpc_method_name_index_.Build(std::move(names));
+
+  std::vector<std::pair<uint32_t, RpcServiceMethod*>> valid_ids;
+  valid_ids.reserve(ids.size());
+  for (const auto& item : ids) {
+    if (item.second != nullptr) {
+      valid_ids.emplace_back(item);
+    }
+  }
+  rpc_method_id_index_.Build(std::move(valid_ids));
+}
+
 const ServiceAdapterOption& Service::GetServiceAdapterOption() const {
   return adapter_->GetServiceAdapterOption();
 }
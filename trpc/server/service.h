@@ -17,6 +17,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
 #include "trpc/codec/server_codec.h"
@@ -27,6 +28,7 @@
 #include "trpc/server/rpc/rpc_service_method.h"
 #include "trpc/server/service_adapter_option.h"
 #include "trpc/transport/server/server_transport.h"
+#include "trpc/util/container/frozen_hash_map.h"
 
 namespace trpc {
 
@@ -108,11 +110,26 @@ class Service {
   bool GetNeedFiberExecutionContext() const { return need_fiber_ctx_; }
 
   /// @brief Add rpc service method.
-  void AddRpcServiceMethod(RpcServiceMethod* method) { rpc_service_methods_[method->Name()] = method; }
+  /// @note Methods are expected to be added at startup, the lookup tables are rebuilt every time a method is added.
+  void AddRpcServiceMethod(RpcServiceMethod* method);
 
   /// @brief Get rpc service method.
   const std::unordered_map<std::string, RpcServiceMethod*>& GetRpcServiceMethod() const { return rpc_service_methods_; }
 
+  /// @brief Find rpc service method by name through perfect hash table.
+  /// @return nullptr if not found.
+  RpcServiceMethod* FindRpcServiceMethod(std::string_view name) const {
+    auto* method = rpc_method_name_index_.Find(name);
+    return method ? *method : nullptr;
+  }
+
+  /// @brief Find rpc service method by method id (see `GetMethodId`).
+  /// @return nullptr if not found, or the id conflicts with another method of this service.
+  RpcServiceMethod* FindRpcServiceMethod(uint32_t method_id) const {
+    auto* method = rpc_method_id_index_.Find(method_id);
+    return method ? *method : nullptr;
+  }
+
   /// @brief Add non-rpc service method.
   void AddNonRpcServiceMethod(NonRpcServiceMethod* method) { non_rpc_service_methods_[method->Name()] = method; }
 
@@ -231,6 +248,10 @@ class Service {
   // rpc service methods
   std::unordered_map<std::string, RpcServiceMethod*> rpc_service_methods_;
 
+  // frozen lookup tables of rpc service methods, by name and by method id
+  container::FrozenHashMap<std::string, RpcServiceMethod*> rpc_method_name_index_;
+  container::FrozenHashMap<uint32_t, RpcServiceMethod*> rpc_method_id_index_;
+
   // non-rpc service methods
   std::unordered_map<std::string, NonRpcServiceMethod*> non_rpc_service_methods_;
 
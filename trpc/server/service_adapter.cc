@@ -63,6 +63,7 @@ FilterStatus RunIoFilters(FilterPoint filter_point, const std::any& msg) noexcep
   try {
     const auto& context = std::any_cast<const ServerContextPtr&>(msg);
     if (filter_point == FilterPoint::SERVER_POST_IO_SEND_MSG) {
+      context->GetRpcStageTimer()->AddSinceMark(RpcStage::kWrite);
       context->SetSendTimestampUs(trpc::time::GetMicroSeconds());
       auto& callback = context->GetSendMsgCallback();
       if (callback != nullptr) {
@@ -173,6 +174,8 @@ void ServiceAdapter::SetService(const ServicePtr& service) {
       AddServiceFilter(service->GetFilterController(), filter);
     }
   }
+  // Global filters have been registered by now, so that requests run the chains built here.
+  service->GetFilterController().BuildChains();
 
   services_[service->GetName()] = service;
   if (is_shared_ && transport_) {
@@ -216,7 +219,10 @@ std::unique_ptr<ServerTransport> ServiceAdapter::CreateServerTransport() {
 
 STransportReqMsg* ServiceAdapter::CreateSTransportReqMsg(const ConnectionPtr& conn, uint64_t recv_timestamp_us,
                                                          std::any&& msg) {
-  ServerContextPtr context = MakeRefCounted<ServerContext>();
+  // The context, protocol objects and scratch data of filters share the arena of the request, which is released at
+  // once when the request finishes.
+  RequestArenaPtr arena = RequestArena::Create();
+  ServerContextPtr context = MakeServerContextInArena(arena);
 
   context->SetRecvTimestampUs(recv_timestamp_us);
   context->SetConnectionId(conn->GetConnId());
@@ -232,10 +238,14 @@ STransportReqMsg* ServiceAdapter::CreateSTransportReqMsg(const ConnectionPtr& co
   context->SetPort(conn->GetPeerPort());
   context->SetIp(conn->GetPeerIp());
   context->SetServerCodec(server_codec_.get());
-  context->SetRequestMsg(server_codec_->CreateRequestObject());
-  context->SetResponseMsg(server_codec_->CreateResponseObject());
+  context->SetRequestMsg(server_codec_->CreateRequestObjectInArena(arena));
+  context->SetResponseMsg(server_codec_->CreateResponseObjectInArena(arena));
 
-  bool ret = server_codec_->ZeroCopyDecode(context, std::move(msg), context->GetRequestMsg());
+  bool ret;
+  {
+    ScopedRpcStage decode_stage(context->GetRpcStageTimer(), RpcStage::kDecode);
+    ret = server_codec_->ZeroCopyDecode(context, std::move(msg), context->GetRequestMsg());
+  }
   if (!ret) {
     TRPC_FMT_ERROR_EVERY_SECOND("request header decode failed, ip: {}, port: {}", context->GetIp(), context->GetPort());
     auto& status = context->GetStatus();
@@ -284,12 +294,14 @@ bool ServiceAdapter::HandleMessage(const ConnectionPtr& conn, std::deque<std::an
     if (RunServerFilters(FilterPoint::SERVER_PRE_SCHED_RECV_MSG, req_msg) == FilterStatus::REJECT) {
       succ = false;
     }
+    req_msg->context->GetRpcStageTimer()->Mark();
 
     SetLocalServerContext(req_msg->context);
 
     MsgTaskHandler msg_handler = [this, req_msg]() mutable {
       auto& context = req_msg->context;
 
+      context->GetRpcStageTimer()->AddSinceMark(RpcStage::kDispatch);
       context->SetBeginTimestampUs(trpc::time::GetMicroSeconds());
 
       RunServerFilters(FilterPoint::SERVER_POST_SCHED_RECV_MSG, req_msg);
@@ -361,9 +373,11 @@ bool ServiceAdapter::HandleFiberMessage(const ConnectionPtr& conn, std::deque<st
     if (RunServerFilters(FilterPoint::SERVER_PRE_SCHED_RECV_MSG, req_msg) == FilterStatus::REJECT) {
       succ = false;
     }
+    req_msg->context->GetRpcStageTimer()->Mark();
 
     MsgTaskHandler msg_handler = [this, conn, req_msg]() mutable {
       auto& context = req_msg->context;
+      context->GetRpcStageTimer()->AddSinceMark(RpcStage::kDispatch);
       context->SetBeginTimestampUs(trpc::time::GetMicroSeconds());
 
       RunServerFilters(FilterPoint::SERVER_POST_SCHED_RECV_MSG, req_msg);
@@ -464,6 +478,8 @@ void ServiceAdapter::FillBindInfo(trpc::BindInfo& bind_info) {
   bind_info.send_queue_capacity = option_.send_queue_capacity;
   bind_info.send_queue_timeout = option_.send_queue_timeout;
   bind_info.accept_thread_num = option_.accept_thread_num;
+  bind_info.reuseport_per_reactor = option_.reuseport_per_reactor;
+  bind_info.reuseport_cpu_affinity = option_.reuseport_cpu_affinity;
   bind_info.accept_function = service_->GetAcceptConnectionFunction();
   bind_info.dispatch_accept_function = service_->GetDispatchAcceptConnectionFunction();
   bind_info.conn_establish_function = service_->GetConnectionEstablishFunction();
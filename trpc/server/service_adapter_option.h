@@ -89,6 +89,13 @@ struct ServiceAdapterOption {
   /// The number of threads(fibers) listening on the port
   uint32_t accept_thread_num{1};
 
+  /// Listen by one SO_REUSEPORT listener per reactor and keep connections on the accepting reactor
+  /// Use in fiber runtime
+  bool reuseport_per_reactor{false};
+
+  /// Steer connections to the listener by the cpu receiving the packet, used with `reuseport_per_reactor`
+  bool reuseport_cpu_affinity{false};
+
   /// The thread model type use by service, deprecated.
   std::string threadmodel_type;
 
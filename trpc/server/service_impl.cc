@@ -18,6 +18,7 @@
 #include <utility>
 
 #include "trpc/codec/codec_helper.h"
+#include "trpc/codec/method_id.h"
 #include "trpc/server/server_context.h"
 #include "trpc/util/log/logging.h"
 #include "trpc/util/time.h"
@@ -99,11 +100,39 @@ void ServiceImpl::HandleTransportStreamMessage(STransportReqMsg* recv) noexcept
   DispatchStream(context);
 }
 
-RpcMethodHandlerInterface* ServiceImpl::GetUnaryRpcMethodHandler(const std::string& func_name) {
-  const auto& rpc_service_methods = GetRpcServiceMethod();
-  auto it = rpc_service_methods.find(func_name);
-  if (it != rpc_service_methods.end() && it->second->GetMethodType() == MethodType::UNARY) {
-    return it->second->GetRpcMethodHandler();
+void ServiceImpl::FillServerContext(const ServerContextPtr& context) {
+  const auto& trans_info = context->GetPbReqTransInfo();
+  if (!trans_info.empty() && trans_info.find(kMethodIdTransInfoKey) != trans_info.end()) {
+    // Tell the client that compact function names are understood here.
+    context->AddRspTransInfo(kMethodIdTransInfoKey, "1");
+  }
+
+  uint32_t method_id = 0;
+  if (TRPC_LIKELY(!ParseCompactFuncName(context->GetFuncName(), &method_id))) {
+    return;
+  }
+  RpcServiceMethod* method = FindRpcServiceMethod(method_id);
+  if (method != nullptr) {
+    context->SetFuncName(method->Name());
+  }
+}
+
+RpcServiceMethod* ServiceImpl::FindRpcServiceMethodByFuncName(const std::string& func_name) const {
+  RpcServiceMethod* method = FindRpcServiceMethod(std::string_view(func_name));
+  if (TRPC_LIKELY(method != nullptr)) {
+    return method;
+  }
+  uint32_t method_id = 0;
+  if (ParseCompactFuncName(func_name, &method_id)) {
+    return FindRpcServiceMethod(method_id);
+  }
+  return nullptr;
+}
+
+RpcServiceMethod* ServiceImpl::GetUnaryRpcServiceMethod(const std::string& func_name) {
+  RpcServiceMethod* method = FindRpcServiceMethodByFuncName(func_name);
+  if (method != nullptr && method->GetMethodType() == MethodType::UNARY) {
+    return method;
   }
 
   TRPC_LOG_ERROR("service: " << GetName() << ", unary func:" << func_name << " not found.");
@@ -111,11 +140,10 @@ RpcMethodHandlerInterface* ServiceImpl::GetUnaryRpcMethodHandler(const std::stri
   return nullptr;
 }
 
-RpcMethodHandlerInterface* ServiceImpl::GetStreamRpcMethodHandler(const std::string& func_name) {
-  const auto& rpc_service_methods = GetRpcServiceMethod();
-  auto it = rpc_service_methods.find(func_name);
-  if (it != rpc_service_methods.end() && it->second->GetMethodType() != MethodType::UNARY) {
-    return it->second->GetRpcMethodHandler();
+RpcServiceMethod* ServiceImpl::GetStreamRpcServiceMethod(const std::string& func_name) {
+  RpcServiceMethod* method = FindRpcServiceMethodByFuncName(func_name);
+  if (method != nullptr && method->GetMethodType() != MethodType::UNARY) {
+    return method;
   }
 
   TRPC_LOG_ERROR("service: " << GetName() << ", stream func:" << func_name << " not found.");
@@ -123,6 +151,16 @@ RpcMethodHandlerInterface* ServiceImpl::GetStreamRpcMethodHandler(const std::str
   return nullptr;
 }
 
+RpcMethodHandlerInterface* ServiceImpl::GetUnaryRpcMethodHandler(const std::string& func_name) {
+  RpcServiceMethod* method = GetUnaryRpcServiceMethod(func_name);
+  return method != nullptr ? method->GetRpcMethodHandler() : nullptr;
+}
+
+RpcMethodHandlerInterface* ServiceImpl::GetStreamRpcMethodHandler(const std::string& func_name) {
+  RpcServiceMethod* method = GetStreamRpcServiceMethod(func_name);
+  return method != nullptr ? method->GetRpcMethodHandler() : nullptr;
+}
+
 void ServiceImpl::HandleNoFuncError(const ServerContextPtr& context) {
   TRPC_LOG_ERROR("func:" << context->GetFuncName() << " not found");
 
@@ -168,10 +206,17 @@ void ServiceImpl::ConstructUnaryResponse(const ServerContextPtr& context, Protoc
 
   NoncontiguousBuffer send_data;
 
-  if (!context->GetServerCodec()->ZeroCopyEncode(context, context->GetResponseMsg(), send_data)) {
+  bool ret;
+  {
+    ScopedRpcStage encode_stage(context->GetRpcStageTimer(), RpcStage::kEncode);
+    ret = context->GetServerCodec()->ZeroCopyEncode(context, context->GetResponseMsg(), send_data);
+  }
+  if (!ret) {
     TRPC_FMT_ERROR("request encode failed, ip:{}, port:{}", context->GetIp(), context->GetPort());
     return;
   }
+  // Time of writing is counted until the response is written by io thread.
+  context->GetRpcStageTimer()->Mark();
 
   *send = trpc::object_pool::New<STransportRspMsg>();
   (*send)->context = context;
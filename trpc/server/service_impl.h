@@ -24,6 +24,10 @@ class ServiceImpl : public Service {
   void HandleTransportMessage(STransportReqMsg* recv, STransportRspMsg** send) noexcept override;
   void HandleTransportStreamMessage(STransportReqMsg* recv) noexcept override;
 
+  /// @brief Restore the full function name if the request carries a compact one (see `ToCompactFuncName`), so that
+  ///        filters and handlers always see the full name.
+  void FillServerContext(const ServerContextPtr& context) override;
+
   /// @brief The method for dispatching and processing unary request
   /// @param context Request context
   /// @param [in] req Request protocol
@@ -39,6 +43,9 @@ class ServiceImpl : public Service {
   }
 
  protected:
+  RpcServiceMethod* FindRpcServiceMethodByFuncName(const std::string& func_name) const;
+  RpcServiceMethod* GetUnaryRpcServiceMethod(const std::string& func_name);
+  RpcServiceMethod* GetStreamRpcServiceMethod(const std::string& func_name);
   RpcMethodHandlerInterface* GetUnaryRpcMethodHandler(const std::string& func_name);
   RpcMethodHandlerInterface* GetStreamRpcMethodHandler(const std::string& func_name);
   void HandleNoFuncError(const ServerContextPtr& context);
@@ -71,6 +71,8 @@ void TrpcServer::BuildServiceAdapterOption(const ServiceConfig& config, ServiceA
   option.send_queue_capacity = config.send_queue_capacity;
   option.send_queue_timeout = config.send_queue_timeout;
   option.accept_thread_num = config.accept_thread_num;
+  option.reuseport_per_reactor = config.reuseport_per_reactor;
+  option.reuseport_cpu_affinity = config.reuseport_cpu_affinity;
   option.threadmodel_type = config.threadmodel_type;
   option.threadmodel_instance_name = config.threadmodel_instance_name;
   option.stream_read_timeout = config.stream_read_timeout;
@@ -123,6 +123,33 @@ Status HttpWriteStream::Write(NoncontiguousBuffer&& item) {
   return ContextStatusToStreamStatus(context_->SendResponse(std::move(item)), [&] { written_size_ += item_size; });
 }
 
+Status HttpWriteStream::WriteFile(FileRegionPtr file) {
+  while (!(state_ & kHeaderWritten)) {  // ensure that the header has been sent completely
+    if (Status headerStatus = WriteHeader(); !headerStatus.OK()) {
+      return headerStatus;
+    }
+  }
+  size_t file_size = file->GetSize();
+  if (content_length_ != kChunked && written_size_ + file_size > static_cast<size_t>(content_length_)) {
+    return kStreamStatusServerWriteContentLengthError;
+  }
+  // An empty chunk ends the chunked response, and an empty file region is never sent.
+  if (file_size == 0) {
+    return kSuccStatus;
+  }
+  if (content_length_ != kChunked) {
+    return ContextStatusToStreamStatus(context_->SendResponse(NoncontiguousBuffer{}, std::move(file)),
+                                       [&] { written_size_ += file_size; });
+  }
+  Status status = ContextStatusToStreamStatus(
+      context_->SendResponse(CreateBufferSlow(HttpChunkHeader(file_size)), std::move(file)), [] {});
+  if (!status.OK()) {
+    return status;
+  }
+  return ContextStatusToStreamStatus(context_->SendResponse(CreateBufferSlow(http::kEndOfChunkMarker)),
+                                     [&] { written_size_ += file_size; });
+}
+
 Status HttpWriteStream::WriteDone() {
   if (!(state_ & kWriteDone)) {
     if (content_length_ == kChunked) {  // chunked response - send end of chunked marker
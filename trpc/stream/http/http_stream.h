@@ -170,6 +170,12 @@ class HttpWriteStream {
   ///         to Content-Length
   Status Write(NoncontiguousBuffer&& item);
 
+  /// @brief Sends a region of file as the response content, it's sent by sendfile(2) if possible, and read into
+  ///        buffer over TLS.
+  /// @param file the file to send, it's sent as one chunk for chunked response
+  /// @return Same as `Write`.
+  Status WriteFile(FileRegionPtr file);
+
   /// @brief Finishes sending the message content.
   /// @return Returns kSuccStatus on success, kStreamStatusServerNetworkError on error, kStreamStatusServerWriteTimeout
   ///         on timeout, kStreamStatusServerWriteContentLengthError when non-chunked response's write length not equal
@@ -62,6 +62,13 @@ static std::string GenHeader(const google::protobuf::FileDescriptor* file, const
   content += LineFeed(indent);
   content += R"(#include "trpc/server/rpc_service_impl.h")";
   content += LineFeed(indent);
+  content += LineFeed(indent);
+  content += "#if defined(TRPC_BUILD_INCLUDE_COROUTINE) && defined(__cpp_impl_coroutine)";
+  content += LineFeed(indent);
+  content += R"(#include "trpc/coroutine/coro/awaitable.h")";
+  content += LineFeed(indent);
+  content += "#endif";
+  content += LineFeed(indent);
 
   return content;
 }
@@ -220,6 +227,10 @@ public:
                                   HelloReply* response);
   virtual ::trpc::Future<HelloReply> AsyncSayHello(::trpc::ClientContextPtr& context,
                                                    const HelloRequest& request);
+#if defined(TRPC_BUILD_INCLUDE_COROUTINE) && defined(__cpp_impl_coroutine)
+  ::trpc::coro::Task<::trpc::Status> CoSayHello(const ::trpc::ClientContextPtr& context,
+                                                const HelloRequest& request, HelloReply* response);
+#endif
 };
 */
 
@@ -258,6 +269,23 @@ std::string GenProxy(const ::google::protobuf::ServiceDescriptor* desc, int inde
       out += LineFeed(indent);
       out += fmt::format("virtual ::trpc::Status {0}(const ::trpc::ClientContextPtr& context, const {1}& request);",
                          method->name(), GetParamterTypeWithNamespace(method->input_type()->full_name()));
+      out += LineFeed(0);
+      out += "#if defined(TRPC_BUILD_INCLUDE_COROUTINE) && defined(__cpp_impl_coroutine)";
+      out += LineFeed(indent);
+      out += "// coroutine, co_await it inside ::trpc::coro::Task";
+      out += LineFeed(indent);
+      out += fmt::format(
+          "::trpc::coro::Task<::trpc::Status> Co{0}(const ::trpc::ClientContextPtr& context, const {1}& request, "
+          "{2}* response) {{",
+          method->name(), GetParamterTypeWithNamespace(method->input_type()->full_name()),
+          GetParamterTypeWithNamespace(method->output_type()->full_name()));
+      out += LineFeed(indent + 1);
+      out += fmt::format("return ::trpc::coro::AwaitUnaryResponse(Async{0}(context, request), response);",
+                         method->name());
+      out += LineFeed(indent);
+      out += "}";
+      out += LineFeed(0);
+      out += "#endif";
     } else if (client_stream && !server_stream) {
       out += fmt::format(
           "virtual ::trpc::stream::StreamWriter<{0}> {1}(const ::trpc::ClientContextPtr& context, {2}* response);",
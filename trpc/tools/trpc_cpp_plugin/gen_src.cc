@@ -19,6 +19,7 @@
 #include "google/protobuf/compiler/plugin.pb.h"
 #include "google/protobuf/descriptor.h"
 
+#include "trpc/codec/method_id.h"
 #include "trpc/proto/trpc_options.pb.h"
 #include "trpc/tools/comm/trpc_cpp_options.pb.h"
 #include "trpc/tools/comm/utils.h"
@@ -100,6 +101,44 @@ static std::string GenServiceMethodNameArray(const ::google::protobuf::ServiceDe
   return out;
 }
 
+/*
+// Method ids of the first name of Greeter_method_names.
+static const uint32_t Greeter_method_ids[] = {
+  0x1a2b3c4du,
+};
+*/
+static std::string GenServiceMethodIdArray(const ::google::protobuf::ServiceDescriptor* service,
+                                           const std::string& pkg, int indent = 0) {
+  std::string out;
+  out.reserve(1024);
+
+  out += LineFeed(indent);
+  out += LineFeed(indent);
+  out += fmt::format("static const uint32_t {0}_method_ids[] = {{", service->name());
+
+  for (int i = 0; i < service->method_count(); ++i) {
+    out += LineFeed(indent + 1);
+
+    // Same as the first name in `GenServiceMethodNameArray`, which is used by service proxy.
+    std::string func_name = service->method(i)->options().GetExtension(trpc::alias);
+    if (func_name.empty()) {
+      const trpc::CppExt cpp_ext = service->method(i)->options().GetExtension(trpc::cpp_ext);
+      if (cpp_ext.alias_size() > 0) {
+        func_name = cpp_ext.alias(0);
+      } else {
+        func_name = fmt::format("/{0}.{1}/{2}", pkg, service->name(), service->method(i)->name());
+      }
+    }
+
+    out += fmt::format("0x{0:08x}u,", ::trpc::GetMethodId(func_name));
+  }
+
+  out += LineFeed(indent);
+  out += "};";
+
+  return out;
+}
+
 /*
 Greeter::Greeter() {
   for (const std::string_view& method : Greeter_method_names[0]) {
@@ -354,11 +393,20 @@ static std::string GenAsyncServiceMethodImp(const ::google::protobuf::ServiceDes
   return out;
 }
 
+/*
+if (context->GetFuncName().empty()) context->SetFuncName(Greeter_method_names[0][0].data(), Greeter_method_ids[0]);
+*/
+static std::string GenProxySetFuncName(const std::string& serviceName, int i) {
+  return fmt::format(
+      "if (context->GetFuncName().empty()) context->SetFuncName({0}_method_names[{1}][0].data(), {0}_method_ids[{1}]);",
+      serviceName, i);
+}
+
 /*
 ::trpc::Status GreeterServiceProxy::SayHello(const ::trpc::ClientContextPtr& context,
                                              const HelloRequest& request,
                                              HelloReply* response) {
-  context->SetFuncName(Greeter_method_names[0][0].data());
+  if (context->GetFuncName().empty()) context->SetFuncName(Greeter_method_names[0][0].data(), Greeter_method_ids[0]);
   return UnaryInvoke<HelloRequest, HelloReply>(context, request, response);
 }
 */
@@ -368,7 +416,6 @@ static std::string GenProxySyncCall(const ::google::protobuf::ServiceDescriptor*
   out.reserve(8 * 1024);
 
   const auto& serviceName = service->name();
-  const auto& methodArrayName = serviceName + "_method_names";
 
   for (int i = 0; i < service->method_count(); ++i) {
     out += LineFeed(indent);
@@ -385,8 +432,7 @@ static std::string GenProxySyncCall(const ::google::protobuf::ServiceDescriptor*
           serviceName, method->name(), GetParamterTypeWithNamespace(method->input_type()->full_name()),
           GetParamterTypeWithNamespace(method->output_type()->full_name()));
       out += LineFeed(1);
-      out += fmt::format("if (context->GetFuncName().empty()) context->SetFuncName({0}[{1}][0].data());",
-                         methodArrayName, std::to_string(i));
+      out += GenProxySetFuncName(serviceName, i);
       if (enable_explicit_link_proto) {
         out += LineFeed(1);
         out += fmt::format(
@@ -407,8 +453,7 @@ static std::string GenProxySyncCall(const ::google::protobuf::ServiceDescriptor*
           GetParamterTypeWithNamespace(method->input_type()->full_name()), serviceName, method->name(),
           GetParamterTypeWithNamespace(method->output_type()->full_name()));
       out += LineFeed(1);
-      out += fmt::format("if (context->GetFuncName().empty()) context->SetFuncName({0}[{1}][0].data());",
-                         methodArrayName, std::to_string(i));
+      out += GenProxySetFuncName(serviceName, i);
       if (enable_explicit_link_proto) {
         out += LineFeed(1);
         out += fmt::format(
@@ -429,8 +474,7 @@ static std::string GenProxySyncCall(const ::google::protobuf::ServiceDescriptor*
           GetParamterTypeWithNamespace(method->output_type()->full_name()), serviceName, method->name(),
           GetParamterTypeWithNamespace(method->input_type()->full_name()));
       out += LineFeed(1);
-      out += fmt::format("if (context->GetFuncName().empty()) context->SetFuncName({0}[{1}][0].data());",
-                         methodArrayName, std::to_string(i));
+      out += GenProxySetFuncName(serviceName, i);
       if (enable_explicit_link_proto) {
         out += LineFeed(1);
         out += fmt::format(
@@ -451,8 +495,7 @@ static std::string GenProxySyncCall(const ::google::protobuf::ServiceDescriptor*
           GetParamterTypeWithNamespace(method->input_type()->full_name()),
           GetParamterTypeWithNamespace(method->output_type()->full_name()), serviceName, method->name());
       out += LineFeed(1);
-      out += fmt::format("if (context->GetFuncName().empty()) context->SetFuncName({0}[{1}][0].data());",
-                         methodArrayName, std::to_string(i));
+      out += GenProxySetFuncName(serviceName, i);
       if (enable_explicit_link_proto) {
         out += LineFeed(1);
         out += fmt::format(
@@ -477,7 +520,6 @@ static std::string GenProxyOnewayCall(const ::google::protobuf::ServiceDescripto
   out.reserve(8 * 1024);
 
   const auto& serviceName = service->name();
-  const auto& methodArrayName = serviceName + "_method_names";
 
   for (int i = 0; i < service->method_count(); ++i) {
     auto method = service->method(i);
@@ -495,8 +537,7 @@ static std::string GenProxyOnewayCall(const ::google::protobuf::ServiceDescripto
         "::trpc::Status {0}ServiceProxy::{1}(const ::trpc::ClientContextPtr& context, const {2}& request) {{",
         serviceName, method->name(), GetParamterTypeWithNamespace(method->input_type()->full_name()));
     out += LineFeed(1);
-    out += fmt::format("if (context->GetFuncName().empty()) context->SetFuncName({0}[{1}][0].data());",
-                       methodArrayName, std::to_string(i));
+    out += GenProxySetFuncName(serviceName, i);
     if (enable_explicit_link_proto) {
       out += LineFeed(1);
       out += fmt::format(
@@ -515,7 +556,7 @@ static std::string GenProxyOnewayCall(const ::google::protobuf::ServiceDescripto
 
 /*
 ::trpc::Future<HelloReply> GreeterServiceProxy::AsyncSayHello(const ::trpc::ClientContextPtr& context,
-const HelloRequest& request) { context->SetFuncName(Greeter_method_names[0][0].data()); return
+const HelloRequest& request) { context->SetFuncName(Greeter_method_names[0][0].data(), Greeter_method_ids[0]); return
 AsyncUnaryInvoke<HelloRequest, HelloReply>(context, request);
 }
 */
@@ -525,7 +566,6 @@ static std::string GenProxyAsyncCall(const ::google::protobuf::ServiceDescriptor
   out.reserve(8 * 1024);
 
   const auto& serviceName = service->name();
-  const auto& methodArrayName = serviceName + "_method_names";
 
   for (int i = 0; i < service->method_count(); ++i) {
     auto method = service->method(i);
@@ -544,8 +584,7 @@ static std::string GenProxyAsyncCall(const ::google::protobuf::ServiceDescriptor
         GetParamterTypeWithNamespace(method->output_type()->full_name()), serviceName, method->name(),
         GetParamterTypeWithNamespace(method->input_type()->full_name()));
     out += LineFeed(indent + 1);
-    out += fmt::format("if (context->GetFuncName().empty()) context->SetFuncName({0}[{1}][0].data());",
-                       methodArrayName, std::to_string(i));
+    out += GenProxySetFuncName(serviceName, i);
     if (enable_explicit_link_proto) {
       out += LineFeed(1);
       out += fmt::format(
@@ -569,7 +608,6 @@ static std::string GenAsyncProxyAsyncCall(const ::google::protobuf::ServiceDescr
   out.reserve(8 * 1024);
 
   const auto& serviceName = service->name();
-  const auto& methodArrayName = serviceName + "_method_names";
 
   for (int i = 0; i < service->method_count(); ++i) {
     auto method = service->method(i);
@@ -584,8 +622,7 @@ static std::string GenAsyncProxyAsyncCall(const ::google::protobuf::ServiceDescr
     out += LineFeed(indent);
 
     auto common = [&]() {
-      out += fmt::format("if (context->GetFuncName().empty()) context->SetFuncName({0}[{1}][0].data());",
-                         methodArrayName, i);
+      out += GenProxySetFuncName(serviceName, i);
       out += LineFeed(indent);
       if (enable_explicit_link_proto) {
         out += fmt::format(
@@ -786,6 +823,7 @@ std::string GenTrpcSrcFile(const google::protobuf::FileDescriptor* file, const s
   for (int i = 0; i < file->service_count(); ++i) {
     auto service = file->service(i);
     out += GenServiceMethodNameArray(service, pkg);
+    out += GenServiceMethodIdArray(service, pkg);
     out += GenServiceConDestructor(service, pkg);
     if (enable_explicit_link_proto) {
       out += GenGetServiceDescriptor(service, false);
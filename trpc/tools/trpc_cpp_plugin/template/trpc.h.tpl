@@ -8,6 +8,10 @@
 #include "trpc/client/rpc_service_proxy.h"
 #include "trpc/server/rpc_service_impl.h"
 
+#if defined(TRPC_BUILD_INCLUDE_COROUTINE) && defined(__cpp_impl_coroutine)
+#include "trpc/coroutine/coro/awaitable.h"
+#endif
+
 {{- $namespaces := (split .PackageName ".") }}
 {{ range $val := $namespaces }}
 namespace {{$val}} {
@@ -81,6 +85,11 @@ class {{ $svcName }}ServiceProxy : public ::trpc::RpcServiceProxy {
   virtual ::trpc::Status {{ $methodName }}(const ::trpc::ClientContextPtr& context, const {{ $rpcReqType }}& request, {{ $rpcRspType }}* response);
   virtual ::trpc::Future<{{ $rpcRspType }}> Async{{ $methodName }}(const ::trpc::ClientContextPtr& context, const {{ $rpcReqType }}& request);
   virtual ::trpc::Status {{ $methodName }}(const ::trpc::ClientContextPtr& context, const {{ $rpcReqType }}& request);
+#if defined(TRPC_BUILD_INCLUDE_COROUTINE) && defined(__cpp_impl_coroutine)
+  ::trpc::coro::Task<::trpc::Status> Co{{ $methodName }}(const ::trpc::ClientContextPtr& context, const {{ $rpcReqType }}& request, {{ $rpcRspType }}* response) {
+    return ::trpc::coro::AwaitUnaryResponse(Async{{ $methodName }}(context, request), response);
+  }
+#endif
   {{- end -}}{{/* end of if streaming */}}
 
   {{- end -}}{{/* end of $service.RPCs range */}}
@@ -378,6 +378,7 @@ int BindAdapter::SendTcpMsg(STransportRspMsg* msg) {
     IoMessage message;
     message.msg = std::move(msg->context);
     message.buffer = std::move(msg->buffer);
+    message.file_region = std::move(msg->file_region);
 
     if (stream_id == 0) {
       ret = conn->Send(std::move(message));
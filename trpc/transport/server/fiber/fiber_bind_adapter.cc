@@ -76,12 +76,16 @@ bool FiberBindAdapter::BindTcp() {
 
 #if !defined(SO_REUSEPORT) || defined(TRPC_DISABLE_REUSEPORT)
   TRPC_ASSERT(accept_num == 1);
+#else
+  if (bind_info.reuseport_per_reactor) {
+    accept_num = reactors.size();
+  }
 #endif
 
   uint32_t count = 0;
   for (auto* reactor : reactors) {
-    auto func = [this](AcceptConnectionInfo& connection_info) {
-      return this->transport_->AcceptConnection(connection_info);
+    auto func = [this, reactor](AcceptConnectionInfo& connection_info) {
+      return this->transport_->AcceptConnection(connection_info, reactor);
     };
     auto acceptor = MakeRefCounted<FiberAcceptor>(reactor, addr);
     acceptor->SetAcceptHandleFunction(std::move(func));
@@ -155,6 +159,13 @@ bool FiberBindAdapter::BindUdp() {
   return true;
 }
 
+bool FiberBindAdapter::SetReusePortCpuSteering(uint32_t listener_num) {
+  if (acceptors_.empty()) {
+    return false;
+  }
+  return acceptors_.front()->SetReusePortCpuSteering(listener_num);
+}
+
 bool FiberBindAdapter::Listen() {
   for (auto& acceptor : acceptors_) {
     if (!acceptor->Listen()) {
@@ -239,6 +250,7 @@ int FiberBindAdapter::SendTcpMsg(STransportRspMsg* msg) {
     IoMessage message;
     message.msg = std::move(msg->context);
     message.buffer = std::move(msg->buffer);
+    message.file_region = std::move(msg->file_region);
 
     int ret = -1;
     if (stream_id == 0) {
@@ -255,6 +267,7 @@ int FiberBindAdapter::SendTcpMsg(STransportRspMsg* msg) {
     IoMessage message;
     message.msg = std::move(msg->context);
     message.buffer = std::move(msg->buffer);
+    message.file_region = std::move(msg->file_region);
 
     if (stream_id == 0 ||
         TRPC_LIKELY(fiber_conn->GetConnectionHandler()->EncodeStreamMessage(&message))) {
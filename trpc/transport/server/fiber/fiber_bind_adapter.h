@@ -40,6 +40,13 @@ class FiberBindAdapter : public RefCounted<FiberBindAdapter> {
 
   bool Listen();
 
+  /// @brief Attach the reuseport program steering connections by rx cpu to the listeners, it applies to the listeners
+  ///        of all bind adapters of the transport as they are in the same SO_REUSEPORT group
+  bool SetReusePortCpuSteering(uint32_t listener_num);
+
+  /// @brief The number of tcp listeners of this adapter
+  size_t GetAcceptorNum() const { return acceptors_.size(); }
+
   void StopListen(bool clean_conn);
 
   void Stop();
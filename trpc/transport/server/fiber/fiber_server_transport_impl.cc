@@ -61,6 +61,17 @@ bool FiberServerTransportImpl::Listen() {
 #endif
   }
 
+  if (bind_info_.reuseport_per_reactor && bind_info_.reuseport_cpu_affinity) {
+    // Listeners join the SO_REUSEPORT group in the order of reactors, so the i-th reactor serves rx cpu i, i+n, ...
+    uint32_t listener_num = 0;
+    for (auto& adapter : bind_adapters_) {
+      listener_num += adapter->GetAcceptorNum();
+    }
+    if (listener_num > 0 && !bind_adapters_.front()->SetReusePortCpuSteering(listener_num)) {
+      TRPC_FMT_WARN("steer connections by rx cpu failed, fall back to hash of reuseport.");
+    }
+  }
+
   return true;
 }
 
@@ -88,7 +99,7 @@ int FiberServerTransportImpl::SendMsg(STransportRspMsg* msg) {
   return bind_adapters_[GetIndexOfBindAdapter(msg->context->GetConnectionId())]->SendMsg(msg);
 }
 
-bool FiberServerTransportImpl::AcceptConnection(AcceptConnectionInfo& connection_info) {
+bool FiberServerTransportImpl::AcceptConnection(AcceptConnectionInfo& connection_info, Reactor* accept_reactor) {
   int alive_conn_num = alive_conns_.fetch_add(1, std::memory_order_relaxed);
   if (alive_conn_num >= static_cast<int>(bind_info_.max_conn_num)) {
     TRPC_FMT_ERROR("too many connections {} and connection {} droped.",
@@ -106,14 +117,20 @@ bool FiberServerTransportImpl::AcceptConnection(AcceptConnectionInfo& connection
     }
   }
 
+  Reactor* reactor = nullptr;
 #if defined(SO_REUSEPORT) && !defined(TRPC_DISABLE_REUSEPORT)
   std::size_t scheduling_group_index = fiber::GetCurrentSchedulingGroupIndex();
+  if (bind_info_.reuseport_per_reactor) {
+    // Keep the connection on the reactor (and scheduling group) that accepted it, rather than spreading it by fd.
+    reactor = accept_reactor;
+  }
 #else
   std::size_t scheduling_group_index = Random() % fiber::GetSchedulingGroupCount();
 #endif
 
   if (TRPC_UNLIKELY(bind_info_.dispatch_accept_function)) {
     scheduling_group_index = bind_info_.dispatch_accept_function(connection_info, fiber::GetSchedulingGroupCount());
+    reactor = nullptr;
   }
 
   uint64_t conn_id = bind_adapters_[scheduling_group_index]->GenConnectionId();
@@ -123,7 +140,9 @@ bool FiberServerTransportImpl::AcceptConnection(AcceptConnectionInfo& connection
     return false;
   }
 
-  Reactor* reactor = fiber::GetReactor(scheduling_group_index, connection_info.socket.GetFd());
+  if (reactor == nullptr) {
+    reactor = fiber::GetReactor(scheduling_group_index, connection_info.socket.GetFd());
+  }
   TRPC_ASSERT(reactor != nullptr);
 
   TRPC_FMT_DEBUG("server accept connection {} and connid {}.", connection_info.conn_info.ToString(), conn_id);
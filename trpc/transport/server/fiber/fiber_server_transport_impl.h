@@ -44,7 +44,8 @@ class FiberServerTransportImpl final : public ServerTransport {
 
   int SendMsg(STransportRspMsg* msg) override;
 
-  bool AcceptConnection(AcceptConnectionInfo& connection_info);
+  /// @brief Handle the connection accepted by the listener running on `accept_reactor`
+  bool AcceptConnection(AcceptConnectionInfo& connection_info, Reactor* accept_reactor = nullptr);
 
   BindInfo& GetBindInfo() { return bind_info_; }
 
@@ -99,6 +99,77 @@ TEST(FiberServerTransportImplTest, Tcp) {
   server_transport.Destroy();
 }
 
+TEST(FiberServerTransportImplTest, TcpReusePortPerReactor) {
+  FiberServerTransportImpl server_transport;
+
+  BindInfo info;
+  info.is_ipv6 = false;
+  info.socket_type = "net";
+  info.ip = "0.0.0.0";
+  info.port = trpc::util::GenRandomAvailablePort();
+  info.network = "tcp";
+  info.protocol = "raw";
+  info.reuseport_per_reactor = true;
+  info.reuseport_cpu_affinity = true;
+  info.accept_function = nullptr;
+  info.checker_function = [](const ConnectionPtr& conn, NoncontiguousBuffer& in, std::deque<std::any>& out) {
+    EXPECT_TRUE(in.ByteSize() > 0);
+    out.push_back(in);
+    return PacketChecker::PACKET_FULL;
+  };
+  info.msg_handle_function = [&server_transport](const ConnectionPtr& conn, std::deque<std::any>& msg) {
+    EXPECT_TRUE(msg.size() > 0);
+    auto it = msg.begin();
+    while (it != msg.end()) {
+      auto& buff = std::any_cast<trpc::NoncontiguousBuffer&>(*it);
+      auto* rsp = trpc::object_pool::New<STransportRspMsg>();
+
+      trpc::ServerContextPtr context = trpc::MakeRefCounted<ServerContext>();
+      context->SetConnectionId(conn->GetConnId());
+      context->SetNetType(ServerContext::NetType::kTcp);
+      context->SetReserved(conn.Get());
+      context->SetIp(conn->GetPeerIp());
+      context->SetPort(conn->GetPeerPort());
+
+      rsp->context = context;
+      rsp->buffer = std::move(buff);
+
+      server_transport.SendMsg(rsp);
+
+      ++it;
+    }
+
+    return true;
+  };
+  info.run_server_filters_function = [](FilterPoint, STransportRspMsg*) { return FilterStatus::CONTINUE; };
+
+  server_transport.Bind(info);
+  ASSERT_TRUE(server_transport.Listen());
+
+  NetworkAddress addr(info.ip, info.port, info.is_ipv6 ? NetworkAddress::IpType::kIpV6 : NetworkAddress::IpType::kIpV4);
+
+  // Connections are accepted by different listeners, each one is served by the reactor accepting it.
+  for (int i = 0; i < 8; ++i) {
+    Socket socket = Socket::CreateTcpSocket(addr.IsIpv6());
+
+    int ret = socket.Connect(addr);
+    ASSERT_TRUE(ret == 0);
+
+    char message[] = "helloworld, this is tcp client";
+    int send_size = socket.Send(message, sizeof(message));
+    ASSERT_TRUE(send_size > 0);
+
+    char recvbuf[1024] = {0};
+    socket.Recv(recvbuf, sizeof(recvbuf));
+
+    ASSERT_STREQ(recvbuf, message);
+    socket.Close();
+  }
+
+  server_transport.Stop();
+  server_transport.Destroy();
+}
+
 TEST(FiberServerTransportImplTest, TcpByAsyncSend) {
   FiberServerTransportImpl server_transport;
 
@@ -59,6 +59,10 @@ struct BindInfo {
   uint32_t max_conn_num{10000};
   uint32_t idle_time{60000};
   uint32_t accept_thread_num{1};
+  // One SO_REUSEPORT listener per reactor, the connection stays on the accepting reactor (fiber runtime)
+  bool reuseport_per_reactor{false};
+  // Select the listener by the cpu receiving the packet, used with `reuseport_per_reactor`
+  bool reuseport_cpu_affinity{false};
 
   // Whether the upper-layer business processing methods has stream rpc methods
   bool has_stream_rpc = false;
@@ -16,6 +16,7 @@
 #include <cstdint>
 #include <string>
 
+#include "trpc/runtime/iomodel/reactor/common/file_region.h"
 #include "trpc/server/server_context.h"
 #include "trpc/util/buffer/noncontiguous_buffer.h"
 #include "trpc/util/object_pool/object_pool.h"
@@ -30,6 +31,9 @@ struct alignas(8) STransportMessage {
 
   /// The serialized data of the response
   NoncontiguousBuffer buffer;
+
+  /// The file sent after `buffer` as the body of the response (only for tcp), e.g. file download of http
+  FileRegionPtr file_region{nullptr};
 };
 
 using STransportReqMsg = STransportMessage;
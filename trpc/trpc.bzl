@@ -621,7 +621,11 @@ def trpc_proto_library(
             "%s//trpc/server:stream_rpc_async_method_handler" % rootpath,
             "%s//trpc/server:stream_rpc_method_handler" % rootpath,
             "%s//trpc/stream:stream" % rootpath,
-        ]
+        ] + select({
+            # `Co<Method>` of generated proxies, only with `--define trpc_include_coroutine=true`.
+            "%s//trpc:trpc_include_coroutine" % rootpath: ["%s//trpc/coroutine/coro:awaitable" % rootpath],
+            "//conditions:default": [],
+        })
         plugin_language = "trpc"
         if plugin == None:
             plugin = "%s//trpc/tools/trpc_cpp_plugin:trpc_cpp_plugin" % rootpath
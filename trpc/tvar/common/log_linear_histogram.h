@@ -0,0 +1,237 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <math.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "trpc/tvar/common/write_mostly.h"
+
+namespace trpc::tvar {
+
+/// @brief Log-linear (HDR-style) histogram of uint32_t values with fixed memory.
+///        Values below 2^kSubBucketBits are counted exactly, every following power of two range is divided into
+///        2^kSubBucketBits linear sub buckets, so the relative error of any bucket is less than 1/2^kSubBucketBits.
+///        Histograms are mergeable and subtractable, which makes them usable inside Window.
+/// @private
+class LogLinearHistogram {
+ public:
+  /// Number of bits used by linear sub buckets, 5 means relative error is less than 1/32.
+  static constexpr uint32_t kSubBucketBits = 5;
+  /// Number of linear sub buckets inside each power of two range.
+  static constexpr uint32_t kSubBucketCount = 1u << kSubBucketBits;
+  /// Total number of buckets to cover all uint32_t values.
+  static constexpr size_t kBucketCount = static_cast<size_t>(32 - kSubBucketBits + 1) << kSubBucketBits;
+
+  /// @brief Get the index of the bucket which value belongs to.
+  static size_t BucketIndex(uint32_t value) {
+    if (value < kSubBucketCount) {
+      return value;
+    }
+    const uint32_t exponent = 31 - __builtin_clz(value);
+    const uint32_t shift = exponent - kSubBucketBits;
+    return (static_cast<size_t>(shift + 1) << kSubBucketBits) + ((value >> shift) - kSubBucketCount);
+  }
+
+  /// @brief Get the smallest value inside bucket.
+  static uint32_t BucketLowerBound(size_t index) {
+    if (index < kSubBucketCount) {
+      return static_cast<uint32_t>(index);
+    }
+    const size_t group = index >> kSubBucketBits;
+    const uint64_t sub = index & (kSubBucketCount - 1);
+    return static_cast<uint32_t>((kSubBucketCount + sub) << (group - 1));
+  }
+
+  /// @brief Get the largest value inside bucket.
+  static uint32_t BucketUpperBound(size_t index) {
+    if (index + 1 >= kBucketCount) {
+      return std::numeric_limits<uint32_t>::max();
+    }
+    return BucketLowerBound(index + 1) - 1;
+  }
+
+  /// @brief Add one value.
+  void Add(uint32_t value) {
+    ++buckets_[BucketIndex(value)];
+    ++count_;
+    sum_ += value;
+  }
+
+  /// @brief Merge all counts of rhs into current histogram.
+  void Merge(const LogLinearHistogram& rhs) {
+    for (size_t i = 0; i < kBucketCount; ++i) {
+      buckets_[i] += rhs.buckets_[i];
+    }
+    count_ += rhs.count_;
+    sum_ += rhs.sum_;
+  }
+
+  /// @brief Remove all counts of rhs from current histogram, rhs must be a former snapshot of current one.
+  void Subtract(const LogLinearHistogram& rhs) {
+    for (size_t i = 0; i < kBucketCount; ++i) {
+      buckets_[i] -= rhs.buckets_[i];
+    }
+    count_ -= rhs.count_;
+    sum_ -= rhs.sum_;
+  }
+
+  /// @brief Get the `ratio'-ile value. E.g. 0.99 means 99%-ile value.
+  /// @return Upper bound of the bucket holding the value, the error is bounded by the width of the bucket.
+  uint32_t GetNumber(double ratio) const {
+    if (count_ == 0) {
+      return 0;
+    }
+    auto n = static_cast<uint64_t>(ceil(ratio * count_));
+    if (n == 0) {
+      n = 1;
+    }
+    uint64_t accumulated = 0;
+    size_t last_non_empty = 0;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+      if (buckets_[i] == 0) {
+        continue;
+      }
+      accumulated += buckets_[i];
+      last_non_empty = i;
+      if (accumulated >= n) {
+        return BucketUpperBound(i);
+      }
+    }
+    // Snapshot taken during concurrent updates may has inconsistent count.
+    return BucketUpperBound(last_non_empty);
+  }
+
+  /// @brief Get average of all values.
+  uint64_t Average() const { return count_ > 0 ? sum_ / count_ : 0; }
+
+  /// @brief Visit all non-empty buckets in ascending order, func is invoked by (index, count).
+  template <typename F>
+  void ForEachBucket(F&& func) const {
+    for (size_t i = 0; i < kBucketCount; ++i) {
+      if (buckets_[i] != 0) {
+        func(i, buckets_[i]);
+      }
+    }
+  }
+
+  uint64_t BucketCount(size_t index) const { return buckets_[index]; }
+
+  uint64_t Count() const { return count_; }
+
+  uint64_t Sum() const { return sum_; }
+
+ private:
+  friend class AtomicLogLinearHistogram;
+
+  uint64_t buckets_[kBucketCount]{0};
+  uint64_t count_{0};
+  uint64_t sum_{0};
+};
+
+/// @brief Thread local write buffer of LogLinearHistogram.
+/// @note Only the owner thread writes, so updating is done by relaxed load and store without any lock.
+/// @private
+class AtomicLogLinearHistogram {
+ public:
+  /// @brief Only called by owner thread.
+  void Add(uint32_t value) {
+    Increase(&buckets_[LogLinearHistogram::BucketIndex(value)], 1);
+    Increase(&count_, 1);
+    Increase(&sum_, value);
+  }
+
+  /// @brief Take a snapshot.
+  LogLinearHistogram Load() const {
+    LogLinearHistogram ret;
+    for (size_t i = 0; i < LogLinearHistogram::kBucketCount; ++i) {
+      ret.buckets_[i] = buckets_[i].load(std::memory_order_relaxed);
+    }
+    ret.count_ = count_.load(std::memory_order_relaxed);
+    ret.sum_ = sum_.load(std::memory_order_relaxed);
+    return ret;
+  }
+
+  void Store(const LogLinearHistogram& value) {
+    for (size_t i = 0; i < LogLinearHistogram::kBucketCount; ++i) {
+      buckets_[i].store(value.buckets_[i], std::memory_order_relaxed);
+    }
+    count_.store(value.count_, std::memory_order_relaxed);
+    sum_.store(value.sum_, std::memory_order_relaxed);
+  }
+
+  void Exchange(LogLinearHistogram* prev, const LogLinearHistogram& value) {
+    for (size_t i = 0; i < LogLinearHistogram::kBucketCount; ++i) {
+      prev->buckets_[i] = buckets_[i].exchange(value.buckets_[i], std::memory_order_relaxed);
+    }
+    prev->count_ = count_.exchange(value.count_, std::memory_order_relaxed);
+    prev->sum_ = sum_.exchange(value.sum_, std::memory_order_relaxed);
+  }
+
+ private:
+  static void Increase(std::atomic<uint64_t>* counter, uint64_t n) {
+    counter->store(counter->load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+  }
+
+ private:
+  std::atomic<uint64_t> buckets_[LogLinearHistogram::kBucketCount]{};
+  std::atomic<uint64_t> count_{0};
+  std::atomic<uint64_t> sum_{0};
+};
+
+/// @brief Traits to merge thread local histograms through WriteMostly.
+/// @note Samplers take the cumulative value and window value is got by subtracting, so thread local buffers are never
+///       reset by samplers.
+/// @private
+struct LogLinearHistogramTraits {
+  struct MergeHistogram {
+    void operator()(LogLinearHistogram* left, const LogLinearHistogram& right) const { left->Merge(right); }
+  };
+
+  struct SubtractHistogram {
+    void operator()(LogLinearHistogram* left, const LogLinearHistogram& right) const { left->Subtract(right); }
+  };
+
+  using Type = LogLinearHistogram;
+  using WriteBuffer = AtomicLogLinearHistogram;
+  using InputDataType = uint32_t;
+  using ResultType = LogLinearHistogram;
+  using SamplerOp = MergeHistogram;
+  using SamplerInvOp = SubtractHistogram;
+
+  /// @brief Update value into thread local.
+  template <typename TLS>
+  static void Update(TLS* wb, InputDataType val) {
+    wb->buffer_.Add(val);
+  }
+
+  /// @brief Merge thread local into global.
+  static void Merge(ResultType* wb1, const Type& wb2) { MergeHistogram()(wb1, wb2); }
+};
+
+/// @brief High performance histogram counter.
+/// @note DON'T use it directly, use HistogramRecorder instead.
+/// @private
+class WriteMostlyHistogram : public WriteMostly<LogLinearHistogramTraits> {
+ public:
+  WriteMostlyHistogram()
+      : WriteMostly<LogLinearHistogramTraits>(LogLinearHistogramTraits::ResultType{},
+                                              LogLinearHistogramTraits::Type{}) {}
+};
+
+}  // namespace trpc::tvar
@@ -0,0 +1,114 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/tvar/common/log_linear_histogram.h"
+
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+using trpc::tvar::LogLinearHistogram;
+using trpc::tvar::WriteMostlyHistogram;
+
+}  // namespace
+
+namespace trpc::testing {
+
+/// @brief Every value must fall into the bucket bounded by its lower and upper bound.
+TEST(LogLinearHistogramTest, BucketBound) {
+  std::vector<uint32_t> values = {0, 1, 31, 32, 33, 63, 64, 65, 1000, 4095, 4096, 123456789,
+                                  std::numeric_limits<uint32_t>::max()};
+  for (uint32_t i = 0; i < 100000; i += 7) {
+    values.push_back(i);
+  }
+  for (auto value : values) {
+    size_t index = LogLinearHistogram::BucketIndex(value);
+    ASSERT_LT(index, LogLinearHistogram::kBucketCount);
+    ASSERT_LE(LogLinearHistogram::BucketLowerBound(index), value);
+    ASSERT_GE(LogLinearHistogram::BucketUpperBound(index), value);
+    // Relative error is bounded by the width of bucket.
+    uint64_t width = LogLinearHistogram::BucketUpperBound(index) - LogLinearHistogram::BucketLowerBound(index);
+    ASSERT_LE(width * LogLinearHistogram::kSubBucketCount, std::max<uint64_t>(value, 1) * 1);
+  }
+  // Buckets are contiguous.
+  for (size_t i = 1; i < LogLinearHistogram::kBucketCount; ++i) {
+    ASSERT_EQ(LogLinearHistogram::BucketUpperBound(i - 1) + 1, LogLinearHistogram::BucketLowerBound(i));
+  }
+  ASSERT_EQ(LogLinearHistogram::kBucketCount - 1,
+            LogLinearHistogram::BucketIndex(std::numeric_limits<uint32_t>::max()));
+}
+
+/// @brief Percentiles are accurate in the tail.
+TEST(LogLinearHistogramTest, GetNumber) {
+  LogLinearHistogram histogram;
+  ASSERT_EQ(0, histogram.GetNumber(0.99));
+  for (uint32_t i = 1; i <= 100000; ++i) {
+    histogram.Add(i);
+  }
+  ASSERT_EQ(100000, histogram.Count());
+  ASSERT_EQ(50000, histogram.Average());
+  for (double ratio : {0.5, 0.9, 0.99, 0.999, 0.9999}) {
+    double expected = ratio * 100000;
+    uint32_t value = histogram.GetNumber(ratio);
+    ASSERT_GE(value, expected);
+    ASSERT_LE(value, expected * (1 + 1.0 / LogLinearHistogram::kSubBucketCount));
+  }
+  ASSERT_EQ(1, histogram.GetNumber(0));
+}
+
+/// @brief Merge and subtract are inverse operations.
+TEST(LogLinearHistogramTest, MergeAndSubtract) {
+  LogLinearHistogram h1;
+  LogLinearHistogram h2;
+  for (uint32_t i = 0; i < 1000; ++i) {
+    h1.Add(i);
+    h2.Add(i * 1000);
+  }
+  LogLinearHistogram merged = h1;
+  merged.Merge(h2);
+  ASSERT_EQ(2000, merged.Count());
+  ASSERT_EQ(h1.Sum() + h2.Sum(), merged.Sum());
+  merged.Subtract(h1);
+  ASSERT_EQ(h2.Count(), merged.Count());
+  for (size_t i = 0; i < LogLinearHistogram::kBucketCount; ++i) {
+    ASSERT_EQ(h2.BucketCount(i), merged.BucketCount(i));
+  }
+}
+
+/// @brief Thread local histograms are merged.
+TEST(LogLinearHistogramTest, WriteMostly) {
+  WriteMostlyHistogram histogram;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; ++t) {
+    threads.emplace_back([&histogram]() {
+      for (uint32_t i = 1; i <= 10000; ++i) {
+        histogram.Update(i);
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  auto value = histogram.GetValue();
+  ASSERT_EQ(80000, value.Count());
+  ASSERT_EQ(8 * 10000 * 10001 / 2, value.Sum());
+  ASSERT_GE(value.GetNumber(0.999), 9990);
+  ASSERT_LE(value.GetNumber(0.999), 9990 * (1 + 1.0 / LogLinearHistogram::kSubBucketCount));
+}
+
+}  // namespace trpc::testing
@@ -0,0 +1,157 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/tvar/compound_ops/histogram_recorder.h"
+
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#ifdef TRPC_BUILD_INCLUDE_PROMETHEUS
+#include "prometheus/collectable.h"
+#include "prometheus/metric_family.h"
+
+#include "trpc/util/prometheus.h"
+#endif
+
+namespace trpc::tvar {
+
+namespace detail {
+
+#ifdef TRPC_BUILD_INCLUDE_PROMETHEUS
+/// @brief Export the cumulative histogram of a HistogramRecorder to Prometheus.
+class HistogramPrometheusCollectable : public ::prometheus::Collectable {
+ public:
+  HistogramPrometheusCollectable(std::string name, const HistogramRecorder* owner)
+      : name_(std::move(name)), owner_(owner) {}
+
+  std::vector<::prometheus::MetricFamily> Collect() const override {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (owner_ == nullptr) {
+      return {};
+    }
+    LogLinearHistogram histogram = owner_->GetHistogram();
+    lock.unlock();
+
+    ::prometheus::ClientMetric metric;
+    metric.histogram.sample_count = histogram.Count();
+    metric.histogram.sample_sum = static_cast<double>(histogram.Sum());
+    // Buckets never become empty again once counted, so the set of `le` labels only grows between scrapes.
+    uint64_t cumulative_count = 0;
+    histogram.ForEachBucket([&](size_t index, uint64_t count) {
+      cumulative_count += count;
+      ::prometheus::ClientMetric::Bucket bucket;
+      bucket.cumulative_count = cumulative_count;
+      bucket.upper_bound = static_cast<double>(LogLinearHistogram::BucketUpperBound(index));
+      metric.histogram.bucket.emplace_back(std::move(bucket));
+    });
+
+    ::prometheus::MetricFamily family;
+    family.name = name_;
+    family.help = "tvar log-linear histogram";
+    family.type = ::prometheus::MetricType::Histogram;
+    family.metric.emplace_back(std::move(metric));
+    return {std::move(family)};
+  }
+
+  /// @brief Called when owner destructs.
+  void Detach() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    owner_ = nullptr;
+  }
+
+ private:
+  std::string name_;
+  mutable std::mutex mutex_;
+  const HistogramRecorder* owner_;
+};
+#else
+class HistogramPrometheusCollectable {};
+#endif
+
+}  // namespace detail
+
+namespace {
+
+/// @brief Convert tvar path into a valid Prometheus metric name, eg. "/user/rpc.latency" to "user_rpc_latency".
+[[maybe_unused]] std::string ToPrometheusName(std::string_view abs_path) {
+  std::string name;
+  name.reserve(abs_path.size());
+  for (char c : abs_path) {
+    bool valid = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == ':';
+    if (!valid) {
+      c = '_';
+    }
+    if (c == '_' && (name.empty() || name.back() == '_')) {
+      continue;
+    }
+    name.push_back(c);
+  }
+  if (!name.empty() && name.front() >= '0' && name.front() <= '9') {
+    name.insert(name.begin(), '_');
+  }
+  return name;
+}
+
+}  // namespace
+
+HistogramRecorder::HistogramRecorder(time_t window_size)
+    : histogram_(), histogram_window_(&histogram_, window_size) {}
+
+HistogramRecorder::HistogramRecorder(TrpcVarGroup* parent, std::string_view rel_path, time_t window_size)
+    : histogram_(), histogram_window_(&histogram_, window_size) {
+  handle_ = TrpcVarGroup::LinkToParent(rel_path, parent, [this] { return ToJsonValue(); });
+#ifdef TRPC_BUILD_INCLUDE_PROMETHEUS
+  if (handle_) {
+    prometheus_collectable_ =
+        std::make_shared<detail::HistogramPrometheusCollectable>(ToPrometheusName(handle_->abs_path), this);
+    trpc::prometheus::RegisterCollectable(prometheus_collectable_);
+  }
+#endif
+}
+
+HistogramRecorder::~HistogramRecorder() {
+  // Unlink from group before members destruct.
+  handle_.reset();
+#ifdef TRPC_BUILD_INCLUDE_PROMETHEUS
+  if (prometheus_collectable_) {
+    prometheus_collectable_->Detach();
+  }
+#endif
+}
+
+Json::Value HistogramRecorder::ToJsonValue() const {
+  LogLinearHistogram histogram = GetWindowHistogram();
+
+  Json::Value value;
+  value["count"] = static_cast<Json::UInt64>(histogram.Count());
+  value["avg"] = static_cast<Json::UInt64>(histogram.Average());
+  value["p50"] = histogram.GetNumber(0.5);
+  value["p90"] = histogram.GetNumber(0.9);
+  value["p99"] = histogram.GetNumber(0.99);
+  value["p999"] = histogram.GetNumber(0.999);
+  value["p9999"] = histogram.GetNumber(0.9999);
+
+  Json::Value buckets(Json::arrayValue);
+  histogram.ForEachBucket([&buckets](size_t index, uint64_t count) {
+    Json::Value bucket;
+    bucket["lower"] = LogLinearHistogram::BucketLowerBound(index);
+    bucket["upper"] = LogLinearHistogram::BucketUpperBound(index);
+    bucket["count"] = static_cast<Json::UInt64>(count);
+    buckets.append(std::move(bucket));
+  });
+  value["buckets"] = std::move(buckets);
+  return value;
+}
+
+}  // namespace trpc::tvar
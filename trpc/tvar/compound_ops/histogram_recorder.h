@@ -0,0 +1,92 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "json/json.h"
+
+#include "trpc/tvar/common/log_linear_histogram.h"
+#include "trpc/tvar/common/tvar_group.h"
+#include "trpc/tvar/compound_ops/window.h"
+
+namespace trpc::tvar {
+
+namespace detail {
+
+/// @private
+class HistogramPrometheusCollectable;
+
+}  // namespace detail
+
+/// @brief Record latency (or any uint32_t value) into a log-linear histogram.
+///        Compared with LatencyRecorder, percentiles are not estimated from reservoir samples, the error of any
+///        percentile is bounded by the bucket width (less than 1/32 of the value), which makes p999/p9999 reliable.
+///        Memory is fixed, about 7KB per updating thread.
+/// @note  When exposed, the histogram of current window can be queried by admin, and the cumulative histogram is
+///        exported to Prometheus with the bucket upper bounds as the `le` labels if prometheus is enabled.
+class HistogramRecorder {
+ public:
+  /// @private
+  using HistogramWindow = Window<WriteMostlyHistogram, SeriesFrequency::SERIES_IN_SECOND>;
+
+ public:
+  /// @brief Use tvar window size in config as default value.
+  explicit HistogramRecorder(time_t window_size = -1);
+
+  HistogramRecorder(TrpcVarGroup* parent, std::string_view rel_path, time_t window_size = -1);
+
+  explicit HistogramRecorder(std::string_view rel_path, time_t window_size = -1)
+      : HistogramRecorder(TrpcVarGroup::FindOrCreate("/"), rel_path, window_size) {}
+
+  ~HistogramRecorder();
+
+  time_t WindowSize() const { return histogram_window_.WindowSize(); }
+
+  void Update(uint32_t value) { histogram_.Update(value); }
+
+  /// @brief Get histogram of all values ever updated.
+  LogLinearHistogram GetHistogram() const { return histogram_.GetValue(); }
+
+  /// @brief Get histogram of values updated in latest window.
+  LogLinearHistogram GetWindowHistogram(time_t window_size) const { return histogram_window_.GetValue(window_size); }
+
+  /// @brief Get histogram of values updated in latest default window.
+  LogLinearHistogram GetWindowHistogram() const { return histogram_window_.GetValue(); }
+
+  /// @brief Get count of all values ever updated.
+  uint64_t Count() const { return histogram_.GetValue().Count(); }
+
+  /// @brief Eg. get 99.9% value in current window.
+  uint32_t Percentile(double ratio) const { return GetWindowHistogram().GetNumber(ratio); }
+
+  std::string GetAbsPath() const { return IsExposed() ? handle_->abs_path : std::string(); }
+
+  bool IsExposed() const { return handle_.has_value(); }
+
+ private:
+  Json::Value ToJsonValue() const;
+
+ private:
+  WriteMostlyHistogram histogram_;
+  HistogramWindow histogram_window_;
+  std::optional<TrpcVarGroup::Handle> handle_;
+  std::shared_ptr<detail::HistogramPrometheusCollectable> prometheus_collectable_;
+};
+
+}  // namespace trpc::tvar
@@ -0,0 +1,106 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/tvar/compound_ops/histogram_recorder.h"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "trpc/common/config/trpc_config.h"
+
+namespace {
+
+using trpc::tvar::HistogramRecorder;
+using trpc::tvar::LogLinearHistogram;
+using trpc::tvar::TrpcVarGroup;
+
+}  // namespace
+
+namespace trpc::testing {
+
+/// @brief Test fixture to load config.
+class TestHistogramRecorder : public ::testing::Test {
+ public:
+  static void SetUpTestCase() {
+    ASSERT_EQ(trpc::TrpcConfig::GetInstance()->Init("trpc/tvar/testing/series.yaml"), 0);
+  }
+
+  static void TearDownTestCase() {}
+};
+
+/// @brief Test in single thread.
+TEST_F(TestHistogramRecorder, Test) {
+  HistogramRecorder recorder(100);
+  constexpr int N = 10000;
+
+  for (int i = 0; i < N; ++i) {
+    recorder.Update(i + 1);
+  }
+  ASSERT_EQ(recorder.Count(), N);
+
+  std::this_thread::sleep_for(std::chrono::seconds(3));
+
+  auto histogram = recorder.GetWindowHistogram();
+  ASSERT_EQ(histogram.Count(), N);
+  ASSERT_EQ(histogram.Average(), (N + 1) / 2);
+  for (double ratio : {0.1, 0.5, 0.9, 0.99, 0.999, 0.9999}) {
+    auto value = recorder.Percentile(ratio);
+    ASSERT_GE(value, ratio * N);
+    ASSERT_LE(value, ratio * N * (1 + 1.0 / LogLinearHistogram::kSubBucketCount));
+  }
+}
+
+/// @brief Test in multiple threads.
+TEST_F(TestHistogramRecorder, MultiThreads) {
+  std::vector<std::thread> v;
+  constexpr int ThreadNums = 10;
+  v.reserve(ThreadNums);
+  HistogramRecorder recorder(100);
+  for (int i = 1; i <= ThreadNums; ++i) {
+    v.emplace_back([a = i, &recorder]() {
+      for (int i = 0; i < 1000; ++i) {
+        recorder.Update(i * 10 + a);
+      }
+    });
+  }
+  for (auto&& t : v) {
+    t.join();
+  }
+  ASSERT_EQ(recorder.Count(), ThreadNums * 1000);
+
+  std::this_thread::sleep_for(std::chrono::seconds(3));
+  ASSERT_EQ(recorder.GetWindowHistogram().Count(), ThreadNums * 1000);
+  ASSERT_GE(recorder.Percentile(0.999), 9990);
+}
+
+/// @brief Test exposed value.
+TEST_F(TestHistogramRecorder, Exposed) {
+  HistogramRecorder recorder("user/histogram_recorder");
+  ASSERT_TRUE(recorder.IsExposed());
+  ASSERT_EQ(recorder.GetAbsPath(), "/user/histogram_recorder");
+  recorder.Update(10);
+  recorder.Update(1000);
+
+  std::this_thread::sleep_for(std::chrono::seconds(2));
+
+  auto value = TrpcVarGroup::TryGet("/user/histogram_recorder");
+  ASSERT_TRUE(value.has_value());
+  ASSERT_EQ((*value)["count"].asUInt64(), 2);
+  ASSERT_EQ((*value)["buckets"].size(), 2);
+  ASSERT_EQ((*value)["buckets"][0]["upper"].asUInt(), 10);
+}
+
+}  // namespace trpc::testing
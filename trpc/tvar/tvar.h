@@ -28,6 +28,7 @@
 #include "trpc/tvar/basic_ops/reducer.h"
 #include "trpc/tvar/basic_ops/status.h"
 #include "trpc/tvar/common/tvar_group.h"
+#include "trpc/tvar/compound_ops/histogram_recorder.h"
 #include "trpc/tvar/compound_ops/latency_recorder.h"
 #include "trpc/tvar/compound_ops/window.h"
 
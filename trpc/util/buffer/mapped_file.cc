@@ -0,0 +1,77 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/util/buffer/mapped_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+
+#include "trpc/util/log/logging.h"
+
+namespace trpc {
+
+RefPtr<MappedFile> MappedFile::Open(const std::string& path, std::size_t offset, std::optional<std::size_t> size) {
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    TRPC_FMT_ERROR("Failed to open file `{}`, errno: {}", path, errno);
+    return nullptr;
+  }
+  struct stat st;
+  if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+    TRPC_FMT_ERROR("`{}` is not a regular file", path);
+    ::close(fd);
+    return nullptr;
+  }
+  auto file_size = static_cast<std::size_t>(st.st_size);
+  if (offset > file_size || (size && *size > file_size - offset)) {
+    TRPC_FMT_ERROR("Region [{}, +{}) exceeds the size of file `{}`: {}", offset, size.value_or(0), path, file_size);
+    ::close(fd);
+    return nullptr;
+  }
+  auto mapped = Map(fd, offset, size.value_or(file_size - offset));
+  // The mapping holds a reference to the file itself.
+  ::close(fd);
+  return mapped;
+}
+
+RefPtr<MappedFile> MappedFile::Map(int fd, std::size_t offset, std::size_t size) {
+  static const std::size_t kPageSize = ::sysconf(_SC_PAGESIZE);
+
+  if (size == 0) {
+    // Nothing to map, mmap(2) refuses zero length.
+    return RefPtr(adopt_ptr, new MappedFile(nullptr, 0, nullptr, 0));
+  }
+  std::size_t aligned_offset = offset / kPageSize * kPageSize;
+  std::size_t length = size + (offset - aligned_offset);
+  void* addr = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, static_cast<off_t>(aligned_offset));
+  if (addr == MAP_FAILED) {
+    TRPC_FMT_ERROR("Failed to map [{}, +{}) of fd {}, errno: {}", offset, size, fd, errno);
+    return nullptr;
+  }
+  // It's usually written out from beginning to end, so read ahead aggressively.
+  ::madvise(addr, length, MADV_SEQUENTIAL);
+  const char* data = static_cast<const char*>(addr) + (offset - aligned_offset);
+  return RefPtr(adopt_ptr, new MappedFile(addr, length, data, size));
+}
+
+MappedFile::~MappedFile() {
+  if (addr_) {
+    ::munmap(addr_, length_);
+  }
+}
+
+}  // namespace trpc
@@ -0,0 +1,63 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string>
+
+#include "trpc/util/ref_ptr.h"
+
+namespace trpc {
+
+/// @brief A read-only region of file mapped into memory, it's unmapped once the last reference is gone.
+///        It's appended to `NoncontiguousBuffer` as a block, so file data (e.g. large attachments) is written to the
+///        network by writev without being copied into blocks of the memory pool.
+/// @note  Don't truncate the file while it's mapped, accessing pages beyond the end of file raises SIGBUS.
+class MappedFile : public RefCounted<MappedFile> {
+ public:
+  /// @brief Maps [offset, offset + size) of the file at `path`, or the rest of the file from `offset` if `size` is not
+  ///        specified.
+  /// @return nullptr if the file can't be mapped, e.g. it's not a regular file or the region exceeds the file.
+  static RefPtr<MappedFile> Open(const std::string& path, std::size_t offset = 0,
+                                 std::optional<std::size_t> size = std::nullopt);
+
+  /// @brief Maps [offset, offset + size) of an opened file, `fd` can be closed after this call.
+  /// @return nullptr on failure.
+  static RefPtr<MappedFile> Map(int fd, std::size_t offset, std::size_t size);
+
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  /// @brief Returns the beginning of the region.
+  const char* data() const noexcept { return data_; }
+
+  /// @brief Returns the size of the region.
+  std::size_t size() const noexcept { return size_; }
+
+ private:
+  MappedFile(void* addr, std::size_t length, const char* data, std::size_t size)
+      : addr_(addr), length_(length), data_(data), size_(size) {}
+
+ private:
+  // The mapping begins at a page boundary, so it may start before `data_`.
+  void* addr_;
+  std::size_t length_;
+  const char* data_;
+  std::size_t size_;
+};
+
+}  // namespace trpc
@@ -0,0 +1,99 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/util/buffer/mapped_file.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "trpc/util/buffer/noncontiguous_buffer.h"
+
+namespace trpc::testing {
+
+class MappedFileTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    for (int i = 0; content_.size() < 100000; ++i) {
+      content_ += std::to_string(i);
+    }
+    std::ofstream(kPath, std::ios::binary) << content_;
+  }
+
+  void TearDown() override { ::remove(kPath); }
+
+  static bool IsMapped() {
+    std::ifstream maps("/proc/self/maps");
+    std::stringstream ss;
+    ss << maps.rdbuf();
+    return ss.str().find(kPath) != std::string::npos;
+  }
+
+  static constexpr char kPath[] = "mapped_file_test.bin";
+  std::string content_;
+};
+
+TEST_F(MappedFileTest, Open) {
+  auto whole = MappedFile::Open(kPath);
+  ASSERT_TRUE(whole);
+  ASSERT_EQ(std::string(whole->data(), whole->size()), content_);
+
+  // Offset doesn't have to be aligned to page.
+  auto region = MappedFile::Open(kPath, 5000, 10000);
+  ASSERT_TRUE(region);
+  ASSERT_EQ(std::string(region->data(), region->size()), content_.substr(5000, 10000));
+
+  ASSERT_EQ(MappedFile::Open(kPath, content_.size())->size(), 0);
+  ASSERT_FALSE(MappedFile::Open(kPath, 5000, content_.size()));
+  ASSERT_FALSE(MappedFile::Open(kPath, content_.size() + 1));
+  ASSERT_FALSE(MappedFile::Open("not_exist.bin"));
+  ASSERT_FALSE(MappedFile::Open("."));
+}
+
+TEST_F(MappedFileTest, AppendToBuffer) {
+  NoncontiguousBuffer buffer = CreateBufferSlow("header");
+  buffer.Append(MappedFile::Open(kPath, 100, 50000));
+  buffer.Append(CreateBufferSlow("tail"));
+  ASSERT_EQ(buffer.ByteSize(), 6 + 50000 + 4);
+  ASSERT_EQ(FlattenSlow(buffer), "header" + content_.substr(100, 50000) + "tail");
+
+  // Blocks of the region are shared by the buffers cut from it.
+  buffer.Skip(10);
+  auto cut = buffer.Cut(20000);
+  ASSERT_EQ(FlattenSlow(cut), content_.substr(104, 20000));
+  ASSERT_EQ(FlattenSlow(buffer), content_.substr(20104, 30000 - 4) + "tail");
+
+  // An empty region is not appended.
+  NoncontiguousBuffer empty;
+  empty.Append(MappedFile::Open(kPath, content_.size()));
+  ASSERT_TRUE(empty.Empty());
+}
+
+TEST_F(MappedFileTest, UnmapWithLastReference) {
+  NoncontiguousBuffer copy;
+  {
+    NoncontiguousBuffer buffer;
+    buffer.Append(MappedFile::Open(kPath));
+    ASSERT_TRUE(IsMapped());
+    copy = buffer;
+  }
+  ASSERT_TRUE(IsMapped());
+  ASSERT_EQ(FlattenSlow(copy), content_);
+  copy.Clear();
+  ASSERT_FALSE(IsMapped());
+}
+
+}  // namespace trpc::testing
@@ -39,6 +39,12 @@ void Deallocate(MemBlock* block) {
 #endif
 }
 
+void FlushRemoteFrees() {
+#if defined(TRPC_SHARED_NOTHING_MEM_POOL)
+  shared_nothing::FlushRemoteFrees();
+#endif
+}
+
 const MemStatistics& GetMemStatistics() noexcept {
 #if defined(TRPC_DISABLED_MEM_POOL)
   return disabled::GetStatistics();
@@ -55,6 +55,10 @@ MemBlock* Allocate();
 /// @param block MemBlock pointer
 void Deallocate(MemBlock* block);
 
+/// @brief Return the memory blocks of other threads freed by the current thread to their owners at once.
+/// @note Only the shared-nothing memory pool batches such blocks, call it when the thread is going to be idle.
+void FlushRemoteFrees();
+
 /// @brief Getting the statistics of the memory pool for the current thread.
 /// @return Statistics
 const MemStatistics& GetMemStatistics() noexcept;
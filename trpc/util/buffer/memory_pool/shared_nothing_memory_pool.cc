@@ -31,6 +31,10 @@ static constexpr uint32_t kFreeListGoalNum = 24;
 static constexpr uint32_t kMaxFreeListNum = 18;
 // The redundancy size for adjusting the number of BlockChunk objects each time.
 static constexpr uint32_t kBlockChunkRedundant = 100;
+// The number of Block objects released to the same remote pool which are pushed at once.
+static constexpr uint32_t kRemoteFreeBatchSize = 8;
+// The number of remote pools a thread keeps batches for.
+static constexpr uint32_t kRemoteFreeBatchNum = 4;
 namespace {
 
 // The logical CPU ID generator.
@@ -68,12 +72,19 @@ bool DeleteToSystem(Block* block) {
 
 /// @brief The shared-nothing memory pool management class.
 struct SharedNothingMemPool {
+  // The registration of the pool of a thread, which is looked up by other threads returning blocks to it.
+  struct alignas(64) Entry {
+    std::atomic<SharedNothingMemPoolImp*> pool{nullptr};
+    // The number of threads which may be pushing blocks to `pool`, the pool waits for them before it is destroyed.
+    std::atomic<uint32_t> pushers{0};
+  };
+
   // Store pointers to shared-nothing memory pools for all threads, with the maximum number of CPUs indicating the
   // maximum number of allowed threads.
-  static SharedNothingMemPoolImp* all_cpus[kMaxCpus];
+  static Entry all_cpus[kMaxCpus];
 };
 
-SharedNothingMemPoolImp* SharedNothingMemPool::all_cpus[kMaxCpus];
+SharedNothingMemPool::Entry SharedNothingMemPool::all_cpus[kMaxCpus];
 
 BlockChunk& BlockChunkManager::GetBlockChunk(uint32_t index) {
   TRPC_ASSERT(index <= block_chunks_.size() && index > 0);
@@ -106,6 +117,15 @@ SharedNothingMemPoolImp::SharedNothingMemPoolImp() {
 }
 
 SharedNothingMemPoolImp::~SharedNothingMemPoolImp() {
+  // Blocks released by other threads from now on are dropped, see `RemoteFreeBatches::FlushBatch`. The threads which
+  // have already seen this pool are waited for, so none of them touches it after it is destroyed.
+  auto& entry = SharedNothingMemPool::all_cpus[cpu_id_];
+  SharedNothingMemPoolImp* self = this;
+  entry.pool.compare_exchange_strong(self, nullptr, std::memory_order_seq_cst);
+  while (entry.pushers.load(std::memory_order_seq_cst) != 0) {
+    std::this_thread::yield();
+  }
+
   // Recycle the memory blocks that cross threads.
   DrainCrossCpuFreelist();
 
@@ -192,7 +212,11 @@ bool SharedNothingMemPoolImp::NewBlockChunk() {
 }
 
 Block* SharedNothingMemPoolImp::Allocate() {
-  DrainCrossCpuFreelist();
+  if (TRPC_UNLIKELY(!free_block_list_.head)) {
+    // Reuse the blocks released by other threads first, they are drained in batch only when the local list runs out,
+    // which keeps the shared list off the fast path.
+    DrainCrossCpuFreelist();
+  }
 
   if (TRPC_UNLIKELY(!free_block_list_.head)) {
     // First, allocate `kFreeListGoalNum` targets from `block_chunk_manager_` to `free_blocks`.
@@ -285,19 +309,15 @@ void SharedNothingMemPoolImp::Deallocate(Block* block) {
   }
 }
 
-void SharedNothingMemPoolImp::DeleteCrossCpu(Block* block) {
-  if (DeleteToSystem(block)) {  // Check if it is allocated by the system.
-    return;
-  }
-
-  // For cross-thread deallocation, store the `block` in `xcpu_free_list_`.
+void SharedNothingMemPoolImp::PushCrossCpuFreelist(Block* head, Block* tail) {
+  // For cross-thread deallocation, store the blocks in `xcpu_free_list_`.
   auto& list = xcpu_free_list_;
   auto old = list.load(std::memory_order_relaxed);
   do {
-    block->next = old;
-  } while (!list.compare_exchange_weak(old, block, std::memory_order_release, std::memory_order_relaxed));
+    tail->next = old;
+  } while (!list.compare_exchange_weak(old, head, std::memory_order_release, std::memory_order_relaxed));
 
-  ++GetTlsStatistics().foreign_frees_num;
+  ++GetTlsStatistics().foreign_free_batches_num;
 }
 
 void SharedNothingMemPoolImp::DrainCrossCpuFreelist() {
@@ -321,13 +341,85 @@ void SharedNothingMemPoolImp::DrainCrossCpuFreelist() {
   }
 
   GetTlsStatistics().cross_cpu_frees_num += free_num;
+  ++GetTlsStatistics().cross_cpu_drains_num;
 }
 
+namespace {
+
+// Blocks released by current thread but allocated by others, which are pushed to the owners in batch, so releasing
+// blocks of another thread doesn't contend on its list for every block.
+class RemoteFreeBatches {
+ public:
+  ~RemoteFreeBatches() { Flush(); }
+
+  void Add(uint32_t owner, Block* block) {
+    Batch& batch = batches_[owner % kRemoteFreeBatchNum];
+    if (batch.owner != owner) {
+      FlushBatch(batch);
+      batch.owner = owner;
+    }
+
+    block->next = batch.head;
+    batch.head = block;
+    if (!batch.tail) {
+      batch.tail = block;
+    }
+    ++GetTlsStatistics().foreign_frees_num;
+
+    if (++batch.length >= kRemoteFreeBatchSize) {
+      FlushBatch(batch);
+    }
+  }
+
+  void Flush() {
+    for (auto& batch : batches_) {
+      FlushBatch(batch);
+    }
+  }
+
+ private:
+  struct Batch {
+    Block* head{nullptr};
+    Block* tail{nullptr};
+    uint32_t length{0};
+    uint32_t owner{kInvalidCpuId};
+  };
+
+  void FlushBatch(Batch& batch) {
+    if (batch.length == 0) {
+      return;
+    }
+
+    // The chunks of blocks are never freed if the owner has exited, so the blocks are simply dropped. The pusher is
+    // announced before the pool is looked up, so the owner either sees it and waits, or it sees the pool unregistered.
+    auto& entry = SharedNothingMemPool::all_cpus[batch.owner];
+    entry.pushers.fetch_add(1, std::memory_order_seq_cst);
+    SharedNothingMemPoolImp* pool = entry.pool.load(std::memory_order_seq_cst);
+    if (pool != nullptr) {
+      pool->PushCrossCpuFreelist(batch.head, batch.tail);
+    }
+    entry.pushers.fetch_sub(1, std::memory_order_release);
+    batch.head = nullptr;
+    batch.tail = nullptr;
+    batch.length = 0;
+  }
+
+ private:
+  Batch batches_[kRemoteFreeBatchNum];
+};
+
+RemoteFreeBatches& GetRemoteFreeBatches() {
+  thread_local RemoteFreeBatches batches;
+  return batches;
+}
+
+}  // namespace
+
 SharedNothingMemPoolImp* GetSharedNothingMemPool(uint32_t cpu_id) {
   thread_local std::unique_ptr<SharedNothingMemPoolImp> tls_pool = nullptr;
   if (!tls_pool) {
     tls_pool = std::make_unique<SharedNothingMemPoolImp>();
-    SharedNothingMemPool::all_cpus[cpu_id] = tls_pool.get();
+    SharedNothingMemPool::all_cpus[cpu_id].pool.store(tls_pool.get(), std::memory_order_release);
   }
 
   return tls_pool.get();
@@ -355,10 +447,17 @@ void Deallocate(detail::Block* block) {
     // When using this memory pool, it is necessary to ensure that it is only used in the framework thread, as using it
     // in business threads may cause the thread to exit. If the corresponding memory pool still has Block being used by
     // other threads when it is deallocated, it may cause a memory overflow.
-    detail::GetSharedNothingMemPool(cpu_id)->DeleteCrossCpu(block);
+    ++GetTlsStatistics().total_frees_num;
+    if (detail::DeleteToSystem(block)) {
+      return;
+    }
+    // Return the block to the thread allocating it, so the chunk it belongs to is managed by the same pool.
+    detail::GetRemoteFreeBatches().Add(cpu_id, block);
   }
 }
 
+void FlushRemoteFrees() { detail::GetRemoteFreeBatches().Flush(); }
+
 Statistics& GetTlsStatistics() noexcept {
   thread_local Statistics statistics;
   return statistics;
@@ -372,7 +471,9 @@ void PrintTlsStatistics() noexcept {
   TRPC_FMT_INFO("shared nothing mem pool, tid: {} allocs_from_system: {} ", tid, stat.allocs_from_system);
   TRPC_FMT_INFO("shared nothing mem pool, tid: {} frees_to_system: {} ", tid, stat.frees_to_system);
   TRPC_FMT_INFO("shared nothing mem pool, tid: {} cross_cpu_frees_num: {} ", tid, stat.cross_cpu_frees_num);
+  TRPC_FMT_INFO("shared nothing mem pool, tid: {} cross_cpu_drains_num: {} ", tid, stat.cross_cpu_drains_num);
   TRPC_FMT_INFO("shared nothing mem pool, tid: {} foreign_frees_num: {} ", tid, stat.foreign_frees_num);
+  TRPC_FMT_INFO("shared nothing mem pool, tid: {} foreign_free_batches_num: {} ", tid, stat.foreign_free_batches_num);
   TRPC_FMT_INFO("shared nothing mem pool, tid: {} block_chunks_alloc_num: {} ", tid, stat.block_chunks_alloc_num);
 }
 
@@ -117,9 +117,11 @@ class alignas(64) SharedNothingMemPoolImp {
   /// @param block The pointer to the Block object that needs to be released.
   void Deallocate(Block* block);
 
-  /// @brief Free the Block object to the idle list across threads.
-  /// @param block The pointer to the Block object that needs to be released.
-  void DeleteCrossCpu(Block* block);
+  /// @brief Push Block objects freed by other threads to the idle list across threads.
+  /// @param head The first Block of the list.
+  /// @param tail The last Block of the list.
+  /// @note Called by other threads.
+  void PushCrossCpuFreelist(Block* head, Block* tail);
 
  private:
   // Reclaim the elements in the cross-thread idle list `xcpu_free_list_` to the local thread idle list
@@ -155,7 +157,9 @@ struct alignas(64) Statistics {
   size_t allocs_from_system{0};      ///< Number of times the tls directly allocates Block objects from the system.
   size_t frees_to_system{0};         ///< Number of times the tls releases Block objects to the system.
   size_t cross_cpu_frees_num{0};     ///< The number of Block objects that are recycled across CPUs.
+  size_t cross_cpu_drains_num{0};    ///< The number of times the Block objects released across CPUs are recycled.
   size_t foreign_frees_num{0};       ///< The number of Block objects that are released across CPUs.
+  size_t foreign_free_batches_num{0};  ///< The number of batches of Block objects released across CPUs.
   size_t block_chunks_alloc_num{0};  ///< The number of times a chunk is allocated for a Block.
 };
 
@@ -169,6 +173,12 @@ detail::Block* Allocate();
 /// @private For internal use purpose only.
 void Deallocate(detail::Block* block);
 
+/// @brief Push the Block objects of other threads released by current thread to their owners at once.
+/// @note Block objects released across threads are returned to the owners in batches, call it when the thread is going
+///       to be idle for a while, so the owners can reuse them.
+/// @private For internal use purpose only.
+void FlushRemoteFrees();
+
 /// @brief Getting the statistics of the memory pool for the current thread.
 /// @return Statistics
 /// @private For internal use purpose only.
@@ -13,6 +13,7 @@
 
 #include "trpc/util/buffer/memory_pool/shared_nothing_memory_pool.h"
 
+#include <algorithm>
 #include <atomic>
 #include <condition_variable>
 #include <cstdlib>
@@ -178,5 +179,57 @@ TEST(SharedNothingTest, SharedNothingMultiThreadTest) {
 
   ASSERT_TRUE(true);
 }
+TEST(SharedNothingTest, CrossThreadDeallocateInBatch) {
+  std::vector<detail::Block*> items;
+  for (size_t i = 0; i < 9; ++i) {
+    items.push_back(Allocate());
+  }
+
+  std::thread t([&items] {
+    for (auto* item : items) {
+      Deallocate(item);
+    }
+    auto& stats = GetTlsStatistics();
+    ASSERT_EQ(stats.foreign_frees_num, 9);
+    // The last one is kept in batch until flushed.
+    ASSERT_EQ(stats.foreign_free_batches_num, 1);
+    FlushRemoteFrees();
+    ASSERT_EQ(stats.foreign_free_batches_num, 2);
+  });
+  t.join();
+
+  // Blocks released by other thread are returned to the owner, and drained once the local list runs out.
+  auto& stats = GetTlsStatistics();
+  auto drains_num = stats.cross_cpu_drains_num;
+  auto frees_num = stats.cross_cpu_frees_num;
+  std::vector<detail::Block*> reused;
+  while (stats.cross_cpu_drains_num == drains_num) {
+    reused.push_back(Allocate());
+  }
+  ASSERT_EQ(stats.cross_cpu_frees_num, frees_num + 9);
+  ASSERT_NE(std::find(items.begin(), items.end(), reused.back()), items.end());
+  for (auto* item : reused) {
+    Deallocate(item);
+  }
+}
+
+TEST(SharedNothingTest, DeallocateAfterOwnerExit) {
+  std::vector<detail::Block*> items;
+  std::thread owner([&items] {
+    for (size_t i = 0; i < 4; ++i) {
+      items.push_back(Allocate());
+    }
+  });
+  owner.join();
+
+  // The pool of the owner is gone, blocks returned to it are dropped instead of touching it.
+  for (auto* item : items) {
+    Deallocate(item);
+  }
+  auto batches_num = GetTlsStatistics().foreign_free_batches_num;
+  FlushRemoteFrees();
+  ASSERT_EQ(GetTlsStatistics().foreign_free_batches_num, batches_num);
+}
+
 }  // namespace testing
 }  // namespace trpc::memory_pool::shared_nothing
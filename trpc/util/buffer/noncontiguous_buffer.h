@@ -30,6 +30,7 @@
 
 #include "trpc/util/align.h"
 #include "trpc/util/buffer/contiguous_buffer.h"
+#include "trpc/util/buffer/mapped_file.h"
 #include "trpc/util/buffer/memory_pool/memory_pool.h"
 #include "trpc/util/check.h"
 #include "trpc/util/internal/singly_linked_list.h"
@@ -104,7 +105,8 @@ class BufferView {
 
 /// @brief Belongs to a middle layer object, mainly used by NoncontiguousBuffer. Each `BufferBlock` contains a
 ///        contiguous memory space, which can be a fixed-size memory block (`MemBlock`) allocated by the framework by
-///        default, or a user-managed custom contiguous address space.
+///        default, a user-managed custom contiguous address space, or a region of file mapped into memory
+///        (`MappedFile`, read only).
 /// @note When using objects instantiated from this class, the following points should be noted:
 /// 1、The type of memory address that can be processed is limited to either MemBlock or a contiguous memory block
 ///    passed in by the user. Mixing the two types is not allowed, which means that `data_` and `contiguous_buffer_`
@@ -123,10 +125,15 @@ struct BufferBlock {
     size_ = std::exchange(b.size_, 0);
     data_ = std::move(b.data_);
     contiguous_buffer_ = std::move(b.contiguous_buffer_);
+    mapped_file_ = std::move(b.mapped_file_);
   }
 
   BufferBlock(const BufferBlock& b)
-      : start_(b.start_), size_(b.size_), data_(b.data_), contiguous_buffer_(b.contiguous_buffer_) {}
+      : start_(b.start_),
+        size_(b.size_),
+        data_(b.data_),
+        contiguous_buffer_(b.contiguous_buffer_),
+        mapped_file_(b.mapped_file_) {}
 
   BufferBlock& operator=(BufferBlock&& b) {
     if (TRPC_UNLIKELY(&b == this)) {
@@ -136,6 +143,7 @@ struct BufferBlock {
     size_ = std::exchange(b.size_, 0);
     data_ = std::move(b.data_);
     contiguous_buffer_ = std::move(b.contiguous_buffer_);
+    mapped_file_ = std::move(b.mapped_file_);
     return *this;
   }
 
@@ -144,6 +152,7 @@ struct BufferBlock {
     size_ = b.size_;
     data_ = b.data_;
     contiguous_buffer_ = b.contiguous_buffer_;
+    mapped_file_ = b.mapped_file_;
     return *this;
   }
 
@@ -158,6 +167,16 @@ struct BufferBlock {
     data_ = std::move(data);
   }
 
+  /// @brief Refer to a region of mapped file, the file is unmapped once no block refers to it.
+  /// @param mapped_file The mapped file, the block sees all of it.
+  /// @note The memory is read only, don't write it through `data()`.
+  void Reset(RefPtr<MappedFile> mapped_file) {
+    TRPC_DCHECK(!data_ && !contiguous_buffer_, "mapped file cannot be mixed with other memory in a block.");
+    start_ = 0;
+    size_ = mapped_file->size();
+    mapped_file_ = std::move(mapped_file);
+  }
+
   /// @brief Change the portion of buffer block we're seeing.
   /// @param bytes Number of bytes to skip.
   void Skip(std::size_t bytes) {
@@ -185,6 +204,10 @@ struct BufferBlock {
       return const_cast<char*>(contiguous_buffer_->GetReadPtr()) + start_;
     }
 
+    if (TRPC_UNLIKELY(mapped_file_)) {
+      return const_cast<char*>(mapped_file_->data()) + start_;
+    }
+
     return nullptr;
   }
 
@@ -201,6 +224,9 @@ struct BufferBlock {
     if (TRPC_UNLIKELY(contiguous_buffer_)) {
       contiguous_buffer_.Reset();
     }
+    if (TRPC_UNLIKELY(mapped_file_)) {
+      mapped_file_.Reset();
+    }
   }
 
   /// @brief Fully managed contiguous memory, where the object is responsible for releasing the managed memory.
@@ -240,6 +266,7 @@ struct BufferBlock {
   std::size_t start_{0}, size_{0};
   RefPtr<memory_pool::MemBlock> data_{nullptr};          // The framework provides a fixed-size contiguous memory block.
   RefPtr<ContiguousBuffer> contiguous_buffer_{nullptr};  // The contiguous space address passed in by the business.
+  RefPtr<MappedFile> mapped_file_{nullptr};              // The region of file mapped into memory.
 };
 
 /// @brief A helper class used to create `BufferBlock`.
@@ -450,6 +477,22 @@ class NoncontiguousBuffer {
   /// @brief Managed constant pointers are not supported at the moment.
   void Append(const char* ptr, std::size_t size) { TRPC_ASSERT(false && "not allowing managed constant pointers."); }
 
+  /// @brief Add a region of mapped file to the internal linked list without copying it, e.g. a slice of file as the
+  ///        attachment of rpc. It's written to the network directly from the mapping, so no block of memory pool is
+  ///        used for it.
+  /// @param mapped_file The mapped file, see `MappedFile::Open`.
+  /// @note Unlike contiguous buffer, it can be mixed with other blocks.
+  void Append(RefPtr<MappedFile> mapped_file) {
+    TRPC_DCHECK(is_contiguous_ == false, "not supported in contigous mode");
+    if (TRPC_UNLIKELY(!mapped_file || mapped_file->size() == 0)) {
+      return;
+    }
+    auto block = object_pool::MakeLwUnique<BufferBlock>();
+    block->Reset(std::move(mapped_file));
+    byte_size_ += block->size();
+    buffers_.push_back(block.Leak());
+  }
+
   /// @brief Manage the contiguous memory block specified by the user.
   /// @param contiguous_buff The object representing the managed contiguous memory block.
   /// @note Once the contiguous memory block is managed, the user should avoid directly manipulating `contiguous_buff`
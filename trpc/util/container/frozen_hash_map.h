@@ -0,0 +1,210 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "trpc/util/log/logging.h"
+
+namespace trpc::container {
+
+namespace detail {
+
+/// @private
+inline uint64_t MixHash(uint64_t x) {
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdULL;
+  x ^= x >> 33;
+  x *= 0xc4ceb9fe1a85ec53ULL;
+  x ^= x >> 33;
+  return x;
+}
+
+/// @private
+inline uint64_t HashKey(std::string_view key) {
+  // FNV-1a, finalized by MixHash as low bits of FNV are weak.
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (char c : key) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 0x100000001b3ULL;
+  }
+  return MixHash(hash);
+}
+
+/// @private
+inline uint64_t HashKey(uint64_t key) { return MixHash(key); }
+
+}  // namespace detail
+
+/// @brief Read-only hash map built once by perfect hashing (hash and displace), every key is located by exactly one
+///        probe, and a lookup costs a single hash of the key plus one key comparison.
+///        It suits tables that are filled at startup and only read afterwards, e.g. method tables of services.
+/// @note  Key is std::string (looked up by std::string_view) or an integral type. Building is O(n) expected, rebuild
+///        the whole map if items change.
+template <typename Key, typename Value>
+class FrozenHashMap {
+  static_assert(std::is_same_v<Key, std::string> || std::is_integral_v<Key>, "Unsupported key type");
+
+ public:
+  using LookupKey = std::conditional_t<std::is_same_v<Key, std::string>, std::string_view, Key>;
+
+  FrozenHashMap() = default;
+
+  /// @brief Build from items, keys must be unique.
+  explicit FrozenHashMap(std::vector<std::pair<Key, Value>> items) { Build(std::move(items)); }
+
+  /// @brief Rebuild from items, keys must be unique.
+  void Build(std::vector<std::pair<Key, Value>> items) {
+    slots_.clear();
+    displacements_.clear();
+    size_ = items.size();
+    if (items.empty()) {
+      return;
+    }
+
+    std::vector<uint64_t> hashes;
+    hashes.reserve(items.size());
+    for (const auto& item : items) {
+      hashes.push_back(detail::HashKey(static_cast<LookupKey>(item.first)));
+    }
+
+    // Load factor of slots is kept in (0.5, 1], and about 2 keys fall in each bucket on average.
+    std::size_t slot_count = RoundUp(items.size());
+    while (!TryPlace(items, hashes, slot_count)) {
+      slot_count *= 2;
+      // Only duplicated keys can fail so many times.
+      TRPC_ASSERT(slot_count <= (items.size() << 8) && "Keys of FrozenHashMap must be unique");
+    }
+  }
+
+  /// @brief Find value by key.
+  /// @return nullptr if not found.
+  const Value* Find(LookupKey key) const {
+    if (size_ == 0) {
+      return nullptr;
+    }
+    uint64_t hash = detail::HashKey(key);
+    uint32_t displacement = displacements_[hash & (displacements_.size() - 1)];
+    const auto& slot = slots_[SlotIndex(hash, displacement, slots_.size())];
+    if (slot && static_cast<LookupKey>(slot->first) == key) {
+      return &slot->second;
+    }
+    return nullptr;
+  }
+
+  /// @brief Visit all items in unspecified order, func is invoked by (key, value).
+  template <typename F>
+  void ForEach(F&& func) const {
+    for (const auto& slot : slots_) {
+      if (slot) {
+        func(slot->first, slot->second);
+      }
+    }
+  }
+
+  std::size_t Size() const { return size_; }
+
+  bool Empty() const { return size_ == 0; }
+
+ private:
+  static std::size_t RoundUp(std::size_t n) {
+    std::size_t ret = 1;
+    while (ret < n) {
+      ret <<= 1;
+    }
+    return ret;
+  }
+
+  static std::size_t SlotIndex(uint64_t hash, uint32_t displacement, std::size_t slot_count) {
+    // Bucket is selected by low bits, so the slot is derived from the high bits mixed with displacement.
+    return detail::MixHash((hash >> 32) ^ (static_cast<uint64_t>(displacement) * 0x9e3779b97f4a7c15ULL)) &
+           (slot_count - 1);
+  }
+
+  bool TryPlace(std::vector<std::pair<Key, Value>>& items, const std::vector<uint64_t>& hashes,
+                std::size_t slot_count) {
+    constexpr uint32_t kMaxDisplacement = 1u << 16;
+
+    std::size_t bucket_count = std::max<std::size_t>(1, slot_count / 2);
+    std::vector<std::vector<std::size_t>> buckets(bucket_count);
+    for (std::size_t i = 0; i < hashes.size(); ++i) {
+      buckets[hashes[i] & (bucket_count - 1)].push_back(i);
+    }
+
+    // Place the largest buckets first, while there are still many free slots.
+    std::vector<std::size_t> order(bucket_count);
+    for (std::size_t i = 0; i < bucket_count; ++i) {
+      order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(),
+                     [&buckets](std::size_t l, std::size_t r) { return buckets[l].size() > buckets[r].size(); });
+
+    std::vector<uint32_t> displacements(bucket_count, 0);
+    std::vector<std::optional<std::size_t>> placed(slot_count);
+    std::vector<std::size_t> candidate;
+    for (std::size_t bucket : order) {
+      const auto& keys = buckets[bucket];
+      if (keys.empty()) {
+        break;
+      }
+      bool found = false;
+      for (uint32_t displacement = 0; displacement < kMaxDisplacement && !found; ++displacement) {
+        candidate.clear();
+        found = true;
+        for (std::size_t key : keys) {
+          std::size_t index = SlotIndex(hashes[key], displacement, slot_count);
+          if (placed[index] || std::find(candidate.begin(), candidate.end(), index) != candidate.end()) {
+            found = false;
+            break;
+          }
+          candidate.push_back(index);
+        }
+        if (found) {
+          displacements[bucket] = displacement;
+          for (std::size_t i = 0; i < keys.size(); ++i) {
+            placed[candidate[i]] = keys[i];
+          }
+        }
+      }
+      if (!found) {
+        return false;
+      }
+    }
+
+    slots_.clear();
+    slots_.resize(slot_count);
+    for (std::size_t i = 0; i < slot_count; ++i) {
+      if (placed[i]) {
+        slots_[i].emplace(std::move(items[*placed[i]]));
+      }
+    }
+    displacements_ = std::move(displacements);
+    return true;
+  }
+
+ private:
+  std::vector<std::optional<std::pair<Key, Value>>> slots_;
+  std::vector<uint32_t> displacements_;
+  std::size_t size_ = 0;
+};
+
+}  // namespace trpc::container
@@ -0,0 +1,79 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/util/container/frozen_hash_map.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace trpc::container::testing {
+
+TEST(FrozenHashMapTest, Empty) {
+  FrozenHashMap<std::string, int> map;
+  ASSERT_TRUE(map.Empty());
+  ASSERT_EQ(map.Find("a"), nullptr);
+
+  map.Build({});
+  ASSERT_EQ(map.Find(""), nullptr);
+}
+
+TEST(FrozenHashMapTest, StringKey) {
+  std::vector<std::pair<std::string, int>> items;
+  for (int i = 0; i < 1000; ++i) {
+    items.emplace_back("/trpc.test.helloworld.Greeter/SayHello" + std::to_string(i), i);
+  }
+  FrozenHashMap<std::string, int> map(items);
+  ASSERT_EQ(map.Size(), 1000);
+
+  for (const auto& [key, value] : items) {
+    const int* found = map.Find(key);
+    ASSERT_NE(found, nullptr);
+    ASSERT_EQ(*found, value);
+  }
+  ASSERT_EQ(map.Find("/trpc.test.helloworld.Greeter/SayHello"), nullptr);
+  ASSERT_EQ(map.Find("/trpc.test.helloworld.Greeter/SayHello1000"), nullptr);
+
+  int count = 0;
+  map.ForEach([&count](const std::string& key, int value) {
+    ASSERT_EQ(key, "/trpc.test.helloworld.Greeter/SayHello" + std::to_string(value));
+    ++count;
+  });
+  ASSERT_EQ(count, 1000);
+}
+
+TEST(FrozenHashMapTest, IntegerKey) {
+  for (uint32_t n = 1; n <= 64; ++n) {
+    std::vector<std::pair<uint32_t, uint32_t>> items;
+    for (uint32_t i = 0; i < n; ++i) {
+      items.emplace_back(i * 7919, i);
+    }
+    FrozenHashMap<uint32_t, uint32_t> map(items);
+    for (uint32_t i = 0; i < n; ++i) {
+      ASSERT_EQ(*map.Find(i * 7919), i);
+    }
+    ASSERT_EQ(map.Find(1), nullptr);
+  }
+}
+
+TEST(FrozenHashMapTest, Rebuild) {
+  FrozenHashMap<std::string, int> map({{"a", 1}});
+  map.Build({{"b", 2}, {"c", 3}});
+  ASSERT_EQ(map.Find("a"), nullptr);
+  ASSERT_EQ(*map.Find("b"), 2);
+  ASSERT_EQ(*map.Find("c"), 3);
+}
+
+}  // namespace trpc::container::testing
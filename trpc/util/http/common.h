@@ -74,6 +74,11 @@ constexpr char kEndOfChunkTransferingMarker[] = "0\r\n";
 constexpr char kTrailer[] = "Trailer";
 constexpr int kTrailerLen{7};
 
+constexpr char kHeaderRange[] = "Range";
+constexpr char kHeaderContentRange[] = "Content-Range";
+constexpr char kHeaderAcceptRanges[] = "Accept-Ranges";
+constexpr char kRangeUnitBytes[] = "bytes";
+
 /// @brief Converts 'Content-Type' to inner compression type.
 /// @private For internal use purpose only.
 constexpr compressor::CompressType StringToCompressType(std::string_view type) {
@@ -0,0 +1,141 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/util/http/file_response.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <charconv>
+#include <memory>
+#include <optional>
+
+#include "trpc/runtime/iomodel/reactor/common/file_region.h"
+#include "trpc/util/http/common.h"
+#include "trpc/util/http/status.h"
+#include "trpc/util/http/util.h"
+#include "trpc/util/string/string_helper.h"
+
+namespace trpc::http {
+
+namespace {
+
+std::optional<std::size_t> ParsePosition(std::string_view s) {
+  std::size_t value = 0;
+  auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), value);
+  if (s.empty() || ec != std::errc() || ptr != s.data() + s.size()) {
+    return std::nullopt;
+  }
+  return value;
+}
+
+std::string GuessMimeType(const std::string& path) {
+  auto slash = path.rfind('/');
+  auto dot = path.rfind('.');
+  if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+    return ExtensionToType("bin");
+  }
+  return ExtensionToType(path.substr(dot + 1));
+}
+
+}  // namespace
+
+RangeStatus ParseRange(std::string_view value, std::size_t file_size, ByteRange* range) {
+  value = Trim(value);
+  constexpr std::string_view kUnit = kRangeUnitBytes;
+  if (value.size() <= kUnit.size() || !StringStartsWithIgnoreCase(value, kUnit) || value[kUnit.size()] != '=') {
+    return RangeStatus::kWhole;
+  }
+  std::string_view spec = Trim(value.substr(kUnit.size() + 1));
+  auto dash = spec.find('-');
+  if (spec.find(',') != std::string_view::npos || dash == std::string_view::npos) {
+    return RangeStatus::kWhole;
+  }
+
+  auto first = Trim(spec.substr(0, dash));
+  auto last = Trim(spec.substr(dash + 1));
+  if (first.empty()) {
+    // Suffix range, "-500" is the last 500 bytes.
+    auto suffix = ParsePosition(last);
+    if (!suffix) {
+      return RangeStatus::kWhole;
+    }
+    if (*suffix == 0 || file_size == 0) {
+      return RangeStatus::kUnsatisfiable;
+    }
+    range->size = std::min(*suffix, file_size);
+    range->begin = file_size - range->size;
+    return RangeStatus::kPartial;
+  }
+
+  auto begin = ParsePosition(first);
+  std::optional<std::size_t> end = last.empty() ? std::optional<std::size_t>(file_size - 1) : ParsePosition(last);
+  if (!begin || !end || (!last.empty() && *end < *begin)) {
+    return RangeStatus::kWhole;
+  }
+  if (*begin >= file_size) {
+    return RangeStatus::kUnsatisfiable;
+  }
+  range->begin = *begin;
+  range->size = std::min(*end, file_size - 1) - *begin + 1;
+  return RangeStatus::kPartial;
+}
+
+bool ReplyFile(const Request& req, const std::string& path, Response* rsp) {
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat st;
+  if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+    ::close(fd);
+    return false;
+  }
+  auto file_size = static_cast<std::size_t>(st.st_size);
+
+  ByteRange range{0, file_size};
+  RangeStatus status = RangeStatus::kWhole;
+  if (const auto& value = req.GetHeader(kHeaderRange); !value.empty()) {
+    status = ParseRange(value, file_size, &range);
+  }
+
+  rsp->SetHeader(kHeaderAcceptRanges, kRangeUnitBytes);
+  if (status == RangeStatus::kUnsatisfiable) {
+    ::close(fd);
+    rsp->SetStatus(ResponseStatus::kRequestedRangeNotSatisfiable);
+    rsp->SetHeader(kHeaderContentRange, Format("{} */{}", kRangeUnitBytes, file_size));
+    rsp->SetNonContiguousBufferContent(NoncontiguousBuffer{});
+    return true;
+  }
+  if (status == RangeStatus::kPartial) {
+    rsp->SetStatus(ResponseStatus::kPartialContent);
+    rsp->SetHeader(kHeaderContentRange,
+                   Format("{} {}-{}/{}", kRangeUnitBytes, range.begin, range.begin + range.size - 1, file_size));
+  } else {
+    rsp->SetStatus(ResponseStatus::kOk);
+  }
+  rsp->SetMimeType(GuessMimeType(path));
+
+  // An empty region is never sent, so a zero-size file is replied as empty content.
+  if (range.size == 0) {
+    ::close(fd);
+    rsp->SetNonContiguousBufferContent(NoncontiguousBuffer{});
+    rsp->SetFileContent(nullptr);
+  } else {
+    rsp->SetFileContent(std::make_shared<FileRegion>(fd, range.begin, range.size));
+  }
+  return true;
+}
+
+}  // namespace trpc::http
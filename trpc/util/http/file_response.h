@@ -0,0 +1,54 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "trpc/util/http/request.h"
+#include "trpc/util/http/response.h"
+
+namespace trpc::http {
+
+/// @brief Byte range of a file, [begin, begin + size).
+struct ByteRange {
+  std::size_t begin{0};
+  std::size_t size{0};
+};
+
+/// @brief Result of parsing "Range" header.
+enum class RangeStatus {
+  // No range or the range is ignored (e.g. invalid or multiple ranges), the whole file is sent.
+  kWhole,
+  // A single satisfiable range, the file is sent partially with status 206.
+  kPartial,
+  // None of the range is in the file, status 416 is replied.
+  kUnsatisfiable,
+};
+
+/// @brief Parses the value of "Range" header (RFC 7233) against a file of `file_size` bytes, e.g. "bytes=0-499",
+///        "bytes=500-" and "bytes=-500".
+/// @param range is set if `kPartial` is returned.
+/// @note  Multiple ranges are not supported, they are ignored as servers are allowed to.
+RangeStatus ParseRange(std::string_view value, std::size_t file_size, ByteRange* range);
+
+/// @brief Replies a regular file as the response content, it's sent by sendfile(2) by server transport.
+///        "Range" header of the request is honored, the response is 206 (with "Content-Range") for a satisfiable
+///        range, 416 for an unsatisfiable one, otherwise it's 200 with the whole file.
+///        "Content-Type" is guessed by the extension of `path` if it's not set yet.
+/// @return false if the file can't be opened (or it's not a regular file), response is untouched in this case.
+bool ReplyFile(const Request& req, const std::string& path, Response* rsp);
+
+}  // namespace trpc::http
@@ -0,0 +1,114 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+#include "trpc/util/http/file_response.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace trpc::testing {
+
+using http::ByteRange;
+using http::RangeStatus;
+
+TEST(FileResponseTest, ParseRange) {
+  ByteRange range;
+  ASSERT_EQ(http::ParseRange("bytes=0-499", 1000, &range), RangeStatus::kPartial);
+  ASSERT_EQ(range.begin, 0);
+  ASSERT_EQ(range.size, 500);
+
+  ASSERT_EQ(http::ParseRange("bytes=500-", 1000, &range), RangeStatus::kPartial);
+  ASSERT_EQ(range.begin, 500);
+  ASSERT_EQ(range.size, 500);
+
+  ASSERT_EQ(http::ParseRange("bytes=-100", 1000, &range), RangeStatus::kPartial);
+  ASSERT_EQ(range.begin, 900);
+  ASSERT_EQ(range.size, 100);
+
+  // Ranges are clamped by the size of file.
+  ASSERT_EQ(http::ParseRange("Bytes=900-2000", 1000, &range), RangeStatus::kPartial);
+  ASSERT_EQ(range.begin, 900);
+  ASSERT_EQ(range.size, 100);
+  ASSERT_EQ(http::ParseRange("bytes=-2000", 1000, &range), RangeStatus::kPartial);
+  ASSERT_EQ(range.begin, 0);
+  ASSERT_EQ(range.size, 1000);
+
+  ASSERT_EQ(http::ParseRange("bytes=1000-", 1000, &range), RangeStatus::kUnsatisfiable);
+  ASSERT_EQ(http::ParseRange("bytes=-0", 1000, &range), RangeStatus::kUnsatisfiable);
+  ASSERT_EQ(http::ParseRange("bytes=0-", 0, &range), RangeStatus::kUnsatisfiable);
+
+  ASSERT_EQ(http::ParseRange("bytes=0-1,5-6", 1000, &range), RangeStatus::kWhole);
+  ASSERT_EQ(http::ParseRange("bytes=5-1", 1000, &range), RangeStatus::kWhole);
+  ASSERT_EQ(http::ParseRange("bytes=a-1", 1000, &range), RangeStatus::kWhole);
+  ASSERT_EQ(http::ParseRange("items=0-1", 1000, &range), RangeStatus::kWhole);
+  ASSERT_EQ(http::ParseRange("bytes=", 1000, &range), RangeStatus::kWhole);
+}
+
+class ReplyFileTest : public ::testing::Test {
+ protected:
+  void SetUp() override { std::ofstream(kPath, std::ios::binary) << std::string(1000, 'a'); }
+
+  void TearDown() override { ::remove(kPath); }
+
+  static constexpr char kPath[] = "file_response_test.txt";
+};
+
+TEST_F(ReplyFileTest, Whole) {
+  http::Request req;
+  http::Response rsp;
+  ASSERT_TRUE(http::ReplyFile(req, kPath, &rsp));
+  ASSERT_EQ(rsp.GetStatus(), http::ResponseStatus::kOk);
+  ASSERT_EQ(rsp.GetHeader("Accept-Ranges"), "bytes");
+  ASSERT_EQ(rsp.GetHeader("Content-Type"), "text/plain");
+  ASSERT_EQ(rsp.ContentLength(), 1000);
+  ASSERT_EQ(rsp.GetFileContent()->GetOffset(), 0);
+
+  // Content of file is sent by transport, only the headers are serialized.
+  std::string serialized = rsp.SerializeToString();
+  ASSERT_NE(serialized.find("Content-Length: 1000\r\n"), std::string::npos);
+  ASSERT_TRUE(serialized.size() > 4 && serialized.substr(serialized.size() - 4) == "\r\n\r\n");
+}
+
+TEST_F(ReplyFileTest, Partial) {
+  http::Request req;
+  req.SetHeader("Range", "bytes=100-199");
+  http::Response rsp;
+  ASSERT_TRUE(http::ReplyFile(req, kPath, &rsp));
+  ASSERT_EQ(rsp.GetStatus(), http::ResponseStatus::kPartialContent);
+  ASSERT_EQ(rsp.GetHeader("Content-Range"), "bytes 100-199/1000");
+  ASSERT_EQ(rsp.ContentLength(), 100);
+  ASSERT_EQ(rsp.GetFileContent()->GetOffset(), 100);
+}
+
+TEST_F(ReplyFileTest, Unsatisfiable) {
+  http::Request req;
+  req.SetHeader("Range", "bytes=1000-");
+  http::Response rsp;
+  ASSERT_TRUE(http::ReplyFile(req, kPath, &rsp));
+  ASSERT_EQ(rsp.GetStatus(), http::ResponseStatus::kRequestedRangeNotSatisfiable);
+  ASSERT_EQ(rsp.GetHeader("Content-Range"), "bytes */1000");
+  ASSERT_EQ(rsp.ContentLength(), 0);
+  ASSERT_EQ(rsp.GetFileContent(), nullptr);
+}
+
+TEST_F(ReplyFileTest, NotFound) {
+  http::Request req;
+  http::Response rsp;
+  ASSERT_FALSE(http::ReplyFile(req, "not_exist.txt", &rsp));
+  ASSERT_FALSE(http::ReplyFile(req, ".", &rsp));
+}
+
+}  // namespace trpc::testing
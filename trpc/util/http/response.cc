@@ -113,7 +113,7 @@ void Response::SerializeHeaderToString(NoncontiguousBufferBuilder& builder) cons
 
 std::string Response::SerializeToString() const {
   std::string ss = SerializeHeaderToString();
-  if (!header_only_) {
+  if (!header_only_ && !file_content_) {
     ss.append(content_provider_.SerializeToString());
   }
   return ss;
@@ -152,7 +152,8 @@ bool Response::SerializeToStringImpl(T&& self, NoncontiguousBuffer& buff) {
   NoncontiguousBufferBuilder builder;
   self.SerializeHeaderToString(builder);
   buff = builder.DestructiveGet();
-  if (!self.header_only_) {
+  // Content of file is not serialized, it's sent by transport after the headers.
+  if (!self.header_only_ && !self.file_content_) {
     std::forward<T>(self).content_provider_.SerializeToString(buff);
   }
 
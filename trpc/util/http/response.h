@@ -24,6 +24,7 @@
 #include <sstream>
 #include <string>
 
+#include "trpc/runtime/iomodel/reactor/common/file_region.h"
 #include "trpc/stream/http/http_stream.h"
 #include "trpc/util/buffer/noncontiguous_buffer.h"
 #include "trpc/util/http/common.h"
@@ -90,7 +91,9 @@ class Response : public Header {
   }
 
   /// @brief Gets the content length.
-  std::size_t ContentLength() const { return content_provider_.ContentLength(); }
+  std::size_t ContentLength() const {
+    return file_content_ ? file_content_->GetSize() : content_provider_.ContentLength();
+  }
 
   /// @brief Sets the content length.
   void SetContentLength(std::optional<size_t> content_length) { content_provider_.SetContentLength(content_length); }
@@ -115,6 +118,15 @@ class Response : public Header {
     content_provider_.SetNonContiguousBufferContent(std::move(content));
   }
 
+  /// @brief Sets a region of file as the response content, it's sent after the headers by sendfile(2) without copying
+  ///        into user space, and it takes the place of the content set before.
+  /// @note  Only HTTP/1.x server transport supports it, content of response is read from the file over TLS.
+  ///        See `ReplyFile` for serving files with range requests.
+  void SetFileContent(FileRegionPtr file_content) { file_content_ = std::move(file_content); }
+
+  /// @brief Gets the file set as the response content.
+  const FileRegionPtr& GetFileContent() const { return file_content_; }
+
   /// @brief Gets the status line.
   /// @private For internal use purpose only.
   const std::string& GetResponseLine() const { return response_line_; }
@@ -229,6 +241,8 @@ class Response : public Header {
   bool header_only_{false};
   bool connection_reusable_{false};
   ContentProvider content_provider_;
+  // Response content sent by sendfile, it takes the place of `content_provider_` if it's set.
+  FileRegionPtr file_content_;
   TrailerPairs trailers_;
 
 };
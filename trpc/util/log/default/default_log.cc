@@ -134,6 +134,8 @@ std::pair<Log::Level, bool> DefaultLog::SetLevel(const char* instance_name, Leve
   if (!strcmp(instance_name, kTrpcLogCacheStringDefault)) {
     trpc_logger_instance_.config.min_level = static_cast<unsigned int>(level);
   }
+  // Drops the cached decisions of the logging macros, so that the new level takes effect immediately.
+  LogCallSite::InvalidateAll();
   return std::make_pair(old, true);
 }
 
@@ -170,6 +172,7 @@ int DefaultLog::Init() {
     }
   }
   initted_ = true;
+  LogCallSite::InvalidateAll();
   return 0;
 }
 
@@ -215,6 +218,7 @@ LoggingPtr& DefaultLog::GetRawSink(const char* raw_sink_name, const char* logger
 
 void DefaultLog::RegisterInstance(const char* instance_name, DefaultLog::Logger logger) {
   instances_[instance_name] = std::move(logger);
+  LogCallSite::InvalidateAll();
 }
 
 DefaultLog::Logger* DefaultLog::GetLoggerInstance(const std::string& instance_name) {
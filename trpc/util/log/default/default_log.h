@@ -122,6 +122,7 @@ class DefaultLog : public Log {
     if (!strcmp(logger_name, kTrpcLogCacheStringDefault)) {
       initted_trpc_logger_instance_ = true;
       trpc_logger_instance_ = instance;
+      LogCallSite::InvalidateAll();
     }
     return true;
   }
@@ -14,6 +14,8 @@
 #pragma once
 
 #include <any>
+#include <atomic>
+#include <cstdint>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -177,6 +179,101 @@ class Log : public RefCounted<Log> {
 };
 using LogPtr = RefPtr<Log>;
 
+/// @brief Per-callsite cache of the "should log" decision, used by the logging macros so that a disabled log statement
+///        costs a couple of relaxed loads instead of a virtual call plus an instance lookup by name.
+/// @note  What is cached is the minimum level enabled for the instance of the callsite, so callsites whose level is a
+///        runtime variable are decided correctly on every call. Levels are assumed to be thresholds, i.e. if a level is
+///        enabled for an instance, so are all the levels above it.
+///        Every callsite is a constant-initialized function-local static, linked into a global list when it resolves
+///        its minimum level for the first time. The cached levels are dropped by `InvalidateAll()`, which is called
+///        whenever the log plugin is registered/reset or the level of an instance is changed at runtime.
+/// @private For internal use purpose only.
+class LogCallSite {
+ public:
+  constexpr LogCallSite() = default;
+
+  /// @brief Returns true if logging at `level` is known to be disabled for `instance_name`.
+  bool IsDisabled(const char* instance_name, int level) const {
+    uint8_t state = state_.load(std::memory_order_relaxed);
+    return state >= kResolved && level < state - kResolved && name_.load(std::memory_order_relaxed) == instance_name;
+  }
+
+  /// @brief Determine whether the log should be output, reusing the cached minimum level if there is a valid one.
+  /// @param should_log Asks the log plugin whether a given `Log::Level` is enabled for `instance_name`.
+  template <typename ShouldLogFunc>
+  bool ShouldLog(const char* instance_name, int level, ShouldLogFunc&& should_log) {
+    uint8_t state = state_.load(std::memory_order_acquire);
+    if (state >= kResolved && name_.load(std::memory_order_relaxed) == instance_name) {
+      return level >= state - kResolved;
+    }
+    if (state == kDynamic) {
+      return should_log(static_cast<Log::Level>(level));
+    }
+
+    const char* expected_name = nullptr;
+    if (!name_.compare_exchange_strong(expected_name, instance_name) && expected_name != instance_name) {
+      // The instance name of this callsite changes at runtime, the decision can not be cached.
+      state_.store(kDynamic, std::memory_order_release);
+      return should_log(static_cast<Log::Level>(level));
+    }
+
+    uint64_t generation = Generation().load();
+    int min_level = Log::trace;
+    while (min_level <= Log::critical && !should_log(static_cast<Log::Level>(min_level))) {
+      ++min_level;
+    }
+
+    uint8_t expected_state = kUnknown;
+    uint8_t resolved_state = static_cast<uint8_t>(kResolved + min_level);
+    if (state_.compare_exchange_strong(expected_state, resolved_state)) {
+      Link();
+      // The level may be changed while resolving, drop the possibly stale minimum level in that case.
+      if (generation != Generation().load()) {
+        state_.compare_exchange_strong(resolved_state, kUnknown);
+      }
+    }
+    return level >= min_level;
+  }
+
+  /// @brief Drop the cached levels of all callsites, they will be resolved again on their next execution.
+  static void InvalidateAll() {
+    Generation().fetch_add(1);
+    for (LogCallSite* site = Head().load(); site != nullptr; site = site->next_) {
+      uint8_t state = site->state_.load(std::memory_order_relaxed);
+      while (state >= kResolved && !site->state_.compare_exchange_weak(state, kUnknown)) {
+      }
+    }
+  }
+
+ private:
+  // States at or above `kResolved` hold `kResolved + minimum enabled level`, where `Log::critical + 1` means that no
+  // level is enabled.
+  enum State : uint8_t { kUnknown = 0, kDynamic = 1, kResolved = 2 };
+
+  static std::atomic<LogCallSite*>& Head() {
+    static std::atomic<LogCallSite*> head{nullptr};
+    return head;
+  }
+
+  static std::atomic<uint64_t>& Generation() {
+    static std::atomic<uint64_t> generation{0};
+    return generation;
+  }
+
+  void Link() {
+    if (linked_.exchange(true, std::memory_order_relaxed)) return;
+    next_ = Head().load();
+    while (!Head().compare_exchange_weak(next_, this)) {
+    }
+  }
+
+ private:
+  std::atomic<uint8_t> state_{kUnknown};
+  std::atomic<bool> linked_{false};
+  std::atomic<const char*> name_{nullptr};
+  LogCallSite* next_{nullptr};
+};
+
 /// @brief Logging plugin factories: Only the "default" log plugins provided by the framework are allowed to register,
 ///        also designed as factories to unify the design style of all plugins in the framework.
 class LogFactory {
@@ -198,13 +295,19 @@ class LogFactory {
 
   /// @brief Registering plugin instances
   /// @param log Plugin instance pointer
-  void Register(const LogPtr& log) { log_ = log; }
+  void Register(const LogPtr& log) {
+    log_ = log;
+    LogCallSite::InvalidateAll();
+  }
 
   /// @brief Get the log plugin instance
   const LogPtr& Get() const { return log_; }
 
   /// @brief Release the log plugin instance
-  void Reset() { log_.Reset(); }
+  void Reset() {
+    log_.Reset();
+    LogCallSite::InvalidateAll();
+  }
 
  private:
   // Returns the "default" log plugin instance
@@ -12,6 +12,7 @@
 //
 
 #include "trpc/util/log/log.h"
+#include "trpc/util/log/logging.h"
 #include "trpc/util/log/testing/mock_log.h"
 
 #include "gmock/gmock.h"
@@ -45,4 +46,82 @@ TEST_F(LogFactoryTest, RegisterAndGetAndReset) {
   EXPECT_EQ(empty_log.get(), nullptr);
 }
 
+TEST(LogCallSiteTest, CacheShouldLogDecision) {
+  using namespace ::testing;
+
+  auto mock_log = MakeRefCounted<MockLog>();
+  LogFactory::GetInstance()->Register(mock_log);
+
+  auto log_debug = [](int i) { TRPC_FMT("mock", ::trpc::Log::debug, "debug {}", i); };
+
+  // The minimum enabled level (info) is resolved once, then served from the callsite cache.
+  EXPECT_CALL(*mock_log, ShouldLog(StrEq("mock"), _)).Times(3).WillRepeatedly([](const char*, Log::Level level) {
+    return level >= Log::info;
+  });
+  EXPECT_CALL(*mock_log, LogIt(_, _, _, _, _, _, _)).Times(0);
+  for (int i = 0; i < 100; ++i) {
+    log_debug(i);
+  }
+  Mock::VerifyAndClearExpectations(mock_log.get());
+
+  // Changing the level invalidates the cache, the minimum level is resolved again.
+  LogCallSite::InvalidateAll();
+  EXPECT_CALL(*mock_log, ShouldLog(StrEq("mock"), _)).Times(2).WillRepeatedly([](const char*, Log::Level level) {
+    return level >= Log::debug;
+  });
+  EXPECT_CALL(*mock_log, LogIt(StrEq("mock"), Log::debug, _, _, _, _, _)).Times(10);
+  for (int i = 0; i < 10; ++i) {
+    log_debug(i);
+  }
+  Mock::VerifyAndClearExpectations(mock_log.get());
+
+  LogFactory::GetInstance()->Reset();
+}
+
+TEST(LogCallSiteTest, RuntimeLevel) {
+  using namespace ::testing;
+
+  auto mock_log = MakeRefCounted<MockLog>();
+  LogFactory::GetInstance()->Register(mock_log);
+
+  auto log_at = [](Log::Level level) { TRPC_PRT("mock", level, "level %d", static_cast<int>(level)); };
+
+  // One callsite logging at different levels, each call is decided by its own level.
+  EXPECT_CALL(*mock_log, ShouldLog(StrEq("mock"), _)).WillRepeatedly([](const char*, Log::Level level) {
+    return level >= Log::info;
+  });
+  EXPECT_CALL(*mock_log, LogIt(StrEq("mock"), Log::debug, _, _, _, _, _)).Times(0);
+  EXPECT_CALL(*mock_log, LogIt(StrEq("mock"), Log::error, _, _, _, _, _)).Times(2);
+  EXPECT_CALL(*mock_log, LogIt(StrEq("mock"), Log::info, _, _, _, _, _)).Times(1);
+  log_at(Log::debug);
+  log_at(Log::error);
+  log_at(Log::debug);
+  log_at(Log::info);
+  log_at(Log::error);
+  Mock::VerifyAndClearExpectations(mock_log.get());
+
+  LogFactory::GetInstance()->Reset();
+}
+
+TEST(LogCallSiteTest, DynamicInstanceName) {
+  using namespace ::testing;
+
+  auto mock_log = MakeRefCounted<MockLog>();
+  LogFactory::GetInstance()->Register(mock_log);
+
+  auto log_debug = [](const char* instance) { TRPC_FMT(instance, ::trpc::Log::debug, "debug"); };
+
+  // The callsite logs to different instances, so every decision has to be resolved by the log plugin.
+  EXPECT_CALL(*mock_log, ShouldLog(StrEq("disabled"), _)).WillRepeatedly(Return(false));
+  EXPECT_CALL(*mock_log, ShouldLog(StrEq("enabled"), Log::debug)).Times(2).WillRepeatedly(Return(true));
+  EXPECT_CALL(*mock_log, LogIt(StrEq("enabled"), Log::debug, _, _, _, _, _)).Times(2);
+  log_debug("disabled");
+  log_debug("enabled");
+  log_debug("disabled");
+  log_debug("enabled");
+  Mock::VerifyAndClearExpectations(mock_log.get());
+
+  LogFactory::GetInstance()->Reset();
+}
+
 }  // namespace trpc::testing
@@ -50,9 +50,14 @@ using trpc::kTrpcLogCacheStringDefault;
 /// @param msg       Log message
 #define TRPC_LOG(instance, level, msg)                                                        \
   do {                                                                                        \
+    static ::trpc::LogCallSite __TRPC_LOG_CALL_SITE__;                                        \
+    if (__TRPC_LOG_CALL_SITE__.IsDisabled(instance, level)) break;                            \
     const auto& __TRPC_LOG_INSTANCE__ = ::trpc::LogFactory::GetInstance()->Get();             \
     if (__TRPC_LOG_INSTANCE__) {                                                              \
-      if (__TRPC_LOG_INSTANCE__->ShouldLog(instance, level))                                  \
+      if (__TRPC_LOG_CALL_SITE__.ShouldLog(                                                   \
+              instance, level, [&](auto __TRPC_LOG_LEVEL__) {                                 \
+                return __TRPC_LOG_INSTANCE__->ShouldLog(instance, __TRPC_LOG_LEVEL__);        \
+              }))                                                                             \
         __TRPC_LOG_INSTANCE__->LogIt(instance, level, __FILE__, __LINE__, __FUNCTION__, msg); \
     } else {                                                                                  \
       ::trpc::Log::NoLog(instance, level, __FILE__, __LINE__, __FUNCTION__, msg);             \
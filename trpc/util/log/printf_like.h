@@ -22,9 +22,14 @@
 /// @brief printf-like log macros for tRPC-Cpp framework log
 #define TRPC_PRT_DEFAULT(instance, level, formats, args...)                                                       \
   do {                                                                                                            \
+    static ::trpc::LogCallSite __TRPC_LOG_CALL_SITE__;                                                            \
+    if (__TRPC_LOG_CALL_SITE__.IsDisabled(instance, level)) break;                                                \
     const auto& __TRPC_PRINTF_LIKE_INSTANCE__ = ::trpc::LogFactory::GetInstance()->Get();                         \
     if (__TRPC_PRINTF_LIKE_INSTANCE__) {                                                                          \
-      if (__TRPC_PRINTF_LIKE_INSTANCE__->ShouldLog(level)) {                                                      \
+      if (__TRPC_LOG_CALL_SITE__.ShouldLog(                                                                       \
+              instance, level, [&](auto __TRPC_LOG_LEVEL__) {                                                     \
+                return __TRPC_PRINTF_LIKE_INSTANCE__->ShouldLog(__TRPC_LOG_LEVEL__);                              \
+              })) {                                                                                               \
         TRPC_LOG_TRY {                                                                                            \
           std::string __TRPC_PRINTF_LIKE_MSG__ = ::trpc::Log::LogSprintf(formats, ##args);                        \
           __TRPC_PRINTF_LIKE_INSTANCE__->LogIt(instance, level, __FILE__, __LINE__, __FUNCTION__,                 \
@@ -48,9 +53,14 @@
 /// @brief printf-like log macros
 #define TRPC_PRT(instance, level, formats, args...)                                                               \
   do {                                                                                                            \
+    static ::trpc::LogCallSite __TRPC_LOG_CALL_SITE__;                                                            \
+    if (__TRPC_LOG_CALL_SITE__.IsDisabled(instance, level)) break;                                                \
     const auto& __TRPC_PRINTF_LIKE_INSTANCE__ = ::trpc::LogFactory::GetInstance()->Get();                         \
     if (__TRPC_PRINTF_LIKE_INSTANCE__) {                                                                          \
-      if (__TRPC_PRINTF_LIKE_INSTANCE__->ShouldLog(instance, level)) {                                            \
+      if (__TRPC_LOG_CALL_SITE__.ShouldLog(                                                                       \
+              instance, level, [&](auto __TRPC_LOG_LEVEL__) {                                                     \
+                return __TRPC_PRINTF_LIKE_INSTANCE__->ShouldLog(instance, __TRPC_LOG_LEVEL__);                    \
+              })) {                                                                                               \
         TRPC_LOG_TRY {                                                                                            \
           std::string __TRPC_PRINTF_LIKE_MSG__ = ::trpc::Log::LogSprintf(formats, ##args);                        \
           __TRPC_PRINTF_LIKE_INSTANCE__->LogIt(instance, level, __FILE__, __LINE__, __FUNCTION__,                 \
@@ -82,9 +92,14 @@
 
 #define TRPC_PRT_EX(context, instance, level, formats, args...)                                           \
   do {                                                                                                    \
+    static ::trpc::LogCallSite __TRPC_LOG_CALL_SITE__;                                                    \
+    if (__TRPC_LOG_CALL_SITE__.IsDisabled(instance, level)) break;                                        \
     const auto& p = ::trpc::LogFactory::GetInstance()->Get();                                             \
     if (p) {                                                                                              \
-      if (p->ShouldLog(instance, level)) {                                                                \
+      if (__TRPC_LOG_CALL_SITE__.ShouldLog(                                                               \
+              instance, level, [&](auto __TRPC_LOG_LEVEL__) {                                             \
+                return p->ShouldLog(instance, __TRPC_LOG_LEVEL__);                                        \
+              })) {                                                                                       \
         TRPC_LOG_TRY {                                                                                    \
           auto& filter_data = context->GetAllFilterData();                                                \
           std::string trpc_printf_like_msg = fmt::sprintf(formats, ##args);                               \
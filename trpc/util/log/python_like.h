@@ -24,9 +24,14 @@
 /// @brief python-like style log macros for  tRPC-Cpp framework log
 #define TRPC_FMT_DEFAULT(instance, level, formats, args...)                                       \
   do {                                                                                            \
+    static ::trpc::LogCallSite __TRPC_LOG_CALL_SITE__;                                            \
+    if (__TRPC_LOG_CALL_SITE__.IsDisabled(instance, level)) break;                                \
     const auto& __TRPC_PYTHON_LIKE_INSTANCE__ = ::trpc::LogFactory::GetInstance()->Get();         \
     if (__TRPC_PYTHON_LIKE_INSTANCE__) {                                                          \
-      if (__TRPC_PYTHON_LIKE_INSTANCE__->ShouldLog(level)) {                                      \
+      if (__TRPC_LOG_CALL_SITE__.ShouldLog(                                                       \
+              instance, level, [&](auto __TRPC_LOG_LEVEL__) {                                     \
+                return __TRPC_PYTHON_LIKE_INSTANCE__->ShouldLog(__TRPC_LOG_LEVEL__);              \
+              })) {                                                                               \
         TRPC_LOG_TRY {                                                                            \
           __TRPC_PYTHON_LIKE_INSTANCE__->LogIt(instance, level, __FILE__, __LINE__, __FUNCTION__, \
                                                ::trpc::Log::LogFormat(formats, ##args));          \
@@ -46,26 +51,31 @@
 
 
 /// @brief python-like style log macros
-#define TRPC_FMT(instance, level, formats, args...)                                               \
-  do {                                                                                            \
-    const auto& __TRPC_PYTHON_LIKE_INSTANCE__ = ::trpc::LogFactory::GetInstance()->Get();         \
-    if (__TRPC_PYTHON_LIKE_INSTANCE__) {                                                          \
-      if (__TRPC_PYTHON_LIKE_INSTANCE__->ShouldLog(instance, level)) {                            \
-        TRPC_LOG_TRY {                                                                            \
-          __TRPC_PYTHON_LIKE_INSTANCE__->LogIt(instance, level, __FILE__, __LINE__, __FUNCTION__, \
-                                               ::trpc::Log::LogFormat(formats, ##args));          \
-        }                                                                                         \
-        TRPC_LOG_CATCH(instance)                                                                  \
-      }                                                                                           \
-    } else {                                                                                      \
-      if (::trpc::Log::ShouldNoLog(instance, level)) {                                            \
-        TRPC_LOG_TRY {                                                                            \
-          ::trpc::Log::NoLog(instance, level, __FILE__, __LINE__, __FUNCTION__,                   \
-                             ::trpc::Log::LogFormat(formats, ##args));                            \
-        }                                                                                         \
-        TRPC_LOG_CATCH(instance)                                                                  \
-      }                                                                                           \
-    }                                                                                             \
+#define TRPC_FMT(instance, level, formats, args...)                                                   \
+  do {                                                                                                \
+    static ::trpc::LogCallSite __TRPC_LOG_CALL_SITE__;                                                \
+    if (__TRPC_LOG_CALL_SITE__.IsDisabled(instance, level)) break;                                    \
+    const auto& __TRPC_PYTHON_LIKE_INSTANCE__ = ::trpc::LogFactory::GetInstance()->Get();             \
+    if (__TRPC_PYTHON_LIKE_INSTANCE__) {                                                              \
+      if (__TRPC_LOG_CALL_SITE__.ShouldLog(                                                           \
+              instance, level, [&](auto __TRPC_LOG_LEVEL__) {                                         \
+                return __TRPC_PYTHON_LIKE_INSTANCE__->ShouldLog(instance, __TRPC_LOG_LEVEL__);        \
+              })) {                                                                                   \
+        TRPC_LOG_TRY {                                                                                \
+          __TRPC_PYTHON_LIKE_INSTANCE__->LogIt(instance, level, __FILE__, __LINE__, __FUNCTION__,     \
+                                               ::trpc::Log::LogFormat(formats, ##args));              \
+        }                                                                                             \
+        TRPC_LOG_CATCH(instance)                                                                      \
+      }                                                                                               \
+    } else {                                                                                          \
+      if (::trpc::Log::ShouldNoLog(instance, level)) {                                                \
+        TRPC_LOG_TRY {                                                                                \
+          ::trpc::Log::NoLog(instance, level, __FILE__, __LINE__, __FUNCTION__,                       \
+                             ::trpc::Log::LogFormat(formats, ##args));                                \
+        }                                                                                             \
+        TRPC_LOG_CATCH(instance)                                                                      \
+      }                                                                                               \
+    }                                                                                                 \
   } while (0)
 
 #define TRPC_FMT_IF(instance, condition, level, formats, args...) \
@@ -75,9 +85,14 @@
 
 #define TRPC_FMT_EX(context, instance, level, formats, args...)                                                   \
   do {                                                                                                            \
+    static ::trpc::LogCallSite __TRPC_LOG_CALL_SITE__;                                                            \
+    if (__TRPC_LOG_CALL_SITE__.IsDisabled(instance, level)) break;                                                \
     const auto& p = ::trpc::LogFactory::GetInstance()->Get();                                                     \
     if (p) {                                                                                                      \
-      if (p->ShouldLog(instance, level)) {                                                                        \
+      if (__TRPC_LOG_CALL_SITE__.ShouldLog(                                                                       \
+              instance, level, [&](auto __TRPC_LOG_LEVEL__) {                                                     \
+                return p->ShouldLog(instance, __TRPC_LOG_LEVEL__);                                                \
+              })) {                                                                                               \
         TRPC_LOG_TRY {                                                                                            \
           auto& filter_data = context->GetAllFilterData();                                                        \
           p->LogIt(instance, level, __FILE__, __LINE__, __FUNCTION__, fmt::format(formats, ##args), filter_data); \
@@ -26,9 +26,14 @@
 /// @brief stream-like log macros
 #define TRPC_STREAM(instance, level, context, msg)                                                          \
   do {                                                                                                      \
+    static ::trpc::LogCallSite __TRPC_LOG_CALL_SITE__;                                                      \
+    if (__TRPC_LOG_CALL_SITE__.IsDisabled(instance, level)) break;                                          \
     const auto& __TRPC_CPP_STREAM_LOGGER_INSTANCE__ = ::trpc::LogFactory::GetInstance()->Get();             \
     if (__TRPC_CPP_STREAM_LOGGER_INSTANCE__) {                                                              \
-      if (__TRPC_CPP_STREAM_LOGGER_INSTANCE__->ShouldLog(instance, level)) {                                \
+      if (__TRPC_LOG_CALL_SITE__.ShouldLog(                                                                 \
+              instance, level, [&](auto __TRPC_LOG_LEVEL__) {                                               \
+                return __TRPC_CPP_STREAM_LOGGER_INSTANCE__->ShouldLog(instance, __TRPC_LOG_LEVEL__);        \
+              })) {                                                                                         \
         TRPC_LOG_TRY {                                                                                      \
           STREAM_APPENDER(msg);                                                                             \
           if (context) {                                                                                    \
@@ -55,9 +60,14 @@
 /// @brief stream-like log macros for tRPC-Cpp framework log
 #define TRPC_STREAM_DEFAULT(instance, level, msg)                                                       \
   do {                                                                                                  \
+    static ::trpc::LogCallSite __TRPC_LOG_CALL_SITE__;                                                  \
+    if (__TRPC_LOG_CALL_SITE__.IsDisabled(instance, level)) break;                                      \
     const auto& __TRPC_CPP_STREAM_LOGGER_INSTANCE__ = ::trpc::LogFactory::GetInstance()->Get();         \
     if (__TRPC_CPP_STREAM_LOGGER_INSTANCE__) {                                                          \
-      if (__TRPC_CPP_STREAM_LOGGER_INSTANCE__->ShouldLog(level)) {                                      \
+      if (__TRPC_LOG_CALL_SITE__.ShouldLog(                                                             \
+              instance, level, [&](auto __TRPC_LOG_LEVEL__) {                                           \
+                return __TRPC_CPP_STREAM_LOGGER_INSTANCE__->ShouldLog(__TRPC_LOG_LEVEL__);              \
+              })) {                                                                                     \
         TRPC_LOG_TRY {                                                                                  \
           STREAM_APPENDER(msg);                                                                         \
           __TRPC_CPP_STREAM_LOGGER_INSTANCE__->LogIt(instance, level, __FILE__, __LINE__, __FUNCTION__, \
@@ -79,9 +89,14 @@
 /// @brief stream-like log macros for tRPC-Cpp framework
 #define TRPC_STREAM_EX_DEFAULT(instance, level, context, msg)                                               \
   do {                                                                                                      \
+    static ::trpc::LogCallSite __TRPC_LOG_CALL_SITE__;                                                      \
+    if (__TRPC_LOG_CALL_SITE__.IsDisabled(instance, level)) break;                                          \
     const auto& __TRPC_CPP_STREAM_LOGGER_INSTANCE__ = ::trpc::LogFactory::GetInstance()->Get();             \
     if (__TRPC_CPP_STREAM_LOGGER_INSTANCE__) {                                                              \
-      if (__TRPC_CPP_STREAM_LOGGER_INSTANCE__->ShouldLog(level)) {                                          \
+      if (__TRPC_LOG_CALL_SITE__.ShouldLog(                                                                 \
+              instance, level, [&](auto __TRPC_LOG_LEVEL__) {                                               \
+                return __TRPC_CPP_STREAM_LOGGER_INSTANCE__->ShouldLog(__TRPC_LOG_LEVEL__);                  \
+              })) {                                                                                         \
         TRPC_LOG_TRY {                                                                                      \
           STREAM_APPENDER(msg);                                                                             \
           __TRPC_CPP_STREAM_LOGGER_INSTANCE__->LogIt(instance, level, __FILE__, __LINE__, __FUNCTION__,     \
@@ -103,9 +118,14 @@
 /// @brief stream-like log macros
 #define TRPC_STREAM_EX(instance, level, context, msg)                                                       \
   do {                                                                                                      \
+    static ::trpc::LogCallSite __TRPC_LOG_CALL_SITE__;                                                      \
+    if (__TRPC_LOG_CALL_SITE__.IsDisabled(instance, level)) break;                                          \
     const auto& __TRPC_CPP_STREAM_LOGGER_INSTANCE__ = ::trpc::LogFactory::GetInstance()->Get();             \
     if (__TRPC_CPP_STREAM_LOGGER_INSTANCE__) {                                                              \
-      if (__TRPC_CPP_STREAM_LOGGER_INSTANCE__->ShouldLog(instance, level)) {                                \
+      if (__TRPC_LOG_CALL_SITE__.ShouldLog(                                                                 \
+              instance, level, [&](auto __TRPC_LOG_LEVEL__) {                                               \
+                return __TRPC_CPP_STREAM_LOGGER_INSTANCE__->ShouldLog(instance, __TRPC_LOG_LEVEL__);        \
+              })) {                                                                                         \
         TRPC_LOG_TRY {                                                                                      \
           STREAM_APPENDER(msg);                                                                             \
           __TRPC_CPP_STREAM_LOGGER_INSTANCE__->LogIt(instance, level, __FILE__, __LINE__, __FUNCTION__,     \
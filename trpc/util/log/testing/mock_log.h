@@ -13,7 +13,9 @@
 
 #pragma once
 
+#include <any>
 #include <string>
+#include <unordered_map>
 #include <utility>
 
 #include "gmock/gmock.h"
@@ -33,7 +35,9 @@ class MockLog : public Log {
   void Stop() override { ASSERT_TRUE(true); }
 
   MOCK_CONST_METHOD2(ShouldLog, bool(const char*, Level));
-  MOCK_CONST_METHOD6(LogIt, void(const char*, Level, const char*, int, const char*, std::string_view));
+  MOCK_CONST_METHOD1(ShouldLog, bool(Level));
+  MOCK_CONST_METHOD7(LogIt, void(const char*, Level, const char*, int, const char*, std::string_view,
+                                 const std::unordered_map<uint32_t, std::any>&));
 
   MOCK_CONST_METHOD1(GetLevel, std::pair<Level, bool>(const char*));
   MOCK_METHOD2(SetLevel, std::pair<Level, bool>(const char*, Level level));
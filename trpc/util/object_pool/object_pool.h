@@ -113,4 +113,8 @@ void Delete(T* p) {
   }
 }
 
+/// @brief Return the objects of other threads freed by the current thread to their owners at once.
+/// @note Only shared-nothing object pools batch such objects, call it when the thread is going to be idle.
+inline void FlushRemoteFrees() { shared_nothing::FlushAllRemoteFrees(); }
+
 }  // namespace trpc::object_pool
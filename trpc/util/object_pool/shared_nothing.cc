@@ -13,12 +13,20 @@
 
 #include "trpc/util/object_pool/shared_nothing.h"
 
+#include <algorithm>
+
 namespace trpc::object_pool::shared_nothing {
 
 namespace detail {
 
 namespace {
 std::atomic<uint32_t> cpu_id_gen{0};
+
+// The batches of freed objects of current thread, one for each type of objects.
+std::vector<RemoteFreeBatchesBase*>& GetTlsRemoteFreeBatches() {
+  thread_local std::vector<RemoteFreeBatchesBase*> batches;
+  return batches;
+}
 }
 
 uint32_t GetCpuId() {
@@ -33,6 +41,19 @@ uint32_t GetCpuId() {
   return tls_cpu_id;
 }
 
+RemoteFreeBatchesBase::RemoteFreeBatchesBase() { GetTlsRemoteFreeBatches().push_back(this); }
+
+RemoteFreeBatchesBase::~RemoteFreeBatchesBase() {
+  auto& batches = GetTlsRemoteFreeBatches();
+  batches.erase(std::remove(batches.begin(), batches.end(), this), batches.end());
+}
+
 }  // namespace detail
 
+void FlushAllRemoteFrees() {
+  for (auto* batches : detail::GetTlsRemoteFreeBatches()) {
+    batches->Flush();
+  }
+}
+
 }  // namespace trpc::object_pool::shared_nothing
@@ -19,6 +19,7 @@
 #include <cstdint>
 #include <cstdlib>
 #include <memory>
+#include <thread>
 #include <vector>
 
 #include "trpc/util/likely.h"
@@ -36,7 +37,9 @@ struct alignas(64) Statistics {
   size_t allocs_num{0};             // Total number of object allocations in the current thread's object pool.
   size_t frees_num{0};              // Total number of object releases in the current thread's object pool.
   size_t cross_cpu_frees_num{0};    // Number of objects reclaimed from the idle list across CPUs.
+  size_t cross_cpu_drains_num{0};   // Number of times the idle list across CPUs was drained.
   size_t foreign_frees_num{0};      // Number of times objects were reclaimed to the idle list  across CPUs.
+  size_t foreign_free_batches_num{0};  // Number of batches of objects pushed to the idle list across CPUs.
   size_t slot_chunks_alloc_num{0};  // Number of times the current thread's object pool executed a 'chunk' allocation.
   size_t slot_from_system{0};       // Number of times a 'slot' was allocated from the system.
 };
@@ -55,6 +58,8 @@ static constexpr uint32_t kInvalidCpuId = 0xffffffff;  // Invalid CPU ID.
 static constexpr uint32_t kInvalidSlotChunkId = 0;     // Invalid SlotChunk ID, valid IDs should > 0.
 static constexpr uint32_t kPageSize = 4096;            // Memory page size.
 static constexpr uint32_t kMinChunkSize = 8;           // The minimum number of objects contained in a chunk.
+static constexpr uint32_t kRemoteFreeBatchSize = 32;   // Objects freed to the same remote pool pushed at once.
+static constexpr uint32_t kRemoteFreeBatchNum = 8;     // The number of remote pools a thread keeps batches for.
 
 template <typename T>
 class SharedNothingPoolImp;
@@ -62,11 +67,18 @@ class SharedNothingPoolImp;
 /// @brief The global management class for 'shared-nothing' object pool.
 template <typename T>
 struct SharedNothingPool {
-  static SharedNothingPoolImp<T>* all_cpus[kMaxCpus];
+  /// @brief The registration of the pool of a thread, which is looked up by other threads returning objects to it.
+  struct alignas(64) Entry {
+    std::atomic<SharedNothingPoolImp<T>*> pool{nullptr};
+    // The number of threads which may be pushing objects to `pool`, the pool waits for them before it is destroyed.
+    std::atomic<uint32_t> pushers{0};
+  };
+
+  static Entry all_cpus[kMaxCpus];
 };
 
 template <typename T>
-SharedNothingPoolImp<T>* SharedNothingPool<T>::all_cpus[kMaxCpus];
+typename SharedNothingPool<T>::Entry SharedNothingPool<T>::all_cpus[kMaxCpus];
 
 uint32_t GetCpuId();
 
@@ -161,8 +173,9 @@ class alignas(64) SharedNothingPoolImp {
   /// @brief Deallocate an object
   void Delete(T* obj);
 
-  /// @brief Deallocate an object across CPUs
-  void DeleteCrossCpu(T* obj);
+  /// @brief Push a list of objects freed by other threads, `length` objects linked from `head` to `tail`.
+  /// @note  Called by other threads.
+  void PushCrossCpuFreelist(Slot<T>* head, Slot<T>* tail, uint32_t length);
 
  private:
   // Reclaim free list objects across CPUs
@@ -184,6 +197,8 @@ class alignas(64) SharedNothingPoolImp {
   uint32_t chunk_size_;
   // The maximun number of Slot objects allocated.
   size_t max_slot_num_{kDefaultMaxObjectNum};
+  // The CPU ID of the thread owning the pool.
+  uint32_t cpu_id_{kInvalidCpuId};
   // The cross-CPU object reclamation list.
   alignas(64) std::atomic<Slot<T>*> xcpu_freelist_{nullptr};
   // The current number of Slot objects allocated.
@@ -195,6 +210,7 @@ std::atomic<uint32_t> SharedNothingPoolImp<T>::current_slot_num_{0};
 
 template <typename T>
 SharedNothingPoolImp<T>::SharedNothingPoolImp() {
+  cpu_id_ = GetCpuId();
   slot_chunk_manager_.DoResize(100);
   max_free_num_ = std::max<uint32_t>(64, kPageSize * 2 / static_cast<uint32_t>(sizeof(Slot<T>)));
   uint32_t min_free_num = max_free_num_ / 2;
@@ -209,6 +225,16 @@ SharedNothingPoolImp<T>::SharedNothingPoolImp() {
 
 template <typename T>
 SharedNothingPoolImp<T>::~SharedNothingPoolImp() {
+  // Objects freed by other threads from now on are dropped, see `RemoteFreeBatches::FlushBatch`. The threads which
+  // have already seen this pool are waited for, so none of them touches it after it is destroyed.
+  auto& entry = SharedNothingPool<T>::all_cpus[cpu_id_];
+  SharedNothingPoolImp<T>* self = this;
+  entry.pool.compare_exchange_strong(self, nullptr, std::memory_order_seq_cst);
+  while (entry.pushers.load(std::memory_order_seq_cst) != 0) {
+    std::this_thread::yield();
+  }
+  DrainCrossCpuFreelist();
+
   // Reclaiming Slot objects from freeslots_ to slot_chunk_manager_
   while (freeslots_.length > 0) {
     auto* slot = freeslots_.head;
@@ -233,7 +259,7 @@ SharedNothingPoolImp<T>::~SharedNothingPoolImp() {
     if (slot_chunk.freeslot.length == chunk_size_) {
       free_chunk_count++;
       free(slot_chunk.chunk_addr);
-      current_slot_num_.fetch_sub(chunk_size_, std::memory_order::memory_order_relaxed);
+      current_slot_num_.fetch_sub(chunk_size_, std::memory_order_relaxed);
     } else {
       TRPC_FMT_ERROR("Memory leak, chunk_id = {}, chunk_addr = {}", chunk_id, slot_chunk.chunk_addr);
     }
@@ -247,7 +273,11 @@ SharedNothingPoolImp<T>::~SharedNothingPoolImp() {
 
 template <typename T>
 T* SharedNothingPoolImp<T>::New() {
-  DrainCrossCpuFreelist();
+  if (TRPC_UNLIKELY(!freeslots_.head)) {
+    // Reuse the objects freed by other threads first, they are drained in batch only when the local list runs out,
+    // which keeps the shared list off the fast path.
+    DrainCrossCpuFreelist();
+  }
 
   if (TRPC_UNLIKELY(!freeslots_.head)) {
     // Allocate goal number of targets from slot_chunk_manager_ to freeslots_ first.
@@ -267,7 +297,7 @@ T* SharedNothingPoolImp<T>::New() {
     }
 
     // If slot_chunk_manager_ cannot allocate goal number of targets, then allocate from the system.
-    uint32_t current_slot_num = current_slot_num_.load(std::memory_order::memory_order_relaxed);
+    uint32_t current_slot_num = current_slot_num_.load(std::memory_order_relaxed);
     while (freeslots_.length < goal_num_ && current_slot_num < max_slot_num_) {
       void* chunk_addr = aligned_alloc(alignof(Slot<T>), sizeof(Slot<T>) * chunk_size_);
       if (TRPC_UNLIKELY(chunk_addr == nullptr)) {
@@ -293,7 +323,7 @@ T* SharedNothingPoolImp<T>::New() {
 
       // Increment the allocation count in data statistics.
       ++GetTlsStatistics<T>().slot_chunks_alloc_num;
-      current_slot_num_.fetch_add(chunk_size_, std::memory_order::memory_order_relaxed);
+      current_slot_num_.fetch_add(chunk_size_, std::memory_order_relaxed);
     }
   }
 
@@ -358,19 +388,14 @@ void SharedNothingPoolImp<T>::Delete(T* obj) {
 }
 
 template <typename T>
-void SharedNothingPoolImp<T>::DeleteCrossCpu(T* obj) {
-  Slot<T>* p = reinterpret_cast<Slot<T>*>(obj);
-  if (DeleteToSystem(p)) {
-    return;
-  }
-
+void SharedNothingPoolImp<T>::PushCrossCpuFreelist(Slot<T>* head, Slot<T>* tail, uint32_t length) {
   auto& list = xcpu_freelist_;
   auto old = list.load(std::memory_order_relaxed);
   do {
-    p->next = old;
-  } while (!list.compare_exchange_weak(old, p, std::memory_order_release, std::memory_order_relaxed));
+    tail->next = old;
+  } while (!list.compare_exchange_weak(old, head, std::memory_order_release, std::memory_order_relaxed));
 
-  ++GetTlsStatistics<T>().foreign_frees_num;
+  ++GetTlsStatistics<T>().foreign_free_batches_num;
 }
 
 template <typename T>
@@ -394,6 +419,7 @@ void SharedNothingPoolImp<T>::DrainCrossCpuFreelist() {
   }
 
   GetTlsStatistics<T>().cross_cpu_frees_num += free_num;
+  ++GetTlsStatistics<T>().cross_cpu_drains_num;
 }
 
 template <typename T>
@@ -407,13 +433,96 @@ bool SharedNothingPoolImp<T>::DeleteToSystem(Slot<T>* slot) {
   return false;
 }
 
+/// @brief The batches of objects of some type freed by current thread, which can be flushed without knowing the type.
+class RemoteFreeBatchesBase {
+ public:
+  RemoteFreeBatchesBase();
+
+  virtual ~RemoteFreeBatchesBase();
+
+  /// @brief Push all batches to their owners.
+  virtual void Flush() = 0;
+};
+
+/// @brief Objects freed by current thread but allocated by others, which are pushed to the owners in batch, so freeing
+///        objects of another thread doesn't contend on its list for every object.
+/// @note  A thread keeps at most `kRemoteFreeBatchNum * kRemoteFreeBatchSize` objects in batches, they are flushed
+///        when the thread exits, or by `FlushRemoteFrees`.
+template <typename T>
+class RemoteFreeBatches : public RemoteFreeBatchesBase {
+ public:
+  ~RemoteFreeBatches() override { Flush(); }
+
+  /// @brief Add an object allocated by the thread of `owner`.
+  void Add(uint32_t owner, Slot<T>* slot) {
+    Batch& batch = batches_[owner % kRemoteFreeBatchNum];
+    if (batch.owner != owner) {
+      FlushBatch(batch);
+      batch.owner = owner;
+    }
+
+    slot->next = batch.head;
+    batch.head = slot;
+    if (!batch.tail) {
+      batch.tail = slot;
+    }
+    ++GetTlsStatistics<T>().foreign_frees_num;
+
+    if (++batch.length >= kRemoteFreeBatchSize) {
+      FlushBatch(batch);
+    }
+  }
+
+  void Flush() override {
+    for (auto& batch : batches_) {
+      FlushBatch(batch);
+    }
+  }
+
+ private:
+  struct Batch {
+    Slot<T>* head{nullptr};
+    Slot<T>* tail{nullptr};
+    uint32_t length{0};
+    uint32_t owner{kInvalidCpuId};
+  };
+
+  void FlushBatch(Batch& batch) {
+    if (batch.length == 0) {
+      return;
+    }
+
+    // The chunks of objects are never freed if the owner has exited, so the objects are simply dropped. The pusher is
+    // announced before the pool is looked up, so the owner either sees it and waits, or it sees the pool unregistered.
+    auto& entry = SharedNothingPool<T>::all_cpus[batch.owner];
+    entry.pushers.fetch_add(1, std::memory_order_seq_cst);
+    SharedNothingPoolImp<T>* pool = entry.pool.load(std::memory_order_seq_cst);
+    if (pool != nullptr) {
+      pool->PushCrossCpuFreelist(batch.head, batch.tail, batch.length);
+    }
+    entry.pushers.fetch_sub(1, std::memory_order_release);
+    batch.head = nullptr;
+    batch.tail = nullptr;
+    batch.length = 0;
+  }
+
+ private:
+  Batch batches_[kRemoteFreeBatchNum];
+};
+
+template <typename T>
+RemoteFreeBatches<T>& GetRemoteFreeBatches() {
+  thread_local RemoteFreeBatches<T> batches;
+  return batches;
+}
+
 template <typename T>
 SharedNothingPoolImp<T>* GetSharedNothingPool(uint32_t cpu_id) {
   thread_local std::unique_ptr<SharedNothingPoolImp<T>> tls_pool = nullptr;
   if (!tls_pool) {
     tls_pool = std::make_unique<SharedNothingPoolImp<T>>();
 
-    SharedNothingPool<T>::all_cpus[cpu_id] = tls_pool.get();
+    SharedNothingPool<T>::all_cpus[cpu_id].pool.store(tls_pool.get(), std::memory_order_release);
   }
 
   return tls_pool.get();
@@ -440,12 +549,25 @@ void Delete(T* ptr) {
   uint32_t tls_cpu_id = detail::GetCpuId();
   if (cpu_id == tls_cpu_id) {
     detail::GetSharedNothingPool<T>(cpu_id)->Delete(ptr);
+  } else if (TRPC_UNLIKELY(slot->need_free_to_system)) {
+    // Allocated from system, no need to return it to the owner.
+    slot->need_free_to_system = false;
+    free(slot);
+    --GetTlsStatistics<T>().slot_from_system;
   } else {
-    detail::SharedNothingPoolImp<T>* pool = detail::SharedNothingPool<T>::all_cpus[cpu_id];
-    assert(pool != nullptr);
-
-    pool->DeleteCrossCpu(ptr);
+    detail::GetRemoteFreeBatches<T>().Add(cpu_id, slot);
   }
 }
 
+/// @brief Push the objects of other threads freed by current thread to their owners at once. Objects freed across
+///        threads are returned to the owners in batches, call it when the thread is going to be idle for a while, so
+///        the owners can reuse them.
+template <typename T>
+void FlushRemoteFrees() {
+  detail::GetRemoteFreeBatches<T>().Flush();
+}
+
+/// @brief Push the objects of other threads freed by current thread to their owners at once, for objects of all types.
+void FlushAllRemoteFrees();
+
 }  // namespace trpc::object_pool::shared_nothing
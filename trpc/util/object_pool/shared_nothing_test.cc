@@ -15,6 +15,7 @@
 
 #include <stdlib.h>
 
+#include <algorithm>
 #include <atomic>
 #include <condition_variable>
 #include <functional>
@@ -193,6 +194,92 @@ TEST(SharedNothingTest, SharedNothingMultiThreadTest) {
   ASSERT_TRUE(true);
 }
 
+struct E {
+  int a;
+};
+
+template <>
+struct ObjectPoolTraits<E> {
+  static constexpr auto kType = ObjectPoolType::kSharedNothing;
+};
+
+TEST(SharedNothingTest, CrossThreadDeleteInBatch) {
+  using shared_nothing::detail::kRemoteFreeBatchSize;
+  std::vector<E*> items;
+  for (uint32_t i = 0; i < kRemoteFreeBatchSize + 1; ++i) {
+    items.push_back(trpc::object_pool::New<E>());
+  }
+
+  std::thread t([&items] {
+    for (auto* item : items) {
+      trpc::object_pool::Delete<E>(item);
+    }
+    auto& stats = shared_nothing::GetTlsStatistics<E>();
+    ASSERT_EQ(stats.foreign_frees_num, kRemoteFreeBatchSize + 1);
+    // The last one is kept in batch until flushed.
+    ASSERT_EQ(stats.foreign_free_batches_num, 1);
+    shared_nothing::FlushRemoteFrees<E>();
+    ASSERT_EQ(stats.foreign_free_batches_num, 2);
+  });
+  t.join();
+
+  // Objects freed by other thread are drained once the local list runs out.
+  auto& stats = shared_nothing::GetTlsStatistics<E>();
+  std::vector<E*> reused;
+  while (stats.cross_cpu_drains_num == 0) {
+    reused.push_back(trpc::object_pool::New<E>());
+  }
+  ASSERT_EQ(stats.cross_cpu_frees_num, kRemoteFreeBatchSize + 1);
+  ASSERT_NE(std::find(items.begin(), items.end(), reused.back()), items.end());
+  for (auto* item : reused) {
+    trpc::object_pool::Delete<E>(item);
+  }
+}
+
+struct F {
+  int a;
+};
+
+template <>
+struct ObjectPoolTraits<F> {
+  static constexpr auto kType = ObjectPoolType::kSharedNothing;
+};
+
+TEST(SharedNothingTest, FlushRemoteFreesOfAllTypes) {
+  E* e = trpc::object_pool::New<E>();
+  F* f = trpc::object_pool::New<F>();
+
+  std::thread t([e, f] {
+    trpc::object_pool::Delete<E>(e);
+    trpc::object_pool::Delete<F>(f);
+    ASSERT_EQ(shared_nothing::GetTlsStatistics<E>().foreign_free_batches_num, 0);
+    ASSERT_EQ(shared_nothing::GetTlsStatistics<F>().foreign_free_batches_num, 0);
+
+    trpc::object_pool::FlushRemoteFrees();
+    ASSERT_EQ(shared_nothing::GetTlsStatistics<E>().foreign_free_batches_num, 1);
+    ASSERT_EQ(shared_nothing::GetTlsStatistics<F>().foreign_free_batches_num, 1);
+  });
+  t.join();
+}
+
+TEST(SharedNothingTest, DeleteAfterOwnerExit) {
+  std::vector<F*> items;
+  std::thread owner([&items] {
+    for (int i = 0; i < 4; ++i) {
+      items.push_back(trpc::object_pool::New<F>());
+    }
+  });
+  owner.join();
+
+  // The pool of the owner is gone, objects returned to it are dropped instead of touching it.
+  for (auto* item : items) {
+    trpc::object_pool::Delete<F>(item);
+  }
+  uint64_t batches_num = shared_nothing::GetTlsStatistics<F>().foreign_free_batches_num;
+  trpc::object_pool::FlushRemoteFrees();
+  ASSERT_EQ(shared_nothing::GetTlsStatistics<F>().foreign_free_batches_num, batches_num);
+}
+
 TEST(SharedNothingTest, SlotChunkManagerTest) {
   shared_nothing::detail::Slot<std::string> slot;
   slot.chunk_id = 1;
@@ -14,6 +14,9 @@
 #ifdef TRPC_BUILD_INCLUDE_PROMETHEUS
 #include "trpc/util/prometheus.h"
 
+#include <iterator>
+#include <mutex>
+
 #include "trpc/admin/base_funcs.h"
 #include "trpc/util/log/logging.h"
 
@@ -97,10 +100,34 @@ void InitProcessMetrics() {
 
 std::once_flag init_flag;
 
+// Collectables registered besides the default registry.
+std::vector<std::weak_ptr<::prometheus::Collectable>> collectables;
+std::mutex collectables_lock;
+
+void RegisterCollectable(const std::weak_ptr<::prometheus::Collectable>& collectable) {
+  std::lock_guard<std::mutex> lock(collectables_lock);
+  collectables.push_back(collectable);
+}
+
 std::vector<::prometheus::MetricFamily> Collect() {
   std::call_once(init_flag, InitProcessMetrics);
   UpdateProcessMetric();
-  return collector->Collect();
+  std::vector<::prometheus::MetricFamily> families = collector->Collect();
+
+  std::lock_guard<std::mutex> lock(collectables_lock);
+  auto iter = collectables.begin();
+  while (iter != collectables.end()) {
+    auto collectable = iter->lock();
+    if (!collectable) {
+      iter = collectables.erase(iter);
+      continue;
+    }
+    auto collected = collectable->Collect();
+    families.insert(families.end(), std::make_move_iterator(collected.begin()),
+                    std::make_move_iterator(collected.end()));
+    ++iter;
+  }
+  return families;
 }
 
 }  // namespace trpc::prometheus
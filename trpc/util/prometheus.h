@@ -19,6 +19,7 @@
 #include <string>
 #include <vector>
 
+#include "prometheus/collectable.h"
 #include "prometheus/counter.h"
 #include "prometheus/gauge.h"
 #include "prometheus/histogram.h"
@@ -34,6 +35,10 @@ std::shared_ptr<::prometheus::Registry> GetRegistry();
 /// @brief Gets monitoring data collected by Prometheus.
 std::vector<::prometheus::MetricFamily> Collect();
 
+/// @brief Registers a collectable whose metric families are collected together with the default registry.
+/// @note Only a weak reference is kept, the collectable is removed automatically after it expires.
+void RegisterCollectable(const std::weak_ptr<::prometheus::Collectable>& collectable);
+
 /// @brief Gets a counter type monitoring family.
 ::prometheus::Family<::prometheus::Counter>* GetCounterFamily(const char* name, const char* help,
                                                               const std::map<std::string, std::string>& labels = {});
@@ -0,0 +1,128 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#include "trpc/util/request_arena.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "trpc/util/check.h"
+
+namespace trpc {
+
+namespace {
+
+// Moving average of bytes used by arenas recently destroyed in current thread, scaled by `kUsageShift`.
+constexpr std::size_t kUsageShift = 3;
+thread_local std::size_t tls_recent_usage = 0;
+
+std::size_t RoundUpBlockSize(std::size_t size) {
+  // Malloc hands out memory in 16 bytes granularity anyway.
+  return (size + 15) & ~static_cast<std::size_t>(15);
+}
+
+}  // namespace
+
+void RequestArenaDeleter::operator()(RequestArena* arena) const noexcept {
+  arena->~RequestArena();
+  std::free(arena);
+}
+
+RefPtr<RequestArena> RequestArena::Create(std::size_t first_block_size) {
+  bool adaptive = first_block_size == 0;
+  if (adaptive) {
+    first_block_size = SuggestedFirstBlockSize();
+  }
+  first_block_size = RoundUpBlockSize(std::max(first_block_size, kMinBlockSize));
+
+  // The first block follows arena object in the same allocation.
+  constexpr std::size_t kHeaderSize = (sizeof(RequestArena) + alignof(std::max_align_t) - 1) &
+                                      ~(alignof(std::max_align_t) - 1);
+  void* mem = std::malloc(kHeaderSize + first_block_size);
+  TRPC_CHECK(mem != nullptr, "Out of memory");
+  auto* arena = new (mem) RequestArena(static_cast<char*>(mem) + kHeaderSize, first_block_size, adaptive);
+  return RefPtr(adopt_ptr, arena);
+}
+
+RequestArena::RequestArena(char* begin, std::size_t size, bool adaptive) noexcept
+    : ptr_(begin), end_(begin + size), reserved_(size), first_block_size_(size), adaptive_(adaptive) {}
+
+RequestArena::~RequestArena() {
+  while (cleanups_) {
+    // The cleanup may not touch arena, but fetch next one first to be safe.
+    Cleanup* cleanup = cleanups_;
+    cleanups_ = cleanup->next;
+    cleanup->func(cleanup->obj);
+  }
+
+  if (adaptive_) {
+    std::size_t used = UsedBytes();
+    tls_recent_usage = tls_recent_usage - (tls_recent_usage >> kUsageShift) + used;
+  }
+
+  while (blocks_) {
+    Block* next = blocks_->next;
+    std::free(blocks_);
+    blocks_ = next;
+  }
+}
+
+void RequestArena::AddCleanup(void (*func)(void*), void* obj) {
+  auto* cleanup = static_cast<Cleanup*>(Allocate(sizeof(Cleanup), alignof(Cleanup)));
+  cleanup->func = func;
+  cleanup->obj = obj;
+  cleanup->next = cleanups_;
+  cleanups_ = cleanup;
+}
+
+std::size_t RequestArena::UsedBytes() const noexcept {
+  std::size_t current_block_size = blocks_ ? blocks_->size : first_block_size_;
+  return retired_ + current_block_size - static_cast<std::size_t>(end_ - ptr_);
+}
+
+std::size_t RequestArena::SuggestedFirstBlockSize() noexcept {
+  // A quarter more than the average, so that most requests fit in the first block.
+  std::size_t average = tls_recent_usage >> kUsageShift;
+  return std::clamp(average + average / 4, kMinBlockSize, kMaxBlockSize);
+}
+
+void* RequestArena::AllocateSlow(std::size_t size, std::size_t align) {
+  constexpr std::size_t kBlockHeaderSize = (sizeof(Block) + alignof(std::max_align_t) - 1) &
+                                           ~(alignof(std::max_align_t) - 1);
+  TRPC_CHECK(size <= std::numeric_limits<std::size_t>::max() / 2 - kBlockHeaderSize - align, "Allocation too large");
+
+  // Blocks grow geometrically, a large allocation gets a block of its own size.
+  std::size_t current_block_size = blocks_ ? blocks_->size : first_block_size_;
+  std::size_t block_size = std::min(current_block_size * 2, kMaxBlockSize);
+  block_size = RoundUpBlockSize(std::max(block_size, size + align));
+
+  void* mem = std::malloc(kBlockHeaderSize + block_size);
+  TRPC_CHECK(mem != nullptr, "Out of memory");
+
+  retired_ += current_block_size - static_cast<std::size_t>(end_ - ptr_);
+  reserved_ += block_size;
+
+  auto* block = static_cast<Block*>(mem);
+  block->next = blocks_;
+  block->size = block_size;
+  blocks_ = block;
+  ptr_ = static_cast<char*>(mem) + kBlockHeaderSize;
+  end_ = ptr_ + block_size;
+
+  char* ptr = AlignUp(ptr_, align);
+  ptr_ = ptr + size;
+  return ptr;
+}
+
+}  // namespace trpc
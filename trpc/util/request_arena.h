@@ -0,0 +1,182 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "trpc/util/ref_ptr.h"
+
+namespace trpc {
+
+class RequestArena;
+
+/// @private
+struct RequestArenaDeleter {
+  void operator()(RequestArena* arena) const noexcept;
+};
+
+/// @brief Bump allocator whose memory lives as long as a request, everything allocated from it is released at once
+///        when the last reference goes away, instead of by a malloc/free pair per object.
+///        The first block is allocated together with the arena itself, and its size follows the usage of arenas
+///        recently released by current thread, so a typical request is served by a single malloc.
+/// @note  Allocation is not thread-safe, the arena is meant to be used along the processing flow of a request.
+///        Referencing/dereferencing it is thread-safe.
+class RequestArena : public RefCounted<RequestArena, RequestArenaDeleter> {
+ public:
+  /// @brief Smallest block allocated by arena.
+  static constexpr std::size_t kMinBlockSize = 512;
+
+  /// @brief Largest block allocated by arena, unless a single allocation is larger.
+  static constexpr std::size_t kMaxBlockSize = 64 * 1024;
+
+  /// @brief Create an arena.
+  /// @param first_block_size Size of the first block, 0 means it is decided by the usage of recent arenas.
+  static RefPtr<RequestArena> Create(std::size_t first_block_size = 0);
+
+  RequestArena(const RequestArena&) = delete;
+  RequestArena& operator=(const RequestArena&) = delete;
+
+  /// @brief Allocate raw memory, it is never freed individually.
+  /// @param align Must be a power of 2.
+  void* Allocate(std::size_t size, std::size_t align = alignof(std::max_align_t)) {
+    char* ptr = AlignUp(ptr_, align);
+    if (ptr <= end_ && size <= static_cast<std::size_t>(end_ - ptr)) {
+      ptr_ = ptr + size;
+      return ptr;
+    }
+    return AllocateSlow(size, align);
+  }
+
+  /// @brief Construct an object in arena, its destructor (if not trivial) is called when arena is destroyed.
+  template <typename T, typename... Args>
+  T* New(Args&&... args) {
+    void* ptr = Allocate(sizeof(T), alignof(T));
+    T* obj = new (ptr) T(std::forward<Args>(args)...);
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      AddCleanup([](void* p) { static_cast<T*>(p)->~T(); }, obj);
+    }
+    return obj;
+  }
+
+  /// @brief Copy string into arena, the returned view is valid as long as arena.
+  std::string_view CopyString(std::string_view str) {
+    if (str.empty()) {
+      return {};
+    }
+    char* ptr = static_cast<char*>(Allocate(str.size(), 1));
+    std::char_traits<char>::copy(ptr, str.data(), str.size());
+    return std::string_view(ptr, str.size());
+  }
+
+  /// @brief Register a function called with `obj` when arena is destroyed, in the reverse order of registration.
+  void AddCleanup(void (*func)(void*), void* obj);
+
+  /// @brief Bytes handed out by arena, including alignment padding.
+  std::size_t UsedBytes() const noexcept;
+
+  /// @brief Bytes of all blocks held by arena.
+  std::size_t ReservedBytes() const noexcept { return reserved_; }
+
+  /// @brief Size of the first block the next adaptive arena created by current thread will get.
+  static std::size_t SuggestedFirstBlockSize() noexcept;
+
+ private:
+  friend struct RequestArenaDeleter;
+
+  struct Block {
+    Block* next;
+    std::size_t size;
+  };
+
+  struct Cleanup {
+    void (*func)(void*);
+    void* obj;
+    Cleanup* next;
+  };
+
+  RequestArena(char* begin, std::size_t size, bool adaptive) noexcept;
+  ~RequestArena();
+
+  static char* AlignUp(char* ptr, std::size_t align) noexcept {
+    auto value = reinterpret_cast<std::uintptr_t>(ptr);
+    return reinterpret_cast<char*>((value + align - 1) & ~(static_cast<std::uintptr_t>(align) - 1));
+  }
+
+  void* AllocateSlow(std::size_t size, std::size_t align);
+
+ private:
+  char* ptr_;
+  char* end_;
+
+  // Blocks allocated after the first one (which is inline), newest first.
+  Block* blocks_{nullptr};
+
+  // Cleanups are allocated in arena as well, newest first.
+  Cleanup* cleanups_{nullptr};
+
+  // Bytes used up in blocks other than the current one.
+  std::size_t retired_{0};
+  std::size_t reserved_;
+  std::size_t first_block_size_;
+  bool adaptive_;
+};
+
+using RequestArenaPtr = RefPtr<RequestArena>;
+
+/// @brief Allocator on top of `RequestArena`, deallocation is a no-op. It holds a reference to arena, so containers
+///        or `std::allocate_shared` objects using it keep arena alive.
+template <typename T>
+class RequestArenaAllocator {
+ public:
+  using value_type = T;
+
+  explicit RequestArenaAllocator(RequestArenaPtr arena) noexcept : arena_(std::move(arena)) {}
+
+  template <typename U>
+  RequestArenaAllocator(const RequestArenaAllocator<U>& other) noexcept : arena_(other.GetArena()) {}
+
+  T* allocate(std::size_t n) {
+    if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+      throw std::bad_array_new_length();
+    }
+    return static_cast<T*>(arena_->Allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T*, std::size_t) noexcept {}
+
+  const RequestArenaPtr& GetArena() const noexcept { return arena_; }
+
+  template <typename U>
+  bool operator==(const RequestArenaAllocator<U>& other) const noexcept {
+    return arena_.Get() == other.GetArena().Get();
+  }
+
+  template <typename U>
+  bool operator!=(const RequestArenaAllocator<U>& other) const noexcept {
+    return !(*this == other);
+  }
+
+ private:
+  RequestArenaPtr arena_;
+};
+
+}  // namespace trpc
@@ -0,0 +1,119 @@
+//
+//
+// Tencent is pleased to support the open source community by making tRPC available.
+//
+// Copyright (C) 2023 THL A29 Limited, a Tencent company.
+// All rights reserved.
+//
+// If you have downloaded a copy of the tRPC source code from Tencent,
+// please note that tRPC source code is licensed under the  Apache 2.0 License,
+// A copy of the Apache 2.0 License is included in this file.
+//
+//
+
+
+#include "trpc/util/request_arena.h"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace trpc::testing {
+
+TEST(RequestArenaTest, Allocate) {
+  auto arena = RequestArena::Create(1024);
+  ASSERT_EQ(arena->ReservedBytes(), 1024);
+  ASSERT_EQ(arena->UsedBytes(), 0);
+
+  void* p1 = arena->Allocate(10, 1);
+  void* p2 = arena->Allocate(8, 8);
+  ASSERT_EQ(reinterpret_cast<std::uintptr_t>(p2) % 8, 0);
+  ASSERT_GE(static_cast<char*>(p2), static_cast<char*>(p1) + 10);
+  ASSERT_EQ(arena->UsedBytes(), 24);
+
+  // Exceeds the first block.
+  for (int i = 0; i < 100; ++i) {
+    arena->Allocate(100);
+  }
+  ASSERT_GT(arena->ReservedBytes(), 1024);
+  ASSERT_GE(arena->UsedBytes(), 100 * 100 + 24);
+
+  // Larger than the max block size.
+  void* large = arena->Allocate(RequestArena::kMaxBlockSize * 2);
+  memset(large, 0, RequestArena::kMaxBlockSize * 2);
+  ASSERT_GT(arena->ReservedBytes(), RequestArena::kMaxBlockSize * 2);
+}
+
+TEST(RequestArenaTest, NewAndCleanup) {
+  std::vector<int> destroyed;
+  struct Foo {
+    Foo(std::vector<int>* destroyed, int id) : destroyed(destroyed), id(id) {}
+    ~Foo() { destroyed->push_back(id); }
+    std::vector<int>* destroyed;
+    int id;
+  };
+
+  {
+    auto arena = RequestArena::Create();
+    Foo* foo1 = arena->New<Foo>(&destroyed, 1);
+    arena->New<Foo>(&destroyed, 2);
+    ASSERT_EQ(foo1->id, 1);
+    ASSERT_EQ(*arena->New<int>(3), 3);
+    ASSERT_TRUE(destroyed.empty());
+  }
+  // Destroyed in reverse order.
+  ASSERT_EQ(destroyed, (std::vector<int>{2, 1}));
+}
+
+TEST(RequestArenaTest, CopyString) {
+  auto arena = RequestArena::Create();
+  std::string str = "trpc.test.helloworld.Greeter";
+  auto view = arena->CopyString(str);
+  str.clear();
+  ASSERT_EQ(view, "trpc.test.helloworld.Greeter");
+  ASSERT_TRUE(arena->CopyString("").empty());
+}
+
+TEST(RequestArenaTest, Allocator) {
+  auto arena = RequestArena::Create();
+  RequestArena* raw = arena.Get();
+
+  std::vector<int, RequestArenaAllocator<int>> vec{RequestArenaAllocator<int>(arena)};
+  for (int i = 0; i < 1000; ++i) {
+    vec.push_back(i);
+  }
+  ASSERT_EQ(vec[999], 999);
+
+  auto ptr = std::allocate_shared<std::string>(RequestArenaAllocator<std::string>(arena), "hello");
+  arena = nullptr;
+  // Arena is kept alive by the allocators.
+  ASSERT_GE(raw->UsedBytes(), 1000 * sizeof(int));
+  ASSERT_EQ(*ptr, "hello");
+}
+
+TEST(RequestArenaTest, AdaptiveFirstBlock) {
+  std::thread([] {
+    ASSERT_EQ(RequestArena::SuggestedFirstBlockSize(), RequestArena::kMinBlockSize);
+    for (int i = 0; i < 100; ++i) {
+      auto arena = RequestArena::Create();
+      arena->Allocate(4000);
+    }
+    ASSERT_GE(RequestArena::SuggestedFirstBlockSize(), 4000);
+    ASSERT_LE(RequestArena::SuggestedFirstBlockSize(), 6000);
+    auto arena = RequestArena::Create();
+    ASSERT_GE(arena->ReservedBytes(), 4000);
+
+    // Arena with explicit size doesn't affect the suggestion.
+    for (int i = 0; i < 100; ++i) {
+      RequestArena::Create(1024)->Allocate(100000);
+    }
+    ASSERT_LE(RequestArena::SuggestedFirstBlockSize(), 6000);
+  }).join();
+}
+
+}  // namespace trpc::testing
@@ -25,6 +25,8 @@
 #include <thread>
 #include <vector>
 
+#include "trpc/util/chrono/tsc.h"
+
 namespace trpc {
 
 /// @brief PredicateNotifier allows to wait for arbitrary predicates in non-blocking
@@ -65,6 +67,8 @@ class PredicateNotifier {
     std::condition_variable cv;
     uint64_t epoch;
     unsigned state;
+    // TSC when the waiter is unparked, or 0 if it has not been unparked since `CommitWait`.
+    uint64_t unpark_tsc;
     enum {
       kNotSignaled,
       kWaiting,
@@ -96,6 +100,7 @@ class PredicateNotifier {
   /// @param w waiter
   void CommitWait(Waiter* w) {
     w->state = Waiter::kNotSignaled;
+    w->unpark_tsc = 0;
     // Modification epoch of this waiter.
     uint64_t epoch = (w->epoch & kEpochMask) + (((w->epoch & kWaiterMask) >> kWaiterShift) << kEpochShift);
     uint64_t state = state_.load(std::memory_order_seq_cst);
@@ -240,6 +245,7 @@ class PredicateNotifier {
         std::unique_lock<std::mutex> lock(w->mu);
         state = w->state;
         w->state = Waiter::kSignaled;
+        w->unpark_tsc = ReadTsc();
       }
       // Avoid notifying if it wasn't waiting.
       if (state == Waiter::kWaiting) w->cv.notify_one();